@@ -0,0 +1,8 @@
+# Run by the regression target before the benchmarks (cmake -DREGRESSION_BASELINE=<file> -P <this file>), so that a
+# missing baseline fails immediately instead of after a full benchmark run.
+
+if (NOT EXISTS "${REGRESSION_BASELINE}")
+    message(FATAL_ERROR
+            "The regression baseline ${REGRESSION_BASELINE} does not exist. Record one on the machine and driver to "
+            "compare against with the target regression-update, or point REGRESSION_BASELINE to an existing one.")
+endif()
@@ -0,0 +1,26 @@
+# Script mode (cmake -P): Converts the SPIR-V files listed in MANIFEST_FILE (lines of the form
+# <kernel name>|<variant name>|<SPIR-V file>) to the C++ kernel table written to OUTPUT_FILE.
+
+file(STRINGS "${MANIFEST_FILE}" KERNEL_ENTRIES)
+set(OUTPUT_CONTENT "// Generated by CMake/EmbedKernels.cmake from ${MANIFEST_FILE}. Do not edit.\n\n")
+set(TABLE_CONTENT "")
+set(KERNEL_IDX 0)
+foreach(KERNEL_ENTRY ${KERNEL_ENTRIES})
+    string(REPLACE "|" ";" KERNEL_FIELDS "${KERNEL_ENTRY}")
+    list(GET KERNEL_FIELDS 0 KERNEL_NAME)
+    list(GET KERNEL_FIELDS 1 VARIANT_NAME)
+    list(GET KERNEL_FIELDS 2 SPIRV_FILE)
+    file(READ "${SPIRV_FILE}" HEX_CONTENT HEX)
+    string(LENGTH "${HEX_CONTENT}" HEX_LENGTH)
+    math(EXPR NUM_BYTES "${HEX_LENGTH} / 2")
+    # SPIR-V words are stored in little endian byte order by glslangValidator.
+    string(REGEX REPLACE "(..)(..)(..)(..)" "0x\\4\\3\\2\\1u," WORDS "${HEX_CONTENT}")
+    string(APPEND OUTPUT_CONTENT "static const uint32_t kernelCode${KERNEL_IDX}[] = {${WORDS}};\n")
+    string(APPEND TABLE_CONTENT
+            "    { \"${KERNEL_NAME}\", \"${VARIANT_NAME}\", kernelCode${KERNEL_IDX}, ${NUM_BYTES} },\n")
+    math(EXPR KERNEL_IDX "${KERNEL_IDX} + 1")
+endforeach()
+# The table is terminated by an empty entry, which also keeps it valid when no kernels could be compiled.
+string(APPEND OUTPUT_CONTENT
+        "\nstatic const EmbeddedKernel embeddedKernels[] = {\n${TABLE_CONTENT}    { nullptr, nullptr, nullptr, 0 }\n};\n")
+file(WRITE "${OUTPUT_FILE}" "${OUTPUT_CONTENT}")
@@ -0,0 +1,329 @@
+# Compiles the GLSL compute kernels in src/Shaders to SPIR-V at build time and embeds them into the executable.
+# If glslangValidator cannot be found, the executable is built without kernels and the benchmark modes needing
+# them report that they are unavailable. The same holds for variants using GLSL extensions glslangValidator lacks.
+
+find_program(
+        GLSLANG_VALIDATOR_EXECUTABLE NAMES glslangValidator
+        HINTS "$ENV{VULKAN_SDK}/bin" "$ENV{VULKAN_SDK}/Bin")
+if (NOT GLSLANG_VALIDATOR_EXECUTABLE)
+    message(WARNING "glslangValidator not found. Benchmark kernels will not be available.")
+endif()
+
+# Compiles a minimal kernel using the GLSL extensions of FEATURE once at configure time and sets
+# GLSLANG_SUPPORTS_<FEATURE>. Older Vulkan SDKs lack some of the newer extensions; variants requiring them are skipped
+# (see add_kernel_variant) and reported as unavailable at runtime instead of failing the build.
+function(check_glslang_feature FEATURE SOURCE)
+    set(PROBE_FILE "${CMAKE_CURRENT_BINARY_DIR}/GlslangProbes/${FEATURE}.comp")
+    file(WRITE "${PROBE_FILE}" "#version 460\n${SOURCE}\nlayout(local_size_x = 1) in;\n")
+    execute_process(
+            COMMAND "${GLSLANG_VALIDATOR_EXECUTABLE}" -V --target-env vulkan1.3 -S comp
+                    -o "${PROBE_FILE}.spv" "${PROBE_FILE}"
+            RESULT_VARIABLE PROBE_RESULT OUTPUT_QUIET ERROR_QUIET)
+    if (PROBE_RESULT EQUAL 0)
+        set(GLSLANG_SUPPORTS_${FEATURE} TRUE PARENT_SCOPE)
+    else()
+        set(GLSLANG_SUPPORTS_${FEATURE} FALSE PARENT_SCOPE)
+        message(STATUS "glslangValidator does not support ${FEATURE}. Skipping the kernel variants requiring it.")
+    endif()
+endfunction()
+
+if (GLSLANG_VALIDATOR_EXECUTABLE)
+    check_glslang_feature(BFLOAT16 [=[
+#extension GL_EXT_bfloat16 : require
+void main() { bfloat16_t x = bfloat16_t(1.0); }
+]=])
+    check_glslang_feature(FLOAT8 [=[
+#extension GL_EXT_float_e4m3 : require
+#extension GL_EXT_float_e5m2 : require
+void main() { floate4m3_t x = floate4m3_t(1.0); floate5m2_t y = floate5m2_t(1.0); }
+]=])
+    check_glslang_feature(COOPERATIVE_MATRIX2 [=[
+#extension GL_KHR_cooperative_matrix : require
+#extension GL_KHR_memory_scope_semantics : require
+#extension GL_NV_cooperative_matrix2 : require
+#extension GL_EXT_shader_explicit_arithmetic_types : require
+void main() {
+    coopmat<float16_t, gl_ScopeWorkgroup, 16, 16, gl_MatrixUseA> a =
+            coopmat<float16_t, gl_ScopeWorkgroup, 16, 16, gl_MatrixUseA>(0.0);
+    tensorLayoutNV<2> tensorLayout = createTensorLayoutNV(2);
+}
+]=])
+    check_glslang_feature(COOPERATIVE_VECTOR [=[
+#extension GL_NV_cooperative_vector : require
+#extension GL_EXT_shader_explicit_arithmetic_types : require
+void main() { coopvecNV<float16_t, 16> v = coopvecNV<float16_t, 16>(0.0); }
+]=])
+endif()
+
+set(KERNEL_SOURCE_DIR "${CMAKE_CURRENT_SOURCE_DIR}/src/Shaders")
+set(KERNEL_OUTPUT_DIR "${CMAKE_CURRENT_BINARY_DIR}/Kernels")
+file(GLOB KERNEL_INCLUDE_FILES "${KERNEL_SOURCE_DIR}/*.glsl")
+
+# Maps the short component type names used for kernel variants (see getComponentTypeShortName) to GLSL types.
+function(get_glsl_component_type SHORT_NAME OUT_VAR)
+    set(GLSL_TYPE_f16 float16_t)
+    set(GLSL_TYPE_f32 float32_t)
+    set(GLSL_TYPE_f64 float64_t)
+    set(GLSL_TYPE_bf16 bfloat16_t)
+    set(GLSL_TYPE_e4m3 floate4m3_t)
+    set(GLSL_TYPE_e5m2 floate5m2_t)
+    set(GLSL_TYPE_s8 int8_t)
+    set(GLSL_TYPE_s16 int16_t)
+    set(GLSL_TYPE_s32 int32_t)
+    set(GLSL_TYPE_s64 int64_t)
+    set(GLSL_TYPE_u8 uint8_t)
+    set(GLSL_TYPE_u16 uint16_t)
+    set(GLSL_TYPE_u32 uint32_t)
+    set(GLSL_TYPE_u64 uint64_t)
+    if (NOT DEFINED GLSL_TYPE_${SHORT_NAME})
+        message(FATAL_ERROR "Unknown component type '${SHORT_NAME}'.")
+    endif()
+    set(${OUT_VAR} ${GLSL_TYPE_${SHORT_NAME}} PARENT_SCOPE)
+endfunction()
+
+# Returns the preprocessor defines selecting the types of a variant of the form <A>_<B>_<C>_<Result>.
+function(get_coopmat_type_defines TYPE_COMBINATION OUT_VAR)
+    string(REPLACE "_" ";" TYPE_LIST "${TYPE_COMBINATION}")
+    set(DEFINES "")
+    set(USED_TYPES "")
+    set(TYPE_IDX 0)
+    foreach(MATRIX_NAME A B C R)
+        list(GET TYPE_LIST ${TYPE_IDX} SHORT_NAME)
+        math(EXPR TYPE_IDX "${TYPE_IDX} + 1")
+        get_glsl_component_type(${SHORT_NAME} GLSL_TYPE)
+        list(APPEND DEFINES "${MATRIX_NAME}_TYPE=${GLSL_TYPE}")
+        list(APPEND USED_TYPES ${SHORT_NAME})
+    endforeach()
+    if ("bf16" IN_LIST USED_TYPES)
+        list(APPEND DEFINES "USE_BFLOAT16")
+    endif()
+    if ("e4m3" IN_LIST USED_TYPES)
+        list(APPEND DEFINES "USE_FLOAT_E4M3")
+    endif()
+    if ("e5m2" IN_LIST USED_TYPES)
+        list(APPEND DEFINES "USE_FLOAT_E5M2")
+    endif()
+    set(${OUT_VAR} ${DEFINES} PARENT_SCOPE)
+endfunction()
+
+# add_kernel_variant(<kernel name> <variant name> <source file> [DEFINES <define>...] [REQUIRES <feature>...])
+# The features (see check_glslang_feature) enabled by the type and scope defines are required implicitly.
+function(add_kernel_variant KERNEL_NAME VARIANT_NAME SOURCE_FILE)
+    if (NOT GLSLANG_VALIDATOR_EXECUTABLE)
+        return()
+    endif()
+    cmake_parse_arguments(KERNEL "" "" "DEFINES;REQUIRES" ${ARGN})
+    set(REQUIRED_FEATURES ${KERNEL_REQUIRES})
+    if ("USE_BFLOAT16" IN_LIST KERNEL_DEFINES)
+        list(APPEND REQUIRED_FEATURES BFLOAT16)
+    endif()
+    if ("USE_FLOAT_E4M3" IN_LIST KERNEL_DEFINES OR "USE_FLOAT_E5M2" IN_LIST KERNEL_DEFINES)
+        list(APPEND REQUIRED_FEATURES FLOAT8)
+    endif()
+    if ("USE_WORKGROUP_SCOPE" IN_LIST KERNEL_DEFINES)
+        list(APPEND REQUIRED_FEATURES COOPERATIVE_MATRIX2)
+    endif()
+    foreach(FEATURE ${REQUIRED_FEATURES})
+        if (NOT GLSLANG_SUPPORTS_${FEATURE})
+            return()
+        endif()
+    endforeach()
+    set(SPIRV_FILE "${KERNEL_OUTPUT_DIR}/${KERNEL_NAME}_${VARIANT_NAME}.spv")
+    set(DEFINE_ARGS "")
+    foreach(DEFINE ${KERNEL_DEFINES})
+        list(APPEND DEFINE_ARGS "-D${DEFINE}")
+    endforeach()
+    add_custom_command(
+            OUTPUT "${SPIRV_FILE}"
+            COMMAND ${CMAKE_COMMAND} -E make_directory "${KERNEL_OUTPUT_DIR}"
+            COMMAND "${GLSLANG_VALIDATOR_EXECUTABLE}" -V --target-env vulkan1.3 -S comp
+                    ${DEFINE_ARGS} -o "${SPIRV_FILE}" "${SOURCE_FILE}"
+            DEPENDS "${SOURCE_FILE}" ${KERNEL_INCLUDE_FILES}
+            COMMENT "Compiling kernel ${KERNEL_NAME} (${VARIANT_NAME})"
+            VERBATIM)
+    set_property(GLOBAL APPEND PROPERTY QUERYVKCOOPMAT_KERNEL_SPIRV_FILES "${SPIRV_FILE}")
+    set_property(GLOBAL APPEND PROPERTY QUERYVKCOOPMAT_KERNEL_ENTRIES "${KERNEL_NAME}|${VARIANT_NAME}|${SPIRV_FILE}")
+endfunction()
+
+# Generates EmbeddedKernels.inc (included by src/Kernels.cpp) from all variants added so far.
+function(embed_kernels TARGET_NAME)
+    get_property(SPIRV_FILES GLOBAL PROPERTY QUERYVKCOOPMAT_KERNEL_SPIRV_FILES)
+    get_property(KERNEL_ENTRIES GLOBAL PROPERTY QUERYVKCOOPMAT_KERNEL_ENTRIES)
+    set(MANIFEST_FILE "${KERNEL_OUTPUT_DIR}/KernelManifest.txt")
+    set(EMBEDDED_FILE "${KERNEL_OUTPUT_DIR}/EmbeddedKernels.inc")
+    # The static and shared library targets share the generated file.
+    get_property(IS_EMBEDDED_FILE_ADDED GLOBAL PROPERTY QUERYVKCOOPMAT_EMBEDDED_FILE_ADDED)
+    if (NOT IS_EMBEDDED_FILE_ADDED)
+        string(REPLACE ";" "\n" MANIFEST_CONTENT "${KERNEL_ENTRIES}")
+        # Only touch the manifest if it changed, such that re-running CMake does not cause a rebuild.
+        file(WRITE "${MANIFEST_FILE}.tmp" "${MANIFEST_CONTENT}\n")
+        configure_file("${MANIFEST_FILE}.tmp" "${MANIFEST_FILE}" COPYONLY)
+        add_custom_command(
+                OUTPUT "${EMBEDDED_FILE}"
+                COMMAND ${CMAKE_COMMAND} -DMANIFEST_FILE=${MANIFEST_FILE} -DOUTPUT_FILE=${EMBEDDED_FILE}
+                        -P "${CMAKE_CURRENT_SOURCE_DIR}/CMake/EmbedKernels.cmake"
+                DEPENDS ${SPIRV_FILES} "${MANIFEST_FILE}" "${CMAKE_CURRENT_SOURCE_DIR}/CMake/EmbedKernels.cmake"
+                COMMENT "Embedding SPIR-V kernels"
+                VERBATIM)
+        set_property(GLOBAL PROPERTY QUERYVKCOOPMAT_EMBEDDED_FILE_ADDED TRUE)
+    endif()
+    target_sources(${TARGET_NAME} PRIVATE "${EMBEDDED_FILE}")
+    target_include_directories(${TARGET_NAME} PRIVATE "${KERNEL_OUTPUT_DIR}")
+endfunction()
+
+# Generates all plausible type combinations <A>_<B>_<C>_<Result>: A and B of the same kind (the two 8-bit float formats
+# and the signed and unsigned 8-bit integer types may be mixed), accumulators supported by both input types, and
+# results of the accumulator type or, for float32 accumulation of 16-bit float inputs, of the input type. Drivers only
+# report a subset of these; entries without a matching variant are reported as "no kernel" at runtime.
+function(generate_coopmat_type_combinations OUT_VAR)
+    set(MIXABLE_TYPES_f16 f16)
+    set(MIXABLE_TYPES_bf16 bf16)
+    set(MIXABLE_TYPES_f32 f32)
+    set(MIXABLE_TYPES_f64 f64)
+    set(MIXABLE_TYPES_e4m3 e4m3 e5m2)
+    set(MIXABLE_TYPES_e5m2 e4m3 e5m2)
+    set(MIXABLE_TYPES_s8 s8 u8)
+    set(MIXABLE_TYPES_u8 s8 u8)
+    set(ACCUMULATOR_TYPES_f16 f16 f32)
+    set(ACCUMULATOR_TYPES_bf16 bf16 f32)
+    set(ACCUMULATOR_TYPES_f32 f32)
+    set(ACCUMULATOR_TYPES_f64 f64)
+    set(ACCUMULATOR_TYPES_e4m3 f16 bf16 f32)
+    set(ACCUMULATOR_TYPES_e5m2 f16 bf16 f32)
+    set(ACCUMULATOR_TYPES_s8 s32)
+    set(ACCUMULATOR_TYPES_u8 s32 u32)
+    set(COMBINATIONS "")
+    foreach(A_TYPE f16 bf16 f32 f64 e4m3 e5m2 s8 u8)
+        foreach(B_TYPE ${MIXABLE_TYPES_${A_TYPE}})
+            foreach(C_TYPE ${ACCUMULATOR_TYPES_${A_TYPE}})
+                if (NOT C_TYPE IN_LIST ACCUMULATOR_TYPES_${B_TYPE})
+                    continue()
+                endif()
+                list(APPEND COMBINATIONS "${A_TYPE}_${B_TYPE}_${C_TYPE}_${C_TYPE}")
+                if (C_TYPE STREQUAL "f32" AND A_TYPE STREQUAL B_TYPE AND A_TYPE MATCHES "^b?f16$")
+                    list(APPEND COMBINATIONS "${A_TYPE}_${B_TYPE}_${C_TYPE}_${A_TYPE}")
+                endif()
+            endforeach()
+        endforeach()
+    endforeach()
+    set(${OUT_VAR} ${COMBINATIONS} PARENT_SCOPE)
+endfunction()
+
+# Shapes are specialization constants, so one variant per type combination and scope covers all reported entries.
+# Workgroup scope variants (VK_NV_cooperative_matrix2) are only generated for the input types that it is used with.
+generate_coopmat_type_combinations(COOPMAT_GEMM_TYPE_COMBINATIONS)
+foreach(TYPE_COMBINATION ${COOPMAT_GEMM_TYPE_COMBINATIONS})
+    get_coopmat_type_defines(${TYPE_COMBINATION} TYPE_DEFINES)
+    set(SCOPE_SUFFIXES "")
+    if (NOT TYPE_COMBINATION MATCHES "^f(32|64)_")
+        set(SCOPE_SUFFIXES "_wg")
+    endif()
+    foreach(SCOPE_SUFFIX "" ${SCOPE_SUFFIXES})
+        set(SCOPE_DEFINES "")
+        if (SCOPE_SUFFIX STREQUAL "_wg")
+            set(SCOPE_DEFINES USE_WORKGROUP_SCOPE)
+        endif()
+        add_kernel_variant(
+                CoopMatGemm ${TYPE_COMBINATION}${SCOPE_SUFFIX} "${KERNEL_SOURCE_DIR}/CoopMatGemm.comp"
+                DEFINES ${TYPE_DEFINES} ${SCOPE_DEFINES})
+        # Entries with saturatingAccumulation require the SaturatingAccumulation operand to be present.
+        if (TYPE_COMBINATION MATCHES "^[su]8_")
+            add_kernel_variant(
+                    CoopMatGemm ${TYPE_COMBINATION}_sat${SCOPE_SUFFIX} "${KERNEL_SOURCE_DIR}/CoopMatGemm.comp"
+                    DEFINES ${TYPE_DEFINES} ${SCOPE_DEFINES} SATURATING_ACCUMULATION)
+        endif()
+    endforeach()
+    # Strided and pointer-array batched GEMM (see src/Shaders/BatchedGemm.comp).
+    add_kernel_variant(
+            BatchedGemm ${TYPE_COMBINATION} "${KERNEL_SOURCE_DIR}/BatchedGemm.comp" DEFINES ${TYPE_DEFINES})
+    add_kernel_variant(
+            BatchedGemm ${TYPE_COMBINATION}_ptr "${KERNEL_SOURCE_DIR}/BatchedGemm.comp"
+            DEFINES ${TYPE_DEFINES} POINTER_ARRAY)
+endforeach()
+
+add_kernel_variant(Occupancy default "${KERNEL_SOURCE_DIR}/Occupancy.comp")
+get_coopmat_type_defines(f16_f16_f32_f32 TYPE_DEFINES)
+add_kernel_variant(
+        Occupancy workgroup_scope "${KERNEL_SOURCE_DIR}/Occupancy.comp" DEFINES USE_WORKGROUP_SCOPE ${TYPE_DEFINES})
+
+# Variants <operation>_<path> of the coopmat2 operation microbenchmarks (see src/Shaders/CoopMat2Ops.comp).
+set(COOPMAT2_OPS_VARIANTS
+        convert_fused convert_shared convert_baseline
+        reduce_row_fused reduce_row_shared reduce_column_fused reduce_column_shared
+        reduce_2x2_fused reduce_2x2_shared reduce_baseline reduce_2x2_baseline
+        scale_fused scale_element_loop scale_shared clamp_fused clamp_element_loop clamp_shared
+        activation_fused activation_element_loop activation_shared element_baseline)
+get_coopmat_type_defines(f16_f16_f32_f32 TYPE_DEFINES)
+foreach(VARIANT ${COOPMAT2_OPS_VARIANTS})
+    string(REGEX MATCH "^(.*)_(fused|element_loop|shared|baseline)$" VARIANT_MATCH "${VARIANT}")
+    string(TOUPPER "OP_${CMAKE_MATCH_1}" OPERATION_DEFINE)
+    string(TOUPPER "PATH_${CMAKE_MATCH_2}" PATH_DEFINE)
+    if (OPERATION_DEFINE STREQUAL "OP_REDUCE")
+        set(OPERATION_DEFINE "OP_REDUCE_ROW")
+    endif()
+    set(PATH_REQUIRES "")
+    if (PATH_DEFINE STREQUAL "PATH_FUSED")
+        set(PATH_REQUIRES COOPERATIVE_MATRIX2)
+    endif()
+    add_kernel_variant(
+            CoopMat2Ops ${VARIANT} "${KERNEL_SOURCE_DIR}/CoopMat2Ops.comp"
+            DEFINES ${TYPE_DEFINES} ${OPERATION_DEFINE} ${PATH_DEFINE} REQUIRES ${PATH_REQUIRES})
+endforeach()
+
+# Implicit GEMM convolution with the input in NHWC or NCHW layout (see src/Shaders/ImplicitGemmConv.comp).
+get_coopmat_type_defines(f16_f16_f32_f32 TYPE_DEFINES)
+foreach(INPUT_LAYOUT nhwc nchw)
+    set(LAYOUT_DEFINES ${TYPE_DEFINES})
+    if (INPUT_LAYOUT STREQUAL "nchw")
+        list(APPEND LAYOUT_DEFINES INPUT_NCHW)
+    endif()
+    add_kernel_variant(
+            ImplicitGemmConv ${INPUT_LAYOUT}_im2col "${KERNEL_SOURCE_DIR}/ImplicitGemmConv.comp"
+            DEFINES ${LAYOUT_DEFINES} PATH_IM2COL)
+    add_kernel_variant(
+            ImplicitGemmConv ${INPUT_LAYOUT}_tensor_decode "${KERNEL_SOURCE_DIR}/ImplicitGemmConv.comp"
+            DEFINES ${LAYOUT_DEFINES} PATH_TENSOR_DECODE REQUIRES COOPERATIVE_MATRIX2)
+endforeach()
+add_kernel_variant(
+        ImplicitGemmConv nhwc_tensor_view "${KERNEL_SOURCE_DIR}/ImplicitGemmConv.comp"
+        DEFINES ${TYPE_DEFINES} PATH_TENSOR_VIEW REQUIRES COOPERATIVE_MATRIX2)
+
+# Fused attention with VK_KHR_cooperative_matrix and with VK_NV_cooperative_matrix2 in subgroup and workgroup scope.
+get_coopmat_type_defines(f16_f16_f32_f32 TYPE_DEFINES)
+add_kernel_variant(FlashAttention khr "${KERNEL_SOURCE_DIR}/FlashAttention.comp" DEFINES ${TYPE_DEFINES})
+add_kernel_variant(
+        FlashAttention nv2_subgroup "${KERNEL_SOURCE_DIR}/FlashAttentionNV2.comp"
+        DEFINES ${TYPE_DEFINES} REQUIRES COOPERATIVE_MATRIX2)
+add_kernel_variant(
+        FlashAttention nv2_workgroup "${KERNEL_SOURCE_DIR}/FlashAttentionNV2.comp"
+        DEFINES ${TYPE_DEFINES} USE_WORKGROUP_SCOPE)
+
+# MLP training with VK_NV_cooperative_vector (see src/Shaders/CoopVecTraining.comp).
+add_kernel_variant(
+        CoopVecTraining no_accumulation "${KERNEL_SOURCE_DIR}/CoopVecTraining.comp"
+        DEFINES NO_ACCUMULATION REQUIRES COOPERATIVE_VECTOR)
+add_kernel_variant(
+        CoopVecTraining f16_accumulation "${KERNEL_SOURCE_DIR}/CoopVecTraining.comp" REQUIRES COOPERATIVE_VECTOR)
+add_kernel_variant(
+        CoopVecTraining f32_accumulation "${KERNEL_SOURCE_DIR}/CoopVecTraining.comp"
+        DEFINES GRAD_TYPE_F32 REQUIRES COOPERATIVE_VECTOR)
+
+# MLP inference with VK_NV_cooperative_vector per weight matrix layout (see src/Shaders/CoopVecInference.comp).
+add_kernel_variant(
+        CoopVecInference row_major "${KERNEL_SOURCE_DIR}/CoopVecInference.comp"
+        DEFINES MATRIX_LAYOUT=gl_CooperativeVectorMatrixLayoutRowMajorNV REQUIRES COOPERATIVE_VECTOR)
+add_kernel_variant(
+        CoopVecInference column_major "${KERNEL_SOURCE_DIR}/CoopVecInference.comp"
+        DEFINES MATRIX_LAYOUT=gl_CooperativeVectorMatrixLayoutColumnMajorNV REQUIRES COOPERATIVE_VECTOR)
+add_kernel_variant(
+        CoopVecInference inferencing_optimal "${KERNEL_SOURCE_DIR}/CoopVecInference.comp"
+        DEFINES MATRIX_LAYOUT=gl_CooperativeVectorMatrixLayoutInferencingOptimalNV REQUIRES COOPERATIVE_VECTOR)
+
+# Streaming kernel of the async compute/transfer overlap benchmark (see src/Shaders/StreamCompute.comp).
+add_kernel_variant(StreamCompute default "${KERNEL_SOURCE_DIR}/StreamCompute.comp")
+
+# Reduction kernel of the K split in the multi-GPU GEMM benchmark (see src/Shaders/MatrixAdd.comp).
+add_kernel_variant(MatrixAdd default "${KERNEL_SOURCE_DIR}/MatrixAdd.comp")
+
+# Shared memory bandwidth kernel of the roofline benchmark (see src/Shaders/SharedMemoryBandwidth.comp).
+add_kernel_variant(SharedMemoryBandwidth default "${KERNEL_SOURCE_DIR}/SharedMemoryBandwidth.comp")
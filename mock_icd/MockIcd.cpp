@@ -0,0 +1,1787 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Vulkan driver (ICD) replaying device profiles written by QueryVkCoopMat --capture-profile, so that the tool can run
+ * deterministically without a GPU. See README.md, section "Device profiles and the mock driver".
+ *
+ * - Each profile listed in QUERYVKCOOPMAT_MOCK_PROFILES (separated by ':'; directories add all contained *.json files
+ *   in alphabetical order) becomes one physical device.
+ * - All physical device queries are answered from the profile.
+ * - Device memory is host memory, and the sizes of the memory heaps are enforced.
+ * - Command buffers are not executed. Fences, events and binary semaphores are always signaled, and timeline
+ *   semaphores take the signaled values on submission. Timestamp query i returns i * MOCK_TICKS_PER_TIMESTAMP_QUERY,
+ *   so every measured interval of two consecutive queries is the same.
+ */
+
+#define VK_NO_PROTOTYPES
+#include <vulkan/vulkan.h>
+#include <vulkan/vk_icd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "JsonReader.hpp"
+#include "DeviceProfileFields.hpp"
+
+#define MOCK_ICD_EXPORT extern "C" __attribute__((visibility("default")))
+
+static_assert(sizeof(void*) == 8, "The mock driver stores non-dispatchable handles as pointers.");
+
+static const char* PROFILES_ENVIRONMENT_VARIABLE = "QUERYVKCOOPMAT_MOCK_PROFILES";
+static const uint32_t MOCK_ICD_INTERFACE_VERSION = 5;
+static const uint64_t MOCK_TICKS_PER_TIMESTAMP_QUERY = 1000;
+static const VkDeviceSize MOCK_BUFFER_ALIGNMENT = 256;
+static const size_t MOCK_HOST_ALLOCATION_ALIGNMENT = 4096;
+
+
+/*
+ * Profile loading.
+ */
+
+struct MockFormat {
+    VkFormatProperties properties{};
+    std::vector<VkDrmFormatModifierPropertiesEXT> drmFormatModifiers;
+};
+
+#define MOCK_DECLARE_STRUCT(jsonKey, StructType, sTypeValue, minApiVersion, requiredExtension, FIELDS) \
+    StructType jsonKey{}; \
+    bool jsonKey##IsAvailable = false;
+
+struct MockProfile {
+    std::string filePath;
+    std::vector<VkExtensionProperties> extensions;
+    VkPhysicalDeviceProperties properties{};
+    VkPhysicalDeviceFeatures features{};
+    PROFILE_PROPERTY_STRUCTS(MOCK_DECLARE_STRUCT)
+    PROFILE_FEATURE_STRUCTS(MOCK_DECLARE_STRUCT)
+    std::vector<VkCooperativeMatrixPropertiesKHR> supportedCooperativeMatrixPropertiesKHR;
+    std::vector<VkCooperativeMatrixPropertiesNV> supportedCooperativeMatrixPropertiesNV;
+    std::vector<VkCooperativeMatrixFlexibleDimensionsPropertiesNV>
+            supportedCooperativeMatrixFlexibleDimensionsPropertiesNV;
+    std::vector<VkCooperativeVectorPropertiesNV> supportedCooperativeVectorPropertiesNV;
+    VkPhysicalDeviceMemoryProperties memoryProperties{};
+    std::vector<VkQueueFamilyProperties> queueFamilies;
+    std::vector<VkTimeDomainKHR> timeDomains;
+    std::unordered_map<int64_t, MockFormat> formats;
+
+    [[nodiscard]] bool isExtensionSupported(const char* extensionName) const {
+        for (const auto& extension : extensions) {
+            if (std::strcmp(extension.extensionName, extensionName) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+static void readProfileField(const JsonValue& object, const char* name, uint32_t& value) {
+    const JsonValue* member = object.findMember(name);
+    if (!member) {
+        return;
+    }
+    if (member->getType() == JsonValue::Type::BOOLEAN) {
+        value = member->getBool() ? VK_TRUE : VK_FALSE;
+    } else {
+        value = uint32_t(member->getUint64());
+    }
+}
+
+static void readProfileField(const JsonValue& object, const char* name, uint64_t& value) {
+    if (const JsonValue* member = object.findMember(name)) {
+        value = member->getUint64();
+    }
+}
+
+static void readProfileField(const JsonValue& object, const char* name, float& value) {
+    if (const JsonValue* member = object.findMember(name)) {
+        value = float(member->getDouble());
+    }
+}
+
+template<class T, typename std::enable_if<std::is_enum<T>::value, int>::type = 0>
+static void readProfileField(const JsonValue& object, const char* name, T& value) {
+    if (const JsonValue* member = object.findMember(name)) {
+        value = T(member->getInt64());
+    }
+}
+
+template<size_t N>
+static void readProfileField(const JsonValue& object, const char* name, uint32_t (&values)[N]) {
+    if (const JsonValue* member = object.findMember(name)) {
+        for (size_t i = 0; i < N && i < member->size(); i++) {
+            values[i] = uint32_t(member->at(i).getUint64());
+        }
+    }
+}
+
+template<size_t N>
+static void readProfileField(const JsonValue& object, const char* name, char (&text)[N]) {
+    if (const JsonValue* member = object.findMember(name)) {
+        const std::string& value = member->getString();
+        size_t length = std::min(value.size(), N - 1);
+        std::memcpy(text, value.data(), length);
+        text[length] = '\0';
+    }
+}
+
+template<size_t N>
+static void readProfileField(const JsonValue& object, const char* name, uint8_t (&bytes)[N]) {
+    const JsonValue* member = object.findMember(name);
+    if (!member) {
+        return;
+    }
+    const std::string& hexString = member->getString();
+    if (hexString.size() != 2 * N) {
+        throw std::runtime_error(std::string() + "Expected " + std::to_string(2 * N) + " hex digits for " + name + ".");
+    }
+    for (size_t i = 0; i < N; i++) {
+        bytes[i] = uint8_t(std::stoul(hexString.substr(2 * i, 2), nullptr, 16));
+    }
+}
+
+static void readProfileFeature(const JsonValue& object, const char* name, VkBool32& value) {
+    if (const JsonValue* member = object.findMember(name)) {
+        value = member->getBool() ? VK_TRUE : VK_FALSE;
+    }
+}
+
+#define MOCK_READ_FIELD(name) readProfileField(object, #name, s.name);
+#define MOCK_READ_FEATURE_FIELD(name) readProfileFeature(object, #name, s.name);
+#define MOCK_READ_STRUCT(jsonKey, StructType, sTypeValue, minApiVersion, requiredExtension, FIELDS) \
+    if (const JsonValue* member = root.findMember(#jsonKey)) { \
+        const JsonValue& object = *member; \
+        auto& s = profile.jsonKey; \
+        s.sType = sTypeValue; \
+        FIELDS(MOCK_READ_FIELD) \
+        profile.jsonKey##IsAvailable = true; \
+    }
+#define MOCK_READ_FEATURE_STRUCT(jsonKey, StructType, sTypeValue, minApiVersion, requiredExtension, FIELDS) \
+    if (const JsonValue* member = root.findMember(#jsonKey)) { \
+        const JsonValue& object = *member; \
+        auto& s = profile.jsonKey; \
+        s.sType = sTypeValue; \
+        FIELDS(MOCK_READ_FEATURE_FIELD) \
+        profile.jsonKey##IsAvailable = true; \
+    }
+#define MOCK_READ_ARRAY(jsonKey, ElementType, sTypeValue, FIELDS) \
+    if (const JsonValue* member = root.findMember(#jsonKey)) { \
+        for (const JsonValue& object : member->getElements()) { \
+            ElementType s{}; \
+            s.sType = sTypeValue; \
+            FIELDS(MOCK_READ_FIELD) \
+            profile.jsonKey.push_back(s); \
+        } \
+    }
+
+static MockProfile loadProfile(const std::string& filePath) {
+    JsonValue root = loadJsonFile(filePath);
+    MockProfile profile;
+    profile.filePath = filePath;
+    if (root.at("profileFormatVersion").getInt64() != PROFILE_FORMAT_VERSION) {
+        throw std::runtime_error(filePath + ": Unsupported profile format version.");
+    }
+
+    for (const JsonValue& object : root.at("extensions").getElements()) {
+        VkExtensionProperties extension{};
+        readProfileField(object, "extensionName", extension.extensionName);
+        readProfileField(object, "specVersion", extension.specVersion);
+        profile.extensions.push_back(extension);
+    }
+
+    {
+        const JsonValue& object = root.at("properties");
+        auto& s = profile.properties;
+        PROFILE_PROPERTIES_FIELDS(MOCK_READ_FIELD)
+    }
+    {
+        const JsonValue& object = root.at("properties").at("limits");
+        auto& s = profile.properties.limits;
+        PROFILE_LIMITS_FIELDS(MOCK_READ_FIELD)
+    }
+    PROFILE_PROPERTY_STRUCTS(MOCK_READ_STRUCT)
+    {
+        const JsonValue& object = root.at("features");
+        auto& s = profile.features;
+        PROFILE_FEATURES_FIELDS(MOCK_READ_FEATURE_FIELD)
+    }
+    PROFILE_FEATURE_STRUCTS(MOCK_READ_FEATURE_STRUCT)
+
+    MOCK_READ_ARRAY(
+            supportedCooperativeMatrixPropertiesKHR, VkCooperativeMatrixPropertiesKHR,
+            VK_STRUCTURE_TYPE_COOPERATIVE_MATRIX_PROPERTIES_KHR, PROFILE_COOPERATIVE_MATRIX_PROPERTIES_KHR_ARRAY_FIELDS)
+    MOCK_READ_ARRAY(
+            supportedCooperativeMatrixPropertiesNV, VkCooperativeMatrixPropertiesNV,
+            VK_STRUCTURE_TYPE_COOPERATIVE_MATRIX_PROPERTIES_NV, PROFILE_COOPERATIVE_MATRIX_PROPERTIES_NV_ARRAY_FIELDS)
+    MOCK_READ_ARRAY(
+            supportedCooperativeMatrixFlexibleDimensionsPropertiesNV, VkCooperativeMatrixFlexibleDimensionsPropertiesNV,
+            VK_STRUCTURE_TYPE_COOPERATIVE_MATRIX_FLEXIBLE_DIMENSIONS_PROPERTIES_NV,
+            PROFILE_COOPERATIVE_MATRIX_FLEXIBLE_DIMENSIONS_PROPERTIES_NV_ARRAY_FIELDS)
+    MOCK_READ_ARRAY(
+            supportedCooperativeVectorPropertiesNV, VkCooperativeVectorPropertiesNV,
+            VK_STRUCTURE_TYPE_COOPERATIVE_VECTOR_PROPERTIES_NV, PROFILE_COOPERATIVE_VECTOR_PROPERTIES_NV_ARRAY_FIELDS)
+
+    const JsonValue& memoryProperties = root.at("memoryProperties");
+    const auto& memoryTypes = memoryProperties.at("memoryTypes").getElements();
+    const auto& memoryHeaps = memoryProperties.at("memoryHeaps").getElements();
+    if (memoryTypes.size() > VK_MAX_MEMORY_TYPES || memoryHeaps.size() > VK_MAX_MEMORY_HEAPS) {
+        throw std::runtime_error(filePath + ": Too many memory types or heaps.");
+    }
+    profile.memoryProperties.memoryTypeCount = uint32_t(memoryTypes.size());
+    for (size_t i = 0; i < memoryTypes.size(); i++) {
+        auto& memoryType = profile.memoryProperties.memoryTypes[i];
+        memoryType.propertyFlags = VkMemoryPropertyFlags(memoryTypes[i].at("propertyFlags").getUint64());
+        memoryType.heapIndex = uint32_t(memoryTypes[i].at("heapIndex").getUint64());
+    }
+    profile.memoryProperties.memoryHeapCount = uint32_t(memoryHeaps.size());
+    for (size_t i = 0; i < memoryHeaps.size(); i++) {
+        auto& memoryHeap = profile.memoryProperties.memoryHeaps[i];
+        memoryHeap.size = VkDeviceSize(memoryHeaps[i].at("size").getUint64());
+        memoryHeap.flags = VkMemoryHeapFlags(memoryHeaps[i].at("flags").getUint64());
+    }
+
+    for (const JsonValue& object : root.at("queueFamilies").getElements()) {
+        VkQueueFamilyProperties queueFamily{};
+        readProfileField(object, "queueFlags", queueFamily.queueFlags);
+        readProfileField(object, "queueCount", queueFamily.queueCount);
+        readProfileField(object, "timestampValidBits", queueFamily.timestampValidBits);
+        uint32_t granularity[3] = { 1, 1, 1 };
+        readProfileField(object, "minImageTransferGranularity", granularity);
+        queueFamily.minImageTransferGranularity = { granularity[0], granularity[1], granularity[2] };
+        profile.queueFamilies.push_back(queueFamily);
+    }
+
+    if (const JsonValue* timeDomains = root.findMember("timeDomains")) {
+        for (const JsonValue& timeDomain : timeDomains->getElements()) {
+            profile.timeDomains.push_back(VkTimeDomainKHR(timeDomain.getInt64()));
+        }
+    }
+
+    if (const JsonValue* formats = root.findMember("formats")) {
+        for (const JsonValue& object : formats->getElements()) {
+            MockFormat format;
+            readProfileField(object, "linearTilingFeatures", format.properties.linearTilingFeatures);
+            readProfileField(object, "optimalTilingFeatures", format.properties.optimalTilingFeatures);
+            readProfileField(object, "bufferFeatures", format.properties.bufferFeatures);
+            if (const JsonValue* drmFormatModifiers = object.findMember("drmFormatModifiers")) {
+                for (const JsonValue& modifierObject : drmFormatModifiers->getElements()) {
+                    VkDrmFormatModifierPropertiesEXT modifier{};
+                    readProfileField(modifierObject, "drmFormatModifier", modifier.drmFormatModifier);
+                    readProfileField(
+                            modifierObject, "drmFormatModifierPlaneCount", modifier.drmFormatModifierPlaneCount);
+                    readProfileField(
+                            modifierObject, "drmFormatModifierTilingFeatures",
+                            modifier.drmFormatModifierTilingFeatures);
+                    format.drmFormatModifiers.push_back(modifier);
+                }
+            }
+            profile.formats[object.at("format").getInt64()] = std::move(format);
+        }
+    }
+
+    return profile;
+}
+
+static std::vector<std::string> getProfileFilePaths() {
+    std::vector<std::string> filePaths;
+    const char* environmentValue = std::getenv(PROFILES_ENVIRONMENT_VARIABLE);
+    if (!environmentValue) {
+        return filePaths;
+    }
+    std::string paths = environmentValue;
+    size_t start = 0;
+    while (start <= paths.size()) {
+        size_t end = paths.find(':', start);
+        if (end == std::string::npos) {
+            end = paths.size();
+        }
+        std::string path = paths.substr(start, end - start);
+        start = end + 1;
+        if (path.empty()) {
+            continue;
+        }
+        if (std::filesystem::is_directory(path)) {
+            std::vector<std::string> directoryFilePaths;
+            for (const auto& entry : std::filesystem::directory_iterator(path)) {
+                if (entry.is_regular_file() && entry.path().extension() == ".json") {
+                    directoryFilePaths.push_back(entry.path().string());
+                }
+            }
+            std::sort(directoryFilePaths.begin(), directoryFilePaths.end());
+            filePaths.insert(filePaths.end(), directoryFilePaths.begin(), directoryFilePaths.end());
+        } else {
+            filePaths.push_back(path);
+        }
+    }
+    return filePaths;
+}
+
+
+/*
+ * Objects. Dispatchable objects start with the loader data; non-dispatchable handles are unique integers.
+ */
+
+struct MockDispatchable {
+    MockDispatchable() { set_loader_magic_value(this); }
+    VK_LOADER_DATA loaderData;
+};
+
+struct MockPhysicalDevice : MockDispatchable {
+    MockProfile profile;
+};
+
+struct MockInstance : MockDispatchable {
+    std::vector<std::unique_ptr<MockPhysicalDevice>> physicalDevices;
+};
+
+struct MockDevice;
+
+struct MockQueue : MockDispatchable {
+    MockDevice* device = nullptr;
+};
+
+struct MockCommandBuffer : MockDispatchable {
+};
+
+struct MockMemory {
+    void* hostPointer = nullptr;
+    VkDeviceSize size = 0;
+    uint32_t heapIndex = 0;
+};
+
+struct MockBuffer {
+    VkDeviceSize size = 0;
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    VkDeviceSize memoryOffset = 0;
+};
+
+struct MockQueryPool {
+    VkQueryType queryType = VK_QUERY_TYPE_TIMESTAMP;
+    uint32_t queryCount = 0;
+};
+
+struct MockDevice : MockDispatchable {
+    MockPhysicalDevice* physicalDevice = nullptr;
+    std::mutex mutex;
+    /// Key: queue family index << 32 | queue index.
+    std::unordered_map<uint64_t, std::unique_ptr<MockQueue>> queues;
+    std::unordered_map<uint64_t, std::vector<std::unique_ptr<MockCommandBuffer>>> commandPools;
+    std::unordered_map<uint64_t, MockMemory> memoryAllocations;
+    std::vector<VkDeviceSize> heapUsage;
+    std::unordered_map<uint64_t, MockBuffer> buffers;
+    std::unordered_map<uint64_t, VkDeviceSize> imageSizes;
+    std::unordered_map<uint64_t, uint64_t> semaphoreValues;
+    std::unordered_map<uint64_t, MockQueryPool> queryPools;
+};
+
+template<class Handle>
+static uint64_t getHandleValue(Handle handle) {
+    return uint64_t(reinterpret_cast<uintptr_t>(handle));
+}
+
+template<class Handle>
+static Handle createHandle() {
+    static std::atomic<uint64_t> nextHandleValue{1};
+    return reinterpret_cast<Handle>(uintptr_t(nextHandleValue++));
+}
+
+static MockPhysicalDevice* getPhysicalDevice(VkPhysicalDevice physicalDevice) {
+    return reinterpret_cast<MockPhysicalDevice*>(physicalDevice);
+}
+
+static const MockProfile& getProfile(VkPhysicalDevice physicalDevice) {
+    return getPhysicalDevice(physicalDevice)->profile;
+}
+
+static MockDevice* getDevice(VkDevice device) {
+    return reinterpret_cast<MockDevice*>(device);
+}
+
+/// Two-call idiom of the enumeration functions; pNext of the caller's output structs is preserved.
+template<class T, class = void>
+struct HasPNext : std::false_type {};
+template<class T>
+struct HasPNext<T, std::void_t<decltype(std::declval<T>().pNext)>> : std::true_type {};
+
+template<class T>
+static VkResult copyArrayOut(const std::vector<T>& items, uint32_t* pCount, T* pItems) {
+    if (!pItems) {
+        *pCount = uint32_t(items.size());
+        return VK_SUCCESS;
+    }
+    uint32_t count = std::min(*pCount, uint32_t(items.size()));
+    for (uint32_t i = 0; i < count; i++) {
+        if constexpr (HasPNext<T>::value) {
+            void* pNext = pItems[i].pNext;
+            pItems[i] = items[i];
+            pItems[i].pNext = pNext;
+        } else {
+            pItems[i] = items[i];
+        }
+    }
+    *pCount = count;
+    return count < uint32_t(items.size()) ? VK_INCOMPLETE : VK_SUCCESS;
+}
+
+template<class T>
+static void copyOutStruct(VkBaseOutStructure* out, const T& stored) {
+    auto* target = reinterpret_cast<T*>(out);
+    void* pNext = target->pNext;
+    *target = stored;
+    target->pNext = pNext;
+}
+
+template<class T>
+static const T* findInChain(const void* pNext, VkStructureType structureType) {
+    const auto* next = reinterpret_cast<const VkBaseInStructure*>(pNext);
+    while (next) {
+        if (next->sType == structureType) {
+            return reinterpret_cast<const T*>(next);
+        }
+        next = next->pNext;
+    }
+    return nullptr;
+}
+
+
+/*
+ * Global and instance functions.
+ */
+
+static const std::vector<VkExtensionProperties>& getInstanceExtensions() {
+    static const std::vector<VkExtensionProperties> extensions = {
+            {
+                    VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME,
+                    VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_SPEC_VERSION
+            },
+            { VK_KHR_EXTERNAL_MEMORY_CAPABILITIES_EXTENSION_NAME, VK_KHR_EXTERNAL_MEMORY_CAPABILITIES_SPEC_VERSION },
+            { VK_KHR_DEVICE_GROUP_CREATION_EXTENSION_NAME, VK_KHR_DEVICE_GROUP_CREATION_SPEC_VERSION },
+    };
+    return extensions;
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL mock_vkEnumerateInstanceExtensionProperties(
+        const char* pLayerName, uint32_t* pPropertyCount, VkExtensionProperties* pProperties) {
+    if (pLayerName) {
+        return VK_ERROR_LAYER_NOT_PRESENT;
+    }
+    return copyArrayOut(getInstanceExtensions(), pPropertyCount, pProperties);
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL mock_vkEnumerateInstanceVersion(uint32_t* pApiVersion) {
+    *pApiVersion = VK_HEADER_VERSION_COMPLETE;
+    return VK_SUCCESS;
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL mock_vkCreateInstance(
+        const VkInstanceCreateInfo* pCreateInfo, const VkAllocationCallbacks*, VkInstance* pInstance) {
+    for (uint32_t i = 0; i < pCreateInfo->enabledExtensionCount; i++) {
+        bool isSupported = false;
+        for (const auto& extension : getInstanceExtensions()) {
+            isSupported = isSupported
+                    || std::strcmp(extension.extensionName, pCreateInfo->ppEnabledExtensionNames[i]) == 0;
+        }
+        if (!isSupported) {
+            return VK_ERROR_EXTENSION_NOT_PRESENT;
+        }
+    }
+    auto instance = std::make_unique<MockInstance>();
+    try {
+        for (const std::string& filePath : getProfileFilePaths()) {
+            auto physicalDevice = std::make_unique<MockPhysicalDevice>();
+            physicalDevice->profile = loadProfile(filePath);
+            instance->physicalDevices.push_back(std::move(physicalDevice));
+        }
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "QueryVkCoopMat mock driver: %s\n", e.what());
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
+    *pInstance = reinterpret_cast<VkInstance>(instance.release());
+    return VK_SUCCESS;
+}
+
+static VKAPI_ATTR void VKAPI_CALL mock_vkDestroyInstance(VkInstance instance, const VkAllocationCallbacks*) {
+    delete reinterpret_cast<MockInstance*>(instance);
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL mock_vkEnumeratePhysicalDevices(
+        VkInstance instance, uint32_t* pPhysicalDeviceCount, VkPhysicalDevice* pPhysicalDevices) {
+    std::vector<VkPhysicalDevice> physicalDevices;
+    for (auto& physicalDevice : reinterpret_cast<MockInstance*>(instance)->physicalDevices) {
+        physicalDevices.push_back(reinterpret_cast<VkPhysicalDevice>(physicalDevice.get()));
+    }
+    return copyArrayOut(physicalDevices, pPhysicalDeviceCount, pPhysicalDevices);
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL mock_vkEnumeratePhysicalDeviceGroups(
+        VkInstance instance, uint32_t* pPhysicalDeviceGroupCount,
+        VkPhysicalDeviceGroupProperties* pPhysicalDeviceGroupProperties) {
+    std::vector<VkPhysicalDeviceGroupProperties> groups;
+    for (auto& physicalDevice : reinterpret_cast<MockInstance*>(instance)->physicalDevices) {
+        VkPhysicalDeviceGroupProperties group{};
+        group.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GROUP_PROPERTIES;
+        group.physicalDeviceCount = 1;
+        group.physicalDevices[0] = reinterpret_cast<VkPhysicalDevice>(physicalDevice.get());
+        groups.push_back(group);
+    }
+    return copyArrayOut(groups, pPhysicalDeviceGroupCount, pPhysicalDeviceGroupProperties);
+}
+
+
+/*
+ * Physical device functions.
+ */
+
+static VKAPI_ATTR void VKAPI_CALL mock_vkGetPhysicalDeviceProperties(
+        VkPhysicalDevice physicalDevice, VkPhysicalDeviceProperties* pProperties) {
+    *pProperties = getProfile(physicalDevice).properties;
+}
+
+#define MOCK_FILL_STRUCT(jsonKey, StructType, sTypeValue, minApiVersion, requiredExtension, FIELDS) \
+    case sTypeValue: \
+        if (profile.jsonKey##IsAvailable) { \
+            copyOutStruct(next, profile.jsonKey); \
+        } \
+        break;
+
+/// Structs that were promoted to Vulkan 1.1-1.3 are filled from the Vulkan 1.x property structs of the profile.
+static void fillPromotedProperties(const MockProfile& profile, VkBaseOutStructure* next) {
+    const auto& properties11 = profile.vulkan11Properties;
+    const auto& properties12 = profile.vulkan12Properties;
+    const auto& properties13 = profile.vulkan13Properties;
+    switch (next->sType) {
+        case VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ID_PROPERTIES: {
+            auto* properties = reinterpret_cast<VkPhysicalDeviceIDProperties*>(next);
+            std::memcpy(properties->deviceUUID, properties11.deviceUUID, VK_UUID_SIZE);
+            std::memcpy(properties->driverUUID, properties11.driverUUID, VK_UUID_SIZE);
+            std::memcpy(properties->deviceLUID, properties11.deviceLUID, VK_LUID_SIZE);
+            properties->deviceNodeMask = properties11.deviceNodeMask;
+            properties->deviceLUIDValid = properties11.deviceLUIDValid;
+            break;
+        }
+        case VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SUBGROUP_PROPERTIES: {
+            auto* properties = reinterpret_cast<VkPhysicalDeviceSubgroupProperties*>(next);
+            properties->subgroupSize = properties11.subgroupSize;
+            properties->supportedStages = properties11.subgroupSupportedStages;
+            properties->supportedOperations = properties11.subgroupSupportedOperations;
+            properties->quadOperationsInAllStages = properties11.subgroupQuadOperationsInAllStages;
+            break;
+        }
+        case VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MAINTENANCE_3_PROPERTIES: {
+            auto* properties = reinterpret_cast<VkPhysicalDeviceMaintenance3Properties*>(next);
+            properties->maxPerSetDescriptors = properties11.maxPerSetDescriptors;
+            properties->maxMemoryAllocationSize = properties11.maxMemoryAllocationSize;
+            break;
+        }
+        case VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DRIVER_PROPERTIES: {
+            auto* properties = reinterpret_cast<VkPhysicalDeviceDriverProperties*>(next);
+            properties->driverID = properties12.driverID;
+            std::memcpy(properties->driverName, properties12.driverName, VK_MAX_DRIVER_NAME_SIZE);
+            std::memcpy(properties->driverInfo, properties12.driverInfo, VK_MAX_DRIVER_INFO_SIZE);
+            break;
+        }
+        case VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SUBGROUP_SIZE_CONTROL_PROPERTIES: {
+            auto* properties = reinterpret_cast<VkPhysicalDeviceSubgroupSizeControlProperties*>(next);
+            properties->minSubgroupSize = properties13.minSubgroupSize;
+            properties->maxSubgroupSize = properties13.maxSubgroupSize;
+            properties->maxComputeWorkgroupSubgroups = properties13.maxComputeWorkgroupSubgroups;
+            properties->requiredSubgroupSizeStages = properties13.requiredSubgroupSizeStages;
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+static VKAPI_ATTR void VKAPI_CALL mock_vkGetPhysicalDeviceProperties2(
+        VkPhysicalDevice physicalDevice, VkPhysicalDeviceProperties2* pProperties) {
+    const MockProfile& profile = getProfile(physicalDevice);
+    pProperties->properties = profile.properties;
+    for (auto* next = reinterpret_cast<VkBaseOutStructure*>(pProperties->pNext); next; next = next->pNext) {
+        switch (next->sType) {
+            PROFILE_PROPERTY_STRUCTS(MOCK_FILL_STRUCT)
+            default:
+                fillPromotedProperties(profile, next);
+                break;
+        }
+    }
+}
+
+static VKAPI_ATTR void VKAPI_CALL mock_vkGetPhysicalDeviceFeatures(
+        VkPhysicalDevice physicalDevice, VkPhysicalDeviceFeatures* pFeatures) {
+    *pFeatures = getProfile(physicalDevice).features;
+}
+
+static void fillPromotedFeatures(const MockProfile& profile, VkBaseOutStructure* next) {
+    const auto& features11 = profile.vulkan11Features;
+    const auto& features12 = profile.vulkan12Features;
+    const auto& features13 = profile.vulkan13Features;
+    switch (next->sType) {
+        case VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_16BIT_STORAGE_FEATURES: {
+            auto* features = reinterpret_cast<VkPhysicalDevice16BitStorageFeatures*>(next);
+            features->storageBuffer16BitAccess = features11.storageBuffer16BitAccess;
+            features->uniformAndStorageBuffer16BitAccess = features11.uniformAndStorageBuffer16BitAccess;
+            features->storagePushConstant16 = features11.storagePushConstant16;
+            features->storageInputOutput16 = features11.storageInputOutput16;
+            break;
+        }
+        case VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_8BIT_STORAGE_FEATURES: {
+            auto* features = reinterpret_cast<VkPhysicalDevice8BitStorageFeatures*>(next);
+            features->storageBuffer8BitAccess = features12.storageBuffer8BitAccess;
+            features->uniformAndStorageBuffer8BitAccess = features12.uniformAndStorageBuffer8BitAccess;
+            features->storagePushConstant8 = features12.storagePushConstant8;
+            break;
+        }
+        case VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_FLOAT16_INT8_FEATURES: {
+            auto* features = reinterpret_cast<VkPhysicalDeviceShaderFloat16Int8Features*>(next);
+            features->shaderFloat16 = features12.shaderFloat16;
+            features->shaderInt8 = features12.shaderInt8;
+            break;
+        }
+        case VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES: {
+            auto* features = reinterpret_cast<VkPhysicalDeviceTimelineSemaphoreFeatures*>(next);
+            features->timelineSemaphore = features12.timelineSemaphore;
+            break;
+        }
+        case VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_BUFFER_DEVICE_ADDRESS_FEATURES: {
+            auto* features = reinterpret_cast<VkPhysicalDeviceBufferDeviceAddressFeatures*>(next);
+            features->bufferDeviceAddress = features12.bufferDeviceAddress;
+            features->bufferDeviceAddressCaptureReplay = features12.bufferDeviceAddressCaptureReplay;
+            features->bufferDeviceAddressMultiDevice = features12.bufferDeviceAddressMultiDevice;
+            break;
+        }
+        case VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_MEMORY_MODEL_FEATURES: {
+            auto* features = reinterpret_cast<VkPhysicalDeviceVulkanMemoryModelFeatures*>(next);
+            features->vulkanMemoryModel = features12.vulkanMemoryModel;
+            features->vulkanMemoryModelDeviceScope = features12.vulkanMemoryModelDeviceScope;
+            features->vulkanMemoryModelAvailabilityVisibilityChains =
+                    features12.vulkanMemoryModelAvailabilityVisibilityChains;
+            break;
+        }
+        case VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SCALAR_BLOCK_LAYOUT_FEATURES: {
+            auto* features = reinterpret_cast<VkPhysicalDeviceScalarBlockLayoutFeatures*>(next);
+            features->scalarBlockLayout = features12.scalarBlockLayout;
+            break;
+        }
+        case VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SUBGROUP_SIZE_CONTROL_FEATURES: {
+            auto* features = reinterpret_cast<VkPhysicalDeviceSubgroupSizeControlFeatures*>(next);
+            features->subgroupSizeControl = features13.subgroupSizeControl;
+            features->computeFullSubgroups = features13.computeFullSubgroups;
+            break;
+        }
+        case VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES: {
+            auto* features = reinterpret_cast<VkPhysicalDeviceSynchronization2Features*>(next);
+            features->synchronization2 = features13.synchronization2;
+            break;
+        }
+        case VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MAINTENANCE_4_FEATURES: {
+            auto* features = reinterpret_cast<VkPhysicalDeviceMaintenance4Features*>(next);
+            features->maintenance4 = features13.maintenance4;
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+static VKAPI_ATTR void VKAPI_CALL mock_vkGetPhysicalDeviceFeatures2(
+        VkPhysicalDevice physicalDevice, VkPhysicalDeviceFeatures2* pFeatures) {
+    const MockProfile& profile = getProfile(physicalDevice);
+    pFeatures->features = profile.features;
+    for (auto* next = reinterpret_cast<VkBaseOutStructure*>(pFeatures->pNext); next; next = next->pNext) {
+        switch (next->sType) {
+            PROFILE_FEATURE_STRUCTS(MOCK_FILL_STRUCT)
+            default:
+                fillPromotedFeatures(profile, next);
+                break;
+        }
+    }
+}
+
+static VKAPI_ATTR void VKAPI_CALL mock_vkGetPhysicalDeviceQueueFamilyProperties(
+        VkPhysicalDevice physicalDevice, uint32_t* pQueueFamilyPropertyCount,
+        VkQueueFamilyProperties* pQueueFamilyProperties) {
+    copyArrayOut(getProfile(physicalDevice).queueFamilies, pQueueFamilyPropertyCount, pQueueFamilyProperties);
+}
+
+static VKAPI_ATTR void VKAPI_CALL mock_vkGetPhysicalDeviceQueueFamilyProperties2(
+        VkPhysicalDevice physicalDevice, uint32_t* pQueueFamilyPropertyCount,
+        VkQueueFamilyProperties2* pQueueFamilyProperties) {
+    const auto& queueFamilies = getProfile(physicalDevice).queueFamilies;
+    if (!pQueueFamilyProperties) {
+        *pQueueFamilyPropertyCount = uint32_t(queueFamilies.size());
+        return;
+    }
+    *pQueueFamilyPropertyCount = std::min(*pQueueFamilyPropertyCount, uint32_t(queueFamilies.size()));
+    for (uint32_t i = 0; i < *pQueueFamilyPropertyCount; i++) {
+        pQueueFamilyProperties[i].queueFamilyProperties = queueFamilies[i];
+    }
+}
+
+static VKAPI_ATTR void VKAPI_CALL mock_vkGetPhysicalDeviceMemoryProperties(
+        VkPhysicalDevice physicalDevice, VkPhysicalDeviceMemoryProperties* pMemoryProperties) {
+    *pMemoryProperties = getProfile(physicalDevice).memoryProperties;
+}
+
+static VKAPI_ATTR void VKAPI_CALL mock_vkGetPhysicalDeviceMemoryProperties2(
+        VkPhysicalDevice physicalDevice, VkPhysicalDeviceMemoryProperties2* pMemoryProperties) {
+    const MockProfile& profile = getProfile(physicalDevice);
+    pMemoryProperties->memoryProperties = profile.memoryProperties;
+    auto* budgetProperties = const_cast<VkPhysicalDeviceMemoryBudgetPropertiesEXT*>(
+            findInChain<VkPhysicalDeviceMemoryBudgetPropertiesEXT>(
+                    pMemoryProperties->pNext, VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT));
+    if (budgetProperties) {
+        for (uint32_t i = 0; i < profile.memoryProperties.memoryHeapCount; i++) {
+            budgetProperties->heapBudget[i] = profile.memoryProperties.memoryHeaps[i].size;
+            budgetProperties->heapUsage[i] = 0;
+        }
+    }
+}
+
+static VKAPI_ATTR void VKAPI_CALL mock_vkGetPhysicalDeviceFormatProperties(
+        VkPhysicalDevice physicalDevice, VkFormat format, VkFormatProperties* pFormatProperties) {
+    const auto& formats = getProfile(physicalDevice).formats;
+    auto it = formats.find(int64_t(format));
+    *pFormatProperties = it != formats.end() ? it->second.properties : VkFormatProperties{};
+}
+
+static VKAPI_ATTR void VKAPI_CALL mock_vkGetPhysicalDeviceFormatProperties2(
+        VkPhysicalDevice physicalDevice, VkFormat format, VkFormatProperties2* pFormatProperties) {
+    const auto& formats = getProfile(physicalDevice).formats;
+    auto it = formats.find(int64_t(format));
+    const MockFormat emptyFormat{};
+    const MockFormat& mockFormat = it != formats.end() ? it->second : emptyFormat;
+    pFormatProperties->formatProperties = mockFormat.properties;
+    const auto& modifiers = mockFormat.drmFormatModifiers;
+    for (auto* next = reinterpret_cast<VkBaseOutStructure*>(pFormatProperties->pNext); next; next = next->pNext) {
+        if (next->sType == VK_STRUCTURE_TYPE_DRM_FORMAT_MODIFIER_PROPERTIES_LIST_EXT) {
+            auto* list = reinterpret_cast<VkDrmFormatModifierPropertiesListEXT*>(next);
+            if (!list->pDrmFormatModifierProperties) {
+                list->drmFormatModifierCount = uint32_t(modifiers.size());
+                continue;
+            }
+            list->drmFormatModifierCount = std::min(list->drmFormatModifierCount, uint32_t(modifiers.size()));
+            std::copy_n(modifiers.begin(), list->drmFormatModifierCount, list->pDrmFormatModifierProperties);
+        } else if (next->sType == VK_STRUCTURE_TYPE_DRM_FORMAT_MODIFIER_PROPERTIES_LIST_2_EXT) {
+            auto* list = reinterpret_cast<VkDrmFormatModifierPropertiesList2EXT*>(next);
+            if (!list->pDrmFormatModifierProperties) {
+                list->drmFormatModifierCount = uint32_t(modifiers.size());
+                continue;
+            }
+            list->drmFormatModifierCount = std::min(list->drmFormatModifierCount, uint32_t(modifiers.size()));
+            for (uint32_t i = 0; i < list->drmFormatModifierCount; i++) {
+                auto& modifier = list->pDrmFormatModifierProperties[i];
+                modifier.drmFormatModifier = modifiers[i].drmFormatModifier;
+                modifier.drmFormatModifierPlaneCount = modifiers[i].drmFormatModifierPlaneCount;
+                modifier.drmFormatModifierTilingFeatures = modifiers[i].drmFormatModifierTilingFeatures;
+            }
+        } else if (next->sType == VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_3) {
+            auto* properties3 = reinterpret_cast<VkFormatProperties3*>(next);
+            properties3->linearTilingFeatures = mockFormat.properties.linearTilingFeatures;
+            properties3->optimalTilingFeatures = mockFormat.properties.optimalTilingFeatures;
+            properties3->bufferFeatures = mockFormat.properties.bufferFeatures;
+        }
+    }
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL mock_vkGetPhysicalDeviceImageFormatProperties(
+        VkPhysicalDevice, VkFormat, VkImageType, VkImageTiling, VkImageUsageFlags, VkImageCreateFlags,
+        VkImageFormatProperties*) {
+    return VK_ERROR_FORMAT_NOT_SUPPORTED;
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL mock_vkGetPhysicalDeviceImageFormatProperties2(
+        VkPhysicalDevice, const VkPhysicalDeviceImageFormatInfo2*, VkImageFormatProperties2*) {
+    return VK_ERROR_FORMAT_NOT_SUPPORTED;
+}
+
+static VKAPI_ATTR void VKAPI_CALL mock_vkGetPhysicalDeviceSparseImageFormatProperties(
+        VkPhysicalDevice, VkFormat, VkImageType, VkSampleCountFlagBits, VkImageUsageFlags, VkImageTiling,
+        uint32_t* pPropertyCount, VkSparseImageFormatProperties*) {
+    *pPropertyCount = 0;
+}
+
+static VKAPI_ATTR void VKAPI_CALL mock_vkGetPhysicalDeviceSparseImageFormatProperties2(
+        VkPhysicalDevice, const VkPhysicalDeviceSparseImageFormatInfo2*, uint32_t* pPropertyCount,
+        VkSparseImageFormatProperties2*) {
+    *pPropertyCount = 0;
+}
+
+/// External memory, semaphores and fences are not supported; the peer transfer mode falls back to staging copies.
+static VKAPI_ATTR void VKAPI_CALL mock_vkGetPhysicalDeviceExternalBufferProperties(
+        VkPhysicalDevice, const VkPhysicalDeviceExternalBufferInfo*,
+        VkExternalBufferProperties* pExternalBufferProperties) {
+    pExternalBufferProperties->externalMemoryProperties = {};
+}
+
+static VKAPI_ATTR void VKAPI_CALL mock_vkGetPhysicalDeviceExternalSemaphoreProperties(
+        VkPhysicalDevice, const VkPhysicalDeviceExternalSemaphoreInfo*,
+        VkExternalSemaphoreProperties* pExternalSemaphoreProperties) {
+    pExternalSemaphoreProperties->exportFromImportedHandleTypes = 0;
+    pExternalSemaphoreProperties->compatibleHandleTypes = 0;
+    pExternalSemaphoreProperties->externalSemaphoreFeatures = 0;
+}
+
+static VKAPI_ATTR void VKAPI_CALL mock_vkGetPhysicalDeviceExternalFenceProperties(
+        VkPhysicalDevice, const VkPhysicalDeviceExternalFenceInfo*,
+        VkExternalFenceProperties* pExternalFenceProperties) {
+    pExternalFenceProperties->exportFromImportedHandleTypes = 0;
+    pExternalFenceProperties->compatibleHandleTypes = 0;
+    pExternalFenceProperties->externalFenceFeatures = 0;
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL mock_vkGetPhysicalDeviceToolProperties(
+        VkPhysicalDevice, uint32_t* pToolCount, VkPhysicalDeviceToolProperties*) {
+    *pToolCount = 0;
+    return VK_SUCCESS;
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL mock_vkGetPhysicalDeviceCalibrateableTimeDomainsKHR(
+        VkPhysicalDevice physicalDevice, uint32_t* pTimeDomainCount, VkTimeDomainKHR* pTimeDomains) {
+    return copyArrayOut(getProfile(physicalDevice).timeDomains, pTimeDomainCount, pTimeDomains);
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL mock_vkGetPhysicalDeviceCooperativeMatrixPropertiesKHR(
+        VkPhysicalDevice physicalDevice, uint32_t* pPropertyCount, VkCooperativeMatrixPropertiesKHR* pProperties) {
+    return copyArrayOut(
+            getProfile(physicalDevice).supportedCooperativeMatrixPropertiesKHR, pPropertyCount, pProperties);
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL mock_vkGetPhysicalDeviceCooperativeMatrixPropertiesNV(
+        VkPhysicalDevice physicalDevice, uint32_t* pPropertyCount, VkCooperativeMatrixPropertiesNV* pProperties) {
+    return copyArrayOut(
+            getProfile(physicalDevice).supportedCooperativeMatrixPropertiesNV, pPropertyCount, pProperties);
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL mock_vkGetPhysicalDeviceCooperativeMatrixFlexibleDimensionsPropertiesNV(
+        VkPhysicalDevice physicalDevice, uint32_t* pPropertyCount,
+        VkCooperativeMatrixFlexibleDimensionsPropertiesNV* pProperties) {
+    return copyArrayOut(
+            getProfile(physicalDevice).supportedCooperativeMatrixFlexibleDimensionsPropertiesNV,
+            pPropertyCount, pProperties);
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL mock_vkGetPhysicalDeviceCooperativeVectorPropertiesNV(
+        VkPhysicalDevice physicalDevice, uint32_t* pPropertyCount, VkCooperativeVectorPropertiesNV* pProperties) {
+    return copyArrayOut(
+            getProfile(physicalDevice).supportedCooperativeVectorPropertiesNV, pPropertyCount, pProperties);
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL mock_vkEnumerateDeviceExtensionProperties(
+        VkPhysicalDevice physicalDevice, const char* pLayerName, uint32_t* pPropertyCount,
+        VkExtensionProperties* pProperties) {
+    if (pLayerName) {
+        return VK_ERROR_LAYER_NOT_PRESENT;
+    }
+    return copyArrayOut(getProfile(physicalDevice).extensions, pPropertyCount, pProperties);
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL mock_vkEnumerateDeviceLayerProperties(
+        VkPhysicalDevice, uint32_t* pPropertyCount, VkLayerProperties*) {
+    *pPropertyCount = 0;
+    return VK_SUCCESS;
+}
+
+
+/*
+ * Device functions.
+ */
+
+static VKAPI_ATTR VkResult VKAPI_CALL mock_vkCreateDevice(
+        VkPhysicalDevice physicalDevice, const VkDeviceCreateInfo* pCreateInfo, const VkAllocationCallbacks*,
+        VkDevice* pDevice) {
+    MockPhysicalDevice* mockPhysicalDevice = getPhysicalDevice(physicalDevice);
+    const MockProfile& profile = mockPhysicalDevice->profile;
+    for (uint32_t i = 0; i < pCreateInfo->enabledExtensionCount; i++) {
+        if (!profile.isExtensionSupported(pCreateInfo->ppEnabledExtensionNames[i])) {
+            return VK_ERROR_EXTENSION_NOT_PRESENT;
+        }
+    }
+    auto device = std::make_unique<MockDevice>();
+    device->physicalDevice = mockPhysicalDevice;
+    device->heapUsage.resize(profile.memoryProperties.memoryHeapCount);
+    for (uint32_t i = 0; i < pCreateInfo->queueCreateInfoCount; i++) {
+        const VkDeviceQueueCreateInfo& queueCreateInfo = pCreateInfo->pQueueCreateInfos[i];
+        uint32_t familyIndex = queueCreateInfo.queueFamilyIndex;
+        if (familyIndex >= profile.queueFamilies.size()
+                || queueCreateInfo.queueCount > profile.queueFamilies.at(familyIndex).queueCount) {
+            return VK_ERROR_INITIALIZATION_FAILED;
+        }
+        for (uint32_t queueIndex = 0; queueIndex < queueCreateInfo.queueCount; queueIndex++) {
+            auto queue = std::make_unique<MockQueue>();
+            queue->device = device.get();
+            device->queues[(uint64_t(familyIndex) << 32) | queueIndex] = std::move(queue);
+        }
+    }
+    *pDevice = reinterpret_cast<VkDevice>(device.release());
+    return VK_SUCCESS;
+}
+
+static VKAPI_ATTR void VKAPI_CALL mock_vkDestroyDevice(VkDevice device, const VkAllocationCallbacks*) {
+    MockDevice* mockDevice = getDevice(device);
+    if (!mockDevice) {
+        return;
+    }
+    for (auto& entry : mockDevice->memoryAllocations) {
+        std::free(entry.second.hostPointer);
+    }
+    delete mockDevice;
+}
+
+static VKAPI_ATTR void VKAPI_CALL mock_vkGetDeviceQueue(
+        VkDevice device, uint32_t queueFamilyIndex, uint32_t queueIndex, VkQueue* pQueue) {
+    MockDevice* mockDevice = getDevice(device);
+    auto it = mockDevice->queues.find((uint64_t(queueFamilyIndex) << 32) | queueIndex);
+    *pQueue = it != mockDevice->queues.end() ? reinterpret_cast<VkQueue>(it->second.get()) : VK_NULL_HANDLE;
+}
+
+static VKAPI_ATTR void VKAPI_CALL mock_vkGetDeviceQueue2(
+        VkDevice device, const VkDeviceQueueInfo2* pQueueInfo, VkQueue* pQueue) {
+    mock_vkGetDeviceQueue(device, pQueueInfo->queueFamilyIndex, pQueueInfo->queueIndex, pQueue);
+}
+
+static void signalSemaphore(MockDevice* mockDevice, VkSemaphore semaphore, uint64_t value) {
+    std::lock_guard<std::mutex> lock(mockDevice->mutex);
+    auto it = mockDevice->semaphoreValues.find(getHandleValue(semaphore));
+    if (it != mockDevice->semaphoreValues.end()) {
+        it->second = std::max(it->second, value);
+    }
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL mock_vkQueueSubmit(
+        VkQueue queue, uint32_t submitCount, const VkSubmitInfo* pSubmits, VkFence) {
+    MockDevice* mockDevice = reinterpret_cast<MockQueue*>(queue)->device;
+    for (uint32_t i = 0; i < submitCount; i++) {
+        const auto* timelineInfo = findInChain<VkTimelineSemaphoreSubmitInfo>(
+                pSubmits[i].pNext, VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO);
+        if (!timelineInfo || !timelineInfo->pSignalSemaphoreValues) {
+            continue;
+        }
+        uint32_t count = std::min(pSubmits[i].signalSemaphoreCount, timelineInfo->signalSemaphoreValueCount);
+        for (uint32_t j = 0; j < count; j++) {
+            signalSemaphore(mockDevice, pSubmits[i].pSignalSemaphores[j], timelineInfo->pSignalSemaphoreValues[j]);
+        }
+    }
+    return VK_SUCCESS;
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL mock_vkQueueSubmit2(
+        VkQueue queue, uint32_t submitCount, const VkSubmitInfo2* pSubmits, VkFence) {
+    MockDevice* mockDevice = reinterpret_cast<MockQueue*>(queue)->device;
+    for (uint32_t i = 0; i < submitCount; i++) {
+        for (uint32_t j = 0; j < pSubmits[i].signalSemaphoreInfoCount; j++) {
+            const VkSemaphoreSubmitInfo& signalInfo = pSubmits[i].pSignalSemaphoreInfos[j];
+            signalSemaphore(mockDevice, signalInfo.semaphore, signalInfo.value);
+        }
+    }
+    return VK_SUCCESS;
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL mock_vkCreateSemaphore(
+        VkDevice device, const VkSemaphoreCreateInfo* pCreateInfo, const VkAllocationCallbacks*,
+        VkSemaphore* pSemaphore) {
+    MockDevice* mockDevice = getDevice(device);
+    const auto* typeInfo = findInChain<VkSemaphoreTypeCreateInfo>(
+            pCreateInfo->pNext, VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO);
+    *pSemaphore = createHandle<VkSemaphore>();
+    std::lock_guard<std::mutex> lock(mockDevice->mutex);
+    mockDevice->semaphoreValues[getHandleValue(*pSemaphore)] = typeInfo ? typeInfo->initialValue : 0;
+    return VK_SUCCESS;
+}
+
+static VKAPI_ATTR void VKAPI_CALL mock_vkDestroySemaphore(
+        VkDevice device, VkSemaphore semaphore, const VkAllocationCallbacks*) {
+    MockDevice* mockDevice = getDevice(device);
+    std::lock_guard<std::mutex> lock(mockDevice->mutex);
+    mockDevice->semaphoreValues.erase(getHandleValue(semaphore));
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL mock_vkGetSemaphoreCounterValue(
+        VkDevice device, VkSemaphore semaphore, uint64_t* pValue) {
+    MockDevice* mockDevice = getDevice(device);
+    std::lock_guard<std::mutex> lock(mockDevice->mutex);
+    auto it = mockDevice->semaphoreValues.find(getHandleValue(semaphore));
+    *pValue = it != mockDevice->semaphoreValues.end() ? it->second : 0;
+    return VK_SUCCESS;
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL mock_vkSignalSemaphore(
+        VkDevice device, const VkSemaphoreSignalInfo* pSignalInfo) {
+    signalSemaphore(getDevice(device), pSignalInfo->semaphore, pSignalInfo->value);
+    return VK_SUCCESS;
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL mock_vkGetFenceStatus(VkDevice, VkFence) {
+    return VK_SUCCESS;
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL mock_vkGetEventStatus(VkDevice, VkEvent) {
+    return VK_EVENT_SET;
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL mock_vkAllocateMemory(
+        VkDevice device, const VkMemoryAllocateInfo* pAllocateInfo, const VkAllocationCallbacks*,
+        VkDeviceMemory* pMemory) {
+    MockDevice* mockDevice = getDevice(device);
+    const VkPhysicalDeviceMemoryProperties& memoryProperties = mockDevice->physicalDevice->profile.memoryProperties;
+    if (pAllocateInfo->memoryTypeIndex >= memoryProperties.memoryTypeCount) {
+        return VK_ERROR_OUT_OF_DEVICE_MEMORY;
+    }
+    MockMemory memory;
+    memory.size = pAllocateInfo->allocationSize;
+    memory.heapIndex = memoryProperties.memoryTypes[pAllocateInfo->memoryTypeIndex].heapIndex;
+    std::lock_guard<std::mutex> lock(mockDevice->mutex);
+    if (mockDevice->heapUsage.at(memory.heapIndex) + memory.size
+            > memoryProperties.memoryHeaps[memory.heapIndex].size) {
+        return VK_ERROR_OUT_OF_DEVICE_MEMORY;
+    }
+    // Untouched pages of the host allocation are never committed, so large device-local heaps can be replayed.
+    size_t allocationSize = size_t(
+            (std::max(memory.size, VkDeviceSize(1)) + MOCK_HOST_ALLOCATION_ALIGNMENT - 1)
+            / MOCK_HOST_ALLOCATION_ALIGNMENT * MOCK_HOST_ALLOCATION_ALIGNMENT);
+    memory.hostPointer = std::aligned_alloc(MOCK_HOST_ALLOCATION_ALIGNMENT, allocationSize);
+    if (!memory.hostPointer) {
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+    }
+    mockDevice->heapUsage.at(memory.heapIndex) += memory.size;
+    *pMemory = createHandle<VkDeviceMemory>();
+    mockDevice->memoryAllocations[getHandleValue(*pMemory)] = memory;
+    return VK_SUCCESS;
+}
+
+static VKAPI_ATTR void VKAPI_CALL mock_vkFreeMemory(
+        VkDevice device, VkDeviceMemory memory, const VkAllocationCallbacks*) {
+    MockDevice* mockDevice = getDevice(device);
+    std::lock_guard<std::mutex> lock(mockDevice->mutex);
+    auto it = mockDevice->memoryAllocations.find(getHandleValue(memory));
+    if (it == mockDevice->memoryAllocations.end()) {
+        return;
+    }
+    mockDevice->heapUsage.at(it->second.heapIndex) -= it->second.size;
+    std::free(it->second.hostPointer);
+    mockDevice->memoryAllocations.erase(it);
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL mock_vkMapMemory(
+        VkDevice device, VkDeviceMemory memory, VkDeviceSize offset, VkDeviceSize, VkMemoryMapFlags,
+        void** ppData) {
+    MockDevice* mockDevice = getDevice(device);
+    std::lock_guard<std::mutex> lock(mockDevice->mutex);
+    auto it = mockDevice->memoryAllocations.find(getHandleValue(memory));
+    if (it == mockDevice->memoryAllocations.end()) {
+        return VK_ERROR_MEMORY_MAP_FAILED;
+    }
+    *ppData = static_cast<uint8_t*>(it->second.hostPointer) + offset;
+    return VK_SUCCESS;
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL mock_vkCreateBuffer(
+        VkDevice device, const VkBufferCreateInfo* pCreateInfo, const VkAllocationCallbacks*, VkBuffer* pBuffer) {
+    MockDevice* mockDevice = getDevice(device);
+    *pBuffer = createHandle<VkBuffer>();
+    std::lock_guard<std::mutex> lock(mockDevice->mutex);
+    mockDevice->buffers[getHandleValue(*pBuffer)].size = pCreateInfo->size;
+    return VK_SUCCESS;
+}
+
+static VKAPI_ATTR void VKAPI_CALL mock_vkDestroyBuffer(VkDevice device, VkBuffer buffer, const VkAllocationCallbacks*) {
+    MockDevice* mockDevice = getDevice(device);
+    std::lock_guard<std::mutex> lock(mockDevice->mutex);
+    mockDevice->buffers.erase(getHandleValue(buffer));
+}
+
+static VkMemoryRequirements getMemoryRequirements(MockDevice* mockDevice, VkDeviceSize size) {
+    uint32_t memoryTypeCount = mockDevice->physicalDevice->profile.memoryProperties.memoryTypeCount;
+    VkMemoryRequirements memoryRequirements{};
+    memoryRequirements.size = (size + MOCK_BUFFER_ALIGNMENT - 1) / MOCK_BUFFER_ALIGNMENT * MOCK_BUFFER_ALIGNMENT;
+    memoryRequirements.alignment = MOCK_BUFFER_ALIGNMENT;
+    memoryRequirements.memoryTypeBits = memoryTypeCount >= 32 ? ~0u : (1u << memoryTypeCount) - 1u;
+    return memoryRequirements;
+}
+
+static void fillMemoryRequirements2(
+        MockDevice* mockDevice, VkDeviceSize size, VkMemoryRequirements2* pMemoryRequirements) {
+    pMemoryRequirements->memoryRequirements = getMemoryRequirements(mockDevice, size);
+    auto* dedicatedRequirements = const_cast<VkMemoryDedicatedRequirements*>(
+            findInChain<VkMemoryDedicatedRequirements>(
+                    pMemoryRequirements->pNext, VK_STRUCTURE_TYPE_MEMORY_DEDICATED_REQUIREMENTS));
+    if (dedicatedRequirements) {
+        dedicatedRequirements->prefersDedicatedAllocation = VK_FALSE;
+        dedicatedRequirements->requiresDedicatedAllocation = VK_FALSE;
+    }
+}
+
+static VkDeviceSize getBufferSize(MockDevice* mockDevice, VkBuffer buffer) {
+    std::lock_guard<std::mutex> lock(mockDevice->mutex);
+    auto it = mockDevice->buffers.find(getHandleValue(buffer));
+    return it != mockDevice->buffers.end() ? it->second.size : 0;
+}
+
+static VKAPI_ATTR void VKAPI_CALL mock_vkGetBufferMemoryRequirements(
+        VkDevice device, VkBuffer buffer, VkMemoryRequirements* pMemoryRequirements) {
+    MockDevice* mockDevice = getDevice(device);
+    *pMemoryRequirements = getMemoryRequirements(mockDevice, getBufferSize(mockDevice, buffer));
+}
+
+static VKAPI_ATTR void VKAPI_CALL mock_vkGetBufferMemoryRequirements2(
+        VkDevice device, const VkBufferMemoryRequirementsInfo2* pInfo, VkMemoryRequirements2* pMemoryRequirements) {
+    MockDevice* mockDevice = getDevice(device);
+    fillMemoryRequirements2(mockDevice, getBufferSize(mockDevice, pInfo->buffer), pMemoryRequirements);
+}
+
+static VKAPI_ATTR void VKAPI_CALL mock_vkGetDeviceBufferMemoryRequirements(
+        VkDevice device, const VkDeviceBufferMemoryRequirements* pInfo, VkMemoryRequirements2* pMemoryRequirements) {
+    fillMemoryRequirements2(getDevice(device), pInfo->pCreateInfo->size, pMemoryRequirements);
+}
+
+static void bindBufferMemory(MockDevice* mockDevice, VkBuffer buffer, VkDeviceMemory memory, VkDeviceSize offset) {
+    std::lock_guard<std::mutex> lock(mockDevice->mutex);
+    MockBuffer& mockBuffer = mockDevice->buffers[getHandleValue(buffer)];
+    mockBuffer.memory = memory;
+    mockBuffer.memoryOffset = offset;
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL mock_vkBindBufferMemory(
+        VkDevice device, VkBuffer buffer, VkDeviceMemory memory, VkDeviceSize memoryOffset) {
+    bindBufferMemory(getDevice(device), buffer, memory, memoryOffset);
+    return VK_SUCCESS;
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL mock_vkBindBufferMemory2(
+        VkDevice device, uint32_t bindInfoCount, const VkBindBufferMemoryInfo* pBindInfos) {
+    for (uint32_t i = 0; i < bindInfoCount; i++) {
+        bindBufferMemory(getDevice(device), pBindInfos[i].buffer, pBindInfos[i].memory, pBindInfos[i].memoryOffset);
+    }
+    return VK_SUCCESS;
+}
+
+/// Buffer device addresses are the host addresses of the bound memory.
+static VKAPI_ATTR VkDeviceAddress VKAPI_CALL mock_vkGetBufferDeviceAddress(
+        VkDevice device, const VkBufferDeviceAddressInfo* pInfo) {
+    MockDevice* mockDevice = getDevice(device);
+    std::lock_guard<std::mutex> lock(mockDevice->mutex);
+    auto bufferIt = mockDevice->buffers.find(getHandleValue(pInfo->buffer));
+    if (bufferIt == mockDevice->buffers.end()) {
+        return 0;
+    }
+    auto memoryIt = mockDevice->memoryAllocations.find(getHandleValue(bufferIt->second.memory));
+    if (memoryIt == mockDevice->memoryAllocations.end()) {
+        return 0;
+    }
+    return VkDeviceAddress(reinterpret_cast<uintptr_t>(memoryIt->second.hostPointer)) + bufferIt->second.memoryOffset;
+}
+
+static VKAPI_ATTR uint64_t VKAPI_CALL mock_vkGetBufferOpaqueCaptureAddress(
+        VkDevice, const VkBufferDeviceAddressInfo*) {
+    return 0;
+}
+
+static VKAPI_ATTR uint64_t VKAPI_CALL mock_vkGetDeviceMemoryOpaqueCaptureAddress(
+        VkDevice, const VkDeviceMemoryOpaqueCaptureAddressInfo*) {
+    return 0;
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL mock_vkCreateImage(
+        VkDevice device, const VkImageCreateInfo* pCreateInfo, const VkAllocationCallbacks*, VkImage* pImage) {
+    MockDevice* mockDevice = getDevice(device);
+    // Upper bound of the texel size of all formats; the image contents are never accessed.
+    const VkExtent3D& extent = pCreateInfo->extent;
+    VkDeviceSize size = VkDeviceSize(extent.width) * extent.height * extent.depth * pCreateInfo->arrayLayers * 16;
+    *pImage = createHandle<VkImage>();
+    std::lock_guard<std::mutex> lock(mockDevice->mutex);
+    mockDevice->imageSizes[getHandleValue(*pImage)] = size;
+    return VK_SUCCESS;
+}
+
+static VKAPI_ATTR void VKAPI_CALL mock_vkDestroyImage(VkDevice device, VkImage image, const VkAllocationCallbacks*) {
+    MockDevice* mockDevice = getDevice(device);
+    std::lock_guard<std::mutex> lock(mockDevice->mutex);
+    mockDevice->imageSizes.erase(getHandleValue(image));
+}
+
+static VkDeviceSize getImageSize(MockDevice* mockDevice, VkImage image) {
+    std::lock_guard<std::mutex> lock(mockDevice->mutex);
+    auto it = mockDevice->imageSizes.find(getHandleValue(image));
+    return it != mockDevice->imageSizes.end() ? it->second : 0;
+}
+
+static VKAPI_ATTR void VKAPI_CALL mock_vkGetImageMemoryRequirements(
+        VkDevice device, VkImage image, VkMemoryRequirements* pMemoryRequirements) {
+    MockDevice* mockDevice = getDevice(device);
+    *pMemoryRequirements = getMemoryRequirements(mockDevice, getImageSize(mockDevice, image));
+}
+
+static VKAPI_ATTR void VKAPI_CALL mock_vkGetImageMemoryRequirements2(
+        VkDevice device, const VkImageMemoryRequirementsInfo2* pInfo, VkMemoryRequirements2* pMemoryRequirements) {
+    MockDevice* mockDevice = getDevice(device);
+    fillMemoryRequirements2(mockDevice, getImageSize(mockDevice, pInfo->image), pMemoryRequirements);
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL mock_vkAllocateCommandBuffers(
+        VkDevice device, const VkCommandBufferAllocateInfo* pAllocateInfo, VkCommandBuffer* pCommandBuffers) {
+    MockDevice* mockDevice = getDevice(device);
+    std::lock_guard<std::mutex> lock(mockDevice->mutex);
+    auto& commandBuffers = mockDevice->commandPools[getHandleValue(pAllocateInfo->commandPool)];
+    for (uint32_t i = 0; i < pAllocateInfo->commandBufferCount; i++) {
+        commandBuffers.push_back(std::make_unique<MockCommandBuffer>());
+        pCommandBuffers[i] = reinterpret_cast<VkCommandBuffer>(commandBuffers.back().get());
+    }
+    return VK_SUCCESS;
+}
+
+static VKAPI_ATTR void VKAPI_CALL mock_vkFreeCommandBuffers(
+        VkDevice device, VkCommandPool commandPool, uint32_t commandBufferCount,
+        const VkCommandBuffer* pCommandBuffers) {
+    MockDevice* mockDevice = getDevice(device);
+    std::lock_guard<std::mutex> lock(mockDevice->mutex);
+    auto& commandBuffers = mockDevice->commandPools[getHandleValue(commandPool)];
+    for (uint32_t i = 0; i < commandBufferCount; i++) {
+        auto* commandBuffer = reinterpret_cast<MockCommandBuffer*>(pCommandBuffers[i]);
+        commandBuffers.erase(
+                std::remove_if(commandBuffers.begin(), commandBuffers.end(), [commandBuffer](const auto& entry) {
+                    return entry.get() == commandBuffer;
+                }), commandBuffers.end());
+    }
+}
+
+static VKAPI_ATTR void VKAPI_CALL mock_vkDestroyCommandPool(
+        VkDevice device, VkCommandPool commandPool, const VkAllocationCallbacks*) {
+    MockDevice* mockDevice = getDevice(device);
+    std::lock_guard<std::mutex> lock(mockDevice->mutex);
+    mockDevice->commandPools.erase(getHandleValue(commandPool));
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL mock_vkCreateQueryPool(
+        VkDevice device, const VkQueryPoolCreateInfo* pCreateInfo, const VkAllocationCallbacks*,
+        VkQueryPool* pQueryPool) {
+    MockDevice* mockDevice = getDevice(device);
+    *pQueryPool = createHandle<VkQueryPool>();
+    std::lock_guard<std::mutex> lock(mockDevice->mutex);
+    MockQueryPool& queryPool = mockDevice->queryPools[getHandleValue(*pQueryPool)];
+    queryPool.queryType = pCreateInfo->queryType;
+    queryPool.queryCount = pCreateInfo->queryCount;
+    return VK_SUCCESS;
+}
+
+static VKAPI_ATTR void VKAPI_CALL mock_vkDestroyQueryPool(
+        VkDevice device, VkQueryPool queryPool, const VkAllocationCallbacks*) {
+    MockDevice* mockDevice = getDevice(device);
+    std::lock_guard<std::mutex> lock(mockDevice->mutex);
+    mockDevice->queryPools.erase(getHandleValue(queryPool));
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL mock_vkGetQueryPoolResults(
+        VkDevice device, VkQueryPool queryPool, uint32_t firstQuery, uint32_t queryCount, size_t dataSize,
+        void* pData, VkDeviceSize stride, VkQueryResultFlags flags) {
+    MockDevice* mockDevice = getDevice(device);
+    VkQueryType queryType = VK_QUERY_TYPE_TIMESTAMP;
+    {
+        std::lock_guard<std::mutex> lock(mockDevice->mutex);
+        auto it = mockDevice->queryPools.find(getHandleValue(queryPool));
+        if (it != mockDevice->queryPools.end()) {
+            queryType = it->second.queryType;
+        }
+    }
+    const bool is64Bit = (flags & VK_QUERY_RESULT_64_BIT) != 0;
+    const bool hasAvailability = (flags & VK_QUERY_RESULT_WITH_AVAILABILITY_BIT) != 0;
+    const size_t valueSize = is64Bit ? sizeof(uint64_t) : sizeof(uint32_t);
+    auto* data = static_cast<uint8_t*>(pData);
+    for (uint32_t i = 0; i < queryCount; i++) {
+        size_t offset = size_t(stride) * i;
+        if (offset + valueSize * (hasAvailability ? 2 : 1) > dataSize) {
+            break;
+        }
+        uint64_t value = 0;
+        if (queryType == VK_QUERY_TYPE_TIMESTAMP) {
+            value = uint64_t(firstQuery + i) * MOCK_TICKS_PER_TIMESTAMP_QUERY;
+        }
+        uint64_t values[2] = { value, 1 };
+        for (int j = 0; j < (hasAvailability ? 2 : 1); j++) {
+            if (is64Bit) {
+                std::memcpy(data + offset + j * valueSize, &values[j], valueSize);
+            } else {
+                auto value32 = uint32_t(values[j]);
+                std::memcpy(data + offset + j * valueSize, &value32, valueSize);
+            }
+        }
+    }
+    return VK_SUCCESS;
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL mock_vkAllocateDescriptorSets(
+        VkDevice, const VkDescriptorSetAllocateInfo* pAllocateInfo, VkDescriptorSet* pDescriptorSets) {
+    for (uint32_t i = 0; i < pAllocateInfo->descriptorSetCount; i++) {
+        pDescriptorSets[i] = createHandle<VkDescriptorSet>();
+    }
+    return VK_SUCCESS;
+}
+
+static VKAPI_ATTR void VKAPI_CALL mock_vkGetDescriptorSetLayoutSupport(
+        VkDevice, const VkDescriptorSetLayoutCreateInfo*, VkDescriptorSetLayoutSupport* pSupport) {
+    pSupport->supported = VK_TRUE;
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL mock_vkCreateComputePipelines(
+        VkDevice, VkPipelineCache, uint32_t createInfoCount, const VkComputePipelineCreateInfo*,
+        const VkAllocationCallbacks*, VkPipeline* pPipelines) {
+    for (uint32_t i = 0; i < createInfoCount; i++) {
+        pPipelines[i] = createHandle<VkPipeline>();
+    }
+    return VK_SUCCESS;
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL mock_vkCreateGraphicsPipelines(
+        VkDevice, VkPipelineCache, uint32_t createInfoCount, const VkGraphicsPipelineCreateInfo*,
+        const VkAllocationCallbacks*, VkPipeline* pPipelines) {
+    for (uint32_t i = 0; i < createInfoCount; i++) {
+        pPipelines[i] = createHandle<VkPipeline>();
+    }
+    return VK_SUCCESS;
+}
+
+/// Only the header, so that caches written under the mock driver are valid for the profiled device.
+static VKAPI_ATTR VkResult VKAPI_CALL mock_vkGetPipelineCacheData(
+        VkDevice device, VkPipelineCache, size_t* pDataSize, void* pData) {
+    const VkPhysicalDeviceProperties& properties = getDevice(device)->physicalDevice->profile.properties;
+    VkPipelineCacheHeaderVersionOne header{};
+    header.headerSize = uint32_t(sizeof(VkPipelineCacheHeaderVersionOne));
+    header.headerVersion = VK_PIPELINE_CACHE_HEADER_VERSION_ONE;
+    header.vendorID = properties.vendorID;
+    header.deviceID = properties.deviceID;
+    std::memcpy(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE);
+    if (!pData) {
+        *pDataSize = sizeof(header);
+        return VK_SUCCESS;
+    }
+    if (*pDataSize < sizeof(header)) {
+        *pDataSize = 0;
+        return VK_INCOMPLETE;
+    }
+    std::memcpy(pData, &header, sizeof(header));
+    *pDataSize = sizeof(header);
+    return VK_SUCCESS;
+}
+
+static size_t getComponentTypeSize(VkComponentTypeKHR componentType) {
+    switch (componentType) {
+        case VK_COMPONENT_TYPE_SINT8_KHR:
+        case VK_COMPONENT_TYPE_UINT8_KHR:
+        case VK_COMPONENT_TYPE_FLOAT_E4M3_NV:
+        case VK_COMPONENT_TYPE_FLOAT_E5M2_NV:
+            return 1;
+        case VK_COMPONENT_TYPE_FLOAT16_KHR:
+        case VK_COMPONENT_TYPE_BFLOAT16_KHR:
+        case VK_COMPONENT_TYPE_SINT16_KHR:
+        case VK_COMPONENT_TYPE_UINT16_KHR:
+            return 2;
+        case VK_COMPONENT_TYPE_FLOAT64_KHR:
+        case VK_COMPONENT_TYPE_SINT64_KHR:
+        case VK_COMPONENT_TYPE_UINT64_KHR:
+            return 8;
+        default:
+            return 4;
+    }
+}
+
+/// Optimal layouts are dense with rows padded to 64 bytes; the converted data is zero unless no conversion is needed.
+static VKAPI_ATTR VkResult VKAPI_CALL mock_vkConvertCooperativeVectorMatrixNV(
+        VkDevice, const VkConvertCooperativeVectorMatrixInfoNV* pInfo) {
+    size_t dstSize;
+    if (pInfo->dstLayout == VK_COOPERATIVE_VECTOR_MATRIX_LAYOUT_ROW_MAJOR_NV) {
+        dstSize = size_t(pInfo->numRows) * pInfo->dstStride;
+    } else if (pInfo->dstLayout == VK_COOPERATIVE_VECTOR_MATRIX_LAYOUT_COLUMN_MAJOR_NV) {
+        dstSize = size_t(pInfo->numColumns) * pInfo->dstStride;
+    } else {
+        size_t rowSize = size_t(pInfo->numColumns) * getComponentTypeSize(pInfo->dstComponentType);
+        dstSize = size_t(pInfo->numRows) * ((rowSize + 63) / 64 * 64);
+    }
+    if (!pInfo->dstData.hostAddress) {
+        *pInfo->pDstSize = dstSize;
+        return VK_SUCCESS;
+    }
+    if (*pInfo->pDstSize < dstSize) {
+        return VK_INCOMPLETE;
+    }
+    const bool isCopy = pInfo->srcLayout == pInfo->dstLayout && pInfo->srcStride == pInfo->dstStride
+            && pInfo->srcComponentType == pInfo->dstComponentType && pInfo->srcSize >= dstSize;
+    if (isCopy && pInfo->srcData.hostAddress) {
+        std::memcpy(pInfo->dstData.hostAddress, pInfo->srcData.hostAddress, dstSize);
+    } else {
+        std::memset(pInfo->dstData.hostAddress, 0, dstSize);
+    }
+    *pInfo->pDstSize = dstSize;
+    return VK_SUCCESS;
+}
+
+static uint64_t getClockNs(clockid_t clockId) {
+    timespec time{};
+    clock_gettime(clockId, &time);
+    return uint64_t(time.tv_sec) * 1000000000ull + uint64_t(time.tv_nsec);
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL mock_vkGetCalibratedTimestampsKHR(
+        VkDevice device, uint32_t timestampCount, const VkCalibratedTimestampInfoKHR* pTimestampInfos,
+        uint64_t* pTimestamps, uint64_t* pMaxDeviation) {
+    double timestampPeriod = double(getDevice(device)->physicalDevice->profile.properties.limits.timestampPeriod);
+    for (uint32_t i = 0; i < timestampCount; i++) {
+        switch (pTimestampInfos[i].timeDomain) {
+            case VK_TIME_DOMAIN_DEVICE_KHR:
+                pTimestamps[i] = uint64_t(double(getClockNs(CLOCK_MONOTONIC)) / std::max(timestampPeriod, 1e-6));
+                break;
+            case VK_TIME_DOMAIN_CLOCK_MONOTONIC_RAW_KHR:
+                pTimestamps[i] = getClockNs(CLOCK_MONOTONIC_RAW);
+                break;
+            default:
+                pTimestamps[i] = getClockNs(CLOCK_MONOTONIC);
+                break;
+        }
+    }
+    *pMaxDeviation = 1;
+    return VK_SUCCESS;
+}
+
+static VKAPI_ATTR void VKAPI_CALL mock_vkGetDeviceGroupPeerMemoryFeatures(
+        VkDevice, uint32_t, uint32_t, uint32_t, VkPeerMemoryFeatureFlags* pPeerMemoryFeatures) {
+    *pPeerMemoryFeatures = 0;
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL mock_vkGetMemoryFdKHR(VkDevice, const VkMemoryGetFdInfoKHR*, int*) {
+    return VK_ERROR_TOO_MANY_OBJECTS;
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL mock_vkGetMemoryFdPropertiesKHR(
+        VkDevice, VkExternalMemoryHandleTypeFlagBits, int, VkMemoryFdPropertiesKHR*) {
+    return VK_ERROR_INVALID_EXTERNAL_HANDLE;
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL mock_vkGetMemoryHostPointerPropertiesEXT(
+        VkDevice, VkExternalMemoryHandleTypeFlagBits, const void*, VkMemoryHostPointerPropertiesEXT*) {
+    return VK_ERROR_INVALID_EXTERNAL_HANDLE;
+}
+
+
+/*
+ * Entry point tables.
+ */
+
+/// Functions that only need to return VK_SUCCESS (if they return a VkResult at all).
+template<class PFN>
+struct MockNoOp;
+template<class... Args>
+struct MockNoOp<void (VKAPI_PTR*)(Args...)> {
+    static VKAPI_ATTR void VKAPI_CALL call(Args...) {}
+};
+template<class... Args>
+struct MockNoOp<VkResult (VKAPI_PTR*)(Args...)> {
+    static VKAPI_ATTR VkResult VKAPI_CALL call(Args...) { return VK_SUCCESS; }
+};
+
+/// vkCreate* functions of objects without state in the mock driver.
+template<class PFN>
+struct MockCreate;
+template<class Parent, class CreateInfo, class Handle>
+struct MockCreate<VkResult (VKAPI_PTR*)(Parent, const CreateInfo*, const VkAllocationCallbacks*, Handle*)> {
+    static VKAPI_ATTR VkResult VKAPI_CALL call(
+            Parent, const CreateInfo*, const VkAllocationCallbacks*, Handle* pHandle) {
+        *pHandle = createHandle<Handle>();
+        return VK_SUCCESS;
+    }
+};
+
+enum class MockFunctionLevel {
+    GLOBAL, INSTANCE, PHYSICAL_DEVICE, DEVICE
+};
+
+struct MockFunction {
+    MockFunctionLevel level;
+    PFN_vkVoidFunction function;
+};
+
+#define MOCK_FUNCTION(level, name, function) \
+    { #name, { MockFunctionLevel::level, reinterpret_cast<PFN_vkVoidFunction>(function) } }
+#define MOCK_IMPLEMENTED(level, name) MOCK_FUNCTION(level, name, &mock_##name)
+#define MOCK_ALIAS(level, name, implementation) MOCK_FUNCTION(level, name, &mock_##implementation)
+#define MOCK_NOOP(name) MOCK_FUNCTION(DEVICE, name, &MockNoOp<PFN_##name>::call)
+#define MOCK_CREATE(name) MOCK_FUNCTION(DEVICE, name, &MockCreate<PFN_##name>::call)
+
+static VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL mock_vkGetDeviceProcAddr(VkDevice device, const char* pName);
+static VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL mock_vkGetInstanceProcAddr(VkInstance instance, const char* pName);
+
+static const std::unordered_map<std::string, MockFunction>& getMockFunctions() {
+    static const std::unordered_map<std::string, MockFunction> functions = {
+            MOCK_IMPLEMENTED(GLOBAL, vkEnumerateInstanceExtensionProperties),
+            MOCK_IMPLEMENTED(GLOBAL, vkEnumerateInstanceVersion),
+            MOCK_IMPLEMENTED(GLOBAL, vkCreateInstance),
+            MOCK_IMPLEMENTED(INSTANCE, vkGetInstanceProcAddr),
+            MOCK_IMPLEMENTED(INSTANCE, vkDestroyInstance),
+            MOCK_IMPLEMENTED(INSTANCE, vkEnumeratePhysicalDevices),
+            MOCK_IMPLEMENTED(INSTANCE, vkEnumeratePhysicalDeviceGroups),
+            MOCK_ALIAS(INSTANCE, vkEnumeratePhysicalDeviceGroupsKHR, vkEnumeratePhysicalDeviceGroups),
+
+            MOCK_IMPLEMENTED(PHYSICAL_DEVICE, vkGetPhysicalDeviceProperties),
+            MOCK_IMPLEMENTED(PHYSICAL_DEVICE, vkGetPhysicalDeviceProperties2),
+            MOCK_ALIAS(PHYSICAL_DEVICE, vkGetPhysicalDeviceProperties2KHR, vkGetPhysicalDeviceProperties2),
+            MOCK_IMPLEMENTED(PHYSICAL_DEVICE, vkGetPhysicalDeviceFeatures),
+            MOCK_IMPLEMENTED(PHYSICAL_DEVICE, vkGetPhysicalDeviceFeatures2),
+            MOCK_ALIAS(PHYSICAL_DEVICE, vkGetPhysicalDeviceFeatures2KHR, vkGetPhysicalDeviceFeatures2),
+            MOCK_IMPLEMENTED(PHYSICAL_DEVICE, vkGetPhysicalDeviceQueueFamilyProperties),
+            MOCK_IMPLEMENTED(PHYSICAL_DEVICE, vkGetPhysicalDeviceQueueFamilyProperties2),
+            MOCK_ALIAS(
+                    PHYSICAL_DEVICE, vkGetPhysicalDeviceQueueFamilyProperties2KHR,
+                    vkGetPhysicalDeviceQueueFamilyProperties2),
+            MOCK_IMPLEMENTED(PHYSICAL_DEVICE, vkGetPhysicalDeviceMemoryProperties),
+            MOCK_IMPLEMENTED(PHYSICAL_DEVICE, vkGetPhysicalDeviceMemoryProperties2),
+            MOCK_ALIAS(PHYSICAL_DEVICE, vkGetPhysicalDeviceMemoryProperties2KHR, vkGetPhysicalDeviceMemoryProperties2),
+            MOCK_IMPLEMENTED(PHYSICAL_DEVICE, vkGetPhysicalDeviceFormatProperties),
+            MOCK_IMPLEMENTED(PHYSICAL_DEVICE, vkGetPhysicalDeviceFormatProperties2),
+            MOCK_ALIAS(PHYSICAL_DEVICE, vkGetPhysicalDeviceFormatProperties2KHR, vkGetPhysicalDeviceFormatProperties2),
+            MOCK_IMPLEMENTED(PHYSICAL_DEVICE, vkGetPhysicalDeviceImageFormatProperties),
+            MOCK_IMPLEMENTED(PHYSICAL_DEVICE, vkGetPhysicalDeviceImageFormatProperties2),
+            MOCK_ALIAS(
+                    PHYSICAL_DEVICE, vkGetPhysicalDeviceImageFormatProperties2KHR,
+                    vkGetPhysicalDeviceImageFormatProperties2),
+            MOCK_IMPLEMENTED(PHYSICAL_DEVICE, vkGetPhysicalDeviceSparseImageFormatProperties),
+            MOCK_IMPLEMENTED(PHYSICAL_DEVICE, vkGetPhysicalDeviceSparseImageFormatProperties2),
+            MOCK_IMPLEMENTED(PHYSICAL_DEVICE, vkGetPhysicalDeviceExternalBufferProperties),
+            MOCK_ALIAS(
+                    PHYSICAL_DEVICE, vkGetPhysicalDeviceExternalBufferPropertiesKHR,
+                    vkGetPhysicalDeviceExternalBufferProperties),
+            MOCK_IMPLEMENTED(PHYSICAL_DEVICE, vkGetPhysicalDeviceExternalSemaphoreProperties),
+            MOCK_IMPLEMENTED(PHYSICAL_DEVICE, vkGetPhysicalDeviceExternalFenceProperties),
+            MOCK_IMPLEMENTED(PHYSICAL_DEVICE, vkGetPhysicalDeviceToolProperties),
+            MOCK_IMPLEMENTED(PHYSICAL_DEVICE, vkGetPhysicalDeviceCalibrateableTimeDomainsKHR),
+            MOCK_ALIAS(
+                    PHYSICAL_DEVICE, vkGetPhysicalDeviceCalibrateableTimeDomainsEXT,
+                    vkGetPhysicalDeviceCalibrateableTimeDomainsKHR),
+            MOCK_IMPLEMENTED(PHYSICAL_DEVICE, vkGetPhysicalDeviceCooperativeMatrixPropertiesKHR),
+            MOCK_IMPLEMENTED(PHYSICAL_DEVICE, vkGetPhysicalDeviceCooperativeMatrixPropertiesNV),
+            MOCK_IMPLEMENTED(PHYSICAL_DEVICE, vkGetPhysicalDeviceCooperativeMatrixFlexibleDimensionsPropertiesNV),
+            MOCK_IMPLEMENTED(PHYSICAL_DEVICE, vkGetPhysicalDeviceCooperativeVectorPropertiesNV),
+            MOCK_IMPLEMENTED(PHYSICAL_DEVICE, vkEnumerateDeviceExtensionProperties),
+            MOCK_IMPLEMENTED(PHYSICAL_DEVICE, vkEnumerateDeviceLayerProperties),
+            MOCK_IMPLEMENTED(PHYSICAL_DEVICE, vkCreateDevice),
+
+            MOCK_IMPLEMENTED(DEVICE, vkGetDeviceProcAddr),
+            MOCK_IMPLEMENTED(DEVICE, vkDestroyDevice),
+            MOCK_IMPLEMENTED(DEVICE, vkGetDeviceQueue),
+            MOCK_IMPLEMENTED(DEVICE, vkGetDeviceQueue2),
+            MOCK_NOOP(vkDeviceWaitIdle),
+            MOCK_NOOP(vkQueueWaitIdle),
+            MOCK_IMPLEMENTED(DEVICE, vkQueueSubmit),
+            MOCK_IMPLEMENTED(DEVICE, vkQueueSubmit2),
+            MOCK_ALIAS(DEVICE, vkQueueSubmit2KHR, vkQueueSubmit2),
+
+            MOCK_IMPLEMENTED(DEVICE, vkAllocateMemory),
+            MOCK_IMPLEMENTED(DEVICE, vkFreeMemory),
+            MOCK_IMPLEMENTED(DEVICE, vkMapMemory),
+            MOCK_NOOP(vkUnmapMemory),
+            MOCK_NOOP(vkFlushMappedMemoryRanges),
+            MOCK_NOOP(vkInvalidateMappedMemoryRanges),
+            MOCK_IMPLEMENTED(DEVICE, vkCreateBuffer),
+            MOCK_IMPLEMENTED(DEVICE, vkDestroyBuffer),
+            MOCK_IMPLEMENTED(DEVICE, vkGetBufferMemoryRequirements),
+            MOCK_IMPLEMENTED(DEVICE, vkGetBufferMemoryRequirements2),
+            MOCK_ALIAS(DEVICE, vkGetBufferMemoryRequirements2KHR, vkGetBufferMemoryRequirements2),
+            MOCK_IMPLEMENTED(DEVICE, vkGetDeviceBufferMemoryRequirements),
+            MOCK_ALIAS(DEVICE, vkGetDeviceBufferMemoryRequirementsKHR, vkGetDeviceBufferMemoryRequirements),
+            MOCK_IMPLEMENTED(DEVICE, vkBindBufferMemory),
+            MOCK_IMPLEMENTED(DEVICE, vkBindBufferMemory2),
+            MOCK_ALIAS(DEVICE, vkBindBufferMemory2KHR, vkBindBufferMemory2),
+            MOCK_IMPLEMENTED(DEVICE, vkGetBufferDeviceAddress),
+            MOCK_ALIAS(DEVICE, vkGetBufferDeviceAddressKHR, vkGetBufferDeviceAddress),
+            MOCK_ALIAS(DEVICE, vkGetBufferDeviceAddressEXT, vkGetBufferDeviceAddress),
+            MOCK_IMPLEMENTED(DEVICE, vkGetBufferOpaqueCaptureAddress),
+            MOCK_IMPLEMENTED(DEVICE, vkGetDeviceMemoryOpaqueCaptureAddress),
+            MOCK_CREATE(vkCreateBufferView),
+            MOCK_NOOP(vkDestroyBufferView),
+            MOCK_IMPLEMENTED(DEVICE, vkCreateImage),
+            MOCK_IMPLEMENTED(DEVICE, vkDestroyImage),
+            MOCK_IMPLEMENTED(DEVICE, vkGetImageMemoryRequirements),
+            MOCK_IMPLEMENTED(DEVICE, vkGetImageMemoryRequirements2),
+            MOCK_ALIAS(DEVICE, vkGetImageMemoryRequirements2KHR, vkGetImageMemoryRequirements2),
+            MOCK_NOOP(vkBindImageMemory),
+            MOCK_NOOP(vkBindImageMemory2),
+            MOCK_NOOP(vkGetImageSubresourceLayout),
+            MOCK_CREATE(vkCreateImageView),
+            MOCK_NOOP(vkDestroyImageView),
+            MOCK_CREATE(vkCreateSampler),
+            MOCK_NOOP(vkDestroySampler),
+            MOCK_IMPLEMENTED(DEVICE, vkGetMemoryFdKHR),
+            MOCK_IMPLEMENTED(DEVICE, vkGetMemoryFdPropertiesKHR),
+            MOCK_IMPLEMENTED(DEVICE, vkGetMemoryHostPointerPropertiesEXT),
+            MOCK_IMPLEMENTED(DEVICE, vkGetDeviceGroupPeerMemoryFeatures),
+            MOCK_ALIAS(DEVICE, vkGetDeviceGroupPeerMemoryFeaturesKHR, vkGetDeviceGroupPeerMemoryFeatures),
+
+            MOCK_CREATE(vkCreateFence),
+            MOCK_NOOP(vkDestroyFence),
+            MOCK_NOOP(vkResetFences),
+            MOCK_IMPLEMENTED(DEVICE, vkGetFenceStatus),
+            MOCK_NOOP(vkWaitForFences),
+            MOCK_IMPLEMENTED(DEVICE, vkCreateSemaphore),
+            MOCK_IMPLEMENTED(DEVICE, vkDestroySemaphore),
+            MOCK_IMPLEMENTED(DEVICE, vkGetSemaphoreCounterValue),
+            MOCK_ALIAS(DEVICE, vkGetSemaphoreCounterValueKHR, vkGetSemaphoreCounterValue),
+            MOCK_NOOP(vkWaitSemaphores),
+            MOCK_FUNCTION(DEVICE, vkWaitSemaphoresKHR, &MockNoOp<PFN_vkWaitSemaphores>::call),
+            MOCK_IMPLEMENTED(DEVICE, vkSignalSemaphore),
+            MOCK_ALIAS(DEVICE, vkSignalSemaphoreKHR, vkSignalSemaphore),
+            MOCK_CREATE(vkCreateEvent),
+            MOCK_NOOP(vkDestroyEvent),
+            MOCK_IMPLEMENTED(DEVICE, vkGetEventStatus),
+            MOCK_NOOP(vkSetEvent),
+            MOCK_NOOP(vkResetEvent),
+
+            MOCK_CREATE(vkCreateCommandPool),
+            MOCK_IMPLEMENTED(DEVICE, vkDestroyCommandPool),
+            MOCK_NOOP(vkResetCommandPool),
+            MOCK_NOOP(vkTrimCommandPool),
+            MOCK_IMPLEMENTED(DEVICE, vkAllocateCommandBuffers),
+            MOCK_IMPLEMENTED(DEVICE, vkFreeCommandBuffers),
+            MOCK_NOOP(vkBeginCommandBuffer),
+            MOCK_NOOP(vkEndCommandBuffer),
+            MOCK_NOOP(vkResetCommandBuffer),
+            MOCK_NOOP(vkCmdBindPipeline),
+            MOCK_NOOP(vkCmdBindDescriptorSets),
+            MOCK_NOOP(vkCmdPushConstants),
+            MOCK_NOOP(vkCmdDispatch),
+            MOCK_NOOP(vkCmdDispatchBase),
+            MOCK_NOOP(vkCmdDispatchIndirect),
+            MOCK_NOOP(vkCmdPipelineBarrier),
+            MOCK_NOOP(vkCmdPipelineBarrier2),
+            MOCK_FUNCTION(DEVICE, vkCmdPipelineBarrier2KHR, &MockNoOp<PFN_vkCmdPipelineBarrier2>::call),
+            MOCK_NOOP(vkCmdCopyBuffer),
+            MOCK_NOOP(vkCmdCopyBufferToImage),
+            MOCK_NOOP(vkCmdCopyImageToBuffer),
+            MOCK_NOOP(vkCmdFillBuffer),
+            MOCK_NOOP(vkCmdUpdateBuffer),
+            MOCK_NOOP(vkCmdResetQueryPool),
+            MOCK_NOOP(vkCmdWriteTimestamp),
+            MOCK_NOOP(vkCmdWriteTimestamp2),
+            MOCK_FUNCTION(DEVICE, vkCmdWriteTimestamp2KHR, &MockNoOp<PFN_vkCmdWriteTimestamp2>::call),
+            MOCK_NOOP(vkCmdBeginQuery),
+            MOCK_NOOP(vkCmdEndQuery),
+            MOCK_NOOP(vkCmdSetEvent),
+            MOCK_NOOP(vkCmdResetEvent),
+            MOCK_NOOP(vkCmdWaitEvents),
+            MOCK_NOOP(vkCmdExecuteCommands),
+            MOCK_NOOP(vkCmdConvertCooperativeVectorMatrixNV),
+
+            MOCK_IMPLEMENTED(DEVICE, vkCreateQueryPool),
+            MOCK_IMPLEMENTED(DEVICE, vkDestroyQueryPool),
+            MOCK_NOOP(vkResetQueryPool),
+            MOCK_FUNCTION(DEVICE, vkResetQueryPoolEXT, &MockNoOp<PFN_vkResetQueryPool>::call),
+            MOCK_IMPLEMENTED(DEVICE, vkGetQueryPoolResults),
+
+            MOCK_CREATE(vkCreateShaderModule),
+            MOCK_NOOP(vkDestroyShaderModule),
+            MOCK_CREATE(vkCreatePipelineLayout),
+            MOCK_NOOP(vkDestroyPipelineLayout),
+            MOCK_CREATE(vkCreateDescriptorSetLayout),
+            MOCK_NOOP(vkDestroyDescriptorSetLayout),
+            MOCK_IMPLEMENTED(DEVICE, vkGetDescriptorSetLayoutSupport),
+            MOCK_CREATE(vkCreateDescriptorPool),
+            MOCK_NOOP(vkDestroyDescriptorPool),
+            MOCK_NOOP(vkResetDescriptorPool),
+            MOCK_IMPLEMENTED(DEVICE, vkAllocateDescriptorSets),
+            MOCK_NOOP(vkFreeDescriptorSets),
+            MOCK_NOOP(vkUpdateDescriptorSets),
+            MOCK_IMPLEMENTED(DEVICE, vkCreateComputePipelines),
+            MOCK_IMPLEMENTED(DEVICE, vkCreateGraphicsPipelines),
+            MOCK_NOOP(vkDestroyPipeline),
+            MOCK_CREATE(vkCreatePipelineCache),
+            MOCK_NOOP(vkDestroyPipelineCache),
+            MOCK_IMPLEMENTED(DEVICE, vkGetPipelineCacheData),
+            MOCK_NOOP(vkMergePipelineCaches),
+            MOCK_CREATE(vkCreateRenderPass),
+            MOCK_NOOP(vkDestroyRenderPass),
+            MOCK_CREATE(vkCreateFramebuffer),
+            MOCK_NOOP(vkDestroyFramebuffer),
+
+            MOCK_IMPLEMENTED(DEVICE, vkConvertCooperativeVectorMatrixNV),
+            MOCK_IMPLEMENTED(DEVICE, vkGetCalibratedTimestampsKHR),
+            MOCK_ALIAS(DEVICE, vkGetCalibratedTimestampsEXT, vkGetCalibratedTimestampsKHR),
+    };
+    return functions;
+}
+
+static PFN_vkVoidFunction findMockFunction(const char* pName, MockFunctionLevel maxLevel) {
+    const auto& functions = getMockFunctions();
+    auto it = functions.find(pName);
+    if (it == functions.end()) {
+        return nullptr;
+    }
+    // vkGetDeviceProcAddr must not return instance-level functions.
+    if (maxLevel == MockFunctionLevel::DEVICE && it->second.level != MockFunctionLevel::DEVICE) {
+        return nullptr;
+    }
+    return it->second.function;
+}
+
+static VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL mock_vkGetInstanceProcAddr(VkInstance instance, const char* pName) {
+    PFN_vkVoidFunction function = findMockFunction(pName, MockFunctionLevel::GLOBAL);
+    if (!instance && function && getMockFunctions().at(pName).level != MockFunctionLevel::GLOBAL) {
+        return nullptr;
+    }
+    return function;
+}
+
+static VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL mock_vkGetDeviceProcAddr(VkDevice, const char* pName) {
+    return findMockFunction(pName, MockFunctionLevel::DEVICE);
+}
+
+MOCK_ICD_EXPORT VKAPI_ATTR VkResult VKAPI_CALL vk_icdNegotiateLoaderICDInterfaceVersion(uint32_t* pSupportedVersion) {
+    *pSupportedVersion = std::min(*pSupportedVersion, MOCK_ICD_INTERFACE_VERSION);
+    return VK_SUCCESS;
+}
+
+MOCK_ICD_EXPORT VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL vk_icdGetInstanceProcAddr(
+        VkInstance instance, const char* pName) {
+    return mock_vkGetInstanceProcAddr(instance, pName);
+}
+
+MOCK_ICD_EXPORT VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL vk_icdGetPhysicalDeviceProcAddr(
+        VkInstance, const char* pName) {
+    const auto& functions = getMockFunctions();
+    auto it = functions.find(pName);
+    if (it == functions.end() || it->second.level != MockFunctionLevel::PHYSICAL_DEVICE) {
+        return nullptr;
+    }
+    return it->second.function;
+}
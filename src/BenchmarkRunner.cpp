@@ -0,0 +1,187 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+#include "PrintUtils.hpp"
+#include "BenchmarkRunner.hpp"
+
+static BenchmarkRunnerSettings benchmarkRunnerSettings;
+static BenchmarkRunnerSummary benchmarkRunnerSummary;
+static std::vector<BenchmarkStatistics> recentBenchmarkStatistics;
+
+/// Sampling stops at the time budget only once a median of at least this many samples exists.
+static const uint32_t MIN_SAMPLES_AFTER_TIMEOUT = 3;
+
+void setBenchmarkRunnerSettings(const BenchmarkRunnerSettings& settings) {
+    benchmarkRunnerSettings = settings;
+}
+
+const BenchmarkRunnerSettings& getBenchmarkRunnerSettings() {
+    return benchmarkRunnerSettings;
+}
+
+uint32_t getReducedProblemSize(uint32_t size, uint32_t granularity) {
+    uint32_t divisor = std::max(benchmarkRunnerSettings.problemSizeDivisor, 1u);
+    uint32_t reducedSize = (size + divisor - 1) / divisor;
+    return std::max((reducedSize + granularity - 1) / granularity * granularity, granularity);
+}
+
+/// Linear interpolation between the closest ranks of the sorted samples.
+static double getPercentile(const std::vector<double>& sortedSamples, double percentile) {
+    double position = percentile * double(sortedSamples.size() - 1);
+    auto lowerIdx = size_t(std::floor(position));
+    size_t upperIdx = std::min(lowerIdx + 1, sortedSamples.size() - 1);
+    double t = position - double(lowerIdx);
+    return (1.0 - t) * sortedSamples.at(lowerIdx) + t * sortedSamples.at(upperIdx);
+}
+
+static void computeStatistics(std::vector<double> samples, BenchmarkStatistics& statistics) {
+    std::sort(samples.begin(), samples.end());
+    auto n = double(samples.size());
+    statistics.numSamples = uint32_t(samples.size());
+    statistics.median = getPercentile(samples, 0.5);
+    statistics.p5 = getPercentile(samples, 0.05);
+    statistics.p95 = getPercentile(samples, 0.95);
+    // Order statistics with ranks n/2 -/+ 1.96 sqrt(n)/2 (1-based) bound the median with ~95% confidence.
+    double halfWidthRanks = 0.98 * std::sqrt(n);
+    auto lowerRank = int64_t(std::floor(n / 2.0 - halfWidthRanks));
+    auto upperRank = int64_t(std::ceil(1.0 + n / 2.0 + halfWidthRanks));
+    lowerRank = std::clamp(lowerRank, int64_t(1), int64_t(samples.size()));
+    upperRank = std::clamp(upperRank, int64_t(1), int64_t(samples.size()));
+    statistics.ciLow = samples.at(size_t(lowerRank - 1));
+    statistics.ciHigh = samples.at(size_t(upperRank - 1));
+}
+
+double BenchmarkStatistics::getRelativeCiWidth() const {
+    if (median <= 0.0) {
+        return 0.0;
+    }
+    return (ciHigh - ciLow) / median;
+}
+
+std::string BenchmarkStatistics::toString(const std::string& unit) const {
+    std::string text = formatNumber(median, 3) + " " + unit;
+    text += " (p5 " + formatNumber(p5, 3) + ", p95 " + formatNumber(p95, 3);
+    text += ", CI [" + formatNumber(ciLow, 3) + ", " + formatNumber(ciHigh, 3) + "]";
+    text += ", n=" + std::to_string(numSamples);
+    if (getIsUnstable()) {
+        text += ", unstable";
+    }
+    text += ")";
+    return text;
+}
+
+BenchmarkStatistics runBenchmark(const std::function<double()>& measureSample) {
+    return runBenchmark(measureSample, benchmarkRunnerSettings);
+}
+
+BenchmarkStatistics runBenchmark(
+        const std::function<double()>& measureSample, const BenchmarkRunnerSettings& settings) {
+    BenchmarkStatistics statistics{};
+    auto startTime = std::chrono::steady_clock::now();
+    auto getElapsedMs = [&]() {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    };
+
+    // Warm-up: Until the clocks have ramped up and the last samples agree with each other.
+    std::vector<double> samples;
+    while (true) {
+        samples.push_back(measureSample());
+        if (samples.size() >= size_t(settings.numWarmupWindowSamples)) {
+            std::vector<double> window(samples.end() - settings.numWarmupWindowSamples, samples.end());
+            std::sort(window.begin(), window.end());
+            double windowMedian = window.at(window.size() / 2);
+            if (windowMedian <= 0.0 || (window.back() - window.front()) <= settings.warmupTolerance * windowMedian) {
+                statistics.isWarmupConverged = true;
+                break;
+            }
+        }
+        if (samples.size() >= size_t(settings.maxWarmupSamples) || getElapsedMs() >= 0.5 * settings.timeBudgetMs) {
+            break;
+        }
+    }
+    statistics.numWarmupSamples = uint32_t(samples.size());
+
+    // Sampling: Until the confidence interval is narrow enough or the budget is exhausted.
+    samples.clear();
+    while (samples.size() < size_t(std::max(settings.maxSamples, MIN_SAMPLES_AFTER_TIMEOUT))) {
+        samples.push_back(measureSample());
+        if (samples.size() >= size_t(settings.minSamples)) {
+            computeStatistics(samples, statistics);
+            if (statistics.getRelativeCiWidth() <= settings.targetRelativeCiWidth) {
+                break;
+            }
+        }
+        if (samples.size() >= size_t(MIN_SAMPLES_AFTER_TIMEOUT) && getElapsedMs() >= settings.timeBudgetMs) {
+            break;
+        }
+    }
+    computeStatistics(samples, statistics);
+    statistics.isCiTargetReached = statistics.getRelativeCiWidth() <= settings.targetRelativeCiWidth;
+
+    if (benchmarkRunnerSummary.numMeasurements == 0) {
+        benchmarkRunnerSummary.minSamples = statistics.numSamples;
+        benchmarkRunnerSummary.maxSamples = statistics.numSamples;
+    }
+    benchmarkRunnerSummary.numMeasurements++;
+    benchmarkRunnerSummary.minSamples = std::min(benchmarkRunnerSummary.minSamples, statistics.numSamples);
+    benchmarkRunnerSummary.maxSamples = std::max(benchmarkRunnerSummary.maxSamples, statistics.numSamples);
+    if (statistics.getIsUnstable()) {
+        benchmarkRunnerSummary.numUnstableMeasurements++;
+    }
+    recentBenchmarkStatistics.push_back(statistics);
+    return statistics;
+}
+
+BenchmarkRunnerSummary takeBenchmarkRunnerSummary() {
+    BenchmarkRunnerSummary summary = benchmarkRunnerSummary;
+    benchmarkRunnerSummary = {};
+    return summary;
+}
+
+std::vector<BenchmarkStatistics> takeRecentBenchmarkStatistics() {
+    std::vector<BenchmarkStatistics> statistics;
+    statistics.swap(recentBenchmarkStatistics);
+    return statistics;
+}
+
+std::string getBenchmarkRunnerSummaryString(const BenchmarkRunnerSummary& summary) {
+    std::string text = "Measurements: " + std::to_string(summary.numMeasurements) + " (median of ";
+    if (summary.minSamples == summary.maxSamples) {
+        text += std::to_string(summary.minSamples);
+    } else {
+        text += std::to_string(summary.minSamples) + "-" + std::to_string(summary.maxSamples);
+    }
+    text += " samples each), " + std::to_string(summary.numUnstableMeasurements) + " unstable (no steady state or CI";
+    text += " wider than " + formatNumber(benchmarkRunnerSettings.targetRelativeCiWidth * 100.0, 1) + "%)";
+    return text;
+}
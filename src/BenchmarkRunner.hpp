@@ -0,0 +1,94 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef QUERYVKCOOPMAT_BENCHMARKRUNNER_HPP
+#define QUERYVKCOOPMAT_BENCHMARKRUNNER_HPP
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+struct BenchmarkRunnerSettings {
+    /// Warm-up ends when the last numWarmupWindowSamples samples lie within this relative range around their median.
+    double warmupTolerance = 0.05;
+    uint32_t numWarmupWindowSamples = 3;
+    uint32_t maxWarmupSamples = 20;
+    /// Sampling ends when the 95% confidence interval of the median is narrower than this relative width...
+    double targetRelativeCiWidth = 0.02;
+    uint32_t minSamples = 5;
+    uint32_t maxSamples = 50;
+    /// ... or when the time budget for warm-up and sampling of one measurement has run out.
+    double timeBudgetMs = 500.0;
+    /// Divides the problem sizes of the benchmark modes (see getReducedProblemSize), e.g., for regression runs on
+    /// software drivers. The results are then only comparable to other runs with the same divisor.
+    uint32_t problemSizeDivisor = 1;
+};
+
+/// Statistics of the samples of one measurement (in the unit returned by the sample function, usually milliseconds).
+struct BenchmarkStatistics {
+    double median = 0.0;
+    double p5 = 0.0, p95 = 0.0;
+    double ciLow = 0.0, ciHigh = 0.0; ///< Distribution-free 95% confidence interval of the median.
+    uint32_t numWarmupSamples = 0;
+    uint32_t numSamples = 0;
+    bool isWarmupConverged = false;
+    bool isCiTargetReached = false;
+    [[nodiscard]] inline bool getIsUnstable() const { return !isWarmupConverged || !isCiTargetReached; }
+    [[nodiscard]] double getRelativeCiWidth() const;
+    /// E.g., "1.23 ms (p5 1.20, p95 1.31, CI [1.22, 1.24], n=12)".
+    [[nodiscard]] std::string toString(const std::string& unit = "ms") const;
+};
+
+void setBenchmarkRunnerSettings(const BenchmarkRunnerSettings& settings);
+const BenchmarkRunnerSettings& getBenchmarkRunnerSettings();
+/// The problem size divided by BenchmarkRunnerSettings::problemSizeDivisor, rounded up to a multiple of granularity.
+uint32_t getReducedProblemSize(uint32_t size, uint32_t granularity = 1);
+
+/**
+ * Runs measureSample until the results are in a steady state (warm-up, e.g., for the GPU clocks to ramp up), then
+ * samples it until the confidence interval of the median is narrow enough or the time budget has run out. All
+ * benchmark modes use this (directly or via measureCommands) to gather their numbers.
+ */
+BenchmarkStatistics runBenchmark(const std::function<double()>& measureSample);
+BenchmarkStatistics runBenchmark(
+        const std::function<double()>& measureSample, const BenchmarkRunnerSettings& settings);
+
+/// Counts of the measurements made since the last call of takeBenchmarkRunnerSummary.
+struct BenchmarkRunnerSummary {
+    uint32_t numMeasurements = 0;
+    uint32_t numUnstableMeasurements = 0;
+    uint32_t minSamples = 0, maxSamples = 0;
+};
+BenchmarkRunnerSummary takeBenchmarkRunnerSummary();
+/// The statistics of the measurements made since the last call; ResultTable::addRow attributes them to the row.
+std::vector<BenchmarkStatistics> takeRecentBenchmarkStatistics();
+/// E.g., "Measurements: 24 (median of 5-50 samples each), 2 unstable (no steady state or CI wider than 2%)".
+std::string getBenchmarkRunnerSummaryString(const BenchmarkRunnerSummary& summary);
+
+#endif //QUERYVKCOOPMAT_BENCHMARKRUNNER_HPP
@@ -0,0 +1,352 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cfloat>
+#include <filesystem>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <Utils/File/Logfile.hpp>
+#include <Graphics/Vulkan/Utils/Device.hpp>
+
+#include "PrintUtils.hpp"
+#include "ComponentTypes.hpp"
+#include "NumberFormats.hpp"
+#include "SvgPlot.hpp"
+#include "VulkanUtils.hpp"
+#include "CoopMatGemm.hpp"
+#include "AccuracyBenchmark.hpp"
+
+// The accuracy is evaluated on a smaller problem than the throughput, as the CPU reference needs M * N * K operations.
+static const uint32_t ACCURACY_SIZE_MN = 256;
+static const uint32_t ACCURACY_SIZE_K = 1024;
+/// Errors of exact results are shown at this value in the logarithmic plot.
+static const double MIN_PLOTTED_ERROR = 1e-12;
+
+enum class InputDistribution {
+    UNIFORM, ADVERSARIAL
+};
+static const char* const INPUT_DISTRIBUTION_NAMES[] = { "uniform", "adversarial" };
+
+static const char* const ULP_BUCKET_NAMES[] = { "0", "1", "2-3", "4-15", "16-255", ">=256", "non-finite" };
+static const size_t NUM_ULP_BUCKETS = sizeof(ULP_BUCKET_NAMES) / sizeof(ULP_BUCKET_NAMES[0]);
+
+struct ErrorStatistics {
+    double meanRelativeError = 0.0;
+    double maxRelativeError = 0.0;
+    double meanRelativeErrorTotal = 0.0; ///< Including the error of rounding the inputs to the input types.
+    size_t ulpHistogram[NUM_ULP_BUCKETS] = {};
+    size_t numElements = 0;
+};
+
+struct AccuracyResult {
+    std::string label;
+    std::string shape;
+    bool isValid = false;
+    std::string note;
+    double teraOpsPerSecond = 0.0;
+    ErrorStatistics errors[2];
+    bool isParetoOptimal = false;
+};
+
+/**
+ * Uniform: Floats in [-1, 1], small integers.
+ * Adversarial: Floats with random exponents over a wide range, where every odd element along K (nearly) cancels the
+ * preceding one; integers over the full 8-bit range with extreme values being overrepresented.
+ */
+static std::vector<double> generateValues(
+        VkComponentTypeKHR compType, size_t numRows, size_t numColumns, bool isMatrixA, InputDistribution distribution,
+        uint32_t seed) {
+    std::vector<double> values(numRows * numColumns);
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<double> unitDistribution(0.0, 1.0);
+    bool isInteger = getIsComponentTypeInteger(compType);
+    bool isSigned = getIsComponentTypeSigned(compType);
+
+    if (distribution == InputDistribution::UNIFORM) {
+        std::uniform_int_distribution<int> intDistribution(isSigned ? -4 : 0, isSigned ? 4 : 8);
+        for (double& value : values) {
+            value = isInteger ? double(intDistribution(generator)) : unitDistribution(generator) * 2.0 - 1.0;
+        }
+        return values;
+    }
+
+    if (isInteger) {
+        const int minValue = isSigned ? -128 : 0;
+        const int maxValue = isSigned ? 127 : 255;
+        std::uniform_int_distribution<int> intDistribution(minValue, maxValue);
+        for (double& value : values) {
+            double selector = unitDistribution(generator);
+            value = selector < 0.125 ? minValue : (selector < 0.25 ? maxValue : intDistribution(generator));
+        }
+        return values;
+    }
+
+    int exponentRange = 8;
+    if (compType == VK_COMPONENT_TYPE_FLOAT16_KHR || compType == VK_COMPONENT_TYPE_FLOAT_E5M2_NV) {
+        exponentRange = 4;
+    } else if (compType == VK_COMPONENT_TYPE_FLOAT_E4M3_NV) {
+        exponentRange = 3;
+    }
+    std::uniform_int_distribution<int> exponentDistribution(-exponentRange, exponentRange);
+    for (double& value : values) {
+        double sign = unitDistribution(generator) < 0.5 ? -1.0 : 1.0;
+        value = sign * std::ldexp(1.0 + unitDistribution(generator), exponentDistribution(generator));
+    }
+    // A is row-major M x K and B is row-major K x N, i.e., K is the column index of A and the row index of B.
+    for (size_t row = 0; row < numRows; row++) {
+        for (size_t column = 0; column < numColumns; column++) {
+            size_t k = isMatrixA ? column : row;
+            if (k % 2 == 0) {
+                continue;
+            }
+            size_t previousIdx = isMatrixA ? row * numColumns + column - 1 : (row - 1) * numColumns + column;
+            double& value = values.at(row * numColumns + column);
+            if (isMatrixA) {
+                value = -values.at(previousIdx) * (1.0 + 0.015625 * unitDistribution(generator));
+            } else {
+                value = values.at(previousIdx);
+            }
+        }
+    }
+    return values;
+}
+
+static std::vector<uint8_t> quantizeValues(VkComponentTypeKHR compType, const std::vector<double>& values) {
+    std::vector<uint8_t> data(values.size() * getComponentTypeSize(compType));
+    for (size_t i = 0; i < values.size(); i++) {
+        writeElement(data.data(), compType, i, values.at(i));
+    }
+    return data;
+}
+
+static std::vector<double> computeReference(
+        const std::vector<double>& A, const std::vector<double>& B, size_t M, size_t N, size_t K) {
+    std::vector<double> reference(M * N, 0.0);
+    for (size_t i = 0; i < M; i++) {
+        double* referenceRow = reference.data() + i * N;
+        for (size_t k = 0; k < K; k++) {
+            const double a = A[i * K + k];
+            const double* rowB = B.data() + k * N;
+            for (size_t j = 0; j < N; j++) {
+                referenceRow[j] += a * rowB[j];
+            }
+        }
+    }
+    return reference;
+}
+
+static size_t getUlpBucket(double ulpError) {
+    if (!std::isfinite(ulpError)) {
+        return NUM_ULP_BUCKETS - 1;
+    }
+    if (ulpError < 0.5) {
+        return 0;
+    } else if (ulpError < 1.5) {
+        return 1;
+    } else if (ulpError < 3.5) {
+        return 2;
+    } else if (ulpError < 15.5) {
+        return 3;
+    } else if (ulpError < 255.5) {
+        return 4;
+    }
+    return 5;
+}
+
+static ErrorStatistics evaluateAccuracy(CoopMatGemm& gemm, InputDistribution distribution, uint32_t seed) {
+    const CoopMatGemmSettings& settings = gemm.getSettings();
+    const size_t M = settings.M, N = settings.N, K = settings.K;
+    std::vector<double> valuesA = generateValues(settings.AType, M, K, true, distribution, seed);
+    std::vector<double> valuesB = generateValues(settings.BType, K, N, false, distribution, seed + 1);
+    std::vector<double> referenceTotal = computeReference(valuesA, valuesB, M, N, K);
+    std::vector<uint8_t> dataA = quantizeValues(settings.AType, valuesA);
+    std::vector<uint8_t> dataB = quantizeValues(settings.BType, valuesB);
+    for (size_t i = 0; i < valuesA.size(); i++) {
+        valuesA.at(i) = readElement(dataA.data(), settings.AType, i);
+    }
+    for (size_t i = 0; i < valuesB.size(); i++) {
+        valuesB.at(i) = readElement(dataB.data(), settings.BType, i);
+    }
+    std::vector<double> reference = computeReference(valuesA, valuesB, M, N, K);
+
+    // C is zero, such that only the error of the multiplication and accumulation is measured.
+    gemm.setInputs(
+            std::move(dataA), std::move(dataB),
+            std::vector<uint8_t>(M * N * getComponentTypeSize(settings.CType), 0));
+    gemm.measureTeraOpsPerSecond(1);
+    std::vector<uint8_t> result = gemm.downloadResult();
+
+    ErrorStatistics statistics{};
+    statistics.numElements = M * N;
+    size_t numFinite = 0;
+    for (size_t i = 0; i < M * N; i++) {
+        double value = readElement(result.data(), settings.ResultType, i);
+        double referenceValue = reference.at(i);
+        double roundedReference = roundToComponentType(settings.ResultType, referenceValue);
+        if (!std::isfinite(value)) {
+            statistics.ulpHistogram[NUM_ULP_BUCKETS - 1]++;
+            continue;
+        }
+        double ulpError = std::fabs(value - roundedReference) / getUlpSize(settings.ResultType, roundedReference);
+        statistics.ulpHistogram[getUlpBucket(ulpError)]++;
+        double relativeError = std::fabs(value - referenceValue) / std::max(std::fabs(referenceValue), DBL_MIN);
+        double relativeErrorTotal =
+                std::fabs(value - referenceTotal.at(i)) / std::max(std::fabs(referenceTotal.at(i)), DBL_MIN);
+        statistics.meanRelativeError += relativeError;
+        statistics.maxRelativeError = std::max(statistics.maxRelativeError, relativeError);
+        statistics.meanRelativeErrorTotal += relativeErrorTotal;
+        numFinite++;
+    }
+    if (numFinite > 0) {
+        statistics.meanRelativeError /= double(numFinite);
+        statistics.meanRelativeErrorTotal /= double(numFinite);
+    }
+    return statistics;
+}
+
+static void markParetoOptimal(std::vector<AccuracyResult>& results) {
+    for (auto& result : results) {
+        if (!result.isValid) {
+            continue;
+        }
+        const double error = result.errors[0].meanRelativeErrorTotal;
+        result.isParetoOptimal = true;
+        for (const auto& other : results) {
+            const double otherError = other.errors[0].meanRelativeErrorTotal;
+            if (&other == &result || !other.isValid) {
+                continue;
+            }
+            if (other.teraOpsPerSecond >= result.teraOpsPerSecond && otherError <= error
+                    && (other.teraOpsPerSecond > result.teraOpsPerSecond || otherError < error)) {
+                result.isParetoOptimal = false;
+                break;
+            }
+        }
+    }
+}
+
+void runAccuracyBenchmark(size_t deviceIdx, sgl::vk::Device* device, const std::string& reportDirectory) {
+    writeOut("");
+    writeOut("Accuracy vs. throughput benchmark (accuracy: ", ACCURACY_SIZE_MN, "x", ACCURACY_SIZE_MN, "x",
+             ACCURACY_SIZE_K, " GEMM vs. double precision CPU reference):");
+    if (!device->getCooperativeMatrixFeaturesKHR().cooperativeMatrix) {
+        writeOut("VK_KHR_cooperative_matrix is not supported.");
+        return;
+    }
+
+    std::vector<AccuracyResult> results;
+    try {
+        CommandContext context(device);
+        for (const auto& props : device->getSupportedCooperativeMatrixPropertiesKHR()) {
+            if (props.scope != VK_SCOPE_SUBGROUP_KHR) {
+                continue;
+            }
+            AccuracyResult result;
+            result.label = getTypeCombinationLabel(props);
+            result.shape =
+                    std::to_string(props.MSize) + "x" + std::to_string(props.NSize) + "x" + std::to_string(props.KSize);
+            CoopMatGemmSettings settings = CoopMatGemmSettings::fromProperties(props);
+            result.note = CoopMatGemm::checkSupport(device, settings);
+            if (result.note.empty()) {
+                try {
+                    result.teraOpsPerSecond = CoopMatGemm(device, context, settings).measureTeraOpsPerSecond();
+                    settings.M = ACCURACY_SIZE_MN;
+                    settings.N = ACCURACY_SIZE_MN;
+                    settings.K = ACCURACY_SIZE_K;
+                    CoopMatGemm gemm(device, context, settings);
+                    result.errors[0] = evaluateAccuracy(gemm, InputDistribution::UNIFORM, 1);
+                    result.errors[1] = evaluateAccuracy(gemm, InputDistribution::ADVERSARIAL, 3);
+                    result.isValid = true;
+                } catch (const std::exception& e) {
+                    sgl::Logfile::get()->writeError(
+                            std::string() + "Error in runAccuracyBenchmark (" + result.label + "): " + e.what(), false);
+                    result.note = "failed";
+                }
+            }
+            results.push_back(result);
+        }
+    } catch (const std::exception& e) {
+        sgl::Logfile::get()->writeError(std::string() + "Error in runAccuracyBenchmark: " + e.what(), false);
+    }
+    markParetoOptimal(results);
+
+    ResultTable summaryTable({
+            "Types", "M x N x K", "TOP/s", "Mean rel. err.", "Max rel. err.", "Mean rel. err. (adv.)",
+            "Max rel. err. (adv.)", "Mean rel. err. incl. input rounding", "Pareto" });
+    ResultTable ulpTable({ "Types", "Inputs", "0 ULP", "1 ULP", "2-3 ULP", "4-15 ULP", "16-255 ULP", ">=256 ULP",
+                           "non-finite" });
+    SvgPlot plot(
+            "Accuracy vs. throughput (" + std::string(device->getDeviceName()) + ")", "Throughput [TOP/s]",
+            "Mean relative error incl. input rounding (uniform inputs)", true, true);
+    for (const auto& result : results) {
+        if (!result.isValid) {
+            summaryTable.addRow({ result.label, result.shape, result.note, "-", "-", "-", "-", "-", "-" });
+            continue;
+        }
+        summaryTable.addRow({
+                result.label, result.shape, formatNumber(result.teraOpsPerSecond),
+                formatScientific(result.errors[0].meanRelativeError),
+                formatScientific(result.errors[0].maxRelativeError),
+                formatScientific(result.errors[1].meanRelativeError),
+                formatScientific(result.errors[1].maxRelativeError),
+                formatScientific(result.errors[0].meanRelativeErrorTotal),
+                result.isParetoOptimal ? "yes" : "" });
+        for (int distributionIdx = 0; distributionIdx < 2; distributionIdx++) {
+            const ErrorStatistics& statistics = result.errors[distributionIdx];
+            std::vector<std::string> row = { result.label, INPUT_DISTRIBUTION_NAMES[distributionIdx] };
+            for (size_t bucketIdx = 0; bucketIdx < NUM_ULP_BUCKETS; bucketIdx++) {
+                row.push_back(formatNumber(
+                        100.0 * double(statistics.ulpHistogram[bucketIdx]) / double(statistics.numElements), 1) + "%");
+            }
+            ulpTable.addRow(row);
+        }
+        plot.addPoint(
+                result.teraOpsPerSecond, std::max(result.errors[0].meanRelativeErrorTotal, MIN_PLOTTED_ERROR),
+                result.label + " " + result.shape, result.isParetoOptimal);
+    }
+    summaryTable.print();
+    writeOut("ULP error histograms (relative to the reference rounded to the result type):");
+    ulpTable.print();
+
+    std::error_code errorCode;
+    std::filesystem::create_directories(reportDirectory, errorCode);
+    std::string plotFilePath =
+            (std::filesystem::path(reportDirectory) / ("AccuracyVsThroughput_" + std::to_string(deviceIdx) + ".svg"))
+            .string();
+    if (plot.save(plotFilePath)) {
+        writeOut("Wrote the error vs. throughput plot to ", plotFilePath, " (Pareto-optimal types in red).");
+    } else {
+        sgl::Logfile::get()->writeError("Error in runAccuracyBenchmark: Could not write " + plotFilePath, false);
+    }
+}
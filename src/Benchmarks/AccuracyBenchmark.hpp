@@ -0,0 +1,48 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef QUERYVKCOOPMAT_ACCURACYBENCHMARK_HPP
+#define QUERYVKCOOPMAT_ACCURACYBENCHMARK_HPP
+
+#include <cstddef>
+#include <string>
+
+namespace sgl { namespace vk {
+class Device;
+}}
+
+/**
+ * Runs the GEMM kernel for each supported VK_KHR_cooperative_matrix type combination on uniform random and adversarial
+ * inputs (wide dynamic range and catastrophic cancellation) and compares the results to a double precision CPU
+ * reference. Prints relative errors, ULP histograms and the measured throughput, and writes an error vs. throughput
+ * plot with the Pareto-optimal combinations highlighted to AccuracyVsThroughput_<deviceIdx>.svg in the report
+ * directory.
+ */
+void runAccuracyBenchmark(size_t deviceIdx, sgl::vk::Device* device, const std::string& reportDirectory);
+
+#endif //QUERYVKCOOPMAT_ACCURACYBENCHMARK_HPP
@@ -0,0 +1,624 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <Utils/File/Logfile.hpp>
+#include <Graphics/Vulkan/libs/volk/volk.h>
+#include <Graphics/Vulkan/Utils/Device.hpp>
+
+#include "PrintUtils.hpp"
+#include "VulkanUtils.hpp"
+#include "Kernels.hpp"
+#include "AsyncOverlapBenchmark.hpp"
+
+static const VkDeviceSize CHUNK_SIZE = VkDeviceSize(16) * 1024 * 1024;
+static const uint32_t NUM_CHUNKS = 16;
+/// Chunk N+1 is uploaded and chunk N-1 is read back while chunk N is computed, so three slots are in flight.
+static const uint32_t NUM_SLOTS = 3;
+static const uint32_t WORKGROUP_SIZE = 256;
+static const uint32_t MAX_QUEUES_PER_FAMILY = 3;
+static const uint32_t CALIBRATION_ITERATIONS = 64;
+static const uint32_t MAX_ITERATIONS = 65536;
+
+struct StreamPushConstants {
+    VkDeviceAddress inputBuffer;
+    VkDeviceAddress outputBuffer;
+    uint32_t numElements;
+    uint32_t numIterations;
+};
+
+enum class StreamStage {
+    UPLOAD, COMPUTE, READBACK
+};
+
+struct StreamQueue {
+    uint32_t familyIndex = 0;
+    uint32_t queueIndex = 0;
+};
+
+static std::string getQueueFlagsString(VkQueueFlags queueFlags) {
+    std::vector<std::string> flagNames;
+    if ((queueFlags & VK_QUEUE_GRAPHICS_BIT) != 0) {
+        flagNames.emplace_back("graphics");
+    }
+    if ((queueFlags & VK_QUEUE_COMPUTE_BIT) != 0) {
+        flagNames.emplace_back("compute");
+    }
+    if ((queueFlags & VK_QUEUE_TRANSFER_BIT) != 0) {
+        flagNames.emplace_back("transfer");
+    }
+    std::string flagsString;
+    for (size_t i = 0; i < flagNames.size(); i++) {
+        flagsString += (i == 0 ? "" : "|") + flagNames.at(i);
+    }
+    return flagsString;
+}
+
+static std::string getStreamQueueString(const StreamQueue& queue) {
+    return "#" + std::to_string(queue.familyIndex) + "[" + std::to_string(queue.queueIndex) + "]";
+}
+
+/**
+ * Owns a separate logical device with up to MAX_QUEUES_PER_FAMILY queues of each compute or transfer capable queue
+ * family, as the device passed to the benchmark only exposes a single compute queue. The device-local chunk slots are
+ * shared concurrently by all queue families, such that no queue family ownership transfers are necessary.
+ */
+class StreamingDevice {
+public:
+    explicit StreamingDevice(sgl::vk::Device* device);
+    ~StreamingDevice();
+
+    [[nodiscard]] inline const std::vector<VkQueueFamilyProperties>& getQueueFamilyProperties() const {
+        return queueFamilyProperties;
+    }
+    [[nodiscard]] uint32_t getNumQueues(uint32_t familyIndex) const;
+    [[nodiscard]] inline uint32_t getNumIterations() const { return numIterations; }
+
+    /// Adapts the number of iterations of the kernel, such that computing a chunk takes as long as uploading it.
+    void calibrate(const StreamQueue& computeQueue, const StreamQueue& uploadQueue);
+    /// Time of all chunks of a single stage on the passed queue without any other work.
+    double measureStageMs(StreamStage stage, const StreamQueue& queue);
+    /// All stages of all chunks on a single queue, separated by barriers.
+    double measureSerialMs(const StreamQueue& queue);
+    double measurePipelinedMs(
+            const StreamQueue& uploadQueue, const StreamQueue& computeQueue, const StreamQueue& readbackQueue);
+
+private:
+    void destroy();
+    VkQueue getQueue(const StreamQueue& queue) const;
+    std::vector<VkCommandBuffer> allocateCommandBuffers(uint32_t familyIndex, uint32_t count);
+    void freeCommandBuffers(uint32_t familyIndex, std::vector<VkCommandBuffer>& commandBuffers);
+    void beginCommandBuffer(VkCommandBuffer commandBuffer);
+    void recordStage(VkCommandBuffer commandBuffer, StreamStage stage, uint32_t chunkIdx);
+    std::vector<VkCommandBuffer> recordStageCommandBuffers(StreamStage stage, uint32_t familyIndex);
+    void submit(
+            VkQueue queue, VkCommandBuffer commandBuffer, const std::vector<VkSemaphore>& waitSemaphores,
+            const std::vector<uint64_t>& waitValues, VkSemaphore signalSemaphore, uint64_t signalValue);
+    /// Returns the median time of runOnce over the samples taken by runBenchmark.
+    static double measureRepeatedMs(const std::function<void()>& runOnce);
+
+    sgl::vk::Device* device;
+    VkDevice vkDevice = VK_NULL_HANDLE;
+    std::vector<VkQueueFamilyProperties> queueFamilyProperties;
+    std::vector<std::vector<VkQueue>> queues; ///< Per queue family.
+    std::map<uint32_t, VkCommandPool> commandPools;
+    std::unique_ptr<ComputePipeline> pipeline;
+    DeviceBuffer uploadStagingBuffer, readbackStagingBuffer, inputBuffer, outputBuffer;
+    VkSemaphore uploadSemaphore = VK_NULL_HANDLE, computeSemaphore = VK_NULL_HANDLE;
+    VkSemaphore readbackSemaphore = VK_NULL_HANDLE;
+    uint64_t timelineBaseValue = 0; ///< Timeline values only increase, so each run continues where the last stopped.
+    uint32_t numIterations = CALIBRATION_ITERATIONS;
+};
+
+StreamingDevice::StreamingDevice(sgl::vk::Device* device) : device(device) {
+    const EmbeddedKernel* kernel = findEmbeddedKernel("StreamCompute", "default");
+    if (!kernel) {
+        throw std::runtime_error("StreamCompute kernel is not available.");
+    }
+
+    VkPhysicalDevice physicalDevice = device->getVkPhysicalDevice();
+    uint32_t queueFamilyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, nullptr);
+    queueFamilyProperties.resize(queueFamilyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, queueFamilyProperties.data());
+    queues.resize(queueFamilyCount);
+
+    const float queuePriorities[MAX_QUEUES_PER_FAMILY] = { 1.0f, 1.0f, 1.0f };
+    std::vector<VkDeviceQueueCreateInfo> queueCreateInfos;
+    std::vector<uint32_t> usedQueueFamilyIndices;
+    const VkQueueFlags usableQueueFlags = VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT | VK_QUEUE_TRANSFER_BIT;
+    for (uint32_t familyIdx = 0; familyIdx < queueFamilyCount; familyIdx++) {
+        const auto& familyProperties = queueFamilyProperties.at(familyIdx);
+        if ((familyProperties.queueFlags & usableQueueFlags) == 0 || familyProperties.queueCount == 0) {
+            continue;
+        }
+        VkDeviceQueueCreateInfo queueCreateInfo{};
+        queueCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+        queueCreateInfo.queueFamilyIndex = familyIdx;
+        queueCreateInfo.queueCount = std::min(familyProperties.queueCount, MAX_QUEUES_PER_FAMILY);
+        queueCreateInfo.pQueuePriorities = queuePriorities;
+        queueCreateInfos.push_back(queueCreateInfo);
+        usedQueueFamilyIndices.push_back(familyIdx);
+    }
+
+    VkPhysicalDeviceVulkan12Features vulkan12Features{};
+    vulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+    vulkan12Features.timelineSemaphore = VK_TRUE;
+    vulkan12Features.bufferDeviceAddress = VK_TRUE;
+    VkDeviceCreateInfo deviceCreateInfo{};
+    deviceCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+    deviceCreateInfo.pNext = &vulkan12Features;
+    deviceCreateInfo.queueCreateInfoCount = uint32_t(queueCreateInfos.size());
+    deviceCreateInfo.pQueueCreateInfos = queueCreateInfos.data();
+    throwIfVkError(vkCreateDevice(physicalDevice, &deviceCreateInfo, nullptr, &vkDevice), "vkCreateDevice");
+    loadDeviceFunctions(vkDevice);
+    for (const auto& queueCreateInfo : queueCreateInfos) {
+        auto& familyQueues = queues.at(queueCreateInfo.queueFamilyIndex);
+        familyQueues.resize(queueCreateInfo.queueCount);
+        for (uint32_t queueIdx = 0; queueIdx < queueCreateInfo.queueCount; queueIdx++) {
+            vkGetDeviceQueue(vkDevice, queueCreateInfo.queueFamilyIndex, queueIdx, &familyQueues.at(queueIdx));
+        }
+    }
+
+    try {
+        for (uint32_t familyIdx : usedQueueFamilyIndices) {
+            VkCommandPoolCreateInfo commandPoolCreateInfo{};
+            commandPoolCreateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+            commandPoolCreateInfo.queueFamilyIndex = familyIdx;
+            VkCommandPool commandPool = VK_NULL_HANDLE;
+            throwIfVkError(
+                    vkCreateCommandPool(vkDevice, &commandPoolCreateInfo, nullptr, &commandPool),
+                    "vkCreateCommandPool");
+            commandPools[familyIdx] = commandPool;
+        }
+
+        VkSemaphoreTypeCreateInfo semaphoreTypeCreateInfo{};
+        semaphoreTypeCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+        semaphoreTypeCreateInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+        semaphoreTypeCreateInfo.initialValue = 0;
+        VkSemaphoreCreateInfo semaphoreCreateInfo{};
+        semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        semaphoreCreateInfo.pNext = &semaphoreTypeCreateInfo;
+        for (VkSemaphore* semaphore : { &uploadSemaphore, &computeSemaphore, &readbackSemaphore }) {
+            throwIfVkError(vkCreateSemaphore(vkDevice, &semaphoreCreateInfo, nullptr, semaphore), "vkCreateSemaphore");
+        }
+
+        VkPhysicalDeviceMemoryProperties memoryProperties{};
+        vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memoryProperties);
+        BufferSettings bufferSettings{};
+        bufferSettings.size = CHUNK_SIZE * NUM_SLOTS;
+        bufferSettings.queueFamilyIndices = usedQueueFamilyIndices;
+        bufferSettings.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+        bufferSettings.memoryProperties = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+        uploadStagingBuffer = createDeviceBuffer(vkDevice, memoryProperties, bufferSettings);
+        readbackStagingBuffer = createDeviceBuffer(vkDevice, memoryProperties, bufferSettings);
+        bufferSettings.usage |= VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+        bufferSettings.memoryProperties = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+        inputBuffer = createDeviceBuffer(vkDevice, memoryProperties, bufferSettings);
+        outputBuffer = createDeviceBuffer(vkDevice, memoryProperties, bufferSettings);
+        // The content does not influence the run time, but should not contain denormals or NaNs.
+        std::fill_n(static_cast<float*>(uploadStagingBuffer.mappedData), size_t(CHUNK_SIZE * NUM_SLOTS / 4), 0.5f);
+
+        ComputePipelineSettings pipelineSettings{};
+        pipelineSettings.code = kernel->code;
+        pipelineSettings.codeSize = kernel->codeSize;
+        pipelineSettings.specializationConstants = { WORKGROUP_SIZE };
+        pipelineSettings.pushConstantSize = sizeof(StreamPushConstants);
+        pipeline = std::make_unique<ComputePipeline>(vkDevice, pipelineSettings);
+    } catch (...) {
+        destroy();
+        throw;
+    }
+}
+
+StreamingDevice::~StreamingDevice() {
+    destroy();
+}
+
+void StreamingDevice::destroy() {
+    if (!vkDevice) {
+        return;
+    }
+    loadDeviceFunctions(vkDevice);
+    vkDeviceWaitIdle(vkDevice);
+    pipeline = {};
+    destroyDeviceBuffer(vkDevice, uploadStagingBuffer);
+    destroyDeviceBuffer(vkDevice, readbackStagingBuffer);
+    destroyDeviceBuffer(vkDevice, inputBuffer);
+    destroyDeviceBuffer(vkDevice, outputBuffer);
+    for (VkSemaphore semaphore : { uploadSemaphore, computeSemaphore, readbackSemaphore }) {
+        if (semaphore) {
+            vkDestroySemaphore(vkDevice, semaphore, nullptr);
+        }
+    }
+    for (auto& commandPoolPair : commandPools) {
+        vkDestroyCommandPool(vkDevice, commandPoolPair.second, nullptr);
+    }
+    commandPools.clear();
+    vkDestroyDevice(vkDevice, nullptr);
+    vkDevice = VK_NULL_HANDLE;
+    loadDeviceFunctions(device->getVkDevice());
+}
+
+uint32_t StreamingDevice::getNumQueues(uint32_t familyIndex) const {
+    return uint32_t(queues.at(familyIndex).size());
+}
+
+VkQueue StreamingDevice::getQueue(const StreamQueue& queue) const {
+    return queues.at(queue.familyIndex).at(queue.queueIndex);
+}
+
+std::vector<VkCommandBuffer> StreamingDevice::allocateCommandBuffers(uint32_t familyIndex, uint32_t count) {
+    std::vector<VkCommandBuffer> commandBuffers(count);
+    VkCommandBufferAllocateInfo commandBufferAllocateInfo{};
+    commandBufferAllocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    commandBufferAllocateInfo.commandPool = commandPools.at(familyIndex);
+    commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    commandBufferAllocateInfo.commandBufferCount = count;
+    throwIfVkError(
+            vkAllocateCommandBuffers(vkDevice, &commandBufferAllocateInfo, commandBuffers.data()),
+            "vkAllocateCommandBuffers");
+    return commandBuffers;
+}
+
+void StreamingDevice::freeCommandBuffers(uint32_t familyIndex, std::vector<VkCommandBuffer>& commandBuffers) {
+    vkFreeCommandBuffers(
+            vkDevice, commandPools.at(familyIndex), uint32_t(commandBuffers.size()), commandBuffers.data());
+    commandBuffers.clear();
+}
+
+void StreamingDevice::beginCommandBuffer(VkCommandBuffer commandBuffer) {
+    VkCommandBufferBeginInfo beginInfo{};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    throwIfVkError(vkBeginCommandBuffer(commandBuffer, &beginInfo), "vkBeginCommandBuffer");
+}
+
+void StreamingDevice::recordStage(VkCommandBuffer commandBuffer, StreamStage stage, uint32_t chunkIdx) {
+    const VkDeviceSize slotOffset = VkDeviceSize(chunkIdx % NUM_SLOTS) * CHUNK_SIZE;
+    if (stage == StreamStage::UPLOAD) {
+        VkBufferCopy bufferCopy{ slotOffset, slotOffset, CHUNK_SIZE };
+        vkCmdCopyBuffer(commandBuffer, uploadStagingBuffer.buffer, inputBuffer.buffer, 1, &bufferCopy);
+    } else if (stage == StreamStage::COMPUTE) {
+        StreamPushConstants pushConstants{};
+        pushConstants.inputBuffer = inputBuffer.deviceAddress + slotOffset;
+        pushConstants.outputBuffer = outputBuffer.deviceAddress + slotOffset;
+        pushConstants.numElements = uint32_t(CHUNK_SIZE / 16);
+        pushConstants.numIterations = numIterations;
+        pipeline->bind(commandBuffer);
+        pipeline->pushConstants(commandBuffer, &pushConstants, sizeof(StreamPushConstants));
+        vkCmdDispatch(commandBuffer, (pushConstants.numElements + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE, 1, 1);
+    } else {
+        VkBufferCopy bufferCopy{ slotOffset, slotOffset, CHUNK_SIZE };
+        vkCmdCopyBuffer(commandBuffer, outputBuffer.buffer, readbackStagingBuffer.buffer, 1, &bufferCopy);
+    }
+}
+
+std::vector<VkCommandBuffer> StreamingDevice::recordStageCommandBuffers(StreamStage stage, uint32_t familyIndex) {
+    std::vector<VkCommandBuffer> commandBuffers = allocateCommandBuffers(familyIndex, NUM_CHUNKS);
+    for (uint32_t chunkIdx = 0; chunkIdx < NUM_CHUNKS; chunkIdx++) {
+        beginCommandBuffer(commandBuffers.at(chunkIdx));
+        recordStage(commandBuffers.at(chunkIdx), stage, chunkIdx);
+        throwIfVkError(vkEndCommandBuffer(commandBuffers.at(chunkIdx)), "vkEndCommandBuffer");
+    }
+    return commandBuffers;
+}
+
+void StreamingDevice::submit(
+        VkQueue queue, VkCommandBuffer commandBuffer, const std::vector<VkSemaphore>& waitSemaphores,
+        const std::vector<uint64_t>& waitValues, VkSemaphore signalSemaphore, uint64_t signalValue) {
+    const std::vector<VkPipelineStageFlags> waitStageMasks(
+            waitSemaphores.size(), VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+    VkTimelineSemaphoreSubmitInfo timelineSubmitInfo{};
+    timelineSubmitInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+    timelineSubmitInfo.waitSemaphoreValueCount = uint32_t(waitValues.size());
+    timelineSubmitInfo.pWaitSemaphoreValues = waitValues.data();
+    timelineSubmitInfo.signalSemaphoreValueCount = 1;
+    timelineSubmitInfo.pSignalSemaphoreValues = &signalValue;
+    VkSubmitInfo submitInfo{};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.pNext = &timelineSubmitInfo;
+    submitInfo.waitSemaphoreCount = uint32_t(waitSemaphores.size());
+    submitInfo.pWaitSemaphores = waitSemaphores.data();
+    submitInfo.pWaitDstStageMask = waitStageMasks.data();
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &commandBuffer;
+    submitInfo.signalSemaphoreCount = 1;
+    submitInfo.pSignalSemaphores = &signalSemaphore;
+    throwIfVkError(vkQueueSubmit(queue, 1, &submitInfo, VK_NULL_HANDLE), "vkQueueSubmit");
+}
+
+double StreamingDevice::measureRepeatedMs(const std::function<void()>& runOnce) {
+    return runBenchmark([&]() {
+        auto startTime = std::chrono::high_resolution_clock::now();
+        runOnce();
+        auto endTime = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::milli>(endTime - startTime).count();
+    }).median;
+}
+
+void StreamingDevice::calibrate(const StreamQueue& computeQueue, const StreamQueue& uploadQueue) {
+    double uploadMs = measureStageMs(StreamStage::UPLOAD, uploadQueue);
+    // The first pass may still be bound by memory bandwidth, so the estimate is refined once.
+    numIterations = CALIBRATION_ITERATIONS;
+    for (int passIdx = 0; passIdx < 2; passIdx++) {
+        double computeMs = measureStageMs(StreamStage::COMPUTE, computeQueue);
+        double scale = computeMs > 0.0 ? uploadMs / computeMs : 1.0;
+        numIterations = uint32_t(std::clamp(std::round(double(numIterations) * scale), 1.0, double(MAX_ITERATIONS)));
+    }
+}
+
+double StreamingDevice::measureStageMs(StreamStage stage, const StreamQueue& queue) {
+    std::vector<VkCommandBuffer> commandBuffers = recordStageCommandBuffers(stage, queue.familyIndex);
+    VkQueue vkQueue = getQueue(queue);
+    double timeMs = measureRepeatedMs([&]() {
+        VkSubmitInfo submitInfo{};
+        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.commandBufferCount = uint32_t(commandBuffers.size());
+        submitInfo.pCommandBuffers = commandBuffers.data();
+        throwIfVkError(vkQueueSubmit(vkQueue, 1, &submitInfo, VK_NULL_HANDLE), "vkQueueSubmit");
+        throwIfVkError(vkQueueWaitIdle(vkQueue), "vkQueueWaitIdle");
+    });
+    freeCommandBuffers(queue.familyIndex, commandBuffers);
+    return timeMs;
+}
+
+double StreamingDevice::measureSerialMs(const StreamQueue& queue) {
+    std::vector<VkCommandBuffer> commandBuffers = allocateCommandBuffers(queue.familyIndex, 1);
+    VkCommandBuffer commandBuffer = commandBuffers.front();
+    beginCommandBuffer(commandBuffer);
+    for (uint32_t chunkIdx = 0; chunkIdx < NUM_CHUNKS; chunkIdx++) {
+        for (StreamStage stage : { StreamStage::UPLOAD, StreamStage::COMPUTE, StreamStage::READBACK }) {
+            recordStage(commandBuffer, stage, chunkIdx);
+            insertMemoryBarrier(commandBuffer);
+        }
+    }
+    throwIfVkError(vkEndCommandBuffer(commandBuffer), "vkEndCommandBuffer");
+    VkQueue vkQueue = getQueue(queue);
+    double timeMs = measureRepeatedMs([&]() {
+        VkSubmitInfo submitInfo{};
+        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers = &commandBuffer;
+        throwIfVkError(vkQueueSubmit(vkQueue, 1, &submitInfo, VK_NULL_HANDLE), "vkQueueSubmit");
+        throwIfVkError(vkQueueWaitIdle(vkQueue), "vkQueueWaitIdle");
+    });
+    freeCommandBuffers(queue.familyIndex, commandBuffers);
+    return timeMs;
+}
+
+double StreamingDevice::measurePipelinedMs(
+        const StreamQueue& uploadQueue, const StreamQueue& computeQueue, const StreamQueue& readbackQueue) {
+    std::vector<VkCommandBuffer> uploadCommandBuffers =
+            recordStageCommandBuffers(StreamStage::UPLOAD, uploadQueue.familyIndex);
+    std::vector<VkCommandBuffer> computeCommandBuffers =
+            recordStageCommandBuffers(StreamStage::COMPUTE, computeQueue.familyIndex);
+    std::vector<VkCommandBuffer> readbackCommandBuffers =
+            recordStageCommandBuffers(StreamStage::READBACK, readbackQueue.familyIndex);
+    VkQueue vkUploadQueue = getQueue(uploadQueue);
+    VkQueue vkComputeQueue = getQueue(computeQueue);
+    VkQueue vkReadbackQueue = getQueue(readbackQueue);
+
+    /*
+     * Timeline value base + N + 1 of a semaphore marks that the stage has finished chunk N. Uploading chunk N reuses
+     * the input slot of chunk N - NUM_SLOTS, and computing chunk N the output slot of chunk N - NUM_SLOTS. All waits
+     * refer to work submitted earlier, so a single queue running all stages cannot deadlock either.
+     */
+    double timeMs = measureRepeatedMs([&]() {
+        const uint64_t base = timelineBaseValue;
+        for (uint32_t step = 0; step < NUM_CHUNKS + 2; step++) {
+            if (step < NUM_CHUNKS) {
+                const uint32_t chunkIdx = step;
+                std::vector<VkSemaphore> waitSemaphores;
+                std::vector<uint64_t> waitValues;
+                if (chunkIdx >= NUM_SLOTS) {
+                    waitSemaphores.push_back(computeSemaphore);
+                    waitValues.push_back(base + chunkIdx - NUM_SLOTS + 1);
+                }
+                submit(vkUploadQueue, uploadCommandBuffers.at(chunkIdx), waitSemaphores, waitValues,
+                       uploadSemaphore, base + chunkIdx + 1);
+            }
+            if (step >= 1 && step - 1 < NUM_CHUNKS) {
+                const uint32_t chunkIdx = step - 1;
+                std::vector<VkSemaphore> waitSemaphores = { uploadSemaphore };
+                std::vector<uint64_t> waitValues = { base + chunkIdx + 1 };
+                if (chunkIdx >= NUM_SLOTS) {
+                    waitSemaphores.push_back(readbackSemaphore);
+                    waitValues.push_back(base + chunkIdx - NUM_SLOTS + 1);
+                }
+                submit(vkComputeQueue, computeCommandBuffers.at(chunkIdx), waitSemaphores, waitValues,
+                       computeSemaphore, base + chunkIdx + 1);
+            }
+            if (step >= 2) {
+                const uint32_t chunkIdx = step - 2;
+                submit(vkReadbackQueue, readbackCommandBuffers.at(chunkIdx), { computeSemaphore },
+                       { base + chunkIdx + 1 }, readbackSemaphore, base + chunkIdx + 1);
+            }
+        }
+        const uint64_t finalValue = base + NUM_CHUNKS;
+        VkSemaphoreWaitInfo semaphoreWaitInfo{};
+        semaphoreWaitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+        semaphoreWaitInfo.semaphoreCount = 1;
+        semaphoreWaitInfo.pSemaphores = &readbackSemaphore;
+        semaphoreWaitInfo.pValues = &finalValue;
+        throwIfVkError(vkWaitSemaphores(vkDevice, &semaphoreWaitInfo, UINT64_MAX), "vkWaitSemaphores");
+        timelineBaseValue = finalValue;
+    });
+
+    freeCommandBuffers(uploadQueue.familyIndex, uploadCommandBuffers);
+    freeCommandBuffers(computeQueue.familyIndex, computeCommandBuffers);
+    freeCommandBuffers(readbackQueue.familyIndex, readbackCommandBuffers);
+    return timeMs;
+}
+
+struct QueueCombination {
+    StreamQueue uploadQueue, computeQueue, readbackQueue;
+};
+
+/// Uses distinct queues for the three stages where the queue families provide enough of them.
+static QueueCombination getQueueCombination(
+        const StreamingDevice& streamingDevice, uint32_t computeFamilyIndex, uint32_t transferFamilyIndex) {
+    QueueCombination combination;
+    combination.computeQueue = { computeFamilyIndex, 0 };
+    uint32_t numTransferQueues = streamingDevice.getNumQueues(transferFamilyIndex);
+    uint32_t firstTransferQueueIdx = computeFamilyIndex == transferFamilyIndex ? 1 : 0;
+    combination.uploadQueue = {
+            transferFamilyIndex, std::min(firstTransferQueueIdx, numTransferQueues - 1) };
+    combination.readbackQueue = {
+            transferFamilyIndex, std::min(firstTransferQueueIdx + 1, numTransferQueues - 1) };
+    return combination;
+}
+
+static double getQueueTimeMs(
+        const QueueCombination& combination, const StreamQueue& queue,
+        double uploadMs, double computeMs, double readbackMs) {
+    auto isSameQueue = [&queue](const StreamQueue& other) {
+        return queue.familyIndex == other.familyIndex && queue.queueIndex == other.queueIndex;
+    };
+    double timeMs = 0.0;
+    timeMs += isSameQueue(combination.uploadQueue) ? uploadMs : 0.0;
+    timeMs += isSameQueue(combination.computeQueue) ? computeMs : 0.0;
+    timeMs += isSameQueue(combination.readbackQueue) ? readbackMs : 0.0;
+    return timeMs;
+}
+
+void runAsyncOverlapBenchmark(sgl::vk::Device* device) {
+    writeOut("");
+    writeOut("Async compute/transfer overlap (", NUM_CHUNKS, " chunks of ", sgl::getNiceMemoryString(CHUNK_SIZE, 2),
+             ", timeline semaphores):");
+    const auto& vulkan12Features = device->getPhysicalDeviceVulkan12Features();
+    if (device->getApiVersion() < VK_API_VERSION_1_2 || !vulkan12Features.timelineSemaphore
+            || !vulkan12Features.bufferDeviceAddress) {
+        writeOut("Timeline semaphores or buffer device addresses are not supported.");
+        return;
+    }
+
+    std::unique_ptr<StreamingDevice> streamingDevice;
+    try {
+        streamingDevice = std::make_unique<StreamingDevice>(device);
+    } catch (const std::exception& e) {
+        sgl::Logfile::get()->writeError(std::string() + "Error in runAsyncOverlapBenchmark: " + e.what(), false);
+        return;
+    }
+
+    const auto& queueFamilyProperties = streamingDevice->getQueueFamilyProperties();
+    std::vector<uint32_t> computeFamilyIndices, transferFamilyIndices;
+    for (uint32_t familyIdx = 0; familyIdx < uint32_t(queueFamilyProperties.size()); familyIdx++) {
+        if (streamingDevice->getNumQueues(familyIdx) == 0) {
+            continue;
+        }
+        writeOut("Queue family #", familyIdx, ": ", getQueueFlagsString(queueFamilyProperties.at(familyIdx).queueFlags),
+                 ", ", queueFamilyProperties.at(familyIdx).queueCount, " queues");
+        // Graphics and compute queues support transfer operations even if they do not report the transfer bit.
+        transferFamilyIndices.push_back(familyIdx);
+        if ((queueFamilyProperties.at(familyIdx).queueFlags & VK_QUEUE_COMPUTE_BIT) != 0) {
+            computeFamilyIndices.push_back(familyIdx);
+        }
+    }
+    if (computeFamilyIndices.empty()) {
+        writeOut("No compute queue family found.");
+        return;
+    }
+
+    // Calibrate on the first dedicated transfer family if there is one, as this is the intended use case.
+    uint32_t calibrationTransferFamilyIdx = computeFamilyIndices.front();
+    for (uint32_t familyIdx : transferFamilyIndices) {
+        if ((queueFamilyProperties.at(familyIdx).queueFlags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)) == 0) {
+            calibrationTransferFamilyIdx = familyIdx;
+            break;
+        }
+    }
+    try {
+        QueueCombination calibrationCombination = getQueueCombination(
+                *streamingDevice, computeFamilyIndices.front(), calibrationTransferFamilyIdx);
+        streamingDevice->calibrate(calibrationCombination.computeQueue, calibrationCombination.uploadQueue);
+        writeOut("Kernel iterations per element: ", streamingDevice->getNumIterations());
+    } catch (const std::exception& e) {
+        sgl::Logfile::get()->writeError(
+                std::string() + "Error in runAsyncOverlapBenchmark (calibration): " + e.what(), false);
+        return;
+    }
+
+    const double totalBytes = double(CHUNK_SIZE) * double(NUM_CHUNKS);
+    ResultTable table({
+            "Compute", "Upload", "Readback", "Upload (ms)", "Compute (ms)", "Readback (ms)",
+            "Serial (ms)", "Pipelined (ms)", "Overlap", "Serial GiB/s", "Pipelined GiB/s" });
+    for (uint32_t computeFamilyIdx : computeFamilyIndices) {
+        for (uint32_t transferFamilyIdx : transferFamilyIndices) {
+            QueueCombination combination = getQueueCombination(
+                    *streamingDevice, computeFamilyIdx, transferFamilyIdx);
+            std::vector<std::string> row = {
+                    getStreamQueueString(combination.computeQueue), getStreamQueueString(combination.uploadQueue),
+                    getStreamQueueString(combination.readbackQueue) };
+            try {
+                double uploadMs = streamingDevice->measureStageMs(StreamStage::UPLOAD, combination.uploadQueue);
+                double computeMs = streamingDevice->measureStageMs(StreamStage::COMPUTE, combination.computeQueue);
+                double readbackMs = streamingDevice->measureStageMs(
+                        StreamStage::READBACK, combination.readbackQueue);
+                double serialMs = streamingDevice->measureSerialMs(combination.computeQueue);
+                double pipelinedMs = streamingDevice->measurePipelinedMs(
+                        combination.uploadQueue, combination.computeQueue, combination.readbackQueue);
+
+                // With perfect overlap, the pipelined time is bound by the busiest queue.
+                double idealMs = 0.0;
+                for (const StreamQueue& queue : {
+                        combination.uploadQueue, combination.computeQueue, combination.readbackQueue }) {
+                    idealMs = std::max(
+                            idealMs, getQueueTimeMs(combination, queue, uploadMs, computeMs, readbackMs));
+                }
+                std::string overlapString = "-";
+                if (serialMs - idealMs > 0.0) {
+                    overlapString = formatNumber(100.0 * (serialMs - pipelinedMs) / (serialMs - idealMs), 1) + "%";
+                }
+                row.insert(row.end(), {
+                        formatNumber(uploadMs), formatNumber(computeMs), formatNumber(readbackMs),
+                        formatNumber(serialMs), formatNumber(pipelinedMs), overlapString,
+                        formatNumber(computeGiBPerSecond(totalBytes, serialMs)),
+                        formatNumber(computeGiBPerSecond(totalBytes, pipelinedMs)) });
+            } catch (const std::exception& e) {
+                sgl::Logfile::get()->writeError(
+                        std::string() + "Error in runAsyncOverlapBenchmark (compute family "
+                        + std::to_string(computeFamilyIdx) + ", transfer family "
+                        + std::to_string(transferFamilyIdx) + "): " + e.what(), false);
+                row.resize(11, "failed");
+            }
+            table.addRow(row);
+        }
+    }
+    table.print();
+    writeOut("Queues are written as #<family>[<queue index>]. Overlap: share of the time the pipelined path saves of "
+             "the maximum saving possible with the busiest queue as bound.");
+}
@@ -0,0 +1,290 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <Utils/File/Logfile.hpp>
+#include <Graphics/Vulkan/libs/volk/volk.h>
+#include <Graphics/Vulkan/Utils/Device.hpp>
+
+#include "PrintUtils.hpp"
+#include "ComponentTypes.hpp"
+#include "VulkanUtils.hpp"
+#include "Kernels.hpp"
+#include "CoopMatGemm.hpp"
+#include "BatchedGemmBenchmark.hpp"
+
+/// Size of the matrices of the batch before rounding up to multiples of the cooperative matrix size.
+static const uint32_t MATRIX_SIZE = 64;
+static const uint32_t SUBGROUPS_PER_WORKGROUP = 4;
+static const uint32_t BATCH_COUNTS[] = { 1, 10, 100, 1000, 10000, 100000 };
+static const uint32_t MAX_BATCH_COUNT = 100000;
+/// Upper bound for the memory of the distinct matrices; larger batches reuse matrices.
+static const VkDeviceSize MAX_MATRIX_MEMORY = VkDeviceSize(256) << 20;
+
+struct BatchedGemmPushConstants {
+    VkDeviceAddress addressA, addressB, addressC, addressD;
+    VkDeviceAddress pointerArray;
+    uint32_t M, N, K;
+    uint32_t batchCount, numDistinctMatrices;
+};
+
+struct BatchMatrixAddresses {
+    VkDeviceAddress addressA, addressB, addressC, addressD;
+};
+
+enum class BatchingMode {
+    DISPATCH_PER_MATRIX, STRIDED, POINTER_ARRAY
+};
+
+class BatchedGemm {
+public:
+    BatchedGemm(sgl::vk::Device* device, CommandContext& context, const CoopMatGemmSettings& settings);
+    ~BatchedGemm();
+    [[nodiscard]] double getNumOperations(uint32_t batchCount) const {
+        return 2.0 * double(M) * double(N) * double(K) * double(batchCount);
+    }
+    /// Returns the time for computing the whole batch in milliseconds.
+    double measureBatchMs(BatchingMode mode, uint32_t batchCount);
+
+private:
+    void destroyBuffers();
+
+    sgl::vk::Device* device;
+    CommandContext& context;
+    CoopMatGemmSettings settings;
+    uint32_t M, N, K, numDistinctMatrices;
+    size_t sizeA, sizeB, sizeC, sizeD; ///< Per matrix in bytes.
+    std::unique_ptr<ComputePipeline> stridedPipeline, pointerArrayPipeline;
+    DeviceBuffer bufferA, bufferB, bufferC, bufferD, pointerArrayBuffer;
+};
+
+static uint32_t roundUpToMultiple(uint32_t value, uint32_t multiple) {
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+BatchedGemm::BatchedGemm(sgl::vk::Device* device, CommandContext& context, const CoopMatGemmSettings& settings)
+        : device(device), context(context), settings(settings) {
+    M = roundUpToMultiple(MATRIX_SIZE, settings.lM);
+    N = roundUpToMultiple(MATRIX_SIZE, settings.lN);
+    K = roundUpToMultiple(MATRIX_SIZE, settings.lK);
+    sizeA = size_t(M) * K * getComponentTypeSize(settings.AType);
+    sizeB = size_t(K) * N * getComponentTypeSize(settings.BType);
+    sizeC = size_t(M) * N * getComponentTypeSize(settings.CType);
+    sizeD = size_t(M) * N * getComponentTypeSize(settings.ResultType);
+    numDistinctMatrices = uint32_t(std::min(
+            VkDeviceSize(MAX_BATCH_COUNT), MAX_MATRIX_MEMORY / VkDeviceSize(sizeA + sizeB + sizeC + sizeD)));
+
+    uint32_t subgroupSize = device->getPhysicalDeviceSubgroupProperties().subgroupSize;
+    std::string variantName = CoopMatGemm::getVariantName(settings);
+    for (bool usePointerArray : { false, true }) {
+        std::string kernelVariant = variantName + (usePointerArray ? "_ptr" : "");
+        const EmbeddedKernel* kernel = findEmbeddedKernel("BatchedGemm", kernelVariant);
+        if (!kernel) {
+            throw std::runtime_error("Kernel variant BatchedGemm/" + kernelVariant + " is not available.");
+        }
+        ComputePipelineSettings pipelineSettings{};
+        pipelineSettings.code = kernel->code;
+        pipelineSettings.codeSize = kernel->codeSize;
+        pipelineSettings.specializationConstants = {
+                subgroupSize * SUBGROUPS_PER_WORKGROUP, settings.lM, settings.lN, settings.lK };
+        pipelineSettings.pushConstantSize = sizeof(BatchedGemmPushConstants);
+        (usePointerArray ? pointerArrayPipeline : stridedPipeline) =
+                std::make_unique<ComputePipeline>(device->getVkDevice(), pipelineSettings);
+    }
+
+    const VkBufferUsageFlags usage =
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT
+            | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    try {
+        bufferA = createDeviceBuffer(device, sizeA * numDistinctMatrices, usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        bufferB = createDeviceBuffer(device, sizeB * numDistinctMatrices, usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        bufferC = createDeviceBuffer(device, sizeC * numDistinctMatrices, usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        bufferD = createDeviceBuffer(device, sizeD * numDistinctMatrices, usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        std::vector<BatchMatrixAddresses> pointerArray(MAX_BATCH_COUNT);
+        for (uint32_t i = 0; i < MAX_BATCH_COUNT; i++) {
+            uint32_t matrixIdx = i % numDistinctMatrices;
+            pointerArray[i].addressA = bufferA.deviceAddress + matrixIdx * sizeA;
+            pointerArray[i].addressB = bufferB.deviceAddress + matrixIdx * sizeB;
+            pointerArray[i].addressC = bufferC.deviceAddress + matrixIdx * sizeC;
+            pointerArray[i].addressD = bufferD.deviceAddress + matrixIdx * sizeD;
+        }
+        pointerArrayBuffer = createDeviceBuffer(
+                device, pointerArray.size() * sizeof(BatchMatrixAddresses), usage,
+                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        uploadBufferData(
+                device, context, pointerArrayBuffer, pointerArray.data(),
+                pointerArray.size() * sizeof(BatchMatrixAddresses));
+        // The values do not matter for the throughput; 0x3C00 is 1.0 in float16, and the bit pattern is a small
+        // finite value in all other floating point types.
+        VkCommandBuffer commandBuffer = context.begin();
+        for (const DeviceBuffer* buffer : { &bufferA, &bufferB, &bufferC }) {
+            vkCmdFillBuffer(commandBuffer, buffer->buffer, 0, VK_WHOLE_SIZE, 0x3C003C00u);
+        }
+        context.submitAndWait();
+    } catch (...) {
+        destroyBuffers();
+        throw;
+    }
+}
+
+BatchedGemm::~BatchedGemm() {
+    destroyBuffers();
+}
+
+void BatchedGemm::destroyBuffers() {
+    VkDevice vkDevice = device->getVkDevice();
+    for (DeviceBuffer* buffer : { &bufferA, &bufferB, &bufferC, &bufferD, &pointerArrayBuffer }) {
+        destroyDeviceBuffer(vkDevice, *buffer);
+    }
+}
+
+double BatchedGemm::measureBatchMs(BatchingMode mode, uint32_t batchCount) {
+    BatchedGemmPushConstants pushConstants{};
+    pushConstants.addressA = bufferA.deviceAddress;
+    pushConstants.addressB = bufferB.deviceAddress;
+    pushConstants.addressC = bufferC.deviceAddress;
+    pushConstants.addressD = bufferD.deviceAddress;
+    pushConstants.pointerArray = pointerArrayBuffer.deviceAddress;
+    pushConstants.M = M;
+    pushConstants.N = N;
+    pushConstants.K = K;
+    pushConstants.batchCount = batchCount;
+    pushConstants.numDistinctMatrices = numDistinctMatrices;
+    const uint32_t maxGroupCountX = device->getLimits().maxComputeWorkGroupCount[0];
+    const uint32_t groupCountX = std::min(batchCount, maxGroupCountX);
+    const uint32_t groupCountY = (batchCount + groupCountX - 1) / groupCountX;
+
+    if (mode == BatchingMode::DISPATCH_PER_MATRIX) {
+        // Recording is expensive for large batches, so fewer iterations are used.
+        return measureCommandsMs(context, [&](VkCommandBuffer commandBuffer) {
+            stridedPipeline->bind(commandBuffer);
+            BatchedGemmPushConstants dispatchPushConstants = pushConstants;
+            dispatchPushConstants.batchCount = 1;
+            dispatchPushConstants.numDistinctMatrices = 1;
+            for (uint32_t i = 0; i < batchCount; i++) {
+                uint32_t matrixIdx = i % numDistinctMatrices;
+                dispatchPushConstants.addressA = bufferA.deviceAddress + matrixIdx * sizeA;
+                dispatchPushConstants.addressB = bufferB.deviceAddress + matrixIdx * sizeB;
+                dispatchPushConstants.addressC = bufferC.deviceAddress + matrixIdx * sizeC;
+                dispatchPushConstants.addressD = bufferD.deviceAddress + matrixIdx * sizeD;
+                stridedPipeline->pushConstants(
+                        commandBuffer, &dispatchPushConstants, sizeof(BatchedGemmPushConstants));
+                vkCmdDispatch(commandBuffer, 1, 1, 1);
+            }
+        }, batchCount >= 10000 ? 2 : 10);
+    }
+    const ComputePipeline& pipeline = mode == BatchingMode::STRIDED ? *stridedPipeline : *pointerArrayPipeline;
+    return measureCommandsMs(context, [&](VkCommandBuffer commandBuffer) {
+        pipeline.bind(commandBuffer);
+        pipeline.pushConstants(commandBuffer, &pushConstants, sizeof(BatchedGemmPushConstants));
+        vkCmdDispatch(commandBuffer, groupCountX, groupCountY, 1);
+    });
+}
+
+void runBatchedGemmBenchmark(sgl::vk::Device* device) {
+    writeOut("");
+    writeOut("Batched GEMM benchmark (matrices of ", MATRIX_SIZE, "x", MATRIX_SIZE, "x", MATRIX_SIZE,
+             " rounded up to the cooperative matrix size; TFLOP/s and latency of the whole batch in us):");
+    if (!device->getCooperativeMatrixFeaturesKHR().cooperativeMatrix) {
+        writeOut("VK_KHR_cooperative_matrix is not supported.");
+        return;
+    }
+
+    const std::pair<BatchingMode, const char*> modes[] = {
+            { BatchingMode::DISPATCH_PER_MATRIX, "Per dispatch" },
+            { BatchingMode::STRIDED, "Strided" },
+            { BatchingMode::POINTER_ARRAY, "Pointer array" },
+    };
+    std::vector<std::string> columnNames = { "Types", "M x N x K", "Batch count" };
+    for (const auto& mode : modes) {
+        columnNames.push_back(std::string() + mode.second + " TFLOP/s");
+        columnNames.push_back(std::string() + mode.second + " latency");
+    }
+    ResultTable table(columnNames);
+
+    try {
+        CommandContext context(device);
+        for (const auto& props : device->getSupportedCooperativeMatrixPropertiesKHR()) {
+            // The entries with saturatingAccumulation share their shapes with the ones without.
+            if (props.scope != VK_SCOPE_SUBGROUP_KHR || props.saturatingAccumulation) {
+                continue;
+            }
+            CoopMatGemmSettings settings = CoopMatGemmSettings::fromProperties(props);
+            std::string types = CoopMatGemm::getVariantName(settings);
+            std::string shape =
+                    std::to_string(props.MSize) + "x" + std::to_string(props.NSize) + "x" + std::to_string(props.KSize);
+            std::string unsupportedReason = CoopMatGemm::checkSupport(device, settings);
+            if (unsupportedReason.empty() && !findEmbeddedKernel("BatchedGemm", types)) {
+                unsupportedReason = "no kernel";
+            }
+            if (!unsupportedReason.empty()) {
+                std::vector<std::string> row = { types, shape, "-" };
+                row.resize(columnNames.size(), unsupportedReason);
+                table.addRow(row);
+                continue;
+            }
+            try {
+                BatchedGemm batchedGemm(device, context, settings);
+                for (uint32_t batchCount : BATCH_COUNTS) {
+                    if (batchCount > getReducedProblemSize(MAX_BATCH_COUNT)) {
+                        continue;
+                    }
+                    std::vector<std::string> row = { types, shape, std::to_string(batchCount) };
+                    for (const auto& mode : modes) {
+                        try {
+                            double timeMs = batchedGemm.measureBatchMs(mode.first, batchCount);
+                            row.push_back(formatNumber(batchedGemm.getNumOperations(batchCount) / (timeMs * 1e9), 3));
+                            row.push_back(formatNumber(timeMs * 1e3, 1));
+                        } catch (const std::exception& e) {
+                            sgl::Logfile::get()->writeError(
+                                    std::string() + "Error in runBatchedGemmBenchmark (" + types + ", "
+                                    + mode.second + "): " + e.what(), false);
+                            row.insert(row.end(), 2, "failed");
+                        }
+                    }
+                    table.addRow(row);
+                }
+            } catch (const std::exception& e) {
+                sgl::Logfile::get()->writeError(
+                        std::string() + "Error in runBatchedGemmBenchmark (" + types + "): " + e.what(), false);
+                std::vector<std::string> row = { types, shape, "-" };
+                row.resize(columnNames.size(), "failed");
+                table.addRow(row);
+            }
+        }
+    } catch (const std::exception& e) {
+        sgl::Logfile::get()->writeError(std::string() + "Error in runBatchedGemmBenchmark: " + e.what(), false);
+    }
+    table.print();
+}
@@ -0,0 +1,351 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <Utils/File/Logfile.hpp>
+#include <Graphics/Vulkan/libs/volk/volk.h>
+#include <Graphics/Vulkan/Utils/Device.hpp>
+
+#include "PrintUtils.hpp"
+#include "ComponentTypes.hpp"
+#include "NumberFormats.hpp"
+#include "VulkanUtils.hpp"
+#include "Kernels.hpp"
+#include "RooflineBenchmark.hpp"
+#include "ConvolutionBenchmark.hpp"
+
+static const uint32_t BATCH_SIZE = 32;
+static const uint32_t TILE_M = 2, TILE_N = 2;
+static const uint32_t NUM_SUBGROUPS = 4;
+/// Maximum relative deviation of the tensor addressing results from the manual im2col result.
+static const double MAX_RELATIVE_ERROR = 1e-3;
+
+struct ConvolutionPushConstants {
+    VkDeviceAddress bufferX, bufferW, bufferY;
+    uint32_t M, N, K;
+    uint32_t batchSize, H, W, C, R, S, P, Q;
+    uint32_t convStride, padding, dilation;
+};
+
+struct ConvolutionLayer {
+    const char* name;
+    uint32_t H, W, C, outChannels, R, S, convStride, padding, dilation;
+
+    [[nodiscard]] uint32_t getP() const { return (H + 2 * padding - dilation * (R - 1) - 1) / convStride + 1; }
+    [[nodiscard]] uint32_t getQ() const { return (W + 2 * padding - dilation * (S - 1) - 1) / convStride + 1; }
+    [[nodiscard]] bool getIsPlainMatrix() const { return R == 1 && S == 1 && convStride == 1 && padding == 0; }
+};
+
+// ResNet-50 style layers plus a dilated (DeepLab style) layer.
+static const ConvolutionLayer LAYERS[] = {
+        { "3x3", 56, 56, 64, 64, 3, 3, 1, 1, 1 },
+        { "1x1", 56, 56, 64, 256, 1, 1, 1, 0, 1 },
+        { "3x3 stride 2", 56, 56, 128, 128, 3, 3, 2, 1, 1 },
+        { "1x1 stride 2", 56, 56, 256, 512, 1, 1, 2, 0, 1 },
+        { "3x3", 28, 28, 128, 128, 3, 3, 1, 1, 1 },
+        { "3x3", 14, 14, 256, 256, 3, 3, 1, 1, 1 },
+        { "3x3 dilation 2", 14, 14, 256, 256, 3, 3, 1, 2, 2 },
+        { "1x1", 7, 7, 512, 2048, 1, 1, 1, 0, 1 },
+};
+
+enum class ConvolutionPath {
+    IM2COL, TENSOR_DECODE, TENSOR_VIEW
+};
+
+static const char* getConvolutionPathName(ConvolutionPath path) {
+    if (path == ConvolutionPath::IM2COL) {
+        return "im2col";
+    } else if (path == ConvolutionPath::TENSOR_DECODE) {
+        return "tensor_decode";
+    } else {
+        return "tensor_view";
+    }
+}
+
+static uint32_t roundUpToMultiple(uint32_t value, uint32_t multiple) {
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+static uint32_t getBatchSize() {
+    return getReducedProblemSize(BATCH_SIZE);
+}
+
+class ImplicitGemmConvolution {
+public:
+    ImplicitGemmConvolution(
+            sgl::vk::Device* device, CommandContext& context, const VkCooperativeMatrixPropertiesKHR& props,
+            uint32_t subgroupSize, const ConvolutionLayer& layer, bool isInputNchw);
+    ~ImplicitGemmConvolution();
+    [[nodiscard]] double getNumOperations() const { return 2.0 * double(M) * double(N) * double(K); }
+    /// Compulsory DRAM traffic: reading X and W once and writing the unpadded output.
+    [[nodiscard]] double getNumBytes() const { return numBytes; }
+    /// Returns the throughput in TFLOP/s.
+    double measureTeraOpsPerSecond(ConvolutionPath path);
+    /// Returns the unpadded M x N output of the last measured path.
+    std::vector<float> downloadResult();
+
+private:
+    void destroyBuffers();
+
+    sgl::vk::Device* device;
+    CommandContext& context;
+    VkCooperativeMatrixPropertiesKHR props;
+    uint32_t subgroupSize; ///< Required subgroup size of the kernels.
+    bool isInputNchw;
+    uint32_t M, N, K, paddedM;
+    double numBytes = 0.0;
+    ConvolutionPushConstants pushConstants{};
+    DeviceBuffer bufferX, bufferW, bufferY;
+};
+
+ImplicitGemmConvolution::ImplicitGemmConvolution(
+        sgl::vk::Device* device, CommandContext& context, const VkCooperativeMatrixPropertiesKHR& props,
+        uint32_t subgroupSize, const ConvolutionLayer& layer, bool isInputNchw)
+        : device(device), context(context), props(props), subgroupSize(subgroupSize), isInputNchw(isInputNchw) {
+    const uint32_t P = layer.getP(), Q = layer.getQ();
+    M = getBatchSize() * P * Q;
+    N = layer.outChannels;
+    K = layer.R * layer.S * layer.C;
+    paddedM = roundUpToMultiple(M, props.MSize * TILE_M);
+    if (N % (props.NSize * TILE_N) != 0 || K % props.KSize != 0) {
+        throw std::runtime_error("Layer dimensions are not multiples of the cooperative matrix size.");
+    }
+
+    pushConstants.batchSize = getBatchSize();
+    pushConstants.H = layer.H;
+    pushConstants.W = layer.W;
+    pushConstants.C = layer.C;
+    pushConstants.R = layer.R;
+    pushConstants.S = layer.S;
+    pushConstants.P = P;
+    pushConstants.Q = Q;
+    pushConstants.convStride = layer.convStride;
+    pushConstants.padding = layer.padding;
+    pushConstants.dilation = layer.dilation;
+    pushConstants.N = N;
+    pushConstants.K = K;
+
+    const size_t numElementsX = size_t(getBatchSize()) * layer.H * layer.W * layer.C;
+    std::vector<uint8_t> dataX = createRandomElements(props.AType, numElementsX, 1);
+    std::vector<uint8_t> dataW = createRandomElements(props.BType, size_t(N) * size_t(K), 2);
+    numBytes = double(dataX.size()) + double(dataW.size())
+            + double(M) * double(N) * double(getComponentTypeSize(props.ResultType));
+    const VkBufferUsageFlags usage =
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT
+            | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    try {
+        bufferX = createDeviceBuffer(device, dataX.size(), usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        bufferW = createDeviceBuffer(device, dataW.size(), usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        bufferY = createDeviceBuffer(
+                device, size_t(paddedM) * size_t(N) * getComponentTypeSize(props.ResultType), usage,
+                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        uploadBufferData(device, context, bufferX, dataX.data(), dataX.size());
+        uploadBufferData(device, context, bufferW, dataW.data(), dataW.size());
+    } catch (...) {
+        destroyBuffers();
+        throw;
+    }
+    pushConstants.bufferX = bufferX.deviceAddress;
+    pushConstants.bufferW = bufferW.deviceAddress;
+    pushConstants.bufferY = bufferY.deviceAddress;
+}
+
+ImplicitGemmConvolution::~ImplicitGemmConvolution() {
+    destroyBuffers();
+}
+
+void ImplicitGemmConvolution::destroyBuffers() {
+    VkDevice vkDevice = device->getVkDevice();
+    destroyDeviceBuffer(vkDevice, bufferX);
+    destroyDeviceBuffer(vkDevice, bufferW);
+    destroyDeviceBuffer(vkDevice, bufferY);
+}
+
+double ImplicitGemmConvolution::measureTeraOpsPerSecond(ConvolutionPath path) {
+    const std::string variantName = std::string(isInputNchw ? "nchw_" : "nhwc_") + getConvolutionPathName(path);
+    const EmbeddedKernel* kernel = findEmbeddedKernel("ImplicitGemmConv", variantName);
+    if (!kernel) {
+        throw std::runtime_error("Kernel variant ImplicitGemmConv/" + variantName + " is not available.");
+    }
+    ComputePipelineSettings pipelineSettings{};
+    pipelineSettings.code = kernel->code;
+    pipelineSettings.codeSize = kernel->codeSize;
+    pipelineSettings.specializationConstants = {
+            subgroupSize * NUM_SUBGROUPS, props.MSize, props.NSize, props.KSize, TILE_M, TILE_N, NUM_SUBGROUPS };
+    pipelineSettings.pushConstantSize = sizeof(ConvolutionPushConstants);
+    pipelineSettings.requiredSubgroupSize = subgroupSize;
+    ComputePipeline pipeline(device->getVkDevice(), pipelineSettings);
+
+    // The tensor paths clamp the out-of-bounds rows themselves; the manual path needs padded rows.
+    pushConstants.M = path == ConvolutionPath::IM2COL ? paddedM : M;
+    uint32_t numSubgroupTiles = (paddedM / (props.MSize * TILE_M)) * (N / (props.NSize * TILE_N));
+    uint32_t numWorkgroups = (numSubgroupTiles + NUM_SUBGROUPS - 1) / NUM_SUBGROUPS;
+    double timeMs = measureCommandsMs(context, [&](VkCommandBuffer commandBuffer) {
+        pipeline.bind(commandBuffer);
+        pipeline.pushConstants(commandBuffer, &pushConstants, sizeof(ConvolutionPushConstants));
+        vkCmdDispatch(commandBuffer, numWorkgroups, 1, 1);
+    });
+    return getNumOperations() / (timeMs * 1e9);
+}
+
+std::vector<float> ImplicitGemmConvolution::downloadResult() {
+    std::vector<uint8_t> dataY(bufferY.size);
+    downloadBufferData(device, context, bufferY, dataY.data(), dataY.size());
+    std::vector<float> result(size_t(M) * size_t(N));
+    for (size_t i = 0; i < result.size(); i++) {
+        result[i] = float(readElement(dataY.data(), props.ResultType, i));
+    }
+    return result;
+}
+
+static bool getResultsMatch(const std::vector<float>& reference, const std::vector<float>& result) {
+    double maxAbsReference = 0.0, maxAbsError = 0.0;
+    for (size_t i = 0; i < reference.size(); i++) {
+        maxAbsReference = std::max(maxAbsReference, double(std::abs(reference[i])));
+        maxAbsError = std::max(maxAbsError, double(std::abs(reference[i] - result[i])));
+    }
+    return maxAbsError <= MAX_RELATIVE_ERROR * std::max(maxAbsReference, 1.0);
+}
+
+void runConvolutionBenchmark(sgl::vk::Device* device) {
+    writeOut("");
+    writeOut("Implicit GEMM convolution benchmark (TFLOP/s, batch size ", getBatchSize(), "):");
+    if (!device->getCooperativeMatrixFeaturesKHR().cooperativeMatrix) {
+        writeOut("VK_KHR_cooperative_matrix is not supported.");
+        return;
+    }
+    if (!getIsComponentTypeUsable(device, VK_COMPONENT_TYPE_FLOAT16_KHR)) {
+        writeOut("float16 is not usable in shaders.");
+        return;
+    }
+    const VkCooperativeMatrixPropertiesKHR* selectedProps = nullptr;
+    for (const auto& props : device->getSupportedCooperativeMatrixPropertiesKHR()) {
+        if (props.scope == VK_SCOPE_SUBGROUP_KHR && props.AType == VK_COMPONENT_TYPE_FLOAT16_KHR
+                && props.BType == VK_COMPONENT_TYPE_FLOAT16_KHR && props.CType == VK_COMPONENT_TYPE_FLOAT32_KHR
+                && props.ResultType == VK_COMPONENT_TYPE_FLOAT32_KHR) {
+            selectedProps = &props;
+            break;
+        }
+    }
+    if (!selectedProps) {
+        writeOut("No subgroup scope float16 x float16 + float32 configuration is supported.");
+        return;
+    }
+    const VkCooperativeMatrixPropertiesKHR props = *selectedProps;
+
+    /*
+     * The manual path indexes its shared memory by gl_SubgroupID, so the subgroup size needs to be fixed. Without a
+     * required subgroup size, SPIR-V 1.6 allows a smaller size and thus more subgroups than the shared arrays have
+     * slots for.
+     */
+    const auto& properties13 = device->getPhysicalDeviceVulkan13Properties();
+    uint32_t subgroupSize = device->getPhysicalDeviceSubgroupProperties().subgroupSize;
+    if (!device->getPhysicalDeviceVulkan13Features().subgroupSizeControl
+            || (properties13.requiredSubgroupSizeStages & VK_SHADER_STAGE_COMPUTE_BIT) == 0) {
+        writeOut("Subgroup size control is not supported for compute shaders.");
+        return;
+    }
+    const auto& features2 = device->getCooperativeMatrix2FeaturesNV();
+    bool hasTensorAddressing = features2.cooperativeMatrixTensorAddressing;
+    bool hasDecodeFunctions = hasTensorAddressing && features2.cooperativeMatrixBlockLoads;
+    writeOut("Matrix size: ", props.MSize, "x", props.NSize, "x", props.KSize,
+             ", cooperativeMatrixTensorAddressing: ", hasTensorAddressing,
+             ", cooperativeMatrixBlockLoads: ", bool(features2.cooperativeMatrixBlockLoads));
+
+    ResultTable table({
+            "Layer", "H x W", "C -> K", "Layout", "GEMM M x N x K", "im2col", "Tensor decode", "Tensor view",
+            "Decode speedup" });
+    auto addRooflineRun = [&](
+            const ImplicitGemmConvolution& convolution, const ConvolutionLayer& layer, bool isInputNchw,
+            ConvolutionPath path, double teraOpsPerSecond) {
+        RooflineKernelRun run;
+        run.category = "Convolution";
+        run.label = std::string("conv ") + layer.name + " " + (isInputNchw ? "NCHW " : "NHWC ")
+                + getConvolutionPathName(path);
+        run.types = getTypeCombinationLabel(props);
+        run.numOperations = convolution.getNumOperations();
+        run.numBytes = convolution.getNumBytes();
+        run.timeMs = run.numOperations / (teraOpsPerSecond * 1e9);
+        addRooflineKernelRun(run);
+    };
+    try {
+        CommandContext context(device);
+        for (const auto& layer : LAYERS) {
+            for (bool isInputNchw : { false, true }) {
+                std::vector<std::string> row = {
+                        layer.name, std::to_string(layer.H) + "x" + std::to_string(layer.W),
+                        std::to_string(layer.C) + " -> " + std::to_string(layer.outChannels),
+                        isInputNchw ? "NCHW" : "NHWC",
+                        std::to_string(getBatchSize() * layer.getP() * layer.getQ()) + "x"
+                        + std::to_string(layer.outChannels) + "x" + std::to_string(layer.R * layer.S * layer.C) };
+                try {
+                    ImplicitGemmConvolution convolution(
+                            device, context, props, subgroupSize, layer, isInputNchw);
+                    double im2colTops = convolution.measureTeraOpsPerSecond(ConvolutionPath::IM2COL);
+                    std::vector<float> reference = convolution.downloadResult();
+                    row.push_back(formatNumber(im2colTops));
+                    addRooflineRun(convolution, layer, isInputNchw, ConvolutionPath::IM2COL, im2colTops);
+
+                    double decodeTops = 0.0;
+                    if (hasDecodeFunctions) {
+                        decodeTops = convolution.measureTeraOpsPerSecond(ConvolutionPath::TENSOR_DECODE);
+                        bool matches = getResultsMatch(reference, convolution.downloadResult());
+                        row.push_back(formatNumber(decodeTops) + (matches ? "" : " (mismatch)"));
+                        addRooflineRun(convolution, layer, isInputNchw, ConvolutionPath::TENSOR_DECODE, decodeTops);
+                    } else {
+                        row.emplace_back("n/a");
+                    }
+                    if (hasTensorAddressing && !isInputNchw && layer.getIsPlainMatrix()) {
+                        double viewTops = convolution.measureTeraOpsPerSecond(ConvolutionPath::TENSOR_VIEW);
+                        bool matches = getResultsMatch(reference, convolution.downloadResult());
+                        row.push_back(formatNumber(viewTops) + (matches ? "" : " (mismatch)"));
+                        addRooflineRun(convolution, layer, isInputNchw, ConvolutionPath::TENSOR_VIEW, viewTops);
+                    } else {
+                        row.emplace_back(hasTensorAddressing ? "-" : "n/a");
+                    }
+                    row.push_back(decodeTops > 0.0 ? formatNumber(decodeTops / im2colTops) + "x" : "-");
+                } catch (const std::exception& e) {
+                    sgl::Logfile::get()->writeError(
+                            std::string() + "Error in runConvolutionBenchmark (" + layer.name + ", "
+                            + (isInputNchw ? "NCHW" : "NHWC") + "): " + e.what(), false);
+                    row.resize(9, "failed");
+                }
+                table.addRow(row);
+            }
+        }
+    } catch (const std::exception& e) {
+        sgl::Logfile::get()->writeError(std::string() + "Error in runConvolutionBenchmark: " + e.what(), false);
+    }
+    writeOut("Tensor view loads only apply to NHWC inputs of 1x1 convolutions with stride 1 and no padding.");
+    table.print();
+}
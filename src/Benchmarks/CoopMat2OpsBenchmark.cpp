@@ -0,0 +1,275 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <Utils/File/Logfile.hpp>
+#include <Graphics/Vulkan/libs/volk/volk.h>
+#include <Graphics/Vulkan/Utils/Device.hpp>
+
+#include "PrintUtils.hpp"
+#include "ComponentTypes.hpp"
+#include "NumberFormats.hpp"
+#include "VulkanUtils.hpp"
+#include "Kernels.hpp"
+#include "CoopMat2OpsBenchmark.hpp"
+
+static const uint32_t NUM_SUBGROUPS = 4;
+static const uint32_t NUM_REPETITIONS = 256;
+static const uint32_t NUM_WORKGROUPS = 1024;
+
+struct CoopMat2OpsPushConstants {
+    VkDeviceAddress bufferA, bufferB, bufferD;
+    float parameter;
+};
+
+struct CoopMat2Operation {
+    const char* name;
+    const char* kernelName; ///< Prefix of the kernel variants "<kernelName>_<path>".
+    const char* baselineVariant;
+    VkBool32 VkPhysicalDeviceCooperativeMatrix2FeaturesNV::* requiredFeature;
+    bool hasElementLoop;
+    float parameter; ///< Keeps the values bounded over the repetitions.
+};
+
+static const CoopMat2Operation OPERATIONS[] = {
+        { "Conversion (accumulator to A)", "convert", "convert_baseline",
+          &VkPhysicalDeviceCooperativeMatrix2FeaturesNV::cooperativeMatrixConversions, false, 0.0f },
+        { "Row reduction", "reduce_row", "reduce_baseline",
+          &VkPhysicalDeviceCooperativeMatrix2FeaturesNV::cooperativeMatrixReductions, false, 0.999f },
+        { "Column reduction", "reduce_column", "reduce_baseline",
+          &VkPhysicalDeviceCooperativeMatrix2FeaturesNV::cooperativeMatrixReductions, false, 0.999f },
+        { "2x2 reduction", "reduce_2x2", "reduce_2x2_baseline",
+          &VkPhysicalDeviceCooperativeMatrix2FeaturesNV::cooperativeMatrixReductions, false, 0.999f },
+        { "Scale", "scale", "element_baseline",
+          &VkPhysicalDeviceCooperativeMatrix2FeaturesNV::cooperativeMatrixPerElementOperations, true, 0.999f },
+        { "Clamp", "clamp", "element_baseline",
+          &VkPhysicalDeviceCooperativeMatrix2FeaturesNV::cooperativeMatrixPerElementOperations, true, 0.5f },
+        { "Activation (GELU)", "activation", "element_baseline",
+          &VkPhysicalDeviceCooperativeMatrix2FeaturesNV::cooperativeMatrixPerElementOperations, true, 0.0f },
+};
+
+class CoopMat2OpsMeasurement {
+public:
+    CoopMat2OpsMeasurement(
+            sgl::vk::Device* device, CommandContext& context, const VkCooperativeMatrixPropertiesKHR& props,
+            uint32_t subgroupSize);
+    ~CoopMat2OpsMeasurement();
+    /// Returns the time of one dispatch in microseconds.
+    double measureUs(const std::string& variantName, float parameter);
+
+private:
+    void destroyBuffers();
+
+    sgl::vk::Device* device;
+    CommandContext& context;
+    VkCooperativeMatrixPropertiesKHR props;
+    uint32_t subgroupSize; ///< Required subgroup size of the kernels.
+    DeviceBuffer bufferA, bufferB, bufferD;
+};
+
+CoopMat2OpsMeasurement::CoopMat2OpsMeasurement(
+        sgl::vk::Device* device, CommandContext& context, const VkCooperativeMatrixPropertiesKHR& props,
+        uint32_t subgroupSize)
+        : device(device), context(context), props(props), subgroupSize(subgroupSize) {
+    const VkBufferUsageFlags usage =
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT
+            | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    // Small inputs, such that the chained multiply-adds of the conversion benchmark (growth factor 1 + 0.01 * K * 0.001
+    // per repetition) do not overflow.
+    std::vector<uint8_t> dataA(props.MSize * props.KSize * sizeof(uint16_t));
+    std::vector<uint8_t> dataB(props.KSize * props.NSize * sizeof(uint16_t));
+    for (size_t i = 0; i < dataA.size() / sizeof(uint16_t); i++) {
+        writeElement(dataA.data(), props.AType, i, 0.01);
+    }
+    for (size_t i = 0; i < dataB.size() / sizeof(uint16_t); i++) {
+        writeElement(dataB.data(), props.BType, i, 0.001);
+    }
+    try {
+        bufferA = createDeviceBuffer(device, dataA.size(), usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        bufferB = createDeviceBuffer(device, dataB.size(), usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        bufferD = createDeviceBuffer(
+                device, 2 * props.MSize * props.NSize * sizeof(float), usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        uploadBufferData(device, context, bufferA, dataA.data(), dataA.size());
+        uploadBufferData(device, context, bufferB, dataB.data(), dataB.size());
+    } catch (...) {
+        destroyBuffers();
+        throw;
+    }
+}
+
+CoopMat2OpsMeasurement::~CoopMat2OpsMeasurement() {
+    destroyBuffers();
+}
+
+void CoopMat2OpsMeasurement::destroyBuffers() {
+    VkDevice vkDevice = device->getVkDevice();
+    destroyDeviceBuffer(vkDevice, bufferA);
+    destroyDeviceBuffer(vkDevice, bufferB);
+    destroyDeviceBuffer(vkDevice, bufferD);
+}
+
+double CoopMat2OpsMeasurement::measureUs(const std::string& variantName, float parameter) {
+    const EmbeddedKernel* kernel = findEmbeddedKernel("CoopMat2Ops", variantName);
+    if (!kernel) {
+        throw std::runtime_error("Kernel variant CoopMat2Ops/" + variantName + " is not available.");
+    }
+    ComputePipelineSettings pipelineSettings{};
+    pipelineSettings.code = kernel->code;
+    pipelineSettings.codeSize = kernel->codeSize;
+    pipelineSettings.specializationConstants = {
+            subgroupSize * NUM_SUBGROUPS, props.MSize, props.NSize, props.KSize, NUM_SUBGROUPS, NUM_REPETITIONS };
+    pipelineSettings.pushConstantSize = sizeof(CoopMat2OpsPushConstants);
+    pipelineSettings.requiredSubgroupSize = subgroupSize;
+    ComputePipeline pipeline(device->getVkDevice(), pipelineSettings);
+
+    CoopMat2OpsPushConstants pushConstants{};
+    pushConstants.bufferA = bufferA.deviceAddress;
+    pushConstants.bufferB = bufferB.deviceAddress;
+    pushConstants.bufferD = bufferD.deviceAddress;
+    pushConstants.parameter = parameter;
+    return 1e3 * measureCommandsMs(context, [&](VkCommandBuffer commandBuffer) {
+        pipeline.bind(commandBuffer);
+        pipeline.pushConstants(commandBuffer, &pushConstants, sizeof(CoopMat2OpsPushConstants));
+        vkCmdDispatch(commandBuffer, getReducedProblemSize(NUM_WORKGROUPS), 1, 1);
+    });
+}
+
+/// Returns the time minus the baseline time in microseconds as a string, or "failed".
+static std::string measureNetTime(
+        CoopMat2OpsMeasurement& measurement, const std::string& variantName, float parameter, double baselineUs,
+        double& netUs) {
+    try {
+        netUs = measurement.measureUs(variantName, parameter) - baselineUs;
+        return formatNumber(netUs);
+    } catch (const std::exception& e) {
+        sgl::Logfile::get()->writeError(
+                std::string() + "Error in runCoopMat2OpsBenchmark (" + variantName + "): " + e.what(), false);
+        netUs = -1.0;
+        return "failed";
+    }
+}
+
+void runCoopMat2OpsBenchmark(sgl::vk::Device* device) {
+    writeOut("");
+    writeOut("Cooperative matrix 2 operations benchmark:");
+    if (!device->getCooperativeMatrixFeaturesKHR().cooperativeMatrix) {
+        writeOut("VK_KHR_cooperative_matrix is not supported.");
+        return;
+    }
+    if (!getIsComponentTypeUsable(device, VK_COMPONENT_TYPE_FLOAT16_KHR)) {
+        writeOut("float16 is not usable in shaders.");
+        return;
+    }
+
+    // The conversion benchmark feeds the converted accumulator back as the A matrix, which requires N == K.
+    const VkCooperativeMatrixPropertiesKHR* selectedProps = nullptr;
+    for (const auto& props : device->getSupportedCooperativeMatrixPropertiesKHR()) {
+        if (props.scope == VK_SCOPE_SUBGROUP_KHR && props.AType == VK_COMPONENT_TYPE_FLOAT16_KHR
+                && props.BType == VK_COMPONENT_TYPE_FLOAT16_KHR && props.CType == VK_COMPONENT_TYPE_FLOAT32_KHR
+                && props.ResultType == VK_COMPONENT_TYPE_FLOAT32_KHR && props.NSize == props.KSize
+                && props.MSize % 2 == 0 && props.NSize % 2 == 0) {
+            selectedProps = &props;
+            break;
+        }
+    }
+    if (!selectedProps) {
+        writeOut("No subgroup scope float16 x float16 + float32 configuration with N == K is supported.");
+        return;
+    }
+    const VkCooperativeMatrixPropertiesKHR props = *selectedProps;
+
+    /*
+     * The kernel indexes its shared memory by gl_SubgroupID, so the subgroup size needs to be fixed. Without a required
+     * subgroup size, SPIR-V 1.6 allows a smaller size and thus more subgroups than the shared arrays have slots for.
+     */
+    const auto& properties13 = device->getPhysicalDeviceVulkan13Properties();
+    uint32_t subgroupSize = device->getPhysicalDeviceSubgroupProperties().subgroupSize;
+    if (!device->getPhysicalDeviceVulkan13Features().subgroupSizeControl
+            || (properties13.requiredSubgroupSizeStages & VK_SHADER_STAGE_COMPUTE_BIT) == 0) {
+        writeOut("Subgroup size control is not supported for compute shaders.");
+        return;
+    }
+    const auto& features2 = device->getCooperativeMatrix2FeaturesNV();
+    writeOut(
+            "Matrix size: ", props.MSize, "x", props.NSize, "x", props.KSize, ", subgroup size: ", subgroupSize,
+            ", ", getReducedProblemSize(NUM_WORKGROUPS), " workgroups of ", NUM_SUBGROUPS, " subgroups, ",
+            NUM_REPETITIONS, " repetitions per subgroup.");
+    writeOut("Net time per dispatch in microseconds (minus the loop-carried dependency baseline):");
+
+    ResultTable table({
+            "Operation", "Baseline", "Fused (NV2)", "Element loop (KHR)", "Shared memory round trip",
+            "Fused speedup" });
+    try {
+        CommandContext context(device);
+        CoopMat2OpsMeasurement measurement(device, context, props, subgroupSize);
+        for (const auto& operation : OPERATIONS) {
+            const std::string kernelName = operation.kernelName;
+            std::vector<std::string> row = { operation.name };
+            double baselineUs = 0.0;
+            try {
+                baselineUs = measurement.measureUs(operation.baselineVariant, operation.parameter);
+                row.push_back(formatNumber(baselineUs));
+            } catch (const std::exception& e) {
+                sgl::Logfile::get()->writeError(
+                        std::string() + "Error in runCoopMat2OpsBenchmark (" + operation.baselineVariant + "): "
+                        + e.what(), false);
+                row.resize(6, "failed");
+                table.addRow(row);
+                continue;
+            }
+
+            double fusedUs = -1.0, elementLoopUs = -1.0, sharedUs = -1.0;
+            if (features2.*operation.requiredFeature) {
+                row.push_back(measureNetTime(
+                        measurement, kernelName + "_fused", operation.parameter, baselineUs, fusedUs));
+            } else {
+                row.emplace_back("n/a");
+            }
+            if (operation.hasElementLoop) {
+                row.push_back(measureNetTime(
+                        measurement, kernelName + "_element_loop", operation.parameter, baselineUs, elementLoopUs));
+            } else {
+                row.emplace_back("-");
+            }
+            row.push_back(measureNetTime(
+                    measurement, kernelName + "_shared", operation.parameter, baselineUs, sharedUs));
+            if (fusedUs > 0.0 && sharedUs > 0.0) {
+                row.push_back(formatNumber(sharedUs / fusedUs) + "x");
+            } else {
+                row.emplace_back("-");
+            }
+            table.addRow(row);
+        }
+    } catch (const std::exception& e) {
+        sgl::Logfile::get()->writeError(std::string() + "Error in runCoopMat2OpsBenchmark: " + e.what(), false);
+    }
+    table.print();
+}
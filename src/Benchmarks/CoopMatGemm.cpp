@@ -0,0 +1,250 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdexcept>
+#include <utility>
+
+#include <Graphics/Vulkan/libs/volk/volk.h>
+
+#include "ComponentTypes.hpp"
+#include "NumberFormats.hpp"
+#include "Kernels.hpp"
+#include "CoopMatGemm.hpp"
+
+struct GemmPushConstants {
+    VkDeviceAddress addressA, addressB, addressC, addressD;
+    uint32_t M, N, K;
+};
+
+CoopMatGemmSettings CoopMatGemmSettings::fromProperties(const VkCooperativeMatrixPropertiesKHR& props) {
+    CoopMatGemmSettings settings{};
+    settings.AType = props.AType;
+    settings.BType = props.BType;
+    settings.CType = props.CType;
+    settings.ResultType = props.ResultType;
+    settings.lM = props.MSize;
+    settings.lN = props.NSize;
+    settings.lK = props.KSize;
+    settings.saturatingAccumulation = props.saturatingAccumulation;
+    settings.scope = props.scope;
+    return settings;
+}
+
+CoopMatGemmSettings CoopMatGemmSettings::fromProperties(
+        const VkCooperativeMatrixFlexibleDimensionsPropertiesNV& props) {
+    CoopMatGemmSettings settings{};
+    settings.AType = props.AType;
+    settings.BType = props.BType;
+    settings.CType = props.CType;
+    settings.ResultType = props.ResultType;
+    settings.lM = props.MGranularity;
+    settings.lN = props.NGranularity;
+    settings.lK = props.KGranularity;
+    settings.saturatingAccumulation = props.saturatingAccumulation;
+    settings.scope = props.scope;
+    settings.workgroupInvocations = props.workgroupInvocations;
+    return settings;
+}
+
+std::string CoopMatGemm::getVariantName(const CoopMatGemmSettings& settings) {
+    return getComponentTypeShortName(settings.AType) + "_" + getComponentTypeShortName(settings.BType) + "_"
+            + getComponentTypeShortName(settings.CType) + "_" + getComponentTypeShortName(settings.ResultType)
+            + (settings.saturatingAccumulation ? "_sat" : "")
+            + (settings.scope == VK_SCOPE_WORKGROUP_KHR ? "_wg" : "");
+}
+
+std::string CoopMatGemm::checkSupport(sgl::vk::Device* device, const CoopMatGemmSettings& settings) {
+    if (!findEmbeddedKernel("CoopMatGemm", getVariantName(settings))) {
+        return "no kernel";
+    }
+    if (!device->getPhysicalDeviceVulkan12Features().bufferDeviceAddress) {
+        return "no bufferDeviceAddress";
+    }
+    if (settings.scope == VK_SCOPE_WORKGROUP_KHR
+            && !device->getCooperativeMatrix2FeaturesNV().cooperativeMatrixWorkgroupScope) {
+        return "no workgroup scope";
+    }
+    // The subgroup scope kernel derives its tile from gl_NumSubgroups (see getPipelineSettings).
+    if (settings.scope == VK_SCOPE_SUBGROUP_KHR
+            && (!device->getPhysicalDeviceVulkan13Features().subgroupSizeControl
+                || (device->getPhysicalDeviceVulkan13Properties().requiredSubgroupSizeStages
+                    & VK_SHADER_STAGE_COMPUTE_BIT) == 0)) {
+        return "no subgroup size control";
+    }
+    for (VkComponentTypeKHR compType : { settings.AType, settings.BType, settings.CType, settings.ResultType }) {
+        if (!getIsComponentTypeUsable(device, compType)) {
+            return "no " + getComponentTypeString(compType) + " support";
+        }
+    }
+    return "";
+}
+
+ComputePipelineSettings CoopMatGemm::getPipelineSettings(
+        sgl::vk::Device* device, const CoopMatGemmSettings& settings) {
+    const EmbeddedKernel* kernel = findEmbeddedKernel("CoopMatGemm", getVariantName(settings));
+    if (!kernel) {
+        throw std::runtime_error("CoopMatGemm: Kernel variant " + getVariantName(settings) + " is not available.");
+    }
+    uint32_t subgroupSize = settings.requiredSubgroupSize;
+    if (subgroupSize == 0) {
+        subgroupSize = device->getPhysicalDeviceSubgroupProperties().subgroupSize;
+    }
+    if (settings.scope == VK_SCOPE_WORKGROUP_KHR && settings.workgroupInvocations == 0) {
+        throw std::runtime_error("CoopMatGemm: Workgroup scope entries need workgroupInvocations.");
+    }
+    uint32_t workgroupSize = settings.scope == VK_SCOPE_WORKGROUP_KHR
+            ? settings.workgroupInvocations : subgroupSize * settings.subgroupsPerWorkgroup;
+    if (workgroupSize > device->getLimits().maxComputeWorkGroupInvocations) {
+        throw std::runtime_error("CoopMatGemm: Workgroup size exceeds maxComputeWorkGroupInvocations.");
+    }
+    if (settings.scope == VK_SCOPE_SUBGROUP_KHR && settings.subgroupsPerWorkgroup
+            > device->getPhysicalDeviceVulkan13Properties().maxComputeWorkgroupSubgroups) {
+        throw std::runtime_error("CoopMatGemm: Number of subgroups exceeds maxComputeWorkgroupSubgroups.");
+    }
+    ComputePipelineSettings pipelineSettings{};
+    pipelineSettings.code = kernel->code;
+    pipelineSettings.codeSize = kernel->codeSize;
+    pipelineSettings.specializationConstants = {
+            workgroupSize, settings.lM, settings.lN, settings.lK, settings.tileM, settings.tileN };
+    pipelineSettings.pushConstantSize = sizeof(GemmPushConstants);
+    /*
+     * The subgroup scope kernel computes tile gl_WorkGroupID.x * gl_NumSubgroups + gl_SubgroupID, and the dispatch
+     * assumes subgroupsPerWorkgroup subgroups. Without a required size, SPIR-V 1.6 pipelines may run with any size in
+     * [minSubgroupSize, maxSubgroupSize], such that tiles would be skipped, so the size used above is always pinned.
+     */
+    pipelineSettings.requiredSubgroupSize =
+            settings.scope == VK_SCOPE_SUBGROUP_KHR ? subgroupSize : settings.requiredSubgroupSize;
+    return pipelineSettings;
+}
+
+CoopMatGemm::CoopMatGemm(sgl::vk::Device* device, CommandContext& context, const CoopMatGemmSettings& _settings)
+        : device(device), context(context), settings(_settings) {
+    std::string unsupportedReason = checkSupport(device, settings);
+    if (!unsupportedReason.empty()) {
+        throw std::runtime_error("CoopMatGemm: " + unsupportedReason);
+    }
+
+    settings.M = getReducedProblemSize(settings.M, settings.lM * settings.tileM);
+    settings.N = getReducedProblemSize(settings.N, settings.lN * settings.tileN);
+    settings.K = getReducedProblemSize(settings.K, settings.lK);
+    pipeline = std::make_unique<ComputePipeline>(device->getVkDevice(), getPipelineSettings(device, settings));
+
+    const size_t numElementsA = size_t(settings.M) * size_t(settings.K);
+    const size_t numElementsB = size_t(settings.K) * size_t(settings.N);
+    const size_t numElementsC = size_t(settings.M) * size_t(settings.N);
+    dataA = createRandomElements(settings.AType, numElementsA, 1);
+    dataB = createRandomElements(settings.BType, numElementsB, 2);
+    dataC = createRandomElements(settings.CType, numElementsC, 3);
+    const VkBufferUsageFlags usage =
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT
+            | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    try {
+        bufferA = createDeviceBuffer(device, dataA.size(), usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        bufferB = createDeviceBuffer(device, dataB.size(), usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        bufferC = createDeviceBuffer(device, dataC.size(), usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        bufferD = createDeviceBuffer(
+                device, numElementsC * getComponentTypeSize(settings.ResultType), usage,
+                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        uploadBufferData(device, context, bufferA, dataA.data(), dataA.size());
+        uploadBufferData(device, context, bufferB, dataB.data(), dataB.size());
+        uploadBufferData(device, context, bufferC, dataC.data(), dataC.size());
+    } catch (...) {
+        VkDevice vkDevice = device->getVkDevice();
+        destroyDeviceBuffer(vkDevice, bufferA);
+        destroyDeviceBuffer(vkDevice, bufferB);
+        destroyDeviceBuffer(vkDevice, bufferC);
+        destroyDeviceBuffer(vkDevice, bufferD);
+        throw;
+    }
+}
+
+CoopMatGemm::~CoopMatGemm() {
+    VkDevice vkDevice = device->getVkDevice();
+    destroyDeviceBuffer(vkDevice, bufferA);
+    destroyDeviceBuffer(vkDevice, bufferB);
+    destroyDeviceBuffer(vkDevice, bufferC);
+    destroyDeviceBuffer(vkDevice, bufferD);
+}
+
+double CoopMatGemm::getNumOperations() const {
+    return 2.0 * double(settings.M) * double(settings.N) * double(settings.K);
+}
+
+void CoopMatGemm::recordDispatch(VkCommandBuffer commandBuffer) const {
+    recordDispatch(
+            commandBuffer, *pipeline, settings, bufferA.deviceAddress, bufferB.deviceAddress, bufferC.deviceAddress,
+            bufferD.deviceAddress);
+}
+
+void CoopMatGemm::recordDispatch(
+        VkCommandBuffer commandBuffer, const ComputePipeline& pipeline, const CoopMatGemmSettings& settings,
+        VkDeviceAddress addressA, VkDeviceAddress addressB, VkDeviceAddress addressC, VkDeviceAddress addressD) {
+    GemmPushConstants pushConstants{};
+    pushConstants.addressA = addressA;
+    pushConstants.addressB = addressB;
+    pushConstants.addressC = addressC;
+    pushConstants.addressD = addressD;
+    pushConstants.M = settings.M;
+    pushConstants.N = settings.N;
+    pushConstants.K = settings.K;
+    uint32_t numSubgroupTiles =
+            (settings.M / (settings.lM * settings.tileM)) * (settings.N / (settings.lN * settings.tileN));
+    uint32_t numWorkgroups =
+            (numSubgroupTiles + settings.subgroupsPerWorkgroup - 1) / settings.subgroupsPerWorkgroup;
+    if (settings.scope == VK_SCOPE_WORKGROUP_KHR) {
+        numWorkgroups = numSubgroupTiles;
+    }
+    pipeline.bind(commandBuffer);
+    pipeline.pushConstants(commandBuffer, &pushConstants, sizeof(GemmPushConstants));
+    vkCmdDispatch(commandBuffer, numWorkgroups, 1, 1);
+}
+
+double CoopMatGemm::measureTeraOpsPerSecond(uint32_t numIterations) {
+    double timeMs = measureCommandsMs(context, [this](VkCommandBuffer commandBuffer) {
+        recordDispatch(commandBuffer);
+    }, numIterations);
+    return getNumOperations() / (timeMs * 1e9);
+}
+
+void CoopMatGemm::setInputs(std::vector<uint8_t> A, std::vector<uint8_t> B, std::vector<uint8_t> C) {
+    if (A.size() != dataA.size() || B.size() != dataB.size() || C.size() != dataC.size()) {
+        throw std::runtime_error("CoopMatGemm::setInputs: Mismatching input sizes.");
+    }
+    dataA = std::move(A);
+    dataB = std::move(B);
+    dataC = std::move(C);
+    uploadBufferData(device, context, bufferA, dataA.data(), dataA.size());
+    uploadBufferData(device, context, bufferB, dataB.data(), dataB.size());
+    uploadBufferData(device, context, bufferC, dataC.data(), dataC.size());
+}
+
+std::vector<uint8_t> CoopMatGemm::downloadResult() {
+    std::vector<uint8_t> dataD(bufferD.size);
+    downloadBufferData(device, context, bufferD, dataD.data(), dataD.size());
+    return dataD;
+}
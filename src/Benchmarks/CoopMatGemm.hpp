@@ -0,0 +1,117 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef QUERYVKCOOPMAT_COOPMATGEMM_HPP
+#define QUERYVKCOOPMAT_COOPMATGEMM_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <Graphics/Vulkan/Utils/Device.hpp>
+
+#include "VulkanUtils.hpp"
+
+struct CoopMatGemmSettings {
+    // Cooperative matrix type and shape.
+    VkComponentTypeKHR AType = VK_COMPONENT_TYPE_FLOAT16_KHR;
+    VkComponentTypeKHR BType = VK_COMPONENT_TYPE_FLOAT16_KHR;
+    VkComponentTypeKHR CType = VK_COMPONENT_TYPE_FLOAT32_KHR;
+    VkComponentTypeKHR ResultType = VK_COMPONENT_TYPE_FLOAT32_KHR;
+    uint32_t lM = 16, lN = 16, lK = 16;
+    bool saturatingAccumulation = false;
+    /// VK_SCOPE_WORKGROUP_KHR uses VK_NV_cooperative_matrix2; each workgroup then computes a single tile.
+    VkScopeKHR scope = VK_SCOPE_SUBGROUP_KHR;
+    uint32_t workgroupInvocations = 0; ///< Workgroup size for VK_SCOPE_WORKGROUP_KHR.
+
+    // Kernel configuration.
+    uint32_t tileM = 2, tileN = 2; ///< Number of accumulator matrices per subgroup.
+    uint32_t subgroupsPerWorkgroup = 4;
+    /// 0 uses VkPhysicalDeviceSubgroupProperties::subgroupSize. Subgroup scope kernels always pin the size.
+    uint32_t requiredSubgroupSize = 0;
+
+    // Problem size; divided by the problem size divisor of the benchmark runner and rounded up to multiples of the
+    // tile sizes.
+    uint32_t M = 4096, N = 4096, K = 4096;
+
+    static CoopMatGemmSettings fromProperties(const VkCooperativeMatrixPropertiesKHR& props);
+    /// Uses the granularities as matrix sizes.
+    static CoopMatGemmSettings fromProperties(const VkCooperativeMatrixFlexibleDimensionsPropertiesNV& props);
+};
+
+/**
+ * GEMM D = A * B + C using the CoopMatGemm kernel with VK_KHR_cooperative_matrix. The matrices are filled with random
+ * values that are exactly representable in the respective types.
+ */
+class CoopMatGemm {
+public:
+    /// Throws std::runtime_error if the kernel variant is unavailable or the pipeline cannot be created.
+    CoopMatGemm(sgl::vk::Device* device, CommandContext& context, const CoopMatGemmSettings& settings);
+    ~CoopMatGemm();
+
+    /// <A>_<B>_<C>_<Result>[_sat][_wg]; matches the variants generated in CMake/Kernels.cmake.
+    static std::string getVariantName(const CoopMatGemmSettings& settings);
+    /// Returns an empty string if the variant can be run on the device, and the reason otherwise.
+    static std::string checkSupport(sgl::vk::Device* device, const CoopMatGemmSettings& settings);
+    /// Settings for creating the pipeline of the kernel variant; throws std::runtime_error if it is unavailable.
+    static ComputePipelineSettings getPipelineSettings(sgl::vk::Device* device, const CoopMatGemmSettings& settings);
+
+    [[nodiscard]] inline const CoopMatGemmSettings& getSettings() const { return settings; }
+    [[nodiscard]] double getNumOperations() const; ///< 2 * M * N * K.
+
+    void recordDispatch(VkCommandBuffer commandBuffer) const;
+    /**
+     * Records a dispatch of a pipeline created with getPipelineSettings for buffers not owned by a CoopMatGemm object
+     * (e.g., on a device group). The problem size is used as is, i.e., it needs to be a multiple of the tile sizes.
+     */
+    static void recordDispatch(
+            VkCommandBuffer commandBuffer, const ComputePipeline& pipeline, const CoopMatGemmSettings& settings,
+            VkDeviceAddress addressA, VkDeviceAddress addressB, VkDeviceAddress addressC, VkDeviceAddress addressD);
+    /// Returns the throughput in tera operations per second.
+    double measureTeraOpsPerSecond(uint32_t numIterations = 10);
+
+    /// Replaces the random inputs by arrays of the respective component types with M * K, K * N and M * N elements.
+    void setInputs(std::vector<uint8_t> A, std::vector<uint8_t> B, std::vector<uint8_t> C);
+
+    // Host copies of the inputs and the downloaded result (for accuracy checks).
+    [[nodiscard]] inline const std::vector<uint8_t>& getDataA() const { return dataA; }
+    [[nodiscard]] inline const std::vector<uint8_t>& getDataB() const { return dataB; }
+    [[nodiscard]] inline const std::vector<uint8_t>& getDataC() const { return dataC; }
+    std::vector<uint8_t> downloadResult();
+
+private:
+    sgl::vk::Device* device;
+    CommandContext& context;
+    CoopMatGemmSettings settings;
+    std::unique_ptr<ComputePipeline> pipeline;
+    DeviceBuffer bufferA, bufferB, bufferC, bufferD;
+    std::vector<uint8_t> dataA, dataB, dataC;
+};
+
+#endif //QUERYVKCOOPMAT_COOPMATGEMM_HPP
@@ -0,0 +1,372 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <Utils/File/Logfile.hpp>
+#include <Graphics/Vulkan/libs/volk/volk.h>
+#include <Graphics/Vulkan/Utils/Device.hpp>
+
+#include "PrintUtils.hpp"
+#include "ComponentTypes.hpp"
+#include "NumberFormats.hpp"
+#include "VulkanUtils.hpp"
+#include "CoopVecUtils.hpp"
+#include "Kernels.hpp"
+#include "CoopVecLayoutBenchmark.hpp"
+
+// Need to match the defines in CoopVecInference.comp.
+static const uint32_t LAYER_WIDTH = 64;
+static const uint32_t NUM_LAYERS = 4;
+static const uint32_t WORKGROUP_SIZE = 64;
+static const uint32_t INFERENCE_BATCH_SIZE = 1u << 20;
+static const uint32_t CONVERSION_MATRIX_SIZES[] = { 64, 256, 1024, 4096 };
+/// Number of matrix elements converted per host measurement (repeating small matrices).
+static const size_t HOST_CONVERSION_ELEMENTS = size_t(1) << 26;
+
+struct CoopVecInferencePushConstants {
+    VkDeviceAddress weights, biases, inputs, outputs;
+    uint32_t batchSize;
+    uint32_t weightLayerStride, matrixStride;
+};
+
+static size_t roundUpToMultiple(size_t value, size_t multiple) {
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+static uint32_t getInferenceBatchSize() {
+    return getReducedProblemSize(INFERENCE_BATCH_SIZE, WORKGROUP_SIZE);
+}
+
+/// Returns the conversion throughput in GiB/s of source data.
+static double measureHostConversion(
+        VkDevice vkDevice, const std::vector<uint8_t>& srcData, uint32_t size,
+        VkCooperativeVectorMatrixLayoutNV srcLayout, VkCooperativeVectorMatrixLayoutNV dstLayout) {
+    const VkComponentTypeKHR f16 = VK_COMPONENT_TYPE_FLOAT16_KHR;
+    size_t dstSize = getCoopVecMatrixSize(vkDevice, size, size, f16, dstLayout);
+    std::vector<uint8_t> dstData(dstSize);
+    VkConvertCooperativeVectorMatrixInfoNV info = getCoopVecConversionInfo(
+            size, size, f16, srcLayout, f16, dstLayout, &dstSize);
+    info.srcData.hostAddress = srcData.data();
+    info.dstData.hostAddress = dstData.data();
+    const size_t numElements = getReducedProblemSize(uint32_t(HOST_CONVERSION_ELEMENTS));
+    size_t numRepetitions = std::max(numElements / (size_t(size) * size_t(size)), size_t(1));
+    double elapsedMs = runBenchmark([&]() {
+        auto startTime = std::chrono::high_resolution_clock::now();
+        for (size_t i = 0; i < numRepetitions; i++) {
+            throwIfVkError(
+                    vkConvertCooperativeVectorMatrixNV(vkDevice, &info), "vkConvertCooperativeVectorMatrixNV");
+        }
+        auto endTime = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::milli>(endTime - startTime).count();
+    }).median;
+    return computeGiBPerSecond(double(info.srcSize) * double(numRepetitions), elapsedMs);
+}
+
+/**
+ * Converts numMatrices size x size matrices stored consecutively in srcBuffer (with the passed source stride) into
+ * dstBuffer (with the passed destination stride) in one command, and returns the time in milliseconds.
+ */
+static double measureDeviceConversionMs(
+        CommandContext& context, const DeviceBuffer& srcBuffer, size_t srcMatrixStride,
+        const DeviceBuffer& dstBuffer, size_t dstMatrixStride, uint32_t numMatrices, uint32_t size,
+        VkCooperativeVectorMatrixLayoutNV srcLayout, VkCooperativeVectorMatrixLayoutNV dstLayout) {
+    const VkComponentTypeKHR f16 = VK_COMPONENT_TYPE_FLOAT16_KHR;
+    std::vector<size_t> dstSizes(numMatrices, dstMatrixStride);
+    std::vector<VkConvertCooperativeVectorMatrixInfoNV> infos(numMatrices);
+    for (uint32_t i = 0; i < numMatrices; i++) {
+        infos[i] = getCoopVecConversionInfo(size, size, f16, srcLayout, f16, dstLayout, &dstSizes[i]);
+        infos[i].srcData.deviceAddress = srcBuffer.deviceAddress + i * srcMatrixStride;
+        infos[i].dstData.deviceAddress = dstBuffer.deviceAddress + i * dstMatrixStride;
+    }
+    return measureCommandsMs(context, [&](VkCommandBuffer commandBuffer) {
+        vkCmdConvertCooperativeVectorMatrixNV(commandBuffer, numMatrices, infos.data());
+    });
+}
+
+static void printConversionThroughput(sgl::vk::Device* device, CommandContext& context) {
+    VkDevice vkDevice = device->getVkDevice();
+    const VkComponentTypeKHR f16 = VK_COMPONENT_TYPE_FLOAT16_KHR;
+    const VkCooperativeVectorMatrixLayoutNV srcLayouts[] = {
+            VK_COOPERATIVE_VECTOR_MATRIX_LAYOUT_ROW_MAJOR_NV, VK_COOPERATIVE_VECTOR_MATRIX_LAYOUT_COLUMN_MAJOR_NV };
+    const VkCooperativeVectorMatrixLayoutNV dstLayouts[] = {
+            VK_COOPERATIVE_VECTOR_MATRIX_LAYOUT_INFERENCING_OPTIMAL_NV,
+            VK_COOPERATIVE_VECTOR_MATRIX_LAYOUT_TRAINING_OPTIMAL_NV };
+    const uint32_t maxSize = CONVERSION_MATRIX_SIZES[std::size(CONVERSION_MATRIX_SIZES) - 1];
+
+    writeOut("Weight layout conversion throughput (float16, GiB/s of source data; the device conversion converts ",
+             "the same amount of data as one largest matrix per command):");
+    ResultTable table({ "Matrix size", "Source layout", "Destination layout", "Destination size", "Host GiB/s",
+                        "Device GiB/s" });
+    const VkBufferUsageFlags usage =
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT
+            | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    std::vector<uint8_t> srcData = createRandomElements(f16, size_t(maxSize) * size_t(maxSize), 1);
+    DeviceBuffer srcBuffer, dstBuffer;
+    try {
+        size_t maxDstSize = 0;
+        for (auto dstLayout : dstLayouts) {
+            for (uint32_t size : CONVERSION_MATRIX_SIZES) {
+                size_t numMatrices = (size_t(maxSize) * size_t(maxSize)) / (size_t(size) * size_t(size));
+                size_t dstStride = roundUpToMultiple(
+                        getCoopVecMatrixSize(vkDevice, size, size, f16, dstLayout), COOPVEC_MATRIX_ALIGNMENT);
+                maxDstSize = std::max(maxDstSize, numMatrices * dstStride);
+            }
+        }
+        srcBuffer = createDeviceBuffer(device, srcData.size(), usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        dstBuffer = createDeviceBuffer(device, maxDstSize, usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        uploadBufferData(device, context, srcBuffer, srcData.data(), srcData.size());
+
+        for (uint32_t size : CONVERSION_MATRIX_SIZES) {
+            for (auto srcLayout : srcLayouts) {
+                for (auto dstLayout : dstLayouts) {
+                    std::vector<std::string> row = {
+                            std::to_string(size) + "x" + std::to_string(size),
+                            getCoopVecMatrixLayoutString(srcLayout), getCoopVecMatrixLayoutString(dstLayout) };
+                    try {
+                        size_t dstSize = getCoopVecMatrixSize(vkDevice, size, size, f16, dstLayout);
+                        row.push_back(sgl::getNiceMemoryString(dstSize, 2));
+                        row.push_back(formatNumber(measureHostConversion(
+                                vkDevice, srcData, size, srcLayout, dstLayout)));
+                        size_t srcMatrixSize = size_t(size) * size_t(size) * getComponentTypeSize(f16);
+                        auto numMatrices = uint32_t(srcData.size() / srcMatrixSize);
+                        double timeMs = measureDeviceConversionMs(
+                                context, srcBuffer, srcMatrixSize, dstBuffer,
+                                roundUpToMultiple(dstSize, COOPVEC_MATRIX_ALIGNMENT), numMatrices, size,
+                                srcLayout, dstLayout);
+                        row.push_back(formatNumber(computeGiBPerSecond(double(srcData.size()), timeMs)));
+                    } catch (const std::exception& e) {
+                        sgl::Logfile::get()->writeError(
+                                std::string() + "Error in runCoopVecLayoutBenchmark: " + e.what(), false);
+                        row.resize(6, "failed");
+                    }
+                    table.addRow(row);
+                }
+            }
+        }
+    } catch (const std::exception& e) {
+        sgl::Logfile::get()->writeError(std::string() + "Error in runCoopVecLayoutBenchmark: " + e.what(), false);
+    }
+    destroyDeviceBuffer(vkDevice, srcBuffer);
+    destroyDeviceBuffer(vkDevice, dstBuffer);
+    table.print();
+}
+
+class CoopVecInference {
+public:
+    CoopVecInference(sgl::vk::Device* device, CommandContext& context);
+    ~CoopVecInference();
+    /**
+     * Converts the row-major weights into the passed layout with vkCmdConvertCooperativeVectorMatrixNV and returns
+     * the time of the conversion in milliseconds.
+     */
+    double convertWeights(VkCooperativeVectorMatrixLayoutNV layout);
+    /// Returns the time of the inference of one batch in milliseconds with the last converted weights.
+    double measureInferenceMs(const std::string& variantName);
+
+private:
+    void destroyBuffers();
+
+    sgl::vk::Device* device;
+    CommandContext& context;
+    size_t rowMajorLayerStride = 0, maxLayerStride = 0, weightLayerStride = 0, matrixStride = 0;
+    DeviceBuffer rowMajorWeights, weights, biases, inputs, outputs;
+};
+
+CoopVecInference::CoopVecInference(sgl::vk::Device* device, CommandContext& context)
+        : device(device), context(context) {
+    VkDevice vkDevice = device->getVkDevice();
+    const VkComponentTypeKHR f16 = VK_COMPONENT_TYPE_FLOAT16_KHR;
+    rowMajorLayerStride = roundUpToMultiple(
+            size_t(LAYER_WIDTH) * LAYER_WIDTH * getComponentTypeSize(f16), COOPVEC_MATRIX_ALIGNMENT);
+    maxLayerStride = rowMajorLayerStride;
+    for (auto layout : { VK_COOPERATIVE_VECTOR_MATRIX_LAYOUT_INFERENCING_OPTIMAL_NV,
+                         VK_COOPERATIVE_VECTOR_MATRIX_LAYOUT_TRAINING_OPTIMAL_NV }) {
+        maxLayerStride = std::max(maxLayerStride, roundUpToMultiple(
+                getCoopVecMatrixSize(vkDevice, LAYER_WIDTH, LAYER_WIDTH, f16, layout), COOPVEC_MATRIX_ALIGNMENT));
+    }
+
+    // Weights scaled by 1/8, such that the activations stay in a reasonable range over the layers.
+    std::vector<uint8_t> weightData(NUM_LAYERS * rowMajorLayerStride);
+    for (uint32_t l = 0; l < NUM_LAYERS; l++) {
+        std::vector<uint8_t> layerData = createRandomElements(f16, LAYER_WIDTH * LAYER_WIDTH, 10 + l);
+        for (size_t i = 0; i < LAYER_WIDTH * LAYER_WIDTH; i++) {
+            writeElement(weightData.data() + l * rowMajorLayerStride, f16, i,
+                         readElement(layerData.data(), f16, i) / 8.0);
+        }
+    }
+    std::vector<uint8_t> biasData(NUM_LAYERS * LAYER_WIDTH * sizeof(uint16_t));
+    for (size_t i = 0; i < NUM_LAYERS * LAYER_WIDTH; i++) {
+        writeElement(biasData.data(), f16, i, 0.01);
+    }
+    std::vector<uint8_t> inputData = createRandomElements(f16, size_t(getInferenceBatchSize()) * LAYER_WIDTH, 1);
+
+    const VkBufferUsageFlags usage =
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT
+            | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    const VkMemoryPropertyFlags memoryProperties = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+    try {
+        rowMajorWeights = createDeviceBuffer(device, weightData.size(), usage, memoryProperties);
+        weights = createDeviceBuffer(device, NUM_LAYERS * maxLayerStride, usage, memoryProperties);
+        biases = createDeviceBuffer(device, biasData.size(), usage, memoryProperties);
+        inputs = createDeviceBuffer(device, inputData.size(), usage, memoryProperties);
+        outputs = createDeviceBuffer(device, inputData.size(), usage, memoryProperties);
+        uploadBufferData(device, context, rowMajorWeights, weightData.data(), weightData.size());
+        uploadBufferData(device, context, biases, biasData.data(), biasData.size());
+        uploadBufferData(device, context, inputs, inputData.data(), inputData.size());
+    } catch (...) {
+        destroyBuffers();
+        throw;
+    }
+}
+
+CoopVecInference::~CoopVecInference() {
+    destroyBuffers();
+}
+
+void CoopVecInference::destroyBuffers() {
+    VkDevice vkDevice = device->getVkDevice();
+    for (DeviceBuffer* buffer : { &rowMajorWeights, &weights, &biases, &inputs, &outputs }) {
+        destroyDeviceBuffer(vkDevice, *buffer);
+    }
+}
+
+double CoopVecInference::convertWeights(VkCooperativeVectorMatrixLayoutNV layout) {
+    const VkComponentTypeKHR f16 = VK_COMPONENT_TYPE_FLOAT16_KHR;
+    weightLayerStride = roundUpToMultiple(
+            getCoopVecMatrixSize(device->getVkDevice(), LAYER_WIDTH, LAYER_WIDTH, f16, layout),
+            COOPVEC_MATRIX_ALIGNMENT);
+    matrixStride = getCoopVecMatrixStride(layout, LAYER_WIDTH, LAYER_WIDTH, f16);
+    return measureDeviceConversionMs(
+            context, rowMajorWeights, rowMajorLayerStride, weights, weightLayerStride, NUM_LAYERS, LAYER_WIDTH,
+            VK_COOPERATIVE_VECTOR_MATRIX_LAYOUT_ROW_MAJOR_NV, layout);
+}
+
+double CoopVecInference::measureInferenceMs(const std::string& variantName) {
+    const EmbeddedKernel* kernel = findEmbeddedKernel("CoopVecInference", variantName);
+    if (!kernel) {
+        throw std::runtime_error("Kernel variant CoopVecInference/" + variantName + " is not available.");
+    }
+    ComputePipelineSettings pipelineSettings{};
+    pipelineSettings.code = kernel->code;
+    pipelineSettings.codeSize = kernel->codeSize;
+    pipelineSettings.specializationConstants = { WORKGROUP_SIZE };
+    pipelineSettings.pushConstantSize = sizeof(CoopVecInferencePushConstants);
+    ComputePipeline pipeline(device->getVkDevice(), pipelineSettings);
+
+    CoopVecInferencePushConstants pushConstants{};
+    pushConstants.weights = weights.deviceAddress;
+    pushConstants.biases = biases.deviceAddress;
+    pushConstants.inputs = inputs.deviceAddress;
+    pushConstants.outputs = outputs.deviceAddress;
+    pushConstants.batchSize = getInferenceBatchSize();
+    pushConstants.weightLayerStride = uint32_t(weightLayerStride);
+    pushConstants.matrixStride = uint32_t(matrixStride);
+    return measureCommandsMs(context, [&](VkCommandBuffer commandBuffer) {
+        pipeline.bind(commandBuffer);
+        pipeline.pushConstants(commandBuffer, &pushConstants, sizeof(CoopVecInferencePushConstants));
+        vkCmdDispatch(commandBuffer, (getInferenceBatchSize() + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE, 1, 1);
+    });
+}
+
+static void printInferencePayoff(sgl::vk::Device* device, CommandContext& context) {
+    writeOut("Inference (", NUM_LAYERS, " layers of ", LAYER_WIDTH, "x", LAYER_WIDTH, " float16 weights, batch size ",
+             getInferenceBatchSize(), ") per weight layout; the weights are converted from row-major on the device:");
+    struct InferenceLayout {
+        VkCooperativeVectorMatrixLayoutNV layout;
+        const char* variantName;
+    };
+    const InferenceLayout layouts[] = {
+            { VK_COOPERATIVE_VECTOR_MATRIX_LAYOUT_ROW_MAJOR_NV, "row_major" },
+            { VK_COOPERATIVE_VECTOR_MATRIX_LAYOUT_COLUMN_MAJOR_NV, "column_major" },
+            { VK_COOPERATIVE_VECTOR_MATRIX_LAYOUT_INFERENCING_OPTIMAL_NV, "inferencing_optimal" },
+    };
+    ResultTable table({ "Layout", "Samples/s", "Speedup vs. row-major", "Conversion time (us)",
+                        "Break-even (batches)" });
+    try {
+        CoopVecInference inference(device, context);
+        double rowMajorMs = -1.0;
+        for (const auto& layout : layouts) {
+            std::vector<std::string> row = { getCoopVecMatrixLayoutString(layout.layout) };
+            try {
+                double conversionMs = inference.convertWeights(layout.layout);
+                double inferenceMs = inference.measureInferenceMs(layout.variantName);
+                if (layout.layout == VK_COOPERATIVE_VECTOR_MATRIX_LAYOUT_ROW_MAJOR_NV) {
+                    rowMajorMs = inferenceMs;
+                }
+                row.push_back(formatScientific(double(getInferenceBatchSize()) * 1e3 / inferenceMs));
+                row.push_back(rowMajorMs > 0.0 ? formatNumber(rowMajorMs / inferenceMs) + "x" : "-");
+                row.push_back(formatNumber(conversionMs * 1e3));
+                // Number of batches after which converting the weights at load time pays off.
+                double savedMs = rowMajorMs - inferenceMs;
+                row.push_back(rowMajorMs > 0.0 && savedMs > 0.0 ? formatNumber(conversionMs / savedMs) : "-");
+            } catch (const std::exception& e) {
+                sgl::Logfile::get()->writeError(
+                        std::string() + "Error in runCoopVecLayoutBenchmark (" + layout.variantName + "): "
+                        + e.what(), false);
+                row.resize(5, "failed");
+            }
+            table.addRow(row);
+        }
+    } catch (const std::exception& e) {
+        sgl::Logfile::get()->writeError(std::string() + "Error in runCoopVecLayoutBenchmark: " + e.what(), false);
+    }
+    table.print();
+}
+
+void runCoopVecLayoutBenchmark(sgl::vk::Device* device) {
+    writeOut("");
+    writeOut("Cooperative vector matrix layout conversion benchmark:");
+    if (!device->isDeviceExtensionSupported(VK_NV_COOPERATIVE_VECTOR_EXTENSION_NAME)) {
+        writeOut("VK_NV_cooperative_vector is not supported.");
+        return;
+    }
+    const auto& features = device->getCooperativeVectorFeaturesNV();
+    const auto& properties = device->getCooperativeVectorPropertiesNV();
+    if (!features.cooperativeVector) {
+        writeOut("cooperativeVector is not supported.");
+        return;
+    }
+    try {
+        CommandContext context(device);
+        printConversionThroughput(device, context);
+        if ((properties.cooperativeVectorSupportedStages & VK_SHADER_STAGE_COMPUTE_BIT) != 0
+                && getIsComponentTypeUsable(device, VK_COMPONENT_TYPE_FLOAT16_KHR)) {
+            printInferencePayoff(device, context);
+        } else {
+            writeOut("Cooperative vectors with float16 are not supported in compute shaders.");
+        }
+    } catch (const std::exception& e) {
+        sgl::Logfile::get()->writeError(std::string() + "Error in runCoopVecLayoutBenchmark: " + e.what(), false);
+    }
+}
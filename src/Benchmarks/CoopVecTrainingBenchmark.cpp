@@ -0,0 +1,273 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <Utils/File/Logfile.hpp>
+#include <Graphics/Vulkan/libs/volk/volk.h>
+#include <Graphics/Vulkan/Utils/Device.hpp>
+
+#include "PrintUtils.hpp"
+#include "ComponentTypes.hpp"
+#include "NumberFormats.hpp"
+#include "VulkanUtils.hpp"
+#include "CoopVecUtils.hpp"
+#include "Kernels.hpp"
+#include "CoopVecTrainingBenchmark.hpp"
+
+// Need to match the defines in CoopVecTraining.comp.
+static const uint32_t LAYER_WIDTH = 64;
+static const uint32_t NUM_LAYERS = 3;
+static const uint32_t WORKGROUP_SIZE = 64;
+static const uint32_t BATCH_SIZES[] = { 256, 1024, 4096, 16384, 65536, 262144 };
+static const uint32_t MAX_BATCH_SIZE = 262144;
+
+struct CoopVecTrainingPushConstants {
+    VkDeviceAddress weights, biases, inputs, targets;
+    VkDeviceAddress weightGradients, biasGradients;
+    VkDeviceAddress outputs;
+    uint32_t batchSize;
+    uint32_t weightLayerStride, gradientLayerStride;
+};
+
+static size_t roundUpToMultiple(size_t value, size_t multiple) {
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+class CoopVecTraining {
+public:
+    CoopVecTraining(sgl::vk::Device* device, CommandContext& context);
+    ~CoopVecTraining();
+    /// Returns the time of one training step (gradient clear, forward and backward pass) in milliseconds.
+    double measureStepMs(const std::string& variantName, uint32_t batchSize);
+
+private:
+    void destroyBuffers();
+
+    sgl::vk::Device* device;
+    CommandContext& context;
+    size_t weightLayerStride = 0, gradientLayerStride = 0;
+    DeviceBuffer weights, biases, inputs, targets, weightGradients, biasGradients, outputs;
+};
+
+CoopVecTraining::CoopVecTraining(sgl::vk::Device* device, CommandContext& context)
+        : device(device), context(context) {
+    VkDevice vkDevice = device->getVkDevice();
+    const VkComponentTypeKHR f16 = VK_COMPONENT_TYPE_FLOAT16_KHR;
+    const VkComponentTypeKHR f32 = VK_COMPONENT_TYPE_FLOAT32_KHR;
+    const VkCooperativeVectorMatrixLayoutNV trainingOptimal = VK_COOPERATIVE_VECTOR_MATRIX_LAYOUT_TRAINING_OPTIMAL_NV;
+    weightLayerStride = roundUpToMultiple(
+            getCoopVecMatrixSize(vkDevice, LAYER_WIDTH, LAYER_WIDTH, f16, trainingOptimal), COOPVEC_MATRIX_ALIGNMENT);
+    // Large enough for both accumulation types.
+    gradientLayerStride = roundUpToMultiple(
+            getCoopVecMatrixSize(vkDevice, LAYER_WIDTH, LAYER_WIDTH, f32, trainingOptimal), COOPVEC_MATRIX_ALIGNMENT);
+
+    // Weights scaled by 1/8, such that the activations stay in a reasonable range over the layers.
+    std::vector<uint8_t> weightData(NUM_LAYERS * weightLayerStride);
+    for (uint32_t l = 0; l < NUM_LAYERS; l++) {
+        std::vector<uint8_t> layerData = createRandomElements(f16, LAYER_WIDTH * LAYER_WIDTH, 10 + l);
+        for (size_t i = 0; i < LAYER_WIDTH * LAYER_WIDTH; i++) {
+            writeElement(layerData.data(), f16, i, readElement(layerData.data(), f16, i) / 8.0);
+        }
+        std::vector<uint8_t> convertedData = convertCoopVecMatrixOnHost(
+                vkDevice, layerData.data(), LAYER_WIDTH, LAYER_WIDTH,
+                f16, VK_COOPERATIVE_VECTOR_MATRIX_LAYOUT_ROW_MAJOR_NV, f16, trainingOptimal);
+        std::copy(convertedData.begin(), convertedData.end(), weightData.begin() + ptrdiff_t(l * weightLayerStride));
+    }
+    std::vector<uint8_t> biasData(NUM_LAYERS * LAYER_WIDTH * sizeof(uint16_t));
+    for (size_t i = 0; i < NUM_LAYERS * LAYER_WIDTH; i++) {
+        writeElement(biasData.data(), f16, i, 0.01);
+    }
+    std::vector<uint8_t> inputData = createRandomElements(f16, size_t(MAX_BATCH_SIZE) * LAYER_WIDTH, 1);
+    std::vector<uint8_t> targetData = createRandomElements(f16, size_t(MAX_BATCH_SIZE) * LAYER_WIDTH, 2);
+
+    const VkBufferUsageFlags usage =
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT
+            | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    const VkMemoryPropertyFlags memoryProperties = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+    try {
+        weights = createDeviceBuffer(device, weightData.size(), usage, memoryProperties);
+        biases = createDeviceBuffer(device, biasData.size(), usage, memoryProperties);
+        inputs = createDeviceBuffer(device, inputData.size(), usage, memoryProperties);
+        targets = createDeviceBuffer(device, targetData.size(), usage, memoryProperties);
+        weightGradients = createDeviceBuffer(device, NUM_LAYERS * gradientLayerStride, usage, memoryProperties);
+        biasGradients = createDeviceBuffer(device, NUM_LAYERS * LAYER_WIDTH * sizeof(float), usage, memoryProperties);
+        outputs = createDeviceBuffer(
+                device, size_t(MAX_BATCH_SIZE) * LAYER_WIDTH * sizeof(float), usage, memoryProperties);
+        uploadBufferData(device, context, weights, weightData.data(), weightData.size());
+        uploadBufferData(device, context, biases, biasData.data(), biasData.size());
+        uploadBufferData(device, context, inputs, inputData.data(), inputData.size());
+        uploadBufferData(device, context, targets, targetData.data(), targetData.size());
+    } catch (...) {
+        destroyBuffers();
+        throw;
+    }
+}
+
+CoopVecTraining::~CoopVecTraining() {
+    destroyBuffers();
+}
+
+void CoopVecTraining::destroyBuffers() {
+    VkDevice vkDevice = device->getVkDevice();
+    for (DeviceBuffer* buffer : { &weights, &biases, &inputs, &targets, &weightGradients, &biasGradients, &outputs }) {
+        destroyDeviceBuffer(vkDevice, *buffer);
+    }
+}
+
+double CoopVecTraining::measureStepMs(const std::string& variantName, uint32_t batchSize) {
+    const EmbeddedKernel* kernel = findEmbeddedKernel("CoopVecTraining", variantName);
+    if (!kernel) {
+        throw std::runtime_error("Kernel variant CoopVecTraining/" + variantName + " is not available.");
+    }
+    ComputePipelineSettings pipelineSettings{};
+    pipelineSettings.code = kernel->code;
+    pipelineSettings.codeSize = kernel->codeSize;
+    pipelineSettings.specializationConstants = { WORKGROUP_SIZE };
+    pipelineSettings.pushConstantSize = sizeof(CoopVecTrainingPushConstants);
+    ComputePipeline pipeline(device->getVkDevice(), pipelineSettings);
+
+    CoopVecTrainingPushConstants pushConstants{};
+    pushConstants.weights = weights.deviceAddress;
+    pushConstants.biases = biases.deviceAddress;
+    pushConstants.inputs = inputs.deviceAddress;
+    pushConstants.targets = targets.deviceAddress;
+    pushConstants.weightGradients = weightGradients.deviceAddress;
+    pushConstants.biasGradients = biasGradients.deviceAddress;
+    pushConstants.outputs = outputs.deviceAddress;
+    pushConstants.batchSize = batchSize;
+    pushConstants.weightLayerStride = uint32_t(weightLayerStride);
+    pushConstants.gradientLayerStride = uint32_t(gradientLayerStride);
+    return measureCommandsMs(context, [&](VkCommandBuffer commandBuffer) {
+        vkCmdFillBuffer(commandBuffer, weightGradients.buffer, 0, VK_WHOLE_SIZE, 0);
+        vkCmdFillBuffer(commandBuffer, biasGradients.buffer, 0, VK_WHOLE_SIZE, 0);
+        insertMemoryBarrier(commandBuffer);
+        pipeline.bind(commandBuffer);
+        pipeline.pushConstants(commandBuffer, &pushConstants, sizeof(CoopVecTrainingPushConstants));
+        vkCmdDispatch(commandBuffer, (batchSize + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE, 1, 1);
+    });
+}
+
+/// Checks for a float16 entry (input, matrix, bias and result) that supports transposed matrices.
+static bool getSupportsFloat16Training(sgl::vk::Device* device) {
+    for (const auto& props : device->getSupportedCooperativeVectorPropertiesNV()) {
+        if (props.inputType == VK_COMPONENT_TYPE_FLOAT16_KHR
+                && props.inputInterpretation == VK_COMPONENT_TYPE_FLOAT16_KHR
+                && props.matrixInterpretation == VK_COMPONENT_TYPE_FLOAT16_KHR
+                && props.biasInterpretation == VK_COMPONENT_TYPE_FLOAT16_KHR
+                && props.resultType == VK_COMPONENT_TYPE_FLOAT16_KHR && props.transpose) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void runCoopVecTrainingBenchmark(sgl::vk::Device* device) {
+    writeOut("");
+    writeOut("Cooperative vector training benchmark (", NUM_LAYERS, " layers of ", LAYER_WIDTH, "x", LAYER_WIDTH,
+             " float16 weights):");
+    if (!device->isDeviceExtensionSupported(VK_NV_COOPERATIVE_VECTOR_EXTENSION_NAME)) {
+        writeOut("VK_NV_cooperative_vector is not supported.");
+        return;
+    }
+    const auto& features = device->getCooperativeVectorFeaturesNV();
+    const auto& properties = device->getCooperativeVectorPropertiesNV();
+    if (!features.cooperativeVector || !features.cooperativeVectorTraining
+            || (properties.cooperativeVectorSupportedStages & VK_SHADER_STAGE_COMPUTE_BIT) == 0) {
+        writeOut("cooperativeVectorTraining is not supported in compute shaders.");
+        return;
+    }
+    if (!getIsComponentTypeUsable(device, VK_COMPONENT_TYPE_FLOAT16_KHR) || !getSupportsFloat16Training(device)) {
+        writeOut("No float16 cooperative vector configuration with transposed matrices is supported.");
+        return;
+    }
+
+    struct AccumulationVariant {
+        const char* name;
+        const char* variantName;
+        bool isSupported;
+    };
+    const AccumulationVariant accumulationVariants[] = {
+            { "fp16", "f16_accumulation", bool(properties.cooperativeVectorTrainingFloat16Accumulation) },
+            { "fp32", "f32_accumulation", bool(properties.cooperativeVectorTrainingFloat32Accumulation) },
+    };
+    writeOut("Accumulation overhead: Time per sample of the gradient accumulation compared to summing the gradients "
+             "per sample without accumulation. Growth with the batch size indicates contention.");
+    std::vector<std::string> columnNames = { "Batch size", "No accumulation (steps/s)" };
+    for (const auto& accumulationVariant : accumulationVariants) {
+        columnNames.push_back(std::string() + accumulationVariant.name + " steps/s");
+        columnNames.push_back(std::string() + accumulationVariant.name + " samples/s");
+        columnNames.push_back(std::string() + accumulationVariant.name + " overhead (ns/sample)");
+    }
+    ResultTable table(columnNames);
+
+    try {
+        CommandContext context(device);
+        CoopVecTraining training(device, context);
+        for (uint32_t batchSize : BATCH_SIZES) {
+            if (batchSize > getReducedProblemSize(MAX_BATCH_SIZE)) {
+                continue;
+            }
+            std::vector<std::string> row = { std::to_string(batchSize) };
+            double baselineMs = -1.0;
+            try {
+                baselineMs = training.measureStepMs("no_accumulation", batchSize);
+                row.push_back(formatNumber(1e3 / baselineMs, 1));
+            } catch (const std::exception& e) {
+                sgl::Logfile::get()->writeError(
+                        std::string() + "Error in runCoopVecTrainingBenchmark (no_accumulation): " + e.what(), false);
+                row.emplace_back("failed");
+            }
+            for (const auto& accumulationVariant : accumulationVariants) {
+                if (!accumulationVariant.isSupported) {
+                    row.insert(row.end(), 3, "n/a");
+                    continue;
+                }
+                try {
+                    double stepMs = training.measureStepMs(accumulationVariant.variantName, batchSize);
+                    row.push_back(formatNumber(1e3 / stepMs, 1));
+                    row.push_back(formatScientific(double(batchSize) * 1e3 / stepMs));
+                    row.push_back(baselineMs < 0.0 ? "-"
+                            : formatNumber((stepMs - baselineMs) * 1e6 / double(batchSize)));
+                } catch (const std::exception& e) {
+                    sgl::Logfile::get()->writeError(
+                            std::string() + "Error in runCoopVecTrainingBenchmark (" + accumulationVariant.variantName
+                            + "): " + e.what(), false);
+                    row.insert(row.end(), 3, "failed");
+                }
+            }
+            table.addRow(row);
+        }
+    } catch (const std::exception& e) {
+        sgl::Logfile::get()->writeError(std::string() + "Error in runCoopVecTrainingBenchmark: " + e.what(), false);
+    }
+    table.print();
+}
@@ -0,0 +1,435 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <Utils/File/Logfile.hpp>
+#include <Graphics/Vulkan/libs/volk/volk.h>
+#include <Graphics/Vulkan/Utils/Device.hpp>
+
+#include "PrintUtils.hpp"
+#include "ComponentTypes.hpp"
+#include "NumberFormats.hpp"
+#include "VulkanUtils.hpp"
+#include "Kernels.hpp"
+#include "RooflineBenchmark.hpp"
+#include "FlashAttentionBenchmark.hpp"
+
+/// Number of tokens (batch size * heads * sequence length), such that all sequence lengths have a similar cost.
+static const uint32_t NUM_TOKENS = 65536;
+static const uint32_t NUM_SUBGROUPS_NV2 = 4;
+static const uint32_t MAX_NUM_SUBGROUPS_KHR = 4;
+/// Maximum deviation of the coopmat2 variants from the KHR variant relative to the largest output magnitude.
+static const double MAX_RELATIVE_ERROR = 1e-2;
+
+struct FlashAttentionPushConstants {
+    VkDeviceAddress bufferQ, bufferK, bufferV, bufferO;
+    uint32_t seqLen, numBatchHeads, causal;
+    float scale;
+};
+
+struct FlashAttentionConfig {
+    uint32_t headDim;
+    uint32_t seqLen;
+    bool causal;
+};
+
+/// Kernel variant with its block sizes in queries (rows) and keys (columns).
+struct FlashAttentionVariant {
+    std::string name; ///< Kernel variant name.
+    std::string unsupportedReason; ///< Empty if supported.
+    uint32_t workgroupSize = 0;
+    uint32_t blockRows = 0, blockCols = 0;
+    uint32_t blocksPerWorkgroup = 1;
+    std::vector<uint32_t> specializationConstants; ///< Without HEAD_DIM, which is inserted at headDimConstantIdx.
+    size_t headDimConstantIdx = 0;
+    uint32_t requiredSubgroupSize = 0;
+    uint32_t kGranularity = 1, nGranularity = 1, maxDimension = UINT32_MAX;
+};
+
+static uint32_t roundUpToMultiple(uint32_t value, uint32_t multiple) {
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+/// Returns the number of key blocks processed per query block summed over all query blocks of one sequence.
+static uint64_t getNumProcessedKeys(const FlashAttentionConfig& config, uint32_t blockRows, uint32_t blockCols) {
+    uint64_t numKeys = 0;
+    for (uint32_t queryStart = 0; queryStart < config.seqLen; queryStart += blockRows) {
+        uint32_t keyEnd = config.causal ? std::min(config.seqLen, queryStart + blockRows) : config.seqLen;
+        numKeys += roundUpToMultiple(keyEnd, blockCols);
+    }
+    return numKeys;
+}
+
+class FlashAttention {
+public:
+    FlashAttention(sgl::vk::Device* device, CommandContext& context, const FlashAttentionConfig& config);
+    ~FlashAttention();
+    [[nodiscard]] inline uint32_t getNumBatchHeads() const { return numBatchHeads; }
+    /// Returns the time per dispatch in milliseconds.
+    double measureMs(const FlashAttentionVariant& variant);
+    std::vector<float> downloadResult();
+
+private:
+    void destroyBuffers();
+
+    sgl::vk::Device* device;
+    CommandContext& context;
+    FlashAttentionConfig config;
+    uint32_t numBatchHeads;
+    DeviceBuffer bufferQ, bufferK, bufferV, bufferO;
+};
+
+FlashAttention::FlashAttention(sgl::vk::Device* device, CommandContext& context, const FlashAttentionConfig& config)
+        : device(device), context(context), config(config) {
+    numBatchHeads = std::max(getReducedProblemSize(NUM_TOKENS) / config.seqLen, 1u);
+    const size_t numElements = size_t(numBatchHeads) * size_t(config.seqLen) * size_t(config.headDim);
+    const VkBufferUsageFlags usage =
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT
+            | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    try {
+        uint32_t seed = 1;
+        for (DeviceBuffer* buffer : { &bufferQ, &bufferK, &bufferV }) {
+            std::vector<uint8_t> data = createRandomElements(VK_COMPONENT_TYPE_FLOAT16_KHR, numElements, seed++);
+            *buffer = createDeviceBuffer(device, data.size(), usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+            uploadBufferData(device, context, *buffer, data.data(), data.size());
+        }
+        bufferO = createDeviceBuffer(device, numElements * sizeof(float), usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    } catch (...) {
+        destroyBuffers();
+        throw;
+    }
+}
+
+FlashAttention::~FlashAttention() {
+    destroyBuffers();
+}
+
+void FlashAttention::destroyBuffers() {
+    VkDevice vkDevice = device->getVkDevice();
+    destroyDeviceBuffer(vkDevice, bufferQ);
+    destroyDeviceBuffer(vkDevice, bufferK);
+    destroyDeviceBuffer(vkDevice, bufferV);
+    destroyDeviceBuffer(vkDevice, bufferO);
+}
+
+double FlashAttention::measureMs(const FlashAttentionVariant& variant) {
+    const EmbeddedKernel* kernel = findEmbeddedKernel("FlashAttention", variant.name);
+    if (!kernel) {
+        throw std::runtime_error("Kernel variant FlashAttention/" + variant.name + " is not available.");
+    }
+    ComputePipelineSettings pipelineSettings{};
+    pipelineSettings.code = kernel->code;
+    pipelineSettings.codeSize = kernel->codeSize;
+    pipelineSettings.specializationConstants = variant.specializationConstants;
+    pipelineSettings.specializationConstants.insert(
+            pipelineSettings.specializationConstants.begin() + ptrdiff_t(variant.headDimConstantIdx), config.headDim);
+    pipelineSettings.pushConstantSize = sizeof(FlashAttentionPushConstants);
+    pipelineSettings.requiredSubgroupSize = variant.requiredSubgroupSize;
+    ComputePipeline pipeline(device->getVkDevice(), pipelineSettings);
+
+    FlashAttentionPushConstants pushConstants{};
+    pushConstants.bufferQ = bufferQ.deviceAddress;
+    pushConstants.bufferK = bufferK.deviceAddress;
+    pushConstants.bufferV = bufferV.deviceAddress;
+    pushConstants.bufferO = bufferO.deviceAddress;
+    pushConstants.seqLen = config.seqLen;
+    pushConstants.numBatchHeads = numBatchHeads;
+    pushConstants.causal = config.causal ? 1 : 0;
+    pushConstants.scale = 1.0f / std::sqrt(float(config.headDim));
+    uint32_t numBlocks = numBatchHeads * (config.seqLen / variant.blockRows);
+    uint32_t numWorkgroups = (numBlocks + variant.blocksPerWorkgroup - 1) / variant.blocksPerWorkgroup;
+    return measureCommandsMs(context, [&](VkCommandBuffer commandBuffer) {
+        pipeline.bind(commandBuffer);
+        pipeline.pushConstants(commandBuffer, &pushConstants, sizeof(FlashAttentionPushConstants));
+        vkCmdDispatch(commandBuffer, numWorkgroups, 1, 1);
+    }, 5);
+}
+
+std::vector<float> FlashAttention::downloadResult() {
+    std::vector<float> result(bufferO.size / sizeof(float));
+    downloadBufferData(device, context, bufferO, result.data(), bufferO.size);
+    return result;
+}
+
+static bool getResultsMatch(const std::vector<float>& reference, const std::vector<float>& result) {
+    double maxAbsReference = 0.0, maxAbsError = 0.0;
+    for (size_t i = 0; i < reference.size(); i++) {
+        maxAbsReference = std::max(maxAbsReference, double(std::abs(reference[i])));
+        maxAbsError = std::max(maxAbsError, double(std::abs(reference[i] - result[i])));
+    }
+    return maxAbsError <= MAX_RELATIVE_ERROR * std::max(maxAbsReference, 1e-3);
+}
+
+static bool getIsF16F32(VkComponentTypeKHR AType, VkComponentTypeKHR BType, VkComponentTypeKHR CType,
+                        VkComponentTypeKHR ResultType) {
+    return AType == VK_COMPONENT_TYPE_FLOAT16_KHR && BType == VK_COMPONENT_TYPE_FLOAT16_KHR
+            && CType == VK_COMPONENT_TYPE_FLOAT32_KHR && ResultType == VK_COMPONENT_TYPE_FLOAT32_KHR;
+}
+
+static std::vector<FlashAttentionVariant> createVariants(sgl::vk::Device* device) {
+    std::vector<FlashAttentionVariant> variants;
+    const auto& properties13 = device->getPhysicalDeviceVulkan13Properties();
+    /*
+     * The subgroup scope kernels index per-subgroup data by gl_SubgroupID, so the subgroup size needs to be fixed.
+     * Without a required subgroup size, SPIR-V 1.6 allows a smaller size and thus more subgroups than there are slots.
+     */
+    uint32_t subgroupSize = device->getPhysicalDeviceSubgroupProperties().subgroupSize;
+    const bool hasRequiredSubgroupSize =
+            device->getPhysicalDeviceVulkan13Features().subgroupSizeControl
+            && (properties13.requiredSubgroupSizeStages & VK_SHADER_STAGE_COMPUTE_BIT) != 0;
+    const uint32_t requiredSubgroupSize = subgroupSize;
+
+    FlashAttentionVariant khrVariant{};
+    khrVariant.name = "khr";
+    khrVariant.unsupportedReason = "no f16 x f16 + f32 entry";
+    for (const auto& props : device->getSupportedCooperativeMatrixPropertiesKHR()) {
+        if (props.scope == VK_SCOPE_SUBGROUP_KHR && getIsF16F32(props.AType, props.BType, props.CType, props.ResultType)
+                && props.NSize % props.KSize == 0) {
+            khrVariant.unsupportedReason.clear();
+            khrVariant.blockRows = props.MSize;
+            khrVariant.blockCols = props.NSize;
+            khrVariant.kGranularity = std::max(props.KSize, props.NSize);
+            khrVariant.nGranularity = props.NSize;
+            // WORKGROUP_SIZE and NUM_SUBGROUPS depend on the shared memory usage and are set by prepareVariant.
+            khrVariant.specializationConstants = { 0, props.MSize, props.NSize, props.KSize, 0 };
+            khrVariant.headDimConstantIdx = 4;
+            khrVariant.requiredSubgroupSize = requiredSubgroupSize;
+            break;
+        }
+    }
+    if (khrVariant.unsupportedReason.empty() && !hasRequiredSubgroupSize) {
+        khrVariant.unsupportedReason = "no subgroup size control";
+    }
+    variants.push_back(khrVariant);
+
+    const auto& features2 = device->getCooperativeMatrix2FeaturesNV();
+    std::string nv2UnsupportedReason;
+    if (!features2.cooperativeMatrixReductions || !features2.cooperativeMatrixPerElementOperations
+            || !features2.cooperativeMatrixConversions || !features2.cooperativeMatrixFlexibleDimensions) {
+        nv2UnsupportedReason = "n/a";
+    }
+    for (bool useWorkgroupScope : { false, true }) {
+        FlashAttentionVariant variant{};
+        variant.name = useWorkgroupScope ? "nv2_workgroup" : "nv2_subgroup";
+        variant.unsupportedReason = nv2UnsupportedReason;
+        if (useWorkgroupScope && !features2.cooperativeMatrixWorkgroupScope) {
+            variant.unsupportedReason = "n/a";
+        }
+        if (!useWorkgroupScope && variant.unsupportedReason.empty() && !hasRequiredSubgroupSize) {
+            variant.unsupportedReason = "no subgroup size control";
+        }
+        if (!variant.unsupportedReason.empty()) {
+            variants.push_back(variant);
+            continue;
+        }
+        variant.unsupportedReason = "no f16 x f16 + f32 entry";
+        VkScopeKHR scope = useWorkgroupScope ? VK_SCOPE_WORKGROUP_KHR : VK_SCOPE_SUBGROUP_KHR;
+        for (const auto& props : device->getSupportedCooperativeMatrixFlexibleDimensionsPropertiesNV()) {
+            if (props.scope != scope || !getIsF16F32(props.AType, props.BType, props.CType, props.ResultType)) {
+                continue;
+            }
+            variant.unsupportedReason.clear();
+            // Keys are both the N dimension of S and the K dimension of P * V (and vice versa for the head dimension).
+            uint32_t keyGranularity = std::max(props.NGranularity, props.KGranularity);
+            variant.blockRows = roundUpToMultiple(useWorkgroupScope ? 64 : 16, props.MGranularity);
+            variant.blockCols = roundUpToMultiple(useWorkgroupScope ? 64 : 32, keyGranularity);
+            variant.kGranularity = props.KGranularity;
+            variant.nGranularity = props.NGranularity;
+            variant.maxDimension =
+                    device->getCooperativeMatrix2PropertiesNV().cooperativeMatrixFlexibleDimensionsMaxDimension;
+            if (useWorkgroupScope) {
+                variant.workgroupSize = props.workgroupInvocations;
+            } else {
+                variant.workgroupSize = subgroupSize * NUM_SUBGROUPS_NV2;
+                variant.blocksPerWorkgroup = NUM_SUBGROUPS_NV2;
+                variant.requiredSubgroupSize = requiredSubgroupSize;
+            }
+            variant.specializationConstants = { variant.workgroupSize, variant.blockRows, variant.blockCols };
+            variant.headDimConstantIdx = 3;
+            break;
+        }
+        variants.push_back(variant);
+    }
+    return variants;
+}
+
+/// Returns an empty string if the variant supports the configuration, and the reason otherwise.
+static std::string prepareVariant(
+        sgl::vk::Device* device, FlashAttentionVariant& variant, const FlashAttentionConfig& config) {
+    if (!variant.unsupportedReason.empty()) {
+        return variant.unsupportedReason;
+    }
+    if (config.headDim % variant.kGranularity != 0 || config.headDim % variant.nGranularity != 0
+            || config.headDim > variant.maxDimension || config.seqLen % variant.blockRows != 0
+            || config.seqLen % variant.blockCols != 0) {
+        return "-";
+    }
+    if (variant.name == "khr") {
+        // Shared memory per subgroup: S (float), P (float16), O (float) and the row statistics.
+        const auto& limits = device->getLimits();
+        uint32_t rows = variant.blockRows, cols = variant.blockCols;
+        uint32_t sharedMemoryPerSubgroup = rows * cols * 6 + rows * config.headDim * 4 + rows * 8;
+        uint32_t subgroupSize = device->getPhysicalDeviceSubgroupProperties().subgroupSize;
+        uint32_t numSubgroups = std::min(
+                { MAX_NUM_SUBGROUPS_KHR, limits.maxComputeSharedMemorySize / sharedMemoryPerSubgroup,
+                  limits.maxComputeWorkGroupInvocations / subgroupSize });
+        if (numSubgroups == 0) {
+            return "shared memory";
+        }
+        variant.workgroupSize = subgroupSize * numSubgroups;
+        variant.blocksPerWorkgroup = numSubgroups;
+        variant.specializationConstants[0] = variant.workgroupSize;
+        variant.specializationConstants[4] = numSubgroups;
+    }
+    return "";
+}
+
+void runFlashAttentionBenchmark(sgl::vk::Device* device) {
+    writeOut("");
+    writeOut("Fused attention benchmark (", getReducedProblemSize(NUM_TOKENS), " tokens per configuration):");
+    if (!device->getCooperativeMatrixFeaturesKHR().cooperativeMatrix) {
+        writeOut("VK_KHR_cooperative_matrix is not supported.");
+        return;
+    }
+    if (!getIsComponentTypeUsable(device, VK_COMPONENT_TYPE_FLOAT16_KHR)) {
+        writeOut("float16 is not usable in shaders.");
+        return;
+    }
+
+    std::vector<FlashAttentionVariant> variants = createVariants(device);
+    for (const auto& variant : variants) {
+        if (variant.unsupportedReason.empty()) {
+            writeOut("Variant ", variant.name, ": ", variant.blockRows, " queries x ", variant.blockCols,
+                     " keys per block");
+        } else {
+            writeOut("Variant ", variant.name, ": unsupported");
+        }
+    }
+    writeOut("Traffic: compulsory Q, K, V and O traffic, and the traffic when every query block re-reads K and V.");
+
+    std::vector<std::string> columnNames = { "Head dim", "Seq len", "Causal", "Batch*heads" };
+    for (const auto& variant : variants) {
+        columnNames.push_back(variant.name + " TFLOP/s");
+        columnNames.push_back(variant.name + " traffic");
+        columnNames.push_back(variant.name + " GiB/s");
+    }
+    columnNames.emplace_back("Best");
+    ResultTable table(columnNames);
+
+    try {
+        CommandContext context(device);
+        for (uint32_t headDim : { 64u, 128u, 256u }) {
+            for (uint32_t seqLen : { 1024u, 4096u, 16384u }) {
+                if (seqLen > getReducedProblemSize(NUM_TOKENS)) {
+                    continue;
+                }
+                for (bool causal : { false, true }) {
+                    FlashAttentionConfig config{ headDim, seqLen, causal };
+                    std::vector<std::string> row = {
+                            std::to_string(headDim), std::to_string(seqLen), sgl::toString(causal) };
+                    try {
+                        FlashAttention attention(device, context, config);
+                        const double numBatchHeads = double(attention.getNumBatchHeads());
+                        row.push_back(std::to_string(attention.getNumBatchHeads()));
+                        // Number of attended (query, key) pairs, including the diagonal for causal masking.
+                        double numPairs = causal
+                                ? double(seqLen) * double(seqLen + 1) / 2.0 : double(seqLen) * double(seqLen);
+                        double numOperations = 4.0 * numBatchHeads * numPairs * double(headDim);
+                        double compulsoryBytes =
+                                numBatchHeads * double(seqLen) * double(headDim) * (3.0 * 2.0 + 4.0);
+                        std::vector<float> reference;
+                        std::string bestVariant = "-";
+                        double bestTops = 0.0;
+                        for (auto& variant : variants) {
+                            std::string unsupportedReason = prepareVariant(device, variant, config);
+                            if (!unsupportedReason.empty()) {
+                                row.insert(row.end(), 3, unsupportedReason);
+                                continue;
+                            }
+                            try {
+                                double timeMs = attention.measureMs(variant);
+                                double tops = numOperations / (timeMs * 1e9);
+                                double streamedBytes =
+                                        numBatchHeads * double(seqLen) * double(headDim) * (2.0 + 4.0)
+                                        + numBatchHeads * double(getNumProcessedKeys(
+                                                config, variant.blockRows, variant.blockCols))
+                                        * double(headDim) * 2.0 * 2.0;
+                                std::vector<float> result = attention.downloadResult();
+                                bool matches = true;
+                                if (reference.empty()) {
+                                    reference = std::move(result);
+                                } else {
+                                    matches = getResultsMatch(reference, result);
+                                }
+                                row.push_back(formatNumber(tops) + (matches ? "" : " (mismatch)"));
+                                row.push_back(sgl::getNiceMemoryString(uint64_t(compulsoryBytes), 2) + " / "
+                                        + sgl::getNiceMemoryString(uint64_t(streamedBytes), 2));
+                                row.push_back(formatNumber(computeGiBPerSecond(streamedBytes, timeMs)));
+                                RooflineKernelRun run;
+                                run.category = "Attention";
+                                run.label = "attn d" + std::to_string(headDim) + " s" + std::to_string(seqLen)
+                                        + (causal ? " causal " : " ") + variant.name;
+                                run.types = getTypeCombinationLabel(
+                                        VK_COMPONENT_TYPE_FLOAT16_KHR, VK_COMPONENT_TYPE_FLOAT16_KHR,
+                                        VK_COMPONENT_TYPE_FLOAT32_KHR, VK_COMPONENT_TYPE_FLOAT32_KHR);
+                                run.numOperations = numOperations;
+                                run.numBytes = streamedBytes;
+                                run.timeMs = timeMs;
+                                addRooflineKernelRun(run);
+                                if (matches && tops > bestTops) {
+                                    bestTops = tops;
+                                    bestVariant = variant.name;
+                                }
+                            } catch (const std::exception& e) {
+                                sgl::Logfile::get()->writeError(
+                                        std::string() + "Error in runFlashAttentionBenchmark (" + variant.name
+                                        + "): " + e.what(), false);
+                                row.insert(row.end(), 3, "failed");
+                            }
+                        }
+                        row.push_back(bestVariant);
+                    } catch (const std::exception& e) {
+                        sgl::Logfile::get()->writeError(
+                                std::string() + "Error in runFlashAttentionBenchmark: " + e.what(), false);
+                        row.resize(columnNames.size(), "failed");
+                    }
+                    table.addRow(row);
+                }
+            }
+        }
+    } catch (const std::exception& e) {
+        sgl::Logfile::get()->writeError(std::string() + "Error in runFlashAttentionBenchmark: " + e.what(), false);
+    }
+    table.print();
+}
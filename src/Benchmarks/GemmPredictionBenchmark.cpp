@@ -0,0 +1,207 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <Utils/File/Logfile.hpp>
+#include <Graphics/Vulkan/Utils/Device.hpp>
+
+#include "PrintUtils.hpp"
+#include "ComponentTypes.hpp"
+#include "JsonWriter.hpp"
+#include "GemmPerformanceModel.hpp"
+#include "CoopMatGemm.hpp"
+#include "GemmPredictionBenchmark.hpp"
+
+static const uint32_t TRAINING_SIZES_MN[] = { 128, 256, 512, 1024, 2048, 4096 };
+static const uint32_t TRAINING_SIZES_K[] = { 128, 512, 2048 };
+
+struct GemmShape {
+    uint32_t M, N, K;
+};
+static const GemmShape RECTANGULAR_TRAINING_SHAPES[] = { { 4096, 256, 512 }, { 256, 4096, 512 } };
+static const GemmShape HELD_OUT_SHAPES[] = {
+        { 300, 300, 300 }, { 777, 777, 777 }, { 1500, 1500, 1500 }, { 3000, 3000, 1000 },
+        { 1000, 3000, 700 }, { 3000, 1000, 1500 },
+};
+
+/// The tiles of the CoopMatGemm kernel; see CoopMatGemm::CoopMatGemm.
+static GemmTileGranularity getGemmTileGranularity(const CoopMatGemmSettings& settings) {
+    GemmTileGranularity granularity;
+    granularity.tileM = settings.lM * settings.tileM;
+    granularity.tileN = settings.lN * settings.tileN;
+    granularity.tileK = settings.lK;
+    granularity.tilesPerWorkgroup = settings.scope == VK_SCOPE_WORKGROUP_KHR ? 1 : settings.subgroupsPerWorkgroup;
+    return granularity;
+}
+
+static double measureShapeMs(
+        sgl::vk::Device* device, CommandContext& context, CoopMatGemmSettings settings, const GemmShape& shape) {
+    settings.M = shape.M;
+    settings.N = shape.N;
+    settings.K = shape.K;
+    CoopMatGemm gemm(device, context, settings);
+    // The time of the padded problem is the time of the requested one.
+    return gemm.getNumOperations() / (gemm.measureTeraOpsPerSecond() * 1e9);
+}
+
+struct PredictionEntry {
+    std::string types, shape;
+    CoopMatGemmSettings settings;
+};
+
+void runGemmPredictionBenchmark(size_t deviceIdx, sgl::vk::Device* device, const std::string& reportDirectory) {
+    writeOut("");
+    writeOut("GEMM performance prediction benchmark:");
+    if (!device->getCooperativeMatrixFeaturesKHR().cooperativeMatrix) {
+        writeOut("VK_KHR_cooperative_matrix is not supported.");
+        return;
+    }
+
+    // The first supported shape per type combination and scope.
+    std::vector<PredictionEntry> entries;
+    std::set<std::string> typesSet;
+    auto addEntry = [&](const CoopMatGemmSettings& settings, const std::string& types) {
+        if (typesSet.count(types) != 0 || !CoopMatGemm::checkSupport(device, settings).empty()) {
+            return;
+        }
+        typesSet.insert(types);
+        PredictionEntry entry;
+        entry.types = types;
+        entry.shape =
+                std::to_string(settings.lM) + "x" + std::to_string(settings.lN) + "x" + std::to_string(settings.lK);
+        entry.settings = settings;
+        entries.push_back(entry);
+    };
+    for (const auto& props : device->getSupportedCooperativeMatrixPropertiesKHR()) {
+        if (props.scope == VK_SCOPE_SUBGROUP_KHR) {
+            addEntry(CoopMatGemmSettings::fromProperties(props), getTypeCombinationLabel(props));
+        }
+    }
+    if (device->getCooperativeMatrix2FeaturesNV().cooperativeMatrixWorkgroupScope) {
+        for (const auto& props : device->getSupportedCooperativeMatrixFlexibleDimensionsPropertiesNV()) {
+            if (props.scope == VK_SCOPE_WORKGROUP_KHR) {
+                addEntry(
+                        CoopMatGemmSettings::fromProperties(props),
+                        getTypeCombinationLabel(props.AType, props.BType, props.CType, props.ResultType)
+                                + " (workgroup)");
+            }
+        }
+    }
+    if (entries.empty()) {
+        writeOut("No supported CoopMatGemm kernel variant available.");
+        return;
+    }
+
+    GemmPerformancePredictor predictor;
+    ResultTable summaryTable({
+            "Types", "Shape", "Concurrent WGs", "Error bound", "Mean error", "Max error", "Within bounds" });
+    ResultTable heldOutTable({ "Types", "M x N x K", "Measured", "Predicted", "Bounds", "Error" });
+    try {
+        CommandContext context(device);
+        for (const auto& entry : entries) {
+            try {
+                std::vector<GemmShapeMeasurement> measurements;
+                auto addMeasurement = [&](const GemmShape& shape) {
+                    measurements.push_back({
+                            shape.M, shape.N, shape.K, measureShapeMs(device, context, entry.settings, shape) });
+                };
+                for (uint32_t sizeMN : TRAINING_SIZES_MN) {
+                    for (uint32_t sizeK : TRAINING_SIZES_K) {
+                        addMeasurement({ sizeMN, sizeMN, sizeK });
+                    }
+                }
+                for (const auto& shape : RECTANGULAR_TRAINING_SHAPES) {
+                    addMeasurement(shape);
+                }
+                GemmPerformanceModel model(getGemmTileGranularity(entry.settings));
+                model.fit(measurements);
+
+                double errorSum = 0.0, maxError = 0.0;
+                int numWithinBounds = 0, numHeldOut = 0;
+                for (const auto& shape : HELD_OUT_SHAPES) {
+                    double measuredMs = measureShapeMs(device, context, entry.settings, shape);
+                    GemmPrediction prediction = model.predict(shape.M, shape.N, shape.K);
+                    double error = std::abs(prediction.timeMs / measuredMs - 1.0);
+                    errorSum += error;
+                    maxError = std::max(maxError, error);
+                    numHeldOut++;
+                    if (measuredMs >= prediction.minTimeMs && measuredMs <= prediction.maxTimeMs) {
+                        numWithinBounds++;
+                    }
+                    heldOutTable.addRow({
+                            entry.types,
+                            std::to_string(shape.M) + " x " + std::to_string(shape.N) + " x "
+                                    + std::to_string(shape.K),
+                            formatNumber(measuredMs, 3) + " ms", formatNumber(prediction.timeMs, 3) + " ms",
+                            formatNumber(prediction.minTimeMs, 3) + "-" + formatNumber(prediction.maxTimeMs, 3)
+                                    + (prediction.isExtrapolated ? " (extrapolated)" : ""),
+                            formatNumber(100.0 * error, 1) + "%" });
+                }
+                summaryTable.addRow({
+                        entry.types, entry.shape, std::to_string(model.getConcurrentWorkgroups()),
+                        formatNumber(100.0 * model.getRelativeErrorBound(), 1) + "%",
+                        formatNumber(100.0 * errorSum / double(numHeldOut), 1) + "%",
+                        formatNumber(100.0 * maxError, 1) + "%",
+                        std::to_string(numWithinBounds) + "/" + std::to_string(numHeldOut) });
+                predictor.addModel(entry.types, model);
+            } catch (const std::exception& e) {
+                sgl::Logfile::get()->writeError(
+                        std::string() + "Error in runGemmPredictionBenchmark (" + entry.types + "): " + e.what(),
+                        false);
+            }
+        }
+    } catch (const std::exception& e) {
+        sgl::Logfile::get()->writeError(std::string() + "Error in runGemmPredictionBenchmark: " + e.what(), false);
+        return;
+    }
+    summaryTable.print();
+    heldOutTable.print();
+
+    std::error_code errorCode;
+    std::filesystem::create_directories(reportDirectory, errorCode);
+    const std::string filePath = (std::filesystem::path(reportDirectory)
+            / ("GemmPredictionModel_" + std::to_string(deviceIdx) + ".json")).string();
+    JsonWriter writer;
+    writer.beginObject();
+    writer.keyValue("device", std::string(device->getPhysicalDeviceProperties().deviceName));
+    writer.key("models");
+    predictor.writeJson(writer);
+    writer.endObject();
+    if (!writer.save(filePath)) {
+        sgl::Logfile::get()->writeError("Error in runGemmPredictionBenchmark: Could not write " + filePath, false);
+    } else {
+        writeOut("Wrote the fitted models to ", filePath, ".");
+    }
+}
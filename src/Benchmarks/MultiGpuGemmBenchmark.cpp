@@ -0,0 +1,1082 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <Utils/File/Logfile.hpp>
+#include <Graphics/Vulkan/Utils/Instance.hpp>
+#include <Graphics/Vulkan/Utils/Device.hpp>
+
+#include "PrintUtils.hpp"
+#include "ComponentTypes.hpp"
+#include "NumberFormats.hpp"
+#include "Kernels.hpp"
+#include "VulkanUtils.hpp"
+#include "CoopMatGemm.hpp"
+#include "MultiGpuGemmBenchmark.hpp"
+
+static const uint32_t PROBLEM_SIZE = 8192;
+static const uint32_t NUM_GEMM_ITERATIONS = 4; ///< Per sample of the compute phase.
+static const uint32_t ADD_WORKGROUP_SIZE = 256;
+
+enum class SplitStrategy {
+    ROW, COLUMN, K
+};
+static const SplitStrategy SPLIT_STRATEGIES[] = { SplitStrategy::ROW, SplitStrategy::COLUMN, SplitStrategy::K };
+
+static std::string getSplitStrategyName(SplitStrategy strategy) {
+    if (strategy == SplitStrategy::ROW) {
+        return "Rows (M)";
+    } else if (strategy == SplitStrategy::COLUMN) {
+        return "Columns (N)";
+    } else {
+        return "K + reduction";
+    }
+}
+
+struct MatrixAddPushConstants {
+    VkDeviceAddress inputAddress, outputAddress;
+    uint32_t numElements;
+};
+
+/**
+ * Part of the GEMM computed by one device: rows [rowOffset, rowOffset + M) and columns [columnOffset, columnOffset + N)
+ * of the result, using columns [kOffset, kOffset + K) of A and the same rows of B. The partial results of the K split
+ * cover the full result.
+ */
+struct GemmPartition {
+    CoopMatGemmSettings settings; ///< Size of the block.
+    uint32_t rowOffset = 0, columnOffset = 0, kOffset = 0;
+};
+
+enum class GemmMatrix {
+    A, B, D
+};
+
+struct SplitResult {
+    std::string partitions;
+    double scatterMs = 0.0;
+    double computeMs = 0.0;
+    double gatherMs = 0.0; ///< Including the reduction of the K split.
+};
+
+/// Splits the extent into non-zero multiples of the granularity proportional to the weights.
+static std::vector<uint32_t> splitExtent(uint32_t extent, uint32_t granularity, const std::vector<double>& weights) {
+    const uint32_t numParts = uint32_t(weights.size());
+    const uint32_t numBlocks = extent / granularity;
+    if (numBlocks < numParts) {
+        throw std::runtime_error("The problem size is too small for splitting it across all devices.");
+    }
+    const double weightSum = std::accumulate(weights.begin(), weights.end(), 0.0);
+    std::vector<uint32_t> parts(numParts);
+    uint32_t numAssignedBlocks = 0;
+    double cumulativeWeight = 0.0;
+    for (uint32_t i = 0; i < numParts; i++) {
+        cumulativeWeight += weights.at(i);
+        uint32_t endBlock = uint32_t(std::lround(double(numBlocks) * cumulativeWeight / weightSum));
+        endBlock = std::clamp(endBlock, numAssignedBlocks + 1, numBlocks - (numParts - i - 1));
+        if (i == numParts - 1) {
+            endBlock = numBlocks;
+        }
+        parts.at(i) = (endBlock - numAssignedBlocks) * granularity;
+        numAssignedBlocks = endBlock;
+    }
+    return parts;
+}
+
+static std::vector<GemmPartition> createPartitions(
+        const CoopMatGemmSettings& settings, SplitStrategy strategy, const std::vector<double>& weights) {
+    std::vector<uint32_t> extents;
+    if (strategy == SplitStrategy::ROW) {
+        extents = splitExtent(settings.M, settings.lM * settings.tileM, weights);
+    } else if (strategy == SplitStrategy::COLUMN) {
+        extents = splitExtent(settings.N, settings.lN * settings.tileN, weights);
+    } else {
+        extents = splitExtent(settings.K, settings.lK, weights);
+    }
+    std::vector<GemmPartition> partitions(weights.size());
+    uint32_t offset = 0;
+    for (size_t i = 0; i < partitions.size(); i++) {
+        GemmPartition& partition = partitions.at(i);
+        partition.settings = settings;
+        if (strategy == SplitStrategy::ROW) {
+            partition.settings.M = extents.at(i);
+            partition.rowOffset = offset;
+        } else if (strategy == SplitStrategy::COLUMN) {
+            partition.settings.N = extents.at(i);
+            partition.columnOffset = offset;
+        } else {
+            partition.settings.K = extents.at(i);
+            partition.kOffset = offset;
+        }
+        offset += extents.at(i);
+    }
+    return partitions;
+}
+
+/// Size of the densely packed block of the matrix the partition reads (A, B) or writes (D).
+static VkDeviceSize getBlockSize(const GemmPartition& partition, GemmMatrix matrix) {
+    const CoopMatGemmSettings& s = partition.settings;
+    if (matrix == GemmMatrix::A) {
+        return VkDeviceSize(s.M) * s.K * getComponentTypeSize(s.AType);
+    } else if (matrix == GemmMatrix::B) {
+        return VkDeviceSize(s.K) * s.N * getComponentTypeSize(s.BType);
+    }
+    return VkDeviceSize(s.M) * s.N * getComponentTypeSize(s.ResultType);
+}
+
+/**
+ * Copy regions between the block of the partition in the row-major matrix of the full problem and a densely packed
+ * copy of it starting at packedOffset, which is the layout the GEMM kernel expects. Blocks of complete rows are
+ * contiguous and need a single region; all others need one region per row.
+ */
+static std::vector<VkBufferCopy> getBlockCopyRegions(
+        const CoopMatGemmSettings& settings, const GemmPartition& partition, GemmMatrix matrix,
+        VkDeviceSize packedOffset, bool isPacking) {
+    const CoopMatGemmSettings& s = partition.settings;
+    uint32_t rowOffset = partition.rowOffset, columnOffset = partition.columnOffset;
+    uint32_t numRows = s.M, numColumns = s.N, matrixColumns = settings.N;
+    VkComponentTypeKHR compType = s.ResultType;
+    if (matrix == GemmMatrix::A) {
+        columnOffset = partition.kOffset;
+        numColumns = s.K;
+        matrixColumns = settings.K;
+        compType = s.AType;
+    } else if (matrix == GemmMatrix::B) {
+        rowOffset = partition.kOffset;
+        numRows = s.K;
+        compType = s.BType;
+    }
+    const VkDeviceSize elementSize = getComponentTypeSize(compType);
+    const VkDeviceSize packedRowSize = VkDeviceSize(numColumns) * elementSize;
+    const VkDeviceSize matrixRowSize = VkDeviceSize(matrixColumns) * elementSize;
+    const VkDeviceSize blockOffset = VkDeviceSize(rowOffset) * matrixRowSize + VkDeviceSize(columnOffset) * elementSize;
+    const bool isContiguous = numColumns == matrixColumns;
+    std::vector<VkBufferCopy> regions;
+    for (uint32_t row = 0; row < (isContiguous ? 1u : numRows); row++) {
+        const VkDeviceSize matrixOffset = blockOffset + VkDeviceSize(row) * matrixRowSize;
+        const VkDeviceSize packedRowOffset = packedOffset + VkDeviceSize(row) * packedRowSize;
+        const VkDeviceSize size = isContiguous ? VkDeviceSize(numRows) * packedRowSize : packedRowSize;
+        regions.push_back(isPacking
+                ? VkBufferCopy{ matrixOffset, packedRowOffset, size }
+                : VkBufferCopy{ packedRowOffset, matrixOffset, size });
+    }
+    return regions;
+}
+
+static void copyBufferRegions(
+        VkCommandBuffer commandBuffer, VkBuffer srcBuffer, VkBuffer dstBuffer,
+        const std::vector<VkBufferCopy>& regions) {
+    vkCmdCopyBuffer(commandBuffer, srcBuffer, dstBuffer, uint32_t(regions.size()), regions.data());
+}
+
+/**
+ * Inputs of small integers in [-2, 2]: All sums of products are exact in fp32, such that every split and summation
+ * order needs to reproduce the single-device result bit by bit. C is zero, so only A and B need to be distributed.
+ */
+static std::vector<uint8_t> createIntegerElements(VkComponentTypeKHR compType, size_t numElements, uint32_t seed) {
+    std::vector<uint8_t> data(numElements * getComponentTypeSize(compType));
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<int> distribution(-2, 2);
+    for (size_t i = 0; i < numElements; i++) {
+        writeElement(data.data(), compType, i, double(distribution(generator)));
+    }
+    return data;
+}
+
+/// Throws if the gathered result differs from the one of the full GEMM on a single device.
+static void checkGatheredResult(
+        const std::vector<uint8_t>& result, const std::vector<uint8_t>& reference, VkComponentTypeKHR compType) {
+    if (std::memcmp(result.data(), reference.data(), reference.size()) == 0) {
+        return;
+    }
+    const size_t numElements = reference.size() / getComponentTypeSize(compType);
+    size_t numMismatches = 0;
+    for (size_t i = 0; i < numElements; i++) {
+        if (!(readElement(result.data(), compType, i) == readElement(reference.data(), compType, i))) {
+            numMismatches++;
+        }
+    }
+    if (numMismatches != 0) {
+        throw std::runtime_error(
+                "The gathered result differs from the single-device result in " + std::to_string(numMismatches)
+                + " of " + std::to_string(numElements) + " elements.");
+    }
+}
+
+static std::string getPartitionsString(SplitStrategy strategy, const std::vector<GemmPartition>& partitions) {
+    std::string text = strategy == SplitStrategy::ROW ? "M: " : strategy == SplitStrategy::COLUMN ? "N: " : "K: ";
+    for (size_t i = 0; i < partitions.size(); i++) {
+        const CoopMatGemmSettings& s = partitions.at(i).settings;
+        text += (i == 0 ? "" : "+") + std::to_string(
+                strategy == SplitStrategy::ROW ? s.M : strategy == SplitStrategy::COLUMN ? s.N : s.K);
+    }
+    return text;
+}
+
+static std::unique_ptr<ComputePipeline> createMatrixAddPipeline(VkDevice device) {
+    const EmbeddedKernel* kernel = findEmbeddedKernel("MatrixAdd", "default");
+    if (!kernel) {
+        throw std::runtime_error("MatrixAdd kernel is not available.");
+    }
+    ComputePipelineSettings pipelineSettings{};
+    pipelineSettings.code = kernel->code;
+    pipelineSettings.codeSize = kernel->codeSize;
+    pipelineSettings.specializationConstants = { ADD_WORKGROUP_SIZE };
+    pipelineSettings.pushConstantSize = sizeof(MatrixAddPushConstants);
+    return std::make_unique<ComputePipeline>(device, pipelineSettings);
+}
+
+/// Adds the fp32 partial results of the K split stored after each other in the input to the output.
+static void recordReduction(
+        VkCommandBuffer commandBuffer, const ComputePipeline& addPipeline, VkDeviceAddress inputAddress,
+        VkDeviceAddress outputAddress, VkDeviceSize partialSize, size_t numPartials) {
+    MatrixAddPushConstants pushConstants{};
+    pushConstants.outputAddress = outputAddress;
+    pushConstants.numElements = uint32_t(partialSize / (4 * sizeof(float)));
+    addPipeline.bind(commandBuffer);
+    for (size_t i = 0; i < numPartials; i++) {
+        insertMemoryBarrier(commandBuffer);
+        pushConstants.inputAddress = inputAddress + VkDeviceSize(i) * partialSize;
+        addPipeline.pushConstants(commandBuffer, &pushConstants, sizeof(MatrixAddPushConstants));
+        vkCmdDispatch(commandBuffer, (pushConstants.numElements + ADD_WORKGROUP_SIZE - 1) / ADD_WORKGROUP_SIZE, 1, 1);
+    }
+}
+
+static double getElapsedMs(std::chrono::high_resolution_clock::time_point startTime) {
+    auto endTime = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(endTime - startTime).count();
+}
+
+/*
+ * Host-coordinated execution: Every device computes its partition on densely packed copies of its blocks, stored in
+ * buffers large enough for the full problem. The blocks are packed and unpacked on the first device and moved between
+ * the devices through host-visible staging buffers and a memcpy.
+ */
+struct GemmDeviceResources {
+    sgl::vk::Device* device = nullptr;
+    std::unique_ptr<CommandContext> context;
+    std::unique_ptr<ComputePipeline> gemmPipeline;
+    std::unique_ptr<ComputePipeline> addPipeline; ///< First device only.
+    DeviceBuffer bufferA, bufferB, bufferC, bufferD; ///< Packed blocks of the partition of the device.
+    DeviceBuffer stagingBuffer; ///< Host bounce of the scatter and gather (other devices only).
+    /// First device only: The inputs and the result of the full problem, the staging buffer per other device and the
+    /// partial results of the K split of the other devices, stored after each other.
+    DeviceBuffer matrixA, matrixB, matrixD, peerStagingBuffer, gatherBuffer;
+};
+
+static DeviceBuffer createStagingBuffer(sgl::vk::Device* device, VkDeviceSize size) {
+    const VkBufferUsageFlags usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    // Cached memory makes the CPU reads of the staging buffers considerably faster where available.
+    try {
+        return createDeviceBuffer(
+                device, size, usage,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+                | VK_MEMORY_PROPERTY_HOST_CACHED_BIT);
+    } catch (const std::exception&) {
+        return createDeviceBuffer(
+                device, size, usage, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    }
+}
+
+static void createGemmDeviceResources(
+        GemmDeviceResources& resources, const CoopMatGemmSettings& settings, bool isFirstDevice, size_t numDevices) {
+    auto* device = resources.device;
+    loadDeviceFunctions(device->getVkDevice());
+    resources.context = std::make_unique<CommandContext>(device);
+    resources.gemmPipeline = std::make_unique<ComputePipeline>(
+            device->getVkDevice(), CoopMatGemm::getPipelineSettings(device, settings));
+    const VkDeviceSize sizeA = VkDeviceSize(settings.M) * settings.K * getComponentTypeSize(settings.AType);
+    const VkDeviceSize sizeB = VkDeviceSize(settings.K) * settings.N * getComponentTypeSize(settings.BType);
+    const VkDeviceSize sizeC = VkDeviceSize(settings.M) * settings.N * getComponentTypeSize(settings.CType);
+    const VkDeviceSize sizeD = VkDeviceSize(settings.M) * settings.N * getComponentTypeSize(settings.ResultType);
+    const VkBufferUsageFlags usage =
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT
+            | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    const VkMemoryPropertyFlags deviceLocal = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+    resources.bufferA = createDeviceBuffer(device, sizeA, usage, deviceLocal);
+    resources.bufferB = createDeviceBuffer(device, sizeB, usage, deviceLocal);
+    resources.bufferC = createDeviceBuffer(device, sizeC, usage, deviceLocal);
+    resources.bufferD = createDeviceBuffer(device, sizeD, usage, deviceLocal);
+    if (isFirstDevice) {
+        resources.addPipeline = createMatrixAddPipeline(device->getVkDevice());
+        resources.matrixA = createDeviceBuffer(device, sizeA, usage, deviceLocal);
+        resources.matrixB = createDeviceBuffer(device, sizeB, usage, deviceLocal);
+        resources.matrixD = createDeviceBuffer(device, sizeD, usage, deviceLocal);
+        resources.peerStagingBuffer = createStagingBuffer(device, (numDevices - 1) * std::max(sizeA + sizeB, sizeD));
+        resources.gatherBuffer = createDeviceBuffer(device, (numDevices - 1) * sizeD, usage, deviceLocal);
+    } else {
+        resources.stagingBuffer = createStagingBuffer(device, std::max(sizeA + sizeB, sizeD));
+    }
+
+    // Inputs of the single-device runs of 1.0 (fp16) and 0.0; the values do not matter for the timings, but should
+    // not be denormal or NaN. The splits overwrite A and B with the blocks of the full problem.
+    VkCommandBuffer commandBuffer = resources.context->begin();
+    vkCmdFillBuffer(commandBuffer, resources.bufferA.buffer, 0, VK_WHOLE_SIZE, 0x3C003C00u);
+    vkCmdFillBuffer(commandBuffer, resources.bufferB.buffer, 0, VK_WHOLE_SIZE, 0x3C003C00u);
+    vkCmdFillBuffer(commandBuffer, resources.bufferC.buffer, 0, VK_WHOLE_SIZE, 0u);
+    resources.context->submitAndWait();
+}
+
+static void destroyGemmDeviceResources(GemmDeviceResources& resources) {
+    VkDevice vkDevice = resources.device->getVkDevice();
+    loadDeviceFunctions(vkDevice);
+    for (DeviceBuffer* buffer : {
+            &resources.bufferA, &resources.bufferB, &resources.bufferC, &resources.bufferD,
+            &resources.stagingBuffer, &resources.matrixA, &resources.matrixB, &resources.matrixD,
+            &resources.peerStagingBuffer, &resources.gatherBuffer }) {
+        destroyDeviceBuffer(vkDevice, *buffer);
+    }
+    resources.gemmPipeline = {};
+    resources.addPipeline = {};
+    resources.context = {};
+}
+
+/**
+ * Records the commands of each passed device, submits them to all devices before waiting for any of them, and
+ * returns the wall clock time in milliseconds.
+ */
+static double runOnDevices(
+        const std::vector<GemmDeviceResources*>& devices,
+        const std::function<void(GemmDeviceResources&, VkCommandBuffer)>& recordCommands) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+    for (GemmDeviceResources* resources : devices) {
+        loadDeviceFunctions(resources->device->getVkDevice());
+        recordCommands(*resources, resources->context->begin());
+        resources->context->submit();
+    }
+    for (GemmDeviceResources* resources : devices) {
+        loadDeviceFunctions(resources->device->getVkDevice());
+        resources->context->wait();
+    }
+    return getElapsedMs(startTime);
+}
+
+static void recordGemmIterations(
+        VkCommandBuffer commandBuffer, const GemmDeviceResources& resources, const CoopMatGemmSettings& settings) {
+    for (uint32_t i = 0; i < NUM_GEMM_ITERATIONS; i++) {
+        if (i != 0) {
+            insertMemoryBarrier(commandBuffer);
+        }
+        CoopMatGemm::recordDispatch(
+                commandBuffer, *resources.gemmPipeline, settings, resources.bufferA.deviceAddress,
+                resources.bufferB.deviceAddress, resources.bufferC.deviceAddress, resources.bufferD.deviceAddress);
+    }
+}
+
+/// Measures the phases of the split and checks the gathered result against the reference of the full GEMM.
+static SplitResult measureHostCoordinatedSplit(
+        std::vector<GemmDeviceResources>& resources, const CoopMatGemmSettings& settings, SplitStrategy strategy,
+        const std::vector<GemmPartition>& partitions, const std::vector<uint8_t>& referenceD) {
+    const size_t numDevices = resources.size();
+    GemmDeviceResources& first = resources.front();
+    std::vector<GemmDeviceResources*> allDevices, otherDevices;
+    for (size_t i = 0; i < numDevices; i++) {
+        allDevices.push_back(&resources.at(i));
+        if (i != 0) {
+            otherDevices.push_back(&resources.at(i));
+        }
+    }
+    const VkDeviceSize peerStagingSize = first.peerStagingBuffer.size / (numDevices - 1);
+    const VkDeviceSize partialSize = first.gatherBuffer.size / (numDevices - 1);
+    auto* peerStagingData = static_cast<uint8_t*>(first.peerStagingBuffer.mappedData);
+
+    // The blocks of the first device are packed into its own buffers, those of the others into their staging space.
+    std::vector<VkDeviceSize> sizesA(numDevices), sizesB(numDevices), sizesD(numDevices);
+    std::vector<std::vector<VkBufferCopy>> regionsA(numDevices), regionsB(numDevices), regionsD(numDevices);
+    for (size_t i = 0; i < numDevices; i++) {
+        const GemmPartition& partition = partitions.at(i);
+        const VkDeviceSize stagingOffset = i == 0 ? 0 : (i - 1) * peerStagingSize;
+        sizesA.at(i) = getBlockSize(partition, GemmMatrix::A);
+        sizesB.at(i) = getBlockSize(partition, GemmMatrix::B);
+        sizesD.at(i) = getBlockSize(partition, GemmMatrix::D);
+        regionsA.at(i) = getBlockCopyRegions(settings, partition, GemmMatrix::A, stagingOffset, true);
+        regionsB.at(i) = getBlockCopyRegions(
+                settings, partition, GemmMatrix::B, i == 0 ? 0 : stagingOffset + sizesA.at(i), true);
+        regionsD.at(i) = getBlockCopyRegions(settings, partition, GemmMatrix::D, stagingOffset, false);
+    }
+    // Blocks missing in the gathered result are NaN.
+    runOnDevices({ &first }, [&](GemmDeviceResources& device, VkCommandBuffer commandBuffer) {
+        vkCmdFillBuffer(commandBuffer, device.matrixD.buffer, 0, VK_WHOLE_SIZE, 0xFFFFFFFFu);
+    });
+
+    SplitResult result;
+    result.partitions = getPartitionsString(strategy, partitions);
+    result.scatterMs = runBenchmark([&]() {
+        auto startTime = std::chrono::high_resolution_clock::now();
+        runOnDevices({ &first }, [&](GemmDeviceResources& device, VkCommandBuffer commandBuffer) {
+            copyBufferRegions(commandBuffer, device.matrixA.buffer, device.bufferA.buffer, regionsA.at(0));
+            copyBufferRegions(commandBuffer, device.matrixB.buffer, device.bufferB.buffer, regionsB.at(0));
+            for (size_t i = 1; i < numDevices; i++) {
+                VkBuffer peerStagingBuffer = device.peerStagingBuffer.buffer;
+                copyBufferRegions(commandBuffer, device.matrixA.buffer, peerStagingBuffer, regionsA.at(i));
+                copyBufferRegions(commandBuffer, device.matrixB.buffer, peerStagingBuffer, regionsB.at(i));
+            }
+            insertHostReadBarrier(commandBuffer);
+        });
+        for (size_t i = 1; i < numDevices; i++) {
+            memcpy(resources.at(i).stagingBuffer.mappedData, peerStagingData + (i - 1) * peerStagingSize,
+                   size_t(sizesA.at(i) + sizesB.at(i)));
+        }
+        runOnDevices(otherDevices, [&](GemmDeviceResources& device, VkCommandBuffer commandBuffer) {
+            const size_t i = size_t(&device - resources.data());
+            VkBufferCopy regionA{ 0, 0, sizesA.at(i) };
+            VkBufferCopy regionB{ sizesA.at(i), 0, sizesB.at(i) };
+            vkCmdCopyBuffer(commandBuffer, device.stagingBuffer.buffer, device.bufferA.buffer, 1, &regionA);
+            vkCmdCopyBuffer(commandBuffer, device.stagingBuffer.buffer, device.bufferB.buffer, 1, &regionB);
+        });
+        return getElapsedMs(startTime);
+    }).median;
+
+    result.computeMs = runBenchmark([&]() {
+        return runOnDevices(allDevices, [&](GemmDeviceResources& device, VkCommandBuffer commandBuffer) {
+            recordGemmIterations(commandBuffer, device, partitions.at(&device - resources.data()).settings);
+        }) / double(NUM_GEMM_ITERATIONS);
+    }).median;
+
+    result.gatherMs = runBenchmark([&]() {
+        auto startTime = std::chrono::high_resolution_clock::now();
+        runOnDevices(otherDevices, [&](GemmDeviceResources& device, VkCommandBuffer commandBuffer) {
+            VkBufferCopy region{ 0, 0, sizesD.at(&device - resources.data()) };
+            vkCmdCopyBuffer(commandBuffer, device.bufferD.buffer, device.stagingBuffer.buffer, 1, &region);
+            insertHostReadBarrier(commandBuffer);
+        });
+        for (size_t i = 1; i < numDevices; i++) {
+            memcpy(peerStagingData + (i - 1) * peerStagingSize, resources.at(i).stagingBuffer.mappedData,
+                   size_t(sizesD.at(i)));
+        }
+        runOnDevices({ &first }, [&](GemmDeviceResources& device, VkCommandBuffer commandBuffer) {
+            // The partial result of the first device of the K split is the starting point of the reduction.
+            copyBufferRegions(commandBuffer, device.bufferD.buffer, device.matrixD.buffer, regionsD.at(0));
+            for (size_t i = 1; i < numDevices; i++) {
+                if (strategy == SplitStrategy::K) {
+                    VkBufferCopy region{ (i - 1) * peerStagingSize, (i - 1) * partialSize, sizesD.at(i) };
+                    vkCmdCopyBuffer(
+                            commandBuffer, device.peerStagingBuffer.buffer, device.gatherBuffer.buffer, 1, &region);
+                } else {
+                    copyBufferRegions(
+                            commandBuffer, device.peerStagingBuffer.buffer, device.matrixD.buffer, regionsD.at(i));
+                }
+            }
+            if (strategy == SplitStrategy::K) {
+                recordReduction(
+                        commandBuffer, *device.addPipeline, device.gatherBuffer.deviceAddress,
+                        device.matrixD.deviceAddress, partialSize, numDevices - 1);
+            }
+        });
+        return getElapsedMs(startTime);
+    }).median;
+
+    std::vector<uint8_t> resultD(referenceD.size());
+    loadDeviceFunctions(first.device->getVkDevice());
+    downloadBufferData(first.device, *first.context, first.matrixD, resultD.data(), resultD.size());
+    checkGatheredResult(resultD, referenceD, settings.ResultType);
+    return result;
+}
+
+/*
+ * Device group execution: One logical device for all members. Buffers have one instance per member; the members pack
+ * their blocks of the inputs from the instance of the first member and the first member unpacks the results of the
+ * others through buffers bound to their instances (peer memory). Per-member commands are recorded into a single
+ * command buffer with vkCmdSetDeviceMask. The partitions are equal, as the members are identical devices.
+ */
+struct DeviceGroupResources {
+    VkDevice device = VK_NULL_HANDLE;
+    uint32_t numMembers = 0;
+    VkPhysicalDeviceMemoryProperties memoryProperties{};
+    std::unique_ptr<CommandContext> context;
+    std::unique_ptr<ComputePipeline> gemmPipeline, addPipeline;
+    DeviceBuffer bufferA, bufferB, bufferC, bufferD; ///< Packed blocks of the partition of each member.
+    DeviceBuffer matrixA, matrixB, matrixD, gatherBuffer; ///< Full problem and K split partials (first member).
+    VkBuffer peerBufferA = VK_NULL_HANDLE, peerBufferB = VK_NULL_HANDLE; ///< Instance of the first member.
+    std::vector<VkBuffer> peerBuffersD; ///< Instance of member i + 1, seen by the first member.
+};
+
+/// Binds a new buffer to the memory of the passed buffer, with each member seeing the instance in deviceIndices.
+static VkBuffer createPeerBuffer(
+        VkDevice device, const DeviceBuffer& buffer, const std::vector<uint32_t>& deviceIndices) {
+    VkBufferCreateInfo bufferCreateInfo{};
+    bufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferCreateInfo.size = buffer.size;
+    bufferCreateInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    VkBuffer peerBuffer = VK_NULL_HANDLE;
+    throwIfVkError(vkCreateBuffer(device, &bufferCreateInfo, nullptr, &peerBuffer), "vkCreateBuffer");
+    VkBindBufferMemoryDeviceGroupInfo bindBufferMemoryDeviceGroupInfo{};
+    bindBufferMemoryDeviceGroupInfo.sType = VK_STRUCTURE_TYPE_BIND_BUFFER_MEMORY_DEVICE_GROUP_INFO;
+    bindBufferMemoryDeviceGroupInfo.deviceIndexCount = uint32_t(deviceIndices.size());
+    bindBufferMemoryDeviceGroupInfo.pDeviceIndices = deviceIndices.data();
+    VkBindBufferMemoryInfo bindBufferMemoryInfo{};
+    bindBufferMemoryInfo.sType = VK_STRUCTURE_TYPE_BIND_BUFFER_MEMORY_INFO;
+    bindBufferMemoryInfo.pNext = &bindBufferMemoryDeviceGroupInfo;
+    bindBufferMemoryInfo.buffer = peerBuffer;
+    bindBufferMemoryInfo.memory = buffer.memory;
+    VkResult result = vkBindBufferMemory2(device, 1, &bindBufferMemoryInfo);
+    if (result != VK_SUCCESS) {
+        vkDestroyBuffer(device, peerBuffer, nullptr);
+        throwIfVkError(result, "vkBindBufferMemory2");
+    }
+    return peerBuffer;
+}
+
+static void destroyDeviceGroupResources(DeviceGroupResources& resources) {
+    if (!resources.device) {
+        return;
+    }
+    loadDeviceFunctions(resources.device);
+    for (VkBuffer peerBuffer : resources.peerBuffersD) {
+        vkDestroyBuffer(resources.device, peerBuffer, nullptr);
+    }
+    for (VkBuffer peerBuffer : { resources.peerBufferA, resources.peerBufferB }) {
+        if (peerBuffer) {
+            vkDestroyBuffer(resources.device, peerBuffer, nullptr);
+        }
+    }
+    for (DeviceBuffer* buffer : {
+            &resources.bufferA, &resources.bufferB, &resources.bufferC, &resources.bufferD,
+            &resources.matrixA, &resources.matrixB, &resources.matrixD, &resources.gatherBuffer }) {
+        destroyDeviceBuffer(resources.device, *buffer);
+    }
+    resources.gemmPipeline = {};
+    resources.addPipeline = {};
+    resources.context = {};
+    vkDestroyDevice(resources.device, nullptr);
+    resources.device = VK_NULL_HANDLE;
+}
+
+/// Returns an empty string on success, and the reason why the group cannot be used otherwise.
+static std::string createDeviceGroupResources(
+        DeviceGroupResources& resources, const VkPhysicalDeviceGroupProperties& group, sgl::vk::Device* firstDevice,
+        const CoopMatGemmSettings& settings) {
+    VkPhysicalDevice physicalDevice = group.physicalDevices[0];
+    if (firstDevice->getApiVersion() < VK_API_VERSION_1_3) {
+        return "needs Vulkan 1.3";
+    }
+    if (!firstDevice->isDeviceExtensionSupported(VK_KHR_COOPERATIVE_MATRIX_EXTENSION_NAME)) {
+        return "no VK_KHR_cooperative_matrix";
+    }
+
+    // All features supported by the members are enabled, apart from robust buffer access, which costs performance.
+    VkPhysicalDeviceCooperativeMatrixFeaturesKHR cooperativeMatrixFeatures{};
+    cooperativeMatrixFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_COOPERATIVE_MATRIX_FEATURES_KHR;
+    VkPhysicalDeviceVulkan13Features vulkan13Features{};
+    vulkan13Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
+    vulkan13Features.pNext = &cooperativeMatrixFeatures;
+    VkPhysicalDeviceVulkan12Features vulkan12Features{};
+    vulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+    vulkan12Features.pNext = &vulkan13Features;
+    VkPhysicalDeviceVulkan11Features vulkan11Features{};
+    vulkan11Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_1_FEATURES;
+    vulkan11Features.pNext = &vulkan12Features;
+    VkPhysicalDeviceFeatures2 features2{};
+    features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    features2.pNext = &vulkan11Features;
+    vkGetPhysicalDeviceFeatures2(physicalDevice, &features2);
+    if (!vulkan12Features.bufferDeviceAddressMultiDevice) {
+        return "no bufferDeviceAddressMultiDevice";
+    }
+    features2.features.robustBufferAccess = VK_FALSE;
+    vulkan13Features.robustImageAccess = VK_FALSE;
+
+    uint32_t queueFamilyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> queueFamilyProperties(queueFamilyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, queueFamilyProperties.data());
+    uint32_t queueFamilyIndex = UINT32_MAX;
+    for (uint32_t i = 0; i < queueFamilyCount; i++) {
+        if ((queueFamilyProperties[i].queueFlags & VK_QUEUE_COMPUTE_BIT) != 0) {
+            queueFamilyIndex = i;
+            break;
+        }
+    }
+    if (queueFamilyIndex == UINT32_MAX) {
+        return "no compute queue";
+    }
+
+    float queuePriority = 1.0f;
+    VkDeviceQueueCreateInfo queueCreateInfo{};
+    queueCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+    queueCreateInfo.queueFamilyIndex = queueFamilyIndex;
+    queueCreateInfo.queueCount = 1;
+    queueCreateInfo.pQueuePriorities = &queuePriority;
+    VkDeviceGroupDeviceCreateInfo deviceGroupDeviceCreateInfo{};
+    deviceGroupDeviceCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_GROUP_DEVICE_CREATE_INFO;
+    deviceGroupDeviceCreateInfo.pNext = &features2;
+    deviceGroupDeviceCreateInfo.physicalDeviceCount = group.physicalDeviceCount;
+    deviceGroupDeviceCreateInfo.pPhysicalDevices = group.physicalDevices;
+    const char* extensionName = VK_KHR_COOPERATIVE_MATRIX_EXTENSION_NAME;
+    VkDeviceCreateInfo deviceCreateInfo{};
+    deviceCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+    deviceCreateInfo.pNext = &deviceGroupDeviceCreateInfo;
+    deviceCreateInfo.queueCreateInfoCount = 1;
+    deviceCreateInfo.pQueueCreateInfos = &queueCreateInfo;
+    deviceCreateInfo.enabledExtensionCount = 1;
+    deviceCreateInfo.ppEnabledExtensionNames = &extensionName;
+    throwIfVkError(
+            vkCreateDevice(physicalDevice, &deviceCreateInfo, nullptr, &resources.device), "vkCreateDevice");
+    loadDeviceFunctions(resources.device);
+    VkQueue queue = VK_NULL_HANDLE;
+    vkGetDeviceQueue(resources.device, queueFamilyIndex, 0, &queue);
+    resources.numMembers = group.physicalDeviceCount;
+    vkGetPhysicalDeviceMemoryProperties(physicalDevice, &resources.memoryProperties);
+    resources.context = std::make_unique<CommandContext>(
+            physicalDevice, resources.device, queueFamilyIndex, queue);
+    resources.gemmPipeline = std::make_unique<ComputePipeline>(
+            resources.device, CoopMatGemm::getPipelineSettings(firstDevice, settings));
+    resources.addPipeline = createMatrixAddPipeline(resources.device);
+
+    // Device-local memory is allocated on all members, i.e., each member has its own instance.
+    const VkDeviceSize sizeA = VkDeviceSize(settings.M) * settings.K * getComponentTypeSize(settings.AType);
+    const VkDeviceSize sizeB = VkDeviceSize(settings.K) * settings.N * getComponentTypeSize(settings.BType);
+    const VkDeviceSize sizeC = VkDeviceSize(settings.M) * settings.N * getComponentTypeSize(settings.CType);
+    const VkDeviceSize sizeD = VkDeviceSize(settings.M) * settings.N * getComponentTypeSize(settings.ResultType);
+    BufferSettings bufferSettings{};
+    bufferSettings.usage =
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT
+            | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    bufferSettings.memoryProperties = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+    auto createBuffer = [&](VkDeviceSize size) {
+        bufferSettings.size = size;
+        return createDeviceBuffer(resources.device, resources.memoryProperties, bufferSettings);
+    };
+    resources.bufferA = createBuffer(sizeA);
+    resources.bufferB = createBuffer(sizeB);
+    resources.bufferC = createBuffer(sizeC);
+    resources.bufferD = createBuffer(sizeD);
+    resources.matrixA = createBuffer(sizeA);
+    resources.matrixB = createBuffer(sizeB);
+    resources.matrixD = createBuffer(sizeD);
+    resources.gatherBuffer = createBuffer((resources.numMembers - 1) * sizeD);
+
+    uint32_t heapIndex = resources.memoryProperties.memoryTypes[resources.bufferA.memoryTypeIndex].heapIndex;
+    for (uint32_t memberIdx = 1; memberIdx < resources.numMembers; memberIdx++) {
+        for (auto localAndRemote : { std::make_pair(memberIdx, 0u), std::make_pair(0u, memberIdx) }) {
+            VkPeerMemoryFeatureFlags peerMemoryFeatures = 0;
+            vkGetDeviceGroupPeerMemoryFeatures(
+                    resources.device, heapIndex, localAndRemote.first, localAndRemote.second, &peerMemoryFeatures);
+            if ((peerMemoryFeatures & VK_PEER_MEMORY_FEATURE_COPY_SRC_BIT) == 0) {
+                return "no peer copy";
+            }
+        }
+    }
+    std::vector<uint32_t> deviceIndices(resources.numMembers, 0);
+    resources.peerBufferA = createPeerBuffer(resources.device, resources.matrixA, deviceIndices);
+    resources.peerBufferB = createPeerBuffer(resources.device, resources.matrixB, deviceIndices);
+    for (uint32_t memberIdx = 1; memberIdx < resources.numMembers; memberIdx++) {
+        std::iota(deviceIndices.begin(), deviceIndices.end(), 0u);
+        deviceIndices.at(0) = memberIdx;
+        resources.peerBuffersD.push_back(createPeerBuffer(resources.device, resources.bufferD, deviceIndices));
+    }
+
+    VkCommandBuffer commandBuffer = resources.context->begin();
+    vkCmdFillBuffer(commandBuffer, resources.bufferA.buffer, 0, VK_WHOLE_SIZE, 0x3C003C00u);
+    vkCmdFillBuffer(commandBuffer, resources.bufferB.buffer, 0, VK_WHOLE_SIZE, 0x3C003C00u);
+    vkCmdFillBuffer(commandBuffer, resources.bufferC.buffer, 0, VK_WHOLE_SIZE, 0u);
+    resources.context->submitAndWait();
+    return "";
+}
+
+/// Runs the recorded commands on the members in the device mask and returns the wall clock time in milliseconds.
+static double runOnMembers(
+        DeviceGroupResources& resources, uint32_t deviceMask,
+        const std::function<void(VkCommandBuffer)>& recordCommands) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+    resources.context->setDeviceMask(deviceMask);
+    recordCommands(resources.context->begin());
+    resources.context->submitAndWait();
+    double elapsedMs = getElapsedMs(startTime);
+    resources.context->setDeviceMask(0);
+    return elapsedMs;
+}
+
+/**
+ * Uploads the host data to or downloads it from the instance of the buffer on the first member (the other pointer is
+ * nullptr) through a temporary staging buffer.
+ */
+static void transferFirstMemberBuffer(
+        DeviceGroupResources& resources, const DeviceBuffer& buffer, const void* uploadData, void* downloadData) {
+    BufferSettings stagingSettings{};
+    stagingSettings.size = buffer.size;
+    stagingSettings.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    stagingSettings.memoryProperties = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+    DeviceBuffer stagingBuffer = createDeviceBuffer(resources.device, resources.memoryProperties, stagingSettings);
+    try {
+        VkBufferCopy region{ 0, 0, buffer.size };
+        if (uploadData) {
+            memcpy(stagingBuffer.mappedData, uploadData, size_t(buffer.size));
+        }
+        runOnMembers(resources, 1u, [&](VkCommandBuffer commandBuffer) {
+            if (uploadData) {
+                vkCmdCopyBuffer(commandBuffer, stagingBuffer.buffer, buffer.buffer, 1, &region);
+            } else {
+                vkCmdCopyBuffer(commandBuffer, buffer.buffer, stagingBuffer.buffer, 1, &region);
+                insertHostReadBarrier(commandBuffer);
+            }
+        });
+        if (downloadData) {
+            memcpy(downloadData, stagingBuffer.mappedData, size_t(buffer.size));
+        }
+    } catch (...) {
+        destroyDeviceBuffer(resources.device, stagingBuffer);
+        throw;
+    }
+    destroyDeviceBuffer(resources.device, stagingBuffer);
+}
+
+static void recordGroupGemmIterations(
+        VkCommandBuffer commandBuffer, const DeviceGroupResources& resources, const CoopMatGemmSettings& settings) {
+    for (uint32_t i = 0; i < NUM_GEMM_ITERATIONS; i++) {
+        if (i != 0) {
+            insertMemoryBarrier(commandBuffer);
+        }
+        CoopMatGemm::recordDispatch(
+                commandBuffer, *resources.gemmPipeline, settings, resources.bufferA.deviceAddress,
+                resources.bufferB.deviceAddress, resources.bufferC.deviceAddress, resources.bufferD.deviceAddress);
+    }
+}
+
+static double measureGroupComputeMs(
+        DeviceGroupResources& resources, uint32_t deviceMask, const CoopMatGemmSettings& settings) {
+    return runBenchmark([&]() {
+        return runOnMembers(resources, deviceMask, [&](VkCommandBuffer commandBuffer) {
+            recordGroupGemmIterations(commandBuffer, resources, settings);
+        }) / double(NUM_GEMM_ITERATIONS);
+    }).median;
+}
+
+/// Measures the phases of the split and checks the gathered result against the reference of the full GEMM.
+static SplitResult measureDeviceGroupSplit(
+        DeviceGroupResources& resources, const CoopMatGemmSettings& settings, SplitStrategy strategy,
+        const std::vector<GemmPartition>& partitions, const std::vector<uint8_t>& referenceD) {
+    const uint32_t numMembers = resources.numMembers;
+    const uint32_t allMembersMask = (1u << numMembers) - 1u;
+    const VkDeviceSize partialSize = resources.gatherBuffer.size / (numMembers - 1);
+    std::vector<std::vector<VkBufferCopy>> regionsA(numMembers), regionsB(numMembers), regionsD(numMembers);
+    for (uint32_t memberIdx = 0; memberIdx < numMembers; memberIdx++) {
+        const GemmPartition& partition = partitions.at(memberIdx);
+        regionsA.at(memberIdx) = getBlockCopyRegions(settings, partition, GemmMatrix::A, 0, true);
+        regionsB.at(memberIdx) = getBlockCopyRegions(settings, partition, GemmMatrix::B, 0, true);
+        regionsD.at(memberIdx) = getBlockCopyRegions(settings, partition, GemmMatrix::D, 0, false);
+    }
+    // Blocks missing in the gathered result are NaN.
+    runOnMembers(resources, 1u, [&](VkCommandBuffer commandBuffer) {
+        vkCmdFillBuffer(commandBuffer, resources.matrixD.buffer, 0, VK_WHOLE_SIZE, 0xFFFFFFFFu);
+    });
+
+    SplitResult result;
+    result.partitions = getPartitionsString(strategy, partitions);
+    result.scatterMs = runBenchmark([&]() {
+        return runOnMembers(resources, allMembersMask, [&](VkCommandBuffer commandBuffer) {
+            for (uint32_t memberIdx = 0; memberIdx < numMembers; memberIdx++) {
+                vkCmdSetDeviceMask(commandBuffer, 1u << memberIdx);
+                copyBufferRegions(
+                        commandBuffer, resources.peerBufferA, resources.bufferA.buffer, regionsA.at(memberIdx));
+                copyBufferRegions(
+                        commandBuffer, resources.peerBufferB, resources.bufferB.buffer, regionsB.at(memberIdx));
+            }
+        });
+    }).median;
+    result.computeMs = runBenchmark([&]() {
+        return runOnMembers(resources, allMembersMask, [&](VkCommandBuffer commandBuffer) {
+            for (uint32_t memberIdx = 0; memberIdx < numMembers; memberIdx++) {
+                vkCmdSetDeviceMask(commandBuffer, 1u << memberIdx);
+                recordGroupGemmIterations(commandBuffer, resources, partitions.at(memberIdx).settings);
+            }
+        }) / double(NUM_GEMM_ITERATIONS);
+    }).median;
+    result.gatherMs = runBenchmark([&]() {
+        return runOnMembers(resources, 1u, [&](VkCommandBuffer commandBuffer) {
+            // The partial result of the first member of the K split is the starting point of the reduction.
+            copyBufferRegions(commandBuffer, resources.bufferD.buffer, resources.matrixD.buffer, regionsD.at(0));
+            for (uint32_t memberIdx = 1; memberIdx < numMembers; memberIdx++) {
+                VkBuffer peerBufferD = resources.peerBuffersD.at(memberIdx - 1);
+                if (strategy == SplitStrategy::K) {
+                    VkBufferCopy region{ 0, (memberIdx - 1) * partialSize, partialSize };
+                    vkCmdCopyBuffer(commandBuffer, peerBufferD, resources.gatherBuffer.buffer, 1, &region);
+                } else {
+                    copyBufferRegions(commandBuffer, peerBufferD, resources.matrixD.buffer, regionsD.at(memberIdx));
+                }
+            }
+            if (strategy == SplitStrategy::K) {
+                recordReduction(
+                        commandBuffer, *resources.addPipeline, resources.gatherBuffer.deviceAddress,
+                        resources.matrixD.deviceAddress, partialSize, numMembers - 1);
+            }
+        });
+    }).median;
+
+    std::vector<uint8_t> resultD(referenceD.size());
+    transferFirstMemberBuffer(resources, resources.matrixD, nullptr, resultD.data());
+    checkGatheredResult(resultD, referenceD, settings.ResultType);
+    return result;
+}
+
+/// Adds the row of one split strategy; the efficiencies are relative to the sum of the single-device throughputs.
+static void addSplitRow(
+        ResultTable& table, SplitStrategy strategy, const SplitResult& result, double numOperations,
+        double firstDeviceMs, double singleTeraOpsSum) {
+    const double totalMs = result.scatterMs + result.computeMs + result.gatherMs;
+    const double computeTeraOps = numOperations / (result.computeMs * 1e9);
+    const double totalTeraOps = numOperations / (totalMs * 1e9);
+    table.addRow({
+            getSplitStrategyName(strategy), result.partitions, formatNumber(result.scatterMs),
+            formatNumber(result.computeMs), formatNumber(result.gatherMs), formatNumber(totalMs),
+            formatNumber(totalTeraOps), formatNumber(firstDeviceMs / totalMs) + "x",
+            formatNumber(computeTeraOps / singleTeraOpsSum * 100.0, 1) + "%",
+            formatNumber(totalTeraOps / singleTeraOpsSum * 100.0, 1) + "%" });
+}
+
+static const std::vector<std::string> SPLIT_TABLE_COLUMNS = {
+        "Split", "Partitions", "Scatter ms", "Compute ms", "Gather/reduce ms", "Total ms", "TFLOP/s",
+        "Speedup", "Compute eff.", "Total eff." };
+
+static void runHostCoordinatedSplits(
+        const std::vector<sgl::vk::Device*>& devices, const CoopMatGemmSettings& settings,
+        const std::vector<uint8_t>& dataA, const std::vector<uint8_t>& dataB, std::vector<double>& singleDeviceMs) {
+    const size_t numDevices = devices.size();
+    const double numOperations = 2.0 * double(settings.M) * double(settings.N) * double(settings.K);
+    std::vector<GemmDeviceResources> resources(numDevices);
+    try {
+        for (size_t i = 0; i < numDevices; i++) {
+            resources.at(i).device = devices.at(i);
+            createGemmDeviceResources(resources.at(i), settings, i == 0, numDevices);
+        }
+        ResultTable singleTable({ "Device", "Time ms", "TFLOP/s" });
+        for (size_t i = 0; i < numDevices; i++) {
+            GemmDeviceResources* deviceResources = &resources.at(i);
+            singleDeviceMs.at(i) = runBenchmark([&]() {
+                auto recordCommands = [&](GemmDeviceResources& device, VkCommandBuffer commandBuffer) {
+                    recordGemmIterations(commandBuffer, device, settings);
+                };
+                return runOnDevices({ deviceResources }, recordCommands) / double(NUM_GEMM_ITERATIONS);
+            }).median;
+            singleTable.addRow({
+                    "#" + std::to_string(i), formatNumber(singleDeviceMs.at(i)),
+                    formatNumber(numOperations / (singleDeviceMs.at(i) * 1e9)) });
+        }
+        writeOut("");
+        writeOut("Full GEMM on each device:");
+        singleTable.print();
+
+        // Reference for checking the gathered results: The full GEMM on the first device.
+        GemmDeviceResources& first = resources.front();
+        loadDeviceFunctions(first.device->getVkDevice());
+        uploadBufferData(first.device, *first.context, first.matrixA, dataA.data(), dataA.size());
+        uploadBufferData(first.device, *first.context, first.matrixB, dataB.data(), dataB.size());
+        runOnDevices({ &first }, [&](GemmDeviceResources& device, VkCommandBuffer commandBuffer) {
+            CoopMatGemm::recordDispatch(
+                    commandBuffer, *device.gemmPipeline, settings, device.matrixA.deviceAddress,
+                    device.matrixB.deviceAddress, device.bufferC.deviceAddress, device.matrixD.deviceAddress);
+        });
+        std::vector<uint8_t> referenceD(first.matrixD.size);
+        downloadBufferData(first.device, *first.context, first.matrixD, referenceD.data(), referenceD.size());
+
+        // The partitions are proportional to the throughputs, such that all devices finish at the same time.
+        std::vector<double> weights(numDevices);
+        double singleTeraOpsSum = 0.0;
+        for (size_t i = 0; i < numDevices; i++) {
+            weights.at(i) = 1.0 / singleDeviceMs.at(i);
+            singleTeraOpsSum += numOperations / (singleDeviceMs.at(i) * 1e9);
+        }
+        ResultTable table(SPLIT_TABLE_COLUMNS);
+        for (SplitStrategy strategy : SPLIT_STRATEGIES) {
+            try {
+                std::vector<GemmPartition> partitions = createPartitions(settings, strategy, weights);
+                SplitResult result = measureHostCoordinatedSplit(resources, settings, strategy, partitions, referenceD);
+                addSplitRow(table, strategy, result, numOperations, singleDeviceMs.front(), singleTeraOpsSum);
+            } catch (const std::exception& e) {
+                sgl::Logfile::get()->writeError(
+                        std::string() + "Error in runMultiGpuGemmBenchmark (" + getSplitStrategyName(strategy)
+                        + "): " + e.what(), false);
+                std::vector<std::string> row = { getSplitStrategyName(strategy) };
+                row.resize(SPLIT_TABLE_COLUMNS.size(), "failed");
+                table.addRow(row);
+            }
+        }
+        writeOut("");
+        writeOut("Host-coordinated (staging buffers + memcpy, partitions proportional to the throughputs):");
+        table.print();
+    } catch (const std::exception& e) {
+        sgl::Logfile::get()->writeError(std::string() + "Error in runMultiGpuGemmBenchmark: " + e.what(), false);
+    }
+    for (auto& deviceResources : resources) {
+        if (deviceResources.device) {
+            destroyGemmDeviceResources(deviceResources);
+        }
+    }
+}
+
+static void runDeviceGroupSplits(
+        const VkPhysicalDeviceGroupProperties& group, const std::vector<size_t>& memberDeviceIndices,
+        const std::vector<sgl::vk::Device*>& devices, const CoopMatGemmSettings& settings,
+        const std::vector<uint8_t>& dataA, const std::vector<uint8_t>& dataB) {
+    std::string title = "Device group (";
+    for (size_t memberIdx = 0; memberIdx < memberDeviceIndices.size(); memberIdx++) {
+        title += (memberIdx == 0 ? "#" : ", #") + std::to_string(memberDeviceIndices.at(memberIdx));
+    }
+    title += "; peer memory, equal partitions):";
+    writeOut("");
+    writeOut(title);
+
+    const double numOperations = 2.0 * double(settings.M) * double(settings.N) * double(settings.K);
+    DeviceGroupResources resources;
+    try {
+        std::string unsupportedReason = createDeviceGroupResources(
+                resources, group, devices.at(memberDeviceIndices.front()), settings);
+        if (!unsupportedReason.empty()) {
+            writeOut("Not usable: ", unsupportedReason, ".");
+            destroyDeviceGroupResources(resources);
+            return;
+        }
+        // Reference: The full GEMM on each member alone.
+        double singleTeraOpsSum = 0.0;
+        double firstMemberMs = 0.0;
+        for (uint32_t memberIdx = 0; memberIdx < resources.numMembers; memberIdx++) {
+            double memberMs = measureGroupComputeMs(resources, 1u << memberIdx, settings);
+            singleTeraOpsSum += numOperations / (memberMs * 1e9);
+            if (memberIdx == 0) {
+                firstMemberMs = memberMs;
+            }
+        }
+        // Reference for checking the gathered results: The full GEMM on the first member.
+        transferFirstMemberBuffer(resources, resources.matrixA, dataA.data(), nullptr);
+        transferFirstMemberBuffer(resources, resources.matrixB, dataB.data(), nullptr);
+        runOnMembers(resources, 1u, [&](VkCommandBuffer commandBuffer) {
+            CoopMatGemm::recordDispatch(
+                    commandBuffer, *resources.gemmPipeline, settings, resources.matrixA.deviceAddress,
+                    resources.matrixB.deviceAddress, resources.bufferC.deviceAddress, resources.matrixD.deviceAddress);
+        });
+        std::vector<uint8_t> referenceD(resources.matrixD.size);
+        transferFirstMemberBuffer(resources, resources.matrixD, nullptr, referenceD.data());
+        std::vector<double> weights(resources.numMembers, 1.0);
+        ResultTable table(SPLIT_TABLE_COLUMNS);
+        for (SplitStrategy strategy : SPLIT_STRATEGIES) {
+            try {
+                std::vector<GemmPartition> partitions = createPartitions(settings, strategy, weights);
+                SplitResult result = measureDeviceGroupSplit(resources, settings, strategy, partitions, referenceD);
+                addSplitRow(table, strategy, result, numOperations, firstMemberMs, singleTeraOpsSum);
+            } catch (const std::exception& e) {
+                sgl::Logfile::get()->writeError(
+                        std::string() + "Error in runMultiGpuGemmBenchmark (device group, "
+                        + getSplitStrategyName(strategy) + "): " + e.what(), false);
+                std::vector<std::string> row = { getSplitStrategyName(strategy) };
+                row.resize(SPLIT_TABLE_COLUMNS.size(), "failed");
+                table.addRow(row);
+            }
+        }
+        table.print();
+    } catch (const std::exception& e) {
+        sgl::Logfile::get()->writeError(
+                std::string() + "Error in runMultiGpuGemmBenchmark (device group): " + e.what(), false);
+    }
+    destroyDeviceGroupResources(resources);
+}
+
+void runMultiGpuGemmBenchmark(sgl::vk::Instance* instance, const std::vector<sgl::vk::Device*>& allDevices) {
+    CoopMatGemmSettings settings{};
+    settings.M = getReducedProblemSize(PROBLEM_SIZE, settings.lM * settings.tileM);
+    settings.N = getReducedProblemSize(PROBLEM_SIZE, settings.lN * settings.tileN);
+    settings.K = getReducedProblemSize(PROBLEM_SIZE, settings.lK);
+    const std::string variantName = CoopMatGemm::getVariantName(settings);
+    writeOut("");
+    writeOut("Multi-GPU GEMM benchmark (", settings.M, "x", settings.N, "x", settings.K, ", ", variantName,
+             ", inputs and result on the first device):");
+
+    // Devices without the kernel variant are left out; indices refer to the list of all devices.
+    std::vector<sgl::vk::Device*> devices;
+    std::vector<size_t> deviceIndices;
+    for (size_t i = 0; i < allDevices.size(); i++) {
+        loadDeviceFunctions(allDevices.at(i)->getVkDevice());
+        std::string unsupportedReason = CoopMatGemm::checkSupport(allDevices.at(i), settings);
+        writeOut("#", i, ": ", std::string(allDevices.at(i)->getDeviceName()),
+                 unsupportedReason.empty() ? std::string() : " (not used: " + unsupportedReason + ")");
+        if (unsupportedReason.empty()) {
+            devices.push_back(allDevices.at(i));
+            deviceIndices.push_back(i);
+        }
+    }
+    if (devices.size() < 2) {
+        writeOut("At least two devices supporting the ", variantName, " kernel are necessary for splitting a GEMM.");
+        return;
+    }
+
+    const std::vector<uint8_t> dataA = createIntegerElements(settings.AType, size_t(settings.M) * settings.K, 1);
+    const std::vector<uint8_t> dataB = createIntegerElements(settings.BType, size_t(settings.K) * settings.N, 2);
+    std::vector<double> singleDeviceMs(devices.size());
+    runHostCoordinatedSplits(devices, settings, dataA, dataB, singleDeviceMs);
+
+    try {
+        VkInstance vkInstance = instance->getVkInstance();
+        uint32_t groupCount = 0;
+        throwIfVkError(
+                vkEnumeratePhysicalDeviceGroups(vkInstance, &groupCount, nullptr), "vkEnumeratePhysicalDeviceGroups");
+        std::vector<VkPhysicalDeviceGroupProperties> groups(groupCount);
+        for (auto& group : groups) {
+            group.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GROUP_PROPERTIES;
+        }
+        throwIfVkError(
+                vkEnumeratePhysicalDeviceGroups(vkInstance, &groupCount, groups.data()),
+                "vkEnumeratePhysicalDeviceGroups");
+        bool hasDeviceGroup = false;
+        for (const auto& group : groups) {
+            if (group.physicalDeviceCount < 2) {
+                continue;
+            }
+            // All members need to be among the used devices.
+            std::vector<size_t> memberDeviceIndices;
+            for (uint32_t memberIdx = 0; memberIdx < group.physicalDeviceCount; memberIdx++) {
+                for (size_t i = 0; i < devices.size(); i++) {
+                    if (devices.at(i)->getVkPhysicalDevice() == group.physicalDevices[memberIdx]) {
+                        memberDeviceIndices.push_back(deviceIndices.at(i));
+                    }
+                }
+            }
+            if (memberDeviceIndices.size() == group.physicalDeviceCount) {
+                hasDeviceGroup = true;
+                runDeviceGroupSplits(group, memberDeviceIndices, allDevices, settings, dataA, dataB);
+            }
+        }
+        if (!hasDeviceGroup) {
+            writeOut("");
+            writeOut("vkEnumeratePhysicalDeviceGroups reports no group of two or more of the devices.");
+        }
+    } catch (const std::exception& e) {
+        sgl::Logfile::get()->writeError(
+                std::string() + "Error in runMultiGpuGemmBenchmark (device groups): " + e.what(), false);
+    }
+}
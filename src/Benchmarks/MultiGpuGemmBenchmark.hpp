@@ -0,0 +1,49 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef QUERYVKCOOPMAT_MULTIGPUGEMMBENCHMARK_HPP
+#define QUERYVKCOOPMAT_MULTIGPUGEMMBENCHMARK_HPP
+
+#include <vector>
+
+namespace sgl { namespace vk {
+class Instance;
+class Device;
+}}
+
+/**
+ * Splits one fp16 GEMM with inputs and result on the first device across all passed devices by rows (M), columns (N)
+ * or the reduction dimension (K, followed by a reduction on the first device). The blocks of the inputs are scattered
+ * from and the result blocks gathered to the first device, either host-coordinated via staging buffers or, for device
+ * groups reported by vkEnumeratePhysicalDeviceGroups, via peer memory copies. Splits whose gathered result differs
+ * from the single-device result are reported as failed. Reports the time of each phase, the speedup over the first
+ * device alone and the scaling efficiency against the sum of the single-device throughputs.
+ */
+void runMultiGpuGemmBenchmark(sgl::vk::Instance* instance, const std::vector<sgl::vk::Device*>& devices);
+
+#endif //QUERYVKCOOPMAT_MULTIGPUGEMMBENCHMARK_HPP
@@ -0,0 +1,464 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <Utils/File/Logfile.hpp>
+#include <Graphics/Vulkan/libs/volk/volk.h>
+#include <Graphics/Vulkan/Utils/Device.hpp>
+
+#include "PrintUtils.hpp"
+#include "VulkanUtils.hpp"
+#include "NumaTransferBenchmark.hpp"
+
+static const VkDeviceSize TRANSFER_SIZE = VkDeviceSize(64) * 1024 * 1024;
+
+#ifdef __linux__
+
+static const uint32_t NUM_ITERATIONS = 10;
+/// Nodes within this fraction of the bandwidth of the best node are considered equivalent.
+static const double EQUIVALENT_BANDWIDTH_FRACTION = 0.05;
+static const int NUM_PAGE_SAMPLES = 64;
+
+// Memory policy constants from <numaif.h>, which is part of libnuma and may not be installed.
+static const int NUMA_MPOL_DEFAULT = 0;
+static const int NUMA_MPOL_BIND = 2;
+static const unsigned NUMA_MPOL_MF_STRICT = 1u << 0;
+static const unsigned NUMA_MPOL_MF_MOVE = 1u << 1;
+static const unsigned long NUMA_MAX_NODES = 1024;
+
+struct NumaNode {
+    int index = 0;
+    std::string cpuList; ///< In the list format of sysfs, e.g., "0-15,32-47"; empty for memory-only nodes.
+    std::vector<int> cpus;
+};
+
+struct DevicePciInfo {
+    std::string address; ///< Empty if VK_EXT_pci_bus_info is not supported.
+    int numaNode = -1; ///< -1 if the platform does not report a node.
+    std::string localCpuList;
+};
+
+struct NumaTransferResult {
+    bool isValid = false;
+    std::string pageNodes; ///< Node(s) the pages of the host memory were found on.
+    double uploadGiBs = 0.0, downloadGiBs = 0.0;
+    std::string note; ///< The reason why the memory kind is not available.
+};
+
+static bool readFirstLine(const std::string& filePath, std::string& line) {
+    std::ifstream file(filePath);
+    if (!file.is_open() || !std::getline(file, line)) {
+        return false;
+    }
+    while (!line.empty() && std::isspace(static_cast<unsigned char>(line.back()))) {
+        line.pop_back();
+    }
+    return true;
+}
+
+/// Parses the list format of sysfs, e.g., "0-3,8,10-11".
+static std::vector<int> parseSysfsList(const std::string& list) {
+    std::vector<int> values;
+    size_t pos = 0;
+    while (pos < list.size()) {
+        size_t end = list.find(',', pos);
+        if (end == std::string::npos) {
+            end = list.size();
+        }
+        std::string range = list.substr(pos, end - pos);
+        if (!range.empty()) {
+            size_t dashPos = range.find('-');
+            int first = std::stoi(range.substr(0, dashPos));
+            int last = dashPos == std::string::npos ? first : std::stoi(range.substr(dashPos + 1));
+            for (int value = first; value <= last; value++) {
+                values.push_back(value);
+            }
+        }
+        pos = end + 1;
+    }
+    return values;
+}
+
+static std::vector<NumaNode> queryNumaNodes() {
+    std::vector<NumaNode> nodes;
+    std::string onlineNodes;
+    if (!readFirstLine("/sys/devices/system/node/online", onlineNodes)) {
+        return nodes;
+    }
+    for (int nodeIdx : parseSysfsList(onlineNodes)) {
+        NumaNode node;
+        node.index = nodeIdx;
+        readFirstLine("/sys/devices/system/node/node" + std::to_string(nodeIdx) + "/cpulist", node.cpuList);
+        node.cpus = parseSysfsList(node.cpuList);
+        nodes.push_back(node);
+    }
+    return nodes;
+}
+
+static DevicePciInfo queryDevicePciInfo(sgl::vk::Device* device) {
+    DevicePciInfo info;
+    if (!device->isDeviceExtensionSupported(VK_EXT_PCI_BUS_INFO_EXTENSION_NAME)) {
+        return info;
+    }
+    VkPhysicalDevicePCIBusInfoPropertiesEXT pciBusInfoProperties{};
+    pciBusInfoProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PCI_BUS_INFO_PROPERTIES_EXT;
+    VkPhysicalDeviceProperties2 properties2{};
+    properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+    properties2.pNext = &pciBusInfoProperties;
+    vkGetPhysicalDeviceProperties2(device->getVkPhysicalDevice(), &properties2);
+    char address[32];
+    snprintf(
+            address, sizeof(address), "%04x:%02x:%02x.%x", pciBusInfoProperties.pciDomain,
+            pciBusInfoProperties.pciBus, pciBusInfoProperties.pciDevice, pciBusInfoProperties.pciFunction);
+    info.address = address;
+    const std::string sysfsPath = "/sys/bus/pci/devices/" + info.address;
+    std::string numaNode;
+    if (readFirstLine(sysfsPath + "/numa_node", numaNode) && !numaNode.empty()) {
+        info.numaNode = std::stoi(numaNode);
+    }
+    readFirstLine(sysfsPath + "/local_cpulist", info.localCpuList);
+    return info;
+}
+
+static std::vector<unsigned long> getNodeMask(int node) {
+    const size_t bitsPerWord = 8 * sizeof(unsigned long);
+    std::vector<unsigned long> nodeMask(NUMA_MAX_NODES / bitsPerWord, 0);
+    nodeMask.at(size_t(node) / bitsPerWord) |= 1ul << (size_t(node) % bitsPerWord);
+    return nodeMask;
+}
+
+/// Sets the memory policy of the calling thread; MPOL_DEFAULT restores the default (local) allocation.
+static void setMemoryPolicy(int mode, int node) {
+    std::vector<unsigned long> nodeMask;
+    if (mode != NUMA_MPOL_DEFAULT) {
+        nodeMask = getNodeMask(node);
+    }
+    // The kernel expects the number of bits of the node mask plus one.
+    if (syscall(
+            SYS_set_mempolicy, mode, nodeMask.empty() ? nullptr : nodeMask.data(),
+            nodeMask.empty() ? 0ul : NUMA_MAX_NODES + 1) != 0) {
+        throw std::runtime_error(std::string() + "set_mempolicy failed: " + strerror(errno));
+    }
+}
+
+static void pinThreadToCpus(const std::vector<int>& cpus, const cpu_set_t& fallbackCpuSet) {
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    for (int cpu : cpus) {
+        if (cpu >= 0 && cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &cpuSet);
+        }
+    }
+    // Memory-only nodes have no CPUs of their own.
+    if (sched_setaffinity(0, sizeof(cpu_set_t), CPU_COUNT(&cpuSet) > 0 ? &cpuSet : &fallbackCpuSet) != 0) {
+        throw std::runtime_error(std::string() + "sched_setaffinity failed: " + strerror(errno));
+    }
+}
+
+/// Returns the node the sampled pages are located on, "mixed" or "unknown" (e.g., for driver mappings without pages).
+static std::string getPageNodesString(void* data, size_t size) {
+    const size_t pageSize = size_t(sysconf(_SC_PAGESIZE));
+    const size_t numPages = size / pageSize;
+    const size_t numSamples = std::min(numPages, size_t(NUM_PAGE_SAMPLES));
+    std::vector<void*> pages(numSamples);
+    std::vector<int> status(numSamples, -1);
+    for (size_t i = 0; i < numSamples; i++) {
+        pages.at(i) = static_cast<uint8_t*>(data) + (i * numPages / numSamples) * pageSize;
+    }
+    // Without target nodes, move_pages only queries the current location of the pages.
+    if (numSamples == 0 || syscall(
+            SYS_move_pages, 0, numSamples, pages.data(), nullptr, status.data(), 0) != 0) {
+        return "unknown";
+    }
+    for (int node : status) {
+        if (node < 0) {
+            return "unknown";
+        }
+        if (node != status.front()) {
+            return "mixed";
+        }
+    }
+    return std::to_string(status.front());
+}
+
+static void measureTransfers(
+        CommandContext& context, VkBuffer hostBuffer, VkBuffer localBuffer, NumaTransferResult& result) {
+    VkBufferCopy bufferCopy{ 0, 0, TRANSFER_SIZE };
+    double uploadMs = measureCommandsMs(context, [&](VkCommandBuffer commandBuffer) {
+        vkCmdCopyBuffer(commandBuffer, hostBuffer, localBuffer, 1, &bufferCopy);
+    }, NUM_ITERATIONS);
+    double downloadMs = measureCommandsMs(context, [&](VkCommandBuffer commandBuffer) {
+        vkCmdCopyBuffer(commandBuffer, localBuffer, hostBuffer, 1, &bufferCopy);
+    }, NUM_ITERATIONS);
+    result.isValid = true;
+    result.uploadGiBs = computeGiBPerSecond(double(TRANSFER_SIZE), uploadMs);
+    result.downloadGiBs = computeGiBPerSecond(double(TRANSFER_SIZE), downloadMs);
+}
+
+/// Host memory bound to the node with mbind and imported with VK_EXT_external_memory_host.
+static NumaTransferResult measureImportedHostMemory(
+        sgl::vk::Device* device, CommandContext& context, const DeviceBuffer& localBuffer, int node) {
+    NumaTransferResult result;
+    if (!device->isDeviceExtensionSupported(VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME)) {
+        result.note = "no host import";
+        return result;
+    }
+    const VkExternalMemoryHandleTypeFlagBits handleType = VK_EXTERNAL_MEMORY_HANDLE_TYPE_HOST_ALLOCATION_BIT_EXT;
+    const size_t alignment = std::max(
+            size_t(device->getMinImportedHostPointerAlignment()), size_t(sysconf(_SC_PAGESIZE)));
+    const size_t size = (size_t(TRANSFER_SIZE) + alignment - 1) / alignment * alignment;
+    const size_t mappingSize = size + alignment;
+    void* mapping = mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error(std::string() + "mmap failed: " + strerror(errno));
+    }
+    void* hostPointer = reinterpret_cast<void*>(
+            (reinterpret_cast<uintptr_t>(mapping) + alignment - 1) / alignment * alignment);
+
+    VkDevice vkDevice = device->getVkDevice();
+    DeviceBuffer hostBuffer{};
+    try {
+        std::vector<unsigned long> nodeMask = getNodeMask(node);
+        if (syscall(
+                SYS_mbind, hostPointer, size, NUMA_MPOL_BIND, nodeMask.data(), NUMA_MAX_NODES + 1,
+                NUMA_MPOL_MF_STRICT | NUMA_MPOL_MF_MOVE) != 0) {
+            throw std::runtime_error(std::string() + "mbind failed: " + strerror(errno));
+        }
+        // The pages are allocated on first touch.
+        memset(hostPointer, 0, size);
+        result.pageNodes = getPageNodesString(hostPointer, size);
+
+        VkMemoryHostPointerPropertiesEXT memoryHostPointerProperties{};
+        memoryHostPointerProperties.sType = VK_STRUCTURE_TYPE_MEMORY_HOST_POINTER_PROPERTIES_EXT;
+        if (vkGetMemoryHostPointerPropertiesEXT(vkDevice, handleType, hostPointer, &memoryHostPointerProperties)
+                    != VK_SUCCESS || memoryHostPointerProperties.memoryTypeBits == 0) {
+            result.note = "not importable";
+        } else {
+            VkExternalMemoryBufferCreateInfo externalMemoryBufferCreateInfo{};
+            externalMemoryBufferCreateInfo.sType = VK_STRUCTURE_TYPE_EXTERNAL_MEMORY_BUFFER_CREATE_INFO;
+            externalMemoryBufferCreateInfo.handleTypes = handleType;
+            VkImportMemoryHostPointerInfoEXT importMemoryHostPointerInfo{};
+            importMemoryHostPointerInfo.sType = VK_STRUCTURE_TYPE_IMPORT_MEMORY_HOST_POINTER_INFO_EXT;
+            importMemoryHostPointerInfo.handleType = handleType;
+            importMemoryHostPointerInfo.pHostPointer = hostPointer;
+            BufferSettings bufferSettings{};
+            bufferSettings.size = size;
+            bufferSettings.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+            bufferSettings.memoryTypeBitsMask = memoryHostPointerProperties.memoryTypeBits;
+            bufferSettings.bufferCreateInfoNext = &externalMemoryBufferCreateInfo;
+            bufferSettings.memoryAllocateInfoNext = &importMemoryHostPointerInfo;
+            hostBuffer = createDeviceBuffer(vkDevice, device->getMemoryProperties(), bufferSettings);
+            measureTransfers(context, hostBuffer.buffer, localBuffer.buffer, result);
+        }
+    } catch (const std::exception&) {
+        destroyDeviceBuffer(vkDevice, hostBuffer);
+        munmap(mapping, mappingSize);
+        throw;
+    }
+    // The imported memory needs to be freed before the pages are unmapped.
+    destroyDeviceBuffer(vkDevice, hostBuffer);
+    munmap(mapping, mappingSize);
+    return result;
+}
+
+/// Host-visible memory allocated by the driver while the memory policy of the thread is bound to the node.
+static NumaTransferResult measureDriverHostMemory(
+        sgl::vk::Device* device, CommandContext& context, const DeviceBuffer& localBuffer, int node) {
+    NumaTransferResult result;
+    const VkBufferUsageFlags usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    DeviceBuffer hostBuffer{};
+    setMemoryPolicy(NUMA_MPOL_BIND, node);
+    try {
+        // Cached memory types are always system memory, while other host-visible types may be BAR memory.
+        try {
+            hostBuffer = createDeviceBuffer(
+                    device, TRANSFER_SIZE, usage,
+                    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+                    | VK_MEMORY_PROPERTY_HOST_CACHED_BIT);
+        } catch (const std::exception&) {
+            hostBuffer = createDeviceBuffer(
+                    device, TRANSFER_SIZE, usage,
+                    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+        }
+        // Drivers that allocate the pages lazily do so on first touch.
+        memset(hostBuffer.mappedData, 0, size_t(TRANSFER_SIZE));
+        result.pageNodes = getPageNodesString(hostBuffer.mappedData, size_t(TRANSFER_SIZE));
+        setMemoryPolicy(NUMA_MPOL_DEFAULT, 0);
+        measureTransfers(context, hostBuffer.buffer, localBuffer.buffer, result);
+    } catch (const std::exception&) {
+        setMemoryPolicy(NUMA_MPOL_DEFAULT, 0);
+        destroyDeviceBuffer(device->getVkDevice(), hostBuffer);
+        throw;
+    }
+    destroyDeviceBuffer(device->getVkDevice(), hostBuffer);
+    return result;
+}
+
+static void addTransferRow(
+        ResultTable& table, const NumaNode& node, const std::string& memoryKind, const NumaTransferResult& result) {
+    const std::string cpuList = node.cpuList.empty() ? "none" : node.cpuList;
+    if (!result.isValid) {
+        table.addRow({ std::to_string(node.index), cpuList, memoryKind, "-", result.note, result.note });
+        return;
+    }
+    table.addRow({
+            std::to_string(node.index), cpuList, memoryKind, result.pageNodes, formatNumber(result.uploadGiBs),
+            formatNumber(result.downloadGiBs) });
+}
+
+static void printAffinityRecommendation(
+        const std::vector<NumaNode>& nodes, const std::vector<double>& nodeBandwidths, const DevicePciInfo& pciInfo) {
+    size_t bestIdx = 0, worstIdx = 0;
+    for (size_t i = 0; i < nodes.size(); i++) {
+        if (nodeBandwidths.at(i) > nodeBandwidths.at(bestIdx)) {
+            bestIdx = i;
+        }
+        if (nodeBandwidths.at(i) < nodeBandwidths.at(worstIdx)) {
+            worstIdx = i;
+        }
+    }
+    const NumaNode& bestNode = nodes.at(bestIdx);
+    const double bestBandwidth = nodeBandwidths.at(bestIdx);
+    if (bestBandwidth <= 0.0) {
+        writeOut("No affinity recommendation, as no transfer could be measured.");
+        return;
+    }
+    if (nodes.size() == 1) {
+        writeOut("Single NUMA node; no pinning necessary.");
+        return;
+    }
+    if (nodeBandwidths.at(worstIdx) >= (1.0 - EQUIVALENT_BANDWIDTH_FRACTION) * bestBandwidth) {
+        writeOut("All NUMA nodes reach the same bandwidth within ",
+                 formatNumber(EQUIVALENT_BANDWIDTH_FRACTION * 100.0, 0), "%; pinning is not necessary for transfers.");
+        return;
+    }
+    std::string recommendation =
+            "Affinity recommendation: numactl --cpunodebind=" + std::to_string(bestNode.index) + " --membind="
+            + std::to_string(bestNode.index);
+    if (!bestNode.cpuList.empty()) {
+        recommendation += " (or taskset -c " + bestNode.cpuList + ")";
+    }
+    writeOut(recommendation);
+    writeOut("Mean of upload and download: ", formatNumber(bestBandwidth), " GiB/s on node ", bestNode.index,
+             " vs. ", formatNumber(nodeBandwidths.at(worstIdx)), " GiB/s on node ", nodes.at(worstIdx).index, ".");
+    if (pciInfo.numaNode >= 0 && pciInfo.numaNode != bestNode.index) {
+        writeOut("Note: sysfs reports node ", pciInfo.numaNode, " for the device, but node ", bestNode.index,
+                 " was measured to be faster.");
+    }
+}
+
+#endif
+
+void runNumaTransferBenchmark(sgl::vk::Device* device) {
+    writeOut("");
+    writeOut("NUMA host memory transfer benchmark (", TRANSFER_SIZE / (1024 * 1024), " MiB copies):");
+#ifdef __linux__
+    cpu_set_t originalCpuSet;
+    CPU_ZERO(&originalCpuSet);
+    if (sched_getaffinity(0, sizeof(cpu_set_t), &originalCpuSet) != 0) {
+        sgl::Logfile::get()->writeError(
+                std::string() + "Error in runNumaTransferBenchmark: sched_getaffinity failed: " + strerror(errno),
+                false);
+        return;
+    }
+
+    try {
+        DevicePciInfo pciInfo = queryDevicePciInfo(device);
+        if (pciInfo.address.empty()) {
+            writeOut("PCI address: unknown (no VK_EXT_pci_bus_info)");
+        } else {
+            writeOut("PCI address: ", pciInfo.address, ", NUMA node (sysfs): ",
+                     pciInfo.numaNode >= 0 ? std::to_string(pciInfo.numaNode) : std::string("not reported"),
+                     ", local CPUs: ", pciInfo.localCpuList.empty() ? std::string("unknown") : pciInfo.localCpuList);
+        }
+        std::vector<NumaNode> nodes = queryNumaNodes();
+        if (nodes.empty()) {
+            writeOut("No NUMA nodes found in /sys/devices/system/node.");
+            return;
+        }
+
+        auto context = std::make_unique<CommandContext>(device);
+        DeviceBuffer localBuffer = createDeviceBuffer(
+                device, TRANSFER_SIZE, VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        ResultTable table({ "Node", "CPUs", "Host memory", "Pages on", "Upload GiB/s", "Download GiB/s" });
+        std::vector<double> nodeBandwidths(nodes.size(), 0.0);
+        for (size_t nodeIdx = 0; nodeIdx < nodes.size(); nodeIdx++) {
+            const NumaNode& node = nodes.at(nodeIdx);
+            const std::pair<const char*, decltype(&measureImportedHostMemory)> memoryKinds[] = {
+                    { "Imported (mbind)", &measureImportedHostMemory },
+                    { "Driver allocation", &measureDriverHostMemory } };
+            for (const auto& memoryKind : memoryKinds) {
+                try {
+                    pinThreadToCpus(node.cpus, originalCpuSet);
+                    NumaTransferResult result = memoryKind.second(device, *context, localBuffer, node.index);
+                    addTransferRow(table, node, memoryKind.first, result);
+                    if (result.isValid) {
+                        nodeBandwidths.at(nodeIdx) = std::max(
+                                nodeBandwidths.at(nodeIdx), 0.5 * (result.uploadGiBs + result.downloadGiBs));
+                    }
+                } catch (const std::exception& e) {
+                    sgl::Logfile::get()->writeError(
+                            std::string() + "Error in runNumaTransferBenchmark (node " + std::to_string(node.index)
+                            + ", " + memoryKind.first + "): " + e.what(), false);
+                    table.addRow({
+                            std::to_string(node.index), node.cpuList.empty() ? "none" : node.cpuList,
+                            memoryKind.first, "failed", "failed", "failed" });
+                }
+            }
+        }
+        sched_setaffinity(0, sizeof(cpu_set_t), &originalCpuSet);
+        destroyDeviceBuffer(device->getVkDevice(), localBuffer);
+        context = {};
+        table.print();
+        printAffinityRecommendation(nodes, nodeBandwidths, pciInfo);
+    } catch (const std::exception& e) {
+        sgl::Logfile::get()->writeError(std::string() + "Error in runNumaTransferBenchmark: " + e.what(), false);
+    }
+    sched_setaffinity(0, sizeof(cpu_set_t), &originalCpuSet);
+#else
+    writeOut("Only available on Linux (sysfs, mbind and set_mempolicy).");
+#endif
+}
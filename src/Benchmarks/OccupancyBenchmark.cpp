@@ -0,0 +1,303 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <Utils/File/Logfile.hpp>
+#include <Graphics/Vulkan/libs/volk/volk.h>
+#include <Graphics/Vulkan/Utils/Device.hpp>
+
+#include "PrintUtils.hpp"
+#include "ComponentTypes.hpp"
+#include "VulkanUtils.hpp"
+#include "Kernels.hpp"
+#include "OccupancyModel.hpp"
+#include "OccupancyBenchmark.hpp"
+
+static const uint32_t NUM_CHASE_STEPS = 32768;
+/// A dispatch is considered to still run in a single wave while its time stays below this factor times the time of
+/// a single workgroup.
+static const double SINGLE_WAVE_TIME_FACTOR = 1.5;
+
+struct OccupancyPushConstants {
+    VkDeviceAddress outputBuffer;
+    VkDeviceAddress bufferA, bufferB, bufferD;
+};
+
+struct OccupancyMeasurementSettings {
+    uint32_t workgroupSize = 256;
+    uint32_t sharedMemorySize = 16;
+    const VkCooperativeMatrixFlexibleDimensionsPropertiesNV* workgroupScopeProperties = nullptr;
+};
+
+class OccupancyMeasurement {
+public:
+    OccupancyMeasurement(sgl::vk::Device* device, CommandContext& context, uint32_t maxNumWorkgroups);
+    ~OccupancyMeasurement();
+    /// Returns the largest number of workgroups that still runs in a single wave.
+    uint32_t measureConcurrentWorkgroups(const OccupancyMeasurementSettings& settings);
+
+private:
+    void destroyBuffers();
+    double measureDispatchMs(const ComputePipeline& pipeline, uint32_t numWorkgroups);
+
+    sgl::vk::Device* device;
+    CommandContext& context;
+    uint32_t maxNumWorkgroups;
+    DeviceBuffer outputBuffer, bufferA, bufferB, bufferD;
+    OccupancyPushConstants pushConstants{};
+};
+
+OccupancyMeasurement::OccupancyMeasurement(sgl::vk::Device* device, CommandContext& context, uint32_t maxNumWorkgroups)
+        : device(device), context(context), maxNumWorkgroups(maxNumWorkgroups) {
+    const VkBufferUsageFlags usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+    // The matrices of the workgroup scope variant are small, and their content does not matter.
+    const VkDeviceSize matrixBufferSize = 256 * 1024;
+    try {
+        outputBuffer = createDeviceBuffer(
+                device, VkDeviceSize(maxNumWorkgroups) * sizeof(uint32_t), usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        bufferA = createDeviceBuffer(device, matrixBufferSize, usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        bufferB = createDeviceBuffer(device, matrixBufferSize, usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        bufferD = createDeviceBuffer(device, matrixBufferSize, usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    } catch (...) {
+        destroyBuffers();
+        throw;
+    }
+    pushConstants.outputBuffer = outputBuffer.deviceAddress;
+    pushConstants.bufferA = bufferA.deviceAddress;
+    pushConstants.bufferB = bufferB.deviceAddress;
+    pushConstants.bufferD = bufferD.deviceAddress;
+}
+
+OccupancyMeasurement::~OccupancyMeasurement() {
+    destroyBuffers();
+}
+
+void OccupancyMeasurement::destroyBuffers() {
+    VkDevice vkDevice = device->getVkDevice();
+    destroyDeviceBuffer(vkDevice, outputBuffer);
+    destroyDeviceBuffer(vkDevice, bufferA);
+    destroyDeviceBuffer(vkDevice, bufferB);
+    destroyDeviceBuffer(vkDevice, bufferD);
+}
+
+double OccupancyMeasurement::measureDispatchMs(const ComputePipeline& pipeline, uint32_t numWorkgroups) {
+    return measureCommandsMs(context, [&](VkCommandBuffer commandBuffer) {
+        pipeline.bind(commandBuffer);
+        pipeline.pushConstants(commandBuffer, &pushConstants, sizeof(OccupancyPushConstants));
+        vkCmdDispatch(commandBuffer, numWorkgroups, 1, 1);
+    }, 3);
+}
+
+uint32_t OccupancyMeasurement::measureConcurrentWorkgroups(const OccupancyMeasurementSettings& settings) {
+    bool useWorkgroupScope = settings.workgroupScopeProperties != nullptr;
+    const EmbeddedKernel* kernel = findEmbeddedKernel("Occupancy", useWorkgroupScope ? "workgroup_scope" : "default");
+    if (!kernel) {
+        throw std::runtime_error("Occupancy kernel is not available.");
+    }
+    ComputePipelineSettings pipelineSettings{};
+    pipelineSettings.code = kernel->code;
+    pipelineSettings.codeSize = kernel->codeSize;
+    pipelineSettings.specializationConstants = {
+            settings.workgroupSize, std::max(settings.sharedMemorySize / 4u, 1u), NUM_CHASE_STEPS };
+    if (useWorkgroupScope) {
+        pipelineSettings.specializationConstants.push_back(settings.workgroupScopeProperties->MGranularity);
+        pipelineSettings.specializationConstants.push_back(settings.workgroupScopeProperties->NGranularity);
+        pipelineSettings.specializationConstants.push_back(settings.workgroupScopeProperties->KGranularity);
+    }
+    pipelineSettings.pushConstantSize = sizeof(OccupancyPushConstants);
+    ComputePipeline pipeline(device->getVkDevice(), pipelineSettings);
+
+    double singleWorkgroupTimeMs = measureDispatchMs(pipeline, 1);
+    auto getIsSingleWave = [&](uint32_t numWorkgroups) {
+        return measureDispatchMs(pipeline, numWorkgroups) < SINGLE_WAVE_TIME_FACTOR * singleWorkgroupTimeMs;
+    };
+    uint32_t lower = 1, upper = 2;
+    while (upper <= maxNumWorkgroups && getIsSingleWave(upper)) {
+        lower = upper;
+        upper *= 2;
+    }
+    if (upper > maxNumWorkgroups) {
+        return lower;
+    }
+    while (upper - lower > 1) {
+        uint32_t middle = lower + (upper - lower) / 2;
+        if (getIsSingleWave(middle)) {
+            lower = middle;
+        } else {
+            upper = middle;
+        }
+    }
+    return lower;
+}
+
+static std::string predictionToString(const OccupancyPrediction& prediction) {
+    if (!prediction.fits || prediction.workgroupsPerComputeUnit == 0) {
+        return "-";
+    }
+    return std::to_string(prediction.workgroupsPerComputeUnit);
+}
+
+static void printTileConfigurations(sgl::vk::Device* device, const ComputeUnitInfo& computeUnitInfo) {
+    uint32_t reservedSharedMemory =
+            device->getCooperativeMatrix2PropertiesNV().cooperativeMatrixWorkgroupScopeReservedSharedMemory;
+    writeOut("Predicted occupancy of workgroup scope tiles (double-buffered A and B tiles in shared memory, ",
+             sgl::getNiceMemoryString(reservedSharedMemory, 2), " reserved):");
+    ResultTable table({ "A", "B", "Invocations", "Tile M x N x K", "Shared memory", "WGs/unit", "Limiter" });
+    for (const auto& props : device->getSupportedCooperativeMatrixFlexibleDimensionsPropertiesNV()) {
+        if (props.scope != VK_SCOPE_WORKGROUP_KHR) {
+            continue;
+        }
+        for (uint32_t tileSize : { 64u, 128u, 256u }) {
+            uint32_t tileM = std::max(tileSize / props.MGranularity, 1u) * props.MGranularity;
+            uint32_t tileN = std::max(tileSize / props.NGranularity, 1u) * props.NGranularity;
+            uint32_t tileK = std::max(32u / props.KGranularity, 1u) * props.KGranularity;
+            OccupancyInput input{};
+            input.workgroupSize = props.workgroupInvocations;
+            input.usesWorkgroupScope = true;
+            input.sharedMemorySize = uint32_t(2 * (
+                    tileM * tileK * getComponentTypeSize(props.AType)
+                    + tileK * tileN * getComponentTypeSize(props.BType)));
+            OccupancyPrediction prediction = predictOccupancy(device, computeUnitInfo, input);
+            table.addRow({
+                    getComponentTypeString(props.AType), getComponentTypeString(props.BType),
+                    std::to_string(props.workgroupInvocations),
+                    std::to_string(tileM) + "x" + std::to_string(tileN) + "x" + std::to_string(tileK),
+                    sgl::getNiceMemoryString(prediction.sharedMemoryPerWorkgroup, 2),
+                    predictionToString(prediction), prediction.limiter });
+        }
+    }
+    if (table.empty()) {
+        writeOut("No workgroup scope cooperative matrix configurations are supported.");
+    }
+    table.print();
+}
+
+void runOccupancyBenchmark(sgl::vk::Device* device) {
+    writeOut("");
+    writeOut("Occupancy model and measured occupancy:");
+    const auto& limits = device->getLimits();
+    ComputeUnitInfo computeUnitInfo = queryComputeUnitInfo(device);
+    writeOut("Compute units: ", computeUnitInfo.numComputeUnits == 0 ? "unknown"
+            : std::to_string(computeUnitInfo.numComputeUnits), " (", computeUnitInfo.source, ")");
+    writeOut("Threads per compute unit: ", computeUnitInfo.maxThreadsPerComputeUnit == 0 ? "unknown"
+            : std::to_string(computeUnitInfo.maxThreadsPerComputeUnit));
+    writeOut("Shared memory per compute unit: ",
+             sgl::getNiceMemoryString(computeUnitInfo.sharedMemoryPerComputeUnit, 2),
+             computeUnitInfo.isSharedMemoryPerComputeUnitExact ? " (" + computeUnitInfo.architecture + ")"
+             : std::string(" (unknown architecture, assumed: maxComputeSharedMemorySize)"));
+
+    // Copied, as the measurement settings below point to it.
+    VkCooperativeMatrixFlexibleDimensionsPropertiesNV workgroupScopePropertiesF16{};
+    const VkCooperativeMatrixFlexibleDimensionsPropertiesNV* workgroupScopeProperties = nullptr;
+    if (device->getCooperativeMatrix2FeaturesNV().cooperativeMatrixWorkgroupScope) {
+        printTileConfigurations(device, computeUnitInfo);
+        for (const auto& props : device->getSupportedCooperativeMatrixFlexibleDimensionsPropertiesNV()) {
+            if (props.scope == VK_SCOPE_WORKGROUP_KHR && props.AType == VK_COMPONENT_TYPE_FLOAT16_KHR
+                    && props.BType == VK_COMPONENT_TYPE_FLOAT16_KHR && props.CType == VK_COMPONENT_TYPE_FLOAT32_KHR
+                    && props.ResultType == VK_COMPONENT_TYPE_FLOAT32_KHR) {
+                workgroupScopePropertiesF16 = props;
+                workgroupScopeProperties = &workgroupScopePropertiesF16;
+                break;
+            }
+        }
+    }
+
+    // Validation of the model: Shared memory sweep with 256 invocations, workgroup size sweep with minimal shared
+    // memory, and a shared memory sweep with a workgroup scope cooperative matrix kernel.
+    std::vector<OccupancyMeasurementSettings> measurements;
+    const uint32_t defaultWorkgroupSize = std::min(256u, limits.maxComputeWorkGroupInvocations);
+    const uint32_t maxSharedMemorySize = limits.maxComputeSharedMemorySize;
+    for (uint32_t divisor : { 0u, 16u, 8u, 4u, 3u, 2u, 1u }) {
+        OccupancyMeasurementSettings settings{};
+        settings.workgroupSize = defaultWorkgroupSize;
+        settings.sharedMemorySize = divisor == 0 ? 16u : maxSharedMemorySize / divisor / 16u * 16u;
+        measurements.push_back(settings);
+    }
+    for (uint32_t workgroupSize : { 64u, 1024u }) {
+        OccupancyMeasurementSettings settings{};
+        settings.workgroupSize = std::min(workgroupSize, limits.maxComputeWorkGroupInvocations);
+        measurements.push_back(settings);
+    }
+    if (workgroupScopeProperties) {
+        uint32_t reservedSharedMemory =
+                device->getCooperativeMatrix2PropertiesNV().cooperativeMatrixWorkgroupScopeReservedSharedMemory;
+        uint32_t availableSharedMemory = maxSharedMemorySize - std::min(reservedSharedMemory, maxSharedMemorySize);
+        for (uint32_t divisor : { 0u, 4u, 2u, 1u }) {
+            OccupancyMeasurementSettings settings{};
+            settings.workgroupSize = workgroupScopeProperties->workgroupInvocations;
+            settings.sharedMemorySize = divisor == 0 ? 16u : availableSharedMemory / divisor / 16u * 16u;
+            settings.workgroupScopeProperties = workgroupScopeProperties;
+            measurements.push_back(settings);
+        }
+    }
+
+    writeOut("Predicted vs. measured resident workgroups (per compute unit and in total):");
+    ResultTable table({
+            "Kernel", "Invocations", "Shared memory", "Predicted/unit", "Limiter", "Predicted total",
+            "Measured total", "Measured/unit" });
+    try {
+        CommandContext context(device);
+        OccupancyMeasurement occupancyMeasurement(
+                device, context, std::min(65535u, limits.maxComputeWorkGroupCount[0]));
+        for (const auto& settings : measurements) {
+            OccupancyInput input{};
+            input.workgroupSize = settings.workgroupSize;
+            input.sharedMemorySize = settings.sharedMemorySize;
+            input.usesWorkgroupScope = settings.workgroupScopeProperties != nullptr;
+            OccupancyPrediction prediction = predictOccupancy(device, computeUnitInfo, input);
+            std::vector<std::string> row = {
+                    input.usesWorkgroupScope ? "workgroup scope" : "default", std::to_string(input.workgroupSize),
+                    sgl::getNiceMemoryString(prediction.sharedMemoryPerWorkgroup, 2), predictionToString(prediction),
+                    prediction.limiter,
+                    prediction.totalWorkgroups == 0 ? "-" : std::to_string(prediction.totalWorkgroups) };
+            if (!prediction.fits) {
+                row.resize(8, "-");
+                table.addRow(row);
+                continue;
+            }
+            try {
+                uint32_t measuredTotal = occupancyMeasurement.measureConcurrentWorkgroups(settings);
+                row.push_back(std::to_string(measuredTotal));
+                row.push_back(computeUnitInfo.numComputeUnits == 0 ? "-" : formatNumber(
+                        double(measuredTotal) / double(computeUnitInfo.numComputeUnits), 1));
+            } catch (const std::exception& e) {
+                sgl::Logfile::get()->writeError(std::string() + "Error in runOccupancyBenchmark: " + e.what(), false);
+                row.resize(8, "failed");
+            }
+            table.addRow(row);
+        }
+    } catch (const std::exception& e) {
+        sgl::Logfile::get()->writeError(std::string() + "Error in runOccupancyBenchmark: " + e.what(), false);
+    }
+    table.print();
+}
@@ -0,0 +1,148 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+
+#include <Graphics/Vulkan/libs/volk/volk.h>
+#include <Graphics/Vulkan/Utils/Device.hpp>
+
+#include "OccupancyModel.hpp"
+
+struct ArchitectureSharedMemory {
+    uint32_t vendorID;
+    uint32_t firstDeviceID, lastDeviceID;
+    const char* architecture;
+    uint32_t sharedMemoryPerComputeUnit;
+};
+
+/*
+ * Maximum shared memory per SM from the CUDA programming guide (compute capabilities 7.0 to 9.0) and LDS size per CU
+ * for AMD GPUs (GCN, CDNA and RDNA in CU mode, where one WGP has 128 KiB). The NVIDIA device ID ranges correspond to
+ * the PCI IDs of the respective chips. Newer architectures fall back to maxComputeSharedMemorySize until added here.
+ */
+static const ArchitectureSharedMemory ARCHITECTURE_SHARED_MEMORY_TABLE[] = {
+        { 0x10DE, 0x1D80, 0x1DFF, "NVIDIA Volta", 96 * 1024 },
+        { 0x10DE, 0x1E00, 0x1FFF, "NVIDIA Turing", 64 * 1024 },
+        { 0x10DE, 0x2180, 0x21FF, "NVIDIA Turing", 64 * 1024 },
+        { 0x10DE, 0x20B0, 0x20FF, "NVIDIA Ampere (GA100)", 164 * 1024 },
+        { 0x10DE, 0x2200, 0x22FF, "NVIDIA Ampere (GA10x)", 100 * 1024 },
+        { 0x10DE, 0x2400, 0x25FF, "NVIDIA Ampere (GA10x)", 100 * 1024 },
+        { 0x10DE, 0x2300, 0x23FF, "NVIDIA Hopper", 228 * 1024 },
+        { 0x10DE, 0x2680, 0x28FF, "NVIDIA Ada Lovelace", 100 * 1024 },
+        { 0x1002, 0x0000, 0xFFFF, "AMD", 64 * 1024 },
+};
+
+ComputeUnitInfo queryComputeUnitInfo(sgl::vk::Device* device) {
+    ComputeUnitInfo info{};
+    const uint32_t vendorID = device->getPhysicalDeviceProperties().vendorID;
+    const uint32_t deviceID = device->getPhysicalDeviceProperties().deviceID;
+    info.sharedMemoryPerComputeUnit = device->getLimits().maxComputeSharedMemorySize;
+    for (const auto& entry : ARCHITECTURE_SHARED_MEMORY_TABLE) {
+        if (vendorID == entry.vendorID && deviceID >= entry.firstDeviceID && deviceID <= entry.lastDeviceID) {
+            info.sharedMemoryPerComputeUnit = entry.sharedMemoryPerComputeUnit;
+            info.isSharedMemoryPerComputeUnitExact = true;
+            info.architecture = entry.architecture;
+            break;
+        }
+    }
+
+    VkPhysicalDeviceShaderSMBuiltinsPropertiesNV smBuiltinsProperties{};
+    smBuiltinsProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_SM_BUILTINS_PROPERTIES_NV;
+    VkPhysicalDeviceShaderCorePropertiesAMD shaderCoreProperties{};
+    shaderCoreProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_CORE_PROPERTIES_AMD;
+    VkPhysicalDeviceProperties2 properties2{};
+    properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+    if (device->isDeviceExtensionSupported(VK_NV_SHADER_SM_BUILTINS_EXTENSION_NAME)) {
+        properties2.pNext = &smBuiltinsProperties;
+        vkGetPhysicalDeviceProperties2(device->getVkPhysicalDevice(), &properties2);
+        info.numComputeUnits = smBuiltinsProperties.shaderSMCount;
+        info.maxThreadsPerComputeUnit =
+                smBuiltinsProperties.shaderWarpsPerSM * device->getPhysicalDeviceSubgroupProperties().subgroupSize;
+        info.source = VK_NV_SHADER_SM_BUILTINS_EXTENSION_NAME;
+    } else if (device->isDeviceExtensionSupported(VK_AMD_SHADER_CORE_PROPERTIES_EXTENSION_NAME)) {
+        properties2.pNext = &shaderCoreProperties;
+        vkGetPhysicalDeviceProperties2(device->getVkPhysicalDevice(), &properties2);
+        info.numComputeUnits =
+                shaderCoreProperties.shaderEngineCount * shaderCoreProperties.shaderArraysPerEngineCount
+                * shaderCoreProperties.computeUnitsPerShaderArray;
+        info.maxThreadsPerComputeUnit =
+                shaderCoreProperties.simdPerComputeUnit * shaderCoreProperties.wavefrontsPerSimd
+                * shaderCoreProperties.wavefrontSize;
+        info.source = VK_AMD_SHADER_CORE_PROPERTIES_EXTENSION_NAME;
+    } else {
+        info.source = "core limits only";
+    }
+    return info;
+}
+
+OccupancyPrediction predictOccupancy(
+        sgl::vk::Device* device, const ComputeUnitInfo& computeUnitInfo, const OccupancyInput& input) {
+    const auto& limits = device->getLimits();
+    OccupancyPrediction prediction{};
+    prediction.sharedMemoryPerWorkgroup = input.sharedMemorySize;
+    uint32_t maxWorkgroupSize = limits.maxComputeWorkGroupInvocations;
+    if (input.usesWorkgroupScope) {
+        const auto& properties = device->getCooperativeMatrix2PropertiesNV();
+        prediction.sharedMemoryPerWorkgroup += properties.cooperativeMatrixWorkgroupScopeReservedSharedMemory;
+        maxWorkgroupSize = std::min(maxWorkgroupSize, properties.cooperativeMatrixWorkgroupScopeMaxWorkgroupSize);
+    }
+    if (input.workgroupSize > maxWorkgroupSize) {
+        prediction.limiter = "workgroup size";
+        return prediction;
+    }
+    if (prediction.sharedMemoryPerWorkgroup > limits.maxComputeSharedMemorySize) {
+        prediction.limiter = "maxComputeSharedMemorySize";
+        return prediction;
+    }
+    prediction.fits = true;
+
+    uint32_t limitSharedMemory = UINT32_MAX;
+    if (prediction.sharedMemoryPerWorkgroup > 0) {
+        limitSharedMemory = std::max(
+                computeUnitInfo.sharedMemoryPerComputeUnit / prediction.sharedMemoryPerWorkgroup, 1u);
+    }
+    uint32_t limitThreads = UINT32_MAX;
+    if (computeUnitInfo.maxThreadsPerComputeUnit > 0) {
+        uint32_t subgroupSize = device->getPhysicalDeviceSubgroupProperties().subgroupSize;
+        uint32_t workgroupThreads = (input.workgroupSize + subgroupSize - 1) / subgroupSize * subgroupSize;
+        limitThreads = std::max(computeUnitInfo.maxThreadsPerComputeUnit / workgroupThreads, 1u);
+    }
+    if (limitSharedMemory == UINT32_MAX && limitThreads == UINT32_MAX) {
+        prediction.limiter = "unknown";
+        return prediction;
+    }
+    if (limitSharedMemory <= limitThreads) {
+        prediction.workgroupsPerComputeUnit = limitSharedMemory;
+        prediction.limiter = "shared memory";
+    } else {
+        prediction.workgroupsPerComputeUnit = limitThreads;
+        prediction.limiter = "threads";
+    }
+    prediction.totalWorkgroups = prediction.workgroupsPerComputeUnit * computeUnitInfo.numComputeUnits;
+    return prediction;
+}
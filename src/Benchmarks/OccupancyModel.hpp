@@ -0,0 +1,81 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef QUERYVKCOOPMAT_OCCUPANCYMODEL_HPP
+#define QUERYVKCOOPMAT_OCCUPANCYMODEL_HPP
+
+#include <cstdint>
+#include <string>
+
+namespace sgl { namespace vk {
+class Device;
+}}
+
+/**
+ * Per compute unit (SM/CU/Xe core) resources. Vulkan only exposes them via vendor extensions
+ * (VK_NV_shader_sm_builtins, VK_AMD_shader_core_properties). Unknown values are zero.
+ */
+struct ComputeUnitInfo {
+    uint32_t numComputeUnits = 0;
+    uint32_t maxThreadsPerComputeUnit = 0;
+    /**
+     * Maximum shared memory per compute unit for known architectures (identified by the PCI vendor and device ID).
+     * Otherwise, falls back to maxComputeSharedMemorySize, which is a per-workgroup limit and thus underestimates the
+     * occupancy if several workgroups can share one unit (e.g., on NVIDIA GPUs).
+     */
+    uint32_t sharedMemoryPerComputeUnit = 0;
+    bool isSharedMemoryPerComputeUnitExact = false;
+    std::string architecture; ///< Name of the architecture the shared memory size was looked up for (if known).
+    std::string source;
+};
+
+ComputeUnitInfo queryComputeUnitInfo(sgl::vk::Device* device);
+
+struct OccupancyInput {
+    uint32_t workgroupSize = 0;
+    uint32_t sharedMemorySize = 0; ///< Shared memory declared by the kernel in bytes.
+    bool usesWorkgroupScope = false; ///< Workgroup scope cooperative matrices need additional reserved shared memory.
+};
+
+struct OccupancyPrediction {
+    bool fits = false; ///< Whether a single workgroup fits at all.
+    uint32_t sharedMemoryPerWorkgroup = 0; ///< Including the reserved shared memory.
+    uint32_t workgroupsPerComputeUnit = 0;
+    uint32_t totalWorkgroups = 0; ///< 0 if the number of compute units is unknown.
+    std::string limiter; ///< The resource limiting the occupancy (or why the workgroup does not fit).
+};
+
+/**
+ * Predicts the number of resident workgroups per compute unit as the minimum of the shared memory limit
+ * (sharedMemoryPerComputeUnit / (sharedMemorySize + cooperativeMatrixWorkgroupScopeReservedSharedMemory)) and the
+ * thread limit (maxThreadsPerComputeUnit / workgroupSize rounded up to whole subgroups).
+ */
+OccupancyPrediction predictOccupancy(
+        sgl::vk::Device* device, const ComputeUnitInfo& computeUnitInfo, const OccupancyInput& input);
+
+#endif //QUERYVKCOOPMAT_OCCUPANCYMODEL_HPP
@@ -0,0 +1,591 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include <Utils/File/Logfile.hpp>
+#include <Graphics/Vulkan/Utils/Instance.hpp>
+#include <Graphics/Vulkan/Utils/Device.hpp>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+#include "PrintUtils.hpp"
+#include "VulkanUtils.hpp"
+#include "PeerTransferBenchmark.hpp"
+
+static const VkDeviceSize BANDWIDTH_TRANSFER_SIZE = VkDeviceSize(64) * 1024 * 1024;
+static const VkDeviceSize LATENCY_TRANSFER_SIZE = 4096;
+static const uint32_t NUM_BANDWIDTH_ITERATIONS = 10;
+/// Latency samples contain a single copy between the timestamps; batches of copies would measure throughput instead.
+static const uint32_t NUM_LATENCY_ITERATIONS = 1;
+
+struct TransferResult {
+    bool isValid = false;
+    double bandwidthGiBs = 0.0;
+    double latencyUs = 0.0; ///< Median time of a single small copy (or of a single pass of the host bounce).
+    std::string note; ///< Additional information, or the reason why the path is not available.
+};
+
+static std::string transferResultToString(const TransferResult& result) {
+    if (!result.isValid) {
+        return result.note.empty() ? "n/a" : result.note;
+    }
+    std::string resultString =
+            formatNumber(result.bandwidthGiBs) + " GiB/s, " + formatNumber(result.latencyUs, 1) + " us";
+    if (!result.note.empty()) {
+        resultString += " (" + result.note + ")";
+    }
+    return resultString;
+}
+
+static double measureCopyMs(
+        CommandContext& context, VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size, uint32_t numIterations) {
+    VkBufferCopy bufferCopy{ 0, 0, size };
+    return measureCommandsMs(context, [&](VkCommandBuffer commandBuffer) {
+        vkCmdCopyBuffer(commandBuffer, srcBuffer, dstBuffer, 1, &bufferCopy);
+    }, numIterations);
+}
+
+static TransferResult measureCopy(CommandContext& context, VkBuffer srcBuffer, VkBuffer dstBuffer) {
+    TransferResult result;
+    double bandwidthMs = measureCopyMs(
+            context, srcBuffer, dstBuffer, BANDWIDTH_TRANSFER_SIZE, NUM_BANDWIDTH_ITERATIONS);
+    double latencyMs = measureCopyMs(
+            context, srcBuffer, dstBuffer, LATENCY_TRANSFER_SIZE, NUM_LATENCY_ITERATIONS);
+    result.isValid = true;
+    result.bandwidthGiBs = computeGiBPerSecond(double(BANDWIDTH_TRANSFER_SIZE), bandwidthMs);
+    result.latencyUs = latencyMs * 1e3;
+    return result;
+}
+
+/// Per-device resources shared by the local copy and host bounce measurements.
+struct PeerDeviceResources {
+    sgl::vk::Device* device = nullptr;
+    std::unique_ptr<CommandContext> context;
+    DeviceBuffer localBuffer0, localBuffer1, stagingBuffer;
+};
+
+static void createPeerDeviceResources(PeerDeviceResources& resources) {
+    auto* device = resources.device;
+    loadDeviceFunctions(device->getVkDevice());
+    resources.context = std::make_unique<CommandContext>(device);
+    const VkBufferUsageFlags usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    resources.localBuffer0 = createDeviceBuffer(
+            device, BANDWIDTH_TRANSFER_SIZE, usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    resources.localBuffer1 = createDeviceBuffer(
+            device, BANDWIDTH_TRANSFER_SIZE, usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    // Cached memory makes the CPU reads of the source staging buffer considerably faster where available.
+    try {
+        resources.stagingBuffer = createDeviceBuffer(
+                device, BANDWIDTH_TRANSFER_SIZE, usage,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+                | VK_MEMORY_PROPERTY_HOST_CACHED_BIT);
+    } catch (const std::exception&) {
+        resources.stagingBuffer = createDeviceBuffer(
+                device, BANDWIDTH_TRANSFER_SIZE, usage,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    }
+}
+
+static void destroyPeerDeviceResources(PeerDeviceResources& resources) {
+    VkDevice vkDevice = resources.device->getVkDevice();
+    loadDeviceFunctions(vkDevice);
+    destroyDeviceBuffer(vkDevice, resources.localBuffer0);
+    destroyDeviceBuffer(vkDevice, resources.localBuffer1);
+    destroyDeviceBuffer(vkDevice, resources.stagingBuffer);
+    resources.context = {};
+}
+
+/// Records a copy followed by a barrier making the written data visible to host reads.
+static void recordCopyToHost(
+        VkCommandBuffer commandBuffer, VkBuffer srcBuffer, VkBuffer dstBuffer, const VkBufferCopy& bufferCopy) {
+    vkCmdCopyBuffer(commandBuffer, srcBuffer, dstBuffer, 1, &bufferCopy);
+    insertHostReadBarrier(commandBuffer);
+}
+
+/**
+ * Each sample times complete device -> host -> device passes with the wall clock: the copy to the staging buffer of
+ * the source device and the wait for it, the memcpy between the staging buffers, and the copy on the destination
+ * device and the wait for it. Submissions cannot be batched across devices, so the pass is inherently end-to-end.
+ */
+static TransferResult measureHostBounce(PeerDeviceResources& src, PeerDeviceResources& dst) {
+    auto measurePassMs = [&](VkDeviceSize size, uint32_t numPasses) {
+        VkBufferCopy bufferCopy{ 0, 0, size };
+        return runBenchmark([&]() {
+            auto startTime = std::chrono::high_resolution_clock::now();
+            for (uint32_t i = 0; i < numPasses; i++) {
+                loadDeviceFunctions(src.device->getVkDevice());
+                recordCopyToHost(
+                        src.context->begin(), src.localBuffer0.buffer, src.stagingBuffer.buffer, bufferCopy);
+                src.context->submitAndWait();
+                memcpy(dst.stagingBuffer.mappedData, src.stagingBuffer.mappedData, size_t(size));
+                loadDeviceFunctions(dst.device->getVkDevice());
+                vkCmdCopyBuffer(
+                        dst.context->begin(), dst.stagingBuffer.buffer, dst.localBuffer0.buffer, 1, &bufferCopy);
+                dst.context->submitAndWait();
+            }
+            auto endTime = std::chrono::high_resolution_clock::now();
+            return std::chrono::duration<double, std::milli>(endTime - startTime).count() / double(numPasses);
+        }).median;
+    };
+    TransferResult result;
+    result.isValid = true;
+    result.bandwidthGiBs = computeGiBPerSecond(
+            double(BANDWIDTH_TRANSFER_SIZE), measurePassMs(BANDWIDTH_TRANSFER_SIZE, NUM_BANDWIDTH_ITERATIONS));
+    result.latencyUs = measurePassMs(LATENCY_TRANSFER_SIZE, NUM_LATENCY_ITERATIONS) * 1e3;
+    return result;
+}
+
+#ifdef __linux__
+static bool queryExternalBufferFeatures(
+        VkPhysicalDevice physicalDevice, VkExternalMemoryHandleTypeFlagBits handleType,
+        VkExternalMemoryFeatureFlags requiredFeatures, bool& isDedicatedOnly) {
+    VkPhysicalDeviceExternalBufferInfo externalBufferInfo{};
+    externalBufferInfo.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTERNAL_BUFFER_INFO;
+    externalBufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    externalBufferInfo.handleType = handleType;
+    VkExternalBufferProperties externalBufferProperties{};
+    externalBufferProperties.sType = VK_STRUCTURE_TYPE_EXTERNAL_BUFFER_PROPERTIES;
+    vkGetPhysicalDeviceExternalBufferProperties(physicalDevice, &externalBufferInfo, &externalBufferProperties);
+    VkExternalMemoryFeatureFlags features = externalBufferProperties.externalMemoryProperties.externalMemoryFeatures;
+    isDedicatedOnly = (features & VK_EXTERNAL_MEMORY_FEATURE_DEDICATED_ONLY_BIT) != 0;
+    return (features & requiredFeatures) == requiredFeatures;
+}
+
+/// The buffer exported by the source device and its import on the destination device; destroyed on all exit paths.
+struct DirectImportBuffers {
+    VkDevice srcDevice = VK_NULL_HANDLE, dstDevice = VK_NULL_HANDLE;
+    DeviceBuffer exportedBuffer{}, importedBuffer{};
+    DirectImportBuffers(VkDevice srcDevice, VkDevice dstDevice) : srcDevice(srcDevice), dstDevice(dstDevice) {}
+    ~DirectImportBuffers() {
+        loadDeviceFunctions(dstDevice);
+        destroyDeviceBuffer(dstDevice, importedBuffer);
+        loadDeviceFunctions(srcDevice);
+        destroyDeviceBuffer(srcDevice, exportedBuffer);
+    }
+    DirectImportBuffers(const DirectImportBuffers&) = delete;
+    DirectImportBuffers& operator=(const DirectImportBuffers&) = delete;
+};
+
+static TransferResult measureDirectImportWithMemory(
+        PeerDeviceResources& src, PeerDeviceResources& dst, VkMemoryPropertyFlags exportMemoryProperties,
+        bool srcDedicatedOnly, bool dstDedicatedOnly) {
+    const auto handleType = VK_EXTERNAL_MEMORY_HANDLE_TYPE_DMA_BUF_BIT_EXT;
+    VkDevice srcVkDevice = src.device->getVkDevice();
+    VkDevice dstVkDevice = dst.device->getVkDevice();
+
+    VkExternalMemoryBufferCreateInfo externalMemoryBufferCreateInfo{};
+    externalMemoryBufferCreateInfo.sType = VK_STRUCTURE_TYPE_EXTERNAL_MEMORY_BUFFER_CREATE_INFO;
+    externalMemoryBufferCreateInfo.handleTypes = handleType;
+
+    loadDeviceFunctions(srcVkDevice);
+    VkExportMemoryAllocateInfo exportMemoryAllocateInfo{};
+    exportMemoryAllocateInfo.sType = VK_STRUCTURE_TYPE_EXPORT_MEMORY_ALLOCATE_INFO;
+    exportMemoryAllocateInfo.handleTypes = handleType;
+    BufferSettings exportSettings{};
+    exportSettings.size = BANDWIDTH_TRANSFER_SIZE;
+    exportSettings.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    exportSettings.memoryProperties = exportMemoryProperties & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+    exportSettings.dedicatedAllocation = srcDedicatedOnly;
+    exportSettings.bufferCreateInfoNext = &externalMemoryBufferCreateInfo;
+    exportSettings.memoryAllocateInfoNext = &exportMemoryAllocateInfo;
+    if ((exportMemoryProperties & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT) == 0) {
+        // Restrict to memory types that are not device local, i.e., system memory.
+        const auto& memoryProperties = src.device->getMemoryProperties();
+        exportSettings.memoryTypeBitsMask = 0;
+        for (uint32_t memoryTypeIdx = 0; memoryTypeIdx < memoryProperties.memoryTypeCount; memoryTypeIdx++) {
+            auto propertyFlags = memoryProperties.memoryTypes[memoryTypeIdx].propertyFlags;
+            if ((propertyFlags & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT) == 0
+                    && (propertyFlags & exportMemoryProperties) == exportMemoryProperties) {
+                exportSettings.memoryTypeBitsMask |= 1u << memoryTypeIdx;
+            }
+        }
+    }
+    DirectImportBuffers buffers(srcVkDevice, dstVkDevice);
+    buffers.exportedBuffer = createDeviceBuffer(srcVkDevice, src.device->getMemoryProperties(), exportSettings);
+
+    VkMemoryGetFdInfoKHR memoryGetFdInfo{};
+    memoryGetFdInfo.sType = VK_STRUCTURE_TYPE_MEMORY_GET_FD_INFO_KHR;
+    memoryGetFdInfo.memory = buffers.exportedBuffer.memory;
+    memoryGetFdInfo.handleType = handleType;
+    int fd = -1;
+    throwIfVkError(vkGetMemoryFdKHR(srcVkDevice, &memoryGetFdInfo, &fd), "vkGetMemoryFdKHR");
+
+    /*
+     * The import is done by hand rather than with createDeviceBuffer, as the ownership of the file descriptor is only
+     * transferred to the implementation if vkAllocateMemory succeeds.
+     */
+    loadDeviceFunctions(dstVkDevice);
+    VkMemoryFdPropertiesKHR memoryFdProperties{};
+    memoryFdProperties.sType = VK_STRUCTURE_TYPE_MEMORY_FD_PROPERTIES_KHR;
+    VkResult result = vkGetMemoryFdPropertiesKHR(dstVkDevice, handleType, fd, &memoryFdProperties);
+    if (result != VK_SUCCESS) {
+        close(fd);
+        throwIfVkError(result, "vkGetMemoryFdPropertiesKHR");
+    }
+
+    DeviceBuffer& importedBuffer = buffers.importedBuffer;
+    importedBuffer.size = BANDWIDTH_TRANSFER_SIZE;
+    VkBufferCreateInfo bufferCreateInfo{};
+    bufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferCreateInfo.pNext = &externalMemoryBufferCreateInfo;
+    bufferCreateInfo.size = BANDWIDTH_TRANSFER_SIZE;
+    bufferCreateInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    result = vkCreateBuffer(dstVkDevice, &bufferCreateInfo, nullptr, &importedBuffer.buffer);
+    if (result != VK_SUCCESS) {
+        close(fd);
+        throwIfVkError(result, "vkCreateBuffer");
+    }
+    VkMemoryRequirements memoryRequirements{};
+    vkGetBufferMemoryRequirements(dstVkDevice, importedBuffer.buffer, &memoryRequirements);
+    importedBuffer.memoryTypeIndex = findMemoryTypeIndex(
+            dst.device->getMemoryProperties(),
+            memoryRequirements.memoryTypeBits & memoryFdProperties.memoryTypeBits, 0);
+    VkImportMemoryFdInfoKHR importMemoryFdInfo{};
+    importMemoryFdInfo.sType = VK_STRUCTURE_TYPE_IMPORT_MEMORY_FD_INFO_KHR;
+    importMemoryFdInfo.handleType = handleType;
+    importMemoryFdInfo.fd = fd;
+    VkMemoryDedicatedAllocateInfo dedicatedAllocateInfo{};
+    dedicatedAllocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_ALLOCATE_INFO;
+    dedicatedAllocateInfo.pNext = &importMemoryFdInfo;
+    dedicatedAllocateInfo.buffer = importedBuffer.buffer;
+    VkMemoryAllocateInfo memoryAllocateInfo{};
+    memoryAllocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    memoryAllocateInfo.pNext = dstDedicatedOnly ? (const void*)&dedicatedAllocateInfo : &importMemoryFdInfo;
+    memoryAllocateInfo.allocationSize = memoryRequirements.size;
+    memoryAllocateInfo.memoryTypeIndex = importedBuffer.memoryTypeIndex;
+    result = importedBuffer.memoryTypeIndex == UINT32_MAX
+            ? VK_ERROR_INVALID_EXTERNAL_HANDLE
+            : vkAllocateMemory(dstVkDevice, &memoryAllocateInfo, nullptr, &importedBuffer.memory);
+    if (result != VK_SUCCESS) {
+        close(fd);
+        throwIfVkError(result, "vkAllocateMemory (import)");
+    }
+    throwIfVkError(
+            vkBindBufferMemory(dstVkDevice, importedBuffer.buffer, importedBuffer.memory, 0),
+            "vkBindBufferMemory (import)");
+
+    return measureCopy(*dst.context, importedBuffer.buffer, dst.localBuffer0.buffer);
+}
+
+static TransferResult measureDirectImport(PeerDeviceResources& src, PeerDeviceResources& dst) {
+    TransferResult result;
+    for (auto* device : { src.device, dst.device }) {
+        if (!device->isDeviceExtensionSupported(VK_KHR_EXTERNAL_MEMORY_FD_EXTENSION_NAME)
+                || !device->isDeviceExtensionSupported(VK_EXT_EXTERNAL_MEMORY_DMA_BUF_EXTENSION_NAME)) {
+            result.note = "no dma-buf";
+            return result;
+        }
+    }
+    bool srcDedicatedOnly = false, dstDedicatedOnly = false;
+    if (!queryExternalBufferFeatures(
+            src.device->getVkPhysicalDevice(), VK_EXTERNAL_MEMORY_HANDLE_TYPE_DMA_BUF_BIT_EXT,
+            VK_EXTERNAL_MEMORY_FEATURE_EXPORTABLE_BIT, srcDedicatedOnly)
+            || !queryExternalBufferFeatures(
+                    dst.device->getVkPhysicalDevice(), VK_EXTERNAL_MEMORY_HANDLE_TYPE_DMA_BUF_BIT_EXT,
+                    VK_EXTERNAL_MEMORY_FEATURE_IMPORTABLE_BIT, dstDedicatedOnly)) {
+        result.note = "not exportable";
+        return result;
+    }
+
+    /*
+     * Importing VRAM of another device requires peer-to-peer support by both kernel drivers. If that fails, fall back
+     * to exporting system memory, which is still a zero-copy path from the point of view of the application.
+     */
+    std::string errorString;
+    for (VkMemoryPropertyFlags exportMemoryProperties : {
+            VkMemoryPropertyFlags(VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT),
+            VkMemoryPropertyFlags(VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) }) {
+        try {
+            result = measureDirectImportWithMemory(
+                    src, dst, exportMemoryProperties, srcDedicatedOnly, dstDedicatedOnly);
+            if ((exportMemoryProperties & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT) == 0) {
+                result.note = "sysmem";
+            }
+            return result;
+        } catch (const std::exception& e) {
+            errorString = e.what();
+        }
+    }
+    sgl::Logfile::get()->write(
+            "Peer transfer benchmark: Direct import from " + std::string(src.device->getDeviceName()) + " to "
+            + dst.device->getDeviceName() + " failed: " + errorString, sgl::ORANGE);
+    result = {};
+    result.note = "failed";
+    return result;
+}
+#endif
+
+static void measureDeviceGroup(
+        const VkPhysicalDeviceGroupProperties& group, const std::vector<int>& memberDeviceIndices,
+        std::vector<std::vector<TransferResult>>& results) {
+    const uint32_t numMembers = group.physicalDeviceCount;
+    VkPhysicalDevice physicalDevice = group.physicalDevices[0];
+
+    // All devices in a group have the same queue families.
+    uint32_t queueFamilyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> queueFamilyProperties(queueFamilyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, queueFamilyProperties.data());
+    uint32_t queueFamilyIndex = UINT32_MAX;
+    for (uint32_t i = 0; i < queueFamilyCount; i++) {
+        if ((queueFamilyProperties[i].queueFlags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)) != 0) {
+            queueFamilyIndex = i;
+            break;
+        }
+    }
+    if (queueFamilyIndex == UINT32_MAX) {
+        throw std::runtime_error("No compute queue family found for the device group.");
+    }
+
+    float queuePriority = 1.0f;
+    VkDeviceQueueCreateInfo queueCreateInfo{};
+    queueCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+    queueCreateInfo.queueFamilyIndex = queueFamilyIndex;
+    queueCreateInfo.queueCount = 1;
+    queueCreateInfo.pQueuePriorities = &queuePriority;
+    VkDeviceGroupDeviceCreateInfo deviceGroupDeviceCreateInfo{};
+    deviceGroupDeviceCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_GROUP_DEVICE_CREATE_INFO;
+    deviceGroupDeviceCreateInfo.physicalDeviceCount = numMembers;
+    deviceGroupDeviceCreateInfo.pPhysicalDevices = group.physicalDevices;
+    VkDeviceCreateInfo deviceCreateInfo{};
+    deviceCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+    deviceCreateInfo.pNext = &deviceGroupDeviceCreateInfo;
+    deviceCreateInfo.queueCreateInfoCount = 1;
+    deviceCreateInfo.pQueueCreateInfos = &queueCreateInfo;
+    VkDevice groupDevice = VK_NULL_HANDLE;
+    throwIfVkError(vkCreateDevice(physicalDevice, &deviceCreateInfo, nullptr, &groupDevice), "vkCreateDevice");
+    loadDeviceFunctions(groupDevice);
+    VkQueue queue = VK_NULL_HANDLE;
+    vkGetDeviceQueue(groupDevice, queueFamilyIndex, 0, &queue);
+
+    VkPhysicalDeviceMemoryProperties memoryProperties{};
+    vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memoryProperties);
+
+    // Allocate one memory instance per device of the group.
+    VkMemoryAllocateFlagsInfo memoryAllocateFlagsInfo{};
+    memoryAllocateFlagsInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO;
+    memoryAllocateFlagsInfo.flags = VK_MEMORY_ALLOCATE_DEVICE_MASK_BIT;
+    memoryAllocateFlagsInfo.deviceMask = (1u << numMembers) - 1u;
+    BufferSettings bufferSettings{};
+    bufferSettings.size = BANDWIDTH_TRANSFER_SIZE;
+    bufferSettings.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    bufferSettings.memoryProperties = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+    bufferSettings.memoryAllocateInfoNext = &memoryAllocateFlagsInfo;
+    DeviceBuffer srcBuffer{}, dstBuffer{};
+    std::unique_ptr<CommandContext> context;
+    try {
+        srcBuffer = createDeviceBuffer(groupDevice, memoryProperties, bufferSettings);
+        dstBuffer = createDeviceBuffer(groupDevice, memoryProperties, bufferSettings);
+        context = std::make_unique<CommandContext>(physicalDevice, groupDevice, queueFamilyIndex, queue);
+        uint32_t heapIndex = memoryProperties.memoryTypes[srcBuffer.memoryTypeIndex].heapIndex;
+
+        for (uint32_t localIdx = 0; localIdx < numMembers; localIdx++) {
+            for (uint32_t remoteIdx = 0; remoteIdx < numMembers; remoteIdx++) {
+                int srcDeviceIdx = memberDeviceIndices.at(remoteIdx);
+                int dstDeviceIdx = memberDeviceIndices.at(localIdx);
+                if (localIdx == remoteIdx || srcDeviceIdx < 0 || dstDeviceIdx < 0) {
+                    continue;
+                }
+                TransferResult& result = results.at(srcDeviceIdx).at(dstDeviceIdx);
+                VkPeerMemoryFeatureFlags peerMemoryFeatures = 0;
+                vkGetDeviceGroupPeerMemoryFeatures(groupDevice, heapIndex, localIdx, remoteIdx, &peerMemoryFeatures);
+                if ((peerMemoryFeatures & VK_PEER_MEMORY_FEATURE_COPY_SRC_BIT) == 0) {
+                    result.note = "no peer copy";
+                    continue;
+                }
+
+                // Bind a second buffer such that the local device sees the memory instance of the remote device.
+                VkBufferCreateInfo bufferCreateInfo{};
+                bufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+                bufferCreateInfo.size = BANDWIDTH_TRANSFER_SIZE;
+                bufferCreateInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+                bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+                VkBuffer peerBuffer = VK_NULL_HANDLE;
+                throwIfVkError(vkCreateBuffer(groupDevice, &bufferCreateInfo, nullptr, &peerBuffer), "vkCreateBuffer");
+                std::vector<uint32_t> deviceIndices(numMembers);
+                for (uint32_t i = 0; i < numMembers; i++) {
+                    deviceIndices.at(i) = i;
+                }
+                deviceIndices.at(localIdx) = remoteIdx;
+                VkBindBufferMemoryDeviceGroupInfo bindBufferMemoryDeviceGroupInfo{};
+                bindBufferMemoryDeviceGroupInfo.sType = VK_STRUCTURE_TYPE_BIND_BUFFER_MEMORY_DEVICE_GROUP_INFO;
+                bindBufferMemoryDeviceGroupInfo.deviceIndexCount = numMembers;
+                bindBufferMemoryDeviceGroupInfo.pDeviceIndices = deviceIndices.data();
+                VkBindBufferMemoryInfo bindBufferMemoryInfo{};
+                bindBufferMemoryInfo.sType = VK_STRUCTURE_TYPE_BIND_BUFFER_MEMORY_INFO;
+                bindBufferMemoryInfo.pNext = &bindBufferMemoryDeviceGroupInfo;
+                bindBufferMemoryInfo.buffer = peerBuffer;
+                bindBufferMemoryInfo.memory = srcBuffer.memory;
+                VkResult bindResult = vkBindBufferMemory2(groupDevice, 1, &bindBufferMemoryInfo);
+                if (bindResult == VK_SUCCESS) {
+                    context->setDeviceMask(1u << localIdx);
+                    try {
+                        result = measureCopy(*context, peerBuffer, dstBuffer.buffer);
+                    } catch (...) {
+                        vkDestroyBuffer(groupDevice, peerBuffer, nullptr);
+                        throw;
+                    }
+                } else {
+                    result.note = "bind failed";
+                }
+                vkDestroyBuffer(groupDevice, peerBuffer, nullptr);
+            }
+        }
+    } catch (const std::exception& e) {
+        sgl::Logfile::get()->writeError(
+                std::string() + "Error in measureDeviceGroup: " + e.what(), false);
+    }
+
+    context = {};
+    destroyDeviceBuffer(groupDevice, srcBuffer);
+    destroyDeviceBuffer(groupDevice, dstBuffer);
+    vkDestroyDevice(groupDevice, nullptr);
+}
+
+static void measureDeviceGroups(
+        sgl::vk::Instance* instance, const std::vector<sgl::vk::Device*>& devices,
+        std::vector<std::vector<TransferResult>>& results) {
+    VkInstance vkInstance = instance->getVkInstance();
+    uint32_t groupCount = 0;
+    throwIfVkError(
+            vkEnumeratePhysicalDeviceGroups(vkInstance, &groupCount, nullptr), "vkEnumeratePhysicalDeviceGroups");
+    std::vector<VkPhysicalDeviceGroupProperties> groups(groupCount);
+    for (auto& group : groups) {
+        group.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GROUP_PROPERTIES;
+    }
+    throwIfVkError(
+            vkEnumeratePhysicalDeviceGroups(vkInstance, &groupCount, groups.data()),
+            "vkEnumeratePhysicalDeviceGroups");
+
+    for (const auto& group : groups) {
+        if (group.physicalDeviceCount < 2) {
+            continue;
+        }
+        std::vector<int> memberDeviceIndices(group.physicalDeviceCount, -1);
+        int numMatchedMembers = 0;
+        for (uint32_t memberIdx = 0; memberIdx < group.physicalDeviceCount; memberIdx++) {
+            for (size_t deviceIdx = 0; deviceIdx < devices.size(); deviceIdx++) {
+                if (devices.at(deviceIdx)->getVkPhysicalDevice() == group.physicalDevices[memberIdx]) {
+                    memberDeviceIndices.at(memberIdx) = int(deviceIdx);
+                    numMatchedMembers++;
+                }
+            }
+        }
+        if (numMatchedMembers >= 2) {
+            measureDeviceGroup(group, memberDeviceIndices, results);
+        }
+    }
+}
+
+static void printTransferMatrix(
+        const std::string& title, const std::vector<sgl::vk::Device*>& devices,
+        const std::vector<std::vector<TransferResult>>& results) {
+    std::vector<std::string> columnNames = { "Source \\ Destination" };
+    for (size_t i = 0; i < devices.size(); i++) {
+        columnNames.push_back("#" + std::to_string(i));
+    }
+    ResultTable table(columnNames);
+    for (size_t srcIdx = 0; srcIdx < devices.size(); srcIdx++) {
+        std::vector<std::string> row = { "#" + std::to_string(srcIdx) };
+        for (size_t dstIdx = 0; dstIdx < devices.size(); dstIdx++) {
+            row.push_back(transferResultToString(results.at(srcIdx).at(dstIdx)));
+        }
+        table.addRow(row);
+    }
+    writeOut("");
+    writeOut(title);
+    table.print();
+}
+
+void runPeerTransferBenchmark(sgl::vk::Instance* instance, const std::vector<sgl::vk::Device*>& devices) {
+    const size_t numDevices = devices.size();
+    writeOut("");
+    writeOut("Peer transfer benchmark (", sgl::getNiceMemoryString(BANDWIDTH_TRANSFER_SIZE, 2),
+             " bandwidth transfers, ", sgl::getNiceMemoryString(LATENCY_TRANSFER_SIZE, 2), " single-copy latency):");
+    for (size_t i = 0; i < numDevices; i++) {
+        writeOut("#", i, ": ", std::string(devices.at(i)->getDeviceName()));
+    }
+    if (numDevices < 2) {
+        writeOut("At least two suitable devices are necessary for peer transfers.");
+    }
+
+    std::vector<PeerDeviceResources> resources(numDevices);
+    using TransferMatrix = std::vector<std::vector<TransferResult>>;
+    TransferMatrix directResults(numDevices, std::vector<TransferResult>(numDevices));
+    TransferMatrix hostBounceResults(numDevices, std::vector<TransferResult>(numDevices));
+    TransferMatrix deviceGroupResults(numDevices, std::vector<TransferResult>(numDevices));
+    try {
+        for (size_t i = 0; i < numDevices; i++) {
+            resources.at(i).device = devices.at(i);
+            createPeerDeviceResources(resources.at(i));
+        }
+        for (size_t srcIdx = 0; srcIdx < numDevices; srcIdx++) {
+            for (size_t dstIdx = 0; dstIdx < numDevices; dstIdx++) {
+                auto& src = resources.at(srcIdx);
+                auto& dst = resources.at(dstIdx);
+                if (srcIdx == dstIdx) {
+                    // Device-local copy as reference on the diagonal.
+                    loadDeviceFunctions(src.device->getVkDevice());
+                    TransferResult localResult = measureCopy(
+                            *src.context, src.localBuffer0.buffer, src.localBuffer1.buffer);
+                    localResult.note = "local";
+                    directResults.at(srcIdx).at(dstIdx) = localResult;
+                    hostBounceResults.at(srcIdx).at(dstIdx) = localResult;
+                    deviceGroupResults.at(srcIdx).at(dstIdx) = localResult;
+                    continue;
+                }
+#ifdef __linux__
+                directResults.at(srcIdx).at(dstIdx) = measureDirectImport(src, dst);
+#else
+                directResults.at(srcIdx).at(dstIdx).note = "no dma-buf";
+#endif
+                hostBounceResults.at(srcIdx).at(dstIdx) = measureHostBounce(src, dst);
+            }
+        }
+        measureDeviceGroups(instance, devices, deviceGroupResults);
+    } catch (const std::exception& e) {
+        sgl::Logfile::get()->writeError(std::string() + "Error in runPeerTransferBenchmark: " + e.what(), false);
+    }
+    for (auto& deviceResources : resources) {
+        if (deviceResources.device) {
+            destroyPeerDeviceResources(deviceResources);
+        }
+    }
+
+    printTransferMatrix("Direct import (dma-buf):", devices, directResults);
+    printTransferMatrix("Host bounce (staging buffers + memcpy):", devices, hostBounceResults);
+    printTransferMatrix("Device group (peer memory):", devices, deviceGroupResults);
+}
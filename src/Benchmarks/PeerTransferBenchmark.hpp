@@ -0,0 +1,50 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef QUERYVKCOOPMAT_PEERTRANSFERBENCHMARK_HPP
+#define QUERYVKCOOPMAT_PEERTRANSFERBENCHMARK_HPP
+
+#include <vector>
+
+namespace sgl { namespace vk {
+class Instance;
+class Device;
+}}
+
+/**
+ * Measures the transfer bandwidth and single-copy latency between all pairs of the passed devices for three transfer
+ * paths:
+ * - Direct import: Memory exported by the source device as a dma-buf is imported and copied by the destination device.
+ * - Host bounce: Copy to a host-visible staging buffer on the source device, memcpy, copy from a staging buffer on the
+ *   destination device. Each sample times complete passes with the wall clock.
+ * - Device group: Peer memory copy within a device group reported by vkEnumeratePhysicalDeviceGroups.
+ * Prints one NxN table per transfer path (rows: source device, columns: destination device).
+ */
+void runPeerTransferBenchmark(sgl::vk::Instance* instance, const std::vector<sgl::vk::Device*>& devices);
+
+#endif //QUERYVKCOOPMAT_PEERTRANSFERBENCHMARK_HPP
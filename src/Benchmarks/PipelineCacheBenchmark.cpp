@@ -0,0 +1,190 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <Utils/File/Logfile.hpp>
+#include <Graphics/Vulkan/libs/volk/volk.h>
+#include <Graphics/Vulkan/Utils/Device.hpp>
+
+#include "PrintUtils.hpp"
+#include "VulkanUtils.hpp"
+#include "PipelineCache.hpp"
+#include "CoopMatGemm.hpp"
+#include "PipelineCacheBenchmark.hpp"
+
+static double measurePipelineCreationMs(
+        VkDevice device, ComputePipelineSettings settings, VkPipelineCache pipelineCache) {
+    settings.pipelineCache = pipelineCache;
+    return runBenchmark([&]() {
+        auto startTime = std::chrono::high_resolution_clock::now();
+        ComputePipeline pipeline(device, settings);
+        auto endTime = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::milli>(endTime - startTime).count();
+    }).median;
+}
+
+/// Every sample uses a new empty pipeline cache; afterwards, the pipeline is added to populatedCache.
+static double measureColdPipelineCreationMs(
+        VkDevice device, ComputePipelineSettings settings, VkPipelineCache populatedCache) {
+    double coldMs = runBenchmark([&]() {
+        VkPipelineCache emptyCache = createVkPipelineCache(device, {});
+        settings.pipelineCache = emptyCache;
+        double timeMs = 0.0;
+        try {
+            auto startTime = std::chrono::high_resolution_clock::now();
+            ComputePipeline pipeline(device, settings);
+            auto endTime = std::chrono::high_resolution_clock::now();
+            timeMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+        } catch (...) {
+            vkDestroyPipelineCache(device, emptyCache, nullptr);
+            throw;
+        }
+        vkDestroyPipelineCache(device, emptyCache, nullptr);
+        return timeMs;
+    }).median;
+    settings.pipelineCache = populatedCache;
+    ComputePipeline pipeline(device, settings);
+    return coldMs;
+}
+
+struct PipelineCreationTimes {
+    std::string types, shape;
+    ComputePipelineSettings pipelineSettings;
+    double coldMs = 0.0, warmMemoryMs = 0.0, warmSerializedMs = 0.0, persistentMs = 0.0;
+};
+
+void runPipelineCacheBenchmark(sgl::vk::Device* device, PipelineCache* persistentCache) {
+    writeOut("");
+    writeOut("Pipeline cache benchmark (CoopMatGemm kernels):");
+    if (persistentCache) {
+        writeOut("Persistent cache: ", persistentCache->getFilePath(), " (", persistentCache->getLoadStatus(), ", ",
+                 sgl::getNiceMemoryString(persistentCache->getLoadedDataSize(), 2), " loaded)");
+    } else {
+        writeOut("Persistent cache: disabled");
+    }
+
+    std::vector<PipelineCreationTimes> entries;
+    auto addEntry = [&](const CoopMatGemmSettings& settings) {
+        if (!CoopMatGemm::checkSupport(device, settings).empty()) {
+            return;
+        }
+        PipelineCreationTimes entry;
+        entry.types = CoopMatGemm::getVariantName(settings);
+        entry.shape =
+                std::to_string(settings.lM) + "x" + std::to_string(settings.lN) + "x" + std::to_string(settings.lK);
+        try {
+            entry.pipelineSettings = CoopMatGemm::getPipelineSettings(device, settings);
+        } catch (const std::exception&) {
+            return;
+        }
+        entries.push_back(entry);
+    };
+    for (const auto& props : device->getSupportedCooperativeMatrixPropertiesKHR()) {
+        if (props.scope == VK_SCOPE_SUBGROUP_KHR) {
+            addEntry(CoopMatGemmSettings::fromProperties(props));
+        }
+    }
+    if (device->getCooperativeMatrix2FeaturesNV().cooperativeMatrixWorkgroupScope) {
+        for (const auto& props : device->getSupportedCooperativeMatrixFlexibleDimensionsPropertiesNV()) {
+            if (props.scope == VK_SCOPE_WORKGROUP_KHR) {
+                addEntry(CoopMatGemmSettings::fromProperties(props));
+            }
+        }
+    }
+    if (entries.empty()) {
+        writeOut("No supported CoopMatGemm kernel variant available.");
+        return;
+    }
+
+    VkDevice vkDevice = device->getVkDevice();
+    VkPipelineCache memoryCache = VK_NULL_HANDLE, serializedCache = VK_NULL_HANDLE;
+    size_t serializedDataSize = 0;
+    bool isValid = false;
+    try {
+        memoryCache = createVkPipelineCache(vkDevice, {});
+        for (auto& entry : entries) {
+            entry.coldMs = measureColdPipelineCreationMs(vkDevice, entry.pipelineSettings, memoryCache);
+        }
+        for (auto& entry : entries) {
+            entry.warmMemoryMs = measurePipelineCreationMs(vkDevice, entry.pipelineSettings, memoryCache);
+        }
+        std::vector<uint8_t> serializedData = getPipelineCacheData(vkDevice, memoryCache);
+        serializedDataSize = serializedData.size();
+        std::string errorString = validatePipelineCacheData(
+                device->getPhysicalDeviceProperties(), serializedData.data(), serializedData.size());
+        if (!errorString.empty()) {
+            throw std::runtime_error("Invalid pipeline cache data returned by the driver (" + errorString + ").");
+        }
+        serializedCache = createVkPipelineCache(vkDevice, serializedData);
+        for (auto& entry : entries) {
+            entry.warmSerializedMs = measurePipelineCreationMs(vkDevice, entry.pipelineSettings, serializedCache);
+        }
+        if (persistentCache) {
+            for (auto& entry : entries) {
+                entry.persistentMs = measurePipelineCreationMs(
+                        vkDevice, entry.pipelineSettings, persistentCache->getVkPipelineCache());
+            }
+        }
+        isValid = true;
+    } catch (const std::exception& e) {
+        sgl::Logfile::get()->writeError(std::string() + "Error in runPipelineCacheBenchmark: " + e.what(), false);
+    }
+    if (serializedCache) {
+        vkDestroyPipelineCache(vkDevice, serializedCache, nullptr);
+    }
+    if (memoryCache) {
+        vkDestroyPipelineCache(vkDevice, memoryCache, nullptr);
+    }
+    if (!isValid) {
+        return;
+    }
+
+    ResultTable table({
+            "Types", "Shape", "Cold (ms)", "Warm, in-memory (ms)", "Warm, serialized (ms)", "Persistent (ms)" });
+    PipelineCreationTimes total;
+    for (const auto& entry : entries) {
+        table.addRow({
+                entry.types, entry.shape, formatNumber(entry.coldMs), formatNumber(entry.warmMemoryMs),
+                formatNumber(entry.warmSerializedMs), persistentCache ? formatNumber(entry.persistentMs) : "-" });
+        total.coldMs += entry.coldMs;
+        total.warmMemoryMs += entry.warmMemoryMs;
+        total.warmSerializedMs += entry.warmSerializedMs;
+        total.persistentMs += entry.persistentMs;
+    }
+    table.addRow({
+            "Total", "", formatNumber(total.coldMs), formatNumber(total.warmMemoryMs),
+            formatNumber(total.warmSerializedMs), persistentCache ? formatNumber(total.persistentMs) : "-" });
+    table.print();
+    writeOut("Serialized cache size: ", sgl::getNiceMemoryString(serializedDataSize, 2));
+    writeOut("Note: Cold times can still profit from caches inside the driver (e.g., the shader disk caches of Mesa "
+             "or NVIDIA). The persistent column shows the cache loaded at startup, i.e., warm from the second run on.");
+}
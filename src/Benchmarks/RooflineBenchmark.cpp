@@ -0,0 +1,444 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <filesystem>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <Utils/File/Logfile.hpp>
+#include <Graphics/Vulkan/libs/volk/volk.h>
+#include <Graphics/Vulkan/Utils/Device.hpp>
+
+#include "PrintUtils.hpp"
+#include "ComponentTypes.hpp"
+#include "JsonWriter.hpp"
+#include "SvgPlot.hpp"
+#include "VulkanUtils.hpp"
+#include "Kernels.hpp"
+#include "CoopMatGemm.hpp"
+#include "RooflineBenchmark.hpp"
+
+static const VkDeviceSize MAX_HEAP_BUFFER_SIZE = VkDeviceSize(256) * 1024 * 1024;
+static const uint32_t PEAK_GEMM_SIZE = 4096;
+static const uint32_t GEMM_SWEEP_SIZES[] = { 128, 512, 1024 };
+// Must match SharedMemoryBandwidth.comp.
+static const uint32_t SHARED_MEMORY_WORKGROUP_SIZE = 256;
+static const uint32_t SHARED_MEMORY_SIZE = 2048 * 16;
+static const uint32_t SHARED_MEMORY_NUM_WORKGROUPS = 1024;
+static const uint32_t SHARED_MEMORY_NUM_ITERATIONS = 256;
+
+static std::vector<RooflineKernelRun> recordedKernelRuns;
+
+void addRooflineKernelRun(const RooflineKernelRun& run) {
+    recordedKernelRuns.push_back(run);
+}
+
+void clearRooflineKernelRuns() {
+    recordedKernelRuns.clear();
+}
+
+struct ComputeCeiling {
+    std::string types, shape;
+    CoopMatGemmSettings settings;
+    double teraOpsPerSecond = 0.0;
+};
+
+struct MemoryCeiling {
+    std::string name;
+    uint32_t heapIndex = 0;
+    VkDeviceSize heapSize = 0;
+    bool isDeviceLocal = false;
+    double gibPerSecond = 0.0;
+    [[nodiscard]] double getTeraOpsPerSecondAt(double arithmeticIntensity) const {
+        return gibPerSecond * 1024.0 * 1024.0 * 1024.0 * arithmeticIntensity * 1e-12;
+    }
+};
+
+static double getGemmNumBytes(const CoopMatGemmSettings& settings) {
+    return double(settings.M) * double(settings.K) * double(getComponentTypeSize(settings.AType))
+            + double(settings.K) * double(settings.N) * double(getComponentTypeSize(settings.BType))
+            + double(settings.M) * double(settings.N) * double(getComponentTypeSize(settings.CType))
+            + double(settings.M) * double(settings.N) * double(getComponentTypeSize(settings.ResultType));
+}
+
+/// Best subgroup scope shape per type combination at PEAK_GEMM_SIZE.
+static std::vector<ComputeCeiling> measureComputeCeilings(sgl::vk::Device* device, CommandContext& context) {
+    std::map<std::string, ComputeCeiling> ceilingsMap;
+    for (const auto& props : device->getSupportedCooperativeMatrixPropertiesKHR()) {
+        if (props.scope != VK_SCOPE_SUBGROUP_KHR) {
+            continue;
+        }
+        CoopMatGemmSettings settings = CoopMatGemmSettings::fromProperties(props);
+        settings.M = settings.N = settings.K = PEAK_GEMM_SIZE;
+        std::string types = getTypeCombinationLabel(props);
+        if (!CoopMatGemm::checkSupport(device, settings).empty()) {
+            continue;
+        }
+        try {
+            double teraOpsPerSecond = CoopMatGemm(device, context, settings).measureTeraOpsPerSecond();
+            auto& ceiling = ceilingsMap[types];
+            if (teraOpsPerSecond > ceiling.teraOpsPerSecond) {
+                ceiling.types = types;
+                ceiling.shape = std::to_string(props.MSize) + "x" + std::to_string(props.NSize) + "x"
+                        + std::to_string(props.KSize);
+                ceiling.settings = settings;
+                ceiling.teraOpsPerSecond = teraOpsPerSecond;
+            }
+        } catch (const std::exception& e) {
+            sgl::Logfile::get()->writeError(
+                    std::string() + "Error in runRooflineBenchmark (" + types + "): " + e.what(), false);
+        }
+    }
+    std::vector<ComputeCeiling> ceilings;
+    for (auto& entry : ceilingsMap) {
+        ceilings.push_back(entry.second);
+    }
+    std::sort(ceilings.begin(), ceilings.end(), [](const ComputeCeiling& a, const ComputeCeiling& b) {
+        return a.teraOpsPerSecond > b.teraOpsPerSecond;
+    });
+    return ceilings;
+}
+
+/// Copy bandwidth (read + write) of buffers allocated from each memory heap.
+static std::vector<MemoryCeiling> measureMemoryCeilings(sgl::vk::Device* device, CommandContext& context) {
+    const VkPhysicalDeviceMemoryProperties& memoryProperties = device->getMemoryProperties();
+    std::vector<MemoryCeiling> ceilings;
+    for (uint32_t heapIdx = 0; heapIdx < memoryProperties.memoryHeapCount; heapIdx++) {
+        const VkMemoryHeap& heap = memoryProperties.memoryHeaps[heapIdx];
+        MemoryCeiling ceiling;
+        ceiling.heapIndex = heapIdx;
+        ceiling.heapSize = heap.size;
+        ceiling.isDeviceLocal = (heap.flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0;
+        ceiling.name = "heap " + std::to_string(heapIdx) + (ceiling.isDeviceLocal ? " (device-local)" : " (host)");
+        BufferSettings settings{};
+        settings.size = std::min(MAX_HEAP_BUFFER_SIZE, heap.size / 8 / 4 * 4);
+        settings.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+        settings.memoryTypeBitsMask = 0;
+        for (uint32_t typeIdx = 0; typeIdx < memoryProperties.memoryTypeCount; typeIdx++) {
+            const VkMemoryType& memoryType = memoryProperties.memoryTypes[typeIdx];
+            if (memoryType.heapIndex == heapIdx && (memoryType.propertyFlags & VK_MEMORY_PROPERTY_PROTECTED_BIT) == 0) {
+                settings.memoryTypeBitsMask |= 1u << typeIdx;
+            }
+        }
+        if (settings.memoryTypeBitsMask == 0 || settings.size == 0) {
+            continue;
+        }
+        DeviceBuffer srcBuffer{}, dstBuffer{};
+        VkDevice vkDevice = device->getVkDevice();
+        try {
+            srcBuffer = createDeviceBuffer(vkDevice, memoryProperties, settings);
+            dstBuffer = createDeviceBuffer(vkDevice, memoryProperties, settings);
+            VkBufferCopy bufferCopy{ 0, 0, settings.size };
+            double timeMs = measureCommandsMs(context, [&](VkCommandBuffer commandBuffer) {
+                vkCmdCopyBuffer(commandBuffer, srcBuffer.buffer, dstBuffer.buffer, 1, &bufferCopy);
+            }, 4);
+            ceiling.gibPerSecond = computeGiBPerSecond(2.0 * double(settings.size), timeMs);
+            ceilings.push_back(ceiling);
+        } catch (const std::exception& e) {
+            sgl::Logfile::get()->writeError(
+                    std::string() + "Error in runRooflineBenchmark (" + ceiling.name + "): " + e.what(), false);
+        }
+        destroyDeviceBuffer(vkDevice, srcBuffer);
+        destroyDeviceBuffer(vkDevice, dstBuffer);
+    }
+    return ceilings;
+}
+
+static MemoryCeiling measureSharedMemoryCeiling(sgl::vk::Device* device, CommandContext& context) {
+    MemoryCeiling ceiling;
+    ceiling.name = "shared memory";
+    if (device->getPhysicalDeviceProperties().limits.maxComputeSharedMemorySize < SHARED_MEMORY_SIZE) {
+        throw std::runtime_error("maxComputeSharedMemorySize is below the size used by the kernel.");
+    }
+    const EmbeddedKernel* kernel = findEmbeddedKernel("SharedMemoryBandwidth", "default");
+    if (!kernel) {
+        throw std::runtime_error("SharedMemoryBandwidth kernel is not available.");
+    }
+    ComputePipelineSettings pipelineSettings{};
+    pipelineSettings.code = kernel->code;
+    pipelineSettings.codeSize = kernel->codeSize;
+    pipelineSettings.specializationConstants = { SHARED_MEMORY_WORKGROUP_SIZE };
+    pipelineSettings.pushConstantSize = sizeof(VkDeviceAddress) + sizeof(uint32_t);
+    ComputePipeline pipeline(device->getVkDevice(), pipelineSettings);
+
+    const uint32_t numWorkgroups = getReducedProblemSize(SHARED_MEMORY_NUM_WORKGROUPS);
+    DeviceBuffer outputBuffer = createDeviceBuffer(
+            device, VkDeviceSize(numWorkgroups) * SHARED_MEMORY_WORKGROUP_SIZE * 16,
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    struct {
+        VkDeviceAddress outputBuffer;
+        uint32_t numIterations;
+    } pushConstants{ outputBuffer.deviceAddress, SHARED_MEMORY_NUM_ITERATIONS };
+    try {
+        double timeMs = measureCommandsMs(context, [&](VkCommandBuffer commandBuffer) {
+            pipeline.bind(commandBuffer);
+            pipeline.pushConstants(commandBuffer, &pushConstants, pipelineSettings.pushConstantSize);
+            vkCmdDispatch(commandBuffer, numWorkgroups, 1, 1);
+        });
+        // Four vec4 reads per invocation and iteration.
+        double numBytes = double(numWorkgroups) * double(SHARED_MEMORY_WORKGROUP_SIZE)
+                * double(SHARED_MEMORY_NUM_ITERATIONS) * 4.0 * 16.0;
+        ceiling.gibPerSecond = computeGiBPerSecond(numBytes, timeMs);
+    } catch (...) {
+        destroyDeviceBuffer(device->getVkDevice(), outputBuffer);
+        throw;
+    }
+    destroyDeviceBuffer(device->getVkDevice(), outputBuffer);
+    return ceiling;
+}
+
+/// GEMMs of growing size with the best shape of each type combination, from memory bound to compute bound.
+static std::vector<RooflineKernelRun> measureGemmRuns(
+        sgl::vk::Device* device, CommandContext& context, const std::vector<ComputeCeiling>& computeCeilings) {
+    std::vector<RooflineKernelRun> runs;
+    for (const auto& ceiling : computeCeilings) {
+        std::vector<uint32_t> sizes(std::begin(GEMM_SWEEP_SIZES), std::end(GEMM_SWEEP_SIZES));
+        sizes.push_back(PEAK_GEMM_SIZE);
+        for (uint32_t size : sizes) {
+            CoopMatGemmSettings settings = ceiling.settings;
+            settings.M = settings.N = settings.K = size;
+            RooflineKernelRun run;
+            run.category = "GEMM";
+            run.label = "gemm " + ceiling.types + " " + std::to_string(size);
+            run.types = ceiling.types;
+            try {
+                CoopMatGemm gemm(device, context, settings);
+                // The problem size is rounded up to multiples of the tile sizes.
+                run.numOperations = gemm.getNumOperations();
+                run.numBytes = getGemmNumBytes(gemm.getSettings());
+                run.timeMs = run.numOperations / (gemm.measureTeraOpsPerSecond() * 1e9);
+                runs.push_back(run);
+            } catch (const std::exception& e) {
+                sgl::Logfile::get()->writeError(
+                        std::string() + "Error in runRooflineBenchmark (" + run.label + "): " + e.what(), false);
+            }
+        }
+    }
+    return runs;
+}
+
+static void writeJsonReport(
+        const std::string& filePath, sgl::vk::Device* device, const std::vector<ComputeCeiling>& computeCeilings,
+        const std::vector<MemoryCeiling>& memoryCeilings, const MemoryCeiling* sharedMemoryCeiling,
+        const std::vector<RooflineKernelRun>& runs, const std::vector<double>& attainableTeraOpsPerSecond,
+        const std::vector<std::string>& bounds) {
+    JsonWriter writer;
+    writer.beginObject();
+    writer.keyValue("device", std::string(device->getPhysicalDeviceProperties().deviceName));
+    writer.key("computeCeilings");
+    writer.beginArray();
+    for (const auto& ceiling : computeCeilings) {
+        writer.beginObject();
+        writer.keyValue("types", ceiling.types);
+        writer.keyValue("shape", ceiling.shape);
+        writer.keyValue("teraOpsPerSecond", ceiling.teraOpsPerSecond);
+        writer.endObject();
+    }
+    writer.endArray();
+    writer.key("memoryCeilings");
+    writer.beginArray();
+    for (const auto& ceiling : memoryCeilings) {
+        writer.beginObject();
+        writer.keyValue("name", ceiling.name);
+        writer.keyValue("heapIndex", ceiling.heapIndex);
+        writer.keyValue("heapSize", uint64_t(ceiling.heapSize));
+        writer.keyValue("deviceLocal", ceiling.isDeviceLocal);
+        writer.keyValue("gibPerSecond", ceiling.gibPerSecond);
+        writer.endObject();
+    }
+    writer.endArray();
+    writer.key("sharedMemoryGiBPerSecond");
+    if (sharedMemoryCeiling) {
+        writer.value(sharedMemoryCeiling->gibPerSecond);
+    } else {
+        writer.valueNull();
+    }
+    writer.key("kernels");
+    writer.beginArray();
+    for (size_t runIdx = 0; runIdx < runs.size(); runIdx++) {
+        const auto& run = runs.at(runIdx);
+        writer.beginObject();
+        writer.keyValue("category", run.category);
+        writer.keyValue("label", run.label);
+        writer.keyValue("types", run.types);
+        writer.keyValue("operations", run.numOperations);
+        writer.keyValue("bytes", run.numBytes);
+        writer.keyValue("timeMs", run.timeMs);
+        writer.keyValue("arithmeticIntensity", run.numOperations / run.numBytes);
+        writer.keyValue("teraOpsPerSecond", run.numOperations / (run.timeMs * 1e9));
+        writer.keyValue("attainableTeraOpsPerSecond", attainableTeraOpsPerSecond.at(runIdx));
+        writer.keyValue("bound", bounds.at(runIdx));
+        writer.endObject();
+    }
+    writer.endArray();
+    writer.endObject();
+    if (!writer.save(filePath)) {
+        sgl::Logfile::get()->writeError("Error in runRooflineBenchmark: Could not write " + filePath, false);
+    }
+}
+
+void runRooflineBenchmark(size_t deviceIdx, sgl::vk::Device* device, const std::string& reportDirectory) {
+    writeOut("");
+    writeOut("Roofline benchmark:");
+    std::vector<RooflineKernelRun> runs = std::move(recordedKernelRuns);
+    recordedKernelRuns.clear();
+
+    std::vector<ComputeCeiling> computeCeilings;
+    std::vector<MemoryCeiling> memoryCeilings;
+    MemoryCeiling sharedMemoryCeiling;
+    bool hasSharedMemoryCeiling = false;
+    try {
+        CommandContext context(device);
+        if (device->getCooperativeMatrixFeaturesKHR().cooperativeMatrix) {
+            computeCeilings = measureComputeCeilings(device, context);
+        } else {
+            writeOut("VK_KHR_cooperative_matrix is not supported; only memory ceilings are measured.");
+        }
+        memoryCeilings = measureMemoryCeilings(device, context);
+        try {
+            sharedMemoryCeiling = measureSharedMemoryCeiling(device, context);
+            hasSharedMemoryCeiling = true;
+        } catch (const std::exception& e) {
+            sgl::Logfile::get()->writeError(
+                    std::string() + "Error in runRooflineBenchmark (shared memory): " + e.what(), false);
+        }
+        std::vector<RooflineKernelRun> gemmRuns = measureGemmRuns(device, context, computeCeilings);
+        runs.insert(runs.begin(), gemmRuns.begin(), gemmRuns.end());
+    } catch (const std::exception& e) {
+        sgl::Logfile::get()->writeError(std::string() + "Error in runRooflineBenchmark: " + e.what(), false);
+        return;
+    }
+
+    ResultTable ceilingTable({ "Ceiling", "Shape", "Peak" });
+    for (const auto& ceiling : computeCeilings) {
+        ceilingTable.addRow({ ceiling.types, ceiling.shape, formatNumber(ceiling.teraOpsPerSecond) + " TOP/s" });
+    }
+    for (const auto& ceiling : memoryCeilings) {
+        ceilingTable.addRow({
+                ceiling.name + ", " + sgl::getNiceMemoryString(ceiling.heapSize, 2), "-",
+                formatNumber(ceiling.gibPerSecond) + " GiB/s" });
+    }
+    if (hasSharedMemoryCeiling) {
+        ceilingTable.addRow({
+                sharedMemoryCeiling.name, "-", formatNumber(sharedMemoryCeiling.gibPerSecond) + " GiB/s" });
+    }
+    ceilingTable.print();
+
+    // Kernels are bounded by the fastest device-local heap and the peak of their type combination.
+    const MemoryCeiling* dramCeiling = nullptr;
+    for (const auto& ceiling : memoryCeilings) {
+        bool isBetter = !dramCeiling || (ceiling.isDeviceLocal != dramCeiling->isDeviceLocal
+                ? ceiling.isDeviceLocal : ceiling.gibPerSecond > dramCeiling->gibPerSecond);
+        if (isBetter) {
+            dramCeiling = &ceiling;
+        }
+    }
+    auto getPeakTeraOpsPerSecond = [&](const std::string& types) {
+        for (const auto& ceiling : computeCeilings) {
+            if (ceiling.types == types) {
+                return ceiling.teraOpsPerSecond;
+            }
+        }
+        return computeCeilings.empty() ? 0.0 : computeCeilings.front().teraOpsPerSecond;
+    };
+    std::vector<double> attainableTeraOpsPerSecond;
+    std::vector<std::string> bounds;
+    ResultTable kernelTable({ "Kernel", "Ops/byte", "TOP/s", "Attainable TOP/s", "Of roofline", "Bound" });
+    for (const auto& run : runs) {
+        double intensity = run.numOperations / run.numBytes;
+        double teraOpsPerSecond = run.numOperations / (run.timeMs * 1e9);
+        double computeBound = getPeakTeraOpsPerSecond(run.types);
+        double memoryBound = dramCeiling ? dramCeiling->getTeraOpsPerSecondAt(intensity) : computeBound;
+        double attainable = std::min(computeBound, memoryBound);
+        std::string bound = memoryBound < computeBound ? "memory" : "compute";
+        attainableTeraOpsPerSecond.push_back(attainable);
+        bounds.push_back(bound);
+        kernelTable.addRow({
+                run.label, formatNumber(intensity, 1), formatNumber(teraOpsPerSecond), formatNumber(attainable),
+                attainable > 0.0 ? formatNumber(100.0 * teraOpsPerSecond / attainable, 1) + "%" : "-", bound });
+    }
+    kernelTable.print();
+
+    std::error_code errorCode;
+    std::filesystem::create_directories(reportDirectory, errorCode);
+    const std::string baseFilePath =
+            (std::filesystem::path(reportDirectory) / ("Roofline_" + std::to_string(deviceIdx))).string();
+    writeJsonReport(
+            baseFilePath + ".json", device, computeCeilings, memoryCeilings,
+            hasSharedMemoryCeiling ? &sharedMemoryCeiling : nullptr, runs, attainableTeraOpsPerSecond, bounds);
+
+    // Ceilings span the intensity range of the kernels with some margin around the ridge points.
+    double minIntensity = 0.25, maxIntensity = 1000.0;
+    for (const auto& run : runs) {
+        minIntensity = std::min(minIntensity, 0.5 * run.numOperations / run.numBytes);
+        maxIntensity = std::max(maxIntensity, 2.0 * run.numOperations / run.numBytes);
+    }
+    double maxPeak = computeCeilings.empty() ? 0.0 : computeCeilings.front().teraOpsPerSecond;
+    SvgPlot plot(
+            std::string("Roofline: ") + device->getPhysicalDeviceProperties().deviceName,
+            "Arithmetic intensity (operations/byte)", "TOP/s", true, true);
+    auto addMemoryCeiling = [&](const MemoryCeiling& ceiling) {
+        double ridgeIntensity = maxPeak > 0.0 ? maxPeak / ceiling.getTeraOpsPerSecondAt(1.0) : maxIntensity;
+        ridgeIntensity = std::clamp(ridgeIntensity, minIntensity, maxIntensity);
+        plot.addPolyline(
+                { { minIntensity, ceiling.getTeraOpsPerSecondAt(minIntensity) },
+                  { ridgeIntensity, ceiling.getTeraOpsPerSecondAt(ridgeIntensity) } },
+                ceiling.name);
+    };
+    for (const auto& ceiling : memoryCeilings) {
+        addMemoryCeiling(ceiling);
+    }
+    if (hasSharedMemoryCeiling) {
+        addMemoryCeiling(sharedMemoryCeiling);
+    }
+    for (const auto& ceiling : computeCeilings) {
+        double ridgeIntensity = dramCeiling
+                ? ceiling.teraOpsPerSecond / dramCeiling->getTeraOpsPerSecondAt(1.0) : minIntensity;
+        plot.addPolyline(
+                { { std::clamp(ridgeIntensity, minIntensity, maxIntensity), ceiling.teraOpsPerSecond },
+                  { maxIntensity, ceiling.teraOpsPerSecond } },
+                ceiling.types);
+    }
+    for (size_t runIdx = 0; runIdx < runs.size(); runIdx++) {
+        const auto& run = runs.at(runIdx);
+        plot.addPoint(
+                run.numOperations / run.numBytes, run.numOperations / (run.timeMs * 1e9), run.label,
+                bounds.at(runIdx) == "memory");
+    }
+    if (plot.save(baseFilePath + ".svg")) {
+        writeOut("Wrote the roofline to ", baseFilePath, ".svg and ", baseFilePath,
+                 ".json (memory bound kernels in red).");
+    } else {
+        sgl::Logfile::get()->writeError(
+                "Error in runRooflineBenchmark: Could not write " + baseFilePath + ".svg", false);
+    }
+}
@@ -0,0 +1,64 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef QUERYVKCOOPMAT_ROOFLINEBENCHMARK_HPP
+#define QUERYVKCOOPMAT_ROOFLINEBENCHMARK_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace sgl { namespace vk {
+class Device;
+}}
+
+/// A measured kernel execution to be placed on the roofline by its arithmetic intensity.
+struct RooflineKernelRun {
+    std::string category; ///< "GEMM", "Convolution" or "Attention".
+    std::string label;
+    std::string types; ///< Type combination (e.g., "f16*f16+f32->f32") for picking the matching compute ceiling.
+    double numOperations = 0.0;
+    double numBytes = 0.0; ///< DRAM traffic of the kernel.
+    double timeMs = 0.0;
+};
+
+/**
+ * Called by the convolution and attention modes for their measurements. The runs are placed on the roofline by the
+ * next call of runRooflineBenchmark, and are discarded by clearRooflineKernelRuns (e.g., when switching devices).
+ */
+void addRooflineKernelRun(const RooflineKernelRun& run);
+void clearRooflineKernelRuns();
+
+/**
+ * Measures the peak cooperative matrix throughput per type combination, the copy bandwidth of each memory heap and the
+ * shared memory bandwidth, and places GEMMs of growing size and the recorded kernel runs on the resulting roofline.
+ * Writes Roofline_<device index>.json and Roofline_<device index>.svg to the report directory.
+ */
+void runRooflineBenchmark(size_t deviceIdx, sgl::vk::Device* device, const std::string& reportDirectory);
+
+#endif //QUERYVKCOOPMAT_ROOFLINEBENCHMARK_HPP
@@ -0,0 +1,303 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <Utils/File/Logfile.hpp>
+#include <Graphics/Vulkan/Utils/Device.hpp>
+
+#include "PrintUtils.hpp"
+#include "ComponentTypes.hpp"
+#include "NumberFormats.hpp"
+#include "VulkanUtils.hpp"
+#include "CoopMatGemm.hpp"
+#include "SaturationBenchmark.hpp"
+
+// Problem size for the overflow characterization (the CPU reference needs M * N * K operations).
+static const uint32_t OVERFLOW_SIZE_MN = 128;
+static const uint32_t OVERFLOW_SIZE_K = 2048;
+
+enum class ActivationDistribution {
+    RELU, GAUSSIAN, EXTREME, LARGE_BIAS
+};
+static const ActivationDistribution ACTIVATION_DISTRIBUTIONS[] = {
+        ActivationDistribution::RELU, ActivationDistribution::GAUSSIAN, ActivationDistribution::EXTREME,
+        ActivationDistribution::LARGE_BIAS
+};
+static const char* const ACTIVATION_DISTRIBUTION_NAMES[] = {
+        "ReLU activations", "Gaussian", "extreme values", "ReLU + large bias"
+};
+
+struct OverflowStatistics {
+    size_t numElements = 0;
+    size_t numOverflowed = 0; ///< The exact result is out of range of the result type.
+    size_t numSaturated = 0; ///< Overflowed, and the result was clamped to the range.
+    size_t numWrapped = 0; ///< Overflowed, and the result wrapped around.
+    size_t numMismatches = 0; ///< Neither of the above (e.g., saturation of intermediate sums).
+};
+
+static void getIntegerRange(VkComponentTypeKHR compType, double& minValue, double& maxValue) {
+    const int numBits = int(getComponentTypeSize(compType)) * 8;
+    if (getIsComponentTypeSigned(compType)) {
+        minValue = -std::ldexp(1.0, numBits - 1);
+        maxValue = std::ldexp(1.0, numBits - 1) - 1.0;
+    } else {
+        minValue = 0.0;
+        maxValue = std::ldexp(1.0, numBits) - 1.0;
+    }
+}
+
+static double wrapToIntegerRange(VkComponentTypeKHR compType, double value) {
+    const int numBits = int(getComponentTypeSize(compType)) * 8;
+    const double modulus = std::ldexp(1.0, numBits);
+    double wrapped = std::fmod(value, modulus);
+    if (wrapped < 0.0) {
+        wrapped += modulus;
+    }
+    if (getIsComponentTypeSigned(compType) && wrapped >= modulus / 2.0) {
+        wrapped -= modulus;
+    }
+    return wrapped;
+}
+
+/**
+ * Activations (A) are post-ReLU (half zeros) or Gaussian, weights (B) are Gaussian around the center of their range.
+ * The extreme and large bias distributions push the sums beyond the range of the accumulator via the bias (C), as the
+ * products of 8-bit values only overflow 32-bit accumulators for K > 2^17.
+ */
+static std::vector<double> generateValues(
+        VkComponentTypeKHR compType, size_t numElements, char matrixName, ActivationDistribution distribution,
+        uint32_t seed) {
+    double minValue, maxValue;
+    getIntegerRange(compType, minValue, maxValue);
+    const double center = getIsComponentTypeSigned(compType) ? 0.0 : (maxValue + 1.0) / 2.0;
+    const double halfRange = (maxValue - minValue) / 2.0;
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<double> unitDistribution(0.0, 1.0);
+    std::normal_distribution<double> normalDistribution(0.0, 1.0);
+    auto clampValue = [&](double value) { return std::clamp(std::round(value), minValue, maxValue); };
+
+    std::vector<double> values(numElements, 0.0);
+    if (matrixName == 'C') {
+        if (distribution == ActivationDistribution::EXTREME) {
+            std::fill(values.begin(), values.end(), maxValue);
+        } else if (distribution == ActivationDistribution::LARGE_BIAS) {
+            for (double& value : values) {
+                double limit = getIsComponentTypeSigned(compType) && unitDistribution(generator) < 0.5
+                        ? minValue : maxValue;
+                double offset = std::floor(unitDistribution(generator) * 4194304.0);
+                value = limit == minValue ? limit + offset : limit - offset;
+            }
+        }
+        return values;
+    }
+    for (double& value : values) {
+        if (distribution == ActivationDistribution::EXTREME) {
+            value = maxValue;
+        } else if (matrixName == 'A' && distribution != ActivationDistribution::GAUSSIAN) {
+            bool isZero = unitDistribution(generator) < 0.5;
+            value = isZero ? 0.0 : clampValue(std::fabs(normalDistribution(generator)) * halfRange / 4.0);
+        } else {
+            double sigma = distribution == ActivationDistribution::GAUSSIAN ? halfRange / 3.0 : halfRange / 4.0;
+            value = clampValue(center + normalDistribution(generator) * sigma);
+        }
+    }
+    return values;
+}
+
+static std::vector<uint8_t> toElementData(VkComponentTypeKHR compType, const std::vector<double>& values) {
+    std::vector<uint8_t> data(values.size() * getComponentTypeSize(compType));
+    for (size_t i = 0; i < values.size(); i++) {
+        writeElement(data.data(), compType, i, values.at(i));
+    }
+    return data;
+}
+
+static OverflowStatistics characterizeOverflow(CoopMatGemm& gemm, ActivationDistribution distribution) {
+    const CoopMatGemmSettings& settings = gemm.getSettings();
+    const size_t M = settings.M, N = settings.N, K = settings.K;
+    std::vector<double> A = generateValues(settings.AType, M * K, 'A', distribution, 1);
+    std::vector<double> B = generateValues(settings.BType, K * N, 'B', distribution, 2);
+    std::vector<double> C = generateValues(settings.CType, M * N, 'C', distribution, 3);
+    gemm.setInputs(
+            toElementData(settings.AType, A), toElementData(settings.BType, B), toElementData(settings.CType, C));
+    gemm.measureTeraOpsPerSecond(1);
+    std::vector<uint8_t> result = gemm.downloadResult();
+
+    // All intermediate values are integers below 2^53, so the double precision reference is exact.
+    std::vector<double> reference = C;
+    for (size_t i = 0; i < M; i++) {
+        for (size_t k = 0; k < K; k++) {
+            const double a = A[i * K + k];
+            for (size_t j = 0; j < N; j++) {
+                reference[i * N + j] += a * B[k * N + j];
+            }
+        }
+    }
+
+    double minValue, maxValue;
+    getIntegerRange(settings.ResultType, minValue, maxValue);
+    OverflowStatistics statistics{};
+    statistics.numElements = M * N;
+    for (size_t i = 0; i < M * N; i++) {
+        double value = readElement(result.data(), settings.ResultType, i);
+        double referenceValue = reference.at(i);
+        if (referenceValue >= minValue && referenceValue <= maxValue) {
+            if (value != referenceValue) {
+                statistics.numMismatches++;
+            }
+            continue;
+        }
+        statistics.numOverflowed++;
+        if (value == std::clamp(referenceValue, minValue, maxValue)) {
+            statistics.numSaturated++;
+        } else if (value == wrapToIntegerRange(settings.ResultType, referenceValue)) {
+            statistics.numWrapped++;
+        } else {
+            statistics.numMismatches++;
+        }
+    }
+    return statistics;
+}
+
+/// Throughput of the entries with and without saturating accumulation (negative if not available).
+struct ThroughputPair {
+    double wrapping = -1.0;
+    double saturating = -1.0;
+    std::string wrappingNote = "-";
+    std::string saturatingNote = "-";
+};
+
+static std::string formatPercentage(size_t count, size_t total) {
+    return formatNumber(total == 0 ? 0.0 : 100.0 * double(count) / double(total), 2) + "%";
+}
+
+void runSaturationBenchmark(sgl::vk::Device* device) {
+    writeOut("");
+    writeOut("Saturating integer accumulation benchmark:");
+    if (!device->getCooperativeMatrixFeaturesKHR().cooperativeMatrix) {
+        writeOut("VK_KHR_cooperative_matrix is not supported.");
+        return;
+    }
+
+    // Entries with the same types and shape, with and without saturating accumulation.
+    using EntryKey = std::tuple<VkComponentTypeKHR, VkComponentTypeKHR, VkComponentTypeKHR, VkComponentTypeKHR,
+            uint32_t, uint32_t, uint32_t>;
+    std::map<EntryKey, ThroughputPair> throughputs;
+    std::vector<EntryKey> entryOrder;
+    ResultTable overflowTable({
+            "Types", "M x N x K", "Saturating", "Inputs", "Overflowed", "Saturated", "Wrapped", "Other mismatch" });
+    try {
+        CommandContext context(device);
+        for (const auto& props : device->getSupportedCooperativeMatrixPropertiesKHR()) {
+            if (props.scope != VK_SCOPE_SUBGROUP_KHR || !getIsComponentTypeInteger(props.AType)
+                    || getComponentTypeSize(props.AType) != 1 || getComponentTypeSize(props.BType) != 1) {
+                continue;
+            }
+            EntryKey key(props.AType, props.BType, props.CType, props.ResultType, props.MSize, props.NSize, props.KSize);
+            if (throughputs.find(key) == throughputs.end()) {
+                entryOrder.push_back(key);
+            }
+            ThroughputPair& throughputPair = throughputs[key];
+            double& throughput = props.saturatingAccumulation ? throughputPair.saturating : throughputPair.wrapping;
+            std::string& throughputNote =
+                    props.saturatingAccumulation ? throughputPair.saturatingNote : throughputPair.wrappingNote;
+            std::string typesString =
+                    getComponentTypeString(props.AType) + " * " + getComponentTypeString(props.BType) + " + "
+                    + getComponentTypeString(props.CType) + " -> " + getComponentTypeString(props.ResultType);
+            std::string shapeString =
+                    std::to_string(props.MSize) + "x" + std::to_string(props.NSize) + "x" + std::to_string(props.KSize);
+
+            CoopMatGemmSettings settings = CoopMatGemmSettings::fromProperties(props);
+            std::string unsupportedReason = CoopMatGemm::checkSupport(device, settings);
+            if (!unsupportedReason.empty()) {
+                throughputNote = unsupportedReason;
+                continue;
+            }
+            try {
+                throughput = CoopMatGemm(device, context, settings).measureTeraOpsPerSecond();
+                throughputNote = formatNumber(throughput);
+                settings.M = OVERFLOW_SIZE_MN;
+                settings.N = OVERFLOW_SIZE_MN;
+                settings.K = OVERFLOW_SIZE_K;
+                CoopMatGemm gemm(device, context, settings);
+                for (size_t distributionIdx = 0; distributionIdx < 4; distributionIdx++) {
+                    OverflowStatistics statistics =
+                            characterizeOverflow(gemm, ACTIVATION_DISTRIBUTIONS[distributionIdx]);
+                    overflowTable.addRow({
+                            typesString, shapeString, sgl::toString(bool(props.saturatingAccumulation)),
+                            ACTIVATION_DISTRIBUTION_NAMES[distributionIdx],
+                            formatPercentage(statistics.numOverflowed, statistics.numElements),
+                            formatPercentage(statistics.numSaturated, statistics.numOverflowed),
+                            formatPercentage(statistics.numWrapped, statistics.numOverflowed),
+                            std::to_string(statistics.numMismatches) });
+                }
+            } catch (const std::exception& e) {
+                sgl::Logfile::get()->writeError(
+                        std::string() + "Error in runSaturationBenchmark (" + typesString + "): " + e.what(), false);
+                throughput = -1.0;
+                throughputNote = "failed";
+            }
+        }
+    } catch (const std::exception& e) {
+        sgl::Logfile::get()->writeError(std::string() + "Error in runSaturationBenchmark: " + e.what(), false);
+    }
+
+    if (entryOrder.empty()) {
+        writeOut("No 8-bit integer cooperative matrix configurations are supported.");
+        return;
+    }
+    writeOut("Throughput (TOP/s) with and without saturating accumulation:");
+    ResultTable throughputTable({ "Types", "M x N x K", "Wrapping", "Saturating", "Delta" });
+    for (const auto& key : entryOrder) {
+        const ThroughputPair& throughputPair = throughputs[key];
+        std::string delta = "-";
+        if (throughputPair.wrapping > 0.0 && throughputPair.saturating > 0.0) {
+            delta = formatNumber(
+                    100.0 * (throughputPair.saturating - throughputPair.wrapping) / throughputPair.wrapping, 1) + "%";
+        }
+        throughputTable.addRow({
+                getComponentTypeString(std::get<0>(key)) + " * " + getComponentTypeString(std::get<1>(key)) + " + "
+                + getComponentTypeString(std::get<2>(key)) + " -> " + getComponentTypeString(std::get<3>(key)),
+                std::to_string(std::get<4>(key)) + "x" + std::to_string(std::get<5>(key)) + "x"
+                + std::to_string(std::get<6>(key)),
+                throughputPair.wrappingNote, throughputPair.saturatingNote, delta });
+    }
+    throughputTable.print();
+    writeOut("Overflow characterization (", OVERFLOW_SIZE_MN, "x", OVERFLOW_SIZE_MN, "x", OVERFLOW_SIZE_K,
+             " GEMM; saturated/wrapped relative to the overflowed outputs):");
+    overflowTable.print();
+}
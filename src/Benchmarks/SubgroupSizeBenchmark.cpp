@@ -0,0 +1,116 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <Utils/File/Logfile.hpp>
+#include <Graphics/Vulkan/Utils/Device.hpp>
+
+#include "PrintUtils.hpp"
+#include "ComponentTypes.hpp"
+#include "VulkanUtils.hpp"
+#include "CoopMatGemm.hpp"
+#include "SubgroupSizeBenchmark.hpp"
+
+/// Returns the throughput in TOP/s as a string, or the reason why the configuration could not be run.
+static std::string measureGemm(sgl::vk::Device* device, CommandContext& context, const CoopMatGemmSettings& settings) {
+    try {
+        CoopMatGemm gemm(device, context, settings);
+        return formatNumber(gemm.measureTeraOpsPerSecond());
+    } catch (const std::exception& e) {
+        sgl::Logfile::get()->writeError(
+                std::string() + "Error in runSubgroupSizeBenchmark (" + CoopMatGemm::getVariantName(settings)
+                + ", subgroup size " + std::to_string(settings.requiredSubgroupSize) + "): " + e.what(), false);
+        return "failed";
+    }
+}
+
+void runSubgroupSizeBenchmark(sgl::vk::Device* device) {
+    writeOut("");
+    writeOut("Subgroup size benchmark (GEMM, TOP/s):");
+    if (!device->getCooperativeMatrixFeaturesKHR().cooperativeMatrix) {
+        writeOut("VK_KHR_cooperative_matrix is not supported.");
+        return;
+    }
+    const auto& properties13 = device->getPhysicalDeviceVulkan13Properties();
+    if (!device->getPhysicalDeviceVulkan13Features().subgroupSizeControl
+            || (properties13.requiredSubgroupSizeStages & VK_SHADER_STAGE_COMPUTE_BIT) == 0) {
+        writeOut("Subgroup size control is not supported for compute shaders.");
+        return;
+    }
+
+    std::vector<uint32_t> subgroupSizes;
+    for (uint32_t size = properties13.minSubgroupSize; size <= properties13.maxSubgroupSize; size *= 2) {
+        subgroupSizes.push_back(size);
+    }
+    // The other GEMM benchmarks pin the size reported in VkPhysicalDeviceSubgroupProperties (see CoopMatGemm).
+    const uint32_t reportedSubgroupSize = device->getPhysicalDeviceSubgroupProperties().subgroupSize;
+    std::vector<std::string> columnNames = { "M x N x K", "A", "B", "C", "Result" };
+    for (uint32_t size : subgroupSizes) {
+        columnNames.push_back(
+                "size " + std::to_string(size) + (size == reportedSubgroupSize ? " (reported)" : ""));
+    }
+    ResultTable table(columnNames);
+
+    try {
+        CommandContext context(device);
+        for (const auto& props : device->getSupportedCooperativeMatrixPropertiesKHR()) {
+            if (props.scope != VK_SCOPE_SUBGROUP_KHR) {
+                continue;
+            }
+            CoopMatGemmSettings settings = CoopMatGemmSettings::fromProperties(props);
+            std::vector<std::string> row = {
+                    std::to_string(props.MSize) + "x" + std::to_string(props.NSize) + "x" + std::to_string(props.KSize),
+                    getComponentTypeString(props.AType), getComponentTypeString(props.BType),
+                    getComponentTypeString(props.CType), getComponentTypeString(props.ResultType) };
+            std::string unsupportedReason = CoopMatGemm::checkSupport(device, settings);
+            if (!unsupportedReason.empty()) {
+                row.resize(columnNames.size(), unsupportedReason);
+                table.addRow(row);
+                continue;
+            }
+            auto measureWithSubgroupSize = [&](uint32_t size) {
+                settings.requiredSubgroupSize = size;
+                if (settings.subgroupsPerWorkgroup > properties13.maxComputeWorkgroupSubgroups
+                        || size * settings.subgroupsPerWorkgroup > device->getLimits().maxComputeWorkGroupInvocations) {
+                    return std::string("n/a");
+                }
+                return measureGemm(device, context, settings);
+            };
+            for (uint32_t size : subgroupSizes) {
+                row.push_back(measureWithSubgroupSize(size));
+            }
+            table.addRow(row);
+        }
+    } catch (const std::exception& e) {
+        sgl::Logfile::get()->writeError(std::string() + "Error in runSubgroupSizeBenchmark: " + e.what(), false);
+    }
+    table.print();
+}
@@ -0,0 +1,768 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <Utils/File/Logfile.hpp>
+
+#include "PrintUtils.hpp"
+#include "ComponentTypes.hpp"
+#include "JsonWriter.hpp"
+#include "QueryVkCoopMat.h"
+#include "CapabilityDaemon.hpp"
+
+static const int DRIVER_CHECK_INTERVAL_MS = 2000;
+static const size_t MAX_REQUEST_SIZE = 4096;
+static const int MAX_EPOLL_EVENTS = 64;
+
+/// Pre-serialized responses; rebuilt when the instance is (re-)created.
+struct CapabilityCache {
+    std::vector<std::string> deviceResponses;
+    std::string devicesResponse;
+    std::string allResponse;
+    uint64_t generation = 0;
+};
+
+struct DaemonClient {
+    std::string input;
+    std::string output;
+    size_t outputOffset = 0;
+    bool shallClose = false; ///< After the output has been sent.
+    uint64_t awaitedRefresh = 0; ///< Number of the refresh answering the pending "refresh" request; 0 if none.
+};
+
+/// A refresh built on the worker thread. The event loop only accesses it while no worker thread is running.
+struct CapabilityRefresh {
+    std::string reason;
+    std::string driverFingerprint; ///< Of the driver files when the refresh was started.
+    QvcmContext context = nullptr;
+    CapabilityCache cache;
+    std::string errorMessage;
+    bool isSuccessful = false;
+};
+
+std::string getDefaultDaemonSocketPath() {
+    const char* runtimeDirectory = std::getenv("XDG_RUNTIME_DIR");
+    if (runtimeDirectory && runtimeDirectory[0] != '\0') {
+        return std::string(runtimeDirectory) + "/queryvkcoopmat.sock";
+    }
+    return "/tmp/queryvkcoopmat-" + std::to_string(getuid()) + ".sock";
+}
+
+static std::string uuidToHex(const uint8_t* uuid) {
+    static const char* hexDigits = "0123456789abcdef";
+    std::string hex;
+    for (int i = 0; i < QVCM_UUID_SIZE; i++) {
+        hex += hexDigits[uuid[i] >> 4];
+        hex += hexDigits[uuid[i] & 0xF];
+    }
+    return hex;
+}
+
+/// Calls an array query of the C API with the two-call idiom; unsupported extensions yield an empty array.
+template<class T, class F>
+static std::vector<T> queryArray(const F& queryFunction) {
+    uint32_t count = 0;
+    if (queryFunction(&count, nullptr) != QVCM_SUCCESS) {
+        return {};
+    }
+    std::vector<T> elements(count);
+    QvcmResult result = queryFunction(&count, elements.data());
+    if (result != QVCM_SUCCESS && result != QVCM_INCOMPLETE) {
+        return {};
+    }
+    elements.resize(count);
+    return elements;
+}
+
+static void writeDeviceIdentityJson(JsonWriter& writer, size_t deviceIdx, const QvcmDeviceIdentity& identity) {
+    writer.keyValue("index", uint64_t(deviceIdx));
+    writer.keyValue("deviceName", std::string(identity.deviceName));
+    writer.keyValue("driverName", std::string(identity.driverName));
+    writer.keyValue("driverInfo", std::string(identity.driverInfo));
+    writer.keyValue("apiVersion", identity.apiVersion);
+    writer.keyValue("driverVersion", identity.driverVersion);
+    writer.keyValue("vendorID", identity.vendorID);
+    writer.keyValue("deviceID", identity.deviceID);
+    writer.keyValue("driverID", int32_t(identity.driverID));
+    writer.keyValue("deviceUUID", uuidToHex(identity.deviceUUID));
+    writer.keyValue("driverUUID", uuidToHex(identity.driverUUID));
+}
+
+static void writeDeviceJson(
+        JsonWriter& writer, QvcmContext context, VkPhysicalDevice physicalDevice, size_t deviceIdx) {
+    QvcmDeviceIdentity identity{};
+    qvcmGetDeviceIdentity(context, physicalDevice, &identity);
+    writer.beginObject();
+    writeDeviceIdentityJson(writer, deviceIdx, identity);
+
+    writer.key("cooperativeMatrix");
+    writer.beginArray();
+    auto coopMatProperties = queryArray<QvcmCooperativeMatrixProperties>(
+            [&](uint32_t* count, QvcmCooperativeMatrixProperties* properties) {
+                return qvcmGetCooperativeMatrixProperties(context, physicalDevice, count, properties);
+            });
+    for (const auto& props : coopMatProperties) {
+        writer.beginObject();
+        writer.keyValue("MSize", props.MSize);
+        writer.keyValue("NSize", props.NSize);
+        writer.keyValue("KSize", props.KSize);
+        writer.keyValue("AType", getComponentTypeString(props.AType));
+        writer.keyValue("BType", getComponentTypeString(props.BType));
+        writer.keyValue("CType", getComponentTypeString(props.CType));
+        writer.keyValue("ResultType", getComponentTypeString(props.ResultType));
+        writer.keyValue("saturatingAccumulation", props.saturatingAccumulation != VK_FALSE);
+        writer.keyValue("scope", getScopeString(props.scope));
+        writer.endObject();
+    }
+    writer.endArray();
+
+    QvcmCooperativeMatrix2Features coopMat2Features{};
+    qvcmGetCooperativeMatrix2Features(context, physicalDevice, &coopMat2Features);
+    writer.key("cooperativeMatrix2");
+    writer.beginObject();
+    writer.keyValue("isSupported", coopMat2Features.isSupported != VK_FALSE);
+    writer.keyValue("workgroupScope", coopMat2Features.cooperativeMatrixWorkgroupScope != VK_FALSE);
+    writer.keyValue("flexibleDimensions", coopMat2Features.cooperativeMatrixFlexibleDimensions != VK_FALSE);
+    writer.keyValue("reductions", coopMat2Features.cooperativeMatrixReductions != VK_FALSE);
+    writer.keyValue("conversions", coopMat2Features.cooperativeMatrixConversions != VK_FALSE);
+    writer.keyValue("perElementOperations", coopMat2Features.cooperativeMatrixPerElementOperations != VK_FALSE);
+    writer.keyValue("tensorAddressing", coopMat2Features.cooperativeMatrixTensorAddressing != VK_FALSE);
+    writer.keyValue("blockLoads", coopMat2Features.cooperativeMatrixBlockLoads != VK_FALSE);
+    writer.keyValue(
+            "workgroupScopeMaxWorkgroupSize", coopMat2Features.cooperativeMatrixWorkgroupScopeMaxWorkgroupSize);
+    writer.keyValue(
+            "flexibleDimensionsMaxDimension", coopMat2Features.cooperativeMatrixFlexibleDimensionsMaxDimension);
+    writer.keyValue(
+            "workgroupScopeReservedSharedMemory",
+            coopMat2Features.cooperativeMatrixWorkgroupScopeReservedSharedMemory);
+    writer.key("flexibleDimensionsProperties");
+    writer.beginArray();
+    auto flexibleDimensionsProperties = queryArray<QvcmCooperativeMatrixFlexibleDimensionsProperties>(
+            [&](uint32_t* count, QvcmCooperativeMatrixFlexibleDimensionsProperties* properties) {
+                return qvcmGetCooperativeMatrixFlexibleDimensionsProperties(
+                        context, physicalDevice, count, properties);
+            });
+    for (const auto& props : flexibleDimensionsProperties) {
+        writer.beginObject();
+        writer.keyValue("MGranularity", props.MGranularity);
+        writer.keyValue("NGranularity", props.NGranularity);
+        writer.keyValue("KGranularity", props.KGranularity);
+        writer.keyValue("AType", getComponentTypeString(props.AType));
+        writer.keyValue("BType", getComponentTypeString(props.BType));
+        writer.keyValue("CType", getComponentTypeString(props.CType));
+        writer.keyValue("ResultType", getComponentTypeString(props.ResultType));
+        writer.keyValue("saturatingAccumulation", props.saturatingAccumulation != VK_FALSE);
+        writer.keyValue("scope", getScopeString(props.scope));
+        writer.keyValue("workgroupInvocations", props.workgroupInvocations);
+        writer.endObject();
+    }
+    writer.endArray();
+    writer.endObject();
+
+    QvcmCooperativeVectorFeatures coopVecFeatures{};
+    qvcmGetCooperativeVectorFeatures(context, physicalDevice, &coopVecFeatures);
+    writer.key("cooperativeVector");
+    writer.beginObject();
+    writer.keyValue("isSupported", coopVecFeatures.isSupported != VK_FALSE);
+    writer.keyValue("cooperativeVector", coopVecFeatures.cooperativeVector != VK_FALSE);
+    writer.keyValue("training", coopVecFeatures.cooperativeVectorTraining != VK_FALSE);
+    writer.keyValue("supportedStages", uint32_t(coopVecFeatures.cooperativeVectorSupportedStages));
+    writer.keyValue(
+            "trainingFloat16Accumulation", coopVecFeatures.cooperativeVectorTrainingFloat16Accumulation != VK_FALSE);
+    writer.keyValue(
+            "trainingFloat32Accumulation", coopVecFeatures.cooperativeVectorTrainingFloat32Accumulation != VK_FALSE);
+    writer.keyValue("maxComponents", coopVecFeatures.maxCooperativeVectorComponents);
+    writer.key("properties");
+    writer.beginArray();
+    auto coopVecProperties = queryArray<QvcmCooperativeVectorProperties>(
+            [&](uint32_t* count, QvcmCooperativeVectorProperties* properties) {
+                return qvcmGetCooperativeVectorProperties(context, physicalDevice, count, properties);
+            });
+    for (const auto& props : coopVecProperties) {
+        writer.beginObject();
+        writer.keyValue("inputType", getComponentTypeString(props.inputType));
+        writer.keyValue("inputInterpretation", getComponentTypeString(props.inputInterpretation));
+        writer.keyValue("matrixInterpretation", getComponentTypeString(props.matrixInterpretation));
+        writer.keyValue("biasInterpretation", getComponentTypeString(props.biasInterpretation));
+        writer.keyValue("resultType", getComponentTypeString(props.resultType));
+        writer.keyValue("transpose", props.transpose != VK_FALSE);
+        writer.endObject();
+    }
+    writer.endArray();
+    writer.endObject();
+
+    writer.key("memoryHeaps");
+    writer.beginArray();
+    auto memoryHeaps = queryArray<QvcmMemoryHeap>([&](uint32_t* count, QvcmMemoryHeap* heaps) {
+        return qvcmGetMemoryHeaps(context, physicalDevice, count, heaps);
+    });
+    for (const auto& heap : memoryHeaps) {
+        writer.beginObject();
+        writer.keyValue("size", uint64_t(heap.size));
+        writer.keyValue("isDeviceLocal", (heap.flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0);
+        writer.endObject();
+    }
+    writer.endArray();
+    writer.endObject();
+}
+
+static void buildCapabilityCache(QvcmContext context, CapabilityCache& cache) {
+    // An empty device list would otherwise replace the capabilities of a driver that is being updated.
+    uint32_t numPhysicalDevices = 0;
+    if (qvcmEnumeratePhysicalDevices(context, &numPhysicalDevices, nullptr) != QVCM_SUCCESS) {
+        throw std::runtime_error("Could not enumerate the physical devices.");
+    }
+    auto physicalDevices = queryArray<VkPhysicalDevice>([&](uint32_t* count, VkPhysicalDevice* devices) {
+        return qvcmEnumeratePhysicalDevices(context, count, devices);
+    });
+    cache.deviceResponses.clear();
+    JsonWriter devicesWriter(true), allWriter(true);
+    devicesWriter.beginObject();
+    devicesWriter.key("devices");
+    devicesWriter.beginArray();
+    allWriter.beginObject();
+    allWriter.key("devices");
+    allWriter.beginArray();
+    for (size_t deviceIdx = 0; deviceIdx < physicalDevices.size(); deviceIdx++) {
+        VkPhysicalDevice physicalDevice = physicalDevices.at(deviceIdx);
+        QvcmDeviceIdentity identity{};
+        qvcmGetDeviceIdentity(context, physicalDevice, &identity);
+        devicesWriter.beginObject();
+        writeDeviceIdentityJson(devicesWriter, deviceIdx, identity);
+        devicesWriter.endObject();
+        JsonWriter deviceWriter(true);
+        writeDeviceJson(deviceWriter, context, physicalDevice, deviceIdx);
+        cache.deviceResponses.push_back(deviceWriter.getString());
+        writeDeviceJson(allWriter, context, physicalDevice, deviceIdx);
+    }
+    devicesWriter.endArray();
+    devicesWriter.endObject();
+    allWriter.endArray();
+    allWriter.endObject();
+    cache.devicesResponse = devicesWriter.getString();
+    cache.allResponse = allWriter.getString();
+    cache.generation++;
+}
+
+static std::string getErrorResponse(const std::string& message) {
+    JsonWriter writer(true);
+    writer.beginObject();
+    writer.keyValue("error", message);
+    writer.endObject();
+    return writer.getString();
+}
+
+/// Returns the referenced driver library of an ICD manifest, or an empty string.
+static std::string getIcdLibraryPath(const std::string& manifestPath) {
+    std::ifstream file(manifestPath);
+    std::stringstream stream;
+    stream << file.rdbuf();
+    std::string manifest = stream.str();
+    size_t keyPos = manifest.find("\"library_path\"");
+    if (keyPos == std::string::npos) {
+        return "";
+    }
+    size_t startPos = manifest.find('"', manifest.find(':', keyPos));
+    size_t endPos = startPos == std::string::npos ? std::string::npos : manifest.find('"', startPos + 1);
+    if (endPos == std::string::npos) {
+        return "";
+    }
+    return manifest.substr(startPos + 1, endPos - startPos - 1);
+}
+
+/**
+ * Changes when a Vulkan driver is installed, updated or removed: the paths, modification times and sizes of the ICD
+ * manifests and of the libraries they reference (if given as absolute paths), and the NVIDIA kernel module version.
+ */
+static std::string getDriverFingerprint() {
+    std::string fingerprint;
+    auto addFile = [&](const std::string& path) {
+        struct stat fileStat{};
+        if (stat(path.c_str(), &fileStat) == 0) {
+            fingerprint += path + ":" + std::to_string(fileStat.st_mtime) + ":" + std::to_string(fileStat.st_size)
+                    + ";";
+        }
+    };
+    auto addManifest = [&](const std::string& manifestPath) {
+        addFile(manifestPath);
+        std::string libraryPath = getIcdLibraryPath(manifestPath);
+        if (!libraryPath.empty() && libraryPath.front() == '/') {
+            addFile(libraryPath);
+        }
+    };
+
+    std::vector<std::string> manifestDirectories = {
+            "/etc/vulkan/icd.d", "/usr/local/share/vulkan/icd.d", "/usr/share/vulkan/icd.d" };
+    const char* dataHome = std::getenv("XDG_DATA_HOME");
+    const char* home = std::getenv("HOME");
+    if (dataHome && dataHome[0] != '\0') {
+        manifestDirectories.push_back(std::string(dataHome) + "/vulkan/icd.d");
+    } else if (home && home[0] != '\0') {
+        manifestDirectories.push_back(std::string(home) + "/.local/share/vulkan/icd.d");
+    }
+    for (const auto& directory : manifestDirectories) {
+        DIR* dir = opendir(directory.c_str());
+        if (!dir) {
+            continue;
+        }
+        std::vector<std::string> manifestPaths;
+        while (struct dirent* entry = readdir(dir)) {
+            std::string fileName = entry->d_name;
+            if (fileName.size() > 5 && fileName.compare(fileName.size() - 5, 5, ".json") == 0) {
+                manifestPaths.push_back(directory + "/" + fileName);
+            }
+        }
+        closedir(dir);
+        std::sort(manifestPaths.begin(), manifestPaths.end());
+        for (const auto& manifestPath : manifestPaths) {
+            addManifest(manifestPath);
+        }
+    }
+    for (const char* variableName : { "VK_DRIVER_FILES", "VK_ICD_FILENAMES" }) {
+        const char* value = std::getenv(variableName);
+        if (!value) {
+            continue;
+        }
+        std::stringstream stream(value);
+        std::string manifestPath;
+        while (std::getline(stream, manifestPath, ':')) {
+            addManifest(manifestPath);
+        }
+    }
+
+    std::ifstream nvidiaVersionFile("/proc/driver/nvidia/version");
+    if (nvidiaVersionFile.is_open()) {
+        std::string line;
+        std::getline(nvidiaVersionFile, line);
+        fingerprint += line;
+    }
+    return fingerprint;
+}
+
+static QvcmContext createDaemonContext() {
+    QvcmContextCreateInfo createInfo{};
+    QvcmContext context = nullptr;
+    if (qvcmCreateContext(&createInfo, &context) != QVCM_SUCCESS) {
+        throw std::runtime_error("Could not create the Vulkan instance.");
+    }
+    return context;
+}
+
+/// Fails if another daemon is serving the path; removes a stale socket file left behind by a killed daemon.
+static int createListenSocket(const std::string& socketPath) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path)) {
+        throw std::runtime_error("The socket path is too long: " + socketPath);
+    }
+    std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+
+    int probeFd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (probeFd >= 0) {
+        bool isInUse = connect(probeFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0;
+        close(probeFd);
+        if (isInUse) {
+            throw std::runtime_error("Another daemon is already listening on " + socketPath);
+        }
+    }
+    unlink(socketPath.c_str());
+
+    int listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listenFd < 0) {
+        throw std::runtime_error(std::string() + "socket failed: " + std::strerror(errno));
+    }
+    if (bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0
+            || listen(listenFd, SOMAXCONN) != 0) {
+        int errorCode = errno;
+        close(listenFd);
+        throw std::runtime_error(
+                std::string() + "Could not listen on " + socketPath + ": " + std::strerror(errorCode));
+    }
+    return listenFd;
+}
+
+int runCapabilityDaemon(const std::string& socketPath) {
+    const auto startTime = std::chrono::steady_clock::now();
+    QvcmContext context = nullptr;
+    int listenFd = -1, epollFd = -1, signalFd = -1, refreshEventFd = -1;
+    std::unordered_map<int, DaemonClient> clients;
+    std::thread refreshThread;
+    CapabilityRefresh refreshState;
+    int exitCode = 0;
+    // SIGINT and SIGTERM are handled in the event loop; SIGPIPE is avoided by using MSG_NOSIGNAL. The signals are
+    // blocked before creating the instance, such that threads of the driver inherit the mask.
+    sigset_t signalMask;
+    sigemptyset(&signalMask);
+    sigaddset(&signalMask, SIGINT);
+    sigaddset(&signalMask, SIGTERM);
+    sigprocmask(SIG_BLOCK, &signalMask, nullptr);
+    try {
+        context = createDaemonContext();
+        CapabilityCache cache;
+        std::string driverFingerprint = getDriverFingerprint();
+        buildCapabilityCache(context, cache);
+        uint64_t numRequests = 0;
+
+        // The new instance and responses are built on a worker thread while the old ones are still served. They only
+        // replace the old ones if this succeeds (it fails, e.g., while a driver is being installed).
+        uint64_t numStartedRefreshes = 0;
+        bool isRefreshQueued = false;
+        std::string queuedRefreshReason;
+        // Returns the number of the refresh that will reflect the driver state at the time of the call.
+        auto startRefresh = [&](const std::string& reason) -> uint64_t {
+            if (refreshThread.joinable()) {
+                // The running refresh may have enumerated the devices already; requests are merged into one more.
+                if (!isRefreshQueued) {
+                    isRefreshQueued = true;
+                    queuedRefreshReason = reason;
+                }
+                return numStartedRefreshes + 1;
+            }
+            numStartedRefreshes++;
+            refreshState = CapabilityRefresh();
+            refreshState.reason = reason;
+            refreshState.driverFingerprint = getDriverFingerprint();
+            refreshState.cache.generation = cache.generation;
+            refreshThread = std::thread([&refreshState, refreshEventFd]() {
+                try {
+                    refreshState.context = createDaemonContext();
+                    buildCapabilityCache(refreshState.context, refreshState.cache);
+                    refreshState.isSuccessful = true;
+                } catch (const std::exception& e) {
+                    refreshState.errorMessage = e.what();
+                }
+                uint64_t value = 1;
+                ssize_t numWritten;
+                do {
+                    numWritten = write(refreshEventFd, &value, sizeof(value));
+                } while (numWritten < 0 && errno == EINTR);
+            });
+            return numStartedRefreshes;
+        };
+
+        signalFd = signalfd(-1, &signalMask, SFD_NONBLOCK | SFD_CLOEXEC);
+        listenFd = createListenSocket(socketPath);
+        epollFd = epoll_create1(EPOLL_CLOEXEC);
+        refreshEventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (signalFd < 0 || epollFd < 0 || refreshEventFd < 0) {
+            throw std::runtime_error(std::string() + "Could not create the event loop: " + std::strerror(errno));
+        }
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = listenFd;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &event);
+        event.data.fd = signalFd;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, signalFd, &event);
+        event.data.fd = refreshEventFd;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, refreshEventFd, &event);
+        writeOut("Serving the capabilities of ", cache.deviceResponses.size(), " device(s) on ", socketPath, ".");
+
+        auto closeClient = [&](int clientFd) {
+            epoll_ctl(epollFd, EPOLL_CTL_DEL, clientFd, nullptr);
+            close(clientFd);
+            clients.erase(clientFd);
+        };
+        // Returns an empty string for a refresh; its response is appended when the refresh has finished.
+        auto getResponse = [&](const std::string& request, DaemonClient& client) -> std::string {
+            numRequests++;
+            if (request == "ping") {
+                return "{\"ok\":true}\n";
+            } else if (request == "devices") {
+                return cache.devicesResponse;
+            } else if (request == "all") {
+                return cache.allResponse;
+            } else if (request.rfind("device ", 0) == 0) {
+                char* end = nullptr;
+                unsigned long deviceIdx = std::strtoul(request.c_str() + 7, &end, 10);
+                if (end == request.c_str() + 7 || *end != '\0' || deviceIdx >= cache.deviceResponses.size()) {
+                    return getErrorResponse("Invalid device index.");
+                }
+                return cache.deviceResponses.at(deviceIdx);
+            } else if (request == "stats") {
+                JsonWriter writer(true);
+                writer.beginObject();
+                writer.keyValue("uptimeSeconds", std::chrono::duration<double>(
+                        std::chrono::steady_clock::now() - startTime).count());
+                writer.keyValue("numRequests", numRequests);
+                writer.keyValue("numClients", uint64_t(clients.size()));
+                writer.keyValue("generation", cache.generation);
+                writer.keyValue("isRefreshing", refreshThread.joinable());
+                writer.endObject();
+                return writer.getString();
+            } else if (request == "refresh") {
+                client.awaitedRefresh = startRefresh("requested by a client");
+                return "";
+            }
+            return getErrorResponse("Unknown request.");
+        };
+        // Sends as much of the pending output as possible and waits for EPOLLOUT if the socket buffer is full.
+        auto flushClient = [&](int clientFd) {
+            DaemonClient& client = clients.at(clientFd);
+            while (client.outputOffset < client.output.size()) {
+                ssize_t numSent = send(
+                        clientFd, client.output.data() + client.outputOffset,
+                        client.output.size() - client.outputOffset, MSG_NOSIGNAL);
+                if (numSent < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                        break;
+                    }
+                    closeClient(clientFd);
+                    return;
+                }
+                client.outputOffset += size_t(numSent);
+            }
+            bool isDrained = client.outputOffset == client.output.size();
+            if (isDrained) {
+                client.output.clear();
+                client.outputOffset = 0;
+                if (client.shallClose && client.awaitedRefresh == 0) {
+                    closeClient(clientFd);
+                    return;
+                }
+            }
+            // Clients that stopped sending or wait for a refresh only wait for the rest of their responses. The
+            // requests after a refresh are read once it has been answered, which keeps the order of the responses.
+            epoll_event clientEvent{};
+            clientEvent.events =
+                    client.shallClose || client.awaitedRefresh != 0 ? 0u : uint32_t(EPOLLIN | EPOLLRDHUP);
+            if (!isDrained) {
+                clientEvent.events |= EPOLLOUT;
+            }
+            clientEvent.data.fd = clientFd;
+            epoll_ctl(epollFd, EPOLL_CTL_MOD, clientFd, &clientEvent);
+        };
+
+        // Answers the complete request lines received from a client up to the first refresh.
+        auto processRequests = [&](DaemonClient& client) {
+            size_t lineStart = 0, lineEnd;
+            while (client.awaitedRefresh == 0
+                    && (lineEnd = client.input.find('\n', lineStart)) != std::string::npos) {
+                std::string request = client.input.substr(lineStart, lineEnd - lineStart);
+                if (!request.empty() && request.back() == '\r') {
+                    request.pop_back();
+                }
+                client.output += getResponse(request, client);
+                lineStart = lineEnd + 1;
+            }
+            client.input.erase(0, lineStart);
+            if (client.awaitedRefresh == 0 && client.input.size() > MAX_REQUEST_SIZE) {
+                client.output += getErrorResponse("Request too long.");
+                client.shallClose = true;
+            }
+        };
+        auto updateClient = [&](int clientFd, bool isHungUp) {
+            DaemonClient& client = clients.at(clientFd);
+            if (!client.output.empty() || client.awaitedRefresh != 0) {
+                flushClient(clientFd);
+            } else if (client.shallClose || isHungUp) {
+                closeClient(clientFd);
+            }
+        };
+        auto finishRefresh = [&]() {
+            uint64_t value = 0;
+            if (read(refreshEventFd, &value, sizeof(value)) != ssize_t(sizeof(value)) || !refreshThread.joinable()) {
+                return;
+            }
+            refreshThread.join();
+            std::string response;
+            if (refreshState.isSuccessful) {
+                std::swap(context, refreshState.context);
+                std::swap(cache, refreshState.cache);
+                driverFingerprint = refreshState.driverFingerprint;
+                writeOut("Refreshed the capabilities (", refreshState.reason, "); generation ", cache.generation, ".");
+                response = "{\"ok\":true}\n";
+            } else {
+                sgl::Logfile::get()->writeError(
+                        std::string() + "Error in runCapabilityDaemon: Could not refresh the capabilities ("
+                        + refreshState.reason + "): " + refreshState.errorMessage, false);
+                response = getErrorResponse("Could not refresh the capabilities: " + refreshState.errorMessage);
+            }
+            qvcmDestroyContext(refreshState.context);
+            refreshState.context = nullptr;
+            const uint64_t finishedRefresh = numStartedRefreshes;
+            if (isRefreshQueued) {
+                isRefreshQueued = false;
+                startRefresh(queuedRefreshReason);
+            }
+            std::vector<int> answeredClientFds;
+            for (const auto& entry : clients) {
+                if (entry.second.awaitedRefresh == finishedRefresh) {
+                    answeredClientFds.push_back(entry.first);
+                }
+            }
+            for (int clientFd : answeredClientFds) {
+                DaemonClient& client = clients.at(clientFd);
+                client.output += response;
+                client.awaitedRefresh = 0;
+                processRequests(client);
+                updateClient(clientFd, false);
+            }
+        };
+
+        auto nextDriverCheckTime = std::chrono::steady_clock::now()
+                + std::chrono::milliseconds(DRIVER_CHECK_INTERVAL_MS);
+        epoll_event events[MAX_EPOLL_EVENTS];
+        bool isRunning = true;
+        while (isRunning) {
+            auto now = std::chrono::steady_clock::now();
+            if (now >= nextDriverCheckTime) {
+                std::string newDriverFingerprint = getDriverFingerprint();
+                if (newDriverFingerprint != driverFingerprint) {
+                    // After a failed refresh, the next change of the driver files triggers another attempt.
+                    driverFingerprint = newDriverFingerprint;
+                    startRefresh("driver change");
+                }
+                nextDriverCheckTime = now + std::chrono::milliseconds(DRIVER_CHECK_INTERVAL_MS);
+            }
+            int timeoutMs = int(std::chrono::duration_cast<std::chrono::milliseconds>(
+                    nextDriverCheckTime - now).count()) + 1;
+            int numEvents = epoll_wait(epollFd, events, MAX_EPOLL_EVENTS, timeoutMs);
+            if (numEvents < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw std::runtime_error(std::string() + "epoll_wait failed: " + std::strerror(errno));
+            }
+            for (int eventIdx = 0; eventIdx < numEvents; eventIdx++) {
+                int fd = events[eventIdx].data.fd;
+                uint32_t eventFlags = events[eventIdx].events;
+                if (fd == signalFd) {
+                    signalfd_siginfo signalInfo{};
+                    while (read(signalFd, &signalInfo, sizeof(signalInfo)) == ssize_t(sizeof(signalInfo))) {
+                        isRunning = false;
+                    }
+                    continue;
+                }
+                if (fd == refreshEventFd) {
+                    finishRefresh();
+                    continue;
+                }
+                if (fd == listenFd) {
+                    int clientFd;
+                    while ((clientFd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0) {
+                        epoll_event clientEvent{};
+                        clientEvent.events = EPOLLIN | EPOLLRDHUP;
+                        clientEvent.data.fd = clientFd;
+                        epoll_ctl(epollFd, EPOLL_CTL_ADD, clientFd, &clientEvent);
+                        clients[clientFd] = DaemonClient();
+                    }
+                    continue;
+                }
+                auto it = clients.find(fd);
+                if (it == clients.end()) {
+                    continue;
+                }
+                // Clients waiting for a refresh are not polled for input, so a hang-up would be reported repeatedly.
+                if ((eventFlags & EPOLLERR) != 0
+                        || (it->second.awaitedRefresh != 0 && (eventFlags & EPOLLHUP) != 0)) {
+                    closeClient(fd);
+                    continue;
+                }
+                if ((eventFlags & EPOLLIN) != 0) {
+                    DaemonClient& client = it->second;
+                    char buffer[4096];
+                    bool isReset = false;
+                    while (true) {
+                        ssize_t numReceived = recv(fd, buffer, sizeof(buffer), 0);
+                        if (numReceived > 0) {
+                            client.input.append(buffer, size_t(numReceived));
+                        } else if (numReceived == 0) {
+                            // The client has shut down its side; the pending responses are still sent.
+                            client.shallClose = true;
+                            break;
+                        } else if (errno != EINTR) {
+                            isReset = errno != EAGAIN && errno != EWOULDBLOCK;
+                            break;
+                        }
+                    }
+                    if (isReset) {
+                        closeClient(fd);
+                        continue;
+                    }
+                    processRequests(client);
+                }
+                updateClient(fd, (eventFlags & EPOLLHUP) != 0);
+            }
+        }
+        writeOut("Shutting down the capability daemon.");
+    } catch (const std::exception& e) {
+        sgl::Logfile::get()->writeError(std::string() + "Error in runCapabilityDaemon: " + e.what(), false);
+        exitCode = 1;
+    }
+
+    // An instance creation cannot be interrupted, so shutting down waits for a running refresh.
+    if (refreshThread.joinable()) {
+        refreshThread.join();
+    }
+    qvcmDestroyContext(refreshState.context);
+    for (auto& entry : clients) {
+        close(entry.first);
+    }
+    if (listenFd >= 0) {
+        close(listenFd);
+        unlink(socketPath.c_str());
+    }
+    if (epollFd >= 0) {
+        close(epollFd);
+    }
+    if (signalFd >= 0) {
+        close(signalFd);
+    }
+    if (refreshEventFd >= 0) {
+        close(refreshEventFd);
+    }
+    qvcmDestroyContext(context);
+    return exitCode;
+}
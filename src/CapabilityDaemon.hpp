@@ -0,0 +1,51 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef QUERYVKCOOPMAT_CAPABILITYDAEMON_HPP
+#define QUERYVKCOOPMAT_CAPABILITYDAEMON_HPP
+
+#include <string>
+
+/// $XDG_RUNTIME_DIR/queryvkcoopmat.sock, or /tmp/queryvkcoopmat-<uid>.sock if XDG_RUNTIME_DIR is not set.
+std::string getDefaultDaemonSocketPath();
+
+/**
+ * Keeps a Vulkan instance alive and serves the capabilities of all physical devices over a Unix domain socket until
+ * SIGINT or SIGTERM is received. Clients send one request per line and get one line of compact JSON per request:
+ * - "ping": {"ok":true}
+ * - "devices": identity of all devices
+ * - "device <index>": all properties of one device
+ * - "all": all properties of all devices
+ * - "stats": uptime, number of served requests and clients, and the cache generation
+ * - "refresh": recreates the instance and the cached responses
+ * The responses are cached. The instance is recreated when the installed Vulkan drivers change (checked every few
+ * seconds via the ICD manifests and the driver libraries they reference). Returns the exit code of the process.
+ */
+int runCapabilityDaemon(const std::string& socketPath);
+
+#endif //QUERYVKCOOPMAT_CAPABILITYDAEMON_HPP
@@ -0,0 +1,208 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "ComponentTypes.hpp"
+
+std::string getComponentTypeString(VkComponentTypeKHR compType) {
+    switch (compType) {
+        case VK_COMPONENT_TYPE_FLOAT16_KHR:
+            return "float16";
+        case VK_COMPONENT_TYPE_FLOAT32_KHR:
+            return "float32";
+        case VK_COMPONENT_TYPE_FLOAT64_KHR:
+            return "float64";
+        case VK_COMPONENT_TYPE_SINT8_KHR:
+            return "sint8";
+        case VK_COMPONENT_TYPE_SINT16_KHR:
+            return "sint16";
+        case VK_COMPONENT_TYPE_SINT32_KHR:
+            return "sint32";
+        case VK_COMPONENT_TYPE_SINT64_KHR:
+            return "sint64";
+        case VK_COMPONENT_TYPE_UINT8_KHR:
+            return "uint8";
+        case VK_COMPONENT_TYPE_UINT16_KHR:
+            return "uint16";
+        case VK_COMPONENT_TYPE_UINT32_KHR:
+            return "uint32";
+        case VK_COMPONENT_TYPE_UINT64_KHR:
+            return "uint64";
+        case VK_COMPONENT_TYPE_BFLOAT16_KHR:
+            return "bfloat16";
+        case VK_COMPONENT_TYPE_SINT8_PACKED_NV:
+            return "sint8_packed";
+        case VK_COMPONENT_TYPE_UINT8_PACKED_NV:
+            return "uint8_packed";
+        case VK_COMPONENT_TYPE_FLOAT_E4M3_NV:
+            return "float_e4m3";
+        case VK_COMPONENT_TYPE_FLOAT_E5M2_NV:
+            return "float_e5m2";
+        default:
+            return "UNKNOWN";
+    }
+}
+
+std::string getScopeString(VkScopeKHR scope) {
+    switch (scope) {
+        case VK_SCOPE_DEVICE_KHR:
+            return "DEVICE";
+        case VK_SCOPE_WORKGROUP_KHR:
+            return "WORKGROUP";
+        case VK_SCOPE_SUBGROUP_KHR:
+            return "SUBGROUP";
+        case VK_SCOPE_QUEUE_FAMILY_KHR:
+            return "QUEUE_FAMILY";
+        default:
+            return "UNKNOWN";
+    }
+}
+
+std::string getComponentTypeShortName(VkComponentTypeKHR compType) {
+    switch (compType) {
+        case VK_COMPONENT_TYPE_FLOAT16_KHR:
+            return "f16";
+        case VK_COMPONENT_TYPE_FLOAT32_KHR:
+            return "f32";
+        case VK_COMPONENT_TYPE_FLOAT64_KHR:
+            return "f64";
+        case VK_COMPONENT_TYPE_SINT8_KHR:
+            return "s8";
+        case VK_COMPONENT_TYPE_SINT16_KHR:
+            return "s16";
+        case VK_COMPONENT_TYPE_SINT32_KHR:
+            return "s32";
+        case VK_COMPONENT_TYPE_SINT64_KHR:
+            return "s64";
+        case VK_COMPONENT_TYPE_UINT8_KHR:
+            return "u8";
+        case VK_COMPONENT_TYPE_UINT16_KHR:
+            return "u16";
+        case VK_COMPONENT_TYPE_UINT32_KHR:
+            return "u32";
+        case VK_COMPONENT_TYPE_UINT64_KHR:
+            return "u64";
+        case VK_COMPONENT_TYPE_BFLOAT16_KHR:
+            return "bf16";
+        case VK_COMPONENT_TYPE_SINT8_PACKED_NV:
+            return "s8p";
+        case VK_COMPONENT_TYPE_UINT8_PACKED_NV:
+            return "u8p";
+        case VK_COMPONENT_TYPE_FLOAT_E4M3_NV:
+            return "e4m3";
+        case VK_COMPONENT_TYPE_FLOAT_E5M2_NV:
+            return "e5m2";
+        default:
+            return "unknown";
+    }
+}
+
+std::string getTypeCombinationLabel(
+        VkComponentTypeKHR AType, VkComponentTypeKHR BType, VkComponentTypeKHR CType, VkComponentTypeKHR ResultType) {
+    return getComponentTypeShortName(AType) + "*" + getComponentTypeShortName(BType) + "+"
+            + getComponentTypeShortName(CType) + "->" + getComponentTypeShortName(ResultType);
+}
+
+std::string getTypeCombinationLabel(const VkCooperativeMatrixPropertiesKHR& props) {
+    return getTypeCombinationLabel(props.AType, props.BType, props.CType, props.ResultType);
+}
+
+size_t getComponentTypeSize(VkComponentTypeKHR compType) {
+    switch (compType) {
+        case VK_COMPONENT_TYPE_SINT8_KHR:
+        case VK_COMPONENT_TYPE_UINT8_KHR:
+        case VK_COMPONENT_TYPE_FLOAT_E4M3_NV:
+        case VK_COMPONENT_TYPE_FLOAT_E5M2_NV:
+            return 1;
+        case VK_COMPONENT_TYPE_FLOAT16_KHR:
+        case VK_COMPONENT_TYPE_BFLOAT16_KHR:
+        case VK_COMPONENT_TYPE_SINT16_KHR:
+        case VK_COMPONENT_TYPE_UINT16_KHR:
+            return 2;
+        case VK_COMPONENT_TYPE_FLOAT64_KHR:
+        case VK_COMPONENT_TYPE_SINT64_KHR:
+        case VK_COMPONENT_TYPE_UINT64_KHR:
+            return 8;
+        default:
+            return 4;
+    }
+}
+
+bool getIsComponentTypeInteger(VkComponentTypeKHR compType) {
+    switch (compType) {
+        case VK_COMPONENT_TYPE_FLOAT16_KHR:
+        case VK_COMPONENT_TYPE_FLOAT32_KHR:
+        case VK_COMPONENT_TYPE_FLOAT64_KHR:
+        case VK_COMPONENT_TYPE_BFLOAT16_KHR:
+        case VK_COMPONENT_TYPE_FLOAT_E4M3_NV:
+        case VK_COMPONENT_TYPE_FLOAT_E5M2_NV:
+            return false;
+        default:
+            return true;
+    }
+}
+
+bool getIsComponentTypeSigned(VkComponentTypeKHR compType) {
+    switch (compType) {
+        case VK_COMPONENT_TYPE_UINT8_KHR:
+        case VK_COMPONENT_TYPE_UINT16_KHR:
+        case VK_COMPONENT_TYPE_UINT32_KHR:
+        case VK_COMPONENT_TYPE_UINT64_KHR:
+        case VK_COMPONENT_TYPE_UINT8_PACKED_NV:
+            return false;
+        default:
+            return true;
+    }
+}
+
+bool getIsComponentTypeUsable(sgl::vk::Device* device, VkComponentTypeKHR compType) {
+    const auto& features11 = device->getPhysicalDeviceVulkan11Features();
+    const auto& features12 = device->getPhysicalDeviceVulkan12Features();
+    switch (compType) {
+        case VK_COMPONENT_TYPE_SINT8_KHR:
+        case VK_COMPONENT_TYPE_UINT8_KHR:
+            return features12.shaderInt8 && features12.storageBuffer8BitAccess;
+        case VK_COMPONENT_TYPE_FLOAT16_KHR:
+            return features12.shaderFloat16 && features11.storageBuffer16BitAccess;
+        case VK_COMPONENT_TYPE_SINT16_KHR:
+        case VK_COMPONENT_TYPE_UINT16_KHR:
+            return device->getPhysicalDeviceFeatures().shaderInt16 && features11.storageBuffer16BitAccess;
+        case VK_COMPONENT_TYPE_FLOAT64_KHR:
+            return device->getPhysicalDeviceFeatures().shaderFloat64;
+        case VK_COMPONENT_TYPE_SINT64_KHR:
+        case VK_COMPONENT_TYPE_UINT64_KHR:
+            return device->getPhysicalDeviceFeatures().shaderInt64;
+        case VK_COMPONENT_TYPE_BFLOAT16_KHR:
+            return device->isDeviceExtensionSupported(VK_KHR_SHADER_BFLOAT16_EXTENSION_NAME)
+                    && device->getPhysicalDeviceShaderBfloat16Features().shaderBFloat16Type;
+        case VK_COMPONENT_TYPE_FLOAT_E4M3_NV:
+        case VK_COMPONENT_TYPE_FLOAT_E5M2_NV:
+            return device->isDeviceExtensionSupported(VK_EXT_SHADER_FLOAT8_EXTENSION_NAME);
+        default:
+            return true;
+    }
+}
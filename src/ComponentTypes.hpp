@@ -0,0 +1,56 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef QUERYVKCOOPMAT_COMPONENTTYPES_HPP
+#define QUERYVKCOOPMAT_COMPONENTTYPES_HPP
+
+#include <string>
+
+#include <Graphics/Vulkan/Utils/Device.hpp>
+
+std::string getComponentTypeString(VkComponentTypeKHR compType);
+std::string getScopeString(VkScopeKHR scope);
+
+/// Short name used for kernel variants (e.g., "f16", "bf16", "s8"); must match CMake/Kernels.cmake.
+std::string getComponentTypeShortName(VkComponentTypeKHR compType);
+/// E.g., "f16*f16+f32->f32" for the types A, B, C and Result.
+std::string getTypeCombinationLabel(
+        VkComponentTypeKHR AType, VkComponentTypeKHR BType, VkComponentTypeKHR CType, VkComponentTypeKHR ResultType);
+std::string getTypeCombinationLabel(const VkCooperativeMatrixPropertiesKHR& props);
+/// Size of one element in bytes (packed types count as one 32-bit element).
+size_t getComponentTypeSize(VkComponentTypeKHR compType);
+bool getIsComponentTypeInteger(VkComponentTypeKHR compType);
+bool getIsComponentTypeSigned(VkComponentTypeKHR compType);
+
+/**
+ * Checks whether the features for using the type in storage buffers and arithmetic in shaders are enabled
+ * (e.g., shaderInt8 and storageBuffer8BitAccess for 8-bit integers).
+ */
+bool getIsComponentTypeUsable(sgl::vk::Device* device, VkComponentTypeKHR compType);
+
+#endif //QUERYVKCOOPMAT_COMPONENTTYPES_HPP
@@ -0,0 +1,100 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <Graphics/Vulkan/libs/volk/volk.h>
+
+#include "ComponentTypes.hpp"
+#include "VulkanUtils.hpp"
+#include "CoopVecUtils.hpp"
+
+std::string getCoopVecMatrixLayoutString(VkCooperativeVectorMatrixLayoutNV layout) {
+    if (layout == VK_COOPERATIVE_VECTOR_MATRIX_LAYOUT_ROW_MAJOR_NV) {
+        return "row-major";
+    } else if (layout == VK_COOPERATIVE_VECTOR_MATRIX_LAYOUT_COLUMN_MAJOR_NV) {
+        return "column-major";
+    } else if (layout == VK_COOPERATIVE_VECTOR_MATRIX_LAYOUT_INFERENCING_OPTIMAL_NV) {
+        return "inferencing-optimal";
+    } else if (layout == VK_COOPERATIVE_VECTOR_MATRIX_LAYOUT_TRAINING_OPTIMAL_NV) {
+        return "training-optimal";
+    } else {
+        return "unknown";
+    }
+}
+
+size_t getCoopVecMatrixStride(
+        VkCooperativeVectorMatrixLayoutNV layout, uint32_t numRows, uint32_t numColumns, VkComponentTypeKHR type) {
+    if (layout == VK_COOPERATIVE_VECTOR_MATRIX_LAYOUT_ROW_MAJOR_NV) {
+        return size_t(numColumns) * getComponentTypeSize(type);
+    } else if (layout == VK_COOPERATIVE_VECTOR_MATRIX_LAYOUT_COLUMN_MAJOR_NV) {
+        return size_t(numRows) * getComponentTypeSize(type);
+    }
+    return 0;
+}
+
+VkConvertCooperativeVectorMatrixInfoNV getCoopVecConversionInfo(
+        uint32_t numRows, uint32_t numColumns, VkComponentTypeKHR srcType, VkCooperativeVectorMatrixLayoutNV srcLayout,
+        VkComponentTypeKHR dstType, VkCooperativeVectorMatrixLayoutNV dstLayout, size_t* pDstSize) {
+    VkConvertCooperativeVectorMatrixInfoNV info{};
+    info.sType = VK_STRUCTURE_TYPE_CONVERT_COOPERATIVE_VECTOR_MATRIX_INFO_NV;
+    info.srcSize = size_t(numRows) * size_t(numColumns) * getComponentTypeSize(srcType);
+    info.pDstSize = pDstSize;
+    info.srcComponentType = srcType;
+    info.dstComponentType = dstType;
+    info.numRows = numRows;
+    info.numColumns = numColumns;
+    info.srcLayout = srcLayout;
+    info.srcStride = getCoopVecMatrixStride(srcLayout, numRows, numColumns, srcType);
+    info.dstLayout = dstLayout;
+    info.dstStride = getCoopVecMatrixStride(dstLayout, numRows, numColumns, dstType);
+    return info;
+}
+
+size_t getCoopVecMatrixSize(
+        VkDevice device, uint32_t numRows, uint32_t numColumns, VkComponentTypeKHR type,
+        VkCooperativeVectorMatrixLayoutNV layout) {
+    // Without destination data, only the destination size is queried.
+    size_t dstSize = 0;
+    VkConvertCooperativeVectorMatrixInfoNV info = getCoopVecConversionInfo(
+            numRows, numColumns, type, VK_COOPERATIVE_VECTOR_MATRIX_LAYOUT_ROW_MAJOR_NV, type, layout, &dstSize);
+    throwIfVkError(vkConvertCooperativeVectorMatrixNV(device, &info), "vkConvertCooperativeVectorMatrixNV");
+    return dstSize;
+}
+
+std::vector<uint8_t> convertCoopVecMatrixOnHost(
+        VkDevice device, const void* srcData, uint32_t numRows, uint32_t numColumns,
+        VkComponentTypeKHR srcType, VkCooperativeVectorMatrixLayoutNV srcLayout,
+        VkComponentTypeKHR dstType, VkCooperativeVectorMatrixLayoutNV dstLayout) {
+    size_t dstSize = getCoopVecMatrixSize(device, numRows, numColumns, dstType, dstLayout);
+    std::vector<uint8_t> dstData(dstSize);
+    VkConvertCooperativeVectorMatrixInfoNV info = getCoopVecConversionInfo(
+            numRows, numColumns, srcType, srcLayout, dstType, dstLayout, &dstSize);
+    info.srcData.hostAddress = srcData;
+    info.dstData.hostAddress = dstData.data();
+    throwIfVkError(vkConvertCooperativeVectorMatrixNV(device, &info), "vkConvertCooperativeVectorMatrixNV");
+    return dstData;
+}
@@ -0,0 +1,71 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef QUERYVKCOOPMAT_COOPVECUTILS_HPP
+#define QUERYVKCOOPMAT_COOPVECUTILS_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <Graphics/Vulkan/Utils/Device.hpp>
+
+/*
+ * Helpers for VK_NV_cooperative_vector weight matrices. Like the functions in VulkanUtils.hpp, they report errors by
+ * throwing std::runtime_error.
+ */
+
+/// Matrix offsets passed to the cooperative vector matrix functions need to be aligned to this many bytes.
+const size_t COOPVEC_MATRIX_ALIGNMENT = 64;
+
+std::string getCoopVecMatrixLayoutString(VkCooperativeVectorMatrixLayoutNV layout);
+
+/// Returns the stride in bytes of a tightly packed row-major or column-major matrix, and 0 for the optimal layouts.
+size_t getCoopVecMatrixStride(
+        VkCooperativeVectorMatrixLayoutNV layout, uint32_t numRows, uint32_t numColumns, VkComponentTypeKHR type);
+
+/**
+ * Fills the conversion info for a tightly packed source matrix. The caller needs to set srcData and dstData, and
+ * pDstSize needs to stay valid while the info is used.
+ */
+VkConvertCooperativeVectorMatrixInfoNV getCoopVecConversionInfo(
+        uint32_t numRows, uint32_t numColumns, VkComponentTypeKHR srcType, VkCooperativeVectorMatrixLayoutNV srcLayout,
+        VkComponentTypeKHR dstType, VkCooperativeVectorMatrixLayoutNV dstLayout, size_t* pDstSize);
+
+/// Queries the size in bytes of a numRows x numColumns matrix in the passed layout.
+size_t getCoopVecMatrixSize(
+        VkDevice device, uint32_t numRows, uint32_t numColumns, VkComponentTypeKHR type,
+        VkCooperativeVectorMatrixLayoutNV layout);
+
+/// Converts a matrix between layouts and component types on the host using vkConvertCooperativeVectorMatrixNV.
+std::vector<uint8_t> convertCoopVecMatrixOnHost(
+        VkDevice device, const void* srcData, uint32_t numRows, uint32_t numColumns,
+        VkComponentTypeKHR srcType, VkCooperativeVectorMatrixLayoutNV srcLayout,
+        VkComponentTypeKHR dstType, VkCooperativeVectorMatrixLayoutNV dstLayout);
+
+#endif //QUERYVKCOOPMAT_COOPVECUTILS_HPP
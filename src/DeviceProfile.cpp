@@ -0,0 +1,423 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstring>
+#include <filesystem>
+#include <type_traits>
+
+#include <Utils/File/Logfile.hpp>
+#include <Graphics/Vulkan/Utils/Device.hpp>
+
+#include "PrintUtils.hpp"
+#include "JsonWriter.hpp"
+#include "VulkanUtils.hpp"
+#include "DeviceProfileFields.hpp"
+#include "DeviceProfile.hpp"
+
+const std::vector<VkFormat>& getProfileFormats() {
+    static const std::vector<VkFormat> formats = {
+            VK_FORMAT_R8G8B8A8_UNORM, VK_FORMAT_B8G8R8A8_UNORM, VK_FORMAT_R8G8B8A8_SRGB, VK_FORMAT_B8G8R8A8_SRGB,
+            VK_FORMAT_R16_UNORM, VK_FORMAT_R16G16_UNORM, VK_FORMAT_R16G16B16A16_UNORM,
+            VK_FORMAT_D32_SFLOAT, VK_FORMAT_R32_SFLOAT, VK_FORMAT_R32G32_SFLOAT, VK_FORMAT_R32G32B32A32_SFLOAT,
+            VK_FORMAT_R16_SFLOAT, VK_FORMAT_R16G16_SFLOAT, VK_FORMAT_R16G16B16A16_SFLOAT,
+            VK_FORMAT_R32_UINT, VK_FORMAT_R32G32_UINT, VK_FORMAT_R32G32B32A32_UINT,
+            VK_FORMAT_R32_SINT, VK_FORMAT_R32G32_SINT, VK_FORMAT_R32G32B32A32_SINT,
+            VK_FORMAT_B10G11R11_UFLOAT_PACK32, VK_FORMAT_R64_UINT,
+            VK_FORMAT_G8_B8R8_2PLANE_420_UNORM, // NV12
+            VK_FORMAT_G10X6_B10X6R10X6_2PLANE_420_UNORM_3PACK16, // P010
+    };
+    return formats;
+}
+
+static void writeProfileField(JsonWriter& writer, const char* name, uint32_t value) {
+    writer.keyValue(name, value);
+}
+
+static void writeProfileField(JsonWriter& writer, const char* name, uint64_t value) {
+    writer.keyValue(name, value);
+}
+
+static void writeProfileField(JsonWriter& writer, const char* name, float value) {
+    writer.keyValue(name, double(value));
+}
+
+template<class T, typename std::enable_if<std::is_enum<T>::value, int>::type = 0>
+static void writeProfileField(JsonWriter& writer, const char* name, T value) {
+    writer.keyValue(name, int64_t(value));
+}
+
+template<size_t N>
+static void writeProfileField(JsonWriter& writer, const char* name, const uint32_t (&values)[N]) {
+    writer.key(name);
+    writer.beginArray();
+    for (uint32_t value : values) {
+        writer.value(value);
+    }
+    writer.endArray();
+}
+
+template<size_t N>
+static void writeProfileField(JsonWriter& writer, const char* name, const char (&text)[N]) {
+    writer.keyValue(name, std::string(text, strnlen(text, N)));
+}
+
+/// UUIDs and LUIDs are stored as hex strings.
+template<size_t N>
+static void writeProfileField(JsonWriter& writer, const char* name, const uint8_t (&bytes)[N]) {
+    static const char* hexDigits = "0123456789abcdef";
+    std::string hexString;
+    for (uint8_t byte : bytes) {
+        hexString += hexDigits[byte >> 4];
+        hexString += hexDigits[byte & 0xF];
+    }
+    writer.keyValue(name, hexString);
+}
+
+static bool isExtensionSupported(const std::vector<VkExtensionProperties>& extensions, const char* extensionName) {
+    for (const auto& extension : extensions) {
+        if (std::strcmp(extension.extensionName, extensionName) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool isProfileStructAvailable(
+        uint32_t apiVersion, uint32_t minApiVersion, const char* requiredExtension,
+        const std::vector<VkExtensionProperties>& extensions) {
+    return apiVersion >= minApiVersion && (!requiredExtension || isExtensionSupported(extensions, requiredExtension));
+}
+
+/// Two-call enumeration of a property array whose elements need their sType set.
+template<class T, class EnumerateFunction>
+static std::vector<T> enumerateProfileArray(
+        VkStructureType structureType, const char* callName, EnumerateFunction enumerate) {
+    uint32_t count = 0;
+    throwIfVkError(enumerate(&count, nullptr), callName);
+    std::vector<T> items(count);
+    for (auto& item : items) {
+        item.sType = structureType;
+    }
+    throwIfVkError(enumerate(&count, items.data()), callName);
+    items.resize(count);
+    return items;
+}
+
+#define PROFILE_WRITE_FIELD(name) writeProfileField(writer, #name, s.name);
+#define PROFILE_WRITE_FEATURE_FIELD(name) writer.keyValue(#name, bool(s.name));
+#define PROFILE_CHAIN_STRUCT(jsonKey, StructType, sTypeValue, minApiVersion, requiredExtension, FIELDS) \
+    StructType jsonKey{}; \
+    jsonKey.sType = sTypeValue; \
+    const bool jsonKey##IsAvailable = isProfileStructAvailable( \
+            apiVersion, minApiVersion, requiredExtension, extensions); \
+    if (jsonKey##IsAvailable) { \
+        jsonKey.pNext = chainHead->pNext; \
+        chainHead->pNext = reinterpret_cast<VkBaseOutStructure*>(&jsonKey); \
+    }
+#define PROFILE_WRITE_STRUCT(jsonKey, StructType, sTypeValue, minApiVersion, requiredExtension, FIELDS) \
+    if (jsonKey##IsAvailable) { \
+        const auto& s = jsonKey; \
+        writer.key(#jsonKey); \
+        writer.beginObject(); \
+        FIELDS(PROFILE_WRITE_FIELD) \
+        writer.endObject(); \
+    }
+#define PROFILE_WRITE_FEATURE_STRUCT(jsonKey, StructType, sTypeValue, minApiVersion, requiredExtension, FIELDS) \
+    if (jsonKey##IsAvailable) { \
+        const auto& s = jsonKey; \
+        writer.key(#jsonKey); \
+        writer.beginObject(); \
+        FIELDS(PROFILE_WRITE_FEATURE_FIELD) \
+        writer.endObject(); \
+    }
+#define PROFILE_WRITE_ARRAY(jsonKey, items, FIELDS) \
+    writer.key(jsonKey); \
+    writer.beginArray(); \
+    for (const auto& s : items) { \
+        writer.beginObject(); \
+        FIELDS(PROFILE_WRITE_FIELD) \
+        writer.endObject(); \
+    } \
+    writer.endArray();
+
+static void writeFormatProfiles(
+        JsonWriter& writer, VkPhysicalDevice physicalDevice, const std::vector<VkExtensionProperties>& extensions) {
+    const bool hasDrmFormatModifiers = isExtensionSupported(
+            extensions, VK_EXT_IMAGE_DRM_FORMAT_MODIFIER_EXTENSION_NAME);
+    writer.key("formats");
+    writer.beginArray();
+    for (VkFormat format : getProfileFormats()) {
+        VkDrmFormatModifierPropertiesListEXT drmFormatModifierPropertiesList{};
+        drmFormatModifierPropertiesList.sType = VK_STRUCTURE_TYPE_DRM_FORMAT_MODIFIER_PROPERTIES_LIST_EXT;
+        VkFormatProperties2 formatProperties2{};
+        formatProperties2.sType = VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2;
+        if (hasDrmFormatModifiers) {
+            formatProperties2.pNext = &drmFormatModifierPropertiesList;
+        }
+        vkGetPhysicalDeviceFormatProperties2(physicalDevice, format, &formatProperties2);
+        std::vector<VkDrmFormatModifierPropertiesEXT> drmFormatModifiers(
+                drmFormatModifierPropertiesList.drmFormatModifierCount);
+        if (!drmFormatModifiers.empty()) {
+            drmFormatModifierPropertiesList.pDrmFormatModifierProperties = drmFormatModifiers.data();
+            vkGetPhysicalDeviceFormatProperties2(physicalDevice, format, &formatProperties2);
+            drmFormatModifiers.resize(drmFormatModifierPropertiesList.drmFormatModifierCount);
+        }
+
+        const VkFormatProperties& properties = formatProperties2.formatProperties;
+        writer.beginObject();
+        writer.keyValue("format", int64_t(format));
+        writer.keyValue("linearTilingFeatures", uint32_t(properties.linearTilingFeatures));
+        writer.keyValue("optimalTilingFeatures", uint32_t(properties.optimalTilingFeatures));
+        writer.keyValue("bufferFeatures", uint32_t(properties.bufferFeatures));
+        if (hasDrmFormatModifiers) {
+            writer.key("drmFormatModifiers");
+            writer.beginArray();
+            for (const auto& drmFormatModifier : drmFormatModifiers) {
+                writer.beginObject();
+                writer.keyValue("drmFormatModifier", uint64_t(drmFormatModifier.drmFormatModifier));
+                writer.keyValue("drmFormatModifierPlaneCount", drmFormatModifier.drmFormatModifierPlaneCount);
+                writer.keyValue(
+                        "drmFormatModifierTilingFeatures",
+                        uint32_t(drmFormatModifier.drmFormatModifierTilingFeatures));
+                writer.endObject();
+            }
+            writer.endArray();
+        }
+        writer.endObject();
+    }
+    writer.endArray();
+}
+
+void writeDeviceProfile(JsonWriter& writer, VkPhysicalDevice physicalDevice) {
+    uint32_t numExtensions = 0;
+    throwIfVkError(
+            vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &numExtensions, nullptr),
+            "vkEnumerateDeviceExtensionProperties");
+    std::vector<VkExtensionProperties> extensions(numExtensions);
+    throwIfVkError(
+            vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &numExtensions, extensions.data()),
+            "vkEnumerateDeviceExtensionProperties");
+    extensions.resize(numExtensions);
+
+    VkPhysicalDeviceProperties2 properties2{};
+    properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+    vkGetPhysicalDeviceProperties(physicalDevice, &properties2.properties);
+    const uint32_t apiVersion = properties2.properties.apiVersion;
+    if (apiVersion < VK_API_VERSION_1_1) {
+        throw std::runtime_error("Device profiles need Vulkan 1.1 or newer.");
+    }
+
+    writer.beginObject();
+    writer.keyValue("profileFormatVersion", int32_t(PROFILE_FORMAT_VERSION));
+
+    writer.key("extensions");
+    writer.beginArray();
+    for (const auto& extension : extensions) {
+        writer.beginObject();
+        writeProfileField(writer, "extensionName", extension.extensionName);
+        writer.keyValue("specVersion", extension.specVersion);
+        writer.endObject();
+    }
+    writer.endArray();
+
+    {
+        auto* chainHead = reinterpret_cast<VkBaseOutStructure*>(&properties2);
+        PROFILE_PROPERTY_STRUCTS(PROFILE_CHAIN_STRUCT)
+        vkGetPhysicalDeviceProperties2(physicalDevice, &properties2);
+
+        writer.key("properties");
+        writer.beginObject();
+        {
+            const auto& s = properties2.properties;
+            PROFILE_PROPERTIES_FIELDS(PROFILE_WRITE_FIELD)
+        }
+        writer.key("limits");
+        writer.beginObject();
+        {
+            const auto& s = properties2.properties.limits;
+            PROFILE_LIMITS_FIELDS(PROFILE_WRITE_FIELD)
+        }
+        writer.endObject();
+        writer.endObject();
+        PROFILE_PROPERTY_STRUCTS(PROFILE_WRITE_STRUCT)
+    }
+
+    {
+        VkPhysicalDeviceFeatures2 features2{};
+        features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        auto* chainHead = reinterpret_cast<VkBaseOutStructure*>(&features2);
+        PROFILE_FEATURE_STRUCTS(PROFILE_CHAIN_STRUCT)
+        vkGetPhysicalDeviceFeatures2(physicalDevice, &features2);
+
+        writer.key("features");
+        writer.beginObject();
+        {
+            const auto& s = features2.features;
+            PROFILE_FEATURES_FIELDS(PROFILE_WRITE_FEATURE_FIELD)
+        }
+        writer.endObject();
+        PROFILE_FEATURE_STRUCTS(PROFILE_WRITE_FEATURE_STRUCT)
+    }
+
+    if (isExtensionSupported(extensions, VK_KHR_COOPERATIVE_MATRIX_EXTENSION_NAME)
+            && vkGetPhysicalDeviceCooperativeMatrixPropertiesKHR) {
+        auto items = enumerateProfileArray<VkCooperativeMatrixPropertiesKHR>(
+                VK_STRUCTURE_TYPE_COOPERATIVE_MATRIX_PROPERTIES_KHR,
+                "vkGetPhysicalDeviceCooperativeMatrixPropertiesKHR",
+                [&](uint32_t* count, VkCooperativeMatrixPropertiesKHR* data) {
+                    return vkGetPhysicalDeviceCooperativeMatrixPropertiesKHR(physicalDevice, count, data);
+                });
+        PROFILE_WRITE_ARRAY(
+                "supportedCooperativeMatrixPropertiesKHR", items,
+                PROFILE_COOPERATIVE_MATRIX_PROPERTIES_KHR_ARRAY_FIELDS)
+    }
+    if (isExtensionSupported(extensions, VK_NV_COOPERATIVE_MATRIX_EXTENSION_NAME)
+            && vkGetPhysicalDeviceCooperativeMatrixPropertiesNV) {
+        auto items = enumerateProfileArray<VkCooperativeMatrixPropertiesNV>(
+                VK_STRUCTURE_TYPE_COOPERATIVE_MATRIX_PROPERTIES_NV,
+                "vkGetPhysicalDeviceCooperativeMatrixPropertiesNV",
+                [&](uint32_t* count, VkCooperativeMatrixPropertiesNV* data) {
+                    return vkGetPhysicalDeviceCooperativeMatrixPropertiesNV(physicalDevice, count, data);
+                });
+        PROFILE_WRITE_ARRAY(
+                "supportedCooperativeMatrixPropertiesNV", items, PROFILE_COOPERATIVE_MATRIX_PROPERTIES_NV_ARRAY_FIELDS)
+    }
+    if (isExtensionSupported(extensions, VK_NV_COOPERATIVE_MATRIX_2_EXTENSION_NAME)
+            && vkGetPhysicalDeviceCooperativeMatrixFlexibleDimensionsPropertiesNV) {
+        auto items = enumerateProfileArray<VkCooperativeMatrixFlexibleDimensionsPropertiesNV>(
+                VK_STRUCTURE_TYPE_COOPERATIVE_MATRIX_FLEXIBLE_DIMENSIONS_PROPERTIES_NV,
+                "vkGetPhysicalDeviceCooperativeMatrixFlexibleDimensionsPropertiesNV",
+                [&](uint32_t* count, VkCooperativeMatrixFlexibleDimensionsPropertiesNV* data) {
+                    return vkGetPhysicalDeviceCooperativeMatrixFlexibleDimensionsPropertiesNV(
+                            physicalDevice, count, data);
+                });
+        PROFILE_WRITE_ARRAY(
+                "supportedCooperativeMatrixFlexibleDimensionsPropertiesNV", items,
+                PROFILE_COOPERATIVE_MATRIX_FLEXIBLE_DIMENSIONS_PROPERTIES_NV_ARRAY_FIELDS)
+    }
+    if (isExtensionSupported(extensions, VK_NV_COOPERATIVE_VECTOR_EXTENSION_NAME)
+            && vkGetPhysicalDeviceCooperativeVectorPropertiesNV) {
+        auto items = enumerateProfileArray<VkCooperativeVectorPropertiesNV>(
+                VK_STRUCTURE_TYPE_COOPERATIVE_VECTOR_PROPERTIES_NV,
+                "vkGetPhysicalDeviceCooperativeVectorPropertiesNV",
+                [&](uint32_t* count, VkCooperativeVectorPropertiesNV* data) {
+                    return vkGetPhysicalDeviceCooperativeVectorPropertiesNV(physicalDevice, count, data);
+                });
+        PROFILE_WRITE_ARRAY(
+                "supportedCooperativeVectorPropertiesNV", items, PROFILE_COOPERATIVE_VECTOR_PROPERTIES_NV_ARRAY_FIELDS)
+    }
+
+    VkPhysicalDeviceMemoryProperties memoryProperties{};
+    vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memoryProperties);
+    writer.key("memoryProperties");
+    writer.beginObject();
+    writer.key("memoryTypes");
+    writer.beginArray();
+    for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++) {
+        writer.beginObject();
+        writer.keyValue("propertyFlags", uint32_t(memoryProperties.memoryTypes[i].propertyFlags));
+        writer.keyValue("heapIndex", memoryProperties.memoryTypes[i].heapIndex);
+        writer.endObject();
+    }
+    writer.endArray();
+    writer.key("memoryHeaps");
+    writer.beginArray();
+    for (uint32_t i = 0; i < memoryProperties.memoryHeapCount; i++) {
+        writer.beginObject();
+        writer.keyValue("size", uint64_t(memoryProperties.memoryHeaps[i].size));
+        writer.keyValue("flags", uint32_t(memoryProperties.memoryHeaps[i].flags));
+        writer.endObject();
+    }
+    writer.endArray();
+    writer.endObject();
+
+    uint32_t numQueueFamilies = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &numQueueFamilies, nullptr);
+    std::vector<VkQueueFamilyProperties> queueFamilies(numQueueFamilies);
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &numQueueFamilies, queueFamilies.data());
+    writer.key("queueFamilies");
+    writer.beginArray();
+    for (const auto& queueFamily : queueFamilies) {
+        writer.beginObject();
+        writer.keyValue("queueFlags", uint32_t(queueFamily.queueFlags));
+        writer.keyValue("queueCount", queueFamily.queueCount);
+        writer.keyValue("timestampValidBits", queueFamily.timestampValidBits);
+        const VkExtent3D& granularity = queueFamily.minImageTransferGranularity;
+        writer.key("minImageTransferGranularity");
+        writer.beginArray();
+        writer.value(granularity.width);
+        writer.value(granularity.height);
+        writer.value(granularity.depth);
+        writer.endArray();
+        writer.endObject();
+    }
+    writer.endArray();
+
+    PFN_vkGetPhysicalDeviceCalibrateableTimeDomainsKHR getTimeDomains = nullptr;
+    if (isExtensionSupported(extensions, VK_KHR_CALIBRATED_TIMESTAMPS_EXTENSION_NAME)) {
+        getTimeDomains = vkGetPhysicalDeviceCalibrateableTimeDomainsKHR;
+    } else if (isExtensionSupported(extensions, VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME)) {
+        getTimeDomains = vkGetPhysicalDeviceCalibrateableTimeDomainsEXT;
+    }
+    if (getTimeDomains) {
+        uint32_t numTimeDomains = 0;
+        getTimeDomains(physicalDevice, &numTimeDomains, nullptr);
+        std::vector<VkTimeDomainKHR> timeDomains(numTimeDomains);
+        getTimeDomains(physicalDevice, &numTimeDomains, timeDomains.data());
+        timeDomains.resize(numTimeDomains);
+        writer.key("timeDomains");
+        writer.beginArray();
+        for (VkTimeDomainKHR timeDomain : timeDomains) {
+            writer.value(int64_t(timeDomain));
+        }
+        writer.endArray();
+    }
+
+    writeFormatProfiles(writer, physicalDevice, extensions);
+    writer.endObject();
+}
+
+void captureDeviceProfile(size_t deviceIdx, sgl::vk::Device* device, const std::string& reportDirectory) {
+    JsonWriter writer;
+    try {
+        writeDeviceProfile(writer, device->getVkPhysicalDevice());
+    } catch (const std::exception& e) {
+        sgl::Logfile::get()->writeError(std::string() + "Error in captureDeviceProfile: " + e.what(), false);
+        return;
+    }
+
+    std::error_code errorCode;
+    std::filesystem::create_directories(reportDirectory, errorCode);
+    const std::string filePath = (std::filesystem::path(reportDirectory)
+            / ("DeviceProfile_" + std::to_string(deviceIdx) + ".json")).string();
+    if (!writer.save(filePath)) {
+        sgl::Logfile::get()->writeError("Error in captureDeviceProfile: Could not write " + filePath, false);
+    } else {
+        writeOut("Wrote the device profile to ", filePath, ".");
+    }
+}
@@ -0,0 +1,57 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef QUERYVKCOOPMAT_DEVICEPROFILE_HPP
+#define QUERYVKCOOPMAT_DEVICEPROFILE_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <Graphics/Vulkan/Utils/Device.hpp>
+
+class JsonWriter;
+
+/// Formats whose properties and DRM format modifiers are stored in device profiles and listed by --test-drm-format.
+const std::vector<VkFormat>& getProfileFormats();
+
+/**
+ * Writes everything this tool queries for a physical device as a JSON object: the supported device extensions, the
+ * features and properties (see DeviceProfileFields.hpp), the cooperative matrix, cooperative matrix 2 and cooperative
+ * vector property arrays, the memory properties, the queue families, the calibrateable time domains and the format
+ * properties including the DRM format modifiers.
+ */
+void writeDeviceProfile(JsonWriter& writer, VkPhysicalDevice physicalDevice);
+
+/**
+ * Writes DeviceProfile_<device index>.json to the report directory. The profile can be replayed without the GPU by the
+ * mock driver in mock_icd/.
+ */
+void captureDeviceProfile(size_t deviceIdx, sgl::vk::Device* device, const std::string& reportDirectory);
+
+#endif //QUERYVKCOOPMAT_DEVICEPROFILE_HPP
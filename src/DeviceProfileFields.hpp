@@ -0,0 +1,263 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef QUERYVKCOOPMAT_DEVICEPROFILEFIELDS_HPP
+#define QUERYVKCOOPMAT_DEVICEPROFILEFIELDS_HPP
+
+/*
+ * Member lists of the Vulkan structs stored in device profiles. They are shared by the capture (DeviceProfile.cpp)
+ * and the mock driver replaying the profiles (mock_icd/MockIcd.cpp), so both always agree on the JSON layout.
+ * Feature lists contain all members of the struct. Property lists only contain the members read by this tool and by
+ * sgl; all other members are zero when replaying a profile.
+ * The Vulkan headers need to be included before this file (volk in the tool, the plain headers in the mock driver).
+ */
+
+#define PROFILE_FEATURES_FIELDS(FIELD) \
+    FIELD(robustBufferAccess) FIELD(fullDrawIndexUint32) FIELD(imageCubeArray) FIELD(independentBlend) \
+    FIELD(geometryShader) FIELD(tessellationShader) FIELD(sampleRateShading) FIELD(dualSrcBlend) FIELD(logicOp) \
+    FIELD(multiDrawIndirect) FIELD(drawIndirectFirstInstance) FIELD(depthClamp) FIELD(depthBiasClamp) \
+    FIELD(fillModeNonSolid) FIELD(depthBounds) FIELD(wideLines) FIELD(largePoints) FIELD(alphaToOne) \
+    FIELD(multiViewport) FIELD(samplerAnisotropy) FIELD(textureCompressionETC2) FIELD(textureCompressionASTC_LDR) \
+    FIELD(textureCompressionBC) FIELD(occlusionQueryPrecise) FIELD(pipelineStatisticsQuery) \
+    FIELD(vertexPipelineStoresAndAtomics) FIELD(fragmentStoresAndAtomics) \
+    FIELD(shaderTessellationAndGeometryPointSize) FIELD(shaderImageGatherExtended) \
+    FIELD(shaderStorageImageExtendedFormats) FIELD(shaderStorageImageMultisample) \
+    FIELD(shaderStorageImageReadWithoutFormat) FIELD(shaderStorageImageWriteWithoutFormat) \
+    FIELD(shaderUniformBufferArrayDynamicIndexing) FIELD(shaderSampledImageArrayDynamicIndexing) \
+    FIELD(shaderStorageBufferArrayDynamicIndexing) FIELD(shaderStorageImageArrayDynamicIndexing) \
+    FIELD(shaderClipDistance) FIELD(shaderCullDistance) FIELD(shaderFloat64) FIELD(shaderInt64) FIELD(shaderInt16) \
+    FIELD(shaderResourceResidency) FIELD(shaderResourceMinLod) FIELD(sparseBinding) FIELD(sparseResidencyBuffer) \
+    FIELD(sparseResidencyImage2D) FIELD(sparseResidencyImage3D) FIELD(sparseResidency2Samples) \
+    FIELD(sparseResidency4Samples) FIELD(sparseResidency8Samples) FIELD(sparseResidency16Samples) \
+    FIELD(sparseResidencyAliased) FIELD(variableMultisampleRate) FIELD(inheritedQueries)
+
+#define PROFILE_VULKAN11_FEATURES_FIELDS(FIELD) \
+    FIELD(storageBuffer16BitAccess) FIELD(uniformAndStorageBuffer16BitAccess) FIELD(storagePushConstant16) \
+    FIELD(storageInputOutput16) FIELD(multiview) FIELD(multiviewGeometryShader) FIELD(multiviewTessellationShader) \
+    FIELD(variablePointersStorageBuffer) FIELD(variablePointers) FIELD(protectedMemory) \
+    FIELD(samplerYcbcrConversion) FIELD(shaderDrawParameters)
+
+#define PROFILE_VULKAN12_FEATURES_FIELDS(FIELD) \
+    FIELD(samplerMirrorClampToEdge) FIELD(drawIndirectCount) FIELD(storageBuffer8BitAccess) \
+    FIELD(uniformAndStorageBuffer8BitAccess) FIELD(storagePushConstant8) FIELD(shaderBufferInt64Atomics) \
+    FIELD(shaderSharedInt64Atomics) FIELD(shaderFloat16) FIELD(shaderInt8) FIELD(descriptorIndexing) \
+    FIELD(shaderInputAttachmentArrayDynamicIndexing) FIELD(shaderUniformTexelBufferArrayDynamicIndexing) \
+    FIELD(shaderStorageTexelBufferArrayDynamicIndexing) FIELD(shaderUniformBufferArrayNonUniformIndexing) \
+    FIELD(shaderSampledImageArrayNonUniformIndexing) FIELD(shaderStorageBufferArrayNonUniformIndexing) \
+    FIELD(shaderStorageImageArrayNonUniformIndexing) FIELD(shaderInputAttachmentArrayNonUniformIndexing) \
+    FIELD(shaderUniformTexelBufferArrayNonUniformIndexing) FIELD(shaderStorageTexelBufferArrayNonUniformIndexing) \
+    FIELD(descriptorBindingUniformBufferUpdateAfterBind) FIELD(descriptorBindingSampledImageUpdateAfterBind) \
+    FIELD(descriptorBindingStorageImageUpdateAfterBind) FIELD(descriptorBindingStorageBufferUpdateAfterBind) \
+    FIELD(descriptorBindingUniformTexelBufferUpdateAfterBind) \
+    FIELD(descriptorBindingStorageTexelBufferUpdateAfterBind) FIELD(descriptorBindingUpdateUnusedWhilePending) \
+    FIELD(descriptorBindingPartiallyBound) FIELD(descriptorBindingVariableDescriptorCount) \
+    FIELD(runtimeDescriptorArray) FIELD(samplerFilterMinmax) FIELD(scalarBlockLayout) FIELD(imagelessFramebuffer) \
+    FIELD(uniformBufferStandardLayout) FIELD(shaderSubgroupExtendedTypes) FIELD(separateDepthStencilLayouts) \
+    FIELD(hostQueryReset) FIELD(timelineSemaphore) FIELD(bufferDeviceAddress) \
+    FIELD(bufferDeviceAddressCaptureReplay) FIELD(bufferDeviceAddressMultiDevice) FIELD(vulkanMemoryModel) \
+    FIELD(vulkanMemoryModelDeviceScope) FIELD(vulkanMemoryModelAvailabilityVisibilityChains) \
+    FIELD(shaderOutputViewportIndex) FIELD(shaderOutputLayer) FIELD(subgroupBroadcastDynamicId)
+
+#define PROFILE_VULKAN13_FEATURES_FIELDS(FIELD) \
+    FIELD(robustImageAccess) FIELD(inlineUniformBlock) FIELD(descriptorBindingInlineUniformBlockUpdateAfterBind) \
+    FIELD(pipelineCreationCacheControl) FIELD(privateData) FIELD(shaderDemoteToHelperInvocation) \
+    FIELD(shaderTerminateInvocation) FIELD(subgroupSizeControl) FIELD(computeFullSubgroups) FIELD(synchronization2) \
+    FIELD(textureCompressionASTC_HDR) FIELD(shaderZeroInitializeWorkgroupMemory) FIELD(dynamicRendering) \
+    FIELD(shaderIntegerDotProduct) FIELD(maintenance4)
+
+#define PROFILE_COOPERATIVE_MATRIX_FEATURES_KHR_FIELDS(FIELD) \
+    FIELD(cooperativeMatrix) FIELD(cooperativeMatrixRobustBufferAccess)
+
+#define PROFILE_COOPERATIVE_MATRIX_FEATURES_NV_FIELDS(FIELD) \
+    FIELD(cooperativeMatrix) FIELD(cooperativeMatrixRobustBufferAccess)
+
+#define PROFILE_COOPERATIVE_MATRIX_2_FEATURES_NV_FIELDS(FIELD) \
+    FIELD(cooperativeMatrixWorkgroupScope) FIELD(cooperativeMatrixFlexibleDimensions) \
+    FIELD(cooperativeMatrixReductions) FIELD(cooperativeMatrixConversions) \
+    FIELD(cooperativeMatrixPerElementOperations) FIELD(cooperativeMatrixTensorAddressing) \
+    FIELD(cooperativeMatrixBlockLoads)
+
+#define PROFILE_COOPERATIVE_VECTOR_FEATURES_NV_FIELDS(FIELD) \
+    FIELD(cooperativeVector) FIELD(cooperativeVectorTraining)
+
+#define PROFILE_SHADER_BFLOAT16_FEATURES_KHR_FIELDS(FIELD) \
+    FIELD(shaderBFloat16Type) FIELD(shaderBFloat16DotProduct) FIELD(shaderBFloat16CooperativeMatrix)
+
+#define PROFILE_SHADER_FLOAT8_FEATURES_EXT_FIELDS(FIELD) \
+    FIELD(shaderFloat8) FIELD(shaderFloat8CooperativeMatrix)
+
+#define PROFILE_SHADER_64BIT_INDEXING_FEATURES_EXT_FIELDS(FIELD) \
+    FIELD(shader64BitIndexing)
+
+/**
+ * Feature structs chained to VkPhysicalDeviceFeatures2: STRUCT(JSON key, type, sType, minimum device API version,
+ * required device extension or nullptr, member list).
+ */
+#define PROFILE_FEATURE_STRUCTS(STRUCT) \
+    STRUCT(vulkan11Features, VkPhysicalDeviceVulkan11Features, VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_1_FEATURES, \
+           VK_API_VERSION_1_2, nullptr, PROFILE_VULKAN11_FEATURES_FIELDS) \
+    STRUCT(vulkan12Features, VkPhysicalDeviceVulkan12Features, VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES, \
+           VK_API_VERSION_1_2, nullptr, PROFILE_VULKAN12_FEATURES_FIELDS) \
+    STRUCT(vulkan13Features, VkPhysicalDeviceVulkan13Features, VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES, \
+           VK_API_VERSION_1_3, nullptr, PROFILE_VULKAN13_FEATURES_FIELDS) \
+    STRUCT(cooperativeMatrixFeaturesKHR, VkPhysicalDeviceCooperativeMatrixFeaturesKHR, \
+           VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_COOPERATIVE_MATRIX_FEATURES_KHR, VK_API_VERSION_1_1, \
+           VK_KHR_COOPERATIVE_MATRIX_EXTENSION_NAME, PROFILE_COOPERATIVE_MATRIX_FEATURES_KHR_FIELDS) \
+    STRUCT(cooperativeMatrixFeaturesNV, VkPhysicalDeviceCooperativeMatrixFeaturesNV, \
+           VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_COOPERATIVE_MATRIX_FEATURES_NV, VK_API_VERSION_1_1, \
+           VK_NV_COOPERATIVE_MATRIX_EXTENSION_NAME, PROFILE_COOPERATIVE_MATRIX_FEATURES_NV_FIELDS) \
+    STRUCT(cooperativeMatrix2FeaturesNV, VkPhysicalDeviceCooperativeMatrix2FeaturesNV, \
+           VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_COOPERATIVE_MATRIX_2_FEATURES_NV, VK_API_VERSION_1_1, \
+           VK_NV_COOPERATIVE_MATRIX_2_EXTENSION_NAME, PROFILE_COOPERATIVE_MATRIX_2_FEATURES_NV_FIELDS) \
+    STRUCT(cooperativeVectorFeaturesNV, VkPhysicalDeviceCooperativeVectorFeaturesNV, \
+           VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_COOPERATIVE_VECTOR_FEATURES_NV, VK_API_VERSION_1_1, \
+           VK_NV_COOPERATIVE_VECTOR_EXTENSION_NAME, PROFILE_COOPERATIVE_VECTOR_FEATURES_NV_FIELDS) \
+    STRUCT(shaderBfloat16FeaturesKHR, VkPhysicalDeviceShaderBfloat16FeaturesKHR, \
+           VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_BFLOAT16_FEATURES_KHR, VK_API_VERSION_1_1, \
+           VK_KHR_SHADER_BFLOAT16_EXTENSION_NAME, PROFILE_SHADER_BFLOAT16_FEATURES_KHR_FIELDS) \
+    STRUCT(shaderFloat8FeaturesEXT, VkPhysicalDeviceShaderFloat8FeaturesEXT, \
+           VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_FLOAT8_FEATURES_EXT, VK_API_VERSION_1_1, \
+           VK_EXT_SHADER_FLOAT8_EXTENSION_NAME, PROFILE_SHADER_FLOAT8_FEATURES_EXT_FIELDS) \
+    STRUCT(shader64BitIndexingFeaturesEXT, VkPhysicalDeviceShader64BitIndexingFeaturesEXT, \
+           VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_64_BIT_INDEXING_FEATURES_EXT, VK_API_VERSION_1_1, \
+           VK_EXT_SHADER_64BIT_INDEXING_EXTENSION_NAME, PROFILE_SHADER_64BIT_INDEXING_FEATURES_EXT_FIELDS)
+
+#define PROFILE_PROPERTIES_FIELDS(FIELD) \
+    FIELD(apiVersion) FIELD(driverVersion) FIELD(vendorID) FIELD(deviceID) FIELD(deviceType) FIELD(deviceName) \
+    FIELD(pipelineCacheUUID)
+
+#define PROFILE_LIMITS_FIELDS(FIELD) \
+    FIELD(maxImageDimension1D) FIELD(maxImageDimension2D) FIELD(maxImageDimension3D) FIELD(maxImageDimensionCube) \
+    FIELD(maxImageArrayLayers) FIELD(maxTexelBufferElements) FIELD(maxUniformBufferRange) \
+    FIELD(maxStorageBufferRange) FIELD(maxPushConstantsSize) FIELD(maxMemoryAllocationCount) \
+    FIELD(maxSamplerAllocationCount) FIELD(bufferImageGranularity) FIELD(maxBoundDescriptorSets) \
+    FIELD(maxPerStageDescriptorSamplers) FIELD(maxPerStageDescriptorUniformBuffers) \
+    FIELD(maxPerStageDescriptorStorageBuffers) FIELD(maxPerStageDescriptorSampledImages) \
+    FIELD(maxPerStageDescriptorStorageImages) FIELD(maxPerStageResources) FIELD(maxDescriptorSetSamplers) \
+    FIELD(maxDescriptorSetUniformBuffers) FIELD(maxDescriptorSetUniformBuffersDynamic) \
+    FIELD(maxDescriptorSetStorageBuffers) FIELD(maxDescriptorSetStorageBuffersDynamic) \
+    FIELD(maxDescriptorSetSampledImages) FIELD(maxDescriptorSetStorageImages) FIELD(maxComputeSharedMemorySize) \
+    FIELD(maxComputeWorkGroupCount) FIELD(maxComputeWorkGroupInvocations) FIELD(maxComputeWorkGroupSize) \
+    FIELD(minTexelBufferOffsetAlignment) FIELD(minUniformBufferOffsetAlignment) \
+    FIELD(minStorageBufferOffsetAlignment) FIELD(timestampComputeAndGraphics) FIELD(timestampPeriod) \
+    FIELD(optimalBufferCopyOffsetAlignment) FIELD(optimalBufferCopyRowPitchAlignment) FIELD(nonCoherentAtomSize)
+
+#define PROFILE_VULKAN11_PROPERTIES_FIELDS(FIELD) \
+    FIELD(deviceUUID) FIELD(driverUUID) FIELD(deviceLUID) FIELD(deviceNodeMask) FIELD(deviceLUIDValid) \
+    FIELD(subgroupSize) FIELD(subgroupSupportedStages) FIELD(subgroupSupportedOperations) \
+    FIELD(subgroupQuadOperationsInAllStages) FIELD(maxPerSetDescriptors) FIELD(maxMemoryAllocationSize)
+
+#define PROFILE_VULKAN12_PROPERTIES_FIELDS(FIELD) \
+    FIELD(driverID) FIELD(driverName) FIELD(driverInfo) FIELD(shaderDenormPreserveFloat16) \
+    FIELD(shaderDenormPreserveFloat32) FIELD(shaderRoundingModeRTEFloat16) FIELD(shaderRoundingModeRTEFloat32) \
+    FIELD(shaderRoundingModeRTZFloat16) FIELD(shaderRoundingModeRTZFloat32) FIELD(maxTimelineSemaphoreValueDifference)
+
+#define PROFILE_VULKAN13_PROPERTIES_FIELDS(FIELD) \
+    FIELD(minSubgroupSize) FIELD(maxSubgroupSize) FIELD(maxComputeWorkgroupSubgroups) \
+    FIELD(requiredSubgroupSizeStages) FIELD(maxInlineUniformBlockSize) FIELD(maxBufferSize) \
+    FIELD(integerDotProduct8BitUnsignedAccelerated) FIELD(integerDotProduct8BitSignedAccelerated) \
+    FIELD(integerDotProduct4x8BitPackedUnsignedAccelerated) FIELD(integerDotProduct4x8BitPackedSignedAccelerated)
+
+#define PROFILE_COOPERATIVE_MATRIX_PROPERTIES_KHR_FIELDS(FIELD) \
+    FIELD(cooperativeMatrixSupportedStages)
+
+#define PROFILE_COOPERATIVE_MATRIX_PROPERTIES_NV_FIELDS(FIELD) \
+    FIELD(cooperativeMatrixSupportedStages)
+
+#define PROFILE_COOPERATIVE_MATRIX_2_PROPERTIES_NV_FIELDS(FIELD) \
+    FIELD(cooperativeMatrixWorkgroupScopeMaxWorkgroupSize) FIELD(cooperativeMatrixFlexibleDimensionsMaxDimension) \
+    FIELD(cooperativeMatrixWorkgroupScopeReservedSharedMemory)
+
+#define PROFILE_COOPERATIVE_VECTOR_PROPERTIES_NV_FIELDS(FIELD) \
+    FIELD(cooperativeVectorSupportedStages) FIELD(cooperativeVectorTrainingFloat16Accumulation) \
+    FIELD(cooperativeVectorTrainingFloat32Accumulation) FIELD(maxCooperativeVectorComponents)
+
+#define PROFILE_SHADER_SM_BUILTINS_PROPERTIES_NV_FIELDS(FIELD) \
+    FIELD(shaderSMCount) FIELD(shaderWarpsPerSM)
+
+#define PROFILE_SHADER_CORE_PROPERTIES_AMD_FIELDS(FIELD) \
+    FIELD(shaderEngineCount) FIELD(shaderArraysPerEngineCount) FIELD(computeUnitsPerShaderArray) \
+    FIELD(simdPerComputeUnit) FIELD(wavefrontsPerSimd) FIELD(wavefrontSize) FIELD(sgprsPerSimd) \
+    FIELD(vgprsPerSimd)
+
+#define PROFILE_EXTERNAL_MEMORY_HOST_PROPERTIES_EXT_FIELDS(FIELD) \
+    FIELD(minImportedHostPointerAlignment)
+
+/// Property structs chained to VkPhysicalDeviceProperties2; same arguments as for PROFILE_FEATURE_STRUCTS.
+#define PROFILE_PROPERTY_STRUCTS(STRUCT) \
+    STRUCT(vulkan11Properties, VkPhysicalDeviceVulkan11Properties, \
+           VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_1_PROPERTIES, VK_API_VERSION_1_2, nullptr, \
+           PROFILE_VULKAN11_PROPERTIES_FIELDS) \
+    STRUCT(vulkan12Properties, VkPhysicalDeviceVulkan12Properties, \
+           VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_PROPERTIES, VK_API_VERSION_1_2, nullptr, \
+           PROFILE_VULKAN12_PROPERTIES_FIELDS) \
+    STRUCT(vulkan13Properties, VkPhysicalDeviceVulkan13Properties, \
+           VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_PROPERTIES, VK_API_VERSION_1_3, nullptr, \
+           PROFILE_VULKAN13_PROPERTIES_FIELDS) \
+    STRUCT(cooperativeMatrixPropertiesKHR, VkPhysicalDeviceCooperativeMatrixPropertiesKHR, \
+           VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_COOPERATIVE_MATRIX_PROPERTIES_KHR, VK_API_VERSION_1_1, \
+           VK_KHR_COOPERATIVE_MATRIX_EXTENSION_NAME, PROFILE_COOPERATIVE_MATRIX_PROPERTIES_KHR_FIELDS) \
+    STRUCT(cooperativeMatrixPropertiesNV, VkPhysicalDeviceCooperativeMatrixPropertiesNV, \
+           VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_COOPERATIVE_MATRIX_PROPERTIES_NV, VK_API_VERSION_1_1, \
+           VK_NV_COOPERATIVE_MATRIX_EXTENSION_NAME, PROFILE_COOPERATIVE_MATRIX_PROPERTIES_NV_FIELDS) \
+    STRUCT(cooperativeMatrix2PropertiesNV, VkPhysicalDeviceCooperativeMatrix2PropertiesNV, \
+           VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_COOPERATIVE_MATRIX_2_PROPERTIES_NV, VK_API_VERSION_1_1, \
+           VK_NV_COOPERATIVE_MATRIX_2_EXTENSION_NAME, PROFILE_COOPERATIVE_MATRIX_2_PROPERTIES_NV_FIELDS) \
+    STRUCT(cooperativeVectorPropertiesNV, VkPhysicalDeviceCooperativeVectorPropertiesNV, \
+           VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_COOPERATIVE_VECTOR_PROPERTIES_NV, VK_API_VERSION_1_1, \
+           VK_NV_COOPERATIVE_VECTOR_EXTENSION_NAME, PROFILE_COOPERATIVE_VECTOR_PROPERTIES_NV_FIELDS) \
+    STRUCT(shaderSMBuiltinsPropertiesNV, VkPhysicalDeviceShaderSMBuiltinsPropertiesNV, \
+           VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_SM_BUILTINS_PROPERTIES_NV, VK_API_VERSION_1_1, \
+           VK_NV_SHADER_SM_BUILTINS_EXTENSION_NAME, PROFILE_SHADER_SM_BUILTINS_PROPERTIES_NV_FIELDS) \
+    STRUCT(shaderCorePropertiesAMD, VkPhysicalDeviceShaderCorePropertiesAMD, \
+           VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_CORE_PROPERTIES_AMD, VK_API_VERSION_1_1, \
+           VK_AMD_SHADER_CORE_PROPERTIES_EXTENSION_NAME, PROFILE_SHADER_CORE_PROPERTIES_AMD_FIELDS) \
+    STRUCT(externalMemoryHostPropertiesEXT, VkPhysicalDeviceExternalMemoryHostPropertiesEXT, \
+           VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTERNAL_MEMORY_HOST_PROPERTIES_EXT, VK_API_VERSION_1_1, \
+           VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME, PROFILE_EXTERNAL_MEMORY_HOST_PROPERTIES_EXT_FIELDS)
+
+/// Elements of the arrays returned by the two-call property enumerations.
+#define PROFILE_COOPERATIVE_MATRIX_PROPERTIES_KHR_ARRAY_FIELDS(FIELD) \
+    FIELD(MSize) FIELD(NSize) FIELD(KSize) FIELD(AType) FIELD(BType) FIELD(CType) FIELD(ResultType) \
+    FIELD(saturatingAccumulation) FIELD(scope)
+
+#define PROFILE_COOPERATIVE_MATRIX_PROPERTIES_NV_ARRAY_FIELDS(FIELD) \
+    FIELD(MSize) FIELD(NSize) FIELD(KSize) FIELD(AType) FIELD(BType) FIELD(CType) FIELD(DType) FIELD(scope)
+
+#define PROFILE_COOPERATIVE_MATRIX_FLEXIBLE_DIMENSIONS_PROPERTIES_NV_ARRAY_FIELDS(FIELD) \
+    FIELD(MGranularity) FIELD(NGranularity) FIELD(KGranularity) FIELD(AType) FIELD(BType) FIELD(CType) \
+    FIELD(ResultType) FIELD(saturatingAccumulation) FIELD(scope) FIELD(workgroupInvocations)
+
+#define PROFILE_COOPERATIVE_VECTOR_PROPERTIES_NV_ARRAY_FIELDS(FIELD) \
+    FIELD(inputType) FIELD(inputInterpretation) FIELD(matrixInterpretation) FIELD(biasInterpretation) \
+    FIELD(resultType) FIELD(transpose)
+
+/// Version of the profile JSON layout; bumped on incompatible changes.
+#define PROFILE_FORMAT_VERSION 1
+
+#endif //QUERYVKCOOPMAT_DEVICEPROFILEFIELDS_HPP
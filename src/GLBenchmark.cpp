@@ -0,0 +1,510 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <Utils/File/Logfile.hpp>
+#include <ImGui/Widgets/NumberFormatting.hpp>
+
+#include <EGL/egl.h>
+
+#define GLAPIENTRY EGLAPIENTRY
+#include "GLCommon.hpp"
+#include "PrintUtils.hpp"
+#include "BenchmarkRunner.hpp"
+#include "GLBenchmark.hpp"
+
+struct GLBenchmarkFunctionTable {
+    PFNGLGETSTRINGPROC glGetString;
+    PFNGLGETINTEGERVPROC glGetIntegerv;
+    PFNGLGETINTEGER64VPROC glGetInteger64v;
+    PFNGLGETERRORPROC glGetError;
+    PFNGLFINISHPROC glFinish;
+    PFNGLGENBUFFERSPROC glGenBuffers;
+    PFNGLDELETEBUFFERSPROC glDeleteBuffers;
+    PFNGLBINDBUFFERPROC glBindBuffer;
+    PFNGLBINDBUFFERRANGEPROC glBindBufferRange;
+    PFNGLBUFFERDATAPROC glBufferData;
+    PFNGLBUFFERSUBDATAPROC glBufferSubData;
+    PFNGLCOPYBUFFERSUBDATAPROC glCopyBufferSubData;
+    PFNGLCREATESHADERPROC glCreateShader;
+    PFNGLSHADERSOURCEPROC glShaderSource;
+    PFNGLCOMPILESHADERPROC glCompileShader;
+    PFNGLGETSHADERIVPROC glGetShaderiv;
+    PFNGLGETSHADERINFOLOGPROC glGetShaderInfoLog;
+    PFNGLDELETESHADERPROC glDeleteShader;
+    PFNGLCREATEPROGRAMPROC glCreateProgram;
+    PFNGLATTACHSHADERPROC glAttachShader;
+    PFNGLLINKPROGRAMPROC glLinkProgram;
+    PFNGLGETPROGRAMIVPROC glGetProgramiv;
+    PFNGLGETPROGRAMINFOLOGPROC glGetProgramInfoLog;
+    PFNGLDELETEPROGRAMPROC glDeleteProgram;
+    PFNGLUSEPROGRAMPROC glUseProgram;
+    PFNGLUNIFORM1UIPROC glUniform1ui;
+    PFNGLDISPATCHCOMPUTEPROC glDispatchCompute;
+    PFNGLMEMORYBARRIERPROC glMemoryBarrier;
+    PFNGLGENQUERIESPROC glGenQueries;
+    PFNGLDELETEQUERIESPROC glDeleteQueries;
+    PFNGLBEGINQUERYPROC glBeginQuery;
+    PFNGLENDQUERYPROC glEndQuery;
+    PFNGLGETQUERYOBJECTUI64VPROC glGetQueryObjectui64v;
+    PFNGLFENCESYNCPROC glFenceSync;
+    PFNGLCLIENTWAITSYNCPROC glClientWaitSync;
+    PFNGLDELETESYNCPROC glDeleteSync;
+
+    // Optional (OpenGL 4.4 or GL_ARB_buffer_storage); the persistent-mapped upload paths are skipped without them.
+    PFNGLBUFFERSTORAGEPROC glBufferStorage;
+    PFNGLMAPBUFFERRANGEPROC glMapBufferRange;
+    PFNGLUNMAPBUFFERPROC glUnmapBuffer;
+};
+
+#define LOAD_GL_FUNCTION(functionName) \
+    gl.functionName = decltype(gl.functionName)(getGlFunctionPointer(TOSTRING(functionName)))
+
+static bool loadGlBenchmarkFunctions(
+        GLBenchmarkFunctionTable& gl, void* (*getGlFunctionPointer)(const char* functionName)) {
+    LOAD_GL_FUNCTION(glGetString);
+    LOAD_GL_FUNCTION(glGetIntegerv);
+    LOAD_GL_FUNCTION(glGetInteger64v);
+    LOAD_GL_FUNCTION(glGetError);
+    LOAD_GL_FUNCTION(glFinish);
+    LOAD_GL_FUNCTION(glGenBuffers);
+    LOAD_GL_FUNCTION(glDeleteBuffers);
+    LOAD_GL_FUNCTION(glBindBuffer);
+    LOAD_GL_FUNCTION(glBindBufferRange);
+    LOAD_GL_FUNCTION(glBufferData);
+    LOAD_GL_FUNCTION(glBufferSubData);
+    LOAD_GL_FUNCTION(glCopyBufferSubData);
+    LOAD_GL_FUNCTION(glCreateShader);
+    LOAD_GL_FUNCTION(glShaderSource);
+    LOAD_GL_FUNCTION(glCompileShader);
+    LOAD_GL_FUNCTION(glGetShaderiv);
+    LOAD_GL_FUNCTION(glGetShaderInfoLog);
+    LOAD_GL_FUNCTION(glDeleteShader);
+    LOAD_GL_FUNCTION(glCreateProgram);
+    LOAD_GL_FUNCTION(glAttachShader);
+    LOAD_GL_FUNCTION(glLinkProgram);
+    LOAD_GL_FUNCTION(glGetProgramiv);
+    LOAD_GL_FUNCTION(glGetProgramInfoLog);
+    LOAD_GL_FUNCTION(glDeleteProgram);
+    LOAD_GL_FUNCTION(glUseProgram);
+    LOAD_GL_FUNCTION(glUniform1ui);
+    LOAD_GL_FUNCTION(glDispatchCompute);
+    LOAD_GL_FUNCTION(glMemoryBarrier);
+    LOAD_GL_FUNCTION(glGenQueries);
+    LOAD_GL_FUNCTION(glDeleteQueries);
+    LOAD_GL_FUNCTION(glBeginQuery);
+    LOAD_GL_FUNCTION(glEndQuery);
+    LOAD_GL_FUNCTION(glGetQueryObjectui64v);
+    LOAD_GL_FUNCTION(glFenceSync);
+    LOAD_GL_FUNCTION(glClientWaitSync);
+    LOAD_GL_FUNCTION(glDeleteSync);
+    LOAD_GL_FUNCTION(glBufferStorage);
+    LOAD_GL_FUNCTION(glMapBufferRange);
+    LOAD_GL_FUNCTION(glUnmapBuffer);
+
+    return gl.glGetString && gl.glGetIntegerv && gl.glGetInteger64v && gl.glGetError && gl.glFinish
+            && gl.glGenBuffers && gl.glDeleteBuffers && gl.glBindBuffer && gl.glBindBufferRange
+            && gl.glBufferData && gl.glBufferSubData && gl.glCopyBufferSubData
+            && gl.glCreateShader && gl.glShaderSource && gl.glCompileShader && gl.glGetShaderiv
+            && gl.glGetShaderInfoLog && gl.glDeleteShader && gl.glCreateProgram && gl.glAttachShader
+            && gl.glLinkProgram && gl.glGetProgramiv && gl.glGetProgramInfoLog && gl.glDeleteProgram
+            && gl.glUseProgram && gl.glUniform1ui && gl.glDispatchCompute && gl.glMemoryBarrier
+            && gl.glGenQueries && gl.glDeleteQueries && gl.glBeginQuery && gl.glEndQuery
+            && gl.glGetQueryObjectui64v && gl.glFenceSync && gl.glClientWaitSync && gl.glDeleteSync;
+}
+
+/*
+ * The kernels work on uvec4 elements using a grid-stride loop. The read kernel only writes its result if it matches
+ * a magic value (practically never the case), which keeps the compiler from eliminating the loads.
+ */
+static const char* SSBO_KERNEL_SOURCE = R"(
+layout(local_size_x = 256) in;
+layout(std430, binding = 0) readonly buffer SrcBuffer { uvec4 srcData[]; };
+layout(std430, binding = 1) writeonly buffer DstBuffer { uvec4 dstData[]; };
+layout(location = 0) uniform uint numElements;
+
+void main() {
+    uint globalSize = gl_NumWorkGroups.x * gl_WorkGroupSize.x;
+#if defined(READ_KERNEL)
+    uvec4 acc = uvec4(0u);
+    for (uint i = gl_GlobalInvocationID.x; i < numElements; i += globalSize) {
+        acc ^= srcData[i];
+    }
+    if (acc == uvec4(0xDEADBEEFu)) {
+        dstData[gl_GlobalInvocationID.x] = acc;
+    }
+#elif defined(WRITE_KERNEL)
+    for (uint i = gl_GlobalInvocationID.x; i < numElements; i += globalSize) {
+        dstData[i] = uvec4(i);
+    }
+#elif defined(COPY_KERNEL)
+    for (uint i = gl_GlobalInvocationID.x; i < numElements; i += globalSize) {
+        dstData[i] = srcData[i];
+    }
+#endif
+}
+)";
+
+static const GLuint KERNEL_WORKGROUP_SIZE = 256;
+static const GLuint MAX_NUM_WORKGROUPS = 16384;
+static const int NUM_TIMED_ITERATIONS = 10;
+static const GLsizeiptr MAX_BENCHMARK_BUFFER_SIZE = GLsizeiptr(256) * 1024 * 1024;
+static const GLsizeiptr ALIGNMENT_TEST_SIZE = GLsizeiptr(64) * 1024 * 1024;
+
+class GLSsboBenchmark {
+public:
+    explicit GLSsboBenchmark(GLBenchmarkFunctionTable& gl) : gl(gl) {}
+    ~GLSsboBenchmark();
+    bool initialize();
+    void run();
+
+private:
+    GLuint createComputeProgram(const std::string& kernelDefine);
+    double measureGpuTimeMs(const std::function<void()>& func);
+    double dispatchKernel(GLuint program, GLuint srcBuffer, GLintptr srcOffset, GLuint dstBuffer, GLintptr dstOffset, GLsizeiptr size);
+    void runSizeSweep();
+    void runAlignmentSweep();
+    void runUploadComparison();
+
+    GLBenchmarkFunctionTable& gl;
+    GLint64 maxShaderStorageBlockSize = 0;
+    GLint ssboOffsetAlignment = 0;
+    GLuint readProgram = 0, writeProgram = 0, copyProgram = 0;
+    GLuint srcBuffer = 0, dstBuffer = 0;
+    GLsizeiptr bufferSize = 0;
+    GLuint timerQuery = 0;
+};
+
+GLSsboBenchmark::~GLSsboBenchmark() {
+    for (GLuint program : { readProgram, writeProgram, copyProgram }) {
+        if (program) {
+            gl.glDeleteProgram(program);
+        }
+    }
+    if (srcBuffer) {
+        gl.glDeleteBuffers(1, &srcBuffer);
+    }
+    if (dstBuffer) {
+        gl.glDeleteBuffers(1, &dstBuffer);
+    }
+    if (timerQuery) {
+        gl.glDeleteQueries(1, &timerQuery);
+    }
+}
+
+GLuint GLSsboBenchmark::createComputeProgram(const std::string& kernelDefine) {
+    std::string source = "#version 430\n#define " + kernelDefine + "\n" + SSBO_KERNEL_SOURCE;
+    const GLchar* sourcePtr = source.c_str();
+    GLuint shader = gl.glCreateShader(GL_COMPUTE_SHADER);
+    gl.glShaderSource(shader, 1, &sourcePtr, nullptr);
+    gl.glCompileShader(shader);
+    GLint status = GL_FALSE;
+    gl.glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+    if (status != GL_TRUE) {
+        GLint infoLogLength = 0;
+        gl.glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &infoLogLength);
+        std::string infoLog(size_t(std::max(infoLogLength, 1)), '\0');
+        gl.glGetShaderInfoLog(shader, GLsizei(infoLog.size()), nullptr, infoLog.data());
+        sgl::Logfile::get()->writeError(
+                "Error in GLSsboBenchmark::createComputeProgram: Compiling " + kernelDefine + " failed: "
+                + infoLog, false);
+        gl.glDeleteShader(shader);
+        return 0;
+    }
+
+    GLuint program = gl.glCreateProgram();
+    gl.glAttachShader(program, shader);
+    gl.glLinkProgram(program);
+    gl.glDeleteShader(shader);
+    gl.glGetProgramiv(program, GL_LINK_STATUS, &status);
+    if (status != GL_TRUE) {
+        GLint infoLogLength = 0;
+        gl.glGetProgramiv(program, GL_INFO_LOG_LENGTH, &infoLogLength);
+        std::string infoLog(size_t(std::max(infoLogLength, 1)), '\0');
+        gl.glGetProgramInfoLog(program, GLsizei(infoLog.size()), nullptr, infoLog.data());
+        sgl::Logfile::get()->writeError(
+                "Error in GLSsboBenchmark::createComputeProgram: Linking " + kernelDefine + " failed: "
+                + infoLog, false);
+        gl.glDeleteProgram(program);
+        return 0;
+    }
+    return program;
+}
+
+bool GLSsboBenchmark::initialize() {
+    GLint majorVersion = 0, minorVersion = 0;
+    gl.glGetIntegerv(GL_MAJOR_VERSION, &majorVersion);
+    gl.glGetIntegerv(GL_MINOR_VERSION, &minorVersion);
+    if (majorVersion < 4 || (majorVersion == 4 && minorVersion < 3)) {
+        sgl::Logfile::get()->write(
+                "OpenGL SSBO benchmark skipped: Compute shaders require OpenGL 4.3, but the context has version "
+                + std::to_string(majorVersion) + "." + std::to_string(minorVersion) + ".", sgl::ORANGE);
+        return false;
+    }
+
+    gl.glGetInteger64v(GL_MAX_SHADER_STORAGE_BLOCK_SIZE, &maxShaderStorageBlockSize);
+    gl.glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &ssboOffsetAlignment);
+    ssboOffsetAlignment = std::max(ssboOffsetAlignment, GLint(16));
+
+    readProgram = createComputeProgram("READ_KERNEL");
+    writeProgram = createComputeProgram("WRITE_KERNEL");
+    copyProgram = createComputeProgram("COPY_KERNEL");
+    if (!readProgram || !writeProgram || !copyProgram) {
+        return false;
+    }
+
+    // The alignment sweep binds ranges at up to 16x the offset alignment, so add this as slack.
+    bufferSize = std::min(GLsizeiptr(maxShaderStorageBlockSize), MAX_BENCHMARK_BUFFER_SIZE);
+    bufferSize += GLsizeiptr(ssboOffsetAlignment) * 16;
+    gl.glGenBuffers(1, &srcBuffer);
+    gl.glGenBuffers(1, &dstBuffer);
+    std::vector<uint8_t> initialData(size_t(bufferSize), uint8_t(0x5A));
+    for (GLuint buffer : { srcBuffer, dstBuffer }) {
+        gl.glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffer);
+        gl.glBufferData(GL_SHADER_STORAGE_BUFFER, bufferSize, initialData.data(), GL_STATIC_DRAW);
+    }
+    gl.glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    gl.glGenQueries(1, &timerQuery);
+
+    GLenum errorCode = gl.glGetError();
+    if (errorCode != 0) {
+        sgl::Logfile::get()->writeError(
+                "Error in GLSsboBenchmark::initialize: Buffer allocation failed (error code: "
+                + std::to_string(errorCode) + ").", false);
+        return false;
+    }
+    return true;
+}
+
+double GLSsboBenchmark::measureGpuTimeMs(const std::function<void()>& func) {
+    // The warm-up samples of the runner also exclude lazy allocation and shader upload costs.
+    return runBenchmark([&]() {
+        gl.glBeginQuery(GL_TIME_ELAPSED, timerQuery);
+        for (int i = 0; i < NUM_TIMED_ITERATIONS; i++) {
+            func();
+        }
+        gl.glEndQuery(GL_TIME_ELAPSED);
+        GLuint64 elapsedTimeNs = 0;
+        gl.glGetQueryObjectui64v(timerQuery, GL_QUERY_RESULT, &elapsedTimeNs);
+        return double(elapsedTimeNs) * 1e-6 / double(NUM_TIMED_ITERATIONS);
+    }).median;
+}
+
+double GLSsboBenchmark::dispatchKernel(
+        GLuint program, GLuint srcBuf, GLintptr srcOffset, GLuint dstBuf, GLintptr dstOffset, GLsizeiptr size) {
+    auto numElements = GLuint(size / 16);
+    GLuint numWorkgroups = std::min((numElements + KERNEL_WORKGROUP_SIZE - 1) / KERNEL_WORKGROUP_SIZE, MAX_NUM_WORKGROUPS);
+    gl.glUseProgram(program);
+    gl.glUniform1ui(0, numElements);
+    gl.glBindBufferRange(GL_SHADER_STORAGE_BUFFER, 0, srcBuf, srcOffset, size);
+    gl.glBindBufferRange(GL_SHADER_STORAGE_BUFFER, 1, dstBuf, dstOffset, size);
+    double timeMs = measureGpuTimeMs([&]() {
+        gl.glDispatchCompute(numWorkgroups, 1, 1);
+        gl.glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+    });
+    gl.glUseProgram(0);
+    return timeMs;
+}
+
+void GLSsboBenchmark::runSizeSweep() {
+    GLsizeiptr maxSize = std::min(GLsizeiptr(maxShaderStorageBlockSize), MAX_BENCHMARK_BUFFER_SIZE);
+    ResultTable table({ "Size", "Read GiB/s", "Write GiB/s", "Copy (shader) GiB/s", "Copy (glCopyBufferSubData) GiB/s" });
+    for (GLsizeiptr size = GLsizeiptr(1024) * 1024; size <= maxSize; size *= 4) {
+        double readMs = dispatchKernel(readProgram, srcBuffer, 0, dstBuffer, 0, size);
+        double writeMs = dispatchKernel(writeProgram, srcBuffer, 0, dstBuffer, 0, size);
+        double copyMs = dispatchKernel(copyProgram, srcBuffer, 0, dstBuffer, 0, size);
+        gl.glBindBuffer(GL_COPY_READ_BUFFER, srcBuffer);
+        gl.glBindBuffer(GL_COPY_WRITE_BUFFER, dstBuffer);
+        double copyBufferSubDataMs = measureGpuTimeMs([&]() {
+            gl.glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, size);
+        });
+        gl.glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        gl.glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        table.addRow({
+                sgl::getNiceMemoryString(uint64_t(size), 2),
+                formatNumber(computeGiBPerSecond(double(size), readMs)),
+                formatNumber(computeGiBPerSecond(double(size), writeMs)),
+                formatNumber(computeGiBPerSecond(2.0 * double(size), copyMs)),
+                formatNumber(computeGiBPerSecond(2.0 * double(size), copyBufferSubDataMs)) });
+    }
+    writeOut("");
+    writeOut("OpenGL SSBO bandwidth over buffer size (GPU time):");
+    table.print();
+}
+
+void GLSsboBenchmark::runAlignmentSweep() {
+    GLsizeiptr size = std::min(
+            std::min(GLsizeiptr(maxShaderStorageBlockSize), MAX_BENCHMARK_BUFFER_SIZE), ALIGNMENT_TEST_SIZE);
+    ResultTable table({ "Offset", "Alignment multiple", "Read GiB/s", "Write GiB/s", "Copy (shader) GiB/s" });
+    for (GLintptr alignmentMultiple : { 0, 1, 2, 3, 4, 8, 16 }) {
+        GLintptr offset = alignmentMultiple * GLintptr(ssboOffsetAlignment);
+        double readMs = dispatchKernel(readProgram, srcBuffer, offset, dstBuffer, offset, size);
+        double writeMs = dispatchKernel(writeProgram, srcBuffer, offset, dstBuffer, offset, size);
+        double copyMs = dispatchKernel(copyProgram, srcBuffer, offset, dstBuffer, offset, size);
+        table.addRow({
+                std::to_string(offset) + " B",
+                std::to_string(alignmentMultiple),
+                formatNumber(computeGiBPerSecond(double(size), readMs)),
+                formatNumber(computeGiBPerSecond(double(size), writeMs)),
+                formatNumber(computeGiBPerSecond(2.0 * double(size), copyMs)) });
+    }
+    writeOut("");
+    writeOut(
+            "OpenGL SSBO bandwidth over binding offset (", sgl::getNiceMemoryString(uint64_t(size), 2),
+            " range, offset alignment ", ssboOffsetAlignment, " B):");
+    table.print();
+}
+
+void GLSsboBenchmark::runUploadComparison() {
+    const GLsizeiptr maxUploadSize = std::min(GLsizeiptr(64) * 1024 * 1024, bufferSize);
+    std::vector<uint8_t> hostData(size_t(maxUploadSize));
+    for (size_t i = 0; i < hostData.size(); i++) {
+        hostData[i] = uint8_t(i * 7u + 3u);
+    }
+
+    // Persistent-mapped (coherent) buffer usable both as a staging buffer and directly as an SSBO.
+    bool hasBufferStorage = gl.glBufferStorage && gl.glMapBufferRange && gl.glUnmapBuffer;
+    GLuint persistentBuffer = 0;
+    void* persistentPtr = nullptr;
+    if (hasBufferStorage) {
+        const GLbitfield storageFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        gl.glGenBuffers(1, &persistentBuffer);
+        gl.glBindBuffer(GL_COPY_WRITE_BUFFER, persistentBuffer);
+        gl.glBufferStorage(GL_COPY_WRITE_BUFFER, maxUploadSize, nullptr, storageFlags);
+        persistentPtr = gl.glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, maxUploadSize, storageFlags);
+        gl.glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        if (!persistentPtr) {
+            sgl::Logfile::get()->write(
+                    "OpenGL SSBO benchmark: Persistent mapping failed; skipping mapped upload paths.", sgl::ORANGE);
+            gl.glDeleteBuffers(1, &persistentBuffer);
+            persistentBuffer = 0;
+            hasBufferStorage = false;
+        }
+    }
+
+    auto measureWallTimeMs = [&](const std::function<void()>& func) {
+        return runBenchmark([&]() {
+            gl.glFinish();
+            auto startTime = std::chrono::high_resolution_clock::now();
+            for (int i = 0; i < NUM_TIMED_ITERATIONS; i++) {
+                func();
+            }
+            gl.glFinish();
+            auto endTime = std::chrono::high_resolution_clock::now();
+            double elapsedMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+            return elapsedMs / double(NUM_TIMED_ITERATIONS);
+        }).median;
+    };
+    auto waitForFence = [&]() {
+        GLsync fence = gl.glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        GLenum waitResult;
+        do {
+            waitResult = gl.glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, GLuint64(1000000000));
+        } while (waitResult == GL_TIMEOUT_EXPIRED);
+        gl.glDeleteSync(fence);
+    };
+
+    ResultTable table({
+            "Size", "glBufferSubData GiB/s", "Mapped staging + copy GiB/s", "Mapped memcpy GiB/s",
+            "GPU read of mapped GiB/s" });
+    for (GLsizeiptr size = GLsizeiptr(64) * 1024; size <= maxUploadSize; size *= 4) {
+        gl.glBindBuffer(GL_SHADER_STORAGE_BUFFER, dstBuffer);
+        double bufferSubDataMs = measureWallTimeMs([&]() {
+            gl.glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, size, hostData.data());
+        });
+        gl.glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+        std::string stagingString = "n/a", memcpyString = "n/a", mappedReadString = "n/a";
+        if (hasBufferStorage) {
+            // The fence is necessary before the staging memory may be overwritten again.
+            gl.glBindBuffer(GL_COPY_READ_BUFFER, persistentBuffer);
+            gl.glBindBuffer(GL_COPY_WRITE_BUFFER, dstBuffer);
+            double stagingMs = measureWallTimeMs([&]() {
+                memcpy(persistentPtr, hostData.data(), size_t(size));
+                gl.glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, size);
+                waitForFence();
+            });
+            gl.glBindBuffer(GL_COPY_READ_BUFFER, 0);
+            gl.glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+            // With a coherent mapping, the data is visible to the GPU without any further API call.
+            double memcpyMs = measureWallTimeMs([&]() {
+                memcpy(persistentPtr, hostData.data(), size_t(size));
+            });
+            double mappedReadMs = dispatchKernel(readProgram, persistentBuffer, 0, dstBuffer, 0, size);
+
+            stagingString = formatNumber(computeGiBPerSecond(double(size), stagingMs));
+            memcpyString = formatNumber(computeGiBPerSecond(double(size), memcpyMs));
+            mappedReadString = formatNumber(computeGiBPerSecond(double(size), mappedReadMs));
+        }
+
+        table.addRow({
+                sgl::getNiceMemoryString(uint64_t(size), 2),
+                formatNumber(computeGiBPerSecond(double(size), bufferSubDataMs)),
+                stagingString, memcpyString, mappedReadString });
+    }
+
+    if (persistentBuffer) {
+        gl.glBindBuffer(GL_COPY_WRITE_BUFFER, persistentBuffer);
+        gl.glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+        gl.glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        gl.glDeleteBuffers(1, &persistentBuffer);
+    }
+
+    writeOut("");
+    writeOut("OpenGL upload paths (wall clock until data is usable by the GPU):");
+    table.print();
+}
+
+void GLSsboBenchmark::run() {
+    runSizeSweep();
+    runAlignmentSweep();
+    runUploadComparison();
+}
+
+void runOpenGLSsboBenchmark(void* (*getGlFunctionPointer)(const char* functionName)) {
+    GLBenchmarkFunctionTable gl{};
+    if (!loadGlBenchmarkFunctions(gl, getGlFunctionPointer)) {
+        sgl::Logfile::get()->write(
+                "OpenGL SSBO benchmark skipped: At least one function pointer could not be loaded.", sgl::ORANGE);
+        return;
+    }
+
+    writeOut("");
+    writeOut("OpenGL SSBO benchmark on ", std::string((const char*)gl.glGetString(GL_RENDERER)), ":");
+    GLSsboBenchmark benchmark(gl);
+    if (benchmark.initialize()) {
+        benchmark.run();
+    }
+}
@@ -0,0 +1,312 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "JsonWriter.hpp"
+#include "GemmPerformanceModel.hpp"
+
+/// Upper limit of the searched number of concurrently running workgroups.
+static const uint32_t MAX_CONCURRENT_WORKGROUPS = 65536;
+
+static uint32_t roundUpToMultiple(uint32_t value, uint32_t multiple) {
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+/// Solves the 3x3 system A x = b with partial pivoting; returns false if it is (close to) singular.
+static bool solveLinearSystem3(double A[3][3], double b[3], double x[3]) {
+    for (int col = 0; col < 3; col++) {
+        int pivotRow = col;
+        for (int row = col + 1; row < 3; row++) {
+            if (std::abs(A[row][col]) > std::abs(A[pivotRow][col])) {
+                pivotRow = row;
+            }
+        }
+        if (std::abs(A[pivotRow][col]) < 1e-30) {
+            return false;
+        }
+        std::swap(A[col], A[pivotRow]);
+        std::swap(b[col], b[pivotRow]);
+        for (int row = col + 1; row < 3; row++) {
+            double factor = A[row][col] / A[col][col];
+            for (int k = col; k < 3; k++) {
+                A[row][k] -= factor * A[col][k];
+            }
+            b[row] -= factor * b[col];
+        }
+    }
+    for (int row = 2; row >= 0; row--) {
+        double sum = b[row];
+        for (int k = row + 1; k < 3; k++) {
+            sum -= A[row][k] * x[k];
+        }
+        x[row] = sum / A[row][row];
+    }
+    return true;
+}
+
+GemmPerformanceModel::GemmPerformanceModel(const GemmTileGranularity& granularity) : granularity(granularity) {
+}
+
+double GemmPerformanceModel::getNumWaves(uint32_t M, uint32_t N, uint32_t numConcurrentWorkgroups) const {
+    uint64_t numTiles = uint64_t(roundUpToMultiple(M, granularity.tileM) / granularity.tileM)
+            * uint64_t(roundUpToMultiple(N, granularity.tileN) / granularity.tileN);
+    uint64_t numWorkgroups = (numTiles + granularity.tilesPerWorkgroup - 1) / granularity.tilesPerWorkgroup;
+    return double((numWorkgroups + numConcurrentWorkgroups - 1) / numConcurrentWorkgroups);
+}
+
+uint32_t GemmPerformanceModel::getPaddedK(uint32_t K) const {
+    return roundUpToMultiple(K, granularity.tileK);
+}
+
+double GemmPerformanceModel::predictBase(const BaseModel& model, uint32_t M, uint32_t N, uint32_t K) const {
+    double waves = getNumWaves(M, N, model.concurrentWorkgroups);
+    double timeMs = model.t0 + waves * (model.a * double(getPaddedK(K)) + model.b);
+    return std::max(timeMs, 1e-6);
+}
+
+GemmPerformanceModel::BaseModel GemmPerformanceModel::fitBase(
+        const std::vector<GemmShapeMeasurement>& measurements) const {
+    uint32_t maxNumWorkgroups = 1;
+    for (const auto& measurement : measurements) {
+        maxNumWorkgroups = std::max(maxNumWorkgroups, uint32_t(getNumWaves(measurement.M, measurement.N, 1)));
+    }
+    maxNumWorkgroups = std::min(maxNumWorkgroups, MAX_CONCURRENT_WORKGROUPS);
+
+    // Weighted least squares with weights 1/t^2 minimizes the squared relative error for each candidate.
+    BaseModel bestModel;
+    double bestError = INFINITY;
+    for (uint32_t candidate = 1; candidate <= maxNumWorkgroups; candidate++) {
+        double A[3][3] = {}, rhs[3] = {}, params[3] = {};
+        for (const auto& measurement : measurements) {
+            double waves = getNumWaves(measurement.M, measurement.N, candidate);
+            double x[3] = { 1.0, waves * double(getPaddedK(measurement.K)), waves };
+            double weight = 1.0 / (measurement.timeMs * measurement.timeMs);
+            for (int i = 0; i < 3; i++) {
+                for (int j = 0; j < 3; j++) {
+                    A[i][j] += weight * x[i] * x[j];
+                }
+                rhs[i] += weight * x[i] * measurement.timeMs;
+            }
+        }
+        if (!solveLinearSystem3(A, rhs, params)) {
+            continue;
+        }
+        BaseModel model{ candidate, params[0], params[1], params[2] };
+        double error = 0.0;
+        for (const auto& measurement : measurements) {
+            double relativeError =
+                    predictBase(model, measurement.M, measurement.N, measurement.K) / measurement.timeMs - 1.0;
+            error += relativeError * relativeError;
+        }
+        if (error < bestError) {
+            bestError = error;
+            bestModel = model;
+        }
+    }
+    return bestModel;
+}
+
+void GemmPerformanceModel::getGridCoordinates(uint32_t M, uint32_t N, uint32_t K, double& u, double& v) const {
+    double paddedM = double(roundUpToMultiple(M, granularity.tileM));
+    double paddedN = double(roundUpToMultiple(N, granularity.tileN));
+    u = 0.5 * std::log2(paddedM * paddedN);
+    v = std::log2(double(getPaddedK(K)));
+}
+
+void GemmPerformanceModel::fitCorrectionGrid(
+        const BaseModel& model, const std::vector<GemmShapeMeasurement>& measurements,
+        std::array<double, GRID_SIZE * GRID_SIZE>& grid) const {
+    // Inverse distance weighting of the log residuals at the grid vertices.
+    std::vector<double> us, vs, residuals;
+    for (const auto& measurement : measurements) {
+        double u, v;
+        getGridCoordinates(measurement.M, measurement.N, measurement.K, u, v);
+        us.push_back((u - uMin) / (uMax - uMin));
+        vs.push_back((v - vMin) / (vMax - vMin));
+        residuals.push_back(std::log(
+                measurement.timeMs / predictBase(model, measurement.M, measurement.N, measurement.K)));
+    }
+    for (int j = 0; j < GRID_SIZE; j++) {
+        for (int i = 0; i < GRID_SIZE; i++) {
+            double gridU = double(i) / double(GRID_SIZE - 1);
+            double gridV = double(j) / double(GRID_SIZE - 1);
+            double weightSum = 0.0, valueSum = 0.0;
+            for (size_t idx = 0; idx < residuals.size(); idx++) {
+                double du = gridU - us.at(idx), dv = gridV - vs.at(idx);
+                double weight = 1.0 / (du * du + dv * dv + 1e-6);
+                weightSum += weight;
+                valueSum += weight * residuals.at(idx);
+            }
+            grid.at(j * GRID_SIZE + i) = weightSum > 0.0 ? valueSum / weightSum : 0.0;
+        }
+    }
+}
+
+double GemmPerformanceModel::lookupCorrection(
+        const std::array<double, GRID_SIZE * GRID_SIZE>& grid, double u, double v) const {
+    double x = std::clamp((u - uMin) / (uMax - uMin), 0.0, 1.0) * double(GRID_SIZE - 1);
+    double y = std::clamp((v - vMin) / (vMax - vMin), 0.0, 1.0) * double(GRID_SIZE - 1);
+    int i0 = std::min(int(x), GRID_SIZE - 2), j0 = std::min(int(y), GRID_SIZE - 2);
+    double fx = x - double(i0), fy = y - double(j0);
+    double bottom = (1.0 - fx) * grid.at(j0 * GRID_SIZE + i0) + fx * grid.at(j0 * GRID_SIZE + i0 + 1);
+    double top = (1.0 - fx) * grid.at((j0 + 1) * GRID_SIZE + i0) + fx * grid.at((j0 + 1) * GRID_SIZE + i0 + 1);
+    return (1.0 - fy) * bottom + fy * top;
+}
+
+void GemmPerformanceModel::fit(const std::vector<GemmShapeMeasurement>& measurements) {
+    if (measurements.size() < 3) {
+        throw std::runtime_error("GemmPerformanceModel::fit: At least three measurements are needed.");
+    }
+    uMin = vMin = INFINITY;
+    uMax = vMax = -INFINITY;
+    for (const auto& measurement : measurements) {
+        double u, v;
+        getGridCoordinates(measurement.M, measurement.N, measurement.K, u, v);
+        uMin = std::min(uMin, u);
+        uMax = std::max(uMax, u);
+        vMin = std::min(vMin, v);
+        vMax = std::max(vMax, v);
+    }
+    if (uMax - uMin < 1.0) {
+        uMax = uMin + 1.0;
+    }
+    if (vMax - vMin < 1.0) {
+        vMax = vMin + 1.0;
+    }
+
+    baseModel = fitBase(measurements);
+    concurrentWorkgroups = baseModel.concurrentWorkgroups;
+    fitCorrectionGrid(baseModel, measurements, correctionGrid);
+
+    // Leave-one-out errors of the complete model as error bound.
+    std::vector<double> errors;
+    if (measurements.size() > 3) {
+        for (size_t heldOutIdx = 0; heldOutIdx < measurements.size(); heldOutIdx++) {
+            std::vector<GemmShapeMeasurement> trainingSet;
+            for (size_t idx = 0; idx < measurements.size(); idx++) {
+                if (idx != heldOutIdx) {
+                    trainingSet.push_back(measurements.at(idx));
+                }
+            }
+            const auto& heldOut = measurements.at(heldOutIdx);
+            BaseModel model = fitBase(trainingSet);
+            std::array<double, GRID_SIZE * GRID_SIZE> grid{};
+            fitCorrectionGrid(model, trainingSet, grid);
+            double u, v;
+            getGridCoordinates(heldOut.M, heldOut.N, heldOut.K, u, v);
+            double timeMs = predictBase(model, heldOut.M, heldOut.N, heldOut.K)
+                    * std::exp(lookupCorrection(grid, u, v));
+            errors.push_back(std::abs(timeMs / heldOut.timeMs - 1.0));
+        }
+        std::sort(errors.begin(), errors.end());
+        size_t percentileIdx = size_t(std::ceil(0.95 * double(errors.size()))) - 1;
+        relativeErrorBound = errors.at(std::min(percentileIdx, errors.size() - 1));
+    } else {
+        relativeErrorBound = 1.0;
+    }
+    isFitted = true;
+}
+
+GemmPrediction GemmPerformanceModel::predict(uint32_t M, uint32_t N, uint32_t K) const {
+    if (!isFitted) {
+        throw std::runtime_error("GemmPerformanceModel::predict: The model has not been fitted.");
+    }
+    GemmPrediction prediction;
+    double u, v;
+    getGridCoordinates(M, N, K, u, v);
+    const double epsilon = 1e-9;
+    prediction.isExtrapolated =
+            u < uMin - epsilon || u > uMax + epsilon || v < vMin - epsilon || v > vMax + epsilon;
+    prediction.timeMs = predictBase(baseModel, M, N, K) * std::exp(lookupCorrection(correctionGrid, u, v));
+    double errorBound = prediction.isExtrapolated ? 2.0 * relativeErrorBound : relativeErrorBound;
+    prediction.minTimeMs = prediction.timeMs / (1.0 + errorBound);
+    prediction.maxTimeMs = prediction.timeMs * (1.0 + errorBound);
+    prediction.teraOpsPerSecond = 2.0 * double(M) * double(N) * double(K) / (prediction.timeMs * 1e9);
+    return prediction;
+}
+
+void GemmPerformanceModel::writeJson(JsonWriter& writer) const {
+    writer.beginObject();
+    writer.key("granularity");
+    writer.beginObject();
+    writer.keyValue("tileM", granularity.tileM);
+    writer.keyValue("tileN", granularity.tileN);
+    writer.keyValue("tileK", granularity.tileK);
+    writer.keyValue("tilesPerWorkgroup", granularity.tilesPerWorkgroup);
+    writer.endObject();
+    writer.keyValue("concurrentWorkgroups", baseModel.concurrentWorkgroups);
+    writer.keyValue("t0Ms", baseModel.t0);
+    writer.keyValue("msPerWaveAndK", baseModel.a);
+    writer.keyValue("msPerWave", baseModel.b);
+    writer.keyValue("relativeErrorBound", relativeErrorBound);
+    writer.key("correctionGrid");
+    writer.beginObject();
+    writer.keyValue("log2SqrtMNMin", uMin);
+    writer.keyValue("log2SqrtMNMax", uMax);
+    writer.keyValue("log2KMin", vMin);
+    writer.keyValue("log2KMax", vMax);
+    writer.keyValue("size", int32_t(GRID_SIZE));
+    writer.key("logRatios");
+    writer.beginArray();
+    for (double value : correctionGrid) {
+        writer.value(value);
+    }
+    writer.endArray();
+    writer.endObject();
+    writer.endObject();
+}
+
+void GemmPerformancePredictor::addModel(const std::string& types, GemmPerformanceModel model) {
+    models.erase(types);
+    models.emplace(types, std::move(model));
+}
+
+bool GemmPerformancePredictor::hasModel(const std::string& types) const {
+    return models.find(types) != models.end();
+}
+
+GemmPrediction GemmPerformancePredictor::predict(
+        const std::string& types, uint32_t M, uint32_t N, uint32_t K) const {
+    auto it = models.find(types);
+    if (it == models.end()) {
+        throw std::runtime_error("GemmPerformancePredictor::predict: No model for " + types + ".");
+    }
+    return it->second.predict(M, N, K);
+}
+
+void GemmPerformancePredictor::writeJson(JsonWriter& writer) const {
+    writer.beginObject();
+    for (const auto& entry : models) {
+        writer.key(entry.first);
+        entry.second.writeJson(writer);
+    }
+    writer.endObject();
+}
@@ -0,0 +1,122 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef QUERYVKCOOPMAT_GEMMPERFORMANCEMODEL_HPP
+#define QUERYVKCOOPMAT_GEMMPERFORMANCEMODEL_HPP
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class JsonWriter;
+
+/// Work decomposition of a GEMM kernel configuration (e.g., derived from the KHR or NV2 cooperative matrix sizes).
+struct GemmTileGranularity {
+    uint32_t tileM = 32, tileN = 32; ///< Output tile computed by one subgroup (or workgroup for workgroup scope).
+    uint32_t tileK = 16; ///< K is rounded up to multiples of this.
+    uint32_t tilesPerWorkgroup = 4;
+};
+
+struct GemmShapeMeasurement {
+    uint32_t M = 0, N = 0, K = 0;
+    double timeMs = 0.0;
+};
+
+struct GemmPrediction {
+    double timeMs = 0.0;
+    double minTimeMs = 0.0, maxTimeMs = 0.0; ///< Bounds from the leave-one-out error of the training shapes.
+    double teraOpsPerSecond = 0.0;
+    bool isExtrapolated = false; ///< Outside the range of the training shapes; the bounds are widened.
+};
+
+/**
+ * Predicts the runtime of a GEMM kernel for arbitrary (M, N, K) from a few measured shapes. The base model counts the
+ * waves of workgroups after rounding the problem up to the tile granularity:
+ *   time = t0 + waves(M, N) * (a * K' + b),  waves = ceil(numWorkgroups / concurrentWorkgroups),
+ * where concurrentWorkgroups, t0, a and b are fitted to the measurements. The remaining error is corrected by
+ * bilinear interpolation on a grid over log2(sqrt(M' * N')) and log2(K') that is filled from the residuals of the
+ * training shapes. predict() is O(1).
+ */
+class GemmPerformanceModel {
+public:
+    explicit GemmPerformanceModel(const GemmTileGranularity& granularity);
+
+    /// Throws std::runtime_error if there are fewer than three measurements.
+    void fit(const std::vector<GemmShapeMeasurement>& measurements);
+    [[nodiscard]] GemmPrediction predict(uint32_t M, uint32_t N, uint32_t K) const;
+
+    [[nodiscard]] inline const GemmTileGranularity& getGranularity() const { return granularity; }
+    [[nodiscard]] inline uint32_t getConcurrentWorkgroups() const { return concurrentWorkgroups; }
+    /// Relative error bound, i.e., the 95th percentile of the leave-one-out errors of the training shapes.
+    [[nodiscard]] inline double getRelativeErrorBound() const { return relativeErrorBound; }
+    void writeJson(JsonWriter& writer) const;
+
+private:
+    static const int GRID_SIZE = 8;
+    struct BaseModel {
+        uint32_t concurrentWorkgroups = 1;
+        double t0 = 0.0, a = 0.0, b = 0.0;
+    };
+    [[nodiscard]] double getNumWaves(uint32_t M, uint32_t N, uint32_t concurrentWorkgroups) const;
+    [[nodiscard]] uint32_t getPaddedK(uint32_t K) const;
+    [[nodiscard]] double predictBase(const BaseModel& model, uint32_t M, uint32_t N, uint32_t K) const;
+    [[nodiscard]] BaseModel fitBase(const std::vector<GemmShapeMeasurement>& measurements) const;
+    void getGridCoordinates(uint32_t M, uint32_t N, uint32_t K, double& u, double& v) const;
+    void fitCorrectionGrid(
+            const BaseModel& model, const std::vector<GemmShapeMeasurement>& measurements,
+            std::array<double, GRID_SIZE * GRID_SIZE>& grid) const;
+    [[nodiscard]] double lookupCorrection(
+            const std::array<double, GRID_SIZE * GRID_SIZE>& grid, double u, double v) const;
+
+    GemmTileGranularity granularity;
+    BaseModel baseModel;
+    uint32_t concurrentWorkgroups = 1;
+    double uMin = 0.0, uMax = 1.0, vMin = 0.0, vMax = 1.0; ///< Range of the training shapes in grid coordinates.
+    std::array<double, GRID_SIZE * GRID_SIZE> correctionGrid{}; ///< log(measured / base model).
+    double relativeErrorBound = 0.0;
+    bool isFitted = false;
+};
+
+/**
+ * Models per type combination (e.g., "f16*f16+f32->f32", see getTypeCombinationLabel) for lookups by the scheduler.
+ */
+class GemmPerformancePredictor {
+public:
+    void addModel(const std::string& types, GemmPerformanceModel model);
+    [[nodiscard]] bool hasModel(const std::string& types) const;
+    /// Throws std::runtime_error if no model exists for the type combination.
+    [[nodiscard]] GemmPrediction predict(const std::string& types, uint32_t M, uint32_t N, uint32_t K) const;
+    void writeJson(JsonWriter& writer) const;
+
+private:
+    std::unordered_map<std::string, GemmPerformanceModel> models;
+};
+
+#endif //QUERYVKCOOPMAT_GEMMPERFORMANCEMODEL_HPP
@@ -0,0 +1,231 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <sstream>
+#include <stdexcept>
+
+#include <Graphics/Vulkan/libs/volk/volk.h>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <ctime>
+#endif
+
+#include "VulkanUtils.hpp"
+#include "GpuTimer.hpp"
+
+#ifdef _WIN32
+static const VkTimeDomainKHR HOST_TIME_DOMAIN = VK_TIME_DOMAIN_QUERY_PERFORMANCE_COUNTER_KHR;
+#else
+static const VkTimeDomainKHR HOST_TIME_DOMAIN = VK_TIME_DOMAIN_CLOCK_MONOTONIC_KHR;
+#endif
+
+/// Converts a timestamp of HOST_TIME_DOMAIN to nanoseconds.
+static int64_t hostTicksToNs(uint64_t hostTicks) {
+#ifdef _WIN32
+    LARGE_INTEGER frequency;
+    QueryPerformanceFrequency(&frequency);
+    return int64_t(double(hostTicks) * 1e9 / double(frequency.QuadPart));
+#else
+    return int64_t(hostTicks);
+#endif
+}
+
+GpuTimer::GpuTimer(
+        VkPhysicalDevice physicalDevice, VkDevice device, uint32_t queueFamilyIndex, bool useSynchronization2)
+        : device(device), useSynchronization2(useSynchronization2) {
+    VkPhysicalDeviceProperties properties{};
+    vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+    uint32_t numQueueFamilies = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &numQueueFamilies, nullptr);
+    std::vector<VkQueueFamilyProperties> queueFamilyProperties(numQueueFamilies);
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &numQueueFamilies, queueFamilyProperties.data());
+    if (queueFamilyIndex < numQueueFamilies) {
+        timestampValidBits = queueFamilyProperties.at(queueFamilyIndex).timestampValidBits;
+    }
+    // Without timestampComputeAndGraphics, support is determined per queue family by timestampValidBits.
+    isSupported = timestampValidBits != 0 && properties.limits.timestampPeriod > 0.0f;
+    timestampPeriodNs = double(properties.limits.timestampPeriod);
+    timestampMask = timestampValidBits >= 64 ? ~uint64_t(0) : (uint64_t(1) << timestampValidBits) - 1;
+}
+
+GpuTimer::~GpuTimer() {
+    for (VkQueryPool queryPool : queryPools) {
+        vkDestroyQueryPool(device, queryPool, nullptr);
+    }
+    queryPools.clear();
+}
+
+void GpuTimer::writeTimestamp(VkCommandBuffer commandBuffer, VkQueryPool queryPool, uint32_t queryIdx) {
+    if (useSynchronization2) {
+        vkCmdWriteTimestamp2(commandBuffer, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, queryPool, queryIdx);
+    } else {
+        vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, queryPool, queryIdx);
+    }
+}
+
+uint32_t GpuTimer::beginInterval(VkCommandBuffer commandBuffer) {
+    if (!isSupported) {
+        throw std::runtime_error("Error in GpuTimer::beginInterval: Timestamp queries are not supported.");
+    }
+    uint32_t intervalIdx = numUsedIntervals++;
+    uint32_t poolIdx = intervalIdx / INTERVALS_PER_QUERY_POOL;
+    if (poolIdx >= uint32_t(queryPools.size())) {
+        VkQueryPoolCreateInfo queryPoolCreateInfo{};
+        queryPoolCreateInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        queryPoolCreateInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+        queryPoolCreateInfo.queryCount = 2 * INTERVALS_PER_QUERY_POOL;
+        VkQueryPool queryPool = VK_NULL_HANDLE;
+        throwIfVkError(vkCreateQueryPool(device, &queryPoolCreateInfo, nullptr, &queryPool), "vkCreateQueryPool");
+        queryPools.push_back(queryPool);
+    }
+    VkQueryPool queryPool = queryPools.at(poolIdx);
+    uint32_t queryIdx = 2 * (intervalIdx % INTERVALS_PER_QUERY_POOL);
+    vkCmdResetQueryPool(commandBuffer, queryPool, queryIdx, 2);
+    writeTimestamp(commandBuffer, queryPool, queryIdx);
+    return intervalIdx;
+}
+
+void GpuTimer::endInterval(VkCommandBuffer commandBuffer, uint32_t intervalIdx) {
+    VkQueryPool queryPool = queryPools.at(intervalIdx / INTERVALS_PER_QUERY_POOL);
+    writeTimestamp(commandBuffer, queryPool, 2 * (intervalIdx % INTERVALS_PER_QUERY_POOL) + 1);
+}
+
+void GpuTimer::getIntervalTimestamps(uint32_t intervalIdx, uint64_t timestamps[2]) {
+    VkQueryPool queryPool = queryPools.at(intervalIdx / INTERVALS_PER_QUERY_POOL);
+    throwIfVkError(vkGetQueryPoolResults(
+            device, queryPool, 2 * (intervalIdx % INTERVALS_PER_QUERY_POOL), 2, 2 * sizeof(uint64_t), timestamps,
+            sizeof(uint64_t), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT), "vkGetQueryPoolResults");
+}
+
+double GpuTimer::getIntervalMs(uint32_t intervalIdx) {
+    uint64_t timestamps[2];
+    getIntervalTimestamps(intervalIdx, timestamps);
+    uint64_t elapsedTicks = (timestamps[1] - timestamps[0]) & timestampMask;
+    return double(elapsedTicks) * timestampPeriodNs * 1e-6;
+}
+
+uint64_t GpuTimer::getIntervalStartTicks(uint32_t intervalIdx) {
+    uint64_t timestamps[2];
+    getIntervalTimestamps(intervalIdx, timestamps);
+    return timestamps[0];
+}
+
+
+CalibratedClock::CalibratedClock(sgl::vk::Device* device) : device(device->getVkDevice()) {
+    timestampPeriodNs = double(device->getPhysicalDeviceProperties().limits.timestampPeriod);
+    PFN_vkGetPhysicalDeviceCalibrateableTimeDomainsKHR getTimeDomains = nullptr;
+    if (device->isDeviceExtensionSupported(VK_KHR_CALIBRATED_TIMESTAMPS_EXTENSION_NAME)
+            && vkGetPhysicalDeviceCalibrateableTimeDomainsKHR && vkGetCalibratedTimestampsKHR) {
+        useKhrExtension = true;
+        getTimeDomains = vkGetPhysicalDeviceCalibrateableTimeDomainsKHR;
+        sourceString = VK_KHR_CALIBRATED_TIMESTAMPS_EXTENSION_NAME;
+    } else if (device->isDeviceExtensionSupported(VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME)
+            && vkGetPhysicalDeviceCalibrateableTimeDomainsEXT && vkGetCalibratedTimestampsEXT) {
+        getTimeDomains = vkGetPhysicalDeviceCalibrateableTimeDomainsEXT;
+        sourceString = VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME;
+    } else {
+        sourceString = "calibrated timestamps not supported";
+        return;
+    }
+
+    uint32_t numTimeDomains = 0;
+    getTimeDomains(device->getVkPhysicalDevice(), &numTimeDomains, nullptr);
+    std::vector<VkTimeDomainKHR> timeDomains(numTimeDomains);
+    getTimeDomains(device->getVkPhysicalDevice(), &numTimeDomains, timeDomains.data());
+    bool hasDeviceDomain = false, hasHostDomain = false;
+    for (VkTimeDomainKHR timeDomain : timeDomains) {
+        hasDeviceDomain = hasDeviceDomain || timeDomain == VK_TIME_DOMAIN_DEVICE_KHR;
+        hasHostDomain = hasHostDomain || timeDomain == HOST_TIME_DOMAIN;
+    }
+    if (!hasDeviceDomain || !hasHostDomain) {
+        sourceString = "no calibrateable device/host time domain pair";
+        return;
+    }
+    isSupported = true;
+}
+
+void CalibratedClock::calibrate() {
+    if (!isSupported) {
+        throw std::runtime_error("Error in CalibratedClock::calibrate: " + sourceString + ".");
+    }
+    VkCalibratedTimestampInfoKHR timestampInfos[2]{};
+    timestampInfos[0].sType = VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_KHR;
+    timestampInfos[0].timeDomain = VK_TIME_DOMAIN_DEVICE_KHR;
+    timestampInfos[1].sType = VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_KHR;
+    timestampInfos[1].timeDomain = HOST_TIME_DOMAIN;
+    uint64_t timestamps[2] = {};
+    uint64_t maxDeviation = 0;
+    PFN_vkGetCalibratedTimestampsKHR getCalibratedTimestamps =
+            useKhrExtension ? vkGetCalibratedTimestampsKHR : vkGetCalibratedTimestampsEXT;
+    throwIfVkError(
+            getCalibratedTimestamps(device, 2, timestampInfos, timestamps, &maxDeviation),
+            "vkGetCalibratedTimestamps");
+    deviceTicksAtCalibration = timestamps[0];
+    hostNsAtCalibration = hostTicksToNs(timestamps[1]);
+    maxDeviationNs = maxDeviation;
+}
+
+int64_t CalibratedClock::convertDeviceTicksToHostNs(uint64_t deviceTicks) const {
+    // Signed difference, as the interval may start before or after the calibration.
+    auto deltaTicks = int64_t(deviceTicks - deviceTicksAtCalibration);
+    return hostNsAtCalibration + int64_t(double(deltaTicks) * timestampPeriodNs);
+}
+
+int64_t CalibratedClock::getHostTimeNs() {
+#ifdef _WIN32
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    return hostTicksToNs(uint64_t(counter.QuadPart));
+#else
+    timespec time{};
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return int64_t(time.tv_sec) * 1000000000ll + int64_t(time.tv_nsec);
+#endif
+}
+
+
+std::string getGpuTimingInfoString(sgl::vk::Device* device) {
+    GpuTimer gpuTimer(
+            device->getVkPhysicalDevice(), device->getVkDevice(), device->getComputeQueueIndex(),
+            device->getPhysicalDeviceVulkan13Features().synchronization2);
+    std::stringstream sstr;
+    if (!gpuTimer.getIsSupported()) {
+        sstr << "CPU wall clock (no timestamp support on the compute queue)";
+        return sstr.str();
+    }
+    sstr << "GPU timestamps (period " << gpuTimer.getTimestampPeriodNs() << " ns, ";
+    sstr << gpuTimer.getTimestampValidBits() << " valid bits), ";
+    CalibratedClock calibratedClock(device);
+    sstr << calibratedClock.getSourceString();
+    return sstr.str();
+}
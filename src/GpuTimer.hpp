@@ -0,0 +1,114 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef QUERYVKCOOPMAT_GPUTIMER_HPP
+#define QUERYVKCOOPMAT_GPUTIMER_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <Graphics/Vulkan/Utils/Device.hpp>
+
+/**
+ * Measures time intervals on the GPU with timestamp queries. The queries are allocated in pairs from a list of query
+ * pools that grows on demand and is reused after reset(). If the queue family does not support timestamps (no
+ * timestampComputeAndGraphics and no valid timestamp bits), getIsSupported() returns false and callers fall back to
+ * CPU timing.
+ */
+class GpuTimer {
+public:
+    /// vkCmdWriteTimestamp2 is used if synchronization2 is enabled, and vkCmdWriteTimestamp otherwise.
+    GpuTimer(VkPhysicalDevice physicalDevice, VkDevice device, uint32_t queueFamilyIndex, bool useSynchronization2);
+    ~GpuTimer();
+    GpuTimer(const GpuTimer&) = delete;
+    GpuTimer& operator=(const GpuTimer&) = delete;
+
+    [[nodiscard]] inline bool getIsSupported() const { return isSupported; }
+    [[nodiscard]] inline double getTimestampPeriodNs() const { return timestampPeriodNs; }
+    [[nodiscard]] inline uint32_t getTimestampValidBits() const { return timestampValidBits; }
+
+    /// Writes the start timestamp after all previously recorded commands have finished; returns the interval index.
+    uint32_t beginInterval(VkCommandBuffer commandBuffer);
+    void endInterval(VkCommandBuffer commandBuffer, uint32_t intervalIdx);
+    /// The command buffer containing the interval needs to have finished execution.
+    double getIntervalMs(uint32_t intervalIdx);
+    /// Start timestamp of the interval in ticks of the device time domain (e.g., for CalibratedClock).
+    uint64_t getIntervalStartTicks(uint32_t intervalIdx);
+    /// Makes all intervals available for reuse.
+    inline void reset() { numUsedIntervals = 0; }
+
+private:
+    void writeTimestamp(VkCommandBuffer commandBuffer, VkQueryPool queryPool, uint32_t queryIdx);
+    void getIntervalTimestamps(uint32_t intervalIdx, uint64_t timestamps[2]);
+
+    static const uint32_t INTERVALS_PER_QUERY_POOL = 32;
+    VkDevice device;
+    bool useSynchronization2;
+    bool isSupported = false;
+    double timestampPeriodNs = 1.0;
+    uint32_t timestampValidBits = 0;
+    uint64_t timestampMask = 0;
+    std::vector<VkQueryPool> queryPools;
+    uint32_t numUsedIntervals = 0;
+};
+
+/**
+ * Correlates the device time domain of timestamp queries with the host clock using VK_KHR_calibrated_timestamps or
+ * VK_EXT_calibrated_timestamps. The host time domain is CLOCK_MONOTONIC on Linux and the performance counter on
+ * Windows; getHostTimeNs() returns times in the same domain.
+ */
+class CalibratedClock {
+public:
+    explicit CalibratedClock(sgl::vk::Device* device);
+
+    [[nodiscard]] inline bool getIsSupported() const { return isSupported; }
+    /// "VK_KHR_calibrated_timestamps", "VK_EXT_calibrated_timestamps" or the reason why it is not supported.
+    [[nodiscard]] inline const std::string& getSourceString() const { return sourceString; }
+    /// Takes a new pair of calibrated timestamps. Throws std::runtime_error if not supported.
+    void calibrate();
+    /// Maximum deviation of the last calibration in nanoseconds.
+    [[nodiscard]] inline uint64_t getMaxDeviationNs() const { return maxDeviationNs; }
+    [[nodiscard]] int64_t convertDeviceTicksToHostNs(uint64_t deviceTicks) const;
+    static int64_t getHostTimeNs();
+
+private:
+    VkDevice device;
+    bool isSupported = false;
+    bool useKhrExtension = false;
+    std::string sourceString;
+    double timestampPeriodNs = 1.0;
+    uint64_t deviceTicksAtCalibration = 0;
+    int64_t hostNsAtCalibration = 0;
+    uint64_t maxDeviationNs = 0;
+};
+
+/// Describes the timing source used by measureCommandsMs for the device, e.g., for printing it with the device info.
+std::string getGpuTimingInfoString(sgl::vk::Device* device);
+
+#endif //QUERYVKCOOPMAT_GPUTIMER_HPP
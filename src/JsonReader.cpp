@@ -0,0 +1,407 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+#include "JsonReader.hpp"
+
+static const char* getJsonTypeName(JsonValue::Type type) {
+    switch (type) {
+        case JsonValue::Type::NUL:
+            return "null";
+        case JsonValue::Type::BOOLEAN:
+            return "boolean";
+        case JsonValue::Type::NUMBER:
+            return "number";
+        case JsonValue::Type::STRING:
+            return "string";
+        case JsonValue::Type::ARRAY:
+            return "array";
+        case JsonValue::Type::OBJECT:
+            return "object";
+    }
+    return "unknown";
+}
+
+void JsonValue::checkType(Type expectedType) const {
+    if (type != expectedType) {
+        throw std::runtime_error(
+                std::string() + "Expected JSON " + getJsonTypeName(expectedType) + ", but found "
+                + getJsonTypeName(type) + ".");
+    }
+}
+
+bool JsonValue::getBool() const {
+    checkType(Type::BOOLEAN);
+    return boolean;
+}
+
+double JsonValue::getDouble() const {
+    if (type == Type::NUL) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    checkType(Type::NUMBER);
+    return std::strtod(text.c_str(), nullptr);
+}
+
+int64_t JsonValue::getInt64() const {
+    checkType(Type::NUMBER);
+    errno = 0;
+    char* end = nullptr;
+    long long number = std::strtoll(text.c_str(), &end, 10);
+    if (errno != 0 || *end != '\0') {
+        throw std::runtime_error("Expected a JSON integer, but found " + text + ".");
+    }
+    return int64_t(number);
+}
+
+uint64_t JsonValue::getUint64() const {
+    checkType(Type::NUMBER);
+    errno = 0;
+    char* end = nullptr;
+    unsigned long long number = std::strtoull(text.c_str(), &end, 10);
+    if (errno != 0 || *end != '\0' || text.front() == '-') {
+        throw std::runtime_error("Expected an unsigned JSON integer, but found " + text + ".");
+    }
+    return uint64_t(number);
+}
+
+const std::string& JsonValue::getString() const {
+    checkType(Type::STRING);
+    return text;
+}
+
+size_t JsonValue::size() const {
+    if (type != Type::OBJECT) {
+        checkType(Type::ARRAY);
+    }
+    return elements.size();
+}
+
+const JsonValue& JsonValue::at(size_t idx) const {
+    checkType(Type::ARRAY);
+    if (idx >= elements.size()) {
+        throw std::runtime_error("JSON array index " + std::to_string(idx) + " is out of range.");
+    }
+    return elements[idx];
+}
+
+const std::vector<JsonValue>& JsonValue::getElements() const {
+    if (type != Type::OBJECT) {
+        checkType(Type::ARRAY);
+    }
+    return elements;
+}
+
+const JsonValue* JsonValue::findMember(const std::string& name) const {
+    checkType(Type::OBJECT);
+    for (size_t i = 0; i < memberNames.size(); i++) {
+        if (memberNames[i] == name) {
+            return &elements[i];
+        }
+    }
+    return nullptr;
+}
+
+const JsonValue& JsonValue::at(const std::string& name) const {
+    const JsonValue* member = findMember(name);
+    if (!member) {
+        throw std::runtime_error("JSON object has no member \"" + name + "\".");
+    }
+    return *member;
+}
+
+const std::vector<std::string>& JsonValue::getMemberNames() const {
+    checkType(Type::OBJECT);
+    return memberNames;
+}
+
+
+/// Recursive descent parser over the whole text; nesting depth is limited to keep malformed input from overflowing
+/// the stack.
+class JsonParser {
+public:
+    explicit JsonParser(const std::string& text) : text(text) {}
+
+    JsonValue parseDocument() {
+        JsonValue value;
+        parseValue(value, 0);
+        skipWhitespace();
+        if (pos != text.size()) {
+            throwError("Unexpected trailing characters");
+        }
+        return value;
+    }
+
+private:
+    static constexpr int MAX_DEPTH = 256;
+
+    [[noreturn]] void throwError(const std::string& message) const {
+        size_t lineNumber = 1;
+        for (size_t i = 0; i < pos && i < text.size(); i++) {
+            if (text[i] == '\n') {
+                lineNumber++;
+            }
+        }
+        throw std::runtime_error(message + " in JSON line " + std::to_string(lineNumber) + ".");
+    }
+
+    void skipWhitespace() {
+        while (pos < text.size() && (text[pos] == ' ' || text[pos] == '\t' || text[pos] == '\n' || text[pos] == '\r')) {
+            pos++;
+        }
+    }
+
+    void expect(char c) {
+        skipWhitespace();
+        if (pos >= text.size() || text[pos] != c) {
+            throwError(std::string() + "Expected '" + c + "'");
+        }
+        pos++;
+    }
+
+    bool consumeLiteral(const char* literal) {
+        size_t length = std::char_traits<char>::length(literal);
+        if (text.compare(pos, length, literal) == 0) {
+            pos += length;
+            return true;
+        }
+        return false;
+    }
+
+    void parseValue(JsonValue& value, int depth) {
+        if (depth > MAX_DEPTH) {
+            throwError("Maximum nesting depth exceeded");
+        }
+        skipWhitespace();
+        if (pos >= text.size()) {
+            throwError("Unexpected end of input");
+        }
+        char c = text[pos];
+        if (c == '{') {
+            parseObject(value, depth);
+        } else if (c == '[') {
+            parseArray(value, depth);
+        } else if (c == '"') {
+            value.type = JsonValue::Type::STRING;
+            parseString(value.text);
+        } else if (consumeLiteral("true")) {
+            value.type = JsonValue::Type::BOOLEAN;
+            value.boolean = true;
+        } else if (consumeLiteral("false")) {
+            value.type = JsonValue::Type::BOOLEAN;
+            value.boolean = false;
+        } else if (consumeLiteral("null")) {
+            value.type = JsonValue::Type::NUL;
+        } else if (c == '-' || (c >= '0' && c <= '9')) {
+            parseNumber(value);
+        } else {
+            throwError(std::string() + "Unexpected character '" + c + "'");
+        }
+    }
+
+    void parseObject(JsonValue& value, int depth) {
+        value.type = JsonValue::Type::OBJECT;
+        pos++;
+        skipWhitespace();
+        if (pos < text.size() && text[pos] == '}') {
+            pos++;
+            return;
+        }
+        while (true) {
+            skipWhitespace();
+            if (pos >= text.size() || text[pos] != '"') {
+                throwError("Expected a member name");
+            }
+            value.memberNames.emplace_back();
+            parseString(value.memberNames.back());
+            expect(':');
+            value.elements.emplace_back();
+            parseValue(value.elements.back(), depth + 1);
+            skipWhitespace();
+            if (pos < text.size() && text[pos] == ',') {
+                pos++;
+                continue;
+            }
+            expect('}');
+            return;
+        }
+    }
+
+    void parseArray(JsonValue& value, int depth) {
+        value.type = JsonValue::Type::ARRAY;
+        pos++;
+        skipWhitespace();
+        if (pos < text.size() && text[pos] == ']') {
+            pos++;
+            return;
+        }
+        while (true) {
+            value.elements.emplace_back();
+            parseValue(value.elements.back(), depth + 1);
+            skipWhitespace();
+            if (pos < text.size() && text[pos] == ',') {
+                pos++;
+                continue;
+            }
+            expect(']');
+            return;
+        }
+    }
+
+    void parseNumber(JsonValue& value) {
+        size_t start = pos;
+        if (text[pos] == '-') {
+            pos++;
+        }
+        bool hasDigits = false;
+        while (pos < text.size() && ((text[pos] >= '0' && text[pos] <= '9') || text[pos] == '.' || text[pos] == 'e'
+                || text[pos] == 'E' || text[pos] == '+' || text[pos] == '-')) {
+            hasDigits = hasDigits || (text[pos] >= '0' && text[pos] <= '9');
+            pos++;
+        }
+        if (!hasDigits) {
+            throwError("Invalid number");
+        }
+        value.type = JsonValue::Type::NUMBER;
+        value.text = text.substr(start, pos - start);
+        char* end = nullptr;
+        std::strtod(value.text.c_str(), &end);
+        if (*end != '\0') {
+            throwError("Invalid number \"" + value.text + "\"");
+        }
+    }
+
+    uint32_t parseHex4() {
+        if (pos + 4 > text.size()) {
+            throwError("Truncated \\u escape sequence");
+        }
+        uint32_t codePoint = 0;
+        for (int i = 0; i < 4; i++) {
+            char c = text[pos++];
+            codePoint <<= 4;
+            if (c >= '0' && c <= '9') {
+                codePoint |= uint32_t(c - '0');
+            } else if (c >= 'a' && c <= 'f') {
+                codePoint |= uint32_t(c - 'a' + 10);
+            } else if (c >= 'A' && c <= 'F') {
+                codePoint |= uint32_t(c - 'A' + 10);
+            } else {
+                throwError("Invalid \\u escape sequence");
+            }
+        }
+        return codePoint;
+    }
+
+    static void appendUtf8(std::string& out, uint32_t codePoint) {
+        if (codePoint < 0x80) {
+            out += char(codePoint);
+        } else if (codePoint < 0x800) {
+            out += char(0xC0 | (codePoint >> 6));
+            out += char(0x80 | (codePoint & 0x3F));
+        } else if (codePoint < 0x10000) {
+            out += char(0xE0 | (codePoint >> 12));
+            out += char(0x80 | ((codePoint >> 6) & 0x3F));
+            out += char(0x80 | (codePoint & 0x3F));
+        } else {
+            out += char(0xF0 | (codePoint >> 18));
+            out += char(0x80 | ((codePoint >> 12) & 0x3F));
+            out += char(0x80 | ((codePoint >> 6) & 0x3F));
+            out += char(0x80 | (codePoint & 0x3F));
+        }
+    }
+
+    void parseString(std::string& out) {
+        pos++;
+        while (true) {
+            if (pos >= text.size()) {
+                throwError("Unterminated string");
+            }
+            char c = text[pos++];
+            if (c == '"') {
+                return;
+            }
+            if (c != '\\') {
+                out += c;
+                continue;
+            }
+            if (pos >= text.size()) {
+                throwError("Unterminated string");
+            }
+            c = text[pos++];
+            switch (c) {
+                case '"': out += '"'; break;
+                case '\\': out += '\\'; break;
+                case '/': out += '/'; break;
+                case 'b': out += '\b'; break;
+                case 'f': out += '\f'; break;
+                case 'n': out += '\n'; break;
+                case 'r': out += '\r'; break;
+                case 't': out += '\t'; break;
+                case 'u': {
+                    uint32_t codePoint = parseHex4();
+                    if (codePoint >= 0xD800 && codePoint < 0xDC00 && consumeLiteral("\\u")) {
+                        uint32_t lowSurrogate = parseHex4();
+                        codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (lowSurrogate - 0xDC00);
+                    }
+                    appendUtf8(out, codePoint);
+                    break;
+                }
+                default:
+                    throwError(std::string() + "Invalid escape sequence '\\" + c + "'");
+            }
+        }
+    }
+
+    const std::string& text;
+    size_t pos = 0;
+};
+
+JsonValue parseJson(const std::string& text) {
+    return JsonParser(text).parseDocument();
+}
+
+JsonValue loadJsonFile(const std::string& filePath) {
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open " + filePath + ".");
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    try {
+        return parseJson(buffer.str());
+    } catch (const std::exception& e) {
+        throw std::runtime_error(filePath + ": " + e.what());
+    }
+}
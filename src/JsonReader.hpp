@@ -0,0 +1,85 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef QUERYVKCOOPMAT_JSONREADER_HPP
+#define QUERYVKCOOPMAT_JSONREADER_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Minimal JSON document model for reading back the files written by JsonWriter (e.g., device profiles). Accessors
+ * throw std::runtime_error if the value has a different type or a member/element does not exist.
+ */
+class JsonValue {
+public:
+    enum class Type {
+        NUL, BOOLEAN, NUMBER, STRING, ARRAY, OBJECT
+    };
+
+    [[nodiscard]] inline Type getType() const { return type; }
+    [[nodiscard]] inline bool isNull() const { return type == Type::NUL; }
+    [[nodiscard]] inline bool isObject() const { return type == Type::OBJECT; }
+    [[nodiscard]] inline bool isArray() const { return type == Type::ARRAY; }
+
+    [[nodiscard]] bool getBool() const;
+    /// Non-finite numbers are written as null by JsonWriter and are returned as NaN.
+    [[nodiscard]] double getDouble() const;
+    /// Integers are parsed from the original text, so 64-bit values (e.g., DRM format modifiers) stay exact.
+    [[nodiscard]] int64_t getInt64() const;
+    [[nodiscard]] uint64_t getUint64() const;
+    [[nodiscard]] const std::string& getString() const;
+
+    /// Number of elements of an array or members of an object.
+    [[nodiscard]] size_t size() const;
+    [[nodiscard]] const JsonValue& at(size_t idx) const;
+    [[nodiscard]] const std::vector<JsonValue>& getElements() const;
+
+    /// Returns nullptr if the object has no member with this name.
+    [[nodiscard]] const JsonValue* findMember(const std::string& name) const;
+    [[nodiscard]] const JsonValue& at(const std::string& name) const;
+    /// Member names of an object in file order; the values are the elements with the same index.
+    [[nodiscard]] const std::vector<std::string>& getMemberNames() const;
+
+private:
+    friend class JsonParser;
+    void checkType(Type expectedType) const;
+
+    Type type = Type::NUL;
+    bool boolean = false;
+    std::string text; ///< String value, or the number as written.
+    std::vector<JsonValue> elements;
+    std::vector<std::string> memberNames;
+};
+
+/// Throws std::runtime_error with the line number on syntax errors.
+JsonValue parseJson(const std::string& text);
+JsonValue loadJsonFile(const std::string& filePath);
+
+#endif //QUERYVKCOOPMAT_JSONREADER_HPP
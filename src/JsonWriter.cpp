@@ -0,0 +1,181 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include "JsonWriter.hpp"
+
+void JsonWriter::newLine() {
+    if (isCompact) {
+        return;
+    }
+    text += '\n';
+    text.append(hasElementsStack.size() * 2, ' ');
+}
+
+void JsonWriter::beginValue() {
+    if (isAfterKey) {
+        isAfterKey = false;
+        return;
+    }
+    if (!hasElementsStack.empty()) {
+        if (hasElementsStack.back()) {
+            text += ',';
+        }
+        hasElementsStack.back() = true;
+        newLine();
+    }
+}
+
+void JsonWriter::beginObject() {
+    beginValue();
+    text += '{';
+    hasElementsStack.push_back(false);
+}
+
+void JsonWriter::endObject() {
+    bool hasElements = hasElementsStack.back();
+    hasElementsStack.pop_back();
+    if (hasElements) {
+        newLine();
+    }
+    text += '}';
+    if (hasElementsStack.empty()) {
+        text += '\n';
+    }
+}
+
+void JsonWriter::beginArray() {
+    beginValue();
+    text += '[';
+    hasElementsStack.push_back(false);
+}
+
+void JsonWriter::endArray() {
+    bool hasElements = hasElementsStack.back();
+    hasElementsStack.pop_back();
+    if (hasElements) {
+        newLine();
+    }
+    text += ']';
+    if (hasElementsStack.empty()) {
+        text += '\n';
+    }
+}
+
+void JsonWriter::key(const std::string& name) {
+    beginValue();
+    text += escapeString(name) + (isCompact ? ":" : ": ");
+    isAfterKey = true;
+}
+
+void JsonWriter::value(const std::string& stringValue) {
+    beginValue();
+    text += escapeString(stringValue);
+}
+
+void JsonWriter::value(const char* stringValue) {
+    value(std::string(stringValue));
+}
+
+void JsonWriter::value(double number) {
+    beginValue();
+    if (!std::isfinite(number)) {
+        text += "null";
+        return;
+    }
+    std::ostringstream stream;
+    stream << std::setprecision(10) << number;
+    text += stream.str();
+}
+
+void JsonWriter::value(int64_t number) {
+    beginValue();
+    text += std::to_string(number);
+}
+
+void JsonWriter::value(uint64_t number) {
+    beginValue();
+    text += std::to_string(number);
+}
+
+void JsonWriter::value(bool boolean) {
+    beginValue();
+    text += boolean ? "true" : "false";
+}
+
+void JsonWriter::valueNull() {
+    beginValue();
+    text += "null";
+}
+
+bool JsonWriter::save(const std::string& filePath) const {
+    std::ofstream file(filePath, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    file << text;
+    return bool(file);
+}
+
+std::string JsonWriter::escapeString(const std::string& stringValue) {
+    std::string escaped = "\"";
+    for (char c : stringValue) {
+        switch (c) {
+            case '"':
+                escaped += "\\\"";
+                break;
+            case '\\':
+                escaped += "\\\\";
+                break;
+            case '\n':
+                escaped += "\\n";
+                break;
+            case '\r':
+                escaped += "\\r";
+                break;
+            case '\t':
+                escaped += "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char buffer[8];
+                    snprintf(buffer, sizeof(buffer), "\\u%04x", unsigned(static_cast<unsigned char>(c)));
+                    escaped += buffer;
+                } else {
+                    escaped += c;
+                }
+        }
+    }
+    escaped += '"';
+    return escaped;
+}
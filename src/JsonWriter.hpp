@@ -0,0 +1,84 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef QUERYVKCOOPMAT_JSONWRITER_HPP
+#define QUERYVKCOOPMAT_JSONWRITER_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Minimal streaming JSON writer for the machine-readable reports. Commas and indentation are inserted
+ * automatically; non-finite numbers are written as null.
+ */
+class JsonWriter {
+public:
+    /// Compact output has no whitespace apart from the newline after the top-level value (e.g., for sockets).
+    explicit JsonWriter(bool isCompact = false) : isCompact(isCompact) {}
+
+    void beginObject();
+    void endObject();
+    void beginArray();
+    void endArray();
+    void key(const std::string& name);
+
+    void value(const std::string& text);
+    void value(const char* text);
+    void value(double number);
+    void value(int64_t number);
+    void value(uint64_t number);
+    void value(uint32_t number) { value(uint64_t(number)); }
+    void value(int32_t number) { value(int64_t(number)); }
+    void value(bool boolean);
+    void valueNull();
+
+    template<class T>
+    void keyValue(const std::string& name, const T& v) {
+        key(name);
+        value(v);
+    }
+
+    [[nodiscard]] inline const std::string& getString() const { return text; }
+    /// Returns false if the file could not be written.
+    bool save(const std::string& filePath) const;
+
+    static std::string escapeString(const std::string& text);
+
+private:
+    void beginValue();
+    void newLine();
+
+    bool isCompact;
+    std::string text;
+    /// One entry per open object/array; true once it contains an element.
+    std::vector<bool> hasElementsStack;
+    bool isAfterKey = false;
+};
+
+#endif //QUERYVKCOOPMAT_JSONWRITER_HPP
@@ -0,0 +1,50 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <unordered_map>
+
+#include "Kernels.hpp"
+
+#include "EmbeddedKernels.inc"
+
+const EmbeddedKernel* findEmbeddedKernel(const std::string& kernelName, const std::string& variantName) {
+    // There is one variant per type combination and scope of most kernels, so a linear search would add up.
+    static const std::unordered_map<std::string, const EmbeddedKernel*> kernelRegistry = []() {
+        std::unordered_map<std::string, const EmbeddedKernel*> registry;
+        for (const EmbeddedKernel* kernel = embeddedKernels; kernel->kernelName != nullptr; kernel++) {
+            registry.emplace(std::string(kernel->kernelName) + "|" + kernel->variantName, kernel);
+        }
+        return registry;
+    }();
+    auto it = kernelRegistry.find(kernelName + "|" + variantName);
+    return it != kernelRegistry.end() ? it->second : nullptr;
+}
+
+bool getHasEmbeddedKernels() {
+    return embeddedKernels[0].kernelName != nullptr;
+}
@@ -0,0 +1,52 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef QUERYVKCOOPMAT_KERNELS_HPP
+#define QUERYVKCOOPMAT_KERNELS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * SPIR-V kernel compiled from src/Shaders at build time (see CMake/Kernels.cmake). Each kernel may exist in several
+ * variants, e.g., one per cooperative matrix type combination.
+ */
+struct EmbeddedKernel {
+    const char* kernelName;
+    const char* variantName;
+    const uint32_t* code;
+    size_t codeSize; ///< In bytes.
+};
+
+/// Returns nullptr if the variant was not compiled (e.g., because glslangValidator was not available or does not
+/// support the GLSL extensions the variant needs).
+const EmbeddedKernel* findEmbeddedKernel(const std::string& kernelName, const std::string& variantName);
+bool getHasEmbeddedKernels();
+
+#endif //QUERYVKCOOPMAT_KERNELS_HPP
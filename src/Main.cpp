@@ -26,7 +26,11 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
 #include <iostream>
+#include <memory>
 #include <utility>
 
 #include <Math/Math.hpp>
@@ -35,10 +39,40 @@
 #include <Graphics/Vulkan/Utils/Device.hpp>
 #include <ImGui/Widgets/NumberFormatting.hpp>
 
+#include "PrintUtils.hpp"
+#include "ComponentTypes.hpp"
+#include "VulkanUtils.hpp"
+#include "DeviceRequirements.hpp"
+#include "DeviceProfile.hpp"
+#include "PipelineCache.hpp"
+#include "GpuTimer.hpp"
+#include "BenchmarkRunner.hpp"
+#include "RegressionSuite.hpp"
+#include "Kernels.hpp"
+#include "Benchmarks/CoopMatGemm.hpp"
+#include "Benchmarks/PeerTransferBenchmark.hpp"
+#include "Benchmarks/MultiGpuGemmBenchmark.hpp"
+#include "Benchmarks/SubgroupSizeBenchmark.hpp"
+#include "Benchmarks/OccupancyBenchmark.hpp"
+#include "Benchmarks/AccuracyBenchmark.hpp"
+#include "Benchmarks/SaturationBenchmark.hpp"
+#include "Benchmarks/CoopMat2OpsBenchmark.hpp"
+#include "Benchmarks/ConvolutionBenchmark.hpp"
+#include "Benchmarks/FlashAttentionBenchmark.hpp"
+#include "Benchmarks/CoopVecTrainingBenchmark.hpp"
+#include "Benchmarks/CoopVecLayoutBenchmark.hpp"
+#include "Benchmarks/BatchedGemmBenchmark.hpp"
+#include "Benchmarks/AsyncOverlapBenchmark.hpp"
+#include "Benchmarks/PipelineCacheBenchmark.hpp"
+#include "Benchmarks/RooflineBenchmark.hpp"
+#include "Benchmarks/GemmPredictionBenchmark.hpp"
+#include "Benchmarks/NumaTransferBenchmark.hpp"
+
 #ifdef __linux__
 #include <fstream>
 #include "OffscreenContextEGL.hpp"
 #include "FormatInfo.hpp"
+#include "CapabilityDaemon.hpp"
 #endif
 
 #ifdef _WIN32
@@ -48,60 +82,6 @@
 
 #define RES_TO_STR(r) case r: return #r
 
-std::string getComponentTypeString(VkComponentTypeKHR compType) {
-    switch (compType) {
-        case VK_COMPONENT_TYPE_FLOAT16_KHR:
-            return "float16";
-        case VK_COMPONENT_TYPE_FLOAT32_KHR:
-            return "float32";
-        case VK_COMPONENT_TYPE_FLOAT64_KHR:
-            return "float64";
-        case VK_COMPONENT_TYPE_SINT8_KHR:
-            return "sint8";
-        case VK_COMPONENT_TYPE_SINT16_KHR:
-            return "sint16";
-        case VK_COMPONENT_TYPE_SINT32_KHR:
-            return "sint32";
-        case VK_COMPONENT_TYPE_SINT64_KHR:
-            return "sint64";
-        case VK_COMPONENT_TYPE_UINT8_KHR:
-            return "uint8";
-        case VK_COMPONENT_TYPE_UINT16_KHR:
-            return "uint16";
-        case VK_COMPONENT_TYPE_UINT32_KHR:
-            return "uint32";
-        case VK_COMPONENT_TYPE_UINT64_KHR:
-            return "uint64";
-        case VK_COMPONENT_TYPE_BFLOAT16_KHR:
-            return "bloat16";
-        case VK_COMPONENT_TYPE_SINT8_PACKED_NV:
-            return "sint8_packed";
-        case VK_COMPONENT_TYPE_UINT8_PACKED_NV:
-            return "uint8_packed";
-        case VK_COMPONENT_TYPE_FLOAT_E4M3_NV:
-            return "float_e4m3";
-        case VK_COMPONENT_TYPE_FLOAT_E5M2_NV:
-            return "float_e5m2";
-        default:
-            return "UNKNOWN";
-    }
-}
-
-std::string getScopeString(VkScopeKHR scope) {
-    switch (scope) {
-        case VK_SCOPE_DEVICE_KHR:
-            return "DEVICE";
-        case VK_SCOPE_WORKGROUP_KHR:
-            return "WORKGROUP";
-        case VK_SCOPE_SUBGROUP_KHR:
-            return "SUBGROUP";
-        case VK_SCOPE_QUEUE_FAMILY_KHR:
-            return "QUEUE_FAMILY";
-        default:
-            return "UNKNOWN";
-    }
-}
-
 std::string shaderStagesToString(VkShaderStageFlags stageFlags) {
     std::vector<std::string> shaderStageNames;
     if ((stageFlags & VK_SHADER_STAGE_VERTEX_BIT) != 0) {
@@ -156,20 +136,6 @@ std::string shaderStagesToString(VkShaderStageFlags stageFlags) {
     return shaderStages;
 }
 
-namespace sgl {
-// Override for nicer formating of bools.
-inline std::string toString(bool boolVal) {
-    return boolVal ? "true" : "false";
-}
-}
-
-template<typename... T>
-void writeOut(T... args) {
-    std::string text = (std::string() + ... + sgl::toString(std::move(args)));
-    sgl::Logfile::get()->write(text, sgl::BLACK);
-    std::cout << text << std::endl;
-}
-
 std::string uint8ArrayToHex(const uint8_t* arr, size_t numEntries) {
     std::string hexRep;
     for (size_t i = 0; i < numEntries; i++) {
@@ -178,6 +144,21 @@ std::string uint8ArrayToHex(const uint8_t* arr, size_t numEntries) {
     return hexRep;
 }
 
+/// The embedded GEMM kernel variant picked for a property entry, or "none" if no variant was compiled for it.
+/// Workgroup scope entries of VK_KHR_cooperative_matrix report no workgroup size and are "n/a".
+std::string getCoopMatGemmKernelString(const CoopMatGemmSettings& settings) {
+    if (settings.scope == VK_SCOPE_WORKGROUP_KHR && settings.workgroupInvocations == 0) {
+        return "n/a";
+    }
+    std::string variantName = CoopMatGemm::getVariantName(settings);
+    return findEmbeddedKernel("CoopMatGemm", variantName) ? variantName : "none";
+}
+
+/// Subgroup scope entries of VK_NV_cooperative_matrix2 report zero workgroup invocations.
+std::string getWorkgroupInvocationsString(uint32_t workgroupInvocations) {
+    return workgroupInvocations == 0 ? "n/a" : std::to_string(workgroupInvocations);
+}
+
 void checkCooperativeMatrixFeaturesKHR(sgl::vk::Device* device) {
     if (!device->getCooperativeMatrixFeaturesKHR().cooperativeMatrix) {
         writeOut("");
@@ -190,7 +171,7 @@ void checkCooperativeMatrixFeaturesKHR(sgl::vk::Device* device) {
     writeOut("");
     writeOut("VK_KHR_cooperative_matrix properties:");
     writeOut("");
-    sgl::Logfile::get()->write("<table><tr><th>MSize</th><th>NSize</th><th>KSize</th><th>AType</th><th>BType</th><th>CType</th><th>ResultType</th><th>sat</th><th>scope</th></tr>\n");
+    sgl::Logfile::get()->write("<table><tr><th>MSize</th><th>NSize</th><th>KSize</th><th>AType</th><th>BType</th><th>CType</th><th>ResultType</th><th>sat</th><th>scope</th><th>kernel</th></tr>\n");
     for (size_t i = 0; i < cooperativeMatrixProperties.size(); i++) {
         auto& props = cooperativeMatrixProperties[i];
         std::cout
@@ -203,6 +184,7 @@ void checkCooperativeMatrixFeaturesKHR(sgl::vk::Device* device) {
                 << "\nResultType: " << getComponentTypeString(props.ResultType)
                 << "\nsaturatingAccumulation: " << sgl::toString(bool(props.saturatingAccumulation))
                 << "\nscope: " << getScopeString(props.scope)
+                << "\nkernel: " << getCoopMatGemmKernelString(CoopMatGemmSettings::fromProperties(props))
                 << "\n" << std::endl;
         sgl::Logfile::get()->write("<tr>");
         sgl::Logfile::get()->write("<td>" + std::to_string(props.MSize) +"</td>");
@@ -214,6 +196,8 @@ void checkCooperativeMatrixFeaturesKHR(sgl::vk::Device* device) {
         sgl::Logfile::get()->write("<td>" + getComponentTypeString(props.ResultType) +"</td>");
         sgl::Logfile::get()->write("<td>" + sgl::toString(bool(props.saturatingAccumulation)) +"</td>");
         sgl::Logfile::get()->write("<td>" + getScopeString(props.scope) +"</td>");
+        sgl::Logfile::get()->write(
+                "<td>" + getCoopMatGemmKernelString(CoopMatGemmSettings::fromProperties(props)) + "</td>");
         sgl::Logfile::get()->write("</tr>\n");
     }
     sgl::Logfile::get()->write("</table>\n");
@@ -242,7 +226,7 @@ void checkCooperativeMatrixFeaturesNV2(sgl::vk::Device* device) {
     writeOut("cooperativeMatrixFlexibleDimensionsMaxDimension: ", properties.cooperativeMatrixFlexibleDimensionsMaxDimension);
     writeOut("cooperativeMatrixWorkgroupScopeReservedSharedMemory: ", properties.cooperativeMatrixWorkgroupScopeReservedSharedMemory);
     writeOut("");
-    sgl::Logfile::get()->write("<table><tr><th>MGranularity</th><th>NGranularity</th><th>KGranularity</th><th>AType</th><th>BType</th><th>CType</th><th>ResultType</th><th>sat</th><th>scope</th><th>WGInvocs</th></tr>\n");
+    sgl::Logfile::get()->write("<table><tr><th>MGranularity</th><th>NGranularity</th><th>KGranularity</th><th>AType</th><th>BType</th><th>CType</th><th>ResultType</th><th>sat</th><th>scope</th><th>WGInvocs</th><th>kernel</th></tr>\n");
     for (size_t i = 0; i < flexibleDimensionsProperties.size(); i++) {
         auto& props = flexibleDimensionsProperties[i];
         std::cout
@@ -255,7 +239,8 @@ void checkCooperativeMatrixFeaturesNV2(sgl::vk::Device* device) {
                 << "\nResultType: " << getComponentTypeString(props.ResultType)
                 << "\nsaturatingAccumulation: " << sgl::toString(bool(props.saturatingAccumulation))
                 << "\nscope: " << getScopeString(props.scope)
-                << "\nworkgroupInvocations: " << props.workgroupInvocations
+                << "\nworkgroupInvocations: " << getWorkgroupInvocationsString(props.workgroupInvocations)
+                << "\nkernel: " << getCoopMatGemmKernelString(CoopMatGemmSettings::fromProperties(props))
                 << "\n" << std::endl;
         sgl::Logfile::get()->write("<tr>");
         sgl::Logfile::get()->write("<td>" + std::to_string(props.MGranularity) +"</td>");
@@ -267,7 +252,9 @@ void checkCooperativeMatrixFeaturesNV2(sgl::vk::Device* device) {
         sgl::Logfile::get()->write("<td>" + getComponentTypeString(props.ResultType) +"</td>");
         sgl::Logfile::get()->write("<td>" + sgl::toString(bool(props.saturatingAccumulation)) +"</td>");
         sgl::Logfile::get()->write("<td>" + getScopeString(props.scope) +"</td>");
-        sgl::Logfile::get()->write("<td>" + std::to_string(props.workgroupInvocations) +"</td>");
+        sgl::Logfile::get()->write("<td>" + getWorkgroupInvocationsString(props.workgroupInvocations) +"</td>");
+        sgl::Logfile::get()->write(
+                "<td>" + getCoopMatGemmKernelString(CoopMatGemmSettings::fromProperties(props)) + "</td>");
         sgl::Logfile::get()->write("</tr>\n");
     }
     sgl::Logfile::get()->write("</table>\n");
@@ -476,66 +463,198 @@ void queryImageDrmFormatModifiers(size_t deviceIdx, sgl::vk::Device* device) {
     }
     formatFile << "<br><hr>\n";
 
-    querySingleImageDrmFormatModifiers(device, VK_FORMAT_R8G8B8A8_UNORM, formatFile);
-    querySingleImageDrmFormatModifiers(device, VK_FORMAT_B8G8R8A8_UNORM, formatFile);
-    querySingleImageDrmFormatModifiers(device, VK_FORMAT_R8G8B8A8_SRGB, formatFile);
-    querySingleImageDrmFormatModifiers(device, VK_FORMAT_B8G8R8A8_SRGB, formatFile);
-
-    querySingleImageDrmFormatModifiers(device, VK_FORMAT_R16_UNORM, formatFile);
-    querySingleImageDrmFormatModifiers(device, VK_FORMAT_R16G16_UNORM, formatFile);
-    querySingleImageDrmFormatModifiers(device, VK_FORMAT_R16G16B16A16_UNORM, formatFile);
-
-    querySingleImageDrmFormatModifiers(device, VK_FORMAT_D32_SFLOAT, formatFile);
-    querySingleImageDrmFormatModifiers(device, VK_FORMAT_R32_SFLOAT, formatFile);
-    querySingleImageDrmFormatModifiers(device, VK_FORMAT_R32G32_SFLOAT, formatFile);
-    querySingleImageDrmFormatModifiers(device, VK_FORMAT_R32G32B32A32_SFLOAT, formatFile);
-
-    querySingleImageDrmFormatModifiers(device, VK_FORMAT_R16_SFLOAT, formatFile);
-    querySingleImageDrmFormatModifiers(device, VK_FORMAT_R16G16_SFLOAT, formatFile);
-    querySingleImageDrmFormatModifiers(device, VK_FORMAT_R16G16B16A16_SFLOAT, formatFile);
-
-    querySingleImageDrmFormatModifiers(device, VK_FORMAT_R32_UINT, formatFile);
-    querySingleImageDrmFormatModifiers(device, VK_FORMAT_R32G32_UINT, formatFile);
-    querySingleImageDrmFormatModifiers(device, VK_FORMAT_R32G32B32A32_UINT, formatFile);
-
-    querySingleImageDrmFormatModifiers(device, VK_FORMAT_R32_SINT, formatFile);
-    querySingleImageDrmFormatModifiers(device, VK_FORMAT_R32G32_SINT, formatFile);
-    querySingleImageDrmFormatModifiers(device, VK_FORMAT_R32G32B32A32_SINT, formatFile);
-
-    querySingleImageDrmFormatModifiers(device, VK_FORMAT_B10G11R11_UFLOAT_PACK32, formatFile);
-    querySingleImageDrmFormatModifiers(device, VK_FORMAT_R64_UINT, formatFile);
-
-    querySingleImageDrmFormatModifiers(device, VK_FORMAT_G8_B8R8_2PLANE_420_UNORM, formatFile); // NV12
-    querySingleImageDrmFormatModifiers(device, VK_FORMAT_G10X6_B10X6R10X6_2PLANE_420_UNORM_3PACK16, formatFile); // P010
+    for (VkFormat format : getProfileFormats()) {
+        querySingleImageDrmFormatModifiers(device, format, formatFile);
+    }
 
     formatFile << "</font></body></html>";
     formatFile.close();
 }
 #endif
 
+/// Returns false if the text is not a finite positive number (e.g., for --time-budget).
+bool parsePositiveNumber(const char* text, double& value) {
+    char* end = nullptr;
+    value = std::strtod(text, &end);
+    return end != text && *end == '\0' && std::isfinite(value) && value > 0.0;
+}
+
 int main(int argc, char *argv[]) {
 #ifdef __linux__
     bool shallTestDrmFormatModifiers = false;
+    bool shallRunDaemon = false;
+    std::string daemonSocketPath = getDefaultDaemonSocketPath();
 #endif
 #ifdef _WIN32
     bool shallTestWglExperimental = false;
 #endif
+    bool shallBenchmarkGlSsbo = false;
+    bool shallBenchmarkPeerTransfer = false;
+    bool shallBenchmarkMultiGpuGemm = false;
+    bool shallBenchmarkSubgroupSizes = false;
+    bool shallBenchmarkOccupancy = false;
+    bool shallBenchmarkAccuracy = false;
+    bool shallBenchmarkSaturation = false;
+    bool shallBenchmarkCoopMat2Ops = false;
+    bool shallBenchmarkConvolution = false;
+    bool shallBenchmarkFlashAttention = false;
+    bool shallBenchmarkCoopVecTraining = false;
+    bool shallBenchmarkCoopVecLayouts = false;
+    bool shallBenchmarkBatchedGemm = false;
+    bool shallBenchmarkAsyncOverlap = false;
+    bool shallBenchmarkPipelineCache = false;
+    bool shallBenchmarkRoofline = false;
+    bool shallBenchmarkGemmPrediction = false;
+    bool shallBenchmarkNumaTransfer = false;
+    bool shallCaptureProfile = false;
+    std::string regressionBaselineFilePath;
+    bool shallUpdateRegressionBaseline = false;
+    bool usePipelineCache = true;
+    std::string pipelineCacheDirectory = "PipelineCache";
+    std::string reportDirectory = "Reports";
     for (int i = 1; i < argc; i++) {
         std::string command = argv[i];
         if (command == "--help" || command == "-h") {
             std::cout << "QueryVkCoopMat: Queries Vulkan cooperative matrix support." << std::endl;
 #ifdef __linux__
             std::cout << "Optional argument: --test-drm-format (queries Linux DRM image format modifiers)" << std::endl;
+            std::cout << "Optional argument: --daemon (serves cached queries over a Unix domain socket)" << std::endl;
+            std::cout << "Optional argument: --socket <path> (for --daemon; default: " << daemonSocketPath << ")"
+                    << std::endl;
 #endif
 #ifdef _WIN32
             std::cout << "Optional argument: --wgl (queries WGL contexts for each device; experimental)" << std::endl;
 #endif
+            std::cout << "Optional argument: --bench-gl-ssbo (OpenGL SSBO bandwidth, alignment and upload paths)";
+#ifdef _WIN32
+            std::cout << "; requires --wgl";
+#endif
+            std::cout << std::endl;
+            std::cout << "Optional argument: --bench-peer-transfer (transfer matrix between all suitable devices)"
+                    << std::endl;
+            std::cout << "Optional argument: --bench-multi-gpu-gemm (split one GEMM across all suitable devices)"
+                    << std::endl;
+            std::cout << "Optional argument: --bench-subgroup-sizes (cooperative matrix GEMM per required subgroup size)"
+                    << std::endl;
+            std::cout << "Optional argument: --bench-occupancy (shared memory occupancy model vs. measured occupancy)"
+                    << std::endl;
+            std::cout << "Optional argument: --bench-accuracy (accuracy vs. throughput per cooperative matrix type)"
+                    << std::endl;
+            std::cout << "Optional argument: --bench-saturation (int8 saturating accumulation throughput and overflows)"
+                    << std::endl;
+            std::cout << "Optional argument: --bench-coopmat2-ops (coopmat2 conversions, reductions and per-element ops)"
+                    << std::endl;
+            std::cout << "Optional argument: --bench-convolution (implicit GEMM convolution, tensor addressing vs. im2col)"
+                    << std::endl;
+            std::cout << "Optional argument: --bench-attention (fused attention per head dim, sequence length and masking)"
+                    << std::endl;
+            std::cout << "Optional argument: --bench-coopvec-training (MLP forward and backward pass with cooperative vectors)"
+                    << std::endl;
+            std::cout << "Optional argument: --bench-coopvec-layouts (coopvec weight layout conversion and inference payoff)"
+                    << std::endl;
+            std::cout << "Optional argument: --bench-batched-gemm (per-dispatch, strided and pointer-array batched GEMM)"
+                    << std::endl;
+            std::cout << "Optional argument: --bench-async-overlap (upload/compute/readback overlap on separate queues)"
+                    << std::endl;
+            std::cout << "Optional argument: --bench-pipeline-cache (cold and warm pipeline creation times)"
+                    << std::endl;
+            std::cout << "Optional argument: --bench-roofline (roofline of peak compute, bandwidths and kernels)"
+                    << std::endl;
+            std::cout << "Optional argument: --bench-gemm-prediction (fit and validate GEMM time models)"
+                    << std::endl;
+            std::cout << "Optional argument: --bench-numa-transfer (host-device bandwidth per NUMA node and pinning "
+                    << "advice; Linux)" << std::endl;
+            std::cout << "Optional argument: --capture-profile (device profile for the mock driver in mock_icd/)"
+                    << std::endl;
+            std::cout << "Optional argument: --regression <baseline.json> (all Vulkan modes with reduced problem "
+                    "sizes, compared with the baseline)" << std::endl;
+            std::cout << "Optional argument: --regression-update (for --regression; writes the baseline instead)"
+                    << std::endl;
+            std::cout << "Optional argument: --pipeline-cache-dir <directory> (default: PipelineCache)" << std::endl;
+            std::cout << "Optional argument: --no-pipeline-cache (do not load or save the pipeline cache)" << std::endl;
+            std::cout << "Optional argument: --report-dir <directory> (for JSON/SVG reports; default: Reports)"
+                    << std::endl;
+            std::cout << "Optional argument: --time-budget <ms> (per measurement; default: 500)" << std::endl;
+            std::cout << "Optional argument: --target-ci <percent> (CI width of the median; default: 2)" << std::endl;
+        }
+        else if (command == "--bench-gl-ssbo") {
+            shallBenchmarkGlSsbo = true;
+        } else if (command == "--bench-peer-transfer") {
+            shallBenchmarkPeerTransfer = true;
+        } else if (command == "--bench-multi-gpu-gemm") {
+            shallBenchmarkMultiGpuGemm = true;
+        } else if (command == "--bench-subgroup-sizes") {
+            shallBenchmarkSubgroupSizes = true;
+        } else if (command == "--bench-occupancy") {
+            shallBenchmarkOccupancy = true;
+        } else if (command == "--bench-accuracy") {
+            shallBenchmarkAccuracy = true;
+        } else if (command == "--bench-saturation") {
+            shallBenchmarkSaturation = true;
+        } else if (command == "--bench-coopmat2-ops") {
+            shallBenchmarkCoopMat2Ops = true;
+        } else if (command == "--bench-convolution") {
+            shallBenchmarkConvolution = true;
+        } else if (command == "--bench-attention") {
+            shallBenchmarkFlashAttention = true;
+        } else if (command == "--bench-coopvec-training") {
+            shallBenchmarkCoopVecTraining = true;
+        } else if (command == "--bench-coopvec-layouts") {
+            shallBenchmarkCoopVecLayouts = true;
+        } else if (command == "--bench-batched-gemm") {
+            shallBenchmarkBatchedGemm = true;
+        } else if (command == "--bench-async-overlap") {
+            shallBenchmarkAsyncOverlap = true;
+        } else if (command == "--bench-pipeline-cache") {
+            shallBenchmarkPipelineCache = true;
+        } else if (command == "--bench-gemm-prediction") {
+            shallBenchmarkGemmPrediction = true;
+        } else if (command == "--bench-numa-transfer") {
+            shallBenchmarkNumaTransfer = true;
+        } else if (command == "--capture-profile") {
+            shallCaptureProfile = true;
+        } else if (command == "--bench-roofline") {
+            // The convolution and attention runs are placed on the roofline as well.
+            shallBenchmarkRoofline = true;
+            shallBenchmarkConvolution = true;
+            shallBenchmarkFlashAttention = true;
+        } else if (command == "--regression" && i + 1 < argc) {
+            regressionBaselineFilePath = argv[++i];
+        } else if (command == "--regression-update") {
+            shallUpdateRegressionBaseline = true;
+        } else if (command == "--pipeline-cache-dir" && i + 1 < argc) {
+            pipelineCacheDirectory = argv[++i];
+        } else if (command == "--report-dir" && i + 1 < argc) {
+            reportDirectory = argv[++i];
+        } else if (command == "--no-pipeline-cache") {
+            usePipelineCache = false;
+        } else if (command == "--time-budget" && i + 1 < argc) {
+            BenchmarkRunnerSettings runnerSettings = getBenchmarkRunnerSettings();
+            if (!parsePositiveNumber(argv[++i], runnerSettings.timeBudgetMs)) {
+                std::cerr << "Invalid argument: --time-budget <ms> expects a positive number." << std::endl;
+                return 1;
+            }
+            setBenchmarkRunnerSettings(runnerSettings);
+        } else if (command == "--target-ci" && i + 1 < argc) {
+            BenchmarkRunnerSettings runnerSettings = getBenchmarkRunnerSettings();
+            double targetCiPercent = 0.0;
+            if (!parsePositiveNumber(argv[++i], targetCiPercent)) {
+                std::cerr << "Invalid argument: --target-ci <percent> expects a positive number." << std::endl;
+                return 1;
+            }
+            runnerSettings.targetRelativeCiWidth = targetCiPercent * 1e-2;
+            setBenchmarkRunnerSettings(runnerSettings);
         }
 #ifdef __linux__
         else if (command == "--test-drm-format" || command == "--test-drm-formats" || command == "--drm-formats"
-                || "--drm") {
+                || command == "--drm") {
             shallTestDrmFormatModifiers = true;
         }
+        else if (command == "--daemon") {
+            shallRunDaemon = true;
+        } else if (command == "--socket" && i + 1 < argc) {
+            daemonSocketPath = argv[++i];
+        }
 #endif
 #ifdef _WIN32
         else if (command == "--wgl") {
@@ -547,11 +666,47 @@ int main(int argc, char *argv[]) {
         }
     }
 
+    if (!regressionBaselineFilePath.empty() && !shallUpdateRegressionBaseline
+            && !std::filesystem::exists(regressionBaselineFilePath)) {
+        std::cerr << "The regression baseline " << regressionBaselineFilePath << " does not exist. Record one with "
+                << "--regression-update first." << std::endl;
+        return 1;
+    }
+    if (!regressionBaselineFilePath.empty()) {
+        // The OpenGL interop modes are left out, as CI runners with a software Vulkan driver often lack EGL.
+        shallBenchmarkPeerTransfer = true;
+        shallBenchmarkMultiGpuGemm = true;
+        shallBenchmarkSubgroupSizes = true;
+        shallBenchmarkOccupancy = true;
+        shallBenchmarkAccuracy = true;
+        shallBenchmarkSaturation = true;
+        shallBenchmarkCoopMat2Ops = true;
+        shallBenchmarkConvolution = true;
+        shallBenchmarkFlashAttention = true;
+        shallBenchmarkCoopVecTraining = true;
+        shallBenchmarkCoopVecLayouts = true;
+        shallBenchmarkBatchedGemm = true;
+        shallBenchmarkAsyncOverlap = true;
+        shallBenchmarkPipelineCache = true;
+        shallBenchmarkRoofline = true;
+        shallBenchmarkGemmPrediction = true;
+        shallBenchmarkNumaTransfer = true;
+        // Warm pipeline creation times from a previous run would differ from those in the baseline.
+        usePipelineCache = false;
+        beginRegressionRun(regressionBaselineFilePath);
+    }
+
     sgl::Logfile::get()->createLogfile("Logfile.html", "QueryVkCoopMat");
     sgl::Logfile::get()->write("\n<style>\n");
     sgl::Logfile::get()->write("table {\nborder-spacing: 10px 0;\n}\n");
     sgl::Logfile::get()->write("</style>\n");
 
+#ifdef __linux__
+    if (shallRunDaemon) {
+        return runCapabilityDaemon(daemonSocketPath);
+    }
+#endif
+
     auto* instance = new sgl::vk::Instance;
     instance->createInstance({}, false);
 #ifdef __linux__
@@ -565,26 +720,10 @@ int main(int argc, char *argv[]) {
     }
 #endif
 
-    std::vector<const char*> optionalDeviceExtensions;
-    std::vector<const char*> requiredDeviceExtensions = {
-            VK_EXT_SCALAR_BLOCK_LAYOUT_EXTENSION_NAME, VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME
-    };
-    sgl::vk::DeviceFeatures requestedDeviceFeatures{};
-    requestedDeviceFeatures.optionalVulkan12Features.shaderInt8 = VK_TRUE;
-    requestedDeviceFeatures.optionalVulkan12Features.shaderFloat16 = VK_TRUE;
-    requestedDeviceFeatures.optionalVulkan11Features.storageBuffer16BitAccess = VK_TRUE;
-    requestedDeviceFeatures.optionalVulkan12Features.vulkanMemoryModel = VK_TRUE; // For cooperative matrices.
-    requestedDeviceFeatures.optionalVulkan12Features.vulkanMemoryModelDeviceScope = VK_TRUE; // For cooperative matrices.
-    requestedDeviceFeatures.optionalVulkan13Features.subgroupSizeControl = VK_TRUE;
-    optionalDeviceExtensions.push_back(VK_KHR_SHADER_BFLOAT16_EXTENSION_NAME);
-    optionalDeviceExtensions.push_back(VK_NV_COOPERATIVE_MATRIX_EXTENSION_NAME);
-    optionalDeviceExtensions.push_back(VK_NV_COOPERATIVE_MATRIX_2_EXTENSION_NAME);
-    optionalDeviceExtensions.push_back(VK_NV_COOPERATIVE_VECTOR_EXTENSION_NAME);
-    optionalDeviceExtensions.push_back(VK_KHR_COOPERATIVE_MATRIX_EXTENSION_NAME);
-    optionalDeviceExtensions.push_back(VK_NV_COOPERATIVE_VECTOR_EXTENSION_NAME);
-    optionalDeviceExtensions.push_back(VK_EXT_SHADER_64BIT_INDEXING_EXTENSION_NAME);
-    optionalDeviceExtensions.push_back(VK_KHR_EXTERNAL_MEMORY_EXTENSION_NAME);
-    optionalDeviceExtensions.push_back(VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME);
+    DeviceRequirements deviceRequirements = getDeviceRequirements();
+    std::vector<const char*>& requiredDeviceExtensions = deviceRequirements.requiredDeviceExtensions;
+    std::vector<const char*>& optionalDeviceExtensions = deviceRequirements.optionalDeviceExtensions;
+    sgl::vk::DeviceFeatures& requestedDeviceFeatures = deviceRequirements.requestedDeviceFeatures;
 #ifdef __linux__
     if (shallTestDrmFormatModifiers) {
         optionalDeviceExtensions.push_back(VK_EXT_IMAGE_DRM_FORMAT_MODIFIER_EXTENSION_NAME);
@@ -611,27 +750,133 @@ int main(int argc, char *argv[]) {
                 optionalDeviceExtensions, requestedDeviceFeatures, true);
 #ifdef __linux__
         if (isEglInitialized) {
-            checkEglFeatures(device);
+            checkEglFeatures(device, shallBenchmarkGlSsbo);
         }
 #endif
 #ifdef _WIN32
         if (isWglInitialized) {
-            checkWglFeatures(device);
+            checkWglFeatures(device, shallBenchmarkGlSsbo);
         }
 #endif
         checkCooperativeMatrixFeatures(device);
+        setRegressionDevice(i, device->getDeviceName());
+        if (shallCaptureProfile) {
+            captureDeviceProfile(i, device, reportDirectory);
+        }
+        clearRooflineKernelRuns();
+        writeOut("");
+        writeOut("Benchmark timing: " + getGpuTimingInfoString(device));
+        std::unique_ptr<PipelineCache> pipelineCache;
+        if (usePipelineCache) {
+            try {
+                pipelineCache = std::make_unique<PipelineCache>(device, pipelineCacheDirectory);
+                setDefaultPipelineCache(device->getVkDevice(), pipelineCache->getVkPipelineCache());
+            } catch (const std::exception& e) {
+                sgl::Logfile::get()->writeError(std::string() + "Error in PipelineCache: " + e.what(), false);
+            }
+        }
+        if (shallBenchmarkSubgroupSizes) {
+            RegressionModeScope regressionModeScope("subgroup-sizes");
+            runSubgroupSizeBenchmark(device);
+        }
+        if (shallBenchmarkOccupancy) {
+            RegressionModeScope regressionModeScope("occupancy");
+            runOccupancyBenchmark(device);
+        }
+        if (shallBenchmarkAccuracy) {
+            RegressionModeScope regressionModeScope("accuracy");
+            runAccuracyBenchmark(i, device, reportDirectory);
+        }
+        if (shallBenchmarkSaturation) {
+            RegressionModeScope regressionModeScope("saturation");
+            runSaturationBenchmark(device);
+        }
+        if (shallBenchmarkCoopMat2Ops) {
+            RegressionModeScope regressionModeScope("coopmat2-ops");
+            runCoopMat2OpsBenchmark(device);
+        }
+        if (shallBenchmarkConvolution) {
+            RegressionModeScope regressionModeScope("convolution");
+            runConvolutionBenchmark(device);
+        }
+        if (shallBenchmarkFlashAttention) {
+            RegressionModeScope regressionModeScope("attention");
+            runFlashAttentionBenchmark(device);
+        }
+        if (shallBenchmarkCoopVecTraining) {
+            RegressionModeScope regressionModeScope("coopvec-training");
+            runCoopVecTrainingBenchmark(device);
+        }
+        if (shallBenchmarkCoopVecLayouts) {
+            RegressionModeScope regressionModeScope("coopvec-layouts");
+            runCoopVecLayoutBenchmark(device);
+        }
+        if (shallBenchmarkBatchedGemm) {
+            RegressionModeScope regressionModeScope("batched-gemm");
+            runBatchedGemmBenchmark(device);
+        }
+        if (shallBenchmarkAsyncOverlap) {
+            RegressionModeScope regressionModeScope("async-overlap");
+            runAsyncOverlapBenchmark(device);
+        }
+        if (shallBenchmarkPipelineCache) {
+            RegressionModeScope regressionModeScope("pipeline-cache");
+            runPipelineCacheBenchmark(device, pipelineCache.get());
+        }
+        if (shallBenchmarkRoofline) {
+            RegressionModeScope regressionModeScope("roofline");
+            runRooflineBenchmark(i, device, reportDirectory);
+        }
+        if (shallBenchmarkGemmPrediction) {
+            RegressionModeScope regressionModeScope("gemm-prediction");
+            runGemmPredictionBenchmark(i, device, reportDirectory);
+        }
+        if (shallBenchmarkNumaTransfer) {
+            RegressionModeScope regressionModeScope("numa-transfer");
+            runNumaTransferBenchmark(device);
+        }
 #ifdef __linux__
         if (shallTestDrmFormatModifiers && device->getApiVersion() >= VK_API_VERSION_1_3
                 && device->isDeviceExtensionSupported(VK_EXT_IMAGE_DRM_FORMAT_MODIFIER_EXTENSION_NAME)) {
             queryImageDrmFormatModifiers(i, device);
         }
 #endif
+        if (pipelineCache) {
+            setDefaultPipelineCache(device->getVkDevice(), VK_NULL_HANDLE);
+            pipelineCache->save();
+            pipelineCache = {};
+        }
         delete device;
         if (i == suitablePhysicalDevices.size() - 1) {
             sgl::Logfile::get()->write("<br><hr>\n");
         }
     }
 
+    if (shallBenchmarkPeerTransfer || shallBenchmarkMultiGpuGemm) {
+        // Peer transfers and the multi-GPU GEMM need all devices to be alive at the same time.
+        std::vector<sgl::vk::Device*> devices;
+        for (auto& physicalDevice : suitablePhysicalDevices) {
+            auto* device = new sgl::vk::Device;
+            device->createDeviceHeadlessFromPhysicalDevice(
+                    instance, physicalDevice, requiredDeviceExtensions,
+                    optionalDeviceExtensions, requestedDeviceFeatures, true);
+            devices.push_back(device);
+        }
+        clearRegressionDevice();
+        if (shallBenchmarkPeerTransfer) {
+            RegressionModeScope regressionModeScope("peer-transfer");
+            runPeerTransferBenchmark(instance, devices);
+        }
+        if (shallBenchmarkMultiGpuGemm) {
+            RegressionModeScope regressionModeScope("multi-gpu-gemm");
+            runMultiGpuGemmBenchmark(instance, devices);
+        }
+        for (auto* device : devices) {
+            loadDeviceFunctions(device->getVkDevice());
+            delete device;
+        }
+    }
+
 #ifdef __linux__
     if (isEglInitialized) {
         releaseEglLibrary();
@@ -644,9 +889,16 @@ int main(int argc, char *argv[]) {
 #endif
     delete instance;
 
+    int exitCode = 0;
+    if (!regressionBaselineFilePath.empty()) {
+        size_t numFailures = finishRegressionRun(
+                regressionBaselineFilePath, shallUpdateRegressionBaseline, reportDirectory);
+        exitCode = numFailures == 0 ? 0 : 1;
+    }
+
 #ifdef _WIN32
     pauseIfAppOwnsConsole();
 #endif
 
-    return 0;
+    return exitCode;
 }
@@ -0,0 +1,293 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+
+#include "ComponentTypes.hpp"
+#include "NumberFormats.hpp"
+
+/**
+ * Generic rounding to a binary float format with 1 sign bit, numExponentBits and numMantissaBits. Formats without
+ * infinity (E4M3) use the all-ones exponent for finite values and only reserve the all-ones pattern for NaN.
+ */
+static uint32_t encodeSmallFloat(float value, int numExponentBits, int numMantissaBits, bool hasInfinity) {
+    const uint32_t signBit = 1u << uint32_t(numExponentBits + numMantissaBits);
+    const uint32_t sign = std::signbit(value) ? signBit : 0u;
+    const uint32_t allExponentBits = ((1u << uint32_t(numExponentBits)) - 1u) << uint32_t(numMantissaBits);
+    const uint32_t infinityBits = hasInfinity ? allExponentBits : (signBit - 1u);
+    if (std::isnan(value)) {
+        return sign | (signBit - 1u);
+    }
+    if (std::isinf(value)) {
+        return sign | infinityBits;
+    }
+
+    const int bias = (1 << (numExponentBits - 1)) - 1;
+    const int maxExponentField = hasInfinity ? (1 << numExponentBits) - 2 : (1 << numExponentBits) - 1;
+    const int maxMantissa = hasInfinity ? (1 << numMantissaBits) - 1 : (1 << numMantissaBits) - 2;
+    const double maxFinite = std::ldexp(
+            1.0 + double(maxMantissa) / double(1 << numMantissaBits), maxExponentField - bias);
+
+    double absValue = std::fabs(double(value));
+    int exponent = 0;
+    std::frexp(absValue, &exponent);
+    int unbiasedExponent = std::max(exponent - 1, 1 - bias);
+    double quantum = std::ldexp(1.0, unbiasedExponent - numMantissaBits);
+    double rounded = std::nearbyint(absValue / quantum) * quantum;
+    if (rounded > maxFinite) {
+        return sign | infinityBits;
+    }
+    if (rounded == 0.0) {
+        return sign;
+    }
+
+    std::frexp(rounded, &exponent);
+    unbiasedExponent = exponent - 1;
+    if (unbiasedExponent < 1 - bias) {
+        auto mantissa = uint32_t(rounded / std::ldexp(1.0, 1 - bias - numMantissaBits));
+        return sign | mantissa;
+    }
+    auto exponentField = uint32_t(unbiasedExponent + bias);
+    auto mantissa = uint32_t((rounded / std::ldexp(1.0, unbiasedExponent) - 1.0) * double(1 << numMantissaBits));
+    return sign | (exponentField << uint32_t(numMantissaBits)) | mantissa;
+}
+
+static float decodeSmallFloat(uint32_t bits, int numExponentBits, int numMantissaBits, bool hasInfinity) {
+    const int bias = (1 << (numExponentBits - 1)) - 1;
+    const uint32_t exponentMask = (1u << uint32_t(numExponentBits)) - 1u;
+    const uint32_t mantissaMask = (1u << uint32_t(numMantissaBits)) - 1u;
+    bool isNegative = ((bits >> uint32_t(numExponentBits + numMantissaBits)) & 1u) != 0;
+    uint32_t exponentField = (bits >> uint32_t(numMantissaBits)) & exponentMask;
+    uint32_t mantissa = bits & mantissaMask;
+
+    double result;
+    if (exponentField == exponentMask && (hasInfinity || mantissa == mantissaMask)) {
+        result = hasInfinity && mantissa == 0 ? std::numeric_limits<double>::infinity()
+                : std::numeric_limits<double>::quiet_NaN();
+    } else if (exponentField == 0) {
+        result = std::ldexp(double(mantissa), 1 - bias - numMantissaBits);
+    } else {
+        result = std::ldexp(double(mantissa | (mantissaMask + 1u)), int(exponentField) - bias - numMantissaBits);
+    }
+    return float(isNegative ? -result : result);
+}
+
+uint16_t floatToHalf(float value) {
+    return uint16_t(encodeSmallFloat(value, 5, 10, true));
+}
+
+float halfToFloat(uint16_t value) {
+    return decodeSmallFloat(value, 5, 10, true);
+}
+
+uint16_t floatToBfloat16(float value) {
+    return uint16_t(encodeSmallFloat(value, 8, 7, true));
+}
+
+float bfloat16ToFloat(uint16_t value) {
+    uint32_t bits = uint32_t(value) << 16u;
+    float result;
+    memcpy(&result, &bits, sizeof(float));
+    return result;
+}
+
+uint8_t floatToFloatE4M3(float value) {
+    return uint8_t(encodeSmallFloat(value, 4, 3, false));
+}
+
+float floatE4M3ToFloat(uint8_t value) {
+    return decodeSmallFloat(value, 4, 3, false);
+}
+
+uint8_t floatToFloatE5M2(float value) {
+    return uint8_t(encodeSmallFloat(value, 5, 2, true));
+}
+
+float floatE5M2ToFloat(uint8_t value) {
+    return decodeSmallFloat(value, 5, 2, true);
+}
+
+template<class T>
+static T roundAndClamp(double value) {
+    value = std::round(value);
+    if (std::isnan(value)) {
+        return T(0);
+    }
+    if (value <= double(std::numeric_limits<T>::lowest())) {
+        return std::numeric_limits<T>::lowest();
+    }
+    if (value >= double(std::numeric_limits<T>::max())) {
+        return std::numeric_limits<T>::max();
+    }
+    return T(value);
+}
+
+void writeElement(void* data, VkComponentTypeKHR compType, size_t i, double value) {
+    switch (compType) {
+        case VK_COMPONENT_TYPE_FLOAT16_KHR:
+            static_cast<uint16_t*>(data)[i] = floatToHalf(float(value));
+            break;
+        case VK_COMPONENT_TYPE_FLOAT32_KHR:
+            static_cast<float*>(data)[i] = float(value);
+            break;
+        case VK_COMPONENT_TYPE_FLOAT64_KHR:
+            static_cast<double*>(data)[i] = value;
+            break;
+        case VK_COMPONENT_TYPE_BFLOAT16_KHR:
+            static_cast<uint16_t*>(data)[i] = floatToBfloat16(float(value));
+            break;
+        case VK_COMPONENT_TYPE_FLOAT_E4M3_NV:
+            static_cast<uint8_t*>(data)[i] = floatToFloatE4M3(float(value));
+            break;
+        case VK_COMPONENT_TYPE_FLOAT_E5M2_NV:
+            static_cast<uint8_t*>(data)[i] = floatToFloatE5M2(float(value));
+            break;
+        case VK_COMPONENT_TYPE_SINT8_KHR:
+            static_cast<int8_t*>(data)[i] = roundAndClamp<int8_t>(value);
+            break;
+        case VK_COMPONENT_TYPE_SINT16_KHR:
+            static_cast<int16_t*>(data)[i] = roundAndClamp<int16_t>(value);
+            break;
+        case VK_COMPONENT_TYPE_SINT32_KHR:
+        case VK_COMPONENT_TYPE_SINT8_PACKED_NV:
+            static_cast<int32_t*>(data)[i] = roundAndClamp<int32_t>(value);
+            break;
+        case VK_COMPONENT_TYPE_SINT64_KHR:
+            static_cast<int64_t*>(data)[i] = roundAndClamp<int64_t>(value);
+            break;
+        case VK_COMPONENT_TYPE_UINT8_KHR:
+            static_cast<uint8_t*>(data)[i] = roundAndClamp<uint8_t>(value);
+            break;
+        case VK_COMPONENT_TYPE_UINT16_KHR:
+            static_cast<uint16_t*>(data)[i] = roundAndClamp<uint16_t>(value);
+            break;
+        case VK_COMPONENT_TYPE_UINT64_KHR:
+            static_cast<uint64_t*>(data)[i] = roundAndClamp<uint64_t>(value);
+            break;
+        default:
+            static_cast<uint32_t*>(data)[i] = roundAndClamp<uint32_t>(value);
+            break;
+    }
+}
+
+double readElement(const void* data, VkComponentTypeKHR compType, size_t i) {
+    switch (compType) {
+        case VK_COMPONENT_TYPE_FLOAT16_KHR:
+            return halfToFloat(static_cast<const uint16_t*>(data)[i]);
+        case VK_COMPONENT_TYPE_FLOAT32_KHR:
+            return static_cast<const float*>(data)[i];
+        case VK_COMPONENT_TYPE_FLOAT64_KHR:
+            return static_cast<const double*>(data)[i];
+        case VK_COMPONENT_TYPE_BFLOAT16_KHR:
+            return bfloat16ToFloat(static_cast<const uint16_t*>(data)[i]);
+        case VK_COMPONENT_TYPE_FLOAT_E4M3_NV:
+            return floatE4M3ToFloat(static_cast<const uint8_t*>(data)[i]);
+        case VK_COMPONENT_TYPE_FLOAT_E5M2_NV:
+            return floatE5M2ToFloat(static_cast<const uint8_t*>(data)[i]);
+        case VK_COMPONENT_TYPE_SINT8_KHR:
+            return static_cast<const int8_t*>(data)[i];
+        case VK_COMPONENT_TYPE_SINT16_KHR:
+            return static_cast<const int16_t*>(data)[i];
+        case VK_COMPONENT_TYPE_SINT32_KHR:
+        case VK_COMPONENT_TYPE_SINT8_PACKED_NV:
+            return static_cast<const int32_t*>(data)[i];
+        case VK_COMPONENT_TYPE_SINT64_KHR:
+            return double(static_cast<const int64_t*>(data)[i]);
+        case VK_COMPONENT_TYPE_UINT8_KHR:
+            return static_cast<const uint8_t*>(data)[i];
+        case VK_COMPONENT_TYPE_UINT16_KHR:
+            return static_cast<const uint16_t*>(data)[i];
+        case VK_COMPONENT_TYPE_UINT64_KHR:
+            return double(static_cast<const uint64_t*>(data)[i]);
+        default:
+            return static_cast<const uint32_t*>(data)[i];
+    }
+}
+
+double getUlpSize(VkComponentTypeKHR compType, double value) {
+    int numMantissaBits, bias;
+    switch (compType) {
+        case VK_COMPONENT_TYPE_FLOAT16_KHR:
+            numMantissaBits = 10;
+            bias = 15;
+            break;
+        case VK_COMPONENT_TYPE_FLOAT32_KHR:
+            numMantissaBits = 23;
+            bias = 127;
+            break;
+        case VK_COMPONENT_TYPE_FLOAT64_KHR:
+            numMantissaBits = 52;
+            bias = 1023;
+            break;
+        case VK_COMPONENT_TYPE_BFLOAT16_KHR:
+            numMantissaBits = 7;
+            bias = 127;
+            break;
+        case VK_COMPONENT_TYPE_FLOAT_E4M3_NV:
+            numMantissaBits = 3;
+            bias = 7;
+            break;
+        case VK_COMPONENT_TYPE_FLOAT_E5M2_NV:
+            numMantissaBits = 2;
+            bias = 15;
+            break;
+        default:
+            return 1.0;
+    }
+    int exponent = 0;
+    std::frexp(std::fabs(value), &exponent);
+    int unbiasedExponent = value == 0.0 ? 1 - bias : std::max(exponent - 1, 1 - bias);
+    return std::ldexp(1.0, unbiasedExponent - numMantissaBits);
+}
+
+double roundToComponentType(VkComponentTypeKHR compType, double value) {
+    uint64_t element = 0;
+    writeElement(&element, compType, 0, value);
+    return readElement(&element, compType, 0);
+}
+
+std::vector<uint8_t> createRandomElements(VkComponentTypeKHR compType, size_t numElements, uint32_t seed) {
+    std::vector<uint8_t> data(numElements * getComponentTypeSize(compType));
+    std::mt19937 generator(seed);
+    if (getIsComponentTypeInteger(compType)) {
+        std::uniform_int_distribution<int> distribution(
+                getIsComponentTypeSigned(compType) ? -4 : 0, getIsComponentTypeSigned(compType) ? 4 : 8);
+        for (size_t i = 0; i < numElements; i++) {
+            writeElement(data.data(), compType, i, double(distribution(generator)));
+        }
+    } else {
+        std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+        for (size_t i = 0; i < numElements; i++) {
+            writeElement(data.data(), compType, i, double(distribution(generator)));
+        }
+    }
+    return data;
+}
@@ -0,0 +1,68 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef QUERYVKCOOPMAT_NUMBERFORMATS_HPP
+#define QUERYVKCOOPMAT_NUMBERFORMATS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <Graphics/Vulkan/Utils/Device.hpp>
+
+/*
+ * Host-side conversion between float and the component types used by cooperative matrices. Conversions to the small
+ * float formats round to nearest even. Values out of range become infinity (or NaN for E4M3, which has no infinity).
+ */
+
+uint16_t floatToHalf(float value);
+float halfToFloat(uint16_t value);
+uint16_t floatToBfloat16(float value);
+float bfloat16ToFloat(uint16_t value);
+uint8_t floatToFloatE4M3(float value);
+float floatE4M3ToFloat(uint8_t value);
+uint8_t floatToFloatE5M2(float value);
+float floatE5M2ToFloat(uint8_t value);
+
+/// Writes the value to element i of an array of the passed type. Integers are rounded and clamped to their range.
+void writeElement(void* data, VkComponentTypeKHR compType, size_t i, double value);
+double readElement(const void* data, VkComponentTypeKHR compType, size_t i);
+
+/// Returns the distance to the next representable value of the type above |value| (1 for integer types).
+double getUlpSize(VkComponentTypeKHR compType, double value);
+
+/// Rounds the value to the nearest value representable in the passed type.
+double roundToComponentType(VkComponentTypeKHR compType, double value);
+
+/**
+ * Creates an array of random values exactly representable in the passed type. Floats are drawn from [-1, 1] and
+ * integers from a small range ([-4, 4] or [0, 8]), such that accumulation over long dot products does not overflow.
+ */
+std::vector<uint8_t> createRandomElements(VkComponentTypeKHR compType, size_t numElements, uint32_t seed);
+
+#endif //QUERYVKCOOPMAT_NUMBERFORMATS_HPP
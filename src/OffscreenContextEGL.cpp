@@ -35,6 +35,7 @@
 
 #include "OffscreenContextCommon.hpp"
 #include "OffscreenContextEGL.hpp"
+#include "GLBenchmark.hpp"
 
 #define GLAPIENTRY EGLAPIENTRY
 #include "GLCommon.hpp"
@@ -184,7 +185,7 @@ void* getEglFunctionPointer(const char* functionName) {
     }
     return (void*)eglf->eglGetProcAddress(functionName);
 }
-void checkEglFeatures(sgl::vk::Device* device) {
+void checkEglFeatures(sgl::vk::Device* device, bool shallBenchmarkSsbo) {
     if (!eglf->eglQueryDevicesEXT || !eglf->eglQueryDeviceStringEXT
             || !eglf->eglGetPlatformDisplayEXT || !eglf->eglQueryDeviceBinaryEXT) {
         return;
@@ -400,6 +401,9 @@ void checkEglFeatures(sgl::vk::Device* device) {
     }
 
     printOpenGLContextInformation(getEglFunctionPointer);
+    if (shallBenchmarkSsbo) {
+        runOpenGLSsboBenchmark(getEglFunctionPointer);
+    }
 
     if (eglSurface) {
         if (!eglf->eglDestroySurface(eglDisplay, eglSurface)) {
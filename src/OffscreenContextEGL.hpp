@@ -38,6 +38,6 @@ class Device;
  */
 bool loadEglLibrary();
 void releaseEglLibrary();
-void checkEglFeatures(sgl::vk::Device* device);
+void checkEglFeatures(sgl::vk::Device* device, bool shallBenchmarkSsbo);
 
 #endif //OFFSCREENCONTEXTEGL_HPP
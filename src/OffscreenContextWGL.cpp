@@ -53,6 +53,7 @@ inline void ThrowIfFailed(HRESULT hr) {
 
 #include "OffscreenContextCommon.hpp"
 #include "OffscreenContextWGL.hpp"
+#include "GLBenchmark.hpp"
 
 #include <Graphics/Vulkan/Utils/Device.hpp>
 
@@ -221,7 +222,7 @@ void freeWglPatch() {
     }
 }
 
-void checkWglFeatures(sgl::vk::Device* device) {
+void checkWglFeatures(sgl::vk::Device* device, bool shallBenchmarkSsbo) {
     const VkPhysicalDeviceIDProperties& physicalDeviceIdProperties = device->getDeviceIDProperties();
     if (!physicalDeviceIdProperties.deviceLUIDValid) {
         return;
@@ -391,6 +392,9 @@ void checkWglFeatures(sgl::vk::Device* device) {
     }
 
     printOpenGLContextInformation(getWglFunctionPointer);
+    if (shallBenchmarkSsbo) {
+        runOpenGLSsboBenchmark(getWglFunctionPointer);
+    }
 
     //wglf->wglMakeCurrent(deviceContext, nullptr); // already done by wglDeleteContext
     cleanupWgl(glRenderingContext);
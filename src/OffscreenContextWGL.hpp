@@ -38,6 +38,6 @@ class Device;
  */
 bool initWglPatch();
 void freeWglPatch();
-void checkWglFeatures(sgl::vk::Device* device);
+void checkWglFeatures(sgl::vk::Device* device, bool shallBenchmarkSsbo);
 
 #endif //OFFSCREENCONTEXTWGL_HPP
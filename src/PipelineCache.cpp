@@ -0,0 +1,293 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+#include <Utils/File/Logfile.hpp>
+#include <Graphics/Vulkan/libs/volk/volk.h>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#endif
+
+#include "VulkanUtils.hpp"
+#include "PipelineCache.hpp"
+
+static const char PIPELINE_CACHE_FILE_MAGIC[8] = { 'Q', 'V', 'K', 'P', 'C', 'A', 'C', 'H' };
+static const uint32_t PIPELINE_CACHE_FILE_VERSION = 1;
+
+/// Precedes the data returned by vkGetPipelineCacheData in the cache file.
+struct PipelineCacheFileHeader {
+    char magic[8];
+    uint32_t fileVersion;
+    uint32_t vendorID;
+    uint32_t deviceID;
+    uint32_t driverVersion;
+    uint8_t pipelineCacheUUID[VK_UUID_SIZE];
+    uint64_t dataSize;
+    uint64_t checksum; ///< FNV-1a hash of the data; detects truncated or partially written files.
+};
+
+/// Exclusive lock on a file that is held until the object is destroyed. Blocks until the lock is acquired.
+class FileLock {
+public:
+    explicit FileLock(const std::string& lockFilePath);
+    ~FileLock();
+    FileLock(const FileLock&) = delete;
+    FileLock& operator=(const FileLock&) = delete;
+
+private:
+#ifdef _WIN32
+    HANDLE fileHandle = INVALID_HANDLE_VALUE;
+#else
+    int fd = -1;
+#endif
+};
+
+#ifdef _WIN32
+FileLock::FileLock(const std::string& lockFilePath) {
+    fileHandle = CreateFileA(
+            lockFilePath.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+            OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Could not open the lock file " + lockFilePath + ".");
+    }
+    OVERLAPPED overlapped{};
+    if (!LockFileEx(fileHandle, LOCKFILE_EXCLUSIVE_LOCK, 0, 1, 0, &overlapped)) {
+        CloseHandle(fileHandle);
+        throw std::runtime_error("Could not lock " + lockFilePath + ".");
+    }
+}
+
+FileLock::~FileLock() {
+    OVERLAPPED overlapped{};
+    UnlockFileEx(fileHandle, 0, 1, 0, &overlapped);
+    CloseHandle(fileHandle);
+}
+#else
+FileLock::FileLock(const std::string& lockFilePath) {
+    fd = open(lockFilePath.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Could not open the lock file " + lockFilePath + ".");
+    }
+    if (flock(fd, LOCK_EX) != 0) {
+        close(fd);
+        throw std::runtime_error("Could not lock " + lockFilePath + ".");
+    }
+}
+
+FileLock::~FileLock() {
+    flock(fd, LOCK_UN);
+    close(fd);
+}
+#endif
+
+static uint64_t computeChecksum(const uint8_t* data, size_t dataSize) {
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < dataSize; i++) {
+        hash ^= uint64_t(data[i]);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+static std::string getPipelineCacheFileName(const VkPhysicalDeviceProperties& properties) {
+    std::ostringstream stream;
+    stream << std::hex << std::setfill('0');
+    stream << std::setw(4) << properties.vendorID << "_" << std::setw(4) << properties.deviceID << "_"
+           << std::setw(8) << properties.driverVersion << "_";
+    for (uint32_t i = 0; i < VK_UUID_SIZE; i++) {
+        stream << std::setw(2) << uint32_t(properties.pipelineCacheUUID[i]);
+    }
+    stream << ".bin";
+    return stream.str();
+}
+
+std::string validatePipelineCacheData(
+        const VkPhysicalDeviceProperties& properties, const uint8_t* data, size_t dataSize) {
+    VkPipelineCacheHeaderVersionOne header{};
+    if (dataSize < sizeof(VkPipelineCacheHeaderVersionOne)) {
+        return "header too small";
+    }
+    memcpy(&header, data, sizeof(VkPipelineCacheHeaderVersionOne));
+    if (header.headerSize < sizeof(VkPipelineCacheHeaderVersionOne) || header.headerSize > dataSize) {
+        return "invalid header size";
+    }
+    if (header.headerVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE) {
+        return "unknown header version";
+    }
+    if (header.vendorID != properties.vendorID || header.deviceID != properties.deviceID) {
+        return "vendor or device ID mismatch";
+    }
+    if (memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) != 0) {
+        return "pipelineCacheUUID mismatch";
+    }
+    return "";
+}
+
+/// Returns an empty string if the file could be read and is valid for the device, and the reason otherwise.
+static std::string readPipelineCacheFile(
+        const std::string& filePath, const VkPhysicalDeviceProperties& properties, std::vector<uint8_t>& data) {
+    std::ifstream file(filePath, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return "not found";
+    }
+    auto fileSize = size_t(file.tellg());
+    file.seekg(0);
+    PipelineCacheFileHeader header{};
+    if (fileSize < sizeof(PipelineCacheFileHeader)
+            || !file.read(reinterpret_cast<char*>(&header), sizeof(PipelineCacheFileHeader))) {
+        return "truncated file";
+    }
+    if (memcmp(header.magic, PIPELINE_CACHE_FILE_MAGIC, sizeof(PIPELINE_CACHE_FILE_MAGIC)) != 0
+            || header.fileVersion != PIPELINE_CACHE_FILE_VERSION) {
+        return "unknown file format";
+    }
+    if (header.vendorID != properties.vendorID || header.deviceID != properties.deviceID
+            || header.driverVersion != properties.driverVersion
+            || memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) != 0) {
+        return "written for a different device or driver";
+    }
+    if (header.dataSize != fileSize - sizeof(PipelineCacheFileHeader)) {
+        return "truncated file";
+    }
+    data.resize(size_t(header.dataSize));
+    if (!file.read(reinterpret_cast<char*>(data.data()), std::streamsize(data.size()))) {
+        data.clear();
+        return "truncated file";
+    }
+    if (computeChecksum(data.data(), data.size()) != header.checksum) {
+        data.clear();
+        return "checksum mismatch";
+    }
+    std::string errorString = validatePipelineCacheData(properties, data.data(), data.size());
+    if (!errorString.empty()) {
+        data.clear();
+    }
+    return errorString;
+}
+
+VkPipelineCache createVkPipelineCache(VkDevice device, const std::vector<uint8_t>& initialData) {
+    VkPipelineCacheCreateInfo pipelineCacheCreateInfo{};
+    pipelineCacheCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    pipelineCacheCreateInfo.initialDataSize = initialData.size();
+    pipelineCacheCreateInfo.pInitialData = initialData.empty() ? nullptr : initialData.data();
+    VkPipelineCache pipelineCache = VK_NULL_HANDLE;
+    throwIfVkError(
+            vkCreatePipelineCache(device, &pipelineCacheCreateInfo, nullptr, &pipelineCache), "vkCreatePipelineCache");
+    return pipelineCache;
+}
+
+std::vector<uint8_t> getPipelineCacheData(VkDevice device, VkPipelineCache pipelineCache) {
+    size_t dataSize = 0;
+    throwIfVkError(vkGetPipelineCacheData(device, pipelineCache, &dataSize, nullptr), "vkGetPipelineCacheData");
+    std::vector<uint8_t> data(dataSize);
+    throwIfVkError(
+            vkGetPipelineCacheData(device, pipelineCache, &dataSize, data.data()), "vkGetPipelineCacheData");
+    data.resize(dataSize);
+    return data;
+}
+
+PipelineCache::PipelineCache(sgl::vk::Device* device, const std::string& directory) : device(device) {
+    const auto& properties = device->getPhysicalDeviceProperties();
+    filePath = (std::filesystem::path(directory) / getPipelineCacheFileName(properties)).string();
+    std::vector<uint8_t> data;
+    std::string errorString = readPipelineCacheFile(filePath, properties, data);
+    loadStatus = errorString.empty() ? "loaded" : errorString;
+    loadedDataSize = data.size();
+    pipelineCache = createVkPipelineCache(device->getVkDevice(), data);
+}
+
+PipelineCache::~PipelineCache() {
+    if (pipelineCache) {
+        vkDestroyPipelineCache(device->getVkDevice(), pipelineCache, nullptr);
+    }
+}
+
+bool PipelineCache::save() {
+    const auto& properties = device->getPhysicalDeviceProperties();
+    VkDevice vkDevice = device->getVkDevice();
+    try {
+        // Avoids creating cache files for runs that did not compile any pipeline (e.g., only querying the features).
+        if (getPipelineCacheData(vkDevice, pipelineCache).size()
+                <= std::max(loadedDataSize, sizeof(VkPipelineCacheHeaderVersionOne))) {
+            return true;
+        }
+        std::filesystem::create_directories(std::filesystem::path(filePath).parent_path());
+        FileLock fileLock(filePath + ".lock");
+
+        // Other runs may have added pipelines since the file was loaded.
+        std::vector<uint8_t> fileData;
+        if (readPipelineCacheFile(filePath, properties, fileData).empty()) {
+            VkPipelineCache fileCache = createVkPipelineCache(vkDevice, fileData);
+            VkResult result = vkMergePipelineCaches(vkDevice, pipelineCache, 1, &fileCache);
+            vkDestroyPipelineCache(vkDevice, fileCache, nullptr);
+            throwIfVkError(result, "vkMergePipelineCaches");
+        }
+
+        std::vector<uint8_t> data = getPipelineCacheData(vkDevice, pipelineCache);
+        PipelineCacheFileHeader header{};
+        memcpy(header.magic, PIPELINE_CACHE_FILE_MAGIC, sizeof(PIPELINE_CACHE_FILE_MAGIC));
+        header.fileVersion = PIPELINE_CACHE_FILE_VERSION;
+        header.vendorID = properties.vendorID;
+        header.deviceID = properties.deviceID;
+        header.driverVersion = properties.driverVersion;
+        memcpy(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE);
+        header.dataSize = data.size();
+        header.checksum = computeChecksum(data.data(), data.size());
+
+        // Readers without the lock never see a partially written file, as the rename replaces it atomically.
+        std::string tempFilePath = filePath + ".tmp";
+        {
+            std::ofstream file(tempFilePath, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char*>(&header), sizeof(PipelineCacheFileHeader));
+            file.write(reinterpret_cast<const char*>(data.data()), std::streamsize(data.size()));
+            if (!file) {
+                throw std::runtime_error("Could not write " + tempFilePath + ".");
+            }
+        }
+        std::filesystem::rename(tempFilePath, filePath);
+    } catch (const std::exception& e) {
+        sgl::Logfile::get()->writeError(std::string() + "Error in PipelineCache::save: " + e.what(), false);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,81 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef QUERYVKCOOPMAT_PIPELINECACHE_HPP
+#define QUERYVKCOOPMAT_PIPELINECACHE_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <Graphics/Vulkan/Utils/Device.hpp>
+
+/**
+ * VkPipelineCache persisted across runs. The file name contains the vendor ID, device ID, driver version and
+ * pipelineCacheUUID of the device, such that each driver version starts with a fresh cache. The data is validated
+ * before it is passed to the driver. Saving merges the data written by concurrent runs in the meantime while holding a
+ * lock file, and replaces the cache file atomically.
+ */
+class PipelineCache {
+public:
+    /// Creates an empty cache if the file does not exist or is invalid; throws std::runtime_error on Vulkan errors.
+    PipelineCache(sgl::vk::Device* device, const std::string& directory);
+    ~PipelineCache();
+    PipelineCache(const PipelineCache&) = delete;
+    PipelineCache& operator=(const PipelineCache&) = delete;
+
+    [[nodiscard]] inline VkPipelineCache getVkPipelineCache() const { return pipelineCache; }
+    [[nodiscard]] inline const std::string& getFilePath() const { return filePath; }
+    [[nodiscard]] inline size_t getLoadedDataSize() const { return loadedDataSize; }
+    /// "loaded", "not found", or the reason why the file was rejected.
+    [[nodiscard]] inline const std::string& getLoadStatus() const { return loadStatus; }
+
+    /// Merges the cache with the current file content and writes it back. Returns false on errors, which are logged.
+    bool save();
+
+private:
+    sgl::vk::Device* device;
+    std::string filePath;
+    VkPipelineCache pipelineCache = VK_NULL_HANDLE;
+    size_t loadedDataSize = 0;
+    std::string loadStatus;
+};
+
+/// Creates a pipeline cache with the passed initial data, which needs to be validated beforehand.
+VkPipelineCache createVkPipelineCache(VkDevice device, const std::vector<uint8_t>& initialData);
+/// Returns the data of the passed pipeline cache (vkGetPipelineCacheData).
+std::vector<uint8_t> getPipelineCacheData(VkDevice device, VkPipelineCache pipelineCache);
+
+/**
+ * Checks the VkPipelineCacheHeaderVersionOne header of pipeline cache data against the device. Returns an empty string
+ * if the data is compatible, and the reason otherwise.
+ */
+std::string validatePipelineCacheData(
+        const VkPhysicalDeviceProperties& properties, const uint8_t* data, size_t dataSize);
+
+#endif //QUERYVKCOOPMAT_PIPELINECACHE_HPP
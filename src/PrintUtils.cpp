@@ -0,0 +1,136 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+#include "BenchmarkRunner.hpp"
+#include "PrintUtils.hpp"
+#include "RegressionSuite.hpp"
+
+std::string formatNumber(double value, int precision) {
+    std::ostringstream stream;
+    stream << std::fixed << std::setprecision(precision) << value;
+    return stream.str();
+}
+
+std::string formatScientific(double value, int precision) {
+    std::ostringstream stream;
+    stream << std::scientific << std::setprecision(precision) << value;
+    return stream.str();
+}
+
+double computeGiBPerSecond(double numBytes, double timeMs) {
+    if (timeMs <= 0.0) {
+        return 0.0;
+    }
+    return numBytes / (timeMs * 1e-3) / (1024.0 * 1024.0 * 1024.0);
+}
+
+ResultTable::ResultTable(std::vector<std::string> columnNames) : columnNames(std::move(columnNames)) {
+}
+
+void ResultTable::addRow(std::vector<std::string> row) {
+    row.resize(columnNames.size());
+    rows.push_back(std::move(row));
+    rowStatistics.push_back(takeRecentBenchmarkStatistics());
+}
+
+static bool getIsAnyUnstable(const std::vector<BenchmarkStatistics>& statistics) {
+    return std::any_of(statistics.begin(), statistics.end(), [](const BenchmarkStatistics& measurement) {
+        return measurement.getIsUnstable();
+    });
+}
+
+void ResultTable::print() const {
+    std::vector<size_t> columnWidths(columnNames.size());
+    for (size_t colIdx = 0; colIdx < columnNames.size(); colIdx++) {
+        columnWidths.at(colIdx) = columnNames.at(colIdx).size();
+        for (const auto& row : rows) {
+            columnWidths.at(colIdx) = std::max(columnWidths.at(colIdx), row.at(colIdx).size());
+        }
+    }
+
+    auto printRow = [&](const std::vector<std::string>& row, bool isUnstable) {
+        for (size_t colIdx = 0; colIdx < row.size(); colIdx++) {
+            if (colIdx != 0) {
+                std::cout << "  ";
+            }
+            std::cout << std::setw(int(columnWidths.at(colIdx))) << row.at(colIdx);
+        }
+        std::cout << (isUnstable ? "  *\n" : "\n");
+    };
+    printRow(columnNames, false);
+    bool hasUnstableRows = false;
+    for (size_t rowIdx = 0; rowIdx < rows.size(); rowIdx++) {
+        bool isUnstable = getIsAnyUnstable(rowStatistics.at(rowIdx));
+        hasUnstableRows = hasUnstableRows || isUnstable;
+        printRow(rows.at(rowIdx), isUnstable);
+    }
+    if (hasUnstableRows) {
+        std::cout << "* Contains unstable measurements (see the log for their p5/p95 and confidence intervals).\n";
+    }
+    // Measurements after the last row belong to no row of this table.
+    takeRecentBenchmarkStatistics();
+    recordRegressionTable(columnNames, rows);
+    // Statistics of the measurements taken since the previous table, i.e., usually those of this table.
+    BenchmarkRunnerSummary summary = takeBenchmarkRunnerSummary();
+    std::string summaryString;
+    if (summary.numMeasurements > 0) {
+        summaryString = getBenchmarkRunnerSummaryString(summary);
+        std::cout << summaryString << "\n";
+    }
+    std::cout << std::endl;
+
+    std::string tableString = "<table><tr>";
+    for (const auto& columnName : columnNames) {
+        tableString += "<th>" + columnName + "</th>";
+    }
+    tableString += "<th>Measurements</th></tr>\n";
+    for (size_t rowIdx = 0; rowIdx < rows.size(); rowIdx++) {
+        tableString += "<tr>";
+        for (const auto& entry : rows.at(rowIdx)) {
+            tableString += "<td>" + entry + "</td>";
+        }
+        tableString += "<td>";
+        const std::vector<BenchmarkStatistics>& statistics = rowStatistics.at(rowIdx);
+        for (size_t measurementIdx = 0; measurementIdx < statistics.size(); measurementIdx++) {
+            if (measurementIdx != 0) {
+                tableString += "<br>";
+            }
+            tableString += statistics.at(measurementIdx).toString();
+        }
+        tableString += "</td></tr>\n";
+    }
+    tableString += "</table>\n";
+    if (!summaryString.empty()) {
+        tableString += "<p>" + summaryString + "</p>\n";
+    }
+    sgl::Logfile::get()->write(tableString);
+}
@@ -0,0 +1,83 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef QUERYVKCOOPMAT_PRINTUTILS_HPP
+#define QUERYVKCOOPMAT_PRINTUTILS_HPP
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <utility>
+
+#include <Math/Math.hpp>
+#include <Utils/File/Logfile.hpp>
+#include <ImGui/Widgets/NumberFormatting.hpp>
+
+#include "BenchmarkRunner.hpp"
+
+namespace sgl {
+// Override for nicer formating of bools.
+inline std::string toString(bool boolVal) {
+    return boolVal ? "true" : "false";
+}
+}
+
+template<typename... T>
+void writeOut(T... args) {
+    std::string text = (std::string() + ... + sgl::toString(std::move(args)));
+    sgl::Logfile::get()->write(text, sgl::BLACK);
+    std::cout << text << std::endl;
+}
+
+/// Formats a floating point number with a fixed number of digits after the decimal point.
+std::string formatNumber(double value, int precision = 2);
+/// Formats a number in scientific notation (e.g., 1.23e-04).
+std::string formatScientific(double value, int precision = 2);
+
+/// Converts a number of bytes transferred in the passed time to GiB/s.
+double computeGiBPerSecond(double numBytes, double timeMs);
+
+/**
+ * Table of measurement results. Printed as aligned plain text to stdout and as a HTML table to the log file.
+ * The measurements made by the benchmark runner since the previous row are attributed to each added row: Rows with
+ * unstable measurements are marked with "*", and the log lists the median, p5/p95 and CI of every measurement.
+ */
+class ResultTable {
+public:
+    explicit ResultTable(std::vector<std::string> columnNames);
+    void addRow(std::vector<std::string> row);
+    [[nodiscard]] bool empty() const { return rows.empty(); }
+    void print() const;
+
+private:
+    std::vector<std::string> columnNames;
+    std::vector<std::vector<std::string>> rows;
+    std::vector<std::vector<BenchmarkStatistics>> rowStatistics;
+};
+
+#endif //QUERYVKCOOPMAT_PRINTUTILS_HPP
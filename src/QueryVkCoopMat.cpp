@@ -0,0 +1,524 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <Graphics/Vulkan/libs/volk/volk.h>
+#include <Graphics/Vulkan/Utils/Instance.hpp>
+#include <Graphics/Vulkan/Utils/Device.hpp>
+
+#include "VulkanUtils.hpp"
+#include "BenchmarkRunner.hpp"
+#include "DeviceRequirements.hpp"
+#include "Benchmarks/CoopMatGemm.hpp"
+#include "QueryVkCoopMat.h"
+
+struct QvcmContext_T {
+    VkInstance vkInstance = VK_NULL_HANDLE; ///< Instance of the physical devices passed to the queries.
+    bool isInstanceOfCaller = false;
+    /// Created by the library for queries without an instance of the caller and for running benchmarks.
+    sgl::vk::Instance* instance = nullptr;
+    /// Devices for running benchmarks; keyed by the physical devices passed by the caller.
+    std::map<VkPhysicalDevice, sgl::vk::Device*> devices;
+    std::string lastErrorMessage;
+};
+
+class QvcmError : public std::runtime_error {
+public:
+    QvcmError(QvcmResult result, const std::string& message) : std::runtime_error(message), result(result) {}
+    [[nodiscard]] inline QvcmResult getResult() const { return result; }
+
+private:
+    QvcmResult result;
+};
+
+static void checkVkResult(VkResult result, const std::string& callName) {
+    if (result != VK_SUCCESS) {
+        throw QvcmError(QVCM_ERROR_VULKAN, "Error in " + callName + ": " + getVkResultString(result));
+    }
+}
+
+static void checkArgument(bool condition, const char* message) {
+    if (!condition) {
+        throw QvcmError(QVCM_ERROR_INVALID_ARGUMENT, message);
+    }
+}
+
+/// Runs an entry point and converts exceptions to result codes and the last error message of the context.
+template<class F>
+static QvcmResult callApi(QvcmContext context, const F& function) {
+    if (!context) {
+        return QVCM_ERROR_INVALID_ARGUMENT;
+    }
+    context->lastErrorMessage.clear();
+    try {
+        return function();
+    } catch (const QvcmError& e) {
+        context->lastErrorMessage = e.what();
+        return e.getResult();
+    } catch (const std::exception& e) {
+        context->lastErrorMessage = e.what();
+        return QVCM_ERROR_INTERNAL;
+    }
+}
+
+/// volk keeps one set of instance functions; switches them to the instance of the next call if necessary.
+static void loadInstanceFunctions(VkInstance instance) {
+    if (volkGetLoadedInstance() != instance) {
+        volkLoadInstanceOnly(instance);
+    }
+}
+
+template<class T>
+static QvcmResult copyArray(const std::vector<T>& elements, uint32_t* count, T* output) {
+    checkArgument(count != nullptr, "count must not be NULL.");
+    if (!output) {
+        *count = uint32_t(elements.size());
+        return QVCM_SUCCESS;
+    }
+    uint32_t numCopied = std::min(*count, uint32_t(elements.size()));
+    std::copy(elements.begin(), elements.begin() + numCopied, output);
+    *count = numCopied;
+    return numCopied < uint32_t(elements.size()) ? QVCM_INCOMPLETE : QVCM_SUCCESS;
+}
+
+static void copyString(char* destination, const char* source) {
+    std::snprintf(destination, QVCM_MAX_NAME_SIZE, "%s", source);
+}
+
+static bool getIsDeviceExtensionSupported(VkPhysicalDevice physicalDevice, const char* extensionName) {
+    uint32_t numExtensions = 0;
+    checkVkResult(vkEnumerateDeviceExtensionProperties(
+            physicalDevice, nullptr, &numExtensions, nullptr), "vkEnumerateDeviceExtensionProperties");
+    std::vector<VkExtensionProperties> extensions(numExtensions);
+    checkVkResult(vkEnumerateDeviceExtensionProperties(
+            physicalDevice, nullptr, &numExtensions, extensions.data()), "vkEnumerateDeviceExtensionProperties");
+    for (const auto& extension : extensions) {
+        if (std::strcmp(extension.extensionName, extensionName) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void getDeviceUuid(VkPhysicalDevice physicalDevice, uint8_t deviceUUID[VK_UUID_SIZE]) {
+    VkPhysicalDeviceIDProperties idProperties{};
+    idProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ID_PROPERTIES;
+    VkPhysicalDeviceProperties2 properties2{};
+    properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+    properties2.pNext = &idProperties;
+    vkGetPhysicalDeviceProperties2(physicalDevice, &properties2);
+    std::memcpy(deviceUUID, idProperties.deviceUUID, VK_UUID_SIZE);
+}
+
+static void createInstance(QvcmContext context) {
+    context->instance = new sgl::vk::Instance;
+    try {
+        context->instance->createInstance({}, false);
+    } catch (const std::exception& e) {
+        delete context->instance;
+        context->instance = nullptr;
+        throw QvcmError(QVCM_ERROR_VULKAN, std::string() + "Could not create a Vulkan instance: " + e.what());
+    }
+}
+
+/// Creates the device for running benchmarks on the passed physical device on first use.
+static sgl::vk::Device* getBenchmarkDevice(QvcmContext context, VkPhysicalDevice physicalDevice) {
+    auto it = context->devices.find(physicalDevice);
+    if (it != context->devices.end()) {
+        loadDeviceFunctions(it->second->getVkDevice());
+        return it->second;
+    }
+
+    // Devices can only be created from the instance of the library; the physical devices are matched by their UUID.
+    VkPhysicalDevice ownPhysicalDevice = physicalDevice;
+    if (context->isInstanceOfCaller) {
+        uint8_t deviceUUID[VK_UUID_SIZE];
+        loadInstanceFunctions(context->vkInstance);
+        getDeviceUuid(physicalDevice, deviceUUID);
+        if (!context->instance) {
+            createInstance(context);
+        }
+        loadInstanceFunctions(context->instance->getVkInstance());
+        ownPhysicalDevice = VK_NULL_HANDLE;
+        for (VkPhysicalDevice candidate : sgl::vk::enumeratePhysicalDevices(context->instance)) {
+            uint8_t candidateUUID[VK_UUID_SIZE];
+            getDeviceUuid(candidate, candidateUUID);
+            if (std::memcmp(deviceUUID, candidateUUID, VK_UUID_SIZE) == 0) {
+                ownPhysicalDevice = candidate;
+                break;
+            }
+        }
+        if (!ownPhysicalDevice) {
+            throw QvcmError(QVCM_ERROR_INTERNAL, "No physical device with a matching UUID found.");
+        }
+    } else {
+        loadInstanceFunctions(context->instance->getVkInstance());
+    }
+
+    DeviceRequirements requirements = getDeviceRequirements();
+    if (!sgl::vk::checkIsPhysicalDeviceSuitable(
+            context->instance, ownPhysicalDevice, nullptr, requirements.requiredDeviceExtensions,
+            requirements.requestedDeviceFeatures, true)) {
+        throw QvcmError(QVCM_ERROR_NOT_SUPPORTED, "The device lacks the extensions needed for benchmarks.");
+    }
+    auto* device = new sgl::vk::Device;
+    try {
+        device->createDeviceHeadlessFromPhysicalDevice(
+                context->instance, ownPhysicalDevice, requirements.requiredDeviceExtensions,
+                requirements.optionalDeviceExtensions, requirements.requestedDeviceFeatures, true);
+    } catch (...) {
+        delete device;
+        throw;
+    }
+    context->devices.insert(std::make_pair(physicalDevice, device));
+    return device;
+}
+
+
+QvcmResult qvcmCreateContext(const QvcmContextCreateInfo* createInfo, QvcmContext* context) {
+    if (!createInfo || !context) {
+        return QVCM_ERROR_INVALID_ARGUMENT;
+    }
+    *context = nullptr;
+    auto* newContext = new QvcmContext_T;
+    QvcmResult result = callApi(newContext, [&]() {
+        if (createInfo->instance) {
+            checkVkResult(volkInitialize(), "volkInitialize");
+            newContext->vkInstance = createInfo->instance;
+            newContext->isInstanceOfCaller = true;
+            loadInstanceFunctions(newContext->vkInstance);
+        } else {
+            createInstance(newContext);
+            newContext->vkInstance = newContext->instance->getVkInstance();
+        }
+        return QVCM_SUCCESS;
+    });
+    if (result != QVCM_SUCCESS) {
+        delete newContext;
+        return result;
+    }
+    *context = newContext;
+    return QVCM_SUCCESS;
+}
+
+void qvcmDestroyContext(QvcmContext context) {
+    if (!context) {
+        return;
+    }
+    for (auto& entry : context->devices) {
+        loadDeviceFunctions(entry.second->getVkDevice());
+        delete entry.second;
+    }
+    context->devices.clear();
+    delete context->instance;
+    delete context;
+}
+
+const char* qvcmGetLastErrorMessage(QvcmContext context) {
+    return context ? context->lastErrorMessage.c_str() : "Invalid context.";
+}
+
+QvcmResult qvcmEnumeratePhysicalDevices(QvcmContext context, uint32_t* count, VkPhysicalDevice* physicalDevices) {
+    return callApi(context, [&]() {
+        loadInstanceFunctions(context->vkInstance);
+        uint32_t numPhysicalDevices = 0;
+        checkVkResult(vkEnumeratePhysicalDevices(
+                context->vkInstance, &numPhysicalDevices, nullptr), "vkEnumeratePhysicalDevices");
+        std::vector<VkPhysicalDevice> allPhysicalDevices(numPhysicalDevices);
+        checkVkResult(vkEnumeratePhysicalDevices(
+                context->vkInstance, &numPhysicalDevices, allPhysicalDevices.data()), "vkEnumeratePhysicalDevices");
+        return copyArray(allPhysicalDevices, count, physicalDevices);
+    });
+}
+
+QvcmResult qvcmGetDeviceIdentity(QvcmContext context, VkPhysicalDevice physicalDevice, QvcmDeviceIdentity* identity) {
+    return callApi(context, [&]() {
+        checkArgument(physicalDevice && identity, "physicalDevice and identity must not be NULL.");
+        loadInstanceFunctions(context->vkInstance);
+        VkPhysicalDeviceProperties properties{};
+        vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+        VkPhysicalDeviceIDProperties idProperties{};
+        idProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ID_PROPERTIES;
+        VkPhysicalDeviceDriverProperties driverProperties{};
+        driverProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DRIVER_PROPERTIES;
+        VkPhysicalDeviceProperties2 properties2{};
+        properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+        properties2.pNext = &idProperties;
+        if (properties.apiVersion >= VK_API_VERSION_1_2) {
+            idProperties.pNext = &driverProperties;
+        }
+        vkGetPhysicalDeviceProperties2(physicalDevice, &properties2);
+
+        *identity = {};
+        copyString(identity->deviceName, properties.deviceName);
+        copyString(identity->driverName, driverProperties.driverName);
+        copyString(identity->driverInfo, driverProperties.driverInfo);
+        identity->apiVersion = properties.apiVersion;
+        identity->driverVersion = properties.driverVersion;
+        identity->vendorID = properties.vendorID;
+        identity->deviceID = properties.deviceID;
+        identity->deviceType = properties.deviceType;
+        identity->driverID = driverProperties.driverID;
+        std::memcpy(identity->deviceUUID, idProperties.deviceUUID, QVCM_UUID_SIZE);
+        std::memcpy(identity->driverUUID, idProperties.driverUUID, QVCM_UUID_SIZE);
+        return QVCM_SUCCESS;
+    });
+}
+
+QvcmResult qvcmGetCooperativeMatrixProperties(
+        QvcmContext context, VkPhysicalDevice physicalDevice, uint32_t* count,
+        QvcmCooperativeMatrixProperties* properties) {
+    return callApi(context, [&]() {
+        loadInstanceFunctions(context->vkInstance);
+        if (!getIsDeviceExtensionSupported(physicalDevice, VK_KHR_COOPERATIVE_MATRIX_EXTENSION_NAME)) {
+            throw QvcmError(QVCM_ERROR_NOT_SUPPORTED, "VK_KHR_cooperative_matrix is not supported.");
+        }
+        uint32_t numProperties = 0;
+        checkVkResult(vkGetPhysicalDeviceCooperativeMatrixPropertiesKHR(
+                physicalDevice, &numProperties, nullptr), "vkGetPhysicalDeviceCooperativeMatrixPropertiesKHR");
+        std::vector<VkCooperativeMatrixPropertiesKHR> vkProperties(numProperties);
+        for (auto& props : vkProperties) {
+            props.sType = VK_STRUCTURE_TYPE_COOPERATIVE_MATRIX_PROPERTIES_KHR;
+        }
+        checkVkResult(vkGetPhysicalDeviceCooperativeMatrixPropertiesKHR(
+                physicalDevice, &numProperties, vkProperties.data()),
+                "vkGetPhysicalDeviceCooperativeMatrixPropertiesKHR");
+        std::vector<QvcmCooperativeMatrixProperties> allProperties;
+        for (const auto& props : vkProperties) {
+            allProperties.push_back({
+                    props.MSize, props.NSize, props.KSize, props.AType, props.BType, props.CType, props.ResultType,
+                    props.saturatingAccumulation, props.scope });
+        }
+        return copyArray(allProperties, count, properties);
+    });
+}
+
+QvcmResult qvcmGetCooperativeMatrix2Features(
+        QvcmContext context, VkPhysicalDevice physicalDevice, QvcmCooperativeMatrix2Features* features) {
+    return callApi(context, [&]() {
+        checkArgument(physicalDevice && features, "physicalDevice and features must not be NULL.");
+        loadInstanceFunctions(context->vkInstance);
+        *features = {};
+        if (!getIsDeviceExtensionSupported(physicalDevice, VK_NV_COOPERATIVE_MATRIX_2_EXTENSION_NAME)) {
+            return QVCM_SUCCESS;
+        }
+        VkPhysicalDeviceCooperativeMatrix2FeaturesNV vkFeatures{};
+        vkFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_COOPERATIVE_MATRIX_2_FEATURES_NV;
+        VkPhysicalDeviceFeatures2 features2{};
+        features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        features2.pNext = &vkFeatures;
+        vkGetPhysicalDeviceFeatures2(physicalDevice, &features2);
+        VkPhysicalDeviceCooperativeMatrix2PropertiesNV vkProperties{};
+        vkProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_COOPERATIVE_MATRIX_2_PROPERTIES_NV;
+        VkPhysicalDeviceProperties2 properties2{};
+        properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+        properties2.pNext = &vkProperties;
+        vkGetPhysicalDeviceProperties2(physicalDevice, &properties2);
+
+        features->isSupported = VK_TRUE;
+        features->cooperativeMatrixWorkgroupScope = vkFeatures.cooperativeMatrixWorkgroupScope;
+        features->cooperativeMatrixFlexibleDimensions = vkFeatures.cooperativeMatrixFlexibleDimensions;
+        features->cooperativeMatrixReductions = vkFeatures.cooperativeMatrixReductions;
+        features->cooperativeMatrixConversions = vkFeatures.cooperativeMatrixConversions;
+        features->cooperativeMatrixPerElementOperations = vkFeatures.cooperativeMatrixPerElementOperations;
+        features->cooperativeMatrixTensorAddressing = vkFeatures.cooperativeMatrixTensorAddressing;
+        features->cooperativeMatrixBlockLoads = vkFeatures.cooperativeMatrixBlockLoads;
+        features->cooperativeMatrixWorkgroupScopeMaxWorkgroupSize =
+                vkProperties.cooperativeMatrixWorkgroupScopeMaxWorkgroupSize;
+        features->cooperativeMatrixFlexibleDimensionsMaxDimension =
+                vkProperties.cooperativeMatrixFlexibleDimensionsMaxDimension;
+        features->cooperativeMatrixWorkgroupScopeReservedSharedMemory =
+                vkProperties.cooperativeMatrixWorkgroupScopeReservedSharedMemory;
+        return QVCM_SUCCESS;
+    });
+}
+
+QvcmResult qvcmGetCooperativeMatrixFlexibleDimensionsProperties(
+        QvcmContext context, VkPhysicalDevice physicalDevice, uint32_t* count,
+        QvcmCooperativeMatrixFlexibleDimensionsProperties* properties) {
+    return callApi(context, [&]() {
+        loadInstanceFunctions(context->vkInstance);
+        if (!getIsDeviceExtensionSupported(physicalDevice, VK_NV_COOPERATIVE_MATRIX_2_EXTENSION_NAME)) {
+            throw QvcmError(QVCM_ERROR_NOT_SUPPORTED, "VK_NV_cooperative_matrix2 is not supported.");
+        }
+        uint32_t numProperties = 0;
+        checkVkResult(vkGetPhysicalDeviceCooperativeMatrixFlexibleDimensionsPropertiesNV(
+                physicalDevice, &numProperties, nullptr),
+                "vkGetPhysicalDeviceCooperativeMatrixFlexibleDimensionsPropertiesNV");
+        std::vector<VkCooperativeMatrixFlexibleDimensionsPropertiesNV> vkProperties(numProperties);
+        for (auto& props : vkProperties) {
+            props.sType = VK_STRUCTURE_TYPE_COOPERATIVE_MATRIX_FLEXIBLE_DIMENSIONS_PROPERTIES_NV;
+        }
+        checkVkResult(vkGetPhysicalDeviceCooperativeMatrixFlexibleDimensionsPropertiesNV(
+                physicalDevice, &numProperties, vkProperties.data()),
+                "vkGetPhysicalDeviceCooperativeMatrixFlexibleDimensionsPropertiesNV");
+        std::vector<QvcmCooperativeMatrixFlexibleDimensionsProperties> allProperties;
+        for (const auto& props : vkProperties) {
+            allProperties.push_back({
+                    props.MGranularity, props.NGranularity, props.KGranularity, props.AType, props.BType,
+                    props.CType, props.ResultType, props.saturatingAccumulation, props.scope,
+                    props.workgroupInvocations });
+        }
+        return copyArray(allProperties, count, properties);
+    });
+}
+
+QvcmResult qvcmGetCooperativeVectorFeatures(
+        QvcmContext context, VkPhysicalDevice physicalDevice, QvcmCooperativeVectorFeatures* features) {
+    return callApi(context, [&]() {
+        checkArgument(physicalDevice && features, "physicalDevice and features must not be NULL.");
+        loadInstanceFunctions(context->vkInstance);
+        *features = {};
+        if (!getIsDeviceExtensionSupported(physicalDevice, VK_NV_COOPERATIVE_VECTOR_EXTENSION_NAME)) {
+            return QVCM_SUCCESS;
+        }
+        VkPhysicalDeviceCooperativeVectorFeaturesNV vkFeatures{};
+        vkFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_COOPERATIVE_VECTOR_FEATURES_NV;
+        VkPhysicalDeviceFeatures2 features2{};
+        features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        features2.pNext = &vkFeatures;
+        vkGetPhysicalDeviceFeatures2(physicalDevice, &features2);
+        VkPhysicalDeviceCooperativeVectorPropertiesNV vkProperties{};
+        vkProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_COOPERATIVE_VECTOR_PROPERTIES_NV;
+        VkPhysicalDeviceProperties2 properties2{};
+        properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+        properties2.pNext = &vkProperties;
+        vkGetPhysicalDeviceProperties2(physicalDevice, &properties2);
+
+        features->isSupported = VK_TRUE;
+        features->cooperativeVector = vkFeatures.cooperativeVector;
+        features->cooperativeVectorTraining = vkFeatures.cooperativeVectorTraining;
+        features->cooperativeVectorSupportedStages = vkProperties.cooperativeVectorSupportedStages;
+        features->cooperativeVectorTrainingFloat16Accumulation =
+                vkProperties.cooperativeVectorTrainingFloat16Accumulation;
+        features->cooperativeVectorTrainingFloat32Accumulation =
+                vkProperties.cooperativeVectorTrainingFloat32Accumulation;
+        features->maxCooperativeVectorComponents = vkProperties.maxCooperativeVectorComponents;
+        return QVCM_SUCCESS;
+    });
+}
+
+QvcmResult qvcmGetCooperativeVectorProperties(
+        QvcmContext context, VkPhysicalDevice physicalDevice, uint32_t* count,
+        QvcmCooperativeVectorProperties* properties) {
+    return callApi(context, [&]() {
+        loadInstanceFunctions(context->vkInstance);
+        if (!getIsDeviceExtensionSupported(physicalDevice, VK_NV_COOPERATIVE_VECTOR_EXTENSION_NAME)) {
+            throw QvcmError(QVCM_ERROR_NOT_SUPPORTED, "VK_NV_cooperative_vector is not supported.");
+        }
+        uint32_t numProperties = 0;
+        checkVkResult(vkGetPhysicalDeviceCooperativeVectorPropertiesNV(
+                physicalDevice, &numProperties, nullptr), "vkGetPhysicalDeviceCooperativeVectorPropertiesNV");
+        std::vector<VkCooperativeVectorPropertiesNV> vkProperties(numProperties);
+        for (auto& props : vkProperties) {
+            props.sType = VK_STRUCTURE_TYPE_COOPERATIVE_VECTOR_PROPERTIES_NV;
+        }
+        checkVkResult(vkGetPhysicalDeviceCooperativeVectorPropertiesNV(
+                physicalDevice, &numProperties, vkProperties.data()),
+                "vkGetPhysicalDeviceCooperativeVectorPropertiesNV");
+        std::vector<QvcmCooperativeVectorProperties> allProperties;
+        for (const auto& props : vkProperties) {
+            allProperties.push_back({
+                    props.inputType, props.inputInterpretation, props.matrixInterpretation,
+                    props.biasInterpretation, props.resultType, props.transpose });
+        }
+        return copyArray(allProperties, count, properties);
+    });
+}
+
+QvcmResult qvcmGetMemoryHeaps(
+        QvcmContext context, VkPhysicalDevice physicalDevice, uint32_t* count, QvcmMemoryHeap* heaps) {
+    return callApi(context, [&]() {
+        checkArgument(physicalDevice != VK_NULL_HANDLE, "physicalDevice must not be VK_NULL_HANDLE.");
+        loadInstanceFunctions(context->vkInstance);
+        VkPhysicalDeviceMemoryProperties memoryProperties{};
+        vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memoryProperties);
+        std::vector<QvcmMemoryHeap> allHeaps;
+        for (uint32_t heapIdx = 0; heapIdx < memoryProperties.memoryHeapCount; heapIdx++) {
+            const VkMemoryHeap& heap = memoryProperties.memoryHeaps[heapIdx];
+            allHeaps.push_back({ heap.size, heap.flags });
+        }
+        return copyArray(allHeaps, count, heaps);
+    });
+}
+
+QvcmResult qvcmRunGemmBenchmark(
+        QvcmContext context, VkPhysicalDevice physicalDevice, const QvcmGemmBenchmarkSettings* settings,
+        QvcmGemmBenchmarkResult* result) {
+    return callApi(context, [&]() {
+        checkArgument(physicalDevice && settings && result, "physicalDevice, settings and result must not be NULL.");
+        sgl::vk::Device* device = getBenchmarkDevice(context, physicalDevice);
+
+        CoopMatGemmSettings gemmSettings;
+        gemmSettings.AType = settings->AType;
+        gemmSettings.BType = settings->BType;
+        gemmSettings.CType = settings->CType;
+        gemmSettings.ResultType = settings->ResultType;
+        gemmSettings.lM = settings->lM;
+        gemmSettings.lN = settings->lN;
+        gemmSettings.lK = settings->lK;
+        gemmSettings.saturatingAccumulation = settings->saturatingAccumulation != VK_FALSE;
+        gemmSettings.scope = settings->scope;
+        gemmSettings.workgroupInvocations = settings->workgroupInvocations;
+        gemmSettings.M = settings->M;
+        gemmSettings.N = settings->N;
+        gemmSettings.K = settings->K;
+        std::string unsupportedReason = CoopMatGemm::checkSupport(device, gemmSettings);
+        if (!unsupportedReason.empty()) {
+            throw QvcmError(QVCM_ERROR_NOT_SUPPORTED, unsupportedReason);
+        }
+
+        CommandContext commandContext(device);
+        CoopMatGemm gemm(device, commandContext, gemmSettings);
+        CommandTiming timing = measureCommands(commandContext, [&gemm](VkCommandBuffer commandBuffer) {
+            gemm.recordDispatch(commandBuffer);
+        });
+        // There are no result tables the summary could be printed with.
+        takeBenchmarkRunnerSummary();
+
+        *result = {};
+        result->M = gemm.getSettings().M;
+        result->N = gemm.getSettings().N;
+        result->K = gemm.getSettings().K;
+        result->medianMs = timing.getMs();
+        result->teraOpsPerSecond = gemm.getNumOperations() / (result->medianMs * 1e9);
+        result->ciLowMs = timing.statistics.ciLow;
+        result->ciHighMs = timing.statistics.ciHigh;
+        result->numSamples = timing.statistics.numSamples;
+        result->hasGpuTime = timing.hasGpuTime ? VK_TRUE : VK_FALSE;
+        result->isUnstable = timing.statistics.getIsUnstable() ? VK_TRUE : VK_FALSE;
+        return QVCM_SUCCESS;
+    });
+}
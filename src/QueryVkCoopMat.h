@@ -0,0 +1,210 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef QUERYVKCOOPMAT_QUERYVKCOOPMAT_H
+#define QUERYVKCOOPMAT_QUERYVKCOOPMAT_H
+
+/*
+ * C API of libqueryvkcoopmat for querying cooperative matrix/vector support and running benchmarks in-process.
+ *
+ * Arrays are returned with the usual Vulkan two-call idiom: if the output pointer is NULL, the number of elements is
+ * written to *count; otherwise, at most *count elements are written, *count is set to the number written and
+ * QVCM_INCOMPLETE is returned if not all elements fit.
+ */
+
+#include <stdint.h>
+#include <vulkan/vulkan.h>
+
+#if defined(QUERYVKCOOPMAT_SHARED)
+#if defined(_WIN32)
+#if defined(QUERYVKCOOPMAT_EXPORTS)
+#define QVCM_API __declspec(dllexport)
+#else
+#define QVCM_API __declspec(dllimport)
+#endif
+#else
+#define QVCM_API __attribute__((visibility("default")))
+#endif
+#else
+#define QVCM_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define QVCM_MAX_NAME_SIZE 256
+#define QVCM_UUID_SIZE 16
+
+typedef enum QvcmResult {
+    QVCM_SUCCESS = 0,
+    QVCM_INCOMPLETE = 1,
+    QVCM_ERROR_INVALID_ARGUMENT = -1,
+    QVCM_ERROR_VULKAN = -2, /* A Vulkan call failed (e.g., no Vulkan loader). */
+    QVCM_ERROR_NOT_SUPPORTED = -3, /* The extension or kernel variant is not supported by the device. */
+    QVCM_ERROR_INTERNAL = -4
+} QvcmResult;
+
+typedef struct QvcmContext_T* QvcmContext;
+
+typedef struct QvcmContextCreateInfo {
+    /*
+     * Instance of the caller (created with Vulkan 1.1 or newer) whose physical devices are queried. If it is
+     * VK_NULL_HANDLE, the library creates its own instance.
+     */
+    VkInstance instance;
+} QvcmContextCreateInfo;
+
+typedef struct QvcmDeviceIdentity {
+    char deviceName[QVCM_MAX_NAME_SIZE];
+    char driverName[QVCM_MAX_NAME_SIZE]; /* Empty for devices older than Vulkan 1.2. */
+    char driverInfo[QVCM_MAX_NAME_SIZE];
+    uint32_t apiVersion;
+    uint32_t driverVersion;
+    uint32_t vendorID;
+    uint32_t deviceID;
+    VkPhysicalDeviceType deviceType;
+    VkDriverId driverID;
+    uint8_t deviceUUID[QVCM_UUID_SIZE];
+    uint8_t driverUUID[QVCM_UUID_SIZE];
+} QvcmDeviceIdentity;
+
+/* VkCooperativeMatrixPropertiesKHR without sType and pNext. */
+typedef struct QvcmCooperativeMatrixProperties {
+    uint32_t MSize, NSize, KSize;
+    VkComponentTypeKHR AType, BType, CType, ResultType;
+    VkBool32 saturatingAccumulation;
+    VkScopeKHR scope;
+} QvcmCooperativeMatrixProperties;
+
+typedef struct QvcmCooperativeMatrix2Features {
+    VkBool32 isSupported; /* VK_NV_cooperative_matrix2; all other members are zero if unsupported. */
+    VkBool32 cooperativeMatrixWorkgroupScope;
+    VkBool32 cooperativeMatrixFlexibleDimensions;
+    VkBool32 cooperativeMatrixReductions;
+    VkBool32 cooperativeMatrixConversions;
+    VkBool32 cooperativeMatrixPerElementOperations;
+    VkBool32 cooperativeMatrixTensorAddressing;
+    VkBool32 cooperativeMatrixBlockLoads;
+    uint32_t cooperativeMatrixWorkgroupScopeMaxWorkgroupSize;
+    uint32_t cooperativeMatrixFlexibleDimensionsMaxDimension;
+    uint32_t cooperativeMatrixWorkgroupScopeReservedSharedMemory;
+} QvcmCooperativeMatrix2Features;
+
+/* VkCooperativeMatrixFlexibleDimensionsPropertiesNV without sType and pNext. */
+typedef struct QvcmCooperativeMatrixFlexibleDimensionsProperties {
+    uint32_t MGranularity, NGranularity, KGranularity;
+    VkComponentTypeKHR AType, BType, CType, ResultType;
+    VkBool32 saturatingAccumulation;
+    VkScopeKHR scope;
+    uint32_t workgroupInvocations;
+} QvcmCooperativeMatrixFlexibleDimensionsProperties;
+
+typedef struct QvcmCooperativeVectorFeatures {
+    VkBool32 isSupported; /* VK_NV_cooperative_vector; all other members are zero if unsupported. */
+    VkBool32 cooperativeVector;
+    VkBool32 cooperativeVectorTraining;
+    VkShaderStageFlags cooperativeVectorSupportedStages;
+    VkBool32 cooperativeVectorTrainingFloat16Accumulation;
+    VkBool32 cooperativeVectorTrainingFloat32Accumulation;
+    uint32_t maxCooperativeVectorComponents;
+} QvcmCooperativeVectorFeatures;
+
+/* VkCooperativeVectorPropertiesNV without sType and pNext. */
+typedef struct QvcmCooperativeVectorProperties {
+    VkComponentTypeKHR inputType, inputInterpretation, matrixInterpretation, biasInterpretation, resultType;
+    VkBool32 transpose;
+} QvcmCooperativeVectorProperties;
+
+typedef struct QvcmMemoryHeap {
+    VkDeviceSize size;
+    VkMemoryHeapFlags flags;
+} QvcmMemoryHeap;
+
+/* GEMM D = A * B + C with the CoopMatGemm kernel used by the benchmark modes of the command line tool. */
+typedef struct QvcmGemmBenchmarkSettings {
+    VkComponentTypeKHR AType, BType, CType, ResultType;
+    uint32_t lM, lN, lK; /* MSize/NSize/KSize, or the granularities for flexible dimensions. */
+    VkBool32 saturatingAccumulation;
+    VkScopeKHR scope; /* VK_SCOPE_WORKGROUP_KHR uses VK_NV_cooperative_matrix2. */
+    uint32_t workgroupInvocations; /* For VK_SCOPE_WORKGROUP_KHR. */
+    uint32_t M, N, K; /* Rounded up to multiples of the tile sizes. */
+} QvcmGemmBenchmarkSettings;
+
+typedef struct QvcmGemmBenchmarkResult {
+    uint32_t M, N, K; /* Problem size after rounding up. */
+    double teraOpsPerSecond;
+    double medianMs;
+    double ciLowMs, ciHighMs; /* 95% confidence interval of the median. */
+    uint32_t numSamples;
+    VkBool32 hasGpuTime; /* Timestamp queries were used; otherwise, the times include the submission overhead. */
+    VkBool32 isUnstable; /* The warm-up did not converge or the confidence interval target was not reached. */
+} QvcmGemmBenchmarkResult;
+
+QVCM_API QvcmResult qvcmCreateContext(const QvcmContextCreateInfo* createInfo, QvcmContext* context);
+QVCM_API void qvcmDestroyContext(QvcmContext context);
+/* Message of the last error returned for the context; valid until the next call with the context. */
+QVCM_API const char* qvcmGetLastErrorMessage(QvcmContext context);
+
+QVCM_API QvcmResult qvcmEnumeratePhysicalDevices(
+        QvcmContext context, uint32_t* count, VkPhysicalDevice* physicalDevices);
+QVCM_API QvcmResult qvcmGetDeviceIdentity(
+        QvcmContext context, VkPhysicalDevice physicalDevice, QvcmDeviceIdentity* identity);
+/* Returns QVCM_ERROR_NOT_SUPPORTED if VK_KHR_cooperative_matrix is not supported. */
+QVCM_API QvcmResult qvcmGetCooperativeMatrixProperties(
+        QvcmContext context, VkPhysicalDevice physicalDevice, uint32_t* count,
+        QvcmCooperativeMatrixProperties* properties);
+QVCM_API QvcmResult qvcmGetCooperativeMatrix2Features(
+        QvcmContext context, VkPhysicalDevice physicalDevice, QvcmCooperativeMatrix2Features* features);
+/* Returns QVCM_ERROR_NOT_SUPPORTED if VK_NV_cooperative_matrix2 is not supported. */
+QVCM_API QvcmResult qvcmGetCooperativeMatrixFlexibleDimensionsProperties(
+        QvcmContext context, VkPhysicalDevice physicalDevice, uint32_t* count,
+        QvcmCooperativeMatrixFlexibleDimensionsProperties* properties);
+QVCM_API QvcmResult qvcmGetCooperativeVectorFeatures(
+        QvcmContext context, VkPhysicalDevice physicalDevice, QvcmCooperativeVectorFeatures* features);
+/* Returns QVCM_ERROR_NOT_SUPPORTED if VK_NV_cooperative_vector is not supported. */
+QVCM_API QvcmResult qvcmGetCooperativeVectorProperties(
+        QvcmContext context, VkPhysicalDevice physicalDevice, uint32_t* count,
+        QvcmCooperativeVectorProperties* properties);
+QVCM_API QvcmResult qvcmGetMemoryHeaps(
+        QvcmContext context, VkPhysicalDevice physicalDevice, uint32_t* count, QvcmMemoryHeap* heaps);
+
+/*
+ * Runs the GEMM benchmark on a device created by the library for the physical device. For contexts with an instance
+ * of the caller, the library creates its own instance for running benchmarks on first use and picks the physical
+ * device with the same UUID.
+ */
+QVCM_API QvcmResult qvcmRunGemmBenchmark(
+        QvcmContext context, VkPhysicalDevice physicalDevice, const QvcmGemmBenchmarkSettings* settings,
+        QvcmGemmBenchmarkResult* result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* QUERYVKCOOPMAT_QUERYVKCOOPMAT_H */
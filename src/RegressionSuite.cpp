@@ -0,0 +1,498 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <initializer_list>
+#include <map>
+#include <stdexcept>
+
+#include <Utils/File/Logfile.hpp>
+
+#include "BenchmarkRunner.hpp"
+#include "JsonReader.hpp"
+#include "JsonWriter.hpp"
+#include "PrintUtils.hpp"
+#include "RegressionSuite.hpp"
+
+static const int64_t REGRESSION_FORMAT_VERSION = 1;
+static const uint32_t DEFAULT_PROBLEM_SIZE_DIVISOR = 16;
+
+struct RegressionTable {
+    std::vector<std::string> columnNames;
+    std::vector<std::vector<std::string>> rows;
+};
+
+struct RegressionModeResult {
+    std::string name; ///< Mode name, followed by " #<device index>" for per-device modes.
+    double timeMs = 0.0;
+    std::vector<RegressionTable> tables;
+};
+
+struct RegressionRun {
+    bool isActive = false;
+    uint32_t problemSizeDivisor = DEFAULT_PROBLEM_SIZE_DIVISOR;
+    RegressionTolerances tolerances;
+    std::map<std::string, RegressionTolerances> modeTolerances;
+    std::map<std::string, std::string> deviceNames;
+    std::string currentDeviceKey;
+    /// Index into modeResults, or -1 outside of a RegressionModeScope.
+    ptrdiff_t currentModeIdx = -1;
+    std::vector<RegressionModeResult> modeResults;
+};
+static RegressionRun regressionRun;
+
+static void readTolerances(const JsonValue& value, RegressionTolerances& tolerances) {
+    if (const JsonValue* member = value.findMember("relativeValue")) {
+        tolerances.relativeValue = member->getDouble();
+    }
+    if (const JsonValue* member = value.findMember("absoluteValue")) {
+        tolerances.absoluteValue = member->getDouble();
+    }
+    if (const JsonValue* member = value.findMember("relativeError")) {
+        tolerances.relativeError = member->getDouble();
+    }
+    if (const JsonValue* member = value.findMember("relativeTime")) {
+        tolerances.relativeTime = member->getDouble();
+    }
+}
+
+static void writeTolerances(JsonWriter& writer, const RegressionTolerances& tolerances) {
+    writer.beginObject();
+    writer.keyValue("relativeValue", tolerances.relativeValue);
+    writer.keyValue("absoluteValue", tolerances.absoluteValue);
+    writer.keyValue("relativeError", tolerances.relativeError);
+    writer.keyValue("relativeTime", tolerances.relativeTime);
+    writer.endObject();
+}
+
+void beginRegressionRun(const std::string& baselineFilePath) {
+    regressionRun = RegressionRun();
+    regressionRun.isActive = true;
+    if (std::filesystem::exists(baselineFilePath)) {
+        try {
+            JsonValue baseline = loadJsonFile(baselineFilePath);
+            if (const JsonValue* member = baseline.findMember("problemSizeDivisor")) {
+                regressionRun.problemSizeDivisor = uint32_t(std::max(member->getInt64(), int64_t(1)));
+            }
+            if (const JsonValue* member = baseline.findMember("tolerances")) {
+                readTolerances(*member, regressionRun.tolerances);
+            }
+            if (const JsonValue* member = baseline.findMember("modeTolerances")) {
+                const auto& modeNames = member->getMemberNames();
+                for (size_t i = 0; i < modeNames.size(); i++) {
+                    RegressionTolerances modeTolerances = regressionRun.tolerances;
+                    readTolerances(member->at(i), modeTolerances);
+                    regressionRun.modeTolerances[modeNames.at(i)] = modeTolerances;
+                }
+            }
+        } catch (const std::exception& e) {
+            sgl::Logfile::get()->writeError(std::string() + "Error in beginRegressionRun: " + e.what(), false);
+        }
+    }
+
+    // One warm-up and three measured samples suffice for catching regressions and keep software drivers fast.
+    BenchmarkRunnerSettings settings = getBenchmarkRunnerSettings();
+    settings.problemSizeDivisor = regressionRun.problemSizeDivisor;
+    settings.numWarmupWindowSamples = 1;
+    settings.maxWarmupSamples = 1;
+    settings.minSamples = 3;
+    settings.maxSamples = 3;
+    setBenchmarkRunnerSettings(settings);
+    writeOut("Regression run with problem sizes divided by ", regressionRun.problemSizeDivisor, ".");
+}
+
+bool getIsRegressionRunActive() {
+    return regressionRun.isActive;
+}
+
+void setRegressionDevice(size_t deviceIdx, const std::string& deviceName) {
+    if (!regressionRun.isActive) {
+        return;
+    }
+    regressionRun.currentDeviceKey = "#" + std::to_string(deviceIdx);
+    regressionRun.deviceNames[regressionRun.currentDeviceKey] = deviceName;
+}
+
+void clearRegressionDevice() {
+    regressionRun.currentDeviceKey.clear();
+}
+
+void recordRegressionTable(
+        const std::vector<std::string>& columnNames, const std::vector<std::vector<std::string>>& rows) {
+    if (!regressionRun.isActive || regressionRun.currentModeIdx < 0) {
+        return;
+    }
+    regressionRun.modeResults.at(regressionRun.currentModeIdx).tables.push_back(RegressionTable{ columnNames, rows });
+}
+
+RegressionModeScope::RegressionModeScope(const std::string& modeName) : isActive(regressionRun.isActive) {
+    if (!isActive) {
+        return;
+    }
+    RegressionModeResult modeResult;
+    modeResult.name = modeName;
+    if (!regressionRun.currentDeviceKey.empty()) {
+        modeResult.name += " " + regressionRun.currentDeviceKey;
+    }
+    regressionRun.currentModeIdx = ptrdiff_t(regressionRun.modeResults.size());
+    regressionRun.modeResults.push_back(modeResult);
+    startTime = std::chrono::steady_clock::now();
+}
+
+RegressionModeScope::~RegressionModeScope() {
+    if (!isActive) {
+        return;
+    }
+    auto endTime = std::chrono::steady_clock::now();
+    regressionRun.modeResults.at(regressionRun.currentModeIdx).timeMs =
+            std::chrono::duration<double, std::milli>(endTime - startTime).count();
+    regressionRun.currentModeIdx = -1;
+}
+
+static std::string getModeBaseName(const std::string& modeName) {
+    auto pos = modeName.find(" #");
+    return pos == std::string::npos ? modeName : modeName.substr(0, pos);
+}
+
+static const RegressionTolerances& getModeTolerances(const std::string& modeName) {
+    auto it = regressionRun.modeTolerances.find(getModeBaseName(modeName));
+    return it == regressionRun.modeTolerances.end() ? regressionRun.tolerances : it->second;
+}
+
+/// How the numbers in the cells of a result table column are compared with the baseline.
+enum class RegressionColumnKind {
+    OTHER, ///< Symmetric tolerance (e.g., occupancy, predictions, ratios).
+    HIGHER_IS_BETTER, ///< Throughput and speedups; only decreases can fail.
+    LOWER_IS_BETTER, ///< Times; only increases can fail.
+    CORRECTNESS ///< Errors and counts of wrong or clamped results; tight relative tolerance.
+};
+
+static bool getContainsAny(const std::string& text, std::initializer_list<const char*> patterns) {
+    for (const char* pattern : patterns) {
+        if (text.find(pattern) != std::string::npos) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/// Uses the column name (e.g., "Max rel. err.", "Upload (ms)") and otherwise the unit of the cell (e.g., "TOP/s").
+static RegressionColumnKind getColumnKind(const std::string& columnName, const std::string& unit) {
+    std::string name = columnName;
+    std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return char(std::tolower(c)); });
+    if (getContainsAny(name, { "err", "ulp", "mismatch", "overflowed", "saturated", "wrapped", "non-finite",
+                               "within bounds" })) {
+        return RegressionColumnKind::CORRECTNESS;
+    }
+    if (getContainsAny(name, { "(ms)", " ms", "(us)", "time", "latency" })) {
+        return RegressionColumnKind::LOWER_IS_BETTER;
+    }
+    if (getContainsAny(name, { "/s", "speedup" })) {
+        return RegressionColumnKind::HIGHER_IS_BETTER;
+    }
+    // Unit-less throughput columns, where the unit is only given in the caption of the table (e.g., "TOP/s" of the
+    // wrapping and saturating accumulation). Their relative "Delta" is an intentionally symmetric comparison.
+    if (name == "wrapping" || name == "saturating") {
+        return RegressionColumnKind::HIGHER_IS_BETTER;
+    }
+    if (name == "delta") {
+        return RegressionColumnKind::OTHER;
+    }
+    std::string trimmedUnit = unit;
+    trimmedUnit.erase(0, trimmedUnit.find_first_not_of(' '));
+    if (trimmedUnit.size() >= 2 && trimmedUnit.compare(trimmedUnit.size() - 2, 2, "/s") == 0) {
+        return RegressionColumnKind::HIGHER_IS_BETTER;
+    }
+    if (trimmedUnit == "ms" || trimmedUnit == "us" || trimmedUnit == "ns" || trimmedUnit == "s") {
+        return RegressionColumnKind::LOWER_IS_BETTER;
+    }
+    return RegressionColumnKind::OTHER;
+}
+
+/**
+ * Cells like "12.34 TFLOP/s" or "1.05x" are compared numerically if the rest of the cell matches and contains no
+ * further numbers; everything else (e.g., "yes", "16x16x16") needs to match exactly.
+ */
+static bool getAreCellsEqual(
+        const std::string& cell, const std::string& baselineCell, const std::string& columnName,
+        const RegressionTolerances& tolerances) {
+    if (cell == baselineCell) {
+        return true;
+    }
+    char* cellEnd = nullptr;
+    char* baselineCellEnd = nullptr;
+    double value = std::strtod(cell.c_str(), &cellEnd);
+    double baselineValue = std::strtod(baselineCell.c_str(), &baselineCellEnd);
+    if (cellEnd == cell.c_str() || baselineCellEnd == baselineCell.c_str()) {
+        return false;
+    }
+    std::string suffix = cellEnd;
+    if (suffix != baselineCellEnd || suffix.find_first_of("0123456789") != std::string::npos) {
+        return false;
+    }
+    if (std::isnan(value) || std::isnan(baselineValue)) {
+        return std::isnan(value) && std::isnan(baselineValue);
+    }
+    double tolerance = tolerances.relativeValue * std::abs(baselineValue) + tolerances.absoluteValue;
+    switch (getColumnKind(columnName, suffix)) {
+        case RegressionColumnKind::HIGHER_IS_BETTER:
+            return value >= baselineValue - tolerance;
+        case RegressionColumnKind::LOWER_IS_BETTER:
+            return value <= baselineValue + tolerance;
+        case RegressionColumnKind::CORRECTNESS:
+            return std::abs(value - baselineValue) <= tolerances.relativeError * std::abs(baselineValue);
+        default:
+            return std::abs(value - baselineValue) <= tolerance;
+    }
+}
+
+static std::string joinCells(const std::vector<std::string>& cells) {
+    std::string text;
+    for (size_t i = 0; i < cells.size(); i++) {
+        if (i != 0) {
+            text += " | ";
+        }
+        text += cells.at(i);
+    }
+    return text;
+}
+
+static std::vector<std::string> readStrings(const JsonValue& value) {
+    std::vector<std::string> strings;
+    for (const JsonValue& element : value.getElements()) {
+        strings.push_back(element.getString());
+    }
+    return strings;
+}
+
+static RegressionModeResult readModeResult(const JsonValue& value) {
+    RegressionModeResult modeResult;
+    modeResult.name = value.at("name").getString();
+    modeResult.timeMs = value.at("timeMs").getDouble();
+    for (const JsonValue& tableValue : value.at("tables").getElements()) {
+        RegressionTable table;
+        table.columnNames = readStrings(tableValue.at("columns"));
+        for (const JsonValue& rowValue : tableValue.at("rows").getElements()) {
+            table.rows.push_back(readStrings(rowValue));
+        }
+        modeResult.tables.push_back(table);
+    }
+    return modeResult;
+}
+
+static void compareModeResults(
+        const RegressionModeResult& modeResult, const RegressionModeResult& baselineResult,
+        std::vector<std::string>& failures) {
+    const RegressionTolerances& tolerances = getModeTolerances(modeResult.name);
+    const std::string& modeName = modeResult.name;
+    if (std::isfinite(baselineResult.timeMs)
+            && modeResult.timeMs > baselineResult.timeMs * (1.0 + tolerances.relativeTime)) {
+        failures.push_back(
+                modeName + ": took " + formatNumber(modeResult.timeMs, 1) + " ms instead of "
+                + formatNumber(baselineResult.timeMs, 1) + " ms.");
+    }
+    if (modeResult.tables.size() != baselineResult.tables.size()) {
+        failures.push_back(
+                modeName + ": printed " + std::to_string(modeResult.tables.size()) + " tables instead of "
+                + std::to_string(baselineResult.tables.size()) + ".");
+        return;
+    }
+    for (size_t tableIdx = 0; tableIdx < modeResult.tables.size(); tableIdx++) {
+        const RegressionTable& table = modeResult.tables.at(tableIdx);
+        const RegressionTable& baselineTable = baselineResult.tables.at(tableIdx);
+        std::string tableName = modeName + ", table " + std::to_string(tableIdx + 1);
+        if (table.columnNames != baselineTable.columnNames) {
+            failures.push_back(
+                    tableName + ": columns \"" + joinCells(table.columnNames) + "\" instead of \""
+                    + joinCells(baselineTable.columnNames) + "\".");
+            continue;
+        }
+        if (table.rows.size() != baselineTable.rows.size()) {
+            failures.push_back(
+                    tableName + ": " + std::to_string(table.rows.size()) + " rows instead of "
+                    + std::to_string(baselineTable.rows.size()) + ".");
+            continue;
+        }
+        for (size_t rowIdx = 0; rowIdx < table.rows.size(); rowIdx++) {
+            const std::vector<std::string>& row = table.rows.at(rowIdx);
+            const std::vector<std::string>& baselineRow = baselineTable.rows.at(rowIdx);
+            bool isRowEqual = row.size() == baselineRow.size();
+            for (size_t colIdx = 0; isRowEqual && colIdx < row.size(); colIdx++) {
+                const std::string& columnName =
+                        colIdx < table.columnNames.size() ? table.columnNames.at(colIdx) : std::string();
+                isRowEqual = getAreCellsEqual(row.at(colIdx), baselineRow.at(colIdx), columnName, tolerances);
+            }
+            if (!isRowEqual) {
+                failures.push_back(
+                        tableName + ", row " + std::to_string(rowIdx + 1) + ": \"" + joinCells(row)
+                        + "\" instead of \"" + joinCells(baselineRow) + "\".");
+            }
+        }
+    }
+}
+
+/// The benchmark modes write "failed" into the cells of measurements that threw an exception.
+static void checkFailedCells(const RegressionModeResult& modeResult, std::vector<std::string>& failures) {
+    for (size_t tableIdx = 0; tableIdx < modeResult.tables.size(); tableIdx++) {
+        for (const std::vector<std::string>& row : modeResult.tables.at(tableIdx).rows) {
+            for (const std::string& cell : row) {
+                if (cell == "failed") {
+                    failures.push_back(
+                            modeResult.name + ", table " + std::to_string(tableIdx + 1) + ": \""
+                            + joinCells(row) + "\" contains failed measurements.");
+                    break;
+                }
+            }
+        }
+    }
+}
+
+static void writeRegressionResults(JsonWriter& writer) {
+    writer.beginObject();
+    writer.keyValue("regressionFormatVersion", REGRESSION_FORMAT_VERSION);
+    writer.keyValue("problemSizeDivisor", regressionRun.problemSizeDivisor);
+    writer.key("tolerances");
+    writeTolerances(writer, regressionRun.tolerances);
+    writer.key("modeTolerances");
+    writer.beginObject();
+    for (const auto& entry : regressionRun.modeTolerances) {
+        writer.key(entry.first);
+        writeTolerances(writer, entry.second);
+    }
+    writer.endObject();
+    writer.key("devices");
+    writer.beginObject();
+    for (const auto& entry : regressionRun.deviceNames) {
+        writer.keyValue(entry.first, entry.second);
+    }
+    writer.endObject();
+    writer.key("modes");
+    writer.beginArray();
+    for (const RegressionModeResult& modeResult : regressionRun.modeResults) {
+        writer.beginObject();
+        writer.keyValue("name", modeResult.name);
+        writer.keyValue("timeMs", modeResult.timeMs);
+        writer.key("tables");
+        writer.beginArray();
+        for (const RegressionTable& table : modeResult.tables) {
+            writer.beginObject();
+            writer.key("columns");
+            writer.beginArray();
+            for (const std::string& columnName : table.columnNames) {
+                writer.value(columnName);
+            }
+            writer.endArray();
+            writer.key("rows");
+            writer.beginArray();
+            for (const std::vector<std::string>& row : table.rows) {
+                writer.beginArray();
+                for (const std::string& cell : row) {
+                    writer.value(cell);
+                }
+                writer.endArray();
+            }
+            writer.endArray();
+            writer.endObject();
+        }
+        writer.endArray();
+        writer.endObject();
+    }
+    writer.endArray();
+    writer.endObject();
+}
+
+size_t finishRegressionRun(
+        const std::string& baselineFilePath, bool shallUpdateBaseline, const std::string& reportDirectory) {
+    regressionRun.isActive = false;
+    JsonWriter writer;
+    writeRegressionResults(writer);
+    std::error_code errorCode;
+    std::filesystem::create_directories(reportDirectory, errorCode);
+    const std::string resultsFilePath = (std::filesystem::path(reportDirectory) / "Regression.json").string();
+    if (!writer.save(resultsFilePath)) {
+        sgl::Logfile::get()->writeError("Error in finishRegressionRun: Could not write " + resultsFilePath, false);
+    }
+
+    std::vector<std::string> failures;
+    if (shallUpdateBaseline) {
+        for (const RegressionModeResult& modeResult : regressionRun.modeResults) {
+            checkFailedCells(modeResult, failures);
+        }
+        if (!failures.empty()) {
+            writeOut("Not updating the regression baseline, as measurements failed:");
+        } else if (!writer.save(baselineFilePath)) {
+            sgl::Logfile::get()->writeError(
+                    "Error in finishRegressionRun: Could not write " + baselineFilePath, false);
+            return 1;
+        } else {
+            writeOut("Wrote the regression baseline to ", baselineFilePath, ".");
+        }
+    } else if (!std::filesystem::exists(baselineFilePath)) {
+        failures.push_back("The baseline " + baselineFilePath + " does not exist (see --regression-update).");
+    } else {
+        try {
+            JsonValue baseline = loadJsonFile(baselineFilePath);
+            if (baseline.at("regressionFormatVersion").getInt64() != REGRESSION_FORMAT_VERSION) {
+                throw std::runtime_error("Unsupported regression format version.");
+            }
+            std::map<std::string, RegressionModeResult> baselineResults;
+            for (const JsonValue& modeValue : baseline.at("modes").getElements()) {
+                RegressionModeResult baselineResult = readModeResult(modeValue);
+                baselineResults[baselineResult.name] = baselineResult;
+            }
+            for (const RegressionModeResult& modeResult : regressionRun.modeResults) {
+                auto it = baselineResults.find(modeResult.name);
+                if (it == baselineResults.end()) {
+                    failures.push_back(modeResult.name + ": not in the baseline.");
+                    continue;
+                }
+                compareModeResults(modeResult, it->second, failures);
+                baselineResults.erase(it);
+            }
+            for (const auto& entry : baselineResults) {
+                failures.push_back(entry.first + ": in the baseline, but did not run.");
+            }
+        } catch (const std::exception& e) {
+            failures.push_back(std::string() + "Could not read the baseline " + baselineFilePath + ": " + e.what());
+        }
+    }
+
+    for (const std::string& failure : failures) {
+        writeOut("REGRESSION: ", failure);
+    }
+    if (!shallUpdateBaseline) {
+        writeOut(
+                "Regression run: ", regressionRun.modeResults.size(), " modes compared, ", failures.size(),
+                " failures (results in ", resultsFilePath, ").");
+    }
+    return failures.size();
+}
@@ -0,0 +1,87 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef QUERYVKCOOPMAT_REGRESSIONSUITE_HPP
+#define QUERYVKCOOPMAT_REGRESSIONSUITE_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// Allowed deviations from the baseline; the baseline file can override them globally and per benchmark mode.
+struct RegressionTolerances {
+    /// Numbers in result table cells may deviate by this fraction of the baseline value... Throughput may only
+    /// decrease and times may only increase by this much; improvements never fail.
+    double relativeValue = 0.5;
+    /// ... plus this absolute amount (most tables round to two digits).
+    double absoluteValue = 0.01;
+    /// Errors and counts of wrong results (e.g., "Max rel. err.", ULP histograms) may only deviate by this fraction
+    /// of the baseline value, such that a baseline of zero needs to be matched exactly.
+    double relativeError = 0.01;
+    /// The wall-clock time of a benchmark mode may grow by this fraction of the baseline time.
+    double relativeTime = 1.0;
+};
+
+/**
+ * Starts a regression run: All result tables printed by the benchmark modes and the wall-clock time of each mode are
+ * recorded until finishRegressionRun. The problem size divisor and the reduced sampling settings of the benchmark
+ * runner are taken from the baseline file if it exists (default divisor: 16).
+ */
+void beginRegressionRun(const std::string& baselineFilePath);
+bool getIsRegressionRunActive();
+
+/// The results of the following modes belong to this device (until clearRegressionDevice, e.g., for peer transfers).
+void setRegressionDevice(size_t deviceIdx, const std::string& deviceName);
+void clearRegressionDevice();
+
+/// Called by ResultTable::print.
+void recordRegressionTable(
+        const std::vector<std::string>& columnNames, const std::vector<std::vector<std::string>>& rows);
+
+/// Records the results of one benchmark mode (e.g., "subgroup-sizes") for the lifetime of the object.
+class RegressionModeScope {
+public:
+    explicit RegressionModeScope(const std::string& modeName);
+    ~RegressionModeScope();
+
+private:
+    bool isActive;
+    std::chrono::steady_clock::time_point startTime;
+};
+
+/**
+ * Writes the recorded results to Regression.json in the report directory and compares them with the baseline, or
+ * replaces the baseline by them if shallUpdateBaseline is set (unless a measurement failed). Returns the number of
+ * failures.
+ */
+size_t finishRegressionRun(
+        const std::string& baselineFilePath, bool shallUpdateBaseline, const std::string& reportDirectory);
+
+#endif //QUERYVKCOOPMAT_REGRESSIONSUITE_HPP
@@ -0,0 +1,28 @@
+/*
+ * Extensions and buffer types shared by the cooperative matrix kernels. The element types are selected with the
+ * defines A_TYPE, B_TYPE, C_TYPE and R_TYPE (see get_coopmat_type_defines in CMake/Kernels.cmake).
+ */
+
+#extension GL_KHR_cooperative_matrix : require
+#extension GL_KHR_memory_scope_semantics : require
+#extension GL_KHR_shader_subgroup_basic : require
+#extension GL_EXT_shader_explicit_arithmetic_types : require
+#extension GL_EXT_shader_8bit_storage : require
+#extension GL_EXT_shader_16bit_storage : require
+#extension GL_EXT_buffer_reference : require
+#extension GL_EXT_scalar_block_layout : require
+#ifdef USE_BFLOAT16
+#extension GL_EXT_bfloat16 : require
+#endif
+#ifdef USE_FLOAT_E4M3
+#extension GL_EXT_float_e4m3 : require
+#endif
+#ifdef USE_FLOAT_E5M2
+#extension GL_EXT_float_e5m2 : require
+#endif
+
+// All matrices are row-major and passed via buffer device addresses.
+layout(buffer_reference, scalar, buffer_reference_align = 16) buffer MatrixA { A_TYPE data[]; };
+layout(buffer_reference, scalar, buffer_reference_align = 16) buffer MatrixB { B_TYPE data[]; };
+layout(buffer_reference, scalar, buffer_reference_align = 16) buffer MatrixC { C_TYPE data[]; };
+layout(buffer_reference, scalar, buffer_reference_align = 16) buffer MatrixR { R_TYPE data[]; };
@@ -0,0 +1,217 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+
+#include "PrintUtils.hpp"
+#include "SvgPlot.hpp"
+
+static const double PLOT_WIDTH = 800.0;
+static const double PLOT_HEIGHT = 600.0;
+static const double MARGIN_LEFT = 90.0;
+static const double MARGIN_RIGHT = 40.0;
+static const double MARGIN_TOP = 50.0;
+static const double MARGIN_BOTTOM = 70.0;
+static const char* const POLYLINE_COLORS[] = { "#1f77b4", "#ff7f0e", "#2ca02c", "#d62728", "#9467bd", "#8c564b" };
+
+static std::string escapeXml(const std::string& text) {
+    std::string escaped;
+    for (char c : text) {
+        switch (c) {
+            case '<':
+                escaped += "&lt;";
+                break;
+            case '>':
+                escaped += "&gt;";
+                break;
+            case '&':
+                escaped += "&amp;";
+                break;
+            case '"':
+                escaped += "&quot;";
+                break;
+            default:
+                escaped += c;
+        }
+    }
+    return escaped;
+}
+
+SvgPlot::SvgPlot(std::string title, std::string xAxisLabel, std::string yAxisLabel, bool isLogX, bool isLogY)
+        : title(std::move(title)), xAxisLabel(std::move(xAxisLabel)), yAxisLabel(std::move(yAxisLabel)),
+          isLogX(isLogX), isLogY(isLogY) {
+}
+
+void SvgPlot::addPoint(double x, double y, const std::string& label, bool isHighlighted) {
+    points.push_back({ x, y, label, isHighlighted });
+}
+
+void SvgPlot::addPolyline(const std::vector<std::pair<double, double>>& linePoints, const std::string& label) {
+    polylines.push_back({ linePoints, label });
+}
+
+SvgPlot::AxisRange SvgPlot::computeRange(bool isXAxis) const {
+    bool isLog = isXAxis ? isLogX : isLogY;
+    double minValue = std::numeric_limits<double>::max();
+    double maxValue = std::numeric_limits<double>::lowest();
+    auto addValue = [&](double value) {
+        if (!std::isfinite(value) || (isLog && value <= 0.0)) {
+            return;
+        }
+        minValue = std::min(minValue, value);
+        maxValue = std::max(maxValue, value);
+    };
+    for (const auto& point : points) {
+        addValue(isXAxis ? point.x : point.y);
+    }
+    for (const auto& polyline : polylines) {
+        for (const auto& point : polyline.points) {
+            addValue(isXAxis ? point.first : point.second);
+        }
+    }
+    if (minValue > maxValue) {
+        return isLog ? AxisRange{ 1.0, 10.0 } : AxisRange{ 0.0, 1.0 };
+    }
+    if (isLog) {
+        minValue = std::pow(10.0, std::floor(std::log10(minValue)));
+        maxValue = std::pow(10.0, std::ceil(std::log10(maxValue)));
+        if (minValue == maxValue) {
+            maxValue *= 10.0;
+        }
+    } else {
+        minValue = std::min(minValue, 0.0);
+        if (minValue == maxValue) {
+            maxValue = minValue + 1.0;
+        }
+        maxValue *= 1.05;
+    }
+    return { minValue, maxValue };
+}
+
+bool SvgPlot::save(const std::string& filePath) const {
+    std::ofstream file(filePath);
+    if (!file.is_open()) {
+        return false;
+    }
+    const AxisRange rangeX = computeRange(true);
+    const AxisRange rangeY = computeRange(false);
+    const double innerWidth = PLOT_WIDTH - MARGIN_LEFT - MARGIN_RIGHT;
+    const double innerHeight = PLOT_HEIGHT - MARGIN_TOP - MARGIN_BOTTOM;
+    auto normalize = [](double value, const AxisRange& range, bool isLog) {
+        if (isLog) {
+            return (std::log10(value) - std::log10(range.min)) / (std::log10(range.max) - std::log10(range.min));
+        }
+        return (value - range.min) / (range.max - range.min);
+    };
+    auto toScreenX = [&](double x) { return MARGIN_LEFT + normalize(x, rangeX, isLogX) * innerWidth; };
+    auto toScreenY = [&](double y) { return MARGIN_TOP + (1.0 - normalize(y, rangeY, isLogY)) * innerHeight; };
+    auto isPlottable = [&](double x, double y) {
+        return std::isfinite(x) && std::isfinite(y) && (!isLogX || x > 0.0) && (!isLogY || y > 0.0);
+    };
+
+    file << "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"" << PLOT_WIDTH << "\" height=\"" << PLOT_HEIGHT
+         << "\" font-family=\"sans-serif\" font-size=\"12\">\n";
+    file << "<rect width=\"100%\" height=\"100%\" fill=\"white\"/>\n";
+    file << "<text x=\"" << PLOT_WIDTH / 2.0 << "\" y=\"25\" text-anchor=\"middle\" font-size=\"16\">"
+         << escapeXml(title) << "</text>\n";
+
+    // Axes with tick marks (powers of ten for logarithmic axes, ten steps otherwise).
+    file << "<rect x=\"" << MARGIN_LEFT << "\" y=\"" << MARGIN_TOP << "\" width=\"" << innerWidth << "\" height=\""
+         << innerHeight << "\" fill=\"none\" stroke=\"black\"/>\n";
+    auto writeTicks = [&](bool isXAxis) {
+        bool isLog = isXAxis ? isLogX : isLogY;
+        const AxisRange& range = isXAxis ? rangeX : rangeY;
+        std::vector<double> ticks;
+        if (isLog) {
+            for (double tick = range.min; tick <= range.max * 1.001; tick *= 10.0) {
+                ticks.push_back(tick);
+            }
+        } else {
+            for (int i = 0; i <= 10; i++) {
+                ticks.push_back(range.min + (range.max - range.min) * double(i) / 10.0);
+            }
+        }
+        for (double tick : ticks) {
+            std::string tickLabel = isLog ? "1e" + std::to_string(int(std::round(std::log10(tick))))
+                    : formatNumber(tick, std::abs(range.max - range.min) < 10.0 ? 2 : 0);
+            if (isXAxis) {
+                double x = toScreenX(tick);
+                file << "<line x1=\"" << x << "\" y1=\"" << MARGIN_TOP << "\" x2=\"" << x << "\" y2=\""
+                     << MARGIN_TOP + innerHeight << "\" stroke=\"#dddddd\"/>\n";
+                file << "<text x=\"" << x << "\" y=\"" << MARGIN_TOP + innerHeight + 18.0
+                     << "\" text-anchor=\"middle\">" << tickLabel << "</text>\n";
+            } else {
+                double y = toScreenY(tick);
+                file << "<line x1=\"" << MARGIN_LEFT << "\" y1=\"" << y << "\" x2=\"" << MARGIN_LEFT + innerWidth
+                     << "\" y2=\"" << y << "\" stroke=\"#dddddd\"/>\n";
+                file << "<text x=\"" << MARGIN_LEFT - 8.0 << "\" y=\"" << y + 4.0 << "\" text-anchor=\"end\">"
+                     << tickLabel << "</text>\n";
+            }
+        }
+    };
+    writeTicks(true);
+    writeTicks(false);
+    file << "<text x=\"" << MARGIN_LEFT + innerWidth / 2.0 << "\" y=\"" << PLOT_HEIGHT - 20.0
+         << "\" text-anchor=\"middle\">" << escapeXml(xAxisLabel) << "</text>\n";
+    file << "<text x=\"20\" y=\"" << MARGIN_TOP + innerHeight / 2.0 << "\" text-anchor=\"middle\" transform=\"rotate(-90 20 "
+         << MARGIN_TOP + innerHeight / 2.0 << ")\">" << escapeXml(yAxisLabel) << "</text>\n";
+
+    for (size_t lineIdx = 0; lineIdx < polylines.size(); lineIdx++) {
+        const auto& polyline = polylines.at(lineIdx);
+        const char* color = POLYLINE_COLORS[lineIdx % (sizeof(POLYLINE_COLORS) / sizeof(POLYLINE_COLORS[0]))];
+        file << "<polyline fill=\"none\" stroke=\"" << color << "\" stroke-width=\"2\" points=\"";
+        std::pair<double, double> lastPoint{};
+        for (const auto& point : polyline.points) {
+            if (isPlottable(point.first, point.second)) {
+                file << toScreenX(point.first) << "," << toScreenY(point.second) << " ";
+                lastPoint = point;
+            }
+        }
+        file << "\"/>\n";
+        if (isPlottable(lastPoint.first, lastPoint.second)) {
+            file << "<text x=\"" << toScreenX(lastPoint.first) - 4.0 << "\" y=\"" << toScreenY(lastPoint.second) - 6.0
+                 << "\" text-anchor=\"end\" fill=\"" << color << "\">" << escapeXml(polyline.label) << "</text>\n";
+        }
+    }
+    for (const auto& point : points) {
+        if (!isPlottable(point.x, point.y)) {
+            continue;
+        }
+        double x = toScreenX(point.x);
+        double y = toScreenY(point.y);
+        file << "<circle cx=\"" << x << "\" cy=\"" << y << "\" r=\"4\" fill=\""
+             << (point.isHighlighted ? "#d62728" : "#1f77b4") << "\"/>\n";
+        file << "<text x=\"" << x + 6.0 << "\" y=\"" << y - 6.0 << "\" font-size=\"10\">" << escapeXml(point.label)
+             << "</text>\n";
+    }
+    file << "</svg>\n";
+    return true;
+}
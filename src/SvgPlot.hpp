@@ -0,0 +1,68 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef QUERYVKCOOPMAT_SVGPLOT_HPP
+#define QUERYVKCOOPMAT_SVGPLOT_HPP
+
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * Minimal 2D plot written as a standalone SVG file, with optional logarithmic axes, labeled points and polylines.
+ */
+class SvgPlot {
+public:
+    SvgPlot(std::string title, std::string xAxisLabel, std::string yAxisLabel, bool isLogX, bool isLogY);
+    void addPoint(double x, double y, const std::string& label, bool isHighlighted = false);
+    void addPolyline(const std::vector<std::pair<double, double>>& points, const std::string& label);
+    /// Returns false if the file could not be written.
+    bool save(const std::string& filePath) const;
+
+private:
+    struct Point {
+        double x, y;
+        std::string label;
+        bool isHighlighted;
+    };
+    struct Polyline {
+        std::vector<std::pair<double, double>> points;
+        std::string label;
+    };
+    struct AxisRange {
+        double min, max;
+    };
+    [[nodiscard]] AxisRange computeRange(bool isXAxis) const;
+
+    std::string title, xAxisLabel, yAxisLabel;
+    bool isLogX, isLogY;
+    std::vector<Point> points;
+    std::vector<Polyline> polylines;
+};
+
+#endif //QUERYVKCOOPMAT_SVGPLOT_HPP
@@ -0,0 +1,490 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <map>
+#include <stdexcept>
+
+#include <Graphics/Vulkan/libs/volk/volk.h>
+
+#include "VulkanUtils.hpp"
+#include "GpuTimer.hpp"
+
+#define RES_TO_STR(r) case r: return #r
+
+const char* getVkResultString(VkResult result) {
+    switch (result) {
+        RES_TO_STR(VK_SUCCESS);
+        RES_TO_STR(VK_NOT_READY);
+        RES_TO_STR(VK_TIMEOUT);
+        RES_TO_STR(VK_INCOMPLETE);
+        RES_TO_STR(VK_ERROR_OUT_OF_HOST_MEMORY);
+        RES_TO_STR(VK_ERROR_OUT_OF_DEVICE_MEMORY);
+        RES_TO_STR(VK_ERROR_INITIALIZATION_FAILED);
+        RES_TO_STR(VK_ERROR_DEVICE_LOST);
+        RES_TO_STR(VK_ERROR_MEMORY_MAP_FAILED);
+        RES_TO_STR(VK_ERROR_LAYER_NOT_PRESENT);
+        RES_TO_STR(VK_ERROR_EXTENSION_NOT_PRESENT);
+        RES_TO_STR(VK_ERROR_FEATURE_NOT_PRESENT);
+        RES_TO_STR(VK_ERROR_INCOMPATIBLE_DRIVER);
+        RES_TO_STR(VK_ERROR_TOO_MANY_OBJECTS);
+        RES_TO_STR(VK_ERROR_FORMAT_NOT_SUPPORTED);
+        RES_TO_STR(VK_ERROR_FRAGMENTED_POOL);
+        RES_TO_STR(VK_ERROR_OUT_OF_POOL_MEMORY);
+        RES_TO_STR(VK_ERROR_INVALID_EXTERNAL_HANDLE);
+        RES_TO_STR(VK_ERROR_INVALID_OPAQUE_CAPTURE_ADDRESS);
+        RES_TO_STR(VK_ERROR_UNKNOWN);
+        default:
+            return "UNKNOWN";
+    }
+}
+
+void throwIfVkError(VkResult result, const std::string& callName) {
+    if (result != VK_SUCCESS) {
+        throw std::runtime_error(callName + " failed (" + getVkResultString(result) + ").");
+    }
+}
+
+void loadDeviceFunctions(VkDevice device) {
+    volkLoadDevice(device);
+}
+
+uint32_t findMemoryTypeIndex(
+        const VkPhysicalDeviceMemoryProperties& memoryProperties, uint32_t memoryTypeBits,
+        VkMemoryPropertyFlags requiredFlags) {
+    for (uint32_t memoryTypeIdx = 0; memoryTypeIdx < memoryProperties.memoryTypeCount; memoryTypeIdx++) {
+        if ((memoryTypeBits & (1u << memoryTypeIdx)) != 0
+                && (memoryProperties.memoryTypes[memoryTypeIdx].propertyFlags & requiredFlags) == requiredFlags) {
+            return memoryTypeIdx;
+        }
+    }
+    return UINT32_MAX;
+}
+
+DeviceBuffer createDeviceBuffer(
+        VkDevice device, const VkPhysicalDeviceMemoryProperties& memoryProperties, const BufferSettings& settings) {
+    DeviceBuffer deviceBuffer{};
+    deviceBuffer.size = settings.size;
+
+    VkBufferCreateInfo bufferCreateInfo{};
+    bufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferCreateInfo.pNext = settings.bufferCreateInfoNext;
+    bufferCreateInfo.size = settings.size;
+    bufferCreateInfo.usage = settings.usage;
+    bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    if (settings.queueFamilyIndices.size() > 1) {
+        bufferCreateInfo.sharingMode = VK_SHARING_MODE_CONCURRENT;
+        bufferCreateInfo.queueFamilyIndexCount = uint32_t(settings.queueFamilyIndices.size());
+        bufferCreateInfo.pQueueFamilyIndices = settings.queueFamilyIndices.data();
+    }
+    throwIfVkError(vkCreateBuffer(device, &bufferCreateInfo, nullptr, &deviceBuffer.buffer), "vkCreateBuffer");
+
+    VkMemoryRequirements memoryRequirements{};
+    vkGetBufferMemoryRequirements(device, deviceBuffer.buffer, &memoryRequirements);
+    deviceBuffer.memoryTypeIndex = findMemoryTypeIndex(
+            memoryProperties, memoryRequirements.memoryTypeBits & settings.memoryTypeBitsMask,
+            settings.memoryProperties);
+    if (deviceBuffer.memoryTypeIndex == UINT32_MAX) {
+        vkDestroyBuffer(device, deviceBuffer.buffer, nullptr);
+        throw std::runtime_error("createDeviceBuffer: No suitable memory type found.");
+    }
+
+    VkMemoryDedicatedAllocateInfo dedicatedAllocateInfo{};
+    dedicatedAllocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_ALLOCATE_INFO;
+    dedicatedAllocateInfo.pNext = settings.memoryAllocateInfoNext;
+    dedicatedAllocateInfo.buffer = deviceBuffer.buffer;
+
+    VkMemoryAllocateFlagsInfo allocateFlagsInfo{};
+    allocateFlagsInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO;
+    allocateFlagsInfo.pNext = settings.dedicatedAllocation ? &dedicatedAllocateInfo : settings.memoryAllocateInfoNext;
+    if ((settings.usage & VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT) != 0) {
+        allocateFlagsInfo.flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT;
+    }
+
+    VkMemoryAllocateInfo memoryAllocateInfo{};
+    memoryAllocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    memoryAllocateInfo.pNext = allocateFlagsInfo.flags != 0 ? (const void*)&allocateFlagsInfo : allocateFlagsInfo.pNext;
+    memoryAllocateInfo.allocationSize = memoryRequirements.size;
+    memoryAllocateInfo.memoryTypeIndex = deviceBuffer.memoryTypeIndex;
+    VkResult result = vkAllocateMemory(device, &memoryAllocateInfo, nullptr, &deviceBuffer.memory);
+    if (result != VK_SUCCESS) {
+        vkDestroyBuffer(device, deviceBuffer.buffer, nullptr);
+        throwIfVkError(result, "vkAllocateMemory");
+    }
+    result = vkBindBufferMemory(device, deviceBuffer.buffer, deviceBuffer.memory, 0);
+    if (result != VK_SUCCESS) {
+        destroyDeviceBuffer(device, deviceBuffer);
+        throwIfVkError(result, "vkBindBufferMemory");
+    }
+
+    if ((settings.memoryProperties & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0) {
+        result = vkMapMemory(device, deviceBuffer.memory, 0, VK_WHOLE_SIZE, 0, &deviceBuffer.mappedData);
+        if (result != VK_SUCCESS) {
+            destroyDeviceBuffer(device, deviceBuffer);
+            throwIfVkError(result, "vkMapMemory");
+        }
+    }
+
+    if ((settings.usage & VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT) != 0) {
+        VkBufferDeviceAddressInfo bufferDeviceAddressInfo{};
+        bufferDeviceAddressInfo.sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO;
+        bufferDeviceAddressInfo.buffer = deviceBuffer.buffer;
+        deviceBuffer.deviceAddress = vkGetBufferDeviceAddress(device, &bufferDeviceAddressInfo);
+    }
+    return deviceBuffer;
+}
+
+DeviceBuffer createDeviceBuffer(
+        sgl::vk::Device* device, VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags memoryProperties) {
+    BufferSettings settings{};
+    settings.size = size;
+    settings.usage = usage;
+    settings.memoryProperties = memoryProperties;
+    return createDeviceBuffer(device->getVkDevice(), device->getMemoryProperties(), settings);
+}
+
+void destroyDeviceBuffer(VkDevice device, DeviceBuffer& buffer) {
+    if (buffer.mappedData) {
+        vkUnmapMemory(device, buffer.memory);
+        buffer.mappedData = nullptr;
+    }
+    if (buffer.buffer) {
+        vkDestroyBuffer(device, buffer.buffer, nullptr);
+        buffer.buffer = VK_NULL_HANDLE;
+    }
+    if (buffer.memory) {
+        vkFreeMemory(device, buffer.memory, nullptr);
+        buffer.memory = VK_NULL_HANDLE;
+    }
+}
+
+CommandContext::CommandContext(
+        VkPhysicalDevice physicalDevice, VkDevice device, uint32_t queueFamilyIndex, VkQueue queue,
+        bool useSynchronization2)
+        : device(device), queueFamilyIndex(queueFamilyIndex), queue(queue) {
+    VkCommandPoolCreateInfo commandPoolCreateInfo{};
+    commandPoolCreateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    commandPoolCreateInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    commandPoolCreateInfo.queueFamilyIndex = queueFamilyIndex;
+    throwIfVkError(vkCreateCommandPool(device, &commandPoolCreateInfo, nullptr, &commandPool), "vkCreateCommandPool");
+
+    VkCommandBufferAllocateInfo commandBufferAllocateInfo{};
+    commandBufferAllocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    commandBufferAllocateInfo.commandPool = commandPool;
+    commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    commandBufferAllocateInfo.commandBufferCount = 1;
+    throwIfVkError(
+            vkAllocateCommandBuffers(device, &commandBufferAllocateInfo, &commandBuffer), "vkAllocateCommandBuffers");
+
+    VkFenceCreateInfo fenceCreateInfo{};
+    fenceCreateInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    throwIfVkError(vkCreateFence(device, &fenceCreateInfo, nullptr, &fence), "vkCreateFence");
+
+    gpuTimer = std::make_unique<GpuTimer>(physicalDevice, device, queueFamilyIndex, useSynchronization2);
+    if (!gpuTimer->getIsSupported()) {
+        gpuTimer = {};
+    }
+}
+
+CommandContext::CommandContext(sgl::vk::Device* device)
+        : CommandContext(
+                device->getVkPhysicalDevice(), device->getVkDevice(), device->getComputeQueueIndex(),
+                device->getComputeQueue(), device->getPhysicalDeviceVulkan13Features().synchronization2) {
+    calibratedClock = std::make_unique<CalibratedClock>(device);
+    if (!calibratedClock->getIsSupported()) {
+        calibratedClock = {};
+    }
+}
+
+CommandContext::~CommandContext() {
+    gpuTimer = {};
+    if (fence) {
+        vkDestroyFence(device, fence, nullptr);
+    }
+    if (commandPool) {
+        vkDestroyCommandPool(device, commandPool, nullptr);
+    }
+}
+
+GpuTimer* CommandContext::getGpuTimer() const {
+    return gpuTimer.get();
+}
+
+CalibratedClock* CommandContext::getCalibratedClock() const {
+    return calibratedClock.get();
+}
+
+VkCommandBuffer CommandContext::begin() {
+    throwIfVkError(vkResetCommandBuffer(commandBuffer, 0), "vkResetCommandBuffer");
+    VkDeviceGroupCommandBufferBeginInfo deviceGroupBeginInfo{};
+    deviceGroupBeginInfo.sType = VK_STRUCTURE_TYPE_DEVICE_GROUP_COMMAND_BUFFER_BEGIN_INFO;
+    deviceGroupBeginInfo.deviceMask = deviceMask;
+    VkCommandBufferBeginInfo beginInfo{};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.pNext = deviceMask != 0 ? &deviceGroupBeginInfo : nullptr;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    throwIfVkError(vkBeginCommandBuffer(commandBuffer, &beginInfo), "vkBeginCommandBuffer");
+    return commandBuffer;
+}
+
+void CommandContext::submitAndWait() {
+    submit();
+    wait();
+}
+
+void CommandContext::submit() {
+    throwIfVkError(vkEndCommandBuffer(commandBuffer), "vkEndCommandBuffer");
+    VkDeviceGroupSubmitInfo deviceGroupSubmitInfo{};
+    deviceGroupSubmitInfo.sType = VK_STRUCTURE_TYPE_DEVICE_GROUP_SUBMIT_INFO;
+    deviceGroupSubmitInfo.commandBufferCount = 1;
+    deviceGroupSubmitInfo.pCommandBufferDeviceMasks = &deviceMask;
+    VkSubmitInfo submitInfo{};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.pNext = deviceMask != 0 ? &deviceGroupSubmitInfo : nullptr;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &commandBuffer;
+    throwIfVkError(vkQueueSubmit(queue, 1, &submitInfo, fence), "vkQueueSubmit");
+}
+
+void CommandContext::wait() {
+    throwIfVkError(vkWaitForFences(device, 1, &fence, VK_TRUE, UINT64_MAX), "vkWaitForFences");
+    throwIfVkError(vkResetFences(device, 1, &fence), "vkResetFences");
+}
+
+void uploadBufferData(
+        sgl::vk::Device* device, CommandContext& context, const DeviceBuffer& buffer, const void* data, size_t size) {
+    DeviceBuffer stagingBuffer = createDeviceBuffer(
+            device, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    memcpy(stagingBuffer.mappedData, data, size);
+    VkBufferCopy region{0, 0, size};
+    try {
+        VkCommandBuffer commandBuffer = context.begin();
+        vkCmdCopyBuffer(commandBuffer, stagingBuffer.buffer, buffer.buffer, 1, &region);
+        context.submitAndWait();
+    } catch (...) {
+        destroyDeviceBuffer(device->getVkDevice(), stagingBuffer);
+        throw;
+    }
+    destroyDeviceBuffer(device->getVkDevice(), stagingBuffer);
+}
+
+void downloadBufferData(
+        sgl::vk::Device* device, CommandContext& context, const DeviceBuffer& buffer, void* data, size_t size) {
+    DeviceBuffer stagingBuffer = createDeviceBuffer(
+            device, size, VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    VkBufferCopy region{0, 0, size};
+    try {
+        VkCommandBuffer commandBuffer = context.begin();
+        vkCmdCopyBuffer(commandBuffer, buffer.buffer, stagingBuffer.buffer, 1, &region);
+        insertHostReadBarrier(commandBuffer);
+        context.submitAndWait();
+    } catch (...) {
+        destroyDeviceBuffer(device->getVkDevice(), stagingBuffer);
+        throw;
+    }
+    memcpy(data, stagingBuffer.mappedData, size);
+    destroyDeviceBuffer(device->getVkDevice(), stagingBuffer);
+}
+
+static std::map<VkDevice, VkPipelineCache> defaultPipelineCaches;
+
+void setDefaultPipelineCache(VkDevice device, VkPipelineCache pipelineCache) {
+    if (pipelineCache) {
+        defaultPipelineCaches[device] = pipelineCache;
+    } else {
+        defaultPipelineCaches.erase(device);
+    }
+}
+
+VkPipelineCache getDefaultPipelineCache(VkDevice device) {
+    auto it = defaultPipelineCaches.find(device);
+    return it != defaultPipelineCaches.end() ? it->second : VK_NULL_HANDLE;
+}
+
+ComputePipeline::ComputePipeline(VkDevice device, const ComputePipelineSettings& settings) : device(device) {
+    VkShaderModuleCreateInfo shaderModuleCreateInfo{};
+    shaderModuleCreateInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+    shaderModuleCreateInfo.codeSize = settings.codeSize;
+    shaderModuleCreateInfo.pCode = settings.code;
+    throwIfVkError(
+            vkCreateShaderModule(device, &shaderModuleCreateInfo, nullptr, &shaderModule), "vkCreateShaderModule");
+
+    VkPushConstantRange pushConstantRange{};
+    pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    pushConstantRange.size = settings.pushConstantSize;
+    VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{};
+    pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    pipelineLayoutCreateInfo.pushConstantRangeCount = settings.pushConstantSize > 0 ? 1 : 0;
+    pipelineLayoutCreateInfo.pPushConstantRanges = &pushConstantRange;
+    VkResult result = vkCreatePipelineLayout(device, &pipelineLayoutCreateInfo, nullptr, &pipelineLayout);
+    if (result != VK_SUCCESS) {
+        vkDestroyShaderModule(device, shaderModule, nullptr);
+        throwIfVkError(result, "vkCreatePipelineLayout");
+    }
+
+    std::vector<VkSpecializationMapEntry> mapEntries(settings.specializationConstants.size());
+    for (size_t i = 0; i < mapEntries.size(); i++) {
+        mapEntries.at(i).constantID = uint32_t(i);
+        mapEntries.at(i).offset = uint32_t(i * sizeof(uint32_t));
+        mapEntries.at(i).size = sizeof(uint32_t);
+    }
+    VkSpecializationInfo specializationInfo{};
+    specializationInfo.mapEntryCount = uint32_t(mapEntries.size());
+    specializationInfo.pMapEntries = mapEntries.data();
+    specializationInfo.dataSize = settings.specializationConstants.size() * sizeof(uint32_t);
+    specializationInfo.pData = settings.specializationConstants.data();
+
+    VkPipelineShaderStageRequiredSubgroupSizeCreateInfo requiredSubgroupSizeCreateInfo{};
+    requiredSubgroupSizeCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_REQUIRED_SUBGROUP_SIZE_CREATE_INFO;
+    requiredSubgroupSizeCreateInfo.requiredSubgroupSize = settings.requiredSubgroupSize;
+
+    VkComputePipelineCreateInfo pipelineCreateInfo{};
+    pipelineCreateInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pipelineCreateInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    pipelineCreateInfo.stage.pNext = settings.requiredSubgroupSize != 0 ? &requiredSubgroupSizeCreateInfo : nullptr;
+    pipelineCreateInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+    pipelineCreateInfo.stage.module = shaderModule;
+    pipelineCreateInfo.stage.pName = "main";
+    pipelineCreateInfo.stage.pSpecializationInfo = mapEntries.empty() ? nullptr : &specializationInfo;
+    pipelineCreateInfo.layout = pipelineLayout;
+    VkPipelineCache pipelineCache = settings.pipelineCache ? settings.pipelineCache : getDefaultPipelineCache(device);
+    result = vkCreateComputePipelines(device, pipelineCache, 1, &pipelineCreateInfo, nullptr, &pipeline);
+    if (result != VK_SUCCESS) {
+        vkDestroyPipelineLayout(device, pipelineLayout, nullptr);
+        vkDestroyShaderModule(device, shaderModule, nullptr);
+        throwIfVkError(result, "vkCreateComputePipelines");
+    }
+}
+
+ComputePipeline::~ComputePipeline() {
+    vkDestroyPipeline(device, pipeline, nullptr);
+    vkDestroyPipelineLayout(device, pipelineLayout, nullptr);
+    vkDestroyShaderModule(device, shaderModule, nullptr);
+}
+
+void ComputePipeline::bind(VkCommandBuffer commandBuffer) const {
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline);
+}
+
+void ComputePipeline::pushConstants(VkCommandBuffer commandBuffer, const void* data, uint32_t size) const {
+    vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, size, data);
+}
+
+void insertMemoryBarrier(VkCommandBuffer commandBuffer) {
+    VkMemoryBarrier memoryBarrier{};
+    memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    memoryBarrier.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
+    memoryBarrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+    vkCmdPipelineBarrier(
+            commandBuffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0,
+            1, &memoryBarrier, 0, nullptr, 0, nullptr);
+}
+
+void insertHostReadBarrier(VkCommandBuffer commandBuffer) {
+    VkMemoryBarrier memoryBarrier{};
+    memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    memoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    memoryBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+    vkCmdPipelineBarrier(
+            commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0,
+            1, &memoryBarrier, 0, nullptr, 0, nullptr);
+}
+
+CommandTiming measureCommands(
+        CommandContext& context, const std::function<void(VkCommandBuffer)>& recordCommands,
+        uint32_t numIterations) {
+    GpuTimer* gpuTimer = context.getGpuTimer();
+    CalibratedClock* calibratedClock = context.getCalibratedClock();
+    std::vector<double> cpuSamplesMs, submitLatencySamplesMs;
+    auto measureSample = [&]() {
+        uint32_t intervalIdx = 0;
+        VkCommandBuffer commandBuffer = context.begin();
+        if (gpuTimer) {
+            gpuTimer->reset();
+            intervalIdx = gpuTimer->beginInterval(commandBuffer);
+        }
+        for (uint32_t i = 0; i < numIterations; i++) {
+            if (i != 0) {
+                insertMemoryBarrier(commandBuffer);
+            }
+            recordCommands(commandBuffer);
+        }
+        if (gpuTimer) {
+            gpuTimer->endInterval(commandBuffer, intervalIdx);
+        }
+        if (calibratedClock) {
+            calibratedClock->calibrate();
+        }
+        int64_t submitTimeNs = CalibratedClock::getHostTimeNs();
+        auto startTime = std::chrono::high_resolution_clock::now();
+        context.submitAndWait();
+        auto endTime = std::chrono::high_resolution_clock::now();
+
+        double cpuMs = std::chrono::duration<double, std::milli>(endTime - startTime).count() / double(numIterations);
+        cpuSamplesMs.push_back(cpuMs);
+        if (!gpuTimer) {
+            return cpuMs;
+        }
+        if (calibratedClock) {
+            int64_t gpuStartNs = calibratedClock->convertDeviceTicksToHostNs(
+                    gpuTimer->getIntervalStartTicks(intervalIdx));
+            submitLatencySamplesMs.push_back(double(gpuStartNs - submitTimeNs) * 1e-6);
+        }
+        return gpuTimer->getIntervalMs(intervalIdx) / double(numIterations);
+    };
+
+    CommandTiming timing{};
+    timing.statistics = runBenchmark(measureSample);
+    // The CPU times and latencies of the samples after the warm-up.
+    auto getMedianOfSamples = [&](const std::vector<double>& values) {
+        size_t numSamples = std::min(size_t(timing.statistics.numSamples), values.size());
+        std::vector<double> samples(values.end() - ptrdiff_t(numSamples), values.end());
+        std::sort(samples.begin(), samples.end());
+        return samples.empty() ? 0.0 : samples.at(samples.size() / 2);
+    };
+    timing.cpuMs = getMedianOfSamples(cpuSamplesMs);
+    if (gpuTimer) {
+        timing.gpuMs = timing.statistics.median;
+        timing.hasGpuTime = true;
+    }
+    if (!submitLatencySamplesMs.empty()) {
+        timing.submitLatencyMs = getMedianOfSamples(submitLatencySamplesMs);
+        timing.hasSubmitLatency = true;
+    }
+    return timing;
+}
+
+double measureCommandsMs(
+        CommandContext& context, const std::function<void(VkCommandBuffer)>& recordCommands,
+        uint32_t numIterations) {
+    return measureCommands(context, recordCommands, numIterations).getMs();
+}
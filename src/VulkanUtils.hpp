@@ -0,0 +1,209 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef QUERYVKCOOPMAT_VULKANUTILS_HPP
+#define QUERYVKCOOPMAT_VULKANUTILS_HPP
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <Graphics/Vulkan/Utils/Device.hpp>
+
+#include "BenchmarkRunner.hpp"
+
+class GpuTimer;
+class CalibratedClock;
+
+/*
+ * Thin helpers over the raw Vulkan API used by the benchmark modes. All functions report errors by throwing
+ * std::runtime_error; the benchmark entry points catch them and write them to the log file.
+ */
+
+const char* getVkResultString(VkResult result);
+void throwIfVkError(VkResult result, const std::string& callName);
+
+/**
+ * Device-level entry points are stored in global function pointers by volk, which may have been loaded for a single
+ * device. Benchmarks working with multiple devices at once need to re-point them when switching between devices.
+ */
+void loadDeviceFunctions(VkDevice device);
+
+/// Returns UINT32_MAX if no memory type matches.
+uint32_t findMemoryTypeIndex(
+        const VkPhysicalDeviceMemoryProperties& memoryProperties, uint32_t memoryTypeBits,
+        VkMemoryPropertyFlags requiredFlags);
+
+struct BufferSettings {
+    VkDeviceSize size = 0;
+    VkBufferUsageFlags usage = 0;
+    VkMemoryPropertyFlags memoryProperties = 0;
+    uint32_t memoryTypeBitsMask = ~0u; ///< E.g., for restricting imported memory to compatible types.
+    bool dedicatedAllocation = false;
+    /// Uses VK_SHARING_MODE_CONCURRENT if more than one queue family is passed.
+    std::vector<uint32_t> queueFamilyIndices;
+    const void* bufferCreateInfoNext = nullptr;
+    const void* memoryAllocateInfoNext = nullptr;
+};
+
+struct DeviceBuffer {
+    VkBuffer buffer = VK_NULL_HANDLE;
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    VkDeviceSize size = 0;
+    uint32_t memoryTypeIndex = 0;
+    void* mappedData = nullptr; ///< Persistently mapped if host-visible memory was requested.
+    VkDeviceAddress deviceAddress = 0; ///< Set if VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT was requested.
+};
+
+DeviceBuffer createDeviceBuffer(
+        VkDevice device, const VkPhysicalDeviceMemoryProperties& memoryProperties, const BufferSettings& settings);
+DeviceBuffer createDeviceBuffer(
+        sgl::vk::Device* device, VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags memoryProperties);
+void destroyDeviceBuffer(VkDevice device, DeviceBuffer& buffer);
+
+/**
+ * Command pool, command buffer and fence for synchronous submissions to a single queue, and a GPU timer if the queue
+ * family supports timestamps. Contexts created from an sgl device additionally own a calibrated clock if supported.
+ */
+class CommandContext {
+public:
+    /// E.g., for device groups; the timer uses vkCmdWriteTimestamp2 only if synchronization2 was enabled.
+    CommandContext(
+            VkPhysicalDevice physicalDevice, VkDevice device, uint32_t queueFamilyIndex, VkQueue queue,
+            bool useSynchronization2 = false);
+    explicit CommandContext(sgl::vk::Device* device); ///< Uses the compute queue of the device.
+    ~CommandContext();
+    CommandContext(const CommandContext&) = delete;
+    CommandContext& operator=(const CommandContext&) = delete;
+
+    [[nodiscard]] inline VkDevice getVkDevice() const { return device; }
+    [[nodiscard]] inline VkQueue getQueue() const { return queue; }
+    [[nodiscard]] inline uint32_t getQueueFamilyIndex() const { return queueFamilyIndex; }
+    /// Returns nullptr if timestamp queries are not available for the queue.
+    [[nodiscard]] GpuTimer* getGpuTimer() const;
+    /// Returns nullptr if calibrated timestamps are not available for the device.
+    [[nodiscard]] CalibratedClock* getCalibratedClock() const;
+
+    /// For device groups: Restricts the command buffer and its submission to the passed devices (0 = no mask).
+    inline void setDeviceMask(uint32_t mask) { deviceMask = mask; }
+
+    VkCommandBuffer begin();
+    void submitAndWait();
+    /// Split version of submitAndWait, e.g., for running commands on multiple devices at the same time.
+    void submit();
+    void wait();
+
+private:
+    VkDevice device = VK_NULL_HANDLE;
+    uint32_t queueFamilyIndex = 0;
+    VkQueue queue = VK_NULL_HANDLE;
+    VkCommandPool commandPool = VK_NULL_HANDLE;
+    VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+    VkFence fence = VK_NULL_HANDLE;
+    uint32_t deviceMask = 0;
+    std::unique_ptr<GpuTimer> gpuTimer;
+    std::unique_ptr<CalibratedClock> calibratedClock;
+};
+
+/// Copies data from/to a device-local buffer using a temporary staging buffer.
+void uploadBufferData(
+        sgl::vk::Device* device, CommandContext& context, const DeviceBuffer& buffer, const void* data, size_t size);
+void downloadBufferData(
+        sgl::vk::Device* device, CommandContext& context, const DeviceBuffer& buffer, void* data, size_t size);
+
+struct ComputePipelineSettings {
+    const uint32_t* code = nullptr;
+    size_t codeSize = 0; ///< In bytes.
+    /// Specialization constant i is mapped to constant_id i.
+    std::vector<uint32_t> specializationConstants;
+    /// Kernels access their buffers via buffer device addresses passed as push constants (no descriptor sets).
+    uint32_t pushConstantSize = 0;
+    /// Uses VkPipelineShaderStageRequiredSubgroupSizeCreateInfo if not zero.
+    uint32_t requiredSubgroupSize = 0;
+    /// Falls back to the default pipeline cache of the device (see setDefaultPipelineCache) if VK_NULL_HANDLE.
+    VkPipelineCache pipelineCache = VK_NULL_HANDLE;
+};
+
+/**
+ * Pipeline cache used by all compute pipelines created for the passed device without an explicit cache. Passing
+ * VK_NULL_HANDLE as cache removes the default cache of the device again.
+ */
+void setDefaultPipelineCache(VkDevice device, VkPipelineCache pipelineCache);
+VkPipelineCache getDefaultPipelineCache(VkDevice device);
+
+class ComputePipeline {
+public:
+    ComputePipeline(VkDevice device, const ComputePipelineSettings& settings);
+    ~ComputePipeline();
+    ComputePipeline(const ComputePipeline&) = delete;
+    ComputePipeline& operator=(const ComputePipeline&) = delete;
+
+    void bind(VkCommandBuffer commandBuffer) const;
+    void pushConstants(VkCommandBuffer commandBuffer, const void* data, uint32_t size) const;
+    [[nodiscard]] inline VkPipeline getVkPipeline() const { return pipeline; }
+
+private:
+    VkDevice device = VK_NULL_HANDLE;
+    VkShaderModule shaderModule = VK_NULL_HANDLE;
+    VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
+    VkPipeline pipeline = VK_NULL_HANDLE;
+};
+
+/// Inserts a full memory barrier, such that consecutive benchmark iterations do not overlap.
+void insertMemoryBarrier(VkCommandBuffer commandBuffer);
+/// Makes the data written by preceding transfer commands visible to host reads after the fence wait.
+void insertHostReadBarrier(VkCommandBuffer commandBuffer);
+
+/// Median times per iteration measured by measureCommands.
+struct CommandTiming {
+    double gpuMs = 0.0; ///< Between timestamps written before and after the commands; valid if hasGpuTime is set.
+    double cpuMs = 0.0; ///< Wall clock around submission and fence wait, including driver overhead.
+    double submitLatencyMs = 0.0; ///< From vkQueueSubmit to the start timestamp; valid if hasSubmitLatency is set.
+    bool hasGpuTime = false;
+    bool hasSubmitLatency = false;
+    BenchmarkStatistics statistics; ///< Of the GPU time if available, and of the CPU time otherwise.
+    [[nodiscard]] inline double getMs() const { return hasGpuTime ? gpuMs : cpuMs; }
+};
+
+/**
+ * Records the passed commands numIterations times (separated by memory barriers) into one command buffer and
+ * submits it repeatedly via runBenchmark, which takes care of the warm-up and the number of samples. GPU time is
+ * measured with timestamp queries if the context has a GPU timer.
+ */
+CommandTiming measureCommands(
+        CommandContext& context, const std::function<void(VkCommandBuffer)>& recordCommands,
+        uint32_t numIterations = 10);
+
+/// Returns the median GPU time in milliseconds if available and the CPU time otherwise (see measureCommands).
+double measureCommandsMs(
+        CommandContext& context, const std::function<void(VkCommandBuffer)>& recordCommands,
+        uint32_t numIterations = 10);
+
+#endif //QUERYVKCOOPMAT_VULKANUTILS_HPP